@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "scene/mesh.h"
+#include "tools/cpu_profiler.h"
+
+// System includes
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct CompressOptions
+{
+    // Version 1 or version 2 animation, written as version 2
+    std::string input;
+    std::string output;
+
+    // Frames stored as deltas after every key frame, 0 for key frames only
+    uint32_t keyframeInterval = MESH_ANIMATION_DEFAULT_KEYFRAME_INTERVAL;
+
+    // Repetitions of the decoding of every frame
+    uint32_t numIterations = 4;
+};
+
+static void print_usage()
+{
+    printf("Usage: anim_compress [options] input.anim output.anim\n");
+    printf("--keyframe-interval Frames between two key frames, 0 stores every frame as a key frame (default %u).\n", MESH_ANIMATION_DEFAULT_KEYFRAME_INTERVAL);
+    printf("--iterations Repetitions of the decoding of every frame (default 4).\n");
+}
+
+static bool parse_args(int argc, char** argv, CompressOptions& options)
+{
+    std::vector<std::string> paths;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--keyframe-interval" && hasValue)
+            options.keyframeInterval = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--iterations" && hasValue)
+            options.numIterations = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg.size() > 2 && arg[0] == '-' && arg[1] == '-')
+        {
+            print_usage();
+            return false;
+        }
+        else
+            paths.push_back(arg);
+    }
+    if (paths.size() != 2 || options.numIterations == 0)
+    {
+        print_usage();
+        return false;
+    }
+    options.input = paths[0];
+    options.output = paths[1];
+    return true;
+}
+
+static uint64_t file_size(const std::string& path)
+{
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : (uint64_t)size;
+}
+
+static float angle_error(const float3& reference, const float3& direction)
+{
+    float cosine = dot(reference, direction) / fmaxf(length(reference) * length(direction), 1e-12f);
+    return acosf(fminf(fmaxf(cosine, -1.0f), 1.0f)) / (float)DEG_TO_RAD;
+}
+
+int main(int argc, char** argv)
+{
+    CompressOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // The errors are measured against the full precision frames when the input has them
+    const bool quantizedInput = mesh::is_quantized_mesh_animation(options.input.c_str());
+    MeshAnimation animation;
+    QuantizedMeshAnimation quantizedAnimation;
+    if (!quantizedInput)
+    {
+        mesh::import_mesh_animation(options.input.c_str(), animation);
+        mesh::quantize_mesh_animation(animation, quantizedAnimation);
+    }
+    else
+        mesh::import_quantized_mesh_animation(options.input.c_str(), quantizedAnimation);
+    mesh::export_quantized_mesh_animation(quantizedAnimation, options.output.c_str(), options.keyframeInterval);
+
+    // The written file decodes to the same frames
+    QuantizedMeshAnimation writtenAnimation;
+    mesh::import_quantized_mesh_animation(options.output.c_str(), writtenAnimation);
+    const uint32_t numFrames = (uint32_t)quantizedAnimation.frames.size();
+    const uint32_t numVertices = (uint32_t)quantizedAnimation.sharedVertices.size();
+    bool identical = writtenAnimation.frames.size() == numFrames;
+    for (uint32_t frameIdx = 0; identical && frameIdx < numFrames; ++frameIdx)
+        identical = memcmp(writtenAnimation.frames[frameIdx].data(), quantizedAnimation.frames[frameIdx].data(), numVertices * sizeof(QuantizedVertexData)) == 0;
+    printf("%u vertices, %u frames, %u triangles, key frame interval %u\n", numVertices, numFrames, (uint32_t)quantizedAnimation.indexBuffer.size(), options.keyframeInterval);
+
+    // Footprints, the index buffer is the same in both versions
+    const uint64_t fullVRAM = (uint64_t)numFrames * numVertices * sizeof(VertexData);
+    const uint64_t quantizedVRAM = (uint64_t)numFrames * numVertices * sizeof(QuantizedVertexData) + (uint64_t)numVertices * sizeof(SharedVertexData);
+    const uint64_t inputSize = file_size(options.input);
+    const uint64_t outputSize = file_size(options.output);
+    printf("Disk: %.2f MB -> %.2f MB (%.2fx)\n", inputSize / 1e6, outputSize / 1e6, outputSize > 0 ? inputSize / (double)outputSize : 0.0);
+    printf("Vertex buffers: %.2f MB -> %.2f MB (%.2fx)\n", fullVRAM / 1e6, quantizedVRAM / 1e6, quantizedVRAM > 0 ? fullVRAM / (double)quantizedVRAM : 0.0);
+
+    // Decoding of every frame, scalar and SSE2
+    ScopeHistory referenceHistory(numFrames * options.numIterations), simdHistory(numFrames * options.numIterations);
+    std::vector<VertexData> reference, vertices;
+    float positionError = 0.0f, normalError = 0.0f, tangentError = 0.0f;
+    bool matchingDecoders = true;
+    for (uint32_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+    {
+        for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            mesh::dequantize_frame_reference(quantizedAnimation, frameIdx, reference);
+            auto stop = std::chrono::high_resolution_clock::now();
+            referenceHistory.push(std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f);
+
+            start = std::chrono::high_resolution_clock::now();
+            mesh::dequantize_frame(quantizedAnimation, frameIdx, vertices);
+            stop = std::chrono::high_resolution_clock::now();
+            simdHistory.push(std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f);
+        }
+        matchingDecoders = matchingDecoders && memcmp(reference.data(), vertices.data(), numVertices * sizeof(VertexData)) == 0;
+
+        // Quantization error
+        if (!quantizedInput)
+        {
+            const std::vector<VertexData>& original = animation.vertexBufferArray[frameIdx].data;
+            for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+            {
+                positionError = fmaxf(positionError, length(original[vertIdx].position - vertices[vertIdx].position));
+                normalError = fmaxf(normalError, angle_error(original[vertIdx].normal, vertices[vertIdx].normal));
+                tangentError = fmaxf(tangentError, angle_error(original[vertIdx].tangent, vertices[vertIdx].tangent));
+            }
+        }
+    }
+
+    printf("decoder,median_ms,p95_ms,mvertices_per_s\n");
+    const char* decoderNames[] = { "scalar", "simd" };
+    const ScopeHistory* histories[] = { &referenceHistory, &simdHistory };
+    for (uint32_t decoderIdx = 0; decoderIdx < 2; ++decoderIdx)
+    {
+        const float median = histories[decoderIdx]->percentile(50.0f);
+        printf("%s,%.3f,%.3f,%.2f\n", decoderNames[decoderIdx], median, histories[decoderIdx]->percentile(95.0f), median > 0.0f ? numVertices / (median * 1e3f) : 0.0f);
+    }
+    if (!quantizedInput)
+        printf("Max error: position %g, normal %.4f deg, tangent %.4f deg\n", positionError, normalError, tangentError);
+    printf("Round trip: %s, decoders: %s\n", identical ? "identical" : "DIFFERENT", matchingDecoders ? "identical" : "DIFFERENT");
+    return identical && matchingDecoders ? 0 : -1;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/operators.h"
+#include "scene/mesh.h"
+
+// System includes
+#include <fstream>
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// Scene shared by the CPU benches: the mesh animation and camera path of the sample, or a synthetic field of spheres
+
+// Same clip planes as the camera controller
+#define CAMERA_NEAR 0.01f
+#define CAMERA_FAR 100.0f
+
+struct BenchOptions
+{
+    // Animated mesh and camera path of the sample, a synthetic scene is used without a mesh
+    std::string animation;
+    std::string paths;
+
+    // Resolution of the views
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+
+    // Animation times evaluated per view and repetitions of each measurement
+    uint32_t numFrames = 8;
+    uint32_t numIterations = 4;
+
+    // 0 uses every hardware thread
+    uint32_t numThreads = 0;
+};
+
+struct BenchView
+{
+    float3 position;
+    float3 angles;
+    float fov;
+};
+
+// Options of every bench, the bench prints its own ones after them
+inline void print_bench_usage(const char* benchName)
+{
+    printf("Usage: %s [options]\n", benchName);
+    printf("--animation Mesh animation (michel.anim), a synthetic scene is used otherwise.\n");
+    printf("--paths Camera path of the views (poi_list.csv).\n");
+    printf("--width Width of the views (default 1920).\n");
+    printf("--height Height of the views (default 1080).\n");
+    printf("--frames Animation times per view (default 8).\n");
+    printf("--iterations Repetitions of every measurement (default 4).\n");
+    printf("--threads Number of threads, 0 for all of them (default 0).\n");
+}
+
+// parseExtra(arg, hasValue, argIdx) reads the options of the bench and returns false for an unknown one
+template <typename ExtraParser>
+inline bool parse_bench_args(int argc, char** argv, BenchOptions& options, void (*printUsage)(), ExtraParser parseExtra)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--animation" && hasValue)
+            options.animation = argv[++argIdx];
+        else if (arg == "--paths" && hasValue)
+            options.paths = argv[++argIdx];
+        else if (arg == "--width" && hasValue)
+            options.width = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--height" && hasValue)
+            options.height = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--frames" && hasValue)
+            options.numFrames = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--iterations" && hasValue)
+            options.numIterations = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--threads" && hasValue)
+            options.numThreads = (uint32_t)atoi(argv[++argIdx]);
+        else if (!parseExtra(arg, hasValue, argIdx))
+        {
+            printUsage();
+            return false;
+        }
+    }
+    return options.width > 0 && options.height > 0 && options.numFrames > 0 && options.numIterations > 0;
+}
+
+// Same format as CameraController::load_camera_path
+inline bool load_views(const std::string& path, std::vector<BenchView>& views)
+{
+    std::ifstream pathFile(path);
+    if (!pathFile.is_open())
+        return false;
+    uint32_t numPoints = 0;
+    pathFile >> numPoints;
+    std::string line;
+    for (uint32_t ptIdx = 0; ptIdx < numPoints && pathFile >> line; ++ptIdx)
+    {
+        std::istringstream iss(line);
+        float4 rotation;
+        BenchView view;
+        char s;
+        iss >> rotation.x >> s >> rotation.y >> s >> rotation.z >> s >> rotation.w
+            >> s >> view.position.x >> s >> view.position.y >> s >> view.position.z
+            >> s >> view.angles.x >> s >> view.angles.y >> s >> view.angles.z
+            >> s >> view.fov;
+        views.push_back(view);
+    }
+    return !views.empty();
+}
+
+// Same matrices as CameraController::evaluate_camera_matrices
+inline float4x4 view_projection(const BenchView& view, float aspectRatio)
+{
+    const float4x4 projection = projection_matrix(view.fov, CAMERA_NEAR, CAMERA_FAR, aspectRatio);
+    const float4x4 rotation_z = rotation_matrix_z(view.angles.z);
+    const float4x4 rotation_y = rotation_matrix_y(view.angles.x);
+    const float4x4 rotation_x = rotation_matrix_x(view.angles.y);
+    return mul(projection, mul(rotation_z, mul(rotation_x, rotation_y)));
+}
+
+// Field of spheres in front of the camera that breathe over two frames, two materials.
+// A wide field spreads past the frustum and is also seen from its side.
+inline void synthetic_scene(MeshAnimation& animation, std::vector<BenchView>& views, bool wideField = false)
+{
+    const uint32_t numRings = 24;
+    const uint32_t numSegments = 48;
+    animation.vertexBufferArray.resize(2);
+    uint32_t state = 0x9E3779B9u;
+    for (uint32_t sphereIdx = 0; sphereIdx < 160; ++sphereIdx)
+    {
+        // Random placement in or around the view frustum
+        state = state * 1664525u + 1013904223u;
+        float depth = 3.0f + (state >> 8) / 16777216.0f * 30.0f;
+        state = state * 1664525u + 1013904223u;
+        float x = ((state >> 8) / 16777216.0f * 2.0f - 1.0f) * depth * (wideField ? 2.0f : 1.2f);
+        state = state * 1664525u + 1013904223u;
+        float y = ((state >> 8) / 16777216.0f * 2.0f - 1.0f) * depth * 0.65f;
+        state = state * 1664525u + 1013904223u;
+        float radius = 0.2f + (state >> 8) / 16777216.0f * 0.8f;
+
+        const uint32_t firstVertex = (uint32_t)animation.vertexBufferArray[0].data.size();
+        for (uint32_t ringIdx = 0; ringIdx <= numRings; ++ringIdx)
+        {
+            float theta = (float)PI * ringIdx / numRings;
+            for (uint32_t segmentIdx = 0; segmentIdx <= numSegments; ++segmentIdx)
+            {
+                float phi = (float)TWO_PI * segmentIdx / numSegments;
+                float3 normal = { sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi) };
+                for (uint32_t frameIdx = 0; frameIdx < 2; ++frameIdx)
+                {
+                    VertexData vertex = {};
+                    vertex.position = float3({ x, y, depth }) + normal * (radius * (frameIdx == 0 ? 1.0f : 1.1f));
+                    vertex.normal = normal;
+                    vertex.texCoord = { segmentIdx / (float)numSegments, ringIdx / (float)numRings };
+                    vertex.matID = sphereIdx % 2;
+                    animation.vertexBufferArray[frameIdx].data.push_back(vertex);
+                }
+            }
+        }
+
+        // Outward faces are counter clockwise once projected
+        for (uint32_t ringIdx = 0; ringIdx < numRings; ++ringIdx)
+        {
+            for (uint32_t segmentIdx = 0; segmentIdx < numSegments; ++segmentIdx)
+            {
+                uint32_t v0 = firstVertex + ringIdx * (numSegments + 1) + segmentIdx;
+                uint32_t v1 = v0 + 1;
+                uint32_t v2 = v0 + numSegments + 1;
+                uint32_t v3 = v2 + 1;
+                animation.indexBuffer.push_back({ v0, v2, v1 });
+                animation.indexBuffer.push_back({ v1, v2, v3 });
+            }
+        }
+    }
+
+    // Camera at the origin looking down z, then from the side of the field
+    views.push_back({ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, 35.0f * (float)DEG_TO_RAD });
+    if (wideField)
+        views.push_back({ { -40.0f, 0.0f, 18.0f }, { -90.0f * (float)DEG_TO_RAD, 0.0f, 0.0f }, 35.0f * (float)DEG_TO_RAD });
+}
+
+// The animation and camera path of the options, or the synthetic scene without an animation
+inline bool load_bench_scene(const BenchOptions& options, MeshAnimation& animation, std::vector<BenchView>& views, bool wideField = false)
+{
+    if (options.animation.empty())
+    {
+        synthetic_scene(animation, views, wideField);
+        return true;
+    }
+    mesh::import_mesh_animation(options.animation.c_str(), animation);
+    if (options.paths.empty() || !load_views(options.paths, views))
+    {
+        printf("Failed to read the camera path %s.\n", options.paths.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "graphics/backend.h"
+#include "graphics/binding_table.h"
+#include "tools/cpu_profiler.h"
+
+// System includes
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct BenchOptions
+{
+    // Resources declared by the synthetic shader
+    uint32_t numBindings = 32;
+
+    // Bind calls per run
+    uint32_t numBinds = 1000000;
+
+    // Repetitions of every run
+    uint32_t numIterations = 5;
+};
+
+static void print_usage()
+{
+    printf("Usage: binding_bench [options]\n");
+    printf("--bindings Resources declared by the shader (default 32).\n");
+    printf("--binds Bind calls per run (default 1000000).\n");
+    printf("--iterations Repetitions of every run (default 5).\n");
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--bindings" && hasValue)
+            options.numBindings = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--binds" && hasValue)
+            options.numBinds = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--iterations" && hasValue)
+            options.numIterations = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.numBindings > 0 && options.numBinds > 0 && options.numIterations > 0;
+}
+
+static float ns_per_bind(std::chrono::high_resolution_clock::time_point start, uint32_t numBinds)
+{
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / (float)numBinds;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // Shader with one buffer per binding, the arrays and the spacing cover the declarations of the real shaders
+    std::vector<std::string> names;
+    const std::filesystem::path shaderPath = std::filesystem::temp_directory_path() / "binding_bench.compute";
+    {
+        std::ofstream shaderFile(shaderPath);
+        for (uint32_t bindingIdx = 0; bindingIdx < options.numBindings; ++bindingIdx)
+        {
+            names.push_back("_Binding" + std::to_string(bindingIdx));
+            if (bindingIdx % 2 == 0)
+                shaderFile << "RWStructuredBuffer<float> " << names.back() << ": register(u" << bindingIdx << ");\n";
+            else
+                shaderFile << "Texture2D<float4> " << names.back() << "[4] : register(t" << bindingIdx << ");\n";
+        }
+        shaderFile << "[numthreads(64, 1, 1)]\nvoid main(uint threadID : SV_DispatchThreadID) {}\n";
+    }
+
+    graphics::setup_graphics_api(GraphicsAPI::Null);
+    GraphicsDevice device = graphics::device::create_graphics_device();
+    CommandBuffer cmd = graphics::command_buffer::create_command_buffer(device);
+    GraphicsBuffer buffer = graphics::resources::create_graphics_buffer(device, 256, 4);
+    ComputeShaderDescriptor csd;
+    csd.filename = shaderPath.string();
+    ComputeShader cs = graphics::compute_shader::create_compute_shader(device, csd);
+
+    // Every declared name is found, a missing one isn't
+    std::vector<BindingID> bindingIDs;
+    for (const std::string& name : names)
+        bindingIDs.push_back(binding_id(name.c_str()));
+    BindingTable table;
+    table.build(bindingIDs.data(), (uint32_t)bindingIDs.size());
+    uint32_t errors = 0;
+    for (uint32_t bindingIdx = 0; bindingIdx < options.numBindings; ++bindingIdx)
+    {
+        errors += table.find(bindingIDs[bindingIdx]) == bindingIdx ? 0 : 1;
+        graphics::command_buffer::set_compute_shader_buffer(cmd, cs, bindingIDs[bindingIdx], buffer);
+    }
+    errors += table.find(binding_id("_Missing")) == BINDING_TABLE_EMPTY ? 0 : 1;
+    printf("%u bindings, %u binds, %u errors\n", options.numBindings, options.numBinds, errors);
+
+    // The previous lookups, for reference
+    std::map<std::string, uint32_t> nameMap;
+    for (uint32_t bindingIdx = 0; bindingIdx < options.numBindings; ++bindingIdx)
+        nameMap[names[bindingIdx]] = bindingIdx;
+
+    ScopeHistory nameHistory(options.numIterations);
+    ScopeHistory idHistory(options.numIterations);
+    ScopeHistory mapHistory(options.numIterations);
+    ScopeHistory scanHistory(options.numIterations);
+    ScopeHistory tableHistory(options.numIterations);
+    volatile uint32_t sink = 0;
+    for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+    {
+        // Name hashed at every call
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t bindIdx = 0; bindIdx < options.numBinds; ++bindIdx)
+            graphics::command_buffer::set_compute_shader_buffer(cmd, cs, names[bindIdx % options.numBindings].c_str(), buffer);
+        nameHistory.push(ns_per_bind(start, options.numBinds));
+
+        // Identifier computed once
+        start = std::chrono::high_resolution_clock::now();
+        for (uint32_t bindIdx = 0; bindIdx < options.numBinds; ++bindIdx)
+            graphics::command_buffer::set_compute_shader_buffer(cmd, cs, bindingIDs[bindIdx % options.numBindings], buffer);
+        idHistory.push(ns_per_bind(start, options.numBinds));
+
+        // Lookup only, string map
+        start = std::chrono::high_resolution_clock::now();
+        for (uint32_t bindIdx = 0; bindIdx < options.numBinds; ++bindIdx)
+            sink = sink + nameMap.find(names[bindIdx % options.numBindings])->second;
+        mapHistory.push(ns_per_bind(start, options.numBinds));
+
+        // Lookup only, linear scan of the identifiers
+        start = std::chrono::high_resolution_clock::now();
+        for (uint32_t bindIdx = 0; bindIdx < options.numBinds; ++bindIdx)
+        {
+            const BindingID bindingID = bindingIDs[bindIdx % options.numBindings];
+            sink = sink + (uint32_t)(std::find(bindingIDs.begin(), bindingIDs.end(), bindingID) - bindingIDs.begin());
+        }
+        scanHistory.push(ns_per_bind(start, options.numBinds));
+
+        // Lookup only, hashed table
+        start = std::chrono::high_resolution_clock::now();
+        for (uint32_t bindIdx = 0; bindIdx < options.numBinds; ++bindIdx)
+            sink = sink + table.find(bindingIDs[bindIdx % options.numBindings]);
+        tableHistory.push(ns_per_bind(start, options.numBinds));
+    }
+
+    printf("run,median_ns_per_bind,p95_ns_per_bind\n");
+    printf("bind_name,%.2f,%.2f\n", nameHistory.percentile(50.0f), nameHistory.percentile(95.0f));
+    printf("bind_id,%.2f,%.2f\n", idHistory.percentile(50.0f), idHistory.percentile(95.0f));
+    printf("lookup_map,%.2f,%.2f\n", mapHistory.percentile(50.0f), mapHistory.percentile(95.0f));
+    printf("lookup_scan,%.2f,%.2f\n", scanHistory.percentile(50.0f), scanHistory.percentile(95.0f));
+    printf("lookup_table,%.2f,%.2f\n", tableHistory.percentile(50.0f), tableHistory.percentile(95.0f));
+
+    graphics::compute_shader::destroy_compute_shader(cs);
+    graphics::resources::destroy_graphics_buffer(buffer);
+    graphics::command_buffer::destroy_command_buffer(cmd);
+    graphics::device::destroy_graphics_device(device);
+    std::filesystem::remove(shaderPath);
+    return errors == 0 ? 0 : -1;
+}
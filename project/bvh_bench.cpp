@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "bench_scene.h"
+#include "render_pipeline/bvh.h"
+#include "render_pipeline/software_rasterizer.h"
+#include "render_pipeline/software_shadow.h"
+#include "tools/cpu_profiler.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct BVHBenchOptions : BenchOptions
+{
+    // The refitted tree is rebuilt once its SAH cost exceeds the cost when built by this factor
+    float rebuildThreshold = 1.3f;
+};
+
+static void print_usage()
+{
+    print_bench_usage("bvh_bench");
+    printf("--rebuild-threshold SAH cost ratio above which the refitted tree is rebuilt (default 1.3).\n");
+}
+
+static float elapsed_ms(const std::chrono::high_resolution_clock::time_point& start)
+{
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f;
+}
+
+int main(int argc, char** argv)
+{
+    BVHBenchOptions options;
+    auto parse_threshold = [&](const std::string& arg, bool hasValue, int& argIdx)
+    {
+        if (arg != "--rebuild-threshold" || !hasValue)
+            return false;
+        options.rebuildThreshold = (float)atof(argv[++argIdx]);
+        return true;
+    };
+    if (!parse_bench_args(argc, argv, options, print_usage, parse_threshold))
+        return -1;
+
+    // Scene
+    MeshAnimation animation;
+    std::vector<BenchView> views;
+    if (!load_bench_scene(options, animation, views))
+        return -1;
+    const uint32_t numAnimationFrames = (uint32_t)animation.vertexBufferArray.size();
+
+    task_scheduler::initialize(options.numThreads);
+    SoftwareRasterizer rasterizer;
+    rasterizer.initialize(options.width, options.height);
+
+    // The refitted tree follows the animation, the rebuilt one is the reference of every frame
+    BVH refittedBVH, rebuiltBVH;
+    auto start = std::chrono::high_resolution_clock::now();
+    refittedBVH.build(animation, 0, numAnimationFrames > 1 ? 1 : 0, 0.0f);
+    const float initialBuildMS = elapsed_ms(start);
+    const BVHStats& initialStats = refittedBVH.stats();
+    printf("%u triangles, %u nodes, %u leaves, depth %u, SAH cost %.2f, built in %.3f ms, %u threads\n", initialStats.numTriangles, initialStats.numNodes,
+        initialStats.numLeaves, initialStats.depth, initialStats.buildCost, initialBuildMS, task_scheduler::num_threads());
+
+    // Every view at a few times of the animation
+    ScopeHistory refitHistory(views.size() * options.numFrames * options.numIterations);
+    ScopeHistory rebuildHistory(views.size() * options.numFrames * options.numIterations);
+    std::vector<uint32_t> visibility;
+    std::vector<float> refittedShadow, rebuiltShadow;
+    uint32_t numRebuilds = 0;
+    uint64_t totalRays = 0;
+    double totalTraceMS = 0.0;
+    printf("view,time,refit_ms,rebuild_ms,refit_cost,rebuild_cost,cost_ratio,rebuilt,rays,trace_ms,mrays_per_s,differences\n");
+    for (uint32_t viewIdx = 0; viewIdx < (uint32_t)views.size(); ++viewIdx)
+    {
+        SoftwareShadowView shadowView;
+        shadowView.width = options.width;
+        shadowView.height = options.height;
+        shadowView.viewProjection = view_projection(views[viewIdx], options.width / (float)options.height);
+        shadowView.invViewProjection = inverse(shadowView.viewProjection);
+        shadowView.cameraPosition = views[viewIdx].position;
+        shadowView.sunDirection = float3({ 0.57735026919f, 0.57735026919f, 0.57735026919f });
+        for (uint32_t frameIdx = 0; frameIdx < options.numFrames; ++frameIdx)
+        {
+            // Same frame selection as SkinnedMeshRenderer
+            const float time = frameIdx / (float)options.numFrames;
+            const uint32_t frameA = uint32_t(time * numAnimationFrames) % numAnimationFrames;
+            const uint32_t frameB = (frameA + 1) % numAnimationFrames;
+            const float interpolationFactor = time * numAnimationFrames - frameA;
+
+            // Refit against rebuild
+            ScopeHistory frameRefit(options.numIterations), frameRebuild(options.numIterations);
+            for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                refittedBVH.refit(animation, frameA, frameB, interpolationFactor);
+                frameRefit.push(elapsed_ms(start));
+                refitHistory.push(frameRefit.last());
+
+                start = std::chrono::high_resolution_clock::now();
+                rebuiltBVH.build(animation, frameA, frameB, interpolationFactor);
+                frameRebuild.push(elapsed_ms(start));
+                rebuildHistory.push(frameRebuild.last());
+            }
+            const float refitCost = refittedBVH.stats().cost;
+            const float costRatio = refittedBVH.cost_ratio();
+
+            // Shadows of both trees, they trace the same triangles and have to match
+            rasterizer.render(animation, frameA, frameB, interpolationFactor, shadowView.viewProjection, shadowView.cameraPosition);
+            rasterizer.read_visibility_buffer(visibility);
+            ScopeHistory frameTrace(options.numIterations);
+            uint32_t numRays = 0;
+            for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                numRays = software_shadow::evaluate(refittedBVH, animation, frameA, frameB, interpolationFactor, visibility, shadowView, refittedShadow);
+                frameTrace.push(elapsed_ms(start));
+            }
+            software_shadow::evaluate(rebuiltBVH, animation, frameA, frameB, interpolationFactor, visibility, shadowView, rebuiltShadow);
+            const uint32_t numDifferences = software_shadow::count_differences(refittedShadow, rebuiltShadow);
+            const float traceMS = frameTrace.percentile(50.0f);
+            totalRays += numRays;
+            totalTraceMS += traceMS;
+
+            // Degraded trees are replaced
+            const bool rebuild = costRatio > options.rebuildThreshold;
+            if (rebuild)
+            {
+                refittedBVH.build(animation, frameA, frameB, interpolationFactor);
+                numRebuilds++;
+            }
+            printf("%u,%.3f,%.3f,%.3f,%.2f,%.2f,%.3f,%u,%u,%.3f,%.2f,%u\n", viewIdx, time, frameRefit.percentile(50.0f), frameRebuild.percentile(50.0f),
+                refitCost, rebuiltBVH.stats().cost, costRatio, rebuild ? 1 : 0, numRays, traceMS, traceMS > 0.0f ? numRays / (traceMS * 1e3f) : 0.0f, numDifferences);
+        }
+    }
+    printf("Refit: median %.3f ms, p95 %.3f ms\n", refitHistory.percentile(50.0f), refitHistory.percentile(95.0f));
+    printf("Rebuild: median %.3f ms, p95 %.3f ms\n", rebuildHistory.percentile(50.0f), rebuildHistory.percentile(95.0f));
+    printf("Shadow rays: %.2f Mrays/s, %u rebuilds\n", totalTraceMS > 0.0 ? totalRays / (totalTraceMS * 1e3) : 0.0, numRebuilds);
+
+    refittedBVH.release();
+    rebuiltBVH.release();
+    rasterizer.release();
+    task_scheduler::release();
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "tools/descriptor_ring.h"
+
+// System includes
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// Number of queues of the randomized run and frames a queue lags behind the recording
+#define NUM_TIMELINES 2
+#define FRAME_LATENCY 2
+
+static uint32_t random_uint(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// A block that doesn't fit at the end of the ring skips it, the skipped space comes back with the blocks before it
+static bool check_wrap_around()
+{
+    DescriptorRing ring;
+    ring.initialize(16);
+    bool success = ring.allocate(6) == 0 && ring.allocate(6) == 6;
+    ring.submit(0, 0, 1);
+    ring.submit(6, 0, 2);
+    ring.retire({ 1 });
+    success &= ring.used() == 6;
+
+    // [12, 16) is too small, the block goes at the start and the ring is full with the padding
+    success &= ring.allocate(6) == 0;
+    success &= ring.used() == 16;
+    success &= ring.allocate(1) == UINT32_MAX;
+
+    // The second block and the padding are released, the third one isn't submitted yet
+    ring.retire({ 2 });
+    success &= ring.used() == 6;
+    success &= ring.allocate(10) == 6;
+    success &= ring.allocate(1) == UINT32_MAX;
+    ring.submit(0, 0, 3);
+    ring.submit(6, 0, 3);
+    ring.retire({ 3 });
+    success &= ring.used() == 0;
+    ring.release();
+    return success;
+}
+
+// Blocks retire in allocation order, each one against the fence of its own queue
+static bool check_fence_timeline()
+{
+    DescriptorRing ring;
+    ring.initialize(64);
+    bool success = ring.allocate(8) == 0 && ring.allocate(8) == 8 && ring.allocate(8) == 16;
+    ring.submit(0, 0, 5);
+    ring.submit(8, 1, 3);
+    ring.submit(16, 0, 4);
+
+    // Not reached yet
+    ring.retire({ 4, 2 });
+    success &= ring.used() == 24;
+
+    // The first block goes, the second one waits on the compute queue and keeps the third one
+    ring.retire({ 5, 2 });
+    success &= ring.used() == 16;
+
+    // A timeline that isn't in the completed values is never reached
+    ring.retire({ 5 });
+    success &= ring.used() == 16;
+
+    ring.retire({ 5, 3 });
+    success &= ring.used() == 0;
+    ring.release();
+    return success;
+}
+
+// Blocks that were never submitted to a queue are given back as soon as the ones before them are
+static bool check_no_timeline()
+{
+    DescriptorRing ring;
+    ring.initialize(32);
+    bool success = ring.allocate(4) == 0 && ring.allocate(4) == 4;
+    ring.submit(4, DESCRIPTOR_RING_NO_TIMELINE, 0);
+
+    // The first block is still being recorded and keeps the second one
+    ring.retire({});
+    success &= ring.used() == 8;
+
+    ring.submit(0, DESCRIPTOR_RING_NO_TIMELINE, 0);
+    ring.retire({});
+    success &= ring.used() == 0;
+
+    // An empty ring restarts from the beginning
+    success &= ring.allocate(4) == 0;
+    ring.release();
+    return success;
+}
+
+// Frames of random blocks on several queues: a block never overlaps one in flight, and everything comes back once the queues are idle
+static bool check_random(uint32_t numFrames, uint32_t seed)
+{
+    struct LiveBlock { uint32_t offset, count, timeline; uint64_t fenceValue; };
+    const uint32_t capacity = 1024;
+    DescriptorRing ring;
+    ring.initialize(capacity);
+    std::deque<LiveBlock> liveBlocks;
+    std::vector<uint64_t> completedValues(NUM_TIMELINES, 0);
+    uint32_t state = seed;
+    bool success = true;
+
+    for (uint32_t frameIdx = 1; frameIdx <= numFrames; ++frameIdx)
+    {
+        const uint32_t numBlocks = 1 + random_uint(state) % 8;
+        for (uint32_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+        {
+            const uint32_t count = 1 + random_uint(state) % (capacity / 8);
+            const uint32_t offset = ring.allocate(count);
+            if (offset == UINT32_MAX)
+                continue;
+            success &= offset + count <= capacity;
+            for (const LiveBlock& live : liveBlocks)
+                success &= offset + count <= live.offset || live.offset + live.count <= offset;
+
+            // Some blocks are never executed
+            const uint32_t timeline = random_uint(state) % (NUM_TIMELINES + 1);
+            LiveBlock block = { offset, count, timeline == NUM_TIMELINES ? DESCRIPTOR_RING_NO_TIMELINE : timeline, frameIdx };
+            ring.submit(offset, block.timeline, block.fenceValue);
+            liveBlocks.push_back(block);
+        }
+
+        // The queues finish the frames in their own time, at most FRAME_LATENCY behind
+        for (uint32_t timeline = 0; timeline < NUM_TIMELINES; ++timeline)
+        {
+            if (frameIdx > FRAME_LATENCY && random_uint(state) % 2 == 0)
+                completedValues[timeline] = frameIdx - FRAME_LATENCY;
+        }
+        ring.retire(completedValues);
+        while (!liveBlocks.empty())
+        {
+            const LiveBlock& live = liveBlocks.front();
+            if (live.timeline != DESCRIPTOR_RING_NO_TIMELINE && completedValues[live.timeline] < live.fenceValue)
+                break;
+            liveBlocks.pop_front();
+        }
+
+        // The padding is the only thing the ring can count on top of the live blocks
+        uint32_t liveCount = 0;
+        for (const LiveBlock& live : liveBlocks)
+            liveCount += live.count;
+        success &= ring.used() >= liveCount && ring.used() <= capacity;
+    }
+
+    ring.retire(std::vector<uint64_t>(NUM_TIMELINES, UINT64_MAX));
+    success &= ring.used() == 0;
+    ring.release();
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numFrames = 100000;
+    uint32_t seed = 1;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        if (arg == "--frames" && argIdx + 1 < argc)
+            numFrames = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--seed" && argIdx + 1 < argc)
+            seed = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            printf("Usage: descriptor_ring_check [--frames count (default 100000)] [--seed value (default 1)]\n");
+            return -1;
+        }
+    }
+
+    struct CheckCase { const char* name; bool passed; };
+    const CheckCase cases[] = {
+        { "wrap_around", check_wrap_around() },
+        { "fence_timeline", check_fence_timeline() },
+        { "no_timeline", check_no_timeline() },
+        { "random_frames", check_random(numFrames, seed) } };
+
+    bool success = true;
+    printf("case,status\n");
+    for (const CheckCase& checkCase : cases)
+    {
+        printf("%s,%s\n", checkCase.name, checkCase.passed ? "ok" : "FAILED");
+        success &= checkCase.passed;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "graphics/event_collector.h"
+#include "tools/cpu_profiler.h"
+#include "tools/spsc_queue.h"
+
+// System includes
+#include <chrono>
+#include <mutex>
+#include <queue>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+
+struct BenchOptions
+{
+    // Events sent through the queues per run
+    uint32_t numEvents = 4000000;
+
+    // Capacity of the queues of the throughput runs
+    uint32_t capacity = EVENT_QUEUE_CAPACITY;
+
+    // Repetitions of every throughput run
+    uint32_t numIterations = 5;
+};
+
+static void print_usage()
+{
+    printf("Usage: event_queue_bench [options]\n");
+    printf("--events Events sent per run (default 4000000).\n");
+    printf("--capacity Capacity of the queues of the throughput runs (default %u).\n", EVENT_QUEUE_CAPACITY);
+    printf("--iterations Repetitions of every throughput run (default 5).\n");
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--events" && hasValue)
+            options.numEvents = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--capacity" && hasValue)
+            options.capacity = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--iterations" && hasValue)
+            options.numIterations = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.numEvents > 0 && options.capacity > 0 && options.numIterations > 0;
+}
+
+// Event carrying its sequence number in every field, so that a torn or reordered element is detected
+static EventData make_event(uint32_t sequence)
+{
+    return { (FrameEvent)(sequence % ((uint32_t)FrameEvent::Raw + 1)), sequence, (uint64_t)sequence * 0x9E3779B97F4A7C15ull, ~(int64_t)sequence };
+}
+
+static bool check_event(const EventData& event, uint32_t sequence)
+{
+    const EventData expected = make_event(sequence);
+    return event.type == expected.type && event.data0 == expected.data0 && event.data1 == expected.data1 && event.data2 == expected.data2;
+}
+
+// Every event goes through a queue of the given capacity in order, the producer retries when the queue is full
+static uint32_t stress_queue(uint32_t capacity, uint32_t numEvents)
+{
+    SPSCQueue<EventData> queue(capacity);
+    std::thread producer([&]()
+        {
+            for (uint32_t sequence = 0; sequence < numEvents; ++sequence)
+            {
+                while (!queue.push(make_event(sequence)))
+                    std::this_thread::yield();
+            }
+        });
+
+    uint32_t errors = 0;
+    EventData event;
+    for (uint32_t sequence = 0; sequence < numEvents; ++sequence)
+    {
+        while (!queue.pop(event))
+            std::this_thread::yield();
+        errors += check_event(event, sequence) ? 0 : 1;
+    }
+    producer.join();
+    errors += queue.pop(event) ? 1 : 0;
+    return errors;
+}
+
+// Window thread and render loop through the event collector: the events that aren't dropped arrive in order,
+// and the last draw request is always seen
+static uint32_t stress_collector(uint32_t numEvents, uint32_t& received, uint32_t& dropped, uint32_t& draws)
+{
+    event_collector::clear();
+    std::atomic<bool> done(false);
+    std::thread producer([&]()
+        {
+            for (uint32_t sequence = 0; sequence < numEvents; ++sequence)
+            {
+                event_collector::push_event(make_event(sequence));
+                if (sequence % 64 == 0)
+                    event_collector::request_draw();
+            }
+            event_collector::request_draw();
+            done.store(true, std::memory_order_release);
+        });
+
+    uint32_t errors = 0;
+    received = 0;
+    draws = 0;
+    int64_t lastSequence = -1;
+    bool lastRequestSeen = false;
+    EventData event;
+    while (!lastRequestSeen)
+    {
+        // Once the producer is done, whatever it pushed is visible
+        const bool producerDone = done.load(std::memory_order_acquire);
+        while (event_collector::peek_event(event))
+        {
+            errors += (int64_t)event.data0 > lastSequence && check_event(event, event.data0) ? 0 : 1;
+            lastSequence = event.data0;
+            received++;
+        }
+        if (event_collector::consume_draw_request())
+        {
+            draws++;
+            lastRequestSeen = producerDone;
+        }
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+    dropped = event_collector::dropped_events();
+    errors += received + dropped == numEvents ? 0 : 1;
+    event_collector::clear();
+    return errors;
+}
+
+// Events per second between two threads, the consumer drains the queue like the render loop
+template<typename Queue>
+static float throughput(Queue& queue, uint32_t numEvents)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    std::thread producer([&]()
+        {
+            for (uint32_t sequence = 0; sequence < numEvents; ++sequence)
+            {
+                while (!queue.push(make_event(sequence)))
+                    std::this_thread::yield();
+            }
+        });
+    EventData event;
+    for (uint32_t count = 0; count < numEvents;)
+    {
+        if (queue.pop(event))
+            count++;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return numEvents / (std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e6f);
+}
+
+// The previous event collector made thread safe with a lock, bounded like the ring
+class LockedQueue
+{
+public:
+    explicit LockedQueue(uint32_t capacity) : m_Capacity(capacity) {}
+
+    bool push(const EventData& event)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Queue.size() == m_Capacity)
+            return false;
+        m_Queue.push(event);
+        return true;
+    }
+
+    bool pop(EventData& event)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Queue.empty())
+            return false;
+        event = m_Queue.front();
+        m_Queue.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_Mutex;
+    std::queue<EventData> m_Queue;
+    size_t m_Capacity;
+};
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+    printf("%u events, capacity %u, %u hardware threads\n", options.numEvents, options.capacity, std::thread::hardware_concurrency());
+
+    // Stress, the small capacities keep the queue full or empty most of the time
+    uint32_t totalErrors = 0;
+    const uint32_t capacities[] = { 1, 2, 16, options.capacity };
+    for (uint32_t capacity : capacities)
+    {
+        const uint32_t errors = stress_queue(capacity, options.numEvents);
+        printf("Stress, capacity %u: %u errors\n", capacity, errors);
+        totalErrors += errors;
+    }
+    uint32_t received = 0, dropped = 0, draws = 0;
+    const uint32_t collectorErrors = stress_collector(options.numEvents, received, dropped, draws);
+    printf("Stress, event collector: %u received, %u dropped, %u draws, %u errors\n", received, dropped, draws, collectorErrors);
+    totalErrors += collectorErrors;
+
+    // Throughput
+    ScopeHistory ringHistory(options.numIterations);
+    ScopeHistory lockedHistory(options.numIterations);
+    for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+    {
+        SPSCQueue<EventData> ring(options.capacity);
+        ringHistory.push(throughput(ring, options.numEvents) / 1e6f);
+        LockedQueue locked(options.capacity);
+        lockedHistory.push(throughput(locked, options.numEvents) / 1e6f);
+    }
+    printf("queue,median_mevents_per_s,p5_mevents_per_s\n");
+    printf("spsc,%.2f,%.2f\n", ringHistory.percentile(50.0f), ringHistory.percentile(5.0f));
+    printf("mutex,%.2f,%.2f\n", lockedHistory.percentile(50.0f), lockedHistory.percentile(5.0f));
+    return totalErrors == 0 ? 0 : -1;
+}
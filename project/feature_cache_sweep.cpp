@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/feature_cache.h"
+#include "synthetic_ground.h"
+
+// System includes
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// Tile size of the classification
+#define CACHE_TILE_WIDTH 8
+#define CACHE_TILE_HEIGHT 4
+
+struct SweepOptions
+{
+    // Resolution of the synthetic frame
+    uint32_t width = 640;
+    uint32_t height = 360;
+
+    // Resolution of the latent space
+    uint32_t textureSize = 2048;
+
+    // Number of simulated frames per camera motion
+    uint32_t frames = 16;
+};
+
+// Camera motion applied between two frames
+struct CameraMotion
+{
+    const char* name;
+    float yawStep;
+    float forwardStep;
+};
+
+// Surface seen by a pixel in the current frame
+struct PixelSample
+{
+    FeatureCacheKey key;
+    float2 worldXZ = { 0.0f, 0.0f };
+    float2 uvDX = { 0.0f, 0.0f };
+    float2 uvDY = { 0.0f, 0.0f };
+};
+
+// History and statistics of one set of heuristics
+struct CacheSimulation
+{
+    FeatureCacheSettings settings;
+    std::vector<FeatureCacheKey> keys[2];
+    std::vector<float> features[2];
+    uint64_t coveredPixels = 0;
+    uint64_t reusedPixels = 0;
+    double squaredError = 0.0;
+};
+
+static void print_usage()
+{
+    printf("Usage: feature_cache_sweep [options]\n");
+    printf("--width Width of the synthetic frame (default 640).\n");
+    printf("--height Height of the synthetic frame (default 360).\n");
+    printf("--texture-size Resolution of the latent space (default 2048).\n");
+    printf("--frames Number of simulated frames per camera motion (default 16).\n");
+}
+
+static bool parse_args(int argc, char** argv, SweepOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--width" && hasValue)
+            options.width = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--height" && hasValue)
+            options.height = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--texture-size" && hasValue)
+            options.textureSize = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--frames" && hasValue)
+            options.frames = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.width > 0 && options.height > 0 && options.textureSize > 1 && options.frames > 1;
+}
+
+static void build_frame(const GroundCamera& camera, const FeatureField& field, uint32_t textureSize, std::vector<PixelSample>& samples, std::vector<float>& referenceFeatures)
+{
+    const float numMips = log2f((float)textureSize);
+    samples.assign(camera.width * camera.height, PixelSample());
+    referenceFeatures.assign(samples.size() * GROUND_NUM_FEATURES, 0.0f);
+
+    for (uint32_t y = 0; y < camera.height; ++y)
+    {
+        for (uint32_t x = 0; x < camera.width; ++x)
+        {
+            PixelSample& sample = samples[x + y * camera.width];
+            float2 worldRightXZ, worldBottomXZ;
+            sample.key.valid = ground_hit(camera, x + 0.5f, y + 0.5f, sample.worldXZ)
+                && ground_hit(camera, x + 1.5f, y + 0.5f, worldRightXZ)
+                && ground_hit(camera, x + 0.5f, y + 1.5f, worldBottomXZ);
+            if (!sample.key.valid)
+                continue;
+
+            // The derivatives ignore the island, like the barycentric ones of a triangle
+            float2 uv, uvRight, uvBottom, islandOffset, unusedOffset;
+            uint32_t unusedMaterial;
+            ground_surface(sample.worldXZ, uv, islandOffset, sample.key.material);
+            ground_surface(worldRightXZ, uvRight, unusedOffset, unusedMaterial);
+            ground_surface(worldBottomXZ, uvBottom, unusedOffset, unusedMaterial);
+            sample.key.uv = uv + islandOffset;
+            sample.uvDX = uvRight - uv;
+            sample.uvDY = uvBottom - uv;
+
+            // Same LOD as compute_lod with the filtering enabled
+            float footprint = std::max(length(sample.uvDX), length(sample.uvDY));
+            float lodLevel = log2f(std::max(footprint * textureSize, 1e-8f));
+            sample.key.lod = clamp(lodLevel / numMips, 0.0f, 1.0f);
+            evaluate_field(field, sample.key.uv, footprint, referenceFeatures.data() + (x + y * camera.width) * GROUND_NUM_FEATURES);
+        }
+    }
+}
+
+// Same decisions as FirstPass.compute, the reused pixels copy the features of the previous frame
+static void simulate_frame(const GroundCamera& camera, const GroundCamera& prevCamera, uint32_t frameIndex, float numMips,
+    const std::vector<PixelSample>& samples, const std::vector<float>& referenceFeatures, CacheSimulation& simulation)
+{
+    const uint32_t currentIdx = frameIndex % 2;
+    const std::vector<FeatureCacheKey>& prevKeys = simulation.keys[1 - currentIdx];
+    const std::vector<float>& prevFeatures = simulation.features[1 - currentIdx];
+    std::vector<FeatureCacheKey>& keys = simulation.keys[currentIdx];
+    std::vector<float>& features = simulation.features[currentIdx];
+    keys.resize(samples.size());
+    features.resize(referenceFeatures.size());
+
+    const uint32_t tileCountX = (camera.width + CACHE_TILE_WIDTH - 1) / CACHE_TILE_WIDTH;
+    for (uint32_t pixelIdx = 0; pixelIdx < (uint32_t)samples.size(); ++pixelIdx)
+    {
+        const PixelSample& sample = samples[pixelIdx];
+        keys[pixelIdx] = sample.key;
+        if (!sample.key.valid)
+            continue;
+
+        // Look for the pixel of the previous frame that saw the same point
+        uint32_t x = pixelIdx % camera.width;
+        uint32_t y = pixelIdx / camera.width;
+        uint32_t tileIdx = x / CACHE_TILE_WIDTH + (y / CACHE_TILE_HEIGHT) * tileCountX;
+        uint32_t sourceIdx = FEATURE_CACHE_NO_REUSE;
+        float2 prevCoords;
+        if (frameIndex > 0 && !feature_cache::is_refresh_tile(tileIdx, frameIndex, simulation.settings.refreshPeriod)
+            && ground_project(prevCamera, sample.worldXZ, prevCoords)
+            && prevCoords.x >= 0.0f && prevCoords.y >= 0.0f && prevCoords.x < camera.width && prevCoords.y < camera.height)
+        {
+            uint32_t prevPixelIdx = (uint32_t)prevCoords.x + (uint32_t)prevCoords.y * camera.width;
+            if (feature_cache::validate_reuse(sample.key, sample.uvDX, sample.uvDY, prevKeys[prevPixelIdx], simulation.settings, numMips))
+                sourceIdx = prevPixelIdx;
+        }
+
+        // Copy or infer
+        const float* reference = referenceFeatures.data() + pixelIdx * GROUND_NUM_FEATURES;
+        const float* source = sourceIdx != FEATURE_CACHE_NO_REUSE ? prevFeatures.data() + sourceIdx * GROUND_NUM_FEATURES : reference;
+        std::copy(source, source + GROUND_NUM_FEATURES, features.data() + pixelIdx * GROUND_NUM_FEATURES);
+
+        // The first frame can't reuse anything, keep it out of the statistics
+        if (frameIndex == 0)
+            continue;
+        simulation.coveredPixels++;
+        if (sourceIdx == FEATURE_CACHE_NO_REUSE)
+            continue;
+        simulation.reusedPixels++;
+        for (uint32_t featIdx = 0; featIdx < GROUND_NUM_FEATURES; ++featIdx)
+        {
+            double error = source[featIdx] - reference[featIdx];
+            simulation.squaredError += error * error;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SweepOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // Synthetic scene
+    FeatureField field;
+    build_field(options.textureSize, field);
+    const float numMips = log2f((float)options.textureSize);
+
+    // Camera motions to simulate, in radians and meters per frame
+    const CameraMotion motions[] = { { "static", 0.0f, 0.0f }, { "walk", 0.0f, 0.025f }, { "pan", 0.002f, 0.0f }, { "fast_pan", 0.01f, 0.0f } };
+
+    // Heuristics to sweep
+    std::vector<FeatureCacheSettings> sweep;
+    const uint32_t refreshPeriods[] = { 4, 8, 16 };
+    const float maxUVDeltas[] = { 0.25f, 0.5f, 1.0f };
+    for (uint32_t refreshPeriod : refreshPeriods)
+    {
+        for (float maxUVDelta : maxUVDeltas)
+            sweep.push_back({ refreshPeriod, maxUVDelta, 0.25f });
+    }
+
+    printf("%ux%u frame, %u frames, %ux%u latent space\n", options.width, options.height, options.frames, options.textureSize, options.textureSize);
+    printf("motion,refresh_period,max_uv_delta,max_mip_delta,reused_ratio,psnr_db\n");
+    for (const CameraMotion& motion : motions)
+    {
+        std::vector<CacheSimulation> simulations(sweep.size());
+        for (uint32_t simIdx = 0; simIdx < (uint32_t)sweep.size(); ++simIdx)
+            simulations[simIdx].settings = sweep[simIdx];
+
+        // Every simulation sees the same frames
+        GroundCamera camera, prevCamera;
+        camera.width = options.width;
+        camera.height = options.height;
+        std::vector<PixelSample> samples;
+        std::vector<float> referenceFeatures;
+        for (uint32_t frameIdx = 0; frameIdx < options.frames; ++frameIdx)
+        {
+            build_frame(camera, field, options.textureSize, samples, referenceFeatures);
+            for (CacheSimulation& simulation : simulations)
+                simulate_frame(camera, prevCamera, frameIdx, numMips, samples, referenceFeatures, simulation);
+
+            // Move forward along the view direction and turn
+            prevCamera = camera;
+            camera.yaw += motion.yawStep;
+            camera.position.x += sinf(camera.yaw) * motion.forwardStep;
+            camera.position.z += cosf(camera.yaw) * motion.forwardStep;
+        }
+
+        for (const CacheSimulation& simulation : simulations)
+        {
+            double reusedRatio = simulation.coveredPixels > 0 ? simulation.reusedPixels / (double)simulation.coveredPixels : 0.0;
+            double mse = simulation.coveredPixels > 0 ? simulation.squaredError / (simulation.coveredPixels * GROUND_NUM_FEATURES) : 0.0;
+            double psnr = mse > 0.0 ? 10.0 * log10(1.0 / mse) : 100.0;
+            printf("%s,%u,%.2f,%.2f,%.3f,%.2f\n", motion.name, simulation.settings.refreshPeriod, simulation.settings.maxUVDelta, simulation.settings.maxMipDelta, reusedRatio, psnr);
+        }
+    }
+    return 0;
+}
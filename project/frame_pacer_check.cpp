@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "graphics/backend.h"
+#include "null/null_backend.h"
+#include "tools/frame_pacer.h"
+
+// System includes
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct CheckOptions
+{
+    // Frames recorded per run
+    uint32_t numFrames = 200;
+
+    // Simulated GPU duration of a frame and CPU time to record it
+    uint32_t gpuUs = 2000;
+    uint32_t cpuUs = 500;
+};
+
+struct PacingResult
+{
+    uint32_t errors = 0;
+    uint32_t maxInFlight = 0;
+    float msPerFrame = 0.0f;
+};
+
+static void print_usage()
+{
+    printf("Usage: frame_pacer_check [options]\n");
+    printf("--frames Frames recorded per run (default 200).\n");
+    printf("--gpu-us Simulated GPU duration of a frame in microseconds (default 2000).\n");
+    printf("--cpu-us CPU time to record a frame in microseconds (default 500).\n");
+}
+
+static bool parse_args(int argc, char** argv, CheckOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--frames" && hasValue)
+            options.numFrames = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--gpu-us" && hasValue)
+            options.gpuUs = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--cpu-us" && hasValue)
+            options.cpuUs = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.numFrames > 0;
+}
+
+// Render loop of the renderers on the null backend: one command buffer per slot, a single fence for all of them
+static PacingResult run_pacing(GraphicsDevice device, uint32_t framesInFlight, const CheckOptions& options)
+{
+    PacingResult result;
+    CommandQueue queue = graphics::command_queue::create_command_queue(device);
+    Fence fence = graphics::fence::create_fence(device, 0);
+    std::vector<CommandBuffer> cmdBuffers(framesInFlight);
+    for (CommandBuffer& cmd : cmdBuffers)
+        cmd = graphics::command_buffer::create_command_buffer(device);
+    std::vector<uint64_t> slotSubmittedValues(framesInFlight, 0);
+
+    FramePacer pacer;
+    pacer.initialize(framesInFlight);
+    null_backend::device::set_command_duration(device, options.gpuUs * 1000ull);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frameIdx = 0; frameIdx < options.numFrames; ++frameIdx)
+    {
+        // Round robin over the slots, the wait value is the one of the frame that used the slot last
+        uint64_t waitValue = 0;
+        const uint32_t slot = pacer.begin_frame(waitValue);
+        result.errors += slot == frameIdx % framesInFlight ? 0 : 1;
+        result.errors += waitValue == (frameIdx >= framesInFlight ? frameIdx - framesInFlight + 1 : 0) ? 0 : 1;
+        graphics::fence::wait_value(fence, waitValue);
+
+        // The GPU is done with the resources of the slot, and never more than framesInFlight - 1 frames are still running
+        const uint64_t completedValue = graphics::fence::get_value(fence);
+        result.errors += completedValue >= slotSubmittedValues[slot] ? 0 : 1;
+        const uint32_t inFlight = (uint32_t)(pacer.last_submitted_value() - completedValue);
+        result.errors += inFlight < framesInFlight ? 0 : 1;
+        result.maxInFlight = std::max(result.maxInFlight, inFlight);
+
+        // Record
+        CommandBuffer cmd = cmdBuffers[slot];
+        graphics::command_buffer::reset(cmd);
+        std::this_thread::sleep_for(std::chrono::microseconds(options.cpuUs));
+        graphics::command_buffer::dispatch(cmd, 0, 1, 1, 1);
+        graphics::command_buffer::close(cmd);
+
+        // Submit and signal, the values are strictly increasing
+        graphics::command_queue::execute_command_buffer(queue, cmd);
+        const uint64_t signalValue = pacer.end_frame();
+        result.errors += signalValue == frameIdx + 1 ? 0 : 1;
+        graphics::command_queue::signal(queue, fence, signalValue);
+        slotSubmittedValues[slot] = signalValue;
+    }
+
+    // Drain
+    graphics::fence::wait_value(fence, pacer.last_submitted_value());
+    result.errors += graphics::fence::get_value(fence) == options.numFrames ? 0 : 1;
+    auto stop = std::chrono::high_resolution_clock::now();
+    result.msPerFrame = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f / options.numFrames;
+
+    pacer.release();
+    for (CommandBuffer cmd : cmdBuffers)
+        graphics::command_buffer::destroy_command_buffer(cmd);
+    graphics::fence::destroy_fence(fence);
+    graphics::command_queue::destroy_command_queue(queue);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    CheckOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    graphics::setup_graphics_api(GraphicsAPI::Null);
+    GraphicsDevice device = graphics::device::create_graphics_device();
+    printf("%u frames, %u us on the GPU and %u us on the CPU per frame\n", options.numFrames, options.gpuUs, options.cpuUs);
+
+    // With one frame in flight the CPU and the GPU take turns, with more they overlap and the slower one sets the pace
+    const float serialMs = (options.gpuUs + options.cpuUs) / 1e3f;
+    const float overlappedMs = std::max(options.gpuUs, options.cpuUs) / 1e3f;
+    bool success = true;
+    printf("frames_in_flight,ms_per_frame,expected_ms,max_in_flight,errors,status\n");
+    for (uint32_t framesInFlight = 1; framesInFlight <= 3; ++framesInFlight)
+    {
+        const PacingResult result = run_pacing(device, framesInFlight, options);
+        const float expectedMs = framesInFlight == 1 ? serialMs : overlappedMs;
+
+        // Sleeps overshoot, the pace only has to be closer to the expected one than to the other
+        const bool paced = fabsf(result.msPerFrame - expectedMs) <= fabsf(result.msPerFrame - (framesInFlight == 1 ? overlappedMs : serialMs)) || serialMs == overlappedMs;
+        const bool passed = result.errors == 0 && paced;
+        printf("%u,%.3f,%.3f,%u,%u,%s\n", framesInFlight, result.msPerFrame, expectedMs, result.maxInFlight, result.errors, passed ? "ok" : "FAILED");
+        success &= passed;
+    }
+
+    graphics::device::destroy_graphics_device(device);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/gbuffer_codec.h"
+
+// System includes
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+// Worst error tolerated for every group of channels
+#define DIFFUSE_MAX_ERROR (1.0f / 512.0f + 1e-5f)
+#define UNORM8_MAX_ERROR (0.5f / 255.0f + 1e-6f)
+#define UNORM16_MAX_ERROR (0.5f / 65535.0f + 1e-6f)
+#define NORMAL_MAX_ERROR_DEG 0.02f
+
+struct CodecError
+{
+    const char* name;
+    float maxError;
+    double sumError;
+    float tolerance;
+};
+
+static float random_float(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0f;
+}
+
+static void random_channels(uint32_t& state, float* channels)
+{
+    for (uint32_t channelIdx = 0; channelIdx < GBUFFER_NUM_CHANNELS; ++channelIdx)
+        channels[channelIdx] = random_float(state);
+
+    // Uniform direction on the sphere, remapped like the network output
+    float z = random_float(state) * 2.0f - 1.0f;
+    float phi = random_float(state) * (float)TWO_PI;
+    float r = sqrtf(std::max(1.0f - z * z, 0.0f));
+    channels[GBUFFER_NORMAL_OFFSET] = r * cosf(phi) * 0.5f + 0.5f;
+    channels[GBUFFER_NORMAL_OFFSET + 1] = r * sinf(phi) * 0.5f + 0.5f;
+    channels[GBUFFER_NORMAL_OFFSET + 2] = z * 0.5f + 0.5f;
+}
+
+static void accumulate(CodecError& error, float value)
+{
+    error.maxError = std::max(error.maxError, value);
+    error.sumError += value;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numSamples = 1000000;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        if (arg == "--samples" && argIdx + 1 < argc)
+            numSamples = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            printf("Usage: gbuffer_codec_check [--samples count (default 1000000)]\n");
+            return -1;
+        }
+    }
+
+    CodecError errors[] = {
+        { "diffuse", 0.0f, 0.0, DIFFUSE_MAX_ERROR },
+        { "normal_deg", 0.0f, 0.0, NORMAL_MAX_ERROR_DEG },
+        { "ao_roughness_metalness_thickness", 0.0f, 0.0, UNORM8_MAX_ERROR },
+        { "mask", 0.0f, 0.0, UNORM8_MAX_ERROR },
+        { "displacement", 0.0f, 0.0, UNORM16_MAX_ERROR } };
+
+    // Axis aligned normals and channels at the bounds of their range, then random ones
+    const float3 axes[] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    const uint32_t numEdgeCases = 12;
+    uint32_t state = 0x2545F491u;
+    for (uint32_t sampleIdx = 0; sampleIdx < numEdgeCases + numSamples; ++sampleIdx)
+    {
+        float channels[GBUFFER_NUM_CHANNELS];
+        if (sampleIdx < numEdgeCases)
+        {
+            const float3& axis = axes[sampleIdx % 6];
+            for (uint32_t channelIdx = 0; channelIdx < GBUFFER_NUM_CHANNELS; ++channelIdx)
+                channels[channelIdx] = sampleIdx < 6 ? 0.0f : 1.0f;
+            channels[GBUFFER_NORMAL_OFFSET] = axis.x * 0.5f + 0.5f;
+            channels[GBUFFER_NORMAL_OFFSET + 1] = axis.y * 0.5f + 0.5f;
+            channels[GBUFFER_NORMAL_OFFSET + 2] = axis.z * 0.5f + 0.5f;
+        }
+        else
+            random_channels(state, channels);
+
+        float decoded[GBUFFER_NUM_CHANNELS];
+        gbuffer_codec::decode(gbuffer_codec::encode(channels), decoded);
+
+        // The diffuse error is relative to the brightest channel, like the precision of the shared exponent
+        float maxDiffuse = std::max(max3(channels[GBUFFER_DIFFUSE_OFFSET], channels[GBUFFER_DIFFUSE_OFFSET + 1], channels[GBUFFER_DIFFUSE_OFFSET + 2]), 1e-6f);
+        for (uint32_t channelIdx = 0; channelIdx < 3; ++channelIdx)
+            accumulate(errors[0], fabsf(decoded[GBUFFER_DIFFUSE_OFFSET + channelIdx] - channels[GBUFFER_DIFFUSE_OFFSET + channelIdx]) / maxDiffuse);
+
+        float3 normal = normalize(float3({ channels[GBUFFER_NORMAL_OFFSET] * 2.0f - 1.0f, channels[GBUFFER_NORMAL_OFFSET + 1] * 2.0f - 1.0f, channels[GBUFFER_NORMAL_OFFSET + 2] * 2.0f - 1.0f }));
+        float3 decodedNormal = { decoded[GBUFFER_NORMAL_OFFSET] * 2.0f - 1.0f, decoded[GBUFFER_NORMAL_OFFSET + 1] * 2.0f - 1.0f, decoded[GBUFFER_NORMAL_OFFSET + 2] * 2.0f - 1.0f };
+
+        // atan2 stays accurate for the tiny angles where acos doesn't
+        accumulate(errors[1], atan2f(length(cross(normal, decodedNormal)), dot(normal, decodedNormal)) * (float)(180.0 / PI));
+
+        const uint32_t unormChannels[] = { GBUFFER_AO_OFFSET, GBUFFER_ROUGHNESS_OFFSET, GBUFFER_METALNESS_OFFSET, GBUFFER_THICKNESS_OFFSET };
+        for (uint32_t channelIdx : unormChannels)
+            accumulate(errors[2], fabsf(decoded[channelIdx] - channels[channelIdx]));
+        accumulate(errors[3], fabsf(decoded[GBUFFER_MASK_OFFSET] - channels[GBUFFER_MASK_OFFSET]));
+        accumulate(errors[3], fabsf(decoded[GBUFFER_MASK_OFFSET + 1] - channels[GBUFFER_MASK_OFFSET + 1]));
+        accumulate(errors[4], fabsf(decoded[GBUFFER_DISPLACEMENT_OFFSET] - channels[GBUFFER_DISPLACEMENT_OFFSET]));
+    }
+
+    // Report
+    printf("%u samples, %u bytes per pixel instead of %u\n", numEdgeCases + numSamples, (uint32_t)GBUFFER_PIXEL_SIZE, (uint32_t)(GBUFFER_NUM_CHANNELS * sizeof(uint16_t)));
+    printf("channels,max_error,mean_error,tolerance,status\n");
+    bool success = true;
+    const uint32_t numValues[] = { 3, 1, 4, 2, 1 };
+    for (uint32_t groupIdx = 0; groupIdx < 5; ++groupIdx)
+    {
+        const CodecError& error = errors[groupIdx];
+        bool passed = error.maxError <= error.tolerance;
+        success &= passed;
+        printf("%s,%.7f,%.7f,%.7f,%s\n", error.name, error.maxError, error.sumError / ((double)(numEdgeCases + numSamples) * numValues[groupIdx]), error.tolerance, passed ? "ok" : "FAILED");
+    }
+    return success ? 0 : 1;
+}
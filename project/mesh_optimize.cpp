@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "scene/mesh_optimizer.h"
+
+// System includes
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct OptimizeOptions
+{
+    // Animation to reorder, written in the same version
+    std::string input;
+    std::string output;
+
+    MeshOptimizerOptions optimizer;
+
+    // Key frame interval of the version 2 outputs
+    uint32_t keyframeInterval = MESH_ANIMATION_DEFAULT_KEYFRAME_INTERVAL;
+};
+
+static void print_usage()
+{
+    printf("Usage: mesh_optimize [options] input.anim output.anim\n");
+    printf("--cache-size Entries of the simulated post transform cache (default %u).\n", MESH_OPTIMIZER_CACHE_SIZE);
+    printf("--overdraw-threshold ACMR factor of the overdraw clusters, below 1 disables the overdraw ordering (default %.2f).\n", MESH_OPTIMIZER_OVERDRAW_THRESHOLD);
+    printf("--no-fetch Keeps the order of the vertices.\n");
+    printf("--keyframe-interval Key frame interval of the quantized outputs (default %u).\n", MESH_ANIMATION_DEFAULT_KEYFRAME_INTERVAL);
+}
+
+static bool parse_args(int argc, char** argv, OptimizeOptions& options)
+{
+    std::vector<std::string> paths;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--cache-size" && hasValue)
+            options.optimizer.cacheSize = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--overdraw-threshold" && hasValue)
+            options.optimizer.overdrawThreshold = (float)atof(argv[++argIdx]);
+        else if (arg == "--no-fetch")
+            options.optimizer.optimizeFetch = false;
+        else if (arg == "--keyframe-interval" && hasValue)
+            options.keyframeInterval = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg.size() > 2 && arg[0] == '-' && arg[1] == '-')
+        {
+            print_usage();
+            return false;
+        }
+        else
+            paths.push_back(arg);
+    }
+    if (paths.size() != 2 || options.optimizer.cacheSize < 3)
+    {
+        print_usage();
+        return false;
+    }
+    options.input = paths[0];
+    options.output = paths[1];
+    return true;
+}
+
+static void print_stats(const char* name, const std::vector<uint3>& indices, uint32_t numVertices, uint32_t vertexSize, uint32_t cacheSize)
+{
+    const VertexCacheStats cache = mesh_optimizer::analyze_vertex_cache(indices, numVertices, cacheSize);
+    const VertexCacheStats cache32 = mesh_optimizer::analyze_vertex_cache(indices, numVertices, 32);
+    const VertexFetchStats fetch = mesh_optimizer::analyze_vertex_fetch(indices, numVertices, vertexSize);
+    printf("%s,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f\n", name, cache.acmr, cache.atvr, cache32.acmr, cache32.atvr, fetch.overfetch, fetch.fetchedBytes / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    OptimizeOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // The quantized animations stay quantized
+    const bool quantized = mesh::is_quantized_mesh_animation(options.input.c_str());
+    MeshAnimation animation;
+    QuantizedMeshAnimation quantizedAnimation;
+    if (quantized)
+        mesh::import_quantized_mesh_animation(options.input.c_str(), quantizedAnimation);
+    else
+        mesh::import_mesh_animation(options.input.c_str(), animation);
+    std::vector<uint3>& indices = quantized ? quantizedAnimation.indexBuffer : animation.indexBuffer;
+    const uint32_t numVertices = quantized ? (uint32_t)quantizedAnimation.sharedVertices.size() : (uint32_t)animation.vertexBufferArray[0].data.size();
+    const uint32_t numFrames = quantized ? (uint32_t)quantizedAnimation.frames.size() : (uint32_t)animation.vertexBufferArray.size();
+    const uint32_t vertexSize = quantized ? sizeof(QuantizedVertexData) : sizeof(VertexData);
+    printf("%u triangles, %u vertices, %u frames, cache of %u vertices\n", (uint32_t)indices.size(), numVertices, numFrames, options.optimizer.cacheSize);
+
+    printf("order,acmr,atvr,acmr_32,atvr_32,overfetch,fetched_mb\n");
+    print_stats("input", indices, numVertices, vertexSize, options.optimizer.cacheSize);
+    auto start = std::chrono::high_resolution_clock::now();
+    const MeshOptimizerResult result = quantized ? mesh_optimizer::optimize_mesh_animation(quantizedAnimation, options.optimizer)
+        : mesh_optimizer::optimize_mesh_animation(animation, options.optimizer);
+    auto stop = std::chrono::high_resolution_clock::now();
+    print_stats("optimized", indices, numVertices, vertexSize, options.optimizer.cacheSize);
+    printf("Optimized in %.1f ms\n", std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f);
+
+    // The steps that would have made the input worse are dropped
+    if (!result.reorderedTriangles)
+        printf("Kept the input triangle order, the optimized one transforms or fetches more vertices.\n");
+    if (!result.remappedVertices && options.optimizer.optimizeFetch)
+        printf("Kept the input vertex order, the first use order fetches more.\n");
+
+    if (quantized)
+        mesh::export_quantized_mesh_animation(quantizedAnimation, options.output.c_str(), options.keyframeInterval);
+    else
+        mesh::export_mesh_animation(animation, options.output.c_str());
+    return 0;
+}
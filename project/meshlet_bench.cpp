@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "bench_scene.h"
+#include "render_pipeline/software_rasterizer.h"
+#include "scene/meshlet.h"
+#include "scene/skinning.h"
+#include "tools/cpu_profiler.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+static void print_usage()
+{
+    print_bench_usage("meshlet_bench");
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!parse_bench_args(argc, argv, options, print_usage, [](const std::string&, bool, int&) { return false; }))
+        return -1;
+
+    // Scene, the synthetic field spreads past the frustum so that the culling has meshlets to reject
+    MeshAnimation animation;
+    std::vector<BenchView> views;
+    if (!load_bench_scene(options, animation, views, true))
+        return -1;
+    const uint32_t numAnimationFrames = (uint32_t)animation.vertexBufferArray.size();
+    const uint32_t numTriangles = (uint32_t)animation.indexBuffer.size();
+
+    task_scheduler::initialize(options.numThreads);
+    SoftwareRasterizer rasterizer;
+    rasterizer.initialize(options.width, options.height);
+
+    // Meshlets of the first frame, like SkinnedMeshRenderer
+    std::vector<float3> positions;
+    skinning::skin_positions(animation, skinning::animation_frame(numAnimationFrames, 0.0f), positions);
+    MeshletMesh meshlets;
+    auto start = std::chrono::high_resolution_clock::now();
+    meshlet::build(animation.indexBuffer, positions, meshlets);
+    auto stop = std::chrono::high_resolution_clock::now();
+    const uint32_t numMeshlets = (uint32_t)meshlets.meshlets.size();
+    printf("%u triangles, %u vertices, %u threads\n", numTriangles, (uint32_t)positions.size(), task_scheduler::num_threads());
+    printf("%u meshlets, %.1f vertices and %.1f triangles per meshlet, built in %.3f ms\n", numMeshlets, meshlets.vertices.size() / (float)numMeshlets,
+        numTriangles / (float)numMeshlets, std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f);
+
+    // Every view at a few times of the animation: refit, cull, and check that no pixel of the visibility buffer comes from a culled meshlet
+    ScopeHistory refitHistory(views.size() * options.numFrames * options.numIterations);
+    ScopeHistory cullHistory(views.size() * options.numFrames * options.numIterations);
+    std::vector<MeshletBounds> bounds;
+    std::vector<uint32_t> visibleTriangles;
+    std::vector<uint8_t> visibleFlags;
+    std::vector<uint32_t> visibility;
+    uint32_t totalMissedPixels = 0;
+    float visibleSum = 0.0f;
+    printf("view,time,visible_meshlets,frustum_culled,backface_culled,visible_triangles_pct,missed_pixels,refit_ms,cull_ms\n");
+    for (uint32_t viewIdx = 0; viewIdx < (uint32_t)views.size(); ++viewIdx)
+    {
+        const float4x4 viewProjection = view_projection(views[viewIdx], options.width / (float)options.height);
+        const MeshletCullingView cullingView = meshlet::culling_view(viewProjection, views[viewIdx].position);
+        for (uint32_t frameIdx = 0; frameIdx < options.numFrames; ++frameIdx)
+        {
+            const float time = frameIdx / (float)options.numFrames;
+            const SkinningFrame frame = skinning::animation_frame(numAnimationFrames, time);
+            skinning::skin_positions(animation, frame, positions);
+
+            ScopeHistory frameRefit(options.numIterations);
+            ScopeHistory frameCull(options.numIterations);
+            MeshletCullingStats stats;
+            for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                meshlet::compute_bounds(meshlets, animation.indexBuffer, positions, bounds);
+                stop = std::chrono::high_resolution_clock::now();
+                float durationMS = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f;
+                frameRefit.push(durationMS);
+                refitHistory.push(durationMS);
+
+                start = std::chrono::high_resolution_clock::now();
+                stats = meshlet::cull(meshlets, bounds, cullingView, visibleTriangles);
+                stop = std::chrono::high_resolution_clock::now();
+                durationMS = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f;
+                frameCull.push(durationMS);
+                cullHistory.push(durationMS);
+            }
+
+            // The culling has to be conservative
+            rasterizer.render(animation, frame.frameA, frame.frameB, frame.interpolationFactor, viewProjection, views[viewIdx].position);
+            rasterizer.read_visibility_buffer(visibility);
+            visibleFlags.assign(numTriangles, 0);
+            for (uint32_t primitiveID : visibleTriangles)
+                visibleFlags[primitiveID] = 1;
+            uint32_t missedPixels = 0;
+            for (uint32_t value : visibility)
+                missedPixels += value != SOFTWARE_RASTER_EMPTY_PIXEL && !visibleFlags[value & 0x7FFFFFFF] ? 1 : 0;
+            totalMissedPixels += missedPixels;
+
+            const float visiblePct = 100.0f * stats.visibleTriangles / numTriangles;
+            visibleSum += visiblePct;
+            printf("%u,%.3f,%u,%u,%u,%.1f,%u,%.3f,%.3f\n", viewIdx, time, stats.visibleMeshlets, stats.frustumCulled, stats.backfaceCulled, visiblePct,
+                missedPixels, frameRefit.percentile(50.0f), frameCull.percentile(50.0f));
+        }
+    }
+    printf("Visible triangles: %.1f%% on average, missed pixels: %u\n", visibleSum / (views.size() * options.numFrames), totalMissedPixels);
+    printf("Refit: median %.3f ms, p95 %.3f ms. Culling: median %.3f ms, p95 %.3f ms\n", refitHistory.percentile(50.0f), refitHistory.percentile(95.0f),
+        cullHistory.percentile(50.0f), cullHistory.percentile(95.0f));
+
+    rasterizer.release();
+    task_scheduler::release();
+    return totalMissedPixels == 0 ? 0 : -1;
+}
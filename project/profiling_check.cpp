@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "graphics/backend.h"
+#include "null/null_backend.h"
+#include "tools/profiling_helper.h"
+
+// System includes
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Frames in flight of the profiling helper, a frame is read back that many frames later
+#define NUM_FRAMES_IN_FLIGHT 2
+
+// Time between the submission of a command buffer and the first GPU timestamp, covers the scheduling of the check itself
+#define ALIGNMENT_TOLERANCE_US 200.0
+
+struct CheckOptions
+{
+    // Frames recorded
+    uint32_t numFrames = 50;
+
+    // Simulated GPU duration of a pass and CPU time spent recording before the submission
+    uint32_t gpuUs = 1000;
+    uint32_t cpuUs = 2000;
+};
+
+struct CheckResult
+{
+    uint32_t framesRead = 0;
+    uint32_t durationErrors = 0;
+    uint32_t nestingErrors = 0;
+    uint32_t cpuAlignmentErrors = 0;
+    uint32_t queueAlignmentErrors = 0;
+    double maxSubmitOffsetUS = 0.0;
+};
+
+static void print_usage()
+{
+    printf("Usage: profiling_check [options]\n");
+    printf("--frames Frames recorded (default 50).\n");
+    printf("--gpu-us Simulated GPU duration of a pass in microseconds (default 1000).\n");
+    printf("--cpu-us CPU time spent recording a frame in microseconds (default 2000).\n");
+}
+
+static bool parse_args(int argc, char** argv, CheckOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--frames" && hasValue)
+            options.numFrames = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--gpu-us" && hasValue)
+            options.gpuUs = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--cpu-us" && hasValue)
+            options.cpuUs = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.numFrames > NUM_FRAMES_IN_FLIGHT && options.gpuUs > 0;
+}
+
+static const TraceEvent* find_event(const std::vector<TraceEvent>& events, const char* name)
+{
+    for (const TraceEvent& gpuEvent : events)
+    {
+        if (gpuEvent.name == name)
+            return &gpuEvent;
+    }
+    return nullptr;
+}
+
+// Scopes of a frame that was read back, recorded as:
+// Direct: Frame { Pass A, Pass B }, Compute: Async, both submitted at submitUS
+static void check_frame(const std::vector<TraceEvent>& events, double submitUS, const CheckOptions& options, CheckResult& result)
+{
+    const TraceEvent* frame = find_event(events, "Frame");
+    const TraceEvent* passA = find_event(events, "Pass A");
+    const TraceEvent* passB = find_event(events, "Pass B");
+    const TraceEvent* async = find_event(events, "Async");
+    if (events.size() != 4 || frame == nullptr || passA == nullptr || passB == nullptr || async == nullptr)
+    {
+        result.nestingErrors++;
+        return;
+    }
+    result.framesRead++;
+
+    // The simulated GPU runs every pass for exactly gpuUs, the ticks are 10ns
+    auto close = [](double a, double b) { return fabs(a - b) <= 0.05; };
+    result.durationErrors += close(passA->durationUS, options.gpuUs) && close(passB->durationUS, options.gpuUs) && close(async->durationUS, options.gpuUs) ? 0 : 1;
+    result.durationErrors += close(frame->durationUS, 2.0 * options.gpuUs) ? 0 : 1;
+
+    // The passes are inside the frame, one after the other
+    result.nestingErrors += frame->depth == 0 && passA->depth == 1 && passB->depth == 1 && async->depth == 0 ? 0 : 1;
+    result.nestingErrors += close(passA->startUS, frame->startUS) && close(passB->startUS, passA->startUS + passA->durationUS) ? 0 : 1;
+    result.nestingErrors += frame->thread == 0 && async->thread == 1 ? 0 : 1;
+
+    // The GPU starts when the command buffers are submitted, not when the frame started recording
+    const double submitOffsetUS = frame->startUS - submitUS;
+    result.maxSubmitOffsetUS = std::max(result.maxSubmitOffsetUS, fabs(submitOffsetUS));
+    result.cpuAlignmentErrors += submitOffsetUS >= -1.0 && submitOffsetUS <= ALIGNMENT_TOLERANCE_US ? 0 : 1;
+
+    // Both queues started together
+    result.queueAlignmentErrors += fabs(async->startUS - frame->startUS) <= ALIGNMENT_TOLERANCE_US ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    CheckOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    graphics::setup_graphics_api(GraphicsAPI::Null);
+    GraphicsDevice device = graphics::device::create_graphics_device();
+    CommandQueue queue = graphics::command_queue::create_command_queue(device);
+    CommandBuffer directCmd = graphics::command_buffer::create_command_buffer(device);
+    CommandBuffer computeCmd = graphics::command_buffer::create_command_buffer(device, CommandBufferType::Compute);
+    CommandBuffer resolveCmd = graphics::command_buffer::create_command_buffer(device);
+    Fence frameFence = graphics::fence::create_fence(device, 0);
+    Fence computeFence = graphics::fence::create_fence(device, 0);
+    null_backend::device::set_command_duration(device, options.gpuUs * 1000ull);
+    printf("%u frames, %u us per pass on the GPU, %u us of recording per frame\n", options.numFrames, options.gpuUs, options.cpuUs);
+
+    ProfilingHelper profiler;
+    profiler.initialize(device, queue, NUM_FRAMES_IN_FLIGHT);
+    profiler.set_enabled(true);
+
+    CheckResult result;
+    std::vector<double> submitTimes;
+    for (uint32_t frameIdx = 0; frameIdx < options.numFrames; ++frameIdx)
+    {
+        // Reads back the frame recorded NUM_FRAMES_IN_FLIGHT frames ago
+        profiler.begin_frame();
+        if (frameIdx >= NUM_FRAMES_IN_FLIGHT)
+            check_frame(profiler.last_gpu_frame(), submitTimes[frameIdx - NUM_FRAMES_IN_FLIGHT], options, result);
+
+        // Direct queue
+        graphics::command_buffer::reset(directCmd);
+        graphics::command_buffer::start_section(directCmd, "Frame");
+        graphics::command_buffer::start_section(directCmd, "Pass A");
+        graphics::command_buffer::dispatch(directCmd, 0, 1, 1, 1);
+        graphics::command_buffer::end_section(directCmd);
+        graphics::command_buffer::start_section(directCmd, "Pass B");
+        graphics::command_buffer::dispatch(directCmd, 0, 1, 1, 1);
+        graphics::command_buffer::end_section(directCmd);
+        graphics::command_buffer::end_section(directCmd);
+        graphics::command_buffer::close(directCmd);
+
+        // Compute queue
+        graphics::command_buffer::reset(computeCmd);
+        graphics::command_buffer::start_section(computeCmd, "Async");
+        graphics::command_buffer::dispatch(computeCmd, 0, 1, 1, 1);
+        graphics::command_buffer::end_section(computeCmd);
+        graphics::command_buffer::close(computeCmd);
+
+        // The timestamps of both queues are resolved once the compute work is done
+        graphics::command_buffer::reset(resolveCmd);
+        profiler.end_frame(resolveCmd);
+        graphics::command_buffer::close(resolveCmd);
+
+        // Rest of the recording, then submit
+        std::this_thread::sleep_for(std::chrono::microseconds(options.cpuUs));
+        submitTimes.push_back(cpu_profiler::timestamp_us());
+        graphics::command_queue::execute_command_buffer(queue, directCmd);
+        graphics::command_queue::execute_command_buffer(queue, computeCmd);
+        graphics::command_queue::signal(queue, computeFence, frameIdx + 1, CommandBufferType::Compute);
+        graphics::command_queue::wait(queue, computeFence, frameIdx + 1);
+        graphics::command_queue::execute_command_buffer(queue, resolveCmd);
+        graphics::command_queue::signal(queue, frameFence, frameIdx + 1);
+        graphics::fence::wait_value(frameFence, frameIdx + 1);
+    }
+
+    // Rolling stats of the scopes
+    const ScopeHistory* passScope = profiler.gpu_scope("Pass A");
+    const bool statsPassed = passScope != nullptr && passScope->count() == result.framesRead && fabsf(passScope->percentile(50.0f) - options.gpuUs / 1e3f) < 1e-3f;
+
+    struct CheckCase { const char* name; bool passed; };
+    const CheckCase cases[] = {
+        { "durations", result.durationErrors == 0 && statsPassed },
+        { "nesting", result.nestingErrors == 0 && result.framesRead == options.numFrames - NUM_FRAMES_IN_FLIGHT },
+        { "cpu_alignment", result.cpuAlignmentErrors == 0 },
+        { "queue_alignment", result.queueAlignmentErrors == 0 } };
+
+    bool success = true;
+    printf("frames_read,max_submit_offset_us\n%u,%.3f\n", result.framesRead, result.maxSubmitOffsetUS);
+    printf("case,status\n");
+    for (const CheckCase& checkCase : cases)
+    {
+        printf("%s,%s\n", checkCase.name, checkCase.passed ? "ok" : "FAILED");
+        success &= checkCase.passed;
+    }
+
+    profiler.release();
+    graphics::fence::destroy_fence(computeFence);
+    graphics::fence::destroy_fence(frameFence);
+    graphics::command_buffer::destroy_command_buffer(resolveCmd);
+    graphics::command_buffer::destroy_command_buffer(computeCmd);
+    graphics::command_buffer::destroy_command_buffer(directCmd);
+    graphics::command_queue::destroy_command_queue(queue);
+    graphics::device::destroy_graphics_device(device);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "graphics/backend.h"
+#include "tools/render_graph.h"
+
+// System includes
+#include <algorithm>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// Resources and passes of the random graphs
+#define RANDOM_NUM_IMPORTED 3
+#define RANDOM_NUM_TRANSIENTS 8
+#define RANDOM_MAX_PASSES 12
+
+static uint32_t random_uint(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Byte ranges of two placed transients intersect
+static bool ranges_intersect(const RenderGraph& graph, RGResource resA, RGResource resB)
+{
+    const uint64_t offsetA = graph.transient_offset(resA);
+    const uint64_t offsetB = graph.transient_offset(resB);
+    return offsetA < offsetB + graph.transient_footprint(resB) && offsetB < offsetA + graph.transient_footprint(resA);
+}
+
+static TextureDescriptor transient_texture_descriptor(uint32_t width, uint32_t height, TextureFormat format)
+{
+    TextureDescriptor descriptor;
+    descriptor.type = TextureType::Tex2D;
+    descriptor.width = width;
+    descriptor.height = height;
+    descriptor.depth = 1;
+    descriptor.mipCount = 1;
+    descriptor.isUAV = true;
+    descriptor.format = format;
+    return descriptor;
+}
+
+// A pass that only feeds a resource nobody reads is culled and never recorded, the side effects keep a pass alive
+static bool check_culling(GraphicsDevice device, CommandBuffer cmd)
+{
+    RenderGraph graph;
+    graph.initialize(device, 2);
+    GraphicsBuffer outputBuffer = graphics::resources::create_graphics_buffer(device, 256, 4);
+
+    std::vector<std::string> recorded;
+    RGResource output = graph.import_buffer("Output", outputBuffer);
+    RGResource used = graph.create_transient_buffer("Used", 256, 4);
+    RGResource unused = graph.create_transient_buffer("Unused", 256, 4);
+    RGPass producer = graph.add_pass("Producer", [&](CommandBuffer) { recorded.push_back("Producer"); });
+    graph.write(producer, used);
+    RGPass dead = graph.add_pass("Dead", [&](CommandBuffer) { recorded.push_back("Dead"); });
+    graph.read(dead, used);
+    graph.write(dead, unused);
+    RGPass consumer = graph.add_pass("Consumer", [&](CommandBuffer) { recorded.push_back("Consumer"); });
+    graph.read(consumer, used);
+    graph.write(consumer, output);
+    RGPass readback = graph.add_pass("Readback", [&](CommandBuffer) { recorded.push_back("Readback"); });
+    graph.read(readback, unused);
+    graph.set_side_effects(readback);
+    graph.mark_output(output);
+
+    // The readback keeps the dead pass alive, without it the pass goes
+    graph.compile();
+    bool success = !graph.pass_culled(producer) && !graph.pass_culled(dead) && !graph.pass_culled(consumer) && !graph.pass_culled(readback);
+    graph.reset();
+
+    output = graph.import_buffer("Output", outputBuffer);
+    used = graph.create_transient_buffer("Used", 256, 4);
+    unused = graph.create_transient_buffer("Unused", 256, 4);
+    producer = graph.add_pass("Producer", [&](CommandBuffer) { recorded.push_back("Producer"); });
+    graph.write(producer, used);
+    dead = graph.add_pass("Dead", [&](CommandBuffer) { recorded.push_back("Dead"); });
+    graph.read(dead, used);
+    graph.write(dead, unused);
+    consumer = graph.add_pass("Consumer", [&](CommandBuffer) { recorded.push_back("Consumer"); });
+    graph.read(consumer, used);
+    graph.write(consumer, output);
+    graph.mark_output(output);
+    graph.compile();
+    success &= !graph.pass_culled(producer) && graph.pass_culled(dead) && !graph.pass_culled(consumer);
+
+    // Culled resources don't get memory and the culled pass isn't recorded
+    success &= graph.transient_offset(unused) == UINT64_MAX;
+    graphics::command_buffer::reset(cmd);
+    graph.execute(cmd);
+    graphics::command_buffer::close(cmd);
+    success &= recorded == std::vector<std::string>({ "Producer", "Consumer" });
+
+    graph.release();
+    graphics::resources::destroy_graphics_buffer(outputBuffer);
+    return success;
+}
+
+// Two unordered accesses in a row get a barrier, a read or a render target in between turns it into a transition
+static bool check_barriers(GraphicsDevice device)
+{
+    RenderGraph graph;
+    graph.initialize(device, 2);
+    GraphicsBuffer buffer = graphics::resources::create_graphics_buffer(device, 256, 4);
+
+    RGResource resource = graph.import_buffer("Buffer", buffer);
+    RGPass firstWrite = graph.add_pass("FirstWrite", [](CommandBuffer) {});
+    graph.write(firstWrite, resource);
+    RGPass secondWrite = graph.add_pass("SecondWrite", [](CommandBuffer) {});
+    graph.write(secondWrite, resource);
+    RGPass readPass = graph.add_pass("Read", [](CommandBuffer) {});
+    graph.read(readPass, resource);
+    graph.set_side_effects(readPass);
+    RGPass thirdWrite = graph.add_pass("ThirdWrite", [](CommandBuffer) {});
+    graph.write(thirdWrite, resource);
+    RGPass readWrite = graph.add_pass("ReadWrite", [](CommandBuffer) {});
+    graph.read(readWrite, resource);
+    graph.write(readWrite, resource);
+    RGPass fourthWrite = graph.add_pass("FourthWrite", [](CommandBuffer) {});
+    graph.write(fourthWrite, resource);
+    graph.mark_output(resource);
+    graph.compile();
+
+    const std::vector<RGResource> barrier = { resource };
+    bool success = graph.pass_barriers(firstWrite).empty();
+    success &= graph.pass_barriers(secondWrite) == barrier;
+    success &= graph.pass_barriers(readPass).empty();
+    success &= graph.pass_barriers(thirdWrite).empty();
+
+    // The read of the pass wins, the resource is transitioned when bound
+    success &= graph.pass_barriers(readWrite) == barrier;
+    success &= graph.pass_barriers(fourthWrite).empty();
+
+    graph.release();
+    graphics::resources::destroy_graphics_buffer(buffer);
+    return success;
+}
+
+// Transients that are never alive at the same time share byte ranges of the heap whatever their stride or type, the others don't
+static bool check_aliasing(GraphicsDevice device, CommandBuffer cmd)
+{
+    RenderGraph graph;
+    graph.initialize(device, 2);
+    GraphicsBuffer outputBuffer = graphics::resources::create_graphics_buffer(device, 1024, 4);
+    const TextureDescriptor textureDesc = transient_texture_descriptor(512, 512, TextureFormat::R8_UNorm);
+
+    // First: [0, 1], Second: [1, 2], OtherStride: [2, 3], Texture: [3, 4]
+    RGResource output, first, second, otherStride, texture;
+    RGPass pass0, pass1, pass2, pass3, pass4;
+    auto declare = [&]()
+    {
+        graph.reset();
+        output = graph.import_buffer("Output", outputBuffer);
+        first = graph.create_transient_buffer("First", 256 * 1024, 4);
+        second = graph.create_transient_buffer("Second", 64 * 1024, 4);
+        otherStride = graph.create_transient_buffer("OtherStride", 256 * 1024, 16);
+        texture = graph.create_transient_render_texture("Texture", textureDesc);
+        pass0 = graph.add_pass("Pass0", [](CommandBuffer) {});
+        graph.write(pass0, first);
+        pass1 = graph.add_pass("Pass1", [](CommandBuffer) {});
+        graph.read(pass1, first);
+        graph.write(pass1, second);
+        pass2 = graph.add_pass("Pass2", [](CommandBuffer) {});
+        graph.read(pass2, second);
+        graph.write(pass2, otherStride);
+        pass3 = graph.add_pass("Pass3", [](CommandBuffer) {});
+        graph.write(pass3, otherStride);
+        graph.write(pass3, texture);
+        pass4 = graph.add_pass("Pass4", [](CommandBuffer) {});
+        graph.read(pass4, texture);
+        graph.write(pass4, output);
+        graph.mark_output(output);
+        graph.compile();
+    };
+    declare();
+
+    // The transients alive in the same pass don't intersect, the buffer of stride 16 and the texture take over the bytes of the dead ones
+    bool success = !ranges_intersect(graph, first, second) && !ranges_intersect(graph, second, otherStride) && !ranges_intersect(graph, otherStride, texture);
+    success &= ranges_intersect(graph, otherStride, first) || ranges_intersect(graph, otherStride, second);
+    success &= ranges_intersect(graph, texture, first) || ranges_intersect(graph, texture, second);
+    success &= graph.transient_footprint(texture) == 256 * 1024;
+    success &= graph.transient_memory() == 512 * 1024;
+
+    // Every transient is activated by the pass that first uses it, OtherStride is written twice in a row
+    success &= graph.pass_activations(pass0) == std::vector<RGResource>({ first });
+    success &= graph.pass_activations(pass1) == std::vector<RGResource>({ second });
+    success &= graph.pass_activations(pass2) == std::vector<RGResource>({ otherStride });
+    success &= graph.pass_activations(pass3) == std::vector<RGResource>({ texture });
+    success &= graph.pass_activations(pass4).empty() && graph.frame_activations().empty();
+    success &= graph.pass_barriers(pass3) == std::vector<RGResource>({ otherStride });
+
+    graphics::command_buffer::reset(cmd);
+    graph.execute(cmd);
+    graphics::command_buffer::close(cmd);
+    const GraphicsBuffer firstBuffer = graph.buffer(first);
+    const RenderTexture renderTexture = graph.render_texture(texture);
+    success &= firstBuffer != 0 && renderTexture != 0 && firstBuffer != graph.buffer(second) && firstBuffer != graph.buffer(otherStride);
+
+    // The same declarations next frame land on the same placed resources
+    declare();
+    graphics::command_buffer::reset(cmd);
+    graph.execute(cmd);
+    graphics::command_buffer::close(cmd);
+    success &= graph.buffer(first) == firstBuffer && graph.render_texture(texture) == renderTexture;
+
+    graph.release();
+    graphics::resources::destroy_graphics_buffer(outputBuffer);
+    return success;
+}
+
+// Random graphs checked against the definitions: the culling, the lifetimes of the aliased transients and the barriers
+static bool check_random(GraphicsDevice device, uint32_t numGraphs, uint32_t seed)
+{
+    struct Decl { uint32_t pass, resource; RGAccess access; };
+    RenderGraph graph;
+    graph.initialize(device, 2);
+    std::vector<GraphicsBuffer> importedBuffers(RANDOM_NUM_IMPORTED);
+    for (GraphicsBuffer& buffer : importedBuffers)
+        buffer = graphics::resources::create_graphics_buffer(device, 256, 4);
+
+    uint32_t state = seed;
+    bool success = true;
+    for (uint32_t graphIdx = 0; graphIdx < numGraphs && success; ++graphIdx)
+    {
+        graph.reset();
+        const uint32_t numResources = RANDOM_NUM_IMPORTED + RANDOM_NUM_TRANSIENTS;
+        std::vector<bool> outputs(numResources, false);
+        for (uint32_t resIdx = 0; resIdx < RANDOM_NUM_IMPORTED; ++resIdx)
+        {
+            graph.import_buffer("Imported", importedBuffers[resIdx]);
+            outputs[resIdx] = random_uint(state) % 2 == 0;
+            if (outputs[resIdx])
+                graph.mark_output(resIdx);
+        }
+        for (uint32_t resIdx = RANDOM_NUM_IMPORTED; resIdx < numResources; ++resIdx)
+        {
+            // Buffers of both strides and render textures, from one to eight blocks of the heap
+            const uint32_t resourceType = random_uint(state) % 4;
+            const uint32_t numBlocks = 1 + random_uint(state) % 8;
+            if (resourceType == 0)
+                graph.create_transient_render_texture("Transient", transient_texture_descriptor(256, 64 * numBlocks, TextureFormat::R8G8B8A8_UNorm));
+            else
+                graph.create_transient_buffer("Transient", numBlocks * 64 * 1024 - random_uint(state) % 1024, resourceType == 1 ? 16 : 4);
+        }
+
+        const uint32_t numPasses = 1 + random_uint(state) % RANDOM_MAX_PASSES;
+        std::vector<bool> sideEffects(numPasses, false);
+        std::vector<Decl> decls;
+        for (uint32_t passIdx = 0; passIdx < numPasses; ++passIdx)
+        {
+            graph.add_pass("Pass", [](CommandBuffer) {});
+            sideEffects[passIdx] = random_uint(state) % 8 == 0;
+            if (sideEffects[passIdx])
+                graph.set_side_effects(passIdx);
+            const uint32_t numAccesses = 1 + random_uint(state) % 3;
+            for (uint32_t accessIdx = 0; accessIdx < numAccesses; ++accessIdx)
+            {
+                const uint32_t resource = random_uint(state) % numResources;
+                const uint32_t accessType = random_uint(state) % 4;
+                const RGAccess access = accessType < 2 ? RGAccess::Read : (accessType == 2 ? RGAccess::UnorderedAccess : RGAccess::RenderTarget);
+                if (access == RGAccess::Read)
+                    graph.read(passIdx, resource);
+                else
+                    graph.write(passIdx, resource, access);
+                decls.push_back({ passIdx, resource, access });
+            }
+        }
+        graph.compile();
+
+        // Culling: an alive pass keeps every earlier writer of what it touches, a culled one writes nothing that is consumed later
+        for (const Decl& decl : decls)
+        {
+            const bool alive = !graph.pass_culled(decl.pass);
+            for (const Decl& other : decls)
+            {
+                if (other.resource != decl.resource || other.pass == decl.pass)
+                    continue;
+                if (alive && other.pass < decl.pass && other.access != RGAccess::Read)
+                    success &= !graph.pass_culled(other.pass);
+                if (!alive && decl.access != RGAccess::Read && other.pass > decl.pass)
+                    success &= graph.pass_culled(other.pass);
+            }
+            if (!alive && decl.access != RGAccess::Read)
+                success &= !outputs[decl.resource];
+        }
+        for (uint32_t passIdx = 0; passIdx < numPasses; ++passIdx)
+            success &= !sideEffects[passIdx] || !graph.pass_culled(passIdx);
+
+        // Lifetimes over the alive passes, the transients alive at the same time get disjoint byte ranges
+        std::vector<uint32_t> firstPass(numResources, UINT32_MAX), lastPass(numResources, 0);
+        for (const Decl& decl : decls)
+        {
+            if (graph.pass_culled(decl.pass))
+                continue;
+            firstPass[decl.resource] = std::min(firstPass[decl.resource], decl.pass);
+            lastPass[decl.resource] = std::max(lastPass[decl.resource], decl.pass);
+        }
+        uint64_t sumFootprints = 0;
+        for (uint32_t resIdx = RANDOM_NUM_IMPORTED; resIdx < numResources; ++resIdx)
+        {
+            const uint64_t offset = graph.transient_offset(resIdx);
+            success &= (offset == UINT64_MAX) == (firstPass[resIdx] == UINT32_MAX);
+            if (offset == UINT64_MAX)
+                continue;
+            sumFootprints += graph.transient_footprint(resIdx);
+            success &= offset + graph.transient_footprint(resIdx) <= graph.transient_memory();
+            for (uint32_t otherIdx = resIdx + 1; otherIdx < numResources; ++otherIdx)
+            {
+                if (graph.transient_offset(otherIdx) == UINT64_MAX || !ranges_intersect(graph, resIdx, otherIdx))
+                    continue;
+                success &= lastPass[resIdx] < firstPass[otherIdx] || lastPass[otherIdx] < firstPass[resIdx];
+            }
+
+            // Activated once, by its first pass
+            const std::vector<RGResource>& activations = graph.pass_activations(firstPass[resIdx]);
+            success &= std::count(activations.begin(), activations.end(), resIdx) == 1;
+        }
+        success &= graph.transient_memory() <= sumFootprints && graph.frame_activations().empty();
+
+        // Barriers: an unordered access right after a pass whose access of the same resource was only unordered, the transients that
+        // share memory are ordered by their activation instead
+        std::map<uint32_t, RGAccess> lastAccess;
+        for (uint32_t passIdx = 0; passIdx < numPasses; ++passIdx)
+        {
+            if (graph.pass_culled(passIdx))
+            {
+                success &= graph.pass_barriers(passIdx).empty();
+                continue;
+            }
+            std::vector<uint32_t> expected, barriers;
+            std::map<uint32_t, RGAccess> passAccess;
+            for (const Decl& decl : decls)
+            {
+                if (decl.pass != passIdx)
+                    continue;
+                const uint32_t key = decl.resource;
+                auto it = lastAccess.find(key);
+                if (decl.access == RGAccess::UnorderedAccess && it != lastAccess.end() && it->second == RGAccess::UnorderedAccess)
+                    expected.push_back(key);
+                auto passIt = passAccess.find(key);
+                if (passIt == passAccess.end() || decl.access == RGAccess::Read)
+                    passAccess[key] = decl.access;
+            }
+            for (const auto& access : passAccess)
+                lastAccess[access.first] = access.second;
+            for (RGResource resource : graph.pass_barriers(passIdx))
+                barriers.push_back(resource);
+            std::sort(expected.begin(), expected.end());
+            expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+            std::sort(barriers.begin(), barriers.end());
+            success &= expected == barriers;
+        }
+        if (!success)
+            printf("Random graph %u failed.\n", graphIdx);
+    }
+
+    graph.release();
+    for (GraphicsBuffer buffer : importedBuffers)
+        graphics::resources::destroy_graphics_buffer(buffer);
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numGraphs = 10000;
+    uint32_t seed = 1;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        if (arg == "--graphs" && argIdx + 1 < argc)
+            numGraphs = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--seed" && argIdx + 1 < argc)
+            seed = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            printf("Usage: render_graph_check [--graphs count (default 10000)] [--seed value (default 1)]\n");
+            return -1;
+        }
+    }
+
+    // The graph only needs a device for the transient heap and its fence, the null backend is enough
+    graphics::setup_graphics_api(GraphicsAPI::Null);
+    GraphicsDevice device = graphics::device::create_graphics_device();
+    CommandBuffer cmd = graphics::command_buffer::create_command_buffer(device);
+
+    struct CheckCase { const char* name; bool passed; };
+    const CheckCase cases[] = {
+        { "culling", check_culling(device, cmd) },
+        { "uav_barriers", check_barriers(device) },
+        { "aliasing", check_aliasing(device, cmd) },
+        { "random_graphs", check_random(device, numGraphs, seed) } };
+
+    bool success = true;
+    printf("case,status\n");
+    for (const CheckCase& checkCase : cases)
+    {
+        printf("%s,%s\n", checkCase.name, checkCase.passed ? "ok" : "FAILED");
+        success &= checkCase.passed;
+    }
+
+    graphics::command_buffer::destroy_command_buffer(cmd);
+    graphics::device::destroy_graphics_device(device);
+    return success ? 0 : 1;
+}
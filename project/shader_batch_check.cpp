@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "tools/file_watcher.h"
+#include "tools/shader_utils.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shader file every stub shader includes
+#define COMMON_INCLUDE "common.hlsl"
+
+struct CheckOptions
+{
+    // Shaders per batch and time a stub compilation takes
+    uint32_t numShaders = 32;
+    uint32_t compileMS = 20;
+
+    // Workers of the scheduler, 0 for one per hardware thread
+    uint32_t numThreads = 0;
+};
+
+// Stub compiler: a shader is a list of dependencies, the files whose name contains "broken" fail to compile
+struct StubShader
+{
+    std::vector<std::string> dependencies;
+};
+
+static uint32_t g_CompileMS = 0;
+static std::atomic<int32_t> g_LiveShaders = 0;
+static std::mutex g_ThreadMutex;
+static std::set<std::thread::id> g_CompileThreads;
+
+static uint64_t stub_compile(const std::string& filename, const std::vector<std::string>& includeDirectories)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_ThreadMutex);
+        g_CompileThreads.insert(std::this_thread::get_id());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(g_CompileMS));
+    if (filename.find("broken") != std::string::npos)
+        return 0;
+
+    StubShader* shader = new StubShader();
+    shader->dependencies.push_back(normalize_file_path(filename));
+    for (const std::string& directory : includeDirectories)
+        shader->dependencies.push_back(normalize_file_path(directory + "/" + COMMON_INCLUDE));
+    g_LiveShaders++;
+    return (uint64_t)shader;
+}
+
+static void stub_destroy(uint64_t shader)
+{
+    delete (StubShader*)shader;
+    g_LiveShaders--;
+}
+
+static const std::vector<std::string>& stub_dependencies(uint64_t shader)
+{
+    return ((StubShader*)shader)->dependencies;
+}
+
+static ShaderCompiler stub_compiler()
+{
+    ShaderCompiler compiler;
+    compiler.create_compute_shader = [](GraphicsDevice, const ComputeShaderDescriptor& csd, bool) -> ComputeShader { return stub_compile(csd.filename, csd.includeDirectories); };
+    compiler.destroy_compute_shader = [](ComputeShader computeShader) { stub_destroy(computeShader); };
+    compiler.compute_shader_dependencies = [](ComputeShader computeShader) -> const std::vector<std::string>& { return stub_dependencies(computeShader); };
+    compiler.create_graphics_pipeline = [](GraphicsDevice, const GraphicsPipelineDescriptor& gpd) -> GraphicsPipeline { return stub_compile(gpd.filename, gpd.includeDirectories); };
+    compiler.destroy_graphics_pipeline = [](GraphicsPipeline graphicsPipeline) { stub_destroy(graphicsPipeline); };
+    compiler.graphics_pipeline_dependencies = [](GraphicsPipeline graphicsPipeline) -> const std::vector<std::string>& { return stub_dependencies(graphicsPipeline); };
+    return compiler;
+}
+
+// Targets of the batches, one graphics pipeline for every four compute shaders
+struct ShaderSet
+{
+    std::vector<ComputeShader> computeShaders;
+    std::vector<GraphicsPipeline> graphicsPipelines;
+};
+
+// Registers the whole set, the compute shader at brokenIdx points to a file that fails to compile
+static void register_shaders(ShaderCompileBatch& batch, ShaderSet& shaders, uint32_t brokenIdx = UINT32_MAX)
+{
+    for (uint32_t shaderIdx = 0; shaderIdx < (uint32_t)shaders.computeShaders.size(); ++shaderIdx)
+    {
+        ComputeShaderDescriptor csd;
+        csd.filename = "shaders/" + std::string(shaderIdx == brokenIdx ? "broken" : "kernel") + std::to_string(shaderIdx) + ".compute";
+        csd.includeDirectories.push_back("shaders");
+        batch.add_compute_shader(csd, shaders.computeShaders[shaderIdx]);
+    }
+    for (uint32_t pipelineIdx = 0; pipelineIdx < (uint32_t)shaders.graphicsPipelines.size(); ++pipelineIdx)
+    {
+        GraphicsPipelineDescriptor gpd;
+        gpd.filename = "shaders/pipeline" + std::to_string(pipelineIdx) + ".graphics";
+        batch.add_graphics_pipeline(gpd, shaders.graphicsPipelines[pipelineIdx]);
+    }
+}
+
+static void destroy_shaders(ShaderSet& shaders)
+{
+    for (ComputeShader& computeShader : shaders.computeShaders)
+        stub_destroy(computeShader);
+    for (GraphicsPipeline& graphicsPipeline : shaders.graphicsPipelines)
+        stub_destroy(graphicsPipeline);
+}
+
+// Every shader is compiled and replaced, on several threads when the scheduler has them
+static bool check_parallel_compile(ShaderSet& shaders)
+{
+    g_CompileThreads.clear();
+    ShaderCompileBatch batch(stub_compiler());
+    register_shaders(batch, shaders);
+    bool success = batch.execute(0);
+    for (ComputeShader computeShader : shaders.computeShaders)
+        success &= computeShader != 0;
+    for (GraphicsPipeline graphicsPipeline : shaders.graphicsPipelines)
+        success &= graphicsPipeline != 0;
+    const uint32_t numShaders = (uint32_t)(shaders.computeShaders.size() + shaders.graphicsPipelines.size());
+    success &= g_LiveShaders == (int32_t)numShaders;
+    success &= task_scheduler::num_threads() == 1 || g_CompileThreads.size() > 1;
+    return success;
+}
+
+// A failing shader keeps every previous target and releases the shaders that did compile
+static bool check_all_or_nothing(ShaderSet& shaders)
+{
+    const ShaderSet previous = shaders;
+    const int32_t numLive = g_LiveShaders;
+    ShaderCompileBatch batch(stub_compiler());
+    register_shaders(batch, shaders, (uint32_t)shaders.computeShaders.size() / 2);
+    bool success = !batch.execute(0);
+    success &= shaders.computeShaders == previous.computeShaders && shaders.graphicsPipelines == previous.graphicsPipelines;
+    success &= g_LiveShaders == numLive;
+    success &= batch.report().numFailed == 1;
+    return success;
+}
+
+// Only the shaders that depend on a changed file are compiled again
+static bool check_incremental(ShaderSet& shaders)
+{
+    const ShaderSet previous = shaders;
+    ShaderCompileBatch batch(stub_compiler());
+    register_shaders(batch, shaders);
+    const std::vector<std::string> changedFiles = { "shaders/kernel1.compute", "shaders/pipeline0.graphics" };
+    bool success = batch.execute(0, &changedFiles);
+    success &= batch.report().numShaders == 2;
+    for (uint32_t shaderIdx = 0; shaderIdx < (uint32_t)shaders.computeShaders.size(); ++shaderIdx)
+        success &= (shaders.computeShaders[shaderIdx] != previous.computeShaders[shaderIdx]) == (shaderIdx == 1);
+    for (uint32_t pipelineIdx = 0; pipelineIdx < (uint32_t)shaders.graphicsPipelines.size(); ++pipelineIdx)
+        success &= (shaders.graphicsPipelines[pipelineIdx] != previous.graphicsPipelines[pipelineIdx]) == (pipelineIdx == 0);
+
+    // The include is shared by the compute shaders, the graphics pipelines don't use it
+    register_shaders(batch, shaders);
+    const std::vector<std::string> changedInclude = { std::string("shaders/") + COMMON_INCLUDE };
+    success &= batch.execute(0, &changedInclude);
+    success &= batch.report().numShaders == (uint32_t)shaders.computeShaders.size();
+    return success;
+}
+
+// The report counts every shader, and the wall time is below the sum of the compile times when there are several threads
+static bool check_timing_report(ShaderSet& shaders, const CheckOptions& options)
+{
+    ShaderCompileBatch batch(stub_compiler());
+    register_shaders(batch, shaders);
+    bool success = batch.execute(0);
+    const ShaderCompileReport& report = batch.report();
+    const uint32_t numShaders = (uint32_t)(shaders.computeShaders.size() + shaders.graphicsPipelines.size());
+    success &= report.numShaders == numShaders && report.numFailed == 0;
+    success &= report.numThreads == task_scheduler::num_threads();
+    success &= report.compileDurationMS >= numShaders * options.compileMS * 0.9;
+    success &= report.durationMS > 0.0 && (report.numThreads == 1 || report.durationMS < report.compileDurationMS);
+    printf("%u shaders of %u ms on %u threads: %.1f ms, %.1fx\n", numShaders, options.compileMS, report.numThreads, report.durationMS, report.compileDurationMS / report.durationMS);
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    CheckOptions options;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        if (arg == "--shaders" && argIdx + 1 < argc)
+            options.numShaders = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--compile-ms" && argIdx + 1 < argc)
+            options.compileMS = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--threads" && argIdx + 1 < argc)
+            options.numThreads = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            printf("Usage: shader_batch_check [--shaders count (default 32)] [--compile-ms duration (default 20)] [--threads count (default 0)]\n");
+            return -1;
+        }
+    }
+    if (options.numShaders < 4)
+        options.numShaders = 4;
+
+    task_scheduler::initialize(options.numThreads);
+    g_CompileMS = options.compileMS;
+    ShaderSet shaders;
+    shaders.computeShaders.resize(options.numShaders, 0);
+    shaders.graphicsPipelines.resize(options.numShaders / 4, 0);
+
+    struct CheckCase { const char* name; bool passed; };
+    const CheckCase cases[] = {
+        { "parallel_compile", check_parallel_compile(shaders) },
+        { "all_or_nothing", check_all_or_nothing(shaders) },
+        { "incremental", check_incremental(shaders) },
+        { "timing_report", check_timing_report(shaders, options) } };
+
+    // Nothing leaks once the targets are destroyed
+    destroy_shaders(shaders);
+    task_scheduler::release();
+
+    bool success = g_LiveShaders == 0;
+    printf("case,status\n");
+    for (const CheckCase& checkCase : cases)
+    {
+        printf("%s,%s\n", checkCase.name, checkCase.passed ? "ok" : "FAILED");
+        success &= checkCase.passed;
+    }
+    printf("no_leak,%s\n", g_LiveShaders == 0 ? "ok" : "FAILED");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "tools/shader_archive.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct PrecompilerOptions
+{
+    // Manifest that declares the permutations
+    std::string manifest = "";
+
+    // Root of the shader sources, also used as include directory
+    std::string shaderDir = "";
+
+    // Archive to produce
+    std::string output = "";
+
+    // DXC command line compiler
+    std::string dxc = "dxc";
+
+    // Number of worker threads (0 = one per hardware thread)
+    uint32_t numThreads = 0;
+
+    // Overrides of the manifest variables
+    std::map<std::string, std::string> variables;
+};
+
+static void print_usage()
+{
+    printf("Usage: shader_precompiler --manifest <file> --shader-dir <dir> --output <archive> [options]\n");
+    printf("--dxc Path of the DXC executable (default: dxc).\n");
+    printf("--set NAME=VALUE Override a variable of the manifest.\n");
+    printf("--threads Number of worker threads (default: one per hardware thread).\n");
+}
+
+static bool parse_args(int argc, char** argv, PrecompilerOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--manifest" && hasValue)
+            options.manifest = argv[++argIdx];
+        else if (arg == "--shader-dir" && hasValue)
+            options.shaderDir = argv[++argIdx];
+        else if (arg == "--output" && hasValue)
+            options.output = argv[++argIdx];
+        else if (arg == "--dxc" && hasValue)
+            options.dxc = argv[++argIdx];
+        else if (arg == "--threads" && hasValue)
+            options.numThreads = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--set" && hasValue)
+        {
+            const std::string variable = argv[++argIdx];
+            const size_t equal = variable.find('=');
+            if (equal == std::string::npos)
+            {
+                printf("Expected NAME=VALUE, got %s.\n", variable.c_str());
+                return false;
+            }
+            options.variables[variable.substr(0, equal)] = variable.substr(equal + 1);
+        }
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+
+    if (options.manifest == "" || options.shaderDir == "" || options.output == "")
+    {
+        print_usage();
+        return false;
+    }
+    return true;
+}
+
+static std::string quote(const std::string& str)
+{
+    return "\"" + str + "\"";
+}
+
+static std::string build_command(const PrecompilerOptions& options, const ShaderPermutation& permutation, const std::string& outputFile)
+{
+    std::string command = quote(options.dxc);
+    command += " -T " + permutation.profile;
+    command += " -E " + permutation.kernel;
+    command += " -I " + quote(options.shaderDir);
+
+    // Arguments such as "-HV 2021" are stored as a single string at runtime
+    for (const std::string& argument : permutation.arguments)
+        command += " " + argument;
+
+    // The runtime passes "NAME VALUE" defines without a value, the command line needs NAME=VALUE
+    for (const std::string& define : permutation.defines)
+    {
+        std::string cmdDefine = define;
+        const size_t space = cmdDefine.find(' ');
+        if (cmdDefine.find('=') == std::string::npos && space != std::string::npos)
+            cmdDefine[space] = '=';
+        command += " -D " + quote(cmdDefine);
+    }
+
+    command += " -Fo " + quote(outputFile);
+    command += " " + quote((std::filesystem::path(options.shaderDir) / permutation.filename).string());
+#if defined(_WIN32)
+    // cmd.exe strips the outer quotes
+    command = quote(command);
+#endif
+    return command;
+}
+
+static bool read_binary(const std::string& path, std::vector<char>& outBinary)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+    outBinary.resize((size_t)file.tellg());
+    file.seekg(0);
+    file.read(outBinary.data(), outBinary.size());
+    return (bool)file && outBinary.size() > 0;
+}
+
+int main(int argc, char** argv)
+{
+    PrecompilerOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // Expand the manifest
+    std::vector<ShaderPermutation> permutations;
+    if (!shader_archive::parse_manifest(options.manifest, options.variables, permutations))
+        return -1;
+    const uint32_t numPermutations = (uint32_t)permutations.size();
+
+    // Evaluate the keys
+    std::vector<uint64_t> keys(numPermutations);
+    for (uint32_t permIdx = 0; permIdx < numPermutations; ++permIdx)
+        keys[permIdx] = shader_archive::permutation_key(permutations[permIdx]);
+
+    // Intermediate binaries
+    const std::filesystem::path tmpDir = options.output + ".tmp";
+    std::error_code ec;
+    std::filesystem::create_directories(tmpDir, ec);
+
+    // Compile everything in parallel, one compiler process per permutation
+    auto start = std::chrono::high_resolution_clock::now();
+    task_scheduler::initialize(options.numThreads);
+    std::vector<std::vector<char>> binaries(numPermutations);
+    std::atomic<uint32_t> numFailures = 0;
+    task_scheduler::parallel_for(0, numPermutations, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t permIdx = first; permIdx < last; ++permIdx)
+        {
+            const ShaderPermutation& permutation = permutations[permIdx];
+            const std::string outputFile = (tmpDir / (std::to_string(permIdx) + ".dxil")).string();
+            const int result = system(build_command(options, permutation, outputFile).c_str());
+            if (result != 0 || !read_binary(outputFile, binaries[permIdx]))
+            {
+                printf("[SHADER ARCHIVE] %s (%s, %s) failed to compile.\n", permutation.filename.c_str(), permutation.kernel.c_str(), permutation.profile.c_str());
+                numFailures++;
+            }
+        }
+    });
+    task_scheduler::release();
+    std::filesystem::remove_all(tmpDir, ec);
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    if (numFailures.load() != 0)
+    {
+        printf("[SHADER ARCHIVE] %u/%u permutations failed, no archive was written.\n", numFailures.load(), numPermutations);
+        return -1;
+    }
+
+    // Pack everything
+    if (!shader_archive::write(options.output, keys, binaries))
+        return -1;
+
+    uint64_t totalSize = 0;
+    for (const std::vector<char>& binary : binaries)
+        totalSize += binary.size();
+    double durationMS = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3;
+    printf("[SHADER ARCHIVE] %u permutations (%.1f KB) compiled in %.1f ms and written to %s\n", numPermutations, totalSize / 1024.0, durationMS, options.output.c_str());
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "scene/skinning.h"
+#include "tools/cpu_profiler.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct BenchOptions
+{
+    // Animated mesh of the sample, random frames are generated without it
+    std::string animation;
+    uint32_t numVertices = 200000;
+
+    // Animation times evaluated and repetitions of each of them
+    uint32_t numTimes = 16;
+    uint32_t numIterations = 8;
+
+    // 0 uses every hardware thread
+    uint32_t numThreads = 0;
+};
+
+static void print_usage()
+{
+    printf("Usage: skinning_bench [options]\n");
+    printf("--animation Mesh animation to skin (michel.anim), random frames are used otherwise.\n");
+    printf("--vertices Number of vertices of the random frames (default 200000).\n");
+    printf("--times Animation times evaluated (default 16).\n");
+    printf("--iterations Repetitions of every time (default 8).\n");
+    printf("--threads Number of threads, 0 for all of them (default 0).\n");
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--animation" && hasValue)
+            options.animation = argv[++argIdx];
+        else if (arg == "--vertices" && hasValue)
+            options.numVertices = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--times" && hasValue)
+            options.numTimes = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--iterations" && hasValue)
+            options.numIterations = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--threads" && hasValue)
+            options.numThreads = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.numVertices > 0 && options.numTimes > 0 && options.numIterations > 0;
+}
+
+// Eight frames of random vertices
+static void random_animation(uint32_t numVertices, MeshAnimation& animation)
+{
+    uint32_t state = 0x9E3779B9u;
+    auto random = [&state]() { state = state * 1664525u + 1013904223u; return (state >> 8) / 16777216.0f * 2.0f - 1.0f; };
+    animation.vertexBufferArray.resize(8);
+    for (VertexBuffer& frame : animation.vertexBufferArray)
+    {
+        frame.data.resize(numVertices);
+        for (VertexData& vertex : frame.data)
+        {
+            vertex.position = { random(), random(), random() };
+            vertex.normal = normalize(float3({ random(), random(), random() }));
+            vertex.tangent = normalize(float3({ random(), random(), random() }));
+            vertex.texCoord = { random(), random() };
+            vertex.matID = state & 7;
+        }
+    }
+}
+
+static float max_error(const std::vector<float3>& reference, const std::vector<float3>& positions)
+{
+    float error = 0.0f;
+    for (uint32_t vertIdx = 0; vertIdx < (uint32_t)reference.size(); ++vertIdx)
+        error = fmaxf(error, length(reference[vertIdx] - positions[vertIdx]));
+    return error;
+}
+
+static float max_error(const std::vector<VertexData>& reference, const std::vector<VertexData>& vertices)
+{
+    float error = 0.0f;
+    for (uint32_t vertIdx = 0; vertIdx < (uint32_t)reference.size(); ++vertIdx)
+    {
+        const float* r = &reference[vertIdx].position.x;
+        const float* v = &vertices[vertIdx].position.x;
+        for (uint32_t floatIdx = 0; floatIdx < sizeof(VertexData) / sizeof(float); ++floatIdx)
+            error = fmaxf(error, fabsf(r[floatIdx] - v[floatIdx]));
+    }
+    return error;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // Frames
+    MeshAnimation animation;
+    if (!options.animation.empty())
+        mesh::import_mesh_animation(options.animation.c_str(), animation);
+    else
+        random_animation(options.numVertices, animation);
+    const uint32_t numFrames = (uint32_t)animation.vertexBufferArray.size();
+    const uint32_t numVertices = (uint32_t)animation.vertexBufferArray[0].data.size();
+
+    task_scheduler::initialize(options.numThreads);
+    PositionStreams streams;
+    skinning::transpose_positions(animation, streams);
+    printf("%u vertices, %u frames, %u threads\n", numVertices, numFrames, task_scheduler::num_threads());
+
+    // Every path over the same times
+    std::vector<VertexData> referenceVertices, vertices;
+    std::vector<float3> referencePositions, positions;
+    const char* pathNames[] = { "vertices_scalar", "vertices_simd", "positions_scalar", "positions_simd", "positions_soa_simd" };
+    const uint32_t numPaths = sizeof(pathNames) / sizeof(pathNames[0]);
+    std::vector<ScopeHistory> histories(numPaths, ScopeHistory(options.numTimes * options.numIterations));
+    float vertexError = 0.0f, positionError = 0.0f;
+    for (uint32_t timeIdx = 0; timeIdx < options.numTimes; ++timeIdx)
+    {
+        const SkinningFrame frame = skinning::animation_frame(numFrames, (timeIdx + 0.5f) / options.numTimes);
+        const std::function<void()> paths[] = {
+            [&]() { skinning::skin_vertices_reference(animation, frame, referenceVertices); },
+            [&]() { skinning::skin_vertices(animation, frame, vertices); },
+            [&]() { skinning::skin_positions_reference(animation, frame, referencePositions); },
+            [&]() { skinning::skin_positions(animation, frame, positions); },
+            [&]() { skinning::skin_positions(streams, frame, positions); } };
+        for (uint32_t pathIdx = 0; pathIdx < numPaths; ++pathIdx)
+        {
+            for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+            {
+                auto start = std::chrono::high_resolution_clock::now();
+                paths[pathIdx]();
+                auto stop = std::chrono::high_resolution_clock::now();
+                histories[pathIdx].push(std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f);
+            }
+
+            // Compared against the scalar references
+            if (pathIdx == 1)
+                vertexError = fmaxf(vertexError, max_error(referenceVertices, vertices));
+            else if (pathIdx > 2)
+                positionError = fmaxf(positionError, max_error(referencePositions, positions));
+        }
+    }
+
+    printf("path,median_ms,p95_ms,mvertices_per_s,speedup\n");
+    for (uint32_t pathIdx = 0; pathIdx < numPaths; ++pathIdx)
+    {
+        const float median = histories[pathIdx].percentile(50.0f);
+        const float reference = histories[pathIdx < 2 ? 0 : 2].percentile(50.0f);
+        printf("%s,%.3f,%.3f,%.2f,%.2f\n", pathNames[pathIdx], median, histories[pathIdx].percentile(95.0f),
+            median > 0.0f ? numVertices / (median * 1e3f) : 0.0f, median > 0.0f ? reference / median : 0.0f);
+    }
+    printf("Max error: vertices %g, positions %g\n", vertexError, positionError);
+
+    task_scheduler::release();
+    return 0;
+}
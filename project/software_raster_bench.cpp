@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "bench_scene.h"
+#include "render_pipeline/software_rasterizer.h"
+#include "render_pipeline/tile_shape.h"
+#include "tools/cpu_profiler.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+struct RasterBenchOptions : BenchOptions
+{
+    // Writes the material IDs of the first frame of every view for tile_shape_autotune
+    bool capture = false;
+};
+
+static void print_usage()
+{
+    print_bench_usage("software_raster_bench");
+    printf("--capture Writes visibility_capture_<view>.bin for the first frame of every view.\n");
+}
+
+int main(int argc, char** argv)
+{
+    RasterBenchOptions options;
+    auto parse_capture = [&](const std::string& arg, bool, int&)
+    {
+        if (arg != "--capture")
+            return false;
+        options.capture = true;
+        return true;
+    };
+    if (!parse_bench_args(argc, argv, options, print_usage, parse_capture))
+        return -1;
+
+    // Scene
+    MeshAnimation animation;
+    std::vector<BenchView> views;
+    if (!load_bench_scene(options, animation, views))
+        return -1;
+    const uint32_t numAnimationFrames = (uint32_t)animation.vertexBufferArray.size();
+
+    task_scheduler::initialize(options.numThreads);
+    SoftwareRasterizer rasterizer;
+    rasterizer.initialize(options.width, options.height);
+    printf("%u triangles, %u vertices, %ux%u, %u threads\n", (uint32_t)animation.indexBuffer.size(), (uint32_t)animation.vertexBufferArray[0].data.size(),
+        options.width, options.height, task_scheduler::num_threads());
+
+    // Every view at a few times of the animation
+    ScopeHistory history(views.size() * options.numFrames * options.numIterations);
+    std::vector<uint32_t> visibility;
+    printf("view,time,rasterized_triangles,binned_triangles,covered_pixels,median_ms\n");
+    for (uint32_t viewIdx = 0; viewIdx < (uint32_t)views.size(); ++viewIdx)
+    {
+        const float4x4 viewProjection = view_projection(views[viewIdx], options.width / (float)options.height);
+        for (uint32_t frameIdx = 0; frameIdx < options.numFrames; ++frameIdx)
+        {
+            // Same frame selection as SkinnedMeshRenderer
+            const float time = frameIdx / (float)options.numFrames;
+            const uint32_t frameA = uint32_t(time * numAnimationFrames) % numAnimationFrames;
+            const uint32_t frameB = (frameA + 1) % numAnimationFrames;
+            const float interpolationFactor = time * numAnimationFrames - frameA;
+
+            ScopeHistory frameHistory(options.numIterations);
+            for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+            {
+                auto start = std::chrono::high_resolution_clock::now();
+                rasterizer.render(animation, frameA, frameB, interpolationFactor, viewProjection, views[viewIdx].position);
+                auto stop = std::chrono::high_resolution_clock::now();
+                float durationMS = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f;
+                frameHistory.push(durationMS);
+                history.push(durationMS);
+            }
+
+            rasterizer.read_visibility_buffer(visibility);
+            uint32_t coveredPixels = 0;
+            for (uint32_t value : visibility)
+                coveredPixels += value != SOFTWARE_RASTER_EMPTY_PIXEL ? 1 : 0;
+            const SoftwareRasterizerStats& stats = rasterizer.stats();
+            printf("%u,%.3f,%u,%u,%u,%.3f\n", viewIdx, time, stats.rasterizedTriangles, stats.binnedTriangles, coveredPixels, frameHistory.percentile(50.0f));
+
+            // Material IDs of the visible primitives, like the "Capture Visibility" button
+            if (options.capture && frameIdx == 0)
+            {
+                VisibilityCapture capture;
+                capture.width = options.width;
+                capture.height = options.height;
+                capture.materials.resize(visibility.size());
+                for (uint32_t pixelIdx = 0; pixelIdx < (uint32_t)visibility.size(); ++pixelIdx)
+                {
+                    uint32_t value = visibility[pixelIdx];
+                    capture.materials[pixelIdx] = value == SOFTWARE_RASTER_EMPTY_PIXEL ? TILE_SHAPE_EMPTY_PIXEL
+                        : animation.vertexBufferArray[0].data[animation.indexBuffer[value & 0x7FFFFFFF].x].matID;
+                }
+                const std::string path = "visibility_capture_" + std::to_string(viewIdx) + ".bin";
+                if (!tile_shape::write_capture(path, capture))
+                    printf("Failed to write %s.\n", path.c_str());
+            }
+        }
+    }
+    printf("Frame time: median %.3f ms, p95 %.3f ms\n", history.percentile(50.0f), history.percentile(95.0f));
+
+    rasterizer.release();
+    task_scheduler::release();
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/operators.h"
+
+// System includes
+#include <math.h>
+
+// Synthetic frame shared by the offline sweeps: a textured ground plane seen from a walking height
+
+// Number of feature channels and of sinusoids per channel
+#define GROUND_NUM_FEATURES 16
+#define GROUND_NUM_OCTAVES 8
+
+// Offset of the second UV island of the atlas, used on the right half of the ground
+#define GROUND_ISLAND_OFFSET_X 0.37f
+#define GROUND_ISLAND_OFFSET_Y 0.21f
+
+struct GroundCamera
+{
+    float3 position = { 0.0f, 1.7f, 0.0f };
+    float yaw = 0.0f;
+    float pitch = -0.3f;
+    float tanHalfFov = 0.6f;
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+};
+
+// Band limited feature field, each channel is a sum of sinusoids that can be prefiltered analytically
+struct FeatureField
+{
+    float2 frequency[GROUND_NUM_FEATURES][GROUND_NUM_OCTAVES];
+    float phase[GROUND_NUM_FEATURES][GROUND_NUM_OCTAVES];
+    float amplitude[GROUND_NUM_FEATURES][GROUND_NUM_OCTAVES];
+};
+
+inline float random_float(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0f;
+}
+
+inline void build_field(uint32_t textureSize, FeatureField& field)
+{
+    // Octaves up to the Nyquist frequency of the latent space, the amplitudes fall off with the frequency
+    uint32_t state = 0x1234567u;
+    for (uint32_t featIdx = 0; featIdx < GROUND_NUM_FEATURES; ++featIdx)
+    {
+        float totalAmplitude = 0.0f;
+        for (uint32_t octIdx = 0; octIdx < GROUND_NUM_OCTAVES; ++octIdx)
+        {
+            float frequency = textureSize * 0.5f * powf(0.5f, (float)(GROUND_NUM_OCTAVES - 1 - octIdx));
+            float angle = random_float(state) * 6.2831853f;
+            field.frequency[featIdx][octIdx] = float2({ cosf(angle) * frequency, sinf(angle) * frequency });
+            field.phase[featIdx][octIdx] = random_float(state) * 6.2831853f;
+            field.amplitude[featIdx][octIdx] = (0.5f + random_float(state)) / sqrtf((float)(octIdx + 1));
+            totalAmplitude += field.amplitude[featIdx][octIdx];
+        }
+
+        // Keep the features in [0, 1]
+        for (uint32_t octIdx = 0; octIdx < GROUND_NUM_OCTAVES; ++octIdx)
+            field.amplitude[featIdx][octIdx] *= 0.5f / totalAmplitude;
+    }
+}
+
+inline void evaluate_field(const FeatureField& field, const float2& uv, float footprint, float* features)
+{
+    // Gaussian prefilter of width footprint, the inference reproduces the filtered texture
+    const float twoPiSq = 19.7392088f;
+    for (uint32_t featIdx = 0; featIdx < GROUND_NUM_FEATURES; ++featIdx)
+    {
+        float value = 0.5f;
+        for (uint32_t octIdx = 0; octIdx < GROUND_NUM_OCTAVES; ++octIdx)
+        {
+            const float2& frequency = field.frequency[featIdx][octIdx];
+            float attenuation = expf(-twoPiSq * footprint * footprint * (frequency.x * frequency.x + frequency.y * frequency.y));
+            value += field.amplitude[featIdx][octIdx] * attenuation * sinf(6.2831853f * (frequency.x * uv.x + frequency.y * uv.y) + field.phase[featIdx][octIdx]);
+        }
+        features[featIdx] = value;
+    }
+}
+
+// World space direction of the view ray through a position of the screen (in pixels), not normalized
+inline float3 view_ray(const GroundCamera& camera, float x, float y)
+{
+    float aspect = camera.width / (float)camera.height;
+    float ndcX = (2.0f * x / camera.width - 1.0f) * camera.tanHalfFov * aspect;
+    float ndcY = (1.0f - 2.0f * y / camera.height) * camera.tanHalfFov;
+
+    // Rotate the view ray by the pitch, then by the yaw
+    float3 local = { ndcX, ndcY * cosf(camera.pitch) + sinf(camera.pitch), cosf(camera.pitch) - ndcY * sinf(camera.pitch) };
+    return { local.x * cosf(camera.yaw) + local.z * sinf(camera.yaw), local.y, local.z * cosf(camera.yaw) - local.x * sinf(camera.yaw) };
+}
+
+// Point of the ground seen through a position of the screen (in pixels)
+inline bool ground_hit(const GroundCamera& camera, float x, float y, float2& worldXZ)
+{
+    float3 dir = view_ray(camera, x, y);
+    if (dir.y >= -1e-4f)
+        return false;
+    float t = -camera.position.y / dir.y;
+    worldXZ = float2({ camera.position.x + t * dir.x, camera.position.z + t * dir.z });
+    return true;
+}
+
+// Position of the screen (in pixels) a point of the ground projects to
+inline bool ground_project(const GroundCamera& camera, const float2& worldXZ, float2& pixel)
+{
+    float3 view = { worldXZ.x - camera.position.x, -camera.position.y, worldXZ.y - camera.position.z };
+    float3 local = { view.x * cosf(camera.yaw) - view.z * sinf(camera.yaw), view.y, view.z * cosf(camera.yaw) + view.x * sinf(camera.yaw) };
+    float depth = local.y * sinf(camera.pitch) + local.z * cosf(camera.pitch);
+    if (depth <= 1e-4f)
+        return false;
+    float ndcX = local.x / depth;
+    float ndcY = (local.y * cosf(camera.pitch) - local.z * sinf(camera.pitch)) / depth;
+    float aspect = camera.width / (float)camera.height;
+    pixel = float2({ (ndcX / (camera.tanHalfFov * aspect) + 1.0f) * 0.5f * camera.width, (1.0f - ndcY / camera.tanHalfFov) * 0.5f * camera.height });
+    return true;
+}
+
+// 4 meters per UV unit, the right half of the ground uses another island of the atlas and the far ground another material.
+// The UV without the island offset is continuous, its derivatives are the ones of a triangle.
+inline void ground_surface(const float2& worldXZ, float2& uv, float2& islandOffset, uint32_t& material)
+{
+    uv = float2({ worldXZ.x * 0.25f, worldXZ.y * 0.25f });
+    islandOffset = worldXZ.x > 1.0f ? float2({ GROUND_ISLAND_OFFSET_X, GROUND_ISLAND_OFFSET_Y }) : float2({ 0.0f, 0.0f });
+    material = worldXZ.y > 30.0f ? 1 : 0;
+}
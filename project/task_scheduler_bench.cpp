@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "tools/cpu_profiler.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct BenchOptions
+{
+    // 0 uses every hardware thread
+    uint32_t numThreads = 0;
+
+    // Tasks or elements per stress run
+    uint32_t numTasks = 100000;
+
+    // Repetitions of every stress and benchmark run
+    uint32_t numIterations = 5;
+};
+
+static void print_usage()
+{
+    printf("Usage: task_scheduler_bench [options]\n");
+    printf("--threads Number of threads, 0 for all of them (default 0).\n");
+    printf("--tasks Tasks or elements per run (default 100000).\n");
+    printf("--iterations Repetitions of every run (default 5).\n");
+}
+
+static bool parse_args(int argc, char** argv, BenchOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--threads" && hasValue)
+            options.numThreads = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--tasks" && hasValue)
+            options.numTasks = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--iterations" && hasValue)
+            options.numIterations = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.numTasks > 0 && options.numIterations > 0;
+}
+
+// Every task of a flat group runs exactly once, the plain writes are published by the wait
+static uint32_t stress_flat(uint32_t numTasks)
+{
+    std::vector<uint32_t> executed(numTasks, 0);
+    TaskGroup group;
+    for (uint32_t taskIdx = 0; taskIdx < numTasks; ++taskIdx)
+        task_scheduler::run(group, [&executed, taskIdx]() { executed[taskIdx]++; });
+    task_scheduler::wait(group);
+
+    uint32_t errors = 0;
+    for (uint32_t count : executed)
+        errors += count == 1 ? 0 : 1;
+    return errors;
+}
+
+// Binary tree of tasks that wait on their children, the waits of the workers have to help or the pool deadlocks
+static uint32_t count_leaves(uint32_t depth)
+{
+    if (depth == 0)
+        return 1;
+    uint32_t left = 0, right = 0;
+    TaskGroup group;
+    task_scheduler::run(group, [&left, depth]() { left = count_leaves(depth - 1); });
+    task_scheduler::run(group, [&right, depth]() { right = count_leaves(depth - 1); });
+    task_scheduler::wait(group);
+    return left + right;
+}
+
+static uint32_t stress_nested(uint32_t numTasks)
+{
+    uint32_t depth = 1;
+    while ((2u << depth) <= numTasks && depth < 20)
+        depth++;
+    return count_leaves(depth) == (1u << depth) ? 0 : 1;
+}
+
+// Chains of continuations, each one reads what the tasks before it wrote without synchronization of its own
+static uint32_t stress_continuations(uint32_t numTasks)
+{
+    const uint32_t numLinks = 64;
+    const uint32_t tasksPerLink = std::max(numTasks / numLinks, 1u);
+    std::vector<uint32_t> values(tasksPerLink, 0);
+    std::vector<uint32_t> sums(numLinks, 0);
+
+    TaskGroup successor;
+    std::function<void(uint32_t)> link = [&](uint32_t linkIdx)
+    {
+        std::vector<std::function<void()>> tasks;
+        for (uint32_t taskIdx = 0; taskIdx < tasksPerLink; ++taskIdx)
+            tasks.push_back([&values, taskIdx]() { values[taskIdx]++; });
+        task_scheduler::run_with_continuation(successor, tasks, [&, linkIdx]()
+            {
+                uint32_t sum = 0;
+                for (uint32_t value : values)
+                    sum += value;
+                sums[linkIdx] = sum;
+                if (linkIdx + 1 < numLinks)
+                    link(linkIdx + 1);
+            });
+    };
+    link(0);
+    task_scheduler::wait(successor);
+
+    uint32_t errors = 0;
+    for (uint32_t linkIdx = 0; linkIdx < numLinks; ++linkIdx)
+        errors += sums[linkIdx] == (linkIdx + 1) * tasksPerLink ? 0 : 1;
+    return errors;
+}
+
+// Every index of a parallel for is covered once, for several grains and with nested loops
+static uint32_t stress_parallel_for(uint32_t numTasks)
+{
+    uint32_t errors = 0;
+    const uint32_t grains[] = { 1, 7, 256, numTasks };
+    for (uint32_t grain : grains)
+    {
+        std::vector<uint32_t> executed(numTasks, 0);
+        task_scheduler::parallel_for(0, numTasks, [&](uint32_t first, uint32_t last)
+            {
+                for (uint32_t idx = first; idx < last; ++idx)
+                    executed[idx]++;
+            }, grain);
+        for (uint32_t count : executed)
+            errors += count == 1 ? 0 : 1;
+    }
+
+    const uint32_t numRows = 64;
+    const uint32_t rowSize = std::max(numTasks / numRows, 1u);
+    std::vector<uint32_t> executed(numRows * rowSize, 0);
+    task_scheduler::parallel_for(0, numRows, [&](uint32_t firstRow, uint32_t lastRow)
+        {
+            for (uint32_t rowIdx = firstRow; rowIdx < lastRow; ++rowIdx)
+            {
+                task_scheduler::parallel_for(0, rowSize, [&, rowIdx](uint32_t first, uint32_t last)
+                    {
+                        for (uint32_t idx = first; idx < last; ++idx)
+                            executed[rowIdx * rowSize + idx]++;
+                    });
+            }
+        });
+    for (uint32_t count : executed)
+        errors += count == 1 ? 0 : 1;
+    return errors;
+}
+
+// Tasks spawned from a thread that is foreign to the pool go through the shared queue
+static uint32_t stress_foreign(uint32_t numTasks)
+{
+    std::atomic<uint32_t> executed(0);
+    TaskGroup group;
+    std::thread foreign([&]()
+        {
+            for (uint32_t taskIdx = 0; taskIdx < numTasks; ++taskIdx)
+                task_scheduler::run(group, [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); });
+            task_scheduler::wait(group);
+        });
+    foreign.join();
+    return executed.load() == numTasks ? 0 : 1;
+}
+
+// Work of a benchmark element, a few dozen nanoseconds
+static float kernel(uint32_t idx)
+{
+    float value = (float)idx;
+    for (uint32_t stepIdx = 0; stepIdx < 16; ++stepIdx)
+        value = sqrtf(value + 1.0f) * 1.5f;
+    return value;
+}
+
+static float duration_ms(std::chrono::high_resolution_clock::time_point start)
+{
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3f;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    task_scheduler::initialize(options.numThreads);
+    const uint32_t numThreads = task_scheduler::num_threads();
+    printf("%u threads, %u tasks, %u iterations\n", numThreads, options.numTasks, options.numIterations);
+
+    // Stress, run it in a build with -fsanitize=thread to check the synchronization
+    uint32_t totalErrors = 0;
+    struct StressRun { const char* name; uint32_t(*func)(uint32_t); };
+    const StressRun stressRuns[] = { { "flat", stress_flat }, { "nested", stress_nested }, { "continuations", stress_continuations },
+        { "parallel_for", stress_parallel_for }, { "foreign", stress_foreign } };
+    for (const StressRun& run : stressRuns)
+    {
+        uint32_t errors = 0;
+        for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+            errors += run.func(options.numTasks);
+        printf("Stress, %s: %u errors\n", run.name, errors);
+        totalErrors += errors;
+    }
+
+    // Overhead of a task, spawned and waited on in a group
+    ScopeHistory spawnHistory(options.numIterations);
+    for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        TaskGroup group;
+        for (uint32_t taskIdx = 0; taskIdx < options.numTasks; ++taskIdx)
+            task_scheduler::run(group, []() {});
+        task_scheduler::wait(group);
+        spawnHistory.push(duration_ms(start) * 1e6f / options.numTasks);
+    }
+
+    // Parallel for against a serial loop and against a std::thread per hardware thread
+    std::vector<float> output(options.numTasks);
+    ScopeHistory serialHistory(options.numIterations);
+    ScopeHistory parallelHistory(options.numIterations);
+    ScopeHistory threadHistory(options.numIterations);
+    for (uint32_t iterationIdx = 0; iterationIdx < options.numIterations; ++iterationIdx)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t idx = 0; idx < options.numTasks; ++idx)
+            output[idx] = kernel(idx);
+        serialHistory.push(duration_ms(start));
+
+        start = std::chrono::high_resolution_clock::now();
+        task_scheduler::parallel_for(0, options.numTasks, [&output](uint32_t first, uint32_t last)
+            {
+                for (uint32_t idx = first; idx < last; ++idx)
+                    output[idx] = kernel(idx);
+            }, 64);
+        parallelHistory.push(duration_ms(start));
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        const uint32_t chunk = (options.numTasks + numThreads - 1) / numThreads;
+        for (uint32_t thIdx = 0; thIdx < numThreads; ++thIdx)
+        {
+            threads.emplace_back([&output, thIdx, chunk, &options]()
+                {
+                    const uint32_t last = std::min((thIdx + 1) * chunk, options.numTasks);
+                    for (uint32_t idx = thIdx * chunk; idx < last; ++idx)
+                        output[idx] = kernel(idx);
+                });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        threadHistory.push(duration_ms(start));
+    }
+
+    printf("run,median,p95\n");
+    printf("spawn_wait_ns_per_task,%.1f,%.1f\n", spawnHistory.percentile(50.0f), spawnHistory.percentile(95.0f));
+    printf("serial_ms,%.3f,%.3f\n", serialHistory.percentile(50.0f), serialHistory.percentile(95.0f));
+    printf("parallel_for_ms,%.3f,%.3f\n", parallelHistory.percentile(50.0f), parallelHistory.percentile(95.0f));
+    printf("std_thread_ms,%.3f,%.3f\n", threadHistory.percentile(50.0f), threadHistory.percentile(95.0f));
+
+    task_scheduler::release();
+    return totalErrors == 0 ? 0 : -1;
+}
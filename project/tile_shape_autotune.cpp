@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/tile_shape.h"
+#include "synthetic_ground.h"
+
+// System includes
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct AutotuneOptions
+{
+    // Visibility buffers written by the "Capture Visibility" button, a synthetic frame is used when there are none
+    std::vector<std::string> captures;
+
+    // Wave sizes of the target device
+    uint32_t waveMin = 32;
+    uint32_t waveMax = 32;
+
+    // Relative cost of the passes
+    TileShapeCostModel costModel;
+};
+
+static void print_usage()
+{
+    printf("Usage: tile_shape_autotune [options] [capture ...]\n");
+    printf("--wave-min Smallest wave the device runs (default 32).\n");
+    printf("--wave-max Largest wave the device runs (default 32).\n");
+    printf("--repacked-weight Cost of a lane of a repacked group relative to a lane of a uniform tile (default 1.25).\n");
+    printf("--classification-weight Cost of a lane of the classification passes (default 0.1).\n");
+    printf("--shading-weight Cost of a lane of the lighting passes (default 0.25).\n");
+}
+
+static bool parse_args(int argc, char** argv, AutotuneOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--wave-min" && hasValue)
+            options.waveMin = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--wave-max" && hasValue)
+            options.waveMax = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--repacked-weight" && hasValue)
+            options.costModel.repackedInference = (float)atof(argv[++argIdx]);
+        else if (arg == "--classification-weight" && hasValue)
+            options.costModel.classification = (float)atof(argv[++argIdx]);
+        else if (arg == "--shading-weight" && hasValue)
+            options.costModel.shading = (float)atof(argv[++argIdx]);
+        else if (arg.size() > 0 && arg[0] != '-')
+            options.captures.push_back(arg);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.waveMin > 0 && options.waveMin <= options.waveMax;
+}
+
+// The ground of the sweeps under a sky, with a few characters standing on it
+static void synthetic_capture(VisibilityCapture& capture)
+{
+    GroundCamera camera;
+    capture.width = camera.width;
+    capture.height = camera.height;
+    capture.materials.assign(capture.width * capture.height, TILE_SHAPE_EMPTY_PIXEL);
+    for (uint32_t y = 0; y < capture.height; ++y)
+    {
+        for (uint32_t x = 0; x < capture.width; ++x)
+        {
+            float2 worldXZ, uv, islandOffset;
+            if (!ground_hit(camera, x + 0.5f, y + 0.5f, worldXZ))
+                continue;
+            ground_surface(worldXZ, uv, islandOffset, capture.materials[x + y * capture.width]);
+        }
+    }
+
+    // Ellipses of two materials, small ones for the distant characters
+    uint32_t state = 0x7F4A7C15u;
+    for (uint32_t ellipseIdx = 0; ellipseIdx < 24; ++ellipseIdx)
+    {
+        float centerX = random_float(state) * capture.width;
+        float centerY = (0.4f + 0.6f * random_float(state)) * capture.height;
+        float radiusX = 8.0f + random_float(state) * 120.0f;
+        float radiusY = radiusX * (1.5f + random_float(state));
+        uint32_t material = 2 + ellipseIdx % 2;
+        for (uint32_t y = 0; y < capture.height; ++y)
+        {
+            for (uint32_t x = 0; x < capture.width; ++x)
+            {
+                float dx = (x + 0.5f - centerX) / radiusX;
+                float dy = (y + 0.5f - centerY) / radiusY;
+                if (dx * dx + dy * dy <= 1.0f)
+                    capture.materials[x + y * capture.width] = material;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    AutotuneOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // Load the frames
+    std::vector<std::string> names;
+    std::vector<VisibilityCapture> captures;
+    for (const std::string& path : options.captures)
+    {
+        VisibilityCapture capture;
+        if (!tile_shape::read_capture(path, capture))
+        {
+            printf("Failed to read the visibility capture %s.\n", path.c_str());
+            return -1;
+        }
+        names.push_back(path);
+        captures.push_back(capture);
+    }
+    if (captures.empty())
+    {
+        captures.resize(1);
+        synthetic_capture(captures[0]);
+        names.push_back("synthetic");
+    }
+
+    // Every shape on every frame
+    const uint2 waveLaneRange = { options.waveMin, options.waveMax };
+    const uint32_t numShapes = (uint32_t)TileShape::Count;
+    std::vector<double> totalCost(numShapes, 0.0);
+    printf("Waves of %u to %u lanes\n", options.waveMin, options.waveMax);
+    printf("capture,shape,supported,active_tiles,uniform_fraction,repacked_groups,lane_efficiency,repack_overhead,relative_cost\n");
+    for (uint32_t captureIdx = 0; captureIdx < (uint32_t)captures.size(); ++captureIdx)
+    {
+        // Costs are relative to the default shape
+        TileShapeStats defaultStats = tile_shape::evaluate(captures[captureIdx], TileShape::Tile8x4, options.waveMin, options.costModel);
+        for (uint32_t shapeIdx = 0; shapeIdx < numShapes; ++shapeIdx)
+        {
+            TileShape shape = (TileShape)shapeIdx;
+            TileShapeStats stats = tile_shape::evaluate(captures[captureIdx], shape, options.waveMin, options.costModel);
+            double relativeCost = defaultStats.cost > 0.0 ? stats.cost / defaultStats.cost : 1.0;
+            totalCost[shapeIdx] += relativeCost;
+            printf("%s,%s,%s,%u,%.3f,%u,%.3f,%.3f,%.3f\n", names[captureIdx].c_str(), tile_shape::name(shape), tile_shape::supported(shape, waveLaneRange) ? "yes" : "no",
+                stats.activeTiles, stats.uniformFraction, stats.repackedGroups, stats.laneEfficiency, stats.repackOverhead, relativeCost);
+        }
+    }
+
+    // Cheapest shape the device can run, on average over the frames
+    TileShape bestShape = TileShape::Tile8x4;
+    double bestCost = DBL_MAX;
+    for (uint32_t shapeIdx = 0; shapeIdx < numShapes; ++shapeIdx)
+    {
+        if (tile_shape::supported((TileShape)shapeIdx, waveLaneRange) && totalCost[shapeIdx] < bestCost)
+        {
+            bestCost = totalCost[shapeIdx];
+            bestShape = (TileShape)shapeIdx;
+        }
+    }
+    printf("Recommended: --tile-shape %s (%.3f of the 8x4 cost)\n", tile_shape::name(bestShape), bestCost / captures.size());
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "tools/tlsf_allocator.h"
+
+// System includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+static uint32_t random_uint(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Sizes are rounded up to the granularity and the whole range can be handed out in one block
+static bool check_granularity()
+{
+    TLSFAllocator allocator;
+    allocator.initialize(1000, 64);
+    bool success = allocator.capacity() == 960;
+
+    uint64_t offsetA = 0, offsetB = 0, offsetC = 0;
+    const uint32_t allocA = allocator.allocate(1, offsetA);
+    const uint32_t allocB = allocator.allocate(65, offsetB);
+    success &= allocA != TLSF_INVALID_ALLOCATION && allocB != TLSF_INVALID_ALLOCATION;
+    success &= offsetA == 0 && offsetB == 64 && allocator.stats().usedBytes == 192;
+
+    // The rest of the range, then nothing
+    success &= allocator.allocate(768, offsetC) != TLSF_INVALID_ALLOCATION && offsetC == 192;
+    success &= allocator.allocate(1, offsetC) == TLSF_INVALID_ALLOCATION;
+    allocator.free(allocA);
+    allocator.free(allocB);
+    success &= allocator.allocate(2000, offsetC) == TLSF_INVALID_ALLOCATION;
+    allocator.release();
+    return success;
+}
+
+// Released blocks merge with their free neighbours on both sides, in any order
+static bool check_coalescing()
+{
+    TLSFAllocator allocator;
+    allocator.initialize(4096, 256);
+    uint64_t offset = 0;
+    std::vector<uint32_t> allocations;
+    for (uint32_t allocIdx = 0; allocIdx < 4; ++allocIdx)
+        allocations.push_back(allocator.allocate(1024, offset));
+    bool success = allocator.stats().freeBlocks == 0;
+
+    // Two holes that aren't neighbours
+    allocator.free(allocations[0]);
+    allocator.free(allocations[2]);
+    TLSFStats stats = allocator.stats();
+    success &= stats.freeBlocks == 2 && stats.largestFreeBlock == 1024 && stats.fragmentation == 0.5f;
+
+    // The block between them joins both
+    allocator.free(allocations[1]);
+    stats = allocator.stats();
+    success &= stats.freeBlocks == 1 && stats.largestFreeBlock == 3072 && stats.fragmentation == 0.0f;
+
+    // Last one, the range is whole again
+    allocator.free(allocations[3]);
+    stats = allocator.stats();
+    success &= allocator.empty() && stats.freeBlocks == 1 && stats.largestFreeBlock == 4096 && stats.peakBytes == 4096;
+    allocator.release();
+    return success;
+}
+
+// A request never lands in a block smaller than it, even when the free lists of its size class hold one
+static bool check_size_classes()
+{
+    TLSFAllocator allocator;
+    allocator.initialize(1 << 20, 1);
+    uint64_t offset = 0;
+
+    // Holes of 1030 and 1100 bytes between allocations that stay live, the first one is in the size class of 1050
+    std::vector<uint32_t> holes;
+    for (uint64_t size : { 1030ull, 1100ull })
+    {
+        holes.push_back(allocator.allocate(size, offset));
+        allocator.allocate(16, offset);
+    }
+    for (uint32_t hole : holes)
+        allocator.free(hole);
+
+    // 1050 doesn't fit in the first hole and goes to the second one
+    bool success = allocator.allocate(1050, offset) != TLSF_INVALID_ALLOCATION && offset == 1046;
+
+    // An exact power of two is served from its own class
+    success &= allocator.allocate(1024, offset) != TLSF_INVALID_ALLOCATION;
+    allocator.release();
+    return success;
+}
+
+// Random allocations and releases checked against a list of the live blocks
+static bool check_random(uint32_t numOperations, uint32_t seed)
+{
+    struct LiveBlock { uint32_t allocation; uint64_t offset, size; };
+    const uint64_t capacity = 1 << 24;
+    const uint64_t granularity = 256;
+    TLSFAllocator allocator;
+    allocator.initialize(capacity, granularity);
+    std::vector<LiveBlock> liveBlocks;
+    uint32_t state = seed;
+    bool success = true;
+
+    for (uint32_t opIdx = 0; opIdx < numOperations; ++opIdx)
+    {
+        if (liveBlocks.empty() || random_uint(state) % 3 != 0)
+        {
+            // Mostly small blocks with a few big ones
+            const uint64_t size = 1 + (random_uint(state) % 4 == 0 ? random_uint(state) % (capacity / 16) : random_uint(state) % 65536);
+            uint64_t offset = 0;
+            const uint32_t allocation = allocator.allocate(size, offset);
+            if (allocation == TLSF_INVALID_ALLOCATION)
+                continue;
+
+            const uint64_t roundedSize = (size + granularity - 1) & ~(granularity - 1);
+            success &= offset % granularity == 0 && offset + roundedSize <= capacity;
+            for (const LiveBlock& live : liveBlocks)
+                success &= offset + roundedSize <= live.offset || live.offset + live.size <= offset;
+            liveBlocks.push_back({ allocation, offset, roundedSize });
+        }
+        else
+        {
+            const uint32_t liveIdx = random_uint(state) % (uint32_t)liveBlocks.size();
+            allocator.free(liveBlocks[liveIdx].allocation);
+            liveBlocks[liveIdx] = liveBlocks.back();
+            liveBlocks.pop_back();
+        }
+
+        // The stats match the live blocks
+        uint64_t usedBytes = 0;
+        for (const LiveBlock& live : liveBlocks)
+            usedBytes += live.size;
+        const TLSFStats stats = allocator.stats();
+        success &= stats.usedBytes == usedBytes && stats.liveAllocations == liveBlocks.size() && stats.largestFreeBlock <= capacity - usedBytes;
+    }
+
+    // Everything merges back into a single block
+    for (const LiveBlock& live : liveBlocks)
+        allocator.free(live.allocation);
+    const TLSFStats stats = allocator.stats();
+    success &= allocator.empty() && stats.freeBlocks == 1 && stats.largestFreeBlock == capacity;
+    allocator.release();
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numOperations = 100000;
+    uint32_t seed = 1;
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        if (arg == "--ops" && argIdx + 1 < argc)
+            numOperations = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--seed" && argIdx + 1 < argc)
+            seed = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            printf("Usage: tlsf_allocator_check [--ops count (default 100000)] [--seed value (default 1)]\n");
+            return -1;
+        }
+    }
+
+    struct CheckCase { const char* name; bool passed; };
+    const CheckCase cases[] = {
+        { "granularity", check_granularity() },
+        { "coalescing", check_coalescing() },
+        { "size_classes", check_size_classes() },
+        { "random_operations", check_random(numOperations, seed) } };
+
+    bool success = true;
+    printf("case,status\n");
+    for (const CheckCase& checkCase : cases)
+    {
+        printf("%s,%s\n", checkCase.name, checkCase.passed ? "ok" : "FAILED");
+        success &= checkCase.passed;
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/variable_rate.h"
+#include "synthetic_ground.h"
+
+// System includes
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct SweepOptions
+{
+    // Resolution of the synthetic frame
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+
+    // Resolution of the latent space
+    uint32_t textureSize = 2048;
+};
+
+static void print_usage()
+{
+    printf("Usage: variable_rate_sweep [options]\n");
+    printf("--width Width of the synthetic frame (default 1920).\n");
+    printf("--height Height of the synthetic frame (default 1080).\n");
+    printf("--texture-size Resolution of the latent space (default 2048).\n");
+}
+
+static bool parse_args(int argc, char** argv, SweepOptions& options)
+{
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        const bool hasValue = argIdx + 1 < argc;
+        if (arg == "--width" && hasValue)
+            options.width = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--height" && hasValue)
+            options.height = (uint32_t)atoi(argv[++argIdx]);
+        else if (arg == "--texture-size" && hasValue)
+            options.textureSize = (uint32_t)atoi(argv[++argIdx]);
+        else
+        {
+            print_usage();
+            return false;
+        }
+    }
+    return options.width > 0 && options.height > 0 && options.textureSize > 1;
+}
+
+// Ramps across the ground at increasing distances, a ramp rises over its run and drops back to the ground behind it.
+// The tiles across their edges mix the footprint of the ground seen at a grazing angle with the one of the slope
+// seen more frontally, a short run gives a steep slope and a large spread, a long one a gentle slope and a small one
+struct SweepRamp
+{
+    float z;
+    float run;
+    float height;
+};
+static const SweepRamp sweepRamps[] = { { 4.0f, 0.5f, 0.3f }, { 9.0f, 2.0f, 0.3f }, { 15.0f, 4.0f, 0.4f }, { 22.0f, 5.0f, 0.6f } };
+
+// Point of the slope of a ramp seen through a position of the screen (in pixels), as world X and distance along the slope
+static bool ramp_hit(const GroundCamera& camera, const SweepRamp& ramp, float x, float y, float2& rampXS, float& distance, float& height)
+{
+    const float3 dir = view_ray(camera, x, y);
+    const float denom = dir.y * ramp.run - dir.z * ramp.height;
+    if (fabsf(denom) < 1e-6f)
+        return false;
+    distance = (-camera.position.y * ramp.run - (ramp.z - camera.position.z) * ramp.height) / denom;
+    height = camera.position.y + distance * dir.y;
+    const float slopeLength = sqrtf(ramp.run * ramp.run + ramp.height * ramp.height);
+    rampXS = float2({ camera.position.x + distance * dir.x, height / ramp.height * slopeLength });
+    return distance > 0.0f;
+}
+
+// Closest ramp slope seen through a position of the screen, nullptr if the ground is visible there
+static const SweepRamp* visible_ramp(const GroundCamera& camera, float x, float y, float2& rampXS)
+{
+    const SweepRamp* closest = nullptr;
+    float closestDistance = FLT_MAX;
+    for (const SweepRamp& ramp : sweepRamps)
+    {
+        float2 hitXS;
+        float distance, height;
+        if (ramp_hit(camera, ramp, x, y, hitXS, distance, height) && distance < closestDistance && height >= 0.0f && height <= ramp.height)
+        {
+            closest = &ramp;
+            closestDistance = distance;
+            rampXS = hitXS;
+        }
+    }
+    return closest;
+}
+
+static void build_tiles(const SweepOptions& options, const FeatureField& field, std::vector<VariableRateTile>& tiles, std::vector<float>& referenceFeatures)
+{
+    GroundCamera camera;
+    camera.width = options.width;
+    camera.height = options.height;
+    const uint32_t tileCountX = (options.width + VRS_TILE_WIDTH - 1) / VRS_TILE_WIDTH;
+    const uint32_t tileCountY = (options.height + VRS_TILE_HEIGHT - 1) / VRS_TILE_HEIGHT;
+    const float numMips = log2f((float)options.textureSize);
+    tiles.resize(tileCountX * tileCountY);
+    referenceFeatures.assign(tiles.size() * VRS_TILE_PIXELS * VRS_NUM_FEATURES, 0.0f);
+
+    for (uint32_t tileIdx = 0; tileIdx < (uint32_t)tiles.size(); ++tileIdx)
+    {
+        VariableRateTile& tile = tiles[tileIdx];
+        for (uint32_t pixelIdx = 0; pixelIdx < VRS_TILE_PIXELS; ++pixelIdx)
+        {
+            uint32_t x = (tileIdx % tileCountX) * VRS_TILE_WIDTH + pixelIdx % VRS_TILE_WIDTH;
+            uint32_t y = (tileIdx / tileCountX) * VRS_TILE_HEIGHT + pixelIdx / VRS_TILE_WIDTH;
+            // The ramps hide the ground behind them, same material as the near ground and the same scale of 4 meters per UV unit
+            float2 rampXS, rampRightXS, rampBottomXS;
+            float2 uv, uvRight, uvBottom, islandOffset;
+            const bool onScreen = x < options.width && y < options.height;
+            const SweepRamp* ramp = onScreen ? visible_ramp(camera, x + 0.5f, y + 0.5f, rampXS) : nullptr;
+            tile.material[pixelIdx] = UINT32_MAX;
+            if (ramp != nullptr)
+            {
+                // The derivatives are taken on the plane of the slope, like the barycentric ones of a triangle
+                float unusedDistance, unusedHeight;
+                tile.covered[pixelIdx] = ramp_hit(camera, *ramp, x + 1.5f, y + 0.5f, rampRightXS, unusedDistance, unusedHeight)
+                    && ramp_hit(camera, *ramp, x + 0.5f, y + 1.5f, rampBottomXS, unusedDistance, unusedHeight);
+                if (!tile.covered[pixelIdx])
+                    continue;
+                uv = rampXS * 0.25f;
+                uvRight = rampRightXS * 0.25f;
+                uvBottom = rampBottomXS * 0.25f;
+                islandOffset = float2({ 0.0f, 0.0f });
+                tile.material[pixelIdx] = 0;
+            }
+            else
+            {
+                float2 worldXZ, worldRightXZ, worldBottomXZ;
+                tile.covered[pixelIdx] = onScreen
+                    && ground_hit(camera, x + 0.5f, y + 0.5f, worldXZ)
+                    && ground_hit(camera, x + 1.5f, y + 0.5f, worldRightXZ)
+                    && ground_hit(camera, x + 0.5f, y + 1.5f, worldBottomXZ);
+                if (!tile.covered[pixelIdx])
+                    continue;
+
+                // The derivatives ignore the island, like the barycentric ones of a triangle
+                float2 unusedOffset;
+                uint32_t unusedMaterial;
+                ground_surface(worldXZ, uv, islandOffset, tile.material[pixelIdx]);
+                ground_surface(worldRightXZ, uvRight, unusedOffset, unusedMaterial);
+                ground_surface(worldBottomXZ, uvBottom, unusedOffset, unusedMaterial);
+            }
+            tile.uv[pixelIdx] = uv + islandOffset;
+            tile.uvDX[pixelIdx] = uvRight - uv;
+            tile.uvDY[pixelIdx] = uvBottom - uv;
+
+            // Same LOD as compute_lod with the filtering enabled
+            float footprint = std::max(length(tile.uvDX[pixelIdx]), length(tile.uvDY[pixelIdx]));
+            float lodLevel = log2f(std::max(footprint * options.textureSize, 1e-8f));
+            tile.lod[pixelIdx] = clamp(lodLevel / numMips, 0.0f, 1.0f);
+            evaluate_field(field, tile.uv[pixelIdx], footprint, referenceFeatures.data() + (tileIdx * VRS_TILE_PIXELS + pixelIdx) * VRS_NUM_FEATURES);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SweepOptions options;
+    if (!parse_args(argc, argv, options))
+        return -1;
+
+    // Synthetic frame
+    FeatureField field;
+    build_field(options.textureSize, field);
+    std::vector<VariableRateTile> tiles;
+    std::vector<float> referenceFeatures;
+    build_tiles(options, field, tiles, referenceFeatures);
+    const float numMips = log2f((float)options.textureSize);
+
+    // Thresholds to sweep, the first one disables the reduced rates
+    std::vector<VariableRateSettings> sweep = { { 2.0f * numMips, 2.0f * numMips, 0.0f } };
+    const float halfRateMips[] = { 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 4.0f };
+    const float maxMipSpreads[] = { 0.5f, 1.0f };
+    for (float halfRateMip : halfRateMips)
+    {
+        for (float maxMipSpread : maxMipSpreads)
+            sweep.push_back({ halfRateMip, halfRateMip + 1.0f, maxMipSpread });
+    }
+
+    printf("%ux%u frame, %u tiles, %ux%u latent space\n", options.width, options.height, (uint32_t)tiles.size(), options.textureSize, options.textureSize);
+    printf("half_mip,quarter_mip,max_spread,full_tiles,half_tiles,quarter_tiles,inferred_ratio,psnr_db\n");
+    for (const VariableRateSettings& settings : sweep)
+    {
+        VariableRateStats stats = variable_rate::evaluate(tiles, referenceFeatures, settings, numMips);
+        double inferredRatio = stats.coveredPixels > 0 ? stats.inferredPixels / (double)stats.coveredPixels : 1.0;
+        printf("%.1f,%.1f,%.1f,%u,%u,%u,%.3f,%.2f\n", settings.halfRateMip, settings.quarterRateMip, settings.maxMipSpread,
+            stats.numTiles[(uint32_t)InferenceRate::Full], stats.numTiles[(uint32_t)InferenceRate::Half], stats.numTiles[(uint32_t)InferenceRate::Quarter], inferredRatio, stats.psnr);
+    }
+    return 0;
+}
@@ -8,8 +8,11 @@
 #pragma once
 
 // SDK includes
+#include "graphics/binding_table.h"
 #include "graphics/descriptors.h"
+#include "tools/descriptor_ring.h"
 #include "tools/security.h"
+#include "tools/tlsf_allocator.h"
 
 // DX12 includes
 #define NOMINMAX
@@ -19,9 +22,12 @@
 #include <dxcapi.h>
 
 // System includes
+#include <atomic>
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
+#include <thread>
 
 namespace d3d12
 {
@@ -29,6 +35,19 @@ namespace d3d12
 	#define DX12_NUM_FRAMES 2
 	#define DX12_CB_ALIGNEMENT_SIZE 256
 
+	// Descriptor management
+	#define DX12_DESCRIPTOR_RING_SIZE 65536
+	#define DX12_SAMPLER_RING_SIZE 2048
+	#define DX12_DESCRIPTOR_CHUNK_SIZE 1024
+	#define DX12_SAMPLER_CHUNK_SIZE 64
+	#define DX12_STAGING_PAGE_SIZE 1024
+
+	// Placed resources, anything bigger than a heap gets a committed resource
+	#define DX12_HEAP_SIZE (64 * 1024 * 1024)
+
+	// Pool of the allocations placed in a transient heap at an offset picked by the caller
+	#define DX12_ALIASED_POOL (UINT32_MAX - 1)
+
 	// Forward declarations
 	struct DX12GraphicsDevice;
 	struct DX12Window;
@@ -41,7 +60,8 @@ namespace d3d12
 	struct DX12Sampler;
 	struct DX12GraphicsBuffer;
 
-	struct DX12DescriptorHeap;
+	struct DX12StagingHeap;
+	struct DX12HeapPool;
 	struct DX12RootSignature;
 	struct DX12ComputeShader;
 	struct DX12GraphicsPipeline;
@@ -77,6 +97,55 @@ namespace d3d12
 		ProfilingScopeT,
 	};
 
+	enum class DX12ViewType
+	{
+		SRV,
+		UAV,
+		CBV,
+		RTAS,
+		Sampler
+	};
+
+	struct DX12CachedView
+	{
+		// Kind of view and its parameter (mip level for textures, offset for buffers)
+		DX12ViewType type = DX12ViewType::SRV;
+		uint64_t parameter = 0;
+
+		// Location in the staging heap
+		uint32_t slot = UINT32_MAX;
+		D3D12_CPU_DESCRIPTOR_HANDLE handle = {};
+	};
+
+	// Resources can only share a heap with resources of the same kind (tier 1 heaps) and placed at the same alignment
+	enum class DX12HeapPoolType
+	{
+		Buffers = 0,
+		UploadBuffers,
+		ReadbackBuffers,
+		Textures,
+		SmallTextures,
+		RenderTextures,
+		Count
+	};
+
+	struct DX12Allocation
+	{
+		// Pool, heap and block the resource was placed in, UINT32_MAX pool for committed resources and DX12_ALIASED_POOL for the aliased ones
+		uint32_t pool = UINT32_MAX;
+		uint32_t heap = UINT32_MAX;
+		uint32_t block = TLSF_INVALID_ALLOCATION;
+		uint64_t size = 0;
+	};
+
+	struct DX12DescriptorChunk
+	{
+		// Block of the device ring and number of descriptors already used
+		uint32_t offset = UINT32_MAX;
+		uint32_t size = 0;
+		uint32_t used = 0;
+	};
+
 	struct DX12GraphicsDevice
 	{
 #if defined(_DEBUG)
@@ -98,6 +167,24 @@ namespace d3d12
 		// Descriptor sizes
 		uint32_t descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES] = {};
 
+		// CPU only heaps where the views of the resources are created once
+		DX12StagingHeap* stagingCSU = nullptr;
+		DX12StagingHeap* stagingSampler = nullptr;
+
+		// Shader visible heaps the descriptor tables are copied into, shared by all the command buffers
+		ID3D12DescriptorHeap* ringHeapCSU = nullptr;
+		ID3D12DescriptorHeap* ringHeapSampler = nullptr;
+		DescriptorRing ringCSU;
+		DescriptorRing ringSampler;
+
+		// Fences the ring blocks are retired against, indexed by timeline
+		std::vector<ID3D12Fence*> timelines;
+
+		// Heaps the resources are placed in
+		DX12HeapPool* heapPools[(uint32_t)DX12HeapPoolType::Count] = {};
+		std::mutex heapMutex;
+		uint32_t committedResources = 0;
+
 		// Feature support
 		bool supportRayTracing = false;
 		bool supportWaveMMA = false;
@@ -107,6 +194,10 @@ namespace d3d12
 		bool supportWorkGraph = false;
 		bool supportCoopVectors = false;
 
+		// Wave sizes the device can run
+		uint32_t waveLaneCountMin = 32;
+		uint32_t waveLaneCountMax = 32;
+
 		// Tracks if the device was created with the debug option
 		bool debugDevice = false;
 
@@ -114,8 +205,8 @@ namespace d3d12
 		uint64_t allocatedMemory = 0;
 		uint32_t allocatedTextures = 0;
 		uint32_t allocatedBuffers = 0;
-		uint32_t allocatedCS = 0;
-		uint32_t allocatedGP = 0;
+		std::atomic<uint32_t> allocatedCS = 0;
+		std::atomic<uint32_t> allocatedGP = 0;
 		uint32_t allocatedSamplers = 0;
 	};
 
@@ -129,6 +220,13 @@ namespace d3d12
 
 		// Actual window
 		HWND window = nullptr;
+
+		// Thread that created the window and pumps its messages
+		std::thread messageThread;
+
+		// Thread that created the render window, its input state is attached to the one of the message thread
+		DWORD renderThreadId = 0;
+		DWORD messageThreadId = 0;
 	};
 
 	struct DX12CommandSubQueue
@@ -150,6 +248,9 @@ namespace d3d12
 
 		// Fence value
 		uint64_t fenceValue = UINT64_MAX;
+
+		// Index of the fence in the device's timelines
+		uint32_t timeline = DESCRIPTOR_RING_NO_TIMELINE;
 	};
 
 	struct DX12CommandQueue
@@ -187,9 +288,15 @@ namespace d3d12
 		// Actual resource
 		ID3D12Resource* resource = nullptr;
 
+		// Memory backing the resource
+		DX12Allocation allocation = {};
+
 		// Current state of the resource
 		D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
 
+		// Placed render and depth textures start with undefined metadata, the first command buffer that uses them discards them
+		bool needsInit = false;
+
 		// Internal properties
 		uint32_t width = 0;
 		uint32_t height = 0;
@@ -199,6 +306,9 @@ namespace d3d12
 		uint32_t alignment = 0;
 		TextureType type = TextureType::Tex2D;
 		bool isDepth = false;
+
+		// Views created so far
+		std::vector<DX12CachedView> views;
 	};
 
 	struct DX12RenderTexture
@@ -264,6 +374,16 @@ namespace d3d12
 		// Command buffer type
 		D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT;
 
+		// Ring blocks the descriptor tables are sub-allocated from, released once the command buffer has been executed
+		DX12DescriptorChunk csuChunk = {};
+		DX12DescriptorChunk samplerChunk = {};
+		std::vector<uint32_t> csuBlocks;
+		std::vector<uint32_t> samplerBlocks;
+
+		// Scratch memory for the descriptor copies
+		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> copySources;
+		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> copyDestinations;
+
 		// Grab the current command allocator
 		inline ID3D12CommandAllocator* cmdAlloc()
 		{
@@ -290,27 +410,54 @@ namespace d3d12
 
 		// Actual resource
 		SamplerDescriptor resource = {};
+
+		// View in the staging heap, created on first use
+		DX12CachedView view = {};
+	};
+
+	struct DX12StagingHeap
+	{
+		// Type of the descriptors
+		D3D12_DESCRIPTOR_HEAP_TYPE type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+
+		// Non shader visible heaps of DX12_STAGING_PAGE_SIZE descriptors
+		std::vector<ID3D12DescriptorHeap*> pages;
+
+		// Slots that were released and can be reused
+		std::vector<uint32_t> freeSlots;
+
+		// Number of slots handed out so far
+		uint32_t numSlots = 0;
 	};
 
-	struct DX12DescriptorHeap
+	struct DX12Heap
 	{
-		// Actual heap
-		ID3D12DescriptorHeap* descriptorHeap;
-
-		// Type of this heap
-		D3D12_DESCRIPTOR_HEAP_TYPE type;
-
-		// GPU Handles for every resource type
-		D3D12_GPU_DESCRIPTOR_HANDLE srvGPU;
-		D3D12_GPU_DESCRIPTOR_HANDLE uavGPU;
-		D3D12_GPU_DESCRIPTOR_HANDLE cbvGPU;
-		D3D12_GPU_DESCRIPTOR_HANDLE samplerGPU;
-
-		// CPU Handles for every resource type
-		D3D12_CPU_DESCRIPTOR_HANDLE srvCPU;
-		D3D12_CPU_DESCRIPTOR_HANDLE uavCPU;
-		D3D12_CPU_DESCRIPTOR_HANDLE cbvCPU;
-		D3D12_CPU_DESCRIPTOR_HANDLE samplerCPU;
+		// Placed resources memory and the allocator of its ranges
+		ID3D12Heap* heap = nullptr;
+		TLSFAllocator allocator;
+	};
+
+	struct DX12TransientHeap
+	{
+		// Memory shared by the aliased buffers and render textures, they own no range of it
+		DX12GraphicsDevice* deviceI = nullptr;
+		ID3D12Heap* heap = nullptr;
+		uint64_t size = 0;
+	};
+
+	struct DX12HeapPool
+	{
+		// Properties shared by the heaps of the pool
+		D3D12_HEAP_TYPE type = D3D12_HEAP_TYPE_DEFAULT;
+		D3D12_HEAP_FLAGS flags = D3D12_HEAP_FLAG_NONE;
+		uint64_t alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+		// Heaps of the pool, the released ones leave an empty slot so that the allocations keep their index
+		std::vector<DX12Heap*> heaps;
+
+		// Peak of the memory used by the pool's resources
+		uint64_t usedMemory = 0;
+		uint64_t peakMemory = 0;
 	};
 
 	struct DX12RootSignature
@@ -347,6 +494,9 @@ namespace d3d12
 		// Shader code
 		IDxcBlob* shaderBlob = nullptr;
 
+		// Normalized paths of the source file and its includes
+		std::vector<std::string> dependencies;
+
 		// Number of resources
 		uint32_t cbvCount = 0;
 		uint32_t srvCount = 0;
@@ -356,11 +506,13 @@ namespace d3d12
 		// Reflection data
 		std::map<std::string, DX12Binding> bindings;
 
-		// Set of descriptor heaps that can be used for this compute shader
-		uint32_t cmdBatchIndex = 0;
-		uint32_t nextUsableHeap = 0;
-		std::vector<DX12DescriptorHeap> CSUHeaps;
-		std::vector<DX12DescriptorHeap> samplerHeaps;
+		// Hashed binding table searched at bind time, indexes the slots
+		BindingTable bindingTable;
+		std::vector<DX12Binding> bindingSlots;
+
+		// Staged views of the bound resources, laid out like the descriptor tables (SRVs, UAVs then CBVs)
+		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> boundCSU;
+		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> boundSamplers;
 
 		// Command signature for indirect dispatch
 		ID3D12CommandSignature* commandSignature = nullptr;
@@ -391,6 +543,9 @@ namespace d3d12
 		// Fragment code
 		IDxcBlob* fragBlob = nullptr;
 
+		// Normalized paths of the source file and its includes
+		std::vector<std::string> dependencies;
+
 		// Number of resources
 		uint32_t srvCount = 0;
 		uint32_t uavCount = 0;
@@ -400,11 +555,13 @@ namespace d3d12
 		// Reflection data
 		std::map<std::string, DX12Binding> bindings;
 
-		// Set of descriptor heaps that can be used for this compute shader
-		uint32_t cmdBatchIndex = 0;
-		uint32_t nextUsableHeap = 0;
-		std::vector<DX12DescriptorHeap> CSUHeaps;
-		std::vector<DX12DescriptorHeap> samplerHeaps;
+		// Hashed binding table searched at bind time, indexes the slots
+		BindingTable bindingTable;
+		std::vector<DX12Binding> bindingSlots;
+
+		// Staged views of the bound resources, laid out like the descriptor tables (SRVs, UAVs then CBVs)
+		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> boundCSU;
+		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> boundSamplers;
 
 		// Stencil ref
 		uint8_t stencilRef = 0;
@@ -430,6 +587,9 @@ namespace d3d12
 		// Actual resource
 		ID3D12Resource* resource = nullptr;
 
+		// Memory backing the resource
+		DX12Allocation allocation = {};
+
 		// Current state
 		D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
 
@@ -437,6 +597,9 @@ namespace d3d12
 		uint64_t bufferSize = 0;
 		uint32_t elementSize = 0;
 		GraphicsBufferType heapType = GraphicsBufferType::Default;
+
+		// Views created so far
+		std::vector<DX12CachedView> views;
 	};
 
 	struct DX12Query
@@ -28,24 +28,62 @@ namespace d3d12
     D3D12_COMMAND_QUEUE_PRIORITY convert_command_queue_priority(CommandQueuePriority priority);
 
     // Descriptor heaps
-    ID3D12DescriptorHeap* create_descriptor_heap_internal(DX12GraphicsDevice* deviceI, uint32_t numDescriptors, uint32_t opaqueType);
-    DX12DescriptorHeap create_descriptor_heap_suc(DX12GraphicsDevice* deviceI, uint32_t srvCount, uint32_t uavCount, uint32_t cbvCount);
-    DX12DescriptorHeap create_descriptor_heap_sampler(DX12GraphicsDevice* deviceI, uint32_t samplerCount);
-    void destroy_descriptor_heap(DX12DescriptorHeap& descriptorHeap);
+    ID3D12DescriptorHeap* create_descriptor_heap_internal(DX12GraphicsDevice* deviceI, uint32_t numDescriptors, uint32_t opaqueType, bool shaderVisible = true);
+
+    // Staging descriptors, the views of a resource are created once in CPU only heaps
+    DX12StagingHeap* create_staging_heap(D3D12_DESCRIPTOR_HEAP_TYPE type);
+    void destroy_staging_heap(DX12StagingHeap* stagingHeap);
+    D3D12_CPU_DESCRIPTOR_HANDLE allocate_staging_descriptor(DX12GraphicsDevice* deviceI, DX12StagingHeap* stagingHeap, uint32_t& outSlot);
+    void release_staging_descriptor(DX12StagingHeap* stagingHeap, uint32_t slot);
+    const DX12CachedView* find_cached_view(const std::vector<DX12CachedView>& views, DX12ViewType type, uint64_t parameter);
+    void release_cached_views(DX12GraphicsDevice* deviceI, std::vector<DX12CachedView>& views);
+
+    // Descriptor tables, copied from the staging heaps into the shader visible rings of the device
+    void create_descriptor_rings(DX12GraphicsDevice* deviceI);
+    void destroy_descriptor_rings(DX12GraphicsDevice* deviceI);
+    uint32_t register_timeline(DX12GraphicsDevice* deviceI, ID3D12Fence* fence);
+    void unregister_timeline(DX12GraphicsDevice* deviceI, uint32_t timeline);
+    void retire_descriptor_tables(DX12GraphicsDevice* deviceI);
+    void bind_descriptor_tables(DX12CommandBuffer* commandBuffer, const DX12RootSignature* rootSignature, bool compute,
+                                const std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& boundCSU, uint32_t srvCount, uint32_t uavCount, const std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& boundSamplers);
+    void submit_descriptor_tables(DX12CommandBuffer* commandBuffer, uint32_t timeline, uint64_t fenceValue);
+
+    // Placed resources, sub-allocated from the heap pools of the device. Resources bigger than a heap fall back to committed ones.
+    // Placed render and depth targets are not initialized, they need a discard or a clear before anything else touches them.
+    void create_heap_pools(DX12GraphicsDevice* deviceI);
+    void destroy_heap_pools(DX12GraphicsDevice* deviceI);
+    ID3D12Resource* create_placed_resource(DX12GraphicsDevice* deviceI, DX12HeapPoolType poolType, const D3D12_RESOURCE_DESC& resourceDesc, D3D12_RESOURCE_STATES state, const D3D12_CLEAR_VALUE* clearValue, DX12Allocation& outAllocation);
+    void release_placed_resource(DX12GraphicsDevice* deviceI, ID3D12Resource* resource, const DX12Allocation& allocation);
+
+    // Resources placed in a transient heap at the offset of the caller, released through release_placed_resource as well
+    ID3D12Resource* create_aliased_resource(DX12TransientHeap* transientHeap, uint64_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, D3D12_RESOURCE_STATES state, const D3D12_CLEAR_VALUE* clearValue, DX12Allocation& outAllocation);
 
     // Root signature
     DX12RootSignature* create_root_signature(DX12GraphicsDevice* device, uint32_t srvCount, uint32_t uavCount, uint32_t cbvCount, uint32_t samplerCount);
     void destroy_root_signature(DX12RootSignature* rootSignature);
 
-    // Binding
-    void query_bindings(IDxcBlob* blob, uint32_t& cbvCount, uint32_t& srvCount, uint32_t& uavCount, uint32_t& samplerCount, std::map<std::string, DX12Binding>& outBindings);
-    bool request_binding(const std::map<std::string, DX12Binding>& bindings, const char* name, DX12Binding& outBind);
+    // Shader compilation, one set of DXC instances per thread so that shaders can be compiled in parallel
+    struct DX12ShaderCompiler
+    {
+        IDxcLibrary* library = nullptr;
+        IDxcCompiler* compiler = nullptr;
+        IDxcUtils* utils = nullptr;
+        IDxcIncludeHandler* includeHandler = nullptr;
+
+        // Version of the compiler, part of the shader cache key
+        std::string version = "";
+    };
+    DX12ShaderCompiler& thread_shader_compiler();
 
-    // Compute shaders
-    void validate_compute_shader_heap(DX12ComputeShader* computeShader, uint32_t cmdBatchIndex);
+    // Compiles a kernel of a shader file, the DXIL cache is used when enabled. Returns nullptr if the compilation failed.
+    // outDependencies receives the normalized paths of the source file and of everything it includes.
+    IDxcBlob* compile_shader_kernel(const std::string& filename, const std::vector<std::string>& includeDirectories, const std::string& kernelName, const wchar_t* profile,
+                                    const std::vector<LPCWSTR>& arguments, const std::vector<DxcDefine>& defines, std::vector<std::string>& outDependencies);
 
-    // Graphics pipeline
-    void validate_graphics_pipeline_heap(DX12GraphicsPipeline* graphicsPipeline, uint32_t cmdBatchIndex);
+    // Binding
+    void query_bindings(IDxcBlob* blob, uint32_t& cbvCount, uint32_t& srvCount, uint32_t& uavCount, uint32_t& samplerCount, std::map<std::string, DX12Binding>& outBindings);
+    void build_binding_table(const std::map<std::string, DX12Binding>& bindings, BindingTable& outTable, std::vector<DX12Binding>& outSlots);
+    bool request_binding(const BindingTable& bindingTable, const std::vector<DX12Binding>& bindingSlots, BindingID bindingID, DX12Binding& outBind);
 
     // Graphics device
     uint32_t vendor_to_vendor_id(GPUVendor vendor);
@@ -34,8 +34,14 @@ namespace graphics
         bool feature_support(GraphicsDevice device, GPUFeature feature);
         CoopMatTier coop_mat_tier(GraphicsDevice device);
 
+        // Minimal (x) and maximal (y) number of lanes of a wave
+        uint2 wave_lane_count_range(GraphicsDevice device);
+
         // Stable power state
         void set_stable_power_state(GraphicsDevice device, bool state);
+
+        // Memory heaps stats
+        DeviceMemoryStats memory_stats(GraphicsDevice device);
     }
 
     namespace command_queue
@@ -63,6 +69,7 @@ namespace graphics
         // Generic operations
         void reset(CommandBuffer commandBuffer);
         void close(CommandBuffer commandBuffer);
+        CommandBufferType command_buffer_type(CommandBuffer commandBuffer);
 
 #pragma region Render Texture
         void clear_render_texture(CommandBuffer commandBuffer, RenderTexture renderTexture, const float4& color);
@@ -98,22 +105,37 @@ namespace graphics
         void uav_barrier_buffer(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer);
         void uav_barrier_texture(CommandBuffer commandBuffer, Texture texture);
         void uav_barrier_render_texture(CommandBuffer commandBuffer, RenderTexture renderTexture);
+        void uav_barriers(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures);
+#pragma endregion
+
+#pragma region Aliasing barrier
+        // The resources take over the transient heap memory they share with the previous ones, their content is undefined until written
+        void aliasing_barriers(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures);
 #pragma endregion
 
 #pragma region Transitions
         void transition_to_common(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer);
         void transition_to_copy_source(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer);
         void transition_to_present(CommandBuffer commandBuffer, RenderTexture renderTexture);
+        void transition_for_compute_queue(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures, bool unorderedAccess);
 #pragma endregion
 
 #pragma region Compute Shader
-        // Bindings
-        void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, ConstantBuffer constantBuffer);
-        void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, GraphicsBuffer graphicsBuffer);
-        void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Texture texture, uint32_t mipLevel = 0);
-        void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, RenderTexture texture);
-        void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Sampler sampler);
-        void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, TopLevelAS rtas);
+        // Bindings, the identifiers are obtained with binding_id
+        void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, ConstantBuffer constantBuffer);
+        void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, GraphicsBuffer graphicsBuffer);
+        void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, Texture texture, uint32_t mipLevel = 0);
+        void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, RenderTexture texture);
+        void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, Sampler sampler);
+        void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, TopLevelAS rtas);
+
+        // Bindings by name, the hash of a literal folds at compile time
+        inline void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, ConstantBuffer constantBuffer) { set_compute_shader_cbuffer(commandBuffer, computeShader, binding_id(name), constantBuffer); }
+        inline void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, GraphicsBuffer graphicsBuffer) { set_compute_shader_buffer(commandBuffer, computeShader, binding_id(name), graphicsBuffer); }
+        inline void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Texture texture, uint32_t mipLevel = 0) { set_compute_shader_texture(commandBuffer, computeShader, binding_id(name), texture, mipLevel); }
+        inline void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, RenderTexture texture) { set_compute_shader_render_texture(commandBuffer, computeShader, binding_id(name), texture); }
+        inline void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Sampler sampler) { set_compute_shader_sampler(commandBuffer, computeShader, binding_id(name), sampler); }
+        inline void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, TopLevelAS rtas) { set_compute_shader_rtas(commandBuffer, computeShader, binding_id(name), rtas); }
 
         // Dispatch
         void dispatch(CommandBuffer commandBuffer, ComputeShader computeShader, uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ);
@@ -124,13 +146,21 @@ namespace graphics
         // Viewport
         void set_viewport(CommandBuffer commandBuffer, int32_t offsetX, int32_t offsetY, uint32_t width, uint32_t height);
 
-        // Bindings
-        void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, ConstantBuffer constantBuffer);
-        void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset = 0);
-        void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Texture texture);
-        void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, RenderTexture renderTexture);
-        void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Sampler sampler);
-        void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, TopLevelAS rtas);
+        // Bindings, the identifiers are obtained with binding_id
+        void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, ConstantBuffer constantBuffer);
+        void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset = 0);
+        void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Texture texture);
+        void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, RenderTexture renderTexture);
+        void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Sampler sampler);
+        void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, TopLevelAS rtas);
+
+        // Bindings by name, the hash of a literal folds at compile time
+        inline void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, ConstantBuffer constantBuffer) { set_graphics_pipeline_cbuffer(commandBuffer, graphicsPipeline, binding_id(name), constantBuffer); }
+        inline void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset = 0) { set_graphics_pipeline_buffer(commandBuffer, graphicsPipeline, binding_id(name), graphicsBuffer, bufferOffset); }
+        inline void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Texture texture) { set_graphics_pipeline_texture(commandBuffer, graphicsPipeline, binding_id(name), texture); }
+        inline void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, RenderTexture renderTexture) { set_graphics_pipeline_render_texture(commandBuffer, graphicsPipeline, binding_id(name), renderTexture); }
+        inline void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Sampler sampler) { set_graphics_pipeline_sampler(commandBuffer, graphicsPipeline, binding_id(name), sampler); }
+        inline void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, TopLevelAS rtas) { set_graphics_pipeline_rtas(commandBuffer, graphicsPipeline, binding_id(name), rtas); }
 
         // Draw
         void draw_indexed(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, uint32_t numTriangles, uint32_t numInstances, DrawPrimitive primitive = DrawPrimitive::Triangle);
@@ -146,11 +176,17 @@ namespace graphics
 #pragma region Events
         void start_section(CommandBuffer commandBuffer, const std::string& eventName);
         void end_section(CommandBuffer commandBuffer);
+
+        // Listener notified of every section (the name is null for the end of a section), used by the profiler to time them
+        typedef void (*SectionCallback)(void* userData, CommandBuffer commandBuffer, const char* eventName);
+        void set_section_listener(SectionCallback callback, void* userData);
 #pragma endregion
 
 #pragma region Ray Tracing
         void enable_profiling_scope(CommandBuffer commandBuffer, ProfilingScope scope);
         void disable_profiling_scope(CommandBuffer commandBuffer, ProfilingScope scope);
+        void write_timestamp(CommandBuffer commandBuffer, ProfilingScope scope, uint32_t index);
+        void resolve_timestamps(CommandBuffer commandBuffer, ProfilingScope scope, uint32_t first, uint32_t count);
 #pragma endregion
 
 #pragma region Misc
@@ -227,6 +263,17 @@ namespace graphics
         void set_buffer_debug_name(GraphicsBuffer graphicsBuffer, const char* name);
 #pragma endregion
 
+#pragma region Transient Heap
+        // Memory shared by resources whose lifetimes don't overlap, the caller picks their offsets from the footprints.
+        // The aliased resources are destroyed like the other ones, before their heap, and need an aliasing barrier before their first use.
+        TransientHeap create_transient_heap(GraphicsDevice graphicsDevice, uint64_t heapSize);
+        void destroy_transient_heap(TransientHeap transientHeap);
+        void graphics_buffer_footprint(GraphicsDevice graphicsDevice, uint64_t bufferSize, uint64_t& size, uint64_t& alignment);
+        void render_texture_footprint(GraphicsDevice graphicsDevice, const TextureDescriptor& rtDesc, uint64_t& size, uint64_t& alignment);
+        GraphicsBuffer create_aliased_graphics_buffer(TransientHeap transientHeap, uint64_t heapOffset, uint64_t bufferSize, uint32_t elementSize, uint32_t bufferFlags = 0);
+        RenderTexture create_aliased_render_texture(TransientHeap transientHeap, uint64_t heapOffset, const TextureDescriptor& rtDesc);
+#pragma endregion
+
 #pragma region Constant Buffer
         ConstantBuffer create_constant_buffer(GraphicsDevice graphicsDevice, uint32_t elementSize, ConstantBufferType bufferType);
         void destroy_constant_buffer(ConstantBuffer constantBuffer);
@@ -250,6 +297,7 @@ namespace graphics
     {
         ComputeShader create_compute_shader(GraphicsDevice graphicsDevice, const ComputeShaderDescriptor& computeShaderDescriptor, bool experimental = false);
         void destroy_compute_shader(ComputeShader computeShader);
+        const std::vector<std::string>& source_dependencies(ComputeShader computeShader);
     }
 
     namespace graphics_pipeline
@@ -257,13 +305,35 @@ namespace graphics
         GraphicsPipeline create_graphics_pipeline(GraphicsDevice graphicsDevice, const GraphicsPipelineDescriptor& graphicsPipelineDescriptor);
         void destroy_graphics_pipeline(GraphicsPipeline graphicsPipeline);
         void set_stencil_ref(GraphicsPipeline graphicsPipeline, uint8_t stencilRef);
+        const std::vector<std::string>& source_dependencies(GraphicsPipeline graphicsPipeline);
     }
 
     namespace profiling_scope
     {
-        ProfilingScope create_profiling_scope(GraphicsDevice graphicsDevice);
+        ProfilingScope create_profiling_scope(GraphicsDevice graphicsDevice, uint32_t numTimestamps = 2);
         void destroy_profiling_scope(ProfilingScope profilingScope);
         uint64_t get_duration_us(ProfilingScope profilingScope, CommandQueue cmdQ, CommandBufferType type = CommandBufferType::Default);
+
+        // Reads resolved timestamps without waiting, the caller ensures the GPU is done with them
+        void read_timestamps(ProfilingScope profilingScope, uint32_t first, uint32_t count, uint64_t* outTicks);
+        uint64_t timestamp_frequency(CommandQueue cmdQ, CommandBufferType type = CommandBufferType::Default);
+
+        // Timestamp of the queue and time of the CPU steady clock (nanoseconds since its epoch) sampled at the same instant
+        void clock_calibration(CommandQueue cmdQ, CommandBufferType type, uint64_t& outGPUTicks, uint64_t& outCPUTimeNS);
+    }
+
+    namespace fence
+    {
+        // Creation and destruction
+        Fence create_fence(GraphicsDevice graphicsDevice, uint64_t initialValue = 0);
+        void destroy_fence(Fence fence);
+
+        // Value operations sync
+        void set_value(Fence fence, uint64_t value);
+        uint64_t get_value(Fence fence);
+
+        // Blocks the calling thread until the fence reaches value
+        void wait_value(Fence fence, uint64_t value);
     }
 
     namespace imgui
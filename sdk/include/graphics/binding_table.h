@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// SDK includes
+#include "graphics/types.h"
+
+// System includes
+#include <vector>
+
+// Marks the free entries of the table
+#define BINDING_TABLE_EMPTY 0xFFFFFFFF
+
+// Open addressing table from the binding identifiers of a shader to the index of their slot, built once when the shader is created.
+// The identifiers are already hashes, the low bits pick the entry and collisions probe linearly. The table is at most half full.
+class BindingTable
+{
+public:
+	// Builds the table over an array of identifiers, asserts if two of them are equal
+	void build(const BindingID* bindingIDs, uint32_t numBindings);
+
+	// Index of the identifier in the array the table was built from, BINDING_TABLE_EMPTY if the shader doesn't have it
+	uint32_t find(BindingID bindingID) const
+	{
+		uint32_t entryIdx = bindingID & m_Mask;
+		while (true)
+		{
+			const uint32_t slotIdx = m_Slots[entryIdx];
+			if (slotIdx == BINDING_TABLE_EMPTY || m_IDs[entryIdx] == bindingID)
+				return slotIdx;
+			entryIdx = (entryIdx + 1) & m_Mask;
+		}
+	}
+
+	uint32_t size() const { return m_NumBindings; }
+
+private:
+	std::vector<BindingID> m_IDs = std::vector<BindingID>(1, 0);
+	std::vector<uint32_t> m_Slots = std::vector<uint32_t>(1, BINDING_TABLE_EMPTY);
+	uint32_t m_Mask = 0;
+	uint32_t m_NumBindings = 0;
+};
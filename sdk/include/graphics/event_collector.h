@@ -8,7 +8,10 @@
 #pragma once
 
 // System includes
-#include <queue>
+#include <stdint.h>
+
+// Events that can wait for the render loop, the window thread drops the new ones past that
+#define EVENT_QUEUE_CAPACITY 4096
 
 enum class MouseButton
 {
@@ -38,12 +41,24 @@ struct EventData
 	int64_t data2;
 };
 
+// Events of the window, pushed by the thread that pumps its messages and consumed by the render loop.
+// The queue is single producer single consumer and lock free, the draw request is an atomic flag.
 namespace event_collector
 {
-	void push_event(const EventData& event);
-	bool peek_event(EventData& event);
+	// Window thread, returns false if the queue is full and the event was dropped
+	bool push_event(const EventData& event);
 	void request_draw();
-	bool active_draw_request();
-	void draw_done();
+
+	// Render loop
+	bool peek_event(EventData& event);
+	// Returns the pending draw request and clears it, a request made while the frame renders is kept for the next one
+	bool consume_draw_request();
+	// Sleeps until a draw is requested or an event is pushed, returns right away if one of them is pending
+	void wait_for_activity();
+
+	// Events dropped since the last clear
+	uint32_t dropped_events();
+
+	// Only once the window thread is stopped
 	void clear();
 }
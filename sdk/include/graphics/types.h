@@ -12,6 +12,19 @@
 
 #include <iostream>
 
+// Identifier of a shader resource, hash of its name (FNV-1a) that can be evaluated at compile time
+typedef uint32_t BindingID;
+constexpr BindingID binding_id(const char* name)
+{
+	uint32_t hash = 0x811c9dc5u;
+	while (*name != '\0')
+	{
+		hash ^= (uint8_t)*name++;
+		hash *= 0x01000193u;
+	}
+	return hash;
+}
+
 // General graphics objects
 typedef uint64_t GraphicsDevice;
 typedef uint64_t RenderWindow;
@@ -35,6 +48,7 @@ typedef uint64_t ConstantBuffer;
 typedef uint64_t Sampler;
 typedef uint64_t TopLevelAS;
 typedef uint64_t BottomLevelAS;
+typedef uint64_t TransientHeap;
 
 // Profiling
 typedef uint64_t ProfilingScope;
@@ -42,6 +56,7 @@ typedef uint64_t ProfilingScope;
 enum class GraphicsAPI
 {
 	DX12 = 0,
+	Null,
 	Count
 };
 
@@ -360,4 +375,22 @@ struct VertexData
 	float3 tangent;
 	float2 texCoord;
 	uint32_t matID;
+};
+
+// Occupancy of the memory heaps resources are placed in
+struct DeviceMemoryStats
+{
+	// Heaps reserved by the device and the part used by live resources
+	uint64_t heapMemory = 0;
+	uint64_t usedMemory = 0;
+	uint64_t peakMemory = 0;
+	uint64_t largestFreeBlock = 0;
+	uint32_t numHeaps = 0;
+
+	// Resources placed in the heaps and the ones that needed their own allocation
+	uint32_t placedResources = 0;
+	uint32_t committedResources = 0;
+
+	// 0 when the free space of every heap is contiguous, tends to 1 when it's scattered in small blocks
+	float fragmentation = 0.0f;
 };
\ No newline at end of file
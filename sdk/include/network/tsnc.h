@@ -9,6 +9,7 @@
 
 // Project includes
 #include "network/mlp.h"
+#include "tools/shader_utils.h"
 
 // System includes
 #include <string>
@@ -49,7 +50,7 @@ public:
 
 	// Reload resources
 	void reload_network(const std::string& modelDir, uint32_t numSets);
-	void reload_shaders(const std::string& shaderLibrary);
+	void reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch);
 	void upload_network(CommandQueue cmdQ, CommandBuffer cmdB);
 
 	// Network data access
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// SDK includes
+#include "graphics/binding_table.h"
+#include "graphics/descriptors.h"
+
+// System includes
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace null_backend
+{
+	// Ticks per second of the simulated timestamps
+	#define NULL_TIMESTAMP_FREQUENCY 100000000ull
+
+	// Distance between the CPU and GPU clocks, arbitrary so that a reader that doesn't calibrate gets garbage
+	#define NULL_GPU_CLOCK_OFFSET_NS 123456789000ull
+
+	// Placement alignment of the resources in a transient heap, the one of the DX12 default placements
+	#define NULL_PLACEMENT_ALIGNMENT 65536ull
+
+	// The simulated GPU timeline is the steady clock of the CPU, in nanoseconds
+	uint64_t now_ns();
+	void sleep_until_ns(uint64_t timeNs);
+
+	struct NullGraphicsDevice
+	{
+		// Cost of every dispatch, draw or copy recorded
+		uint64_t commandDurationNs = 0;
+
+		// Memory of the live buffers
+		uint64_t usedMemory = 0;
+		uint64_t peakMemory = 0;
+	};
+
+	struct NullCommandQueue
+	{
+		NullGraphicsDevice* device = nullptr;
+
+		// Time at which the work submitted to every sub queue (Default, Compute, Copy) is done
+		uint64_t busyUntil[3] = { 0, 0, 0 };
+	};
+
+	enum class NullCommandType
+	{
+		Work,
+		Timestamp,
+		Resolve
+	};
+
+	struct NullQuery;
+	struct NullCommand
+	{
+		NullCommandType type = NullCommandType::Work;
+		uint64_t durationNs = 0;
+		NullQuery* query = nullptr;
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	struct NullCommandBuffer
+	{
+		NullGraphicsDevice* device = nullptr;
+		CommandBufferType type = CommandBufferType::Default;
+		bool closed = false;
+
+		// Recorded commands, walked when executed
+		std::vector<NullCommand> commands;
+
+		// Open sections, to validate the nesting
+		uint32_t sectionDepth = 0;
+	};
+
+	struct NullFence
+	{
+		std::mutex mutex;
+
+		// Last value reached
+		uint64_t completedValue = 0;
+
+		// Values signaled by the queues and the time at which the simulated GPU reaches them, in submission order
+		std::vector<std::pair<uint64_t, uint64_t>> pendingValues;
+	};
+
+	struct NullQuery
+	{
+		// Timestamps written by the commands and the ones resolved for the CPU
+		std::vector<uint64_t> written;
+		std::vector<uint64_t> resolved;
+	};
+
+	struct NullTransientHeap
+	{
+		NullGraphicsDevice* device = nullptr;
+		uint64_t size = 0;
+
+		// Aliased resources still placed in the heap
+		uint32_t numResources = 0;
+	};
+
+	struct NullBuffer
+	{
+		NullGraphicsDevice* device = nullptr;
+		GraphicsBufferType type = GraphicsBufferType::Default;
+		uint32_t elementSize = 0;
+		std::vector<char> data;
+
+		// Transient heap of the aliased buffers, their memory is the one of the heap
+		NullTransientHeap* heap = nullptr;
+		uint64_t heapOffset = 0;
+	};
+
+	struct NullTexture
+	{
+		TextureDescriptor descriptor;
+
+		// Transient heap of the aliased render textures
+		NullTransientHeap* heap = nullptr;
+		uint64_t heapOffset = 0;
+	};
+
+	struct NullShader
+	{
+		// Normalized paths of the source file and its includes
+		std::vector<std::string> dependencies;
+
+		// Resources declared by the sources, the slots keep the last bound handle
+		BindingTable bindingTable;
+		std::vector<uint64_t> boundResources;
+	};
+
+	struct NullSampler
+	{
+		SamplerDescriptor descriptor;
+	};
+
+	struct NullBLAS
+	{
+		GraphicsBuffer vertexBuffer = 0;
+		GraphicsBuffer indexBuffer = 0;
+		uint32_t numTriangles = 0;
+	};
+
+	struct NullTLAS
+	{
+		std::vector<BottomLevelAS> instances;
+	};
+}
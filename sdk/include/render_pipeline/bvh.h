@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+#include "scene/mesh.h"
+
+// System includes
+#include <vector>
+
+// Children of a node of the traversed tree
+#define BVH_WIDTH 8
+
+// Triangles of a leaf, tested together
+#define BVH_LEAF_SIZE 4
+
+// Bins of the SAH evaluation along every axis
+#define BVH_NUM_BINS 16
+
+// Subtrees above this number of triangles are built in parallel
+#define BVH_PARALLEL_THRESHOLD 4096
+
+// Deepest level of 8 wide nodes the traversal stack supports
+#define BVH_MAX_DEPTH 64
+
+// Encoding of the children of a node
+#define BVH_LEAF_FLAG 0x80000000
+#define BVH_EMPTY_CHILD 0xFFFFFFFF
+
+// Relative cost of a ray/box test against a ray/triangle test in the SAH
+#define BVH_NODE_COST 1.0f
+#define BVH_TRIANGLE_COST 1.0f
+
+// Node with up to 8 children, the bounds are stored per axis for the SIMD tests
+struct BVHNode
+{
+	float minX[BVH_WIDTH], minY[BVH_WIDTH], minZ[BVH_WIDTH];
+	float maxX[BVH_WIDTH], maxY[BVH_WIDTH], maxZ[BVH_WIDTH];
+
+	// Index of a node, BVH_LEAF_FLAG | index of a leaf, or BVH_EMPTY_CHILD
+	uint32_t children[BVH_WIDTH];
+};
+
+// Up to 4 triangles stored per axis, the missing ones are degenerate and never hit
+struct BVHLeaf
+{
+	float v0X[BVH_LEAF_SIZE], v0Y[BVH_LEAF_SIZE], v0Z[BVH_LEAF_SIZE];
+	float e1X[BVH_LEAF_SIZE], e1Y[BVH_LEAF_SIZE], e1Z[BVH_LEAF_SIZE];
+	float e2X[BVH_LEAF_SIZE], e2Y[BVH_LEAF_SIZE], e2Z[BVH_LEAF_SIZE];
+	uint32_t primitiveID[BVH_LEAF_SIZE];
+};
+
+struct BVHHit
+{
+	float t = 0.0f;
+	// Barycentrics of the second and third vertices
+	float u = 0.0f;
+	float v = 0.0f;
+	uint32_t primitiveID = UINT32_MAX;
+};
+
+struct BVHStats
+{
+	uint32_t numTriangles = 0;
+	uint32_t numNodes = 0;
+	uint32_t numLeaves = 0;
+	uint32_t depth = 0;
+	// SAH cost when the tree was built and for the current bounds
+	float buildCost = 0.0f;
+	float cost = 0.0f;
+};
+
+// CPU bounding volume hierarchy over a frame of a mesh animation, the counterpart of the BLAS of SkinnedMeshRenderer.
+// A binary tree is built with a binned SAH and collapsed into 8 wide nodes. Refitting keeps the topology and updates the bounds
+// for another frame, the SAH cost tells when the refitted tree has degraded enough to be rebuilt.
+// The task scheduler has to be initialized.
+class BVH
+{
+public:
+	// Cst & Dst
+	BVH();
+	~BVH();
+
+	// Builds the tree over a frame interpolated like SkinMesh.compute
+	void build(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor);
+	void release();
+
+	// Updates the bounds and the triangles for another frame
+	void refit(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor);
+
+	// Current cost relative to the cost when built
+	float cost_ratio() const { return m_Stats.buildCost > 0.0f ? m_Stats.cost / m_Stats.buildCost : 1.0f; }
+
+	// Ray queries in world space. Like RAY_FLAG_CULL_BACK_FACING_TRIANGLES, the triangles whose vertices appear counter clockwise from the origin are ignored.
+	bool occluded(const float3& origin, const float3& direction, float tMin, float tMax) const;
+	bool intersect(const float3& origin, const float3& direction, float tMin, float tMax, BVHHit& hit) const;
+
+	// Skinned positions of the current frame
+	const std::vector<float3>& positions() const { return m_Positions; }
+	const BVHStats& stats() const { return m_Stats; }
+
+private:
+	void skin(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor);
+	void update_leaves(const MeshAnimation& animation);
+	void update_nodes();
+	float evaluate_cost() const;
+
+private:
+	// Vertices of the current frame
+	std::vector<float3> m_Positions;
+
+	// Tree, the root is the first node
+	std::vector<BVHNode> m_Nodes;
+	std::vector<BVHLeaf> m_Leaves;
+
+	// Triangles of every leaf, BVH_LEAF_SIZE per leaf, UINT32_MAX for the padding
+	std::vector<uint32_t> m_LeafTriangles;
+
+	// Nodes per depth, refitted from the deepest level up
+	std::vector<std::vector<uint32_t>> m_Levels;
+
+	// Stats
+	BVHStats m_Stats;
+};
+
+namespace bvh
+{
+	// 8 wide slab test of BVH::occluded and BVH::intersect in a single pass, built with /arch:AVX2 and only called when cpu_features::avx2() is true
+	uint32_t intersect_children_avx2(const BVHNode& node, const float3& origin, const float3& invDirection, float tMin, float tMax, float* tNear);
+}
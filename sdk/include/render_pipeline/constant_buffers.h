@@ -36,7 +36,9 @@ struct GlobalCB
 
     // Filtering
     float _EnableFiltering;
-    float2 _PaddingGB0;
+    // Normalized LOD from which the uniform tiles are inferred at half and quarter rate
+    float _VRSHalfRateLOD;
+    float _VRSQuarterRateLOD;
     uint32_t _FrameIndex;
 
     // Sun direction
@@ -47,4 +49,23 @@ struct GlobalCB
     uint32_t _ChannelSet;
     float2 _NumTextureLOD;
     float _AnimationTime;
+
+    // Maximal normalized LOD variation within a reduced rate tile
+    float _VRSMaxLODSpread;
+    // Feature cache mode, tiles refreshed every N frames and its frame counter (not reset by the camera)
+    uint32_t _CacheMode;
+    uint32_t _CacheRefreshPeriod;
+    uint32_t _CacheFrameIndex;
+
+    // Camera of the previous frame
+    float3 _PrevCameraPosition;
+    // Maximal UV distance (in pixel footprints) between a pixel and the history it reuses
+    float _CacheMaxUVDelta;
+
+    // Maximal normalized LOD distance between a pixel and the history it reuses
+    float _CacheMaxLODDelta;
+    float3 _PaddingGB1;
+
+    // View projection matrix of the previous frame
+    float4x4 _PrevViewProjectionMatrix;
 };
\ No newline at end of file
@@ -10,21 +10,35 @@
 // Project includes
 #include <render_pipeline/types.h>
 
+#include <render_pipeline/feature_cache.h>
 #include <render_pipeline/gbuffer_renderer.h>
 #include <render_pipeline/material_renderer.h>
 #include <render_pipeline/skinned_mesh_renderer.h>
 #include <render_pipeline/ibl.h>
 #include <render_pipeline/texture_manager.h>
 #include <render_pipeline/tile_classifier.h>
+#include <render_pipeline/tile_shape.h>
+#include <render_pipeline/variable_rate.h>
 
 #include <tools/profiling_helper.h>
+#include <tools/benchmark_runner.h>
 #include <tools/camera_controller.h>
 #include <tools/command_line.h>
+#include <tools/file_watcher.h>
+#include <tools/frame_pacer.h>
+#include <tools/render_graph.h>
 
 // System includes
 #include <string>
 #include <memory>
 
+// Resources owned by a frame in flight
+struct FrameContext
+{
+	RGCommandBuffers cmdBuffers = RGCommandBuffers();
+	ConstantBuffer globalCB = 0;
+};
+
 class DinoRenderer
 {
 public:
@@ -40,26 +54,41 @@ public:
 	void render_loop();
 
 private:
-	// Shaders
-	void reload_shaders();
+	// Shaders, an incremental reload only recompiles the shaders affected by the modified files
+	void reload_shaders(bool incremental);
 
 	// Rendering
 	void update_constant_buffers(CommandBuffer cmdB);
 	void render_ui(CommandBuffer cmdB, RenderTexture rt);
+	void build_render_graph(RenderTexture backBuffer);
 	void render_frame();
+	void wait_for_frames();
 
 	// Updata
 	void update(double deltaTime);
 
+	// Benchmark, applies the configuration of the current step and records the timings of the measured frames
+	bool begin_benchmark_frame();
+	void record_benchmark_frame();
+
+	// Writes the material IDs of the visibility buffer read back at the end of the frame, input of the tile_shape_autotune tool
+	void write_visibility_capture(GraphicsBuffer readbackBuffer);
+
 	// Inputs
 	void process_key_event(uint32_t keyCode, bool state);
 
 private:
 	// Graphics Backend
+	GraphicsAPI m_GraphicsAPI = GraphicsAPI::DX12;
 	GraphicsDevice m_Device = 0;
 	RenderWindow m_Window = 0;
 	CommandQueue m_CmdQueue = 0;
 	SwapChain m_SwapChain = 0;
+
+	// Frames in flight, m_CmdBuffer and m_GlobalCB point to the resources of the frame being recorded
+	std::vector<FrameContext> m_Frames;
+	FramePacer m_FramePacer = FramePacer();
+	Fence m_FrameFence = 0;
 	CommandBuffer m_CmdBuffer = 0;
 
 	// Project directory
@@ -69,12 +98,16 @@ private:
 	// Global rendering properties
 	uint2 m_ScreenSizeI = { 0, 0 };
 	uint2 m_TileSizeI = { 0, 0 };
+	TileShape m_TileShape = TileShape::Count;
+	uint2 m_WaveLaneRange = { 0, 0 };
 	float4 m_ScreenSize = { 0.0, 0.0, 0.0, 0.0 };
 	uint32_t m_FrameIndex = 0;
 	double m_Time = 0.0;
 	std::vector<float> m_DurationArray;
 	std::vector<float> m_DrawArray;
 	uint32_t m_CurrentDuration = UINT32_MAX;
+	float m_DirectDurationMS = 0.0f;
+	float m_ShadowDurationMS = 0.0f;
 
 	// UI parameters
 	RenderingMode m_RenderingMode = RenderingMode::Count;
@@ -85,20 +118,28 @@ private:
 	bool m_UseCooperativeVectors = false;
 	bool m_EnableCounters = false;
 	bool m_EnableFiltering = true;
+	bool m_EnableAsyncCompute = true;
+	bool m_EnableVariableRate = false;
+	VariableRateSettings m_VariableRateSettings = VariableRateSettings();
+	bool m_EnableFeatureCache = false;
+	FeatureCacheSettings m_FeatureCacheSettings = FeatureCacheSettings();
 
 	// Rendering resources
 	ConstantBuffer m_GlobalCB = 0;
 	RenderTexture m_VisibilityBuffer = 0;
 	RenderTexture m_DepthTexture = 0;
 	RenderTexture m_ColorTexture = 0;
-	RenderTexture m_ShadowTexture = 0;
-	GraphicsBuffer m_GBuffer = 0;
+	RenderGraph m_RenderGraph = RenderGraph();
+
+	// The shadows and the classification lists are transients of the render graph
+	TextureDescriptor m_ShadowDescriptor = TextureDescriptor();
 
 	// Rendering components
 	SkinnedMeshRenderer m_MeshRenderer = SkinnedMeshRenderer();
 	IBL m_IBL = IBL();
 	TextureManager m_TexManager = TextureManager();
 	TileClassifier m_Classifier = TileClassifier();
+	FeatureCache m_FeatureCache = FeatureCache();
 
 	// Networks
 	TSNC m_TSNC = TSNC();
@@ -115,4 +156,11 @@ private:
 	// Components
 	CameraController m_CameraController = CameraController();
 	ProfilingHelper m_ProfilingHelper = ProfilingHelper();
+	BenchmarkRunner m_Benchmark = BenchmarkRunner();
+	std::string m_BenchmarkOutput = "";
+	FileWatcher m_ShaderWatcher = FileWatcher();
+	std::vector<std::string> m_PendingShaderChanges;
+	bool m_ShaderChangesLost = false;
+	bool m_VisibilityCaptureRequested = false;
+	uint32_t m_NumVisibilityCaptures = 0;
 };
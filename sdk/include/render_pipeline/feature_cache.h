@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "graphics/types.h"
+#include "render_pipeline/types.h"
+#include "tools/shader_utils.h"
+
+// System includes
+#include <string>
+
+// Pixels that need to be inferred, matches FEATURE_CACHE_NO_REUSE in feature_cache.hlsl
+#define FEATURE_CACHE_NO_REUSE UINT32_MAX
+
+// Matches FEATURE_CACHE_* in feature_cache.hlsl
+enum class FeatureCacheMode
+{
+	// The features of every pixel are inferred
+	Disabled = 0,
+	// The keys are recorded but nothing is reused (first frame, invalidated history)
+	Record,
+	// The pixels that match the history of the previous frame copy its features
+	Reuse,
+	Count
+};
+
+// Reuse heuristics
+struct FeatureCacheSettings
+{
+	// Every tile is inferred at least once every refreshPeriod frames
+	uint32_t refreshPeriod = 8;
+	// Maximal UV distance between a pixel and the history it reuses, in pixel footprints
+	float maxUVDelta = 0.5f;
+	// Maximal LOD distance between a pixel and the history it reuses, in mips of the latent space
+	float maxMipDelta = 0.25f;
+};
+
+// Surface the features of a pixel were inferred for
+struct FeatureCacheKey
+{
+	bool valid = false;
+	uint32_t material = 0;
+	float2 uv = { 0.0f, 0.0f };
+	// Normalized LOD (compute_lod)
+	float lod = 0.0f;
+};
+
+// CPU reference of the reuse heuristics (FirstPass.compute)
+namespace feature_cache
+{
+	// Rotating subset of tiles that is inferred every frame
+	bool is_refresh_tile(uint32_t tileIdx, uint32_t frameIndex, uint32_t refreshPeriod);
+
+	// Can the features of the previous key be used for the current one
+	bool validate_reuse(const FeatureCacheKey& key, const float2& uvDX, const float2& uvDY, const FeatureCacheKey& prevKey, const FeatureCacheSettings& settings, float numMips);
+}
+
+class FeatureCache
+{
+public:
+	// Cst & Dst
+	FeatureCache();
+	~FeatureCache();
+
+	// Init & release
+	void initialize(GraphicsDevice device, const uint2& screenSize, const uint2& tileSize, TileShape tileShape);
+	void release();
+
+	// Resource loading
+	void reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch);
+
+	// Swaps the history, it's only reused if the previous frame recorded it with the same configuration
+	FeatureCacheMode begin_frame(bool enabled, uint32_t configuration, const float4x4& viewProjection, const float3& cameraPosition);
+	void invalidate() { m_HistoryRecorded = false; }
+
+	// Copies the reused features from the history
+	void resolve(CommandBuffer cmdB, ConstantBuffer globalCB, GraphicsBuffer tileBuffer, GraphicsBuffer indirectBuffer);
+
+	// Frame data
+	FeatureCacheMode mode() const { return m_Mode; }
+	uint32_t frame_index() const { return m_FrameIndex; }
+	const float4x4& prev_view_projection() const { return m_PrevViewProjection; }
+	const float3& prev_camera_position() const { return m_PrevCameraPosition; }
+
+	// Resource access
+	GraphicsBuffer features_buffer() const { return m_FeatureBuffers[m_CurrentIdx]; }
+	GraphicsBuffer history_features_buffer() const { return m_FeatureBuffers[1 - m_CurrentIdx]; }
+	GraphicsBuffer keys_buffer() const { return m_KeyBuffers[m_CurrentIdx]; }
+	GraphicsBuffer history_keys_buffer() const { return m_KeyBuffers[1 - m_CurrentIdx]; }
+	GraphicsBuffer reuse_buffer() const { return m_ReuseBuffer; }
+
+private:
+	// Device
+	GraphicsDevice m_Device = 0;
+
+	// Shaders
+	ComputeShader m_ReuseCS = 0;
+
+	// Current and previous frame
+	GraphicsBuffer m_FeatureBuffers[2] = { 0, 0 };
+	GraphicsBuffer m_KeyBuffers[2] = { 0, 0 };
+	GraphicsBuffer m_ReuseBuffer = 0;
+	uint32_t m_CurrentIdx = 0;
+
+	// History state
+	FeatureCacheMode m_Mode = FeatureCacheMode::Disabled;
+	bool m_HistoryRecorded = false;
+	uint32_t m_Configuration = 0;
+	uint32_t m_FrameIndex = 0;
+	float4x4 m_ViewProjection = float4x4();
+	float4x4 m_PrevViewProjection = float4x4();
+	float3 m_CameraPosition = { 0.0f, 0.0f, 0.0f };
+	float3 m_PrevCameraPosition = { 0.0f, 0.0f, 0.0f };
+};
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+
+// Material channels produced by the inference, matches the *_OFFSET defines of common.hlsl
+#define GBUFFER_NUM_CHANNELS 16
+#define GBUFFER_AO_OFFSET 0
+#define GBUFFER_DIFFUSE_OFFSET 1
+#define GBUFFER_DISPLACEMENT_OFFSET 4
+#define GBUFFER_MASK_OFFSET 5
+#define GBUFFER_METALNESS_OFFSET 7
+#define GBUFFER_NORMAL_OFFSET 8
+#define GBUFFER_ROUGHNESS_OFFSET 11
+#define GBUFFER_THICKNESS_OFFSET 12
+
+// Size of a pixel of the GBuffer, the channels are packed in a uint4 (gbuffer_codec.hlsl)
+#define GBUFFER_PIXEL_SIZE (4 * sizeof(uint32_t))
+
+// CPU reference of the GBuffer encoding (gbuffer_codec.hlsl)
+namespace gbuffer_codec
+{
+	// Shared exponent color, matches DXGI_FORMAT_R9G9B9E5_SHAREDEXP
+	uint32_t pack_rgb9e5(const float3& color);
+	float3 unpack_rgb9e5(uint32_t value);
+
+	// Octahedral mapping of a unit vector to [0, 1]^2
+	float2 octahedral_encode(const float3& normal);
+	float3 octahedral_decode(const float2& encoded);
+
+	// Packs GBUFFER_NUM_CHANNELS values, the padding channels are dropped and decode to zero
+	uint4 encode(const float* channels);
+	void decode(const uint4& data, float* channels);
+}
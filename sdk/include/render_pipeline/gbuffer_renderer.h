@@ -32,13 +32,13 @@ public:
 	void release();
 
 	// Reload network
-	void reload_shaders(const std::string& shaderLibrary, const std::vector<std::string>& shaderDefines);
+	void reload_shaders(const std::string& shaderLibrary, const std::vector<std::string>& shaderDefines, ShaderCompileBatch& batch);
 
 	// Evaluate the network
 	void evaluate_indirect(CommandBuffer cmdB, ConstantBuffer globalCB, GraphicsBuffer visibilityBuffer, GraphicsBuffer indexationBuffer, GraphicsBuffer indirectBuffer, GraphicsBuffer outputBuffer,
 		const TextureSet& texSet, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, FilteringMode filteringMode);
 
-	// Evaluate the network
+	// Evaluate the network, the low detail tiles are inferred at a reduced rate and upsampled
 	void evaluate_neural_cmp_indirect(CommandBuffer cmdB, ConstantBuffer globalCB, GraphicsBuffer visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, GraphicsBuffer outputBuffer,
 		const TileClassifier& classifier, bool useCoopVectors, const TSNC& network, FilteringMode filteringMode);
 
@@ -50,6 +50,8 @@ public:
 private:
 	void partial_inference(CommandBuffer cmdB, ComputeShader repackedCS, uint32_t indirectOffset, GraphicsBuffer tileBuffer, ConstantBuffer globalCB, GraphicsBuffer visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, GraphicsBuffer outputBuffer,
 		const TileClassifier& classifier, bool useCoopVectors, const TSNC& network, FilteringMode filteringMode);
+	void upsample_indirect(CommandBuffer cmdB, ComputeShader targetCS, uint32_t indirectOffset, GraphicsBuffer tileBuffer, ConstantBuffer globalCB, GraphicsBuffer visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, GraphicsBuffer outputBuffer,
+		const TileClassifier& classifier);
 
 private:
 	// Graphics device
@@ -73,6 +75,14 @@ private:
 	ComputeShader m_FMABC1_Repacked_CS = 0;
 	ComputeShader m_CVBC1_Repacked_CS = 0;
 
+	// Reduced rate BC1 inference and reconstruction
+	ComputeShader m_FMABC1_Half_CS = 0;
+	ComputeShader m_FMABC1_Quarter_CS = 0;
+	ComputeShader m_CVBC1_Half_CS = 0;
+	ComputeShader m_CVBC1_Quarter_CS = 0;
+	ComputeShader m_UpsampleHalfCS = 0;
+	ComputeShader m_UpsampleQuarterCS = 0;
+
 	// Lighting shader
 	ComputeShader m_DeferredLightingCS = 0;
 };
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 // Includes
 #include "graphics/descriptors.h"
+#include "tools/shader_utils.h"
 #include "tools/texture_utils.h"
 
 class IBL
@@ -22,7 +23,7 @@ public:
     void release();
 
     // Reload the shaders
-    void reload_shaders(const std::string& shaderLibrary);
+    void reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch);
 
     // Upload the texture
     void upload_textures(CommandQueue cmdQ, CommandBuffer cmdB);
@@ -32,7 +32,7 @@ public:
 	void release();
 
 	// Reload shaders
-	void reload_shaders(const std::string& shaderLibrary, const TSNC& network);
+	void reload_shaders(const std::string& shaderLibrary, const TSNC& network, ShaderCompileBatch& batch);
 
 	// Evaluate the material
 	void evaluate_indirect(CommandBuffer cmdB, ConstantBuffer globalCB, 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// SDK includes
+#include "graphics/types.h"
+
+// Identifiers of the resources the renderers bind, hashed when compiling so that a bind call only does the table lookup of the shader.
+// The names are the ones declared in the shaders.
+namespace shader_binding
+{
+	constexpr BindingID ActiveTileBuffer = binding_id("_ActiveTileBuffer");
+	constexpr BindingID ActiveTileBufferRW = binding_id("_ActiveTileBufferRW");
+	constexpr BindingID BC1LinearClampSampler = binding_id("bc1_linear_clamp_sampler");
+	constexpr BindingID BackgroundTexture = binding_id("_BackgroundTexture");
+	constexpr BindingID ColorTextureIn = binding_id("_ColorTextureIn");
+	constexpr BindingID ColorTextureRW = binding_id("_ColorTextureRW");
+	constexpr BindingID ComplexTileBuffer = binding_id("_ComplexTileBuffer");
+	constexpr BindingID ComplexTileBufferRW = binding_id("_ComplexTileBufferRW");
+	constexpr BindingID ConvolvedIBLTexture = binding_id("_ConvolvedIBLTexture");
+	constexpr BindingID DisplacementBuffer = binding_id("_DisplacementBuffer");
+	constexpr BindingID FGDSampler = binding_id("s_fgd_sampler");
+	constexpr BindingID FeatureCacheHistory = binding_id("_FeatureCacheHistory");
+	constexpr BindingID FeatureCacheKeysRW = binding_id("_FeatureCacheKeysRW");
+	constexpr BindingID GGXSampler = binding_id("s_ggx_sampler");
+	constexpr BindingID GlobalCB = binding_id("_GlobalCB");
+	constexpr BindingID HalfRateTileBuffer = binding_id("_HalfRateTileBuffer");
+	constexpr BindingID HalfRateTileBufferRW = binding_id("_HalfRateTileBufferRW");
+	constexpr BindingID HistoryBuffer = binding_id("_HistoryBuffer");
+	constexpr BindingID IndexBuffer = binding_id("_IndexBuffer");
+	constexpr BindingID IndexationBuffer = binding_id("_IndexationBuffer");
+	constexpr BindingID IndexedTilesBufferRW = binding_id("_IndexedTilesBufferRW");
+	constexpr BindingID IndirectDiffuseTexture = binding_id("_IndirectDiffuseTexture");
+	constexpr BindingID IndirectDispatchBufferRW = binding_id("_IndirectDispatchBufferRW");
+	constexpr BindingID IndirectDrawBufferRW = binding_id("_IndirectDrawBufferRW");
+	constexpr BindingID InferenceBuffer = binding_id("_InferenceBuffer");
+	constexpr BindingID InferenceBufferRW = binding_id("_InferenceBufferRW");
+	constexpr BindingID InputBuffer = binding_id("_InputBuffer");
+	constexpr BindingID LS0Texture = binding_id("_LS0Texture");
+	constexpr BindingID LS1Texture = binding_id("_LS1Texture");
+	constexpr BindingID LS2Texture = binding_id("_LS2Texture");
+	constexpr BindingID LS3Texture = binding_id("_LS3Texture");
+	constexpr BindingID LambertSampler = binding_id("s_lambert_sampler");
+	constexpr BindingID LinearClampSampler = binding_id("sampler_linear_clamp");
+	constexpr BindingID MLPBias0Buffer = binding_id("_MLPBias0Buffer");
+	constexpr BindingID MLPBias1Buffer = binding_id("_MLPBias1Buffer");
+	constexpr BindingID MLPBias2Buffer = binding_id("_MLPBias2Buffer");
+	constexpr BindingID MLPUsageBufferRW = binding_id("_MLPUsageBufferRW");
+	constexpr BindingID MLPWeight0Buffer = binding_id("_MLPWeight0Buffer");
+	constexpr BindingID MLPWeight1Buffer = binding_id("_MLPWeight1Buffer");
+	constexpr BindingID MLPWeight2Buffer = binding_id("_MLPWeight2Buffer");
+	constexpr BindingID MeshletBoundsBuffer = binding_id("_MeshletBoundsBuffer");
+	constexpr BindingID MeshletBoundsBufferRW = binding_id("_MeshletBoundsBufferRW");
+	constexpr BindingID MeshletBuffer = binding_id("_MeshletBuffer");
+	constexpr BindingID MeshletTriangleBuffer = binding_id("_MeshletTriangleBuffer");
+	constexpr BindingID MeshletVertexBuffer = binding_id("_MeshletVertexBuffer");
+	constexpr BindingID OutputBufferRW = binding_id("_OutputBufferRW");
+	constexpr BindingID PreIntegratedFGDTexture = binding_id("_PreIntegratedFGDTexture");
+	constexpr BindingID QuantizationCB = binding_id("_QuantizationCB");
+	constexpr BindingID QuarterRateTileBuffer = binding_id("_QuarterRateTileBuffer");
+	constexpr BindingID QuarterRateTileBufferRW = binding_id("_QuarterRateTileBufferRW");
+	constexpr BindingID ReuseBuffer = binding_id("_ReuseBuffer");
+	constexpr BindingID ReuseBufferRW = binding_id("_ReuseBufferRW");
+	constexpr BindingID SceneRTAS = binding_id("_SceneRTAS");
+	constexpr BindingID ShadowTexture = binding_id("_ShadowTexture");
+	constexpr BindingID ShadowTextureRW = binding_id("_ShadowTextureRW");
+	constexpr BindingID SharedVertexBuffer = binding_id("_SharedVertexBuffer");
+	constexpr BindingID SkinnedVertexBuffer = binding_id("_SkinnedVertexBuffer");
+	constexpr BindingID Texture0 = binding_id("_Texture0");
+	constexpr BindingID Texture1 = binding_id("_Texture1");
+	constexpr BindingID Texture2 = binding_id("_Texture2");
+	constexpr BindingID Texture3 = binding_id("_Texture3");
+	constexpr BindingID Texture4 = binding_id("_Texture4");
+	constexpr BindingID TextureSampler = binding_id("s_texture_sampler");
+	constexpr BindingID TileBuffer = binding_id("_TileBuffer");
+	constexpr BindingID UVOffsetBuffer = binding_id("_UVOffsetBuffer");
+	constexpr BindingID UniformTileBuffer = binding_id("_UniformTileBuffer");
+	constexpr BindingID UniformTileBufferRW = binding_id("_UniformTileBufferRW");
+	constexpr BindingID VertexBuffer = binding_id("_VertexBuffer");
+	constexpr BindingID VertexBufferA = binding_id("_VertexBufferA");
+	constexpr BindingID VertexBufferB = binding_id("_VertexBufferB");
+	constexpr BindingID VertexBufferRW = binding_id("_VertexBufferRW");
+	constexpr BindingID VisibilityBuffer = binding_id("_VisibilityBuffer");
+	constexpr BindingID VisibleTriangleBuffer = binding_id("_VisibleTriangleBuffer");
+	constexpr BindingID VisibleTriangleBufferRW = binding_id("_VisibleTriangleBufferRW");
+}
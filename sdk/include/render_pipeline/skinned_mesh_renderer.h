@@ -9,7 +9,9 @@
 
 // Includes
 #include "graphics/types.h"
-#include "scene/mesh.h"
+#include "scene/animation_stream.h"
+#include "scene/meshlet.h"
+#include "tools/shader_utils.h"
 
 // System includes
 #include <string>
@@ -27,7 +29,7 @@ public:
 	void release();
 
 	// Resource loading
-	void reload_shaders(const std::string& shaderLibrary);
+	void reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch);
 	void upload_geometry(CommandQueue cmdQ, CommandBuffer cmdB);
 
 	// Rendering
@@ -50,26 +52,50 @@ public:
 	float animation_time() const;
 	uint32_t num_vertices() const { return m_NumVertices; }
 
+	// Material of a primitive of the visibility buffer
+	uint32_t material_id(uint32_t primitiveID) const;
+
 private:
 	uint32_t current_animation_frame() const;
 	uint32_t next_animation_frame() const;
+	uint32_t make_resident(CommandBuffer cmdB, uint32_t frameIdx, bool wait, uint32_t& numUploads);
+	void build_meshlets();
 
 private:
 	// Graphics Device
 	GraphicsDevice m_Device = 0;
 
-	// Animation mesh
+	// Animation mesh, the frames are streamed from the file. Version 2 files stay quantized and are decoded by the skinning
 	uint32_t m_NumFrames = 0;
-	MeshAnimation m_AnimMesh = MeshAnimation();
+	AnimationStream m_AnimStream;
+	bool m_Quantized = false;
 	uint32_t m_NumTriangles = 0;
 	uint32_t m_NumVertices = 0;
 
 	// Runtime buffers
 	GraphicsBuffer m_AnimIndexBuffer = 0;
+	// Ring of resident frames (current, next, prefetched) and the animation frame each of them holds
 	std::vector<GraphicsBuffer> m_AnimVertexBuffer;
+	std::vector<uint32_t> m_ResidentFrames;
+	// Staging of the uploads, one buffer per update in flight
+	std::vector<GraphicsBuffer> m_UploadBuffers;
+	uint32_t m_UpdateIndex = 0;
 	GraphicsBuffer m_SkinnedVertexBuffer = 0;
+	GraphicsBuffer m_SharedVertexBuffer = 0;
+	ConstantBuffer m_QuantizationCB = 0;
 	GraphicsBuffer m_DisplacementBuffer = 0;
 
+	// Meshlets built on the first frame, their bounds are refitted after the skinning and culled before the visibility pass
+	MeshletMesh m_Meshlets;
+	uint32_t m_NumMeshlets = 0;
+	bool m_MeshletCulling = true;
+	GraphicsBuffer m_MeshletBuffer = 0;
+	GraphicsBuffer m_MeshletVertexBuffer = 0;
+	GraphicsBuffer m_MeshletTriangleBuffer = 0;
+	GraphicsBuffer m_MeshletBoundsBuffer = 0;
+	GraphicsBuffer m_VisibleTriangleBuffer = 0;
+	GraphicsBuffer m_IndirectDrawBuffer = 0;
+
 	// Other data
 	float m_Duration = 1.9f;
 	float m_AnimationSpeed = 1.0f;
@@ -79,8 +105,12 @@ private:
 
 	// Shaders
 	GraphicsPipeline m_VisibilityPassGP = 0;
+	GraphicsPipeline m_VisibilityPassCulledGP = 0;
 	ComputeShader m_SkinCS = 0;
 	ComputeShader m_DisplEvalCS = 0;
+	ComputeShader m_MeshletBoundsCS = 0;
+	ComputeShader m_MeshletResetCS = 0;
+	ComputeShader m_MeshletCullingCS = 0;
 
 	// Ray Tracing data
 	TopLevelAS m_TLAS = 0;
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+#include "scene/mesh.h"
+
+// System includes
+#include <vector>
+
+// Screen tiles the triangles are binned into, each of them is rasterized by a single thread
+#define SOFTWARE_RASTER_BIN_SIZE 64
+
+// Blocks of pixels that are trivially accepted or rejected against the edges of a triangle
+#define SOFTWARE_RASTER_BLOCK_SIZE 8
+
+// Sub pixel precision of the snapped vertices (in bits)
+#define SOFTWARE_RASTER_SUBPIXEL_BITS 4
+
+// Number of consecutive triangles set up by a task, the bins keep the submission order of the chunks
+#define SOFTWARE_RASTER_CHUNK_SIZE 2048
+
+// Value of the pixels that nothing covers, same as the clear of the visibility buffer
+#define SOFTWARE_RASTER_EMPTY_PIXEL 0
+
+// Work done for a frame
+struct SoftwareRasterizerStats
+{
+	uint32_t numTriangles = 0;
+	// Triangles that survived the culling and the clipping, a clipped triangle may produce several
+	uint32_t rasterizedTriangles = 0;
+	// Bins overlapped by the rasterized triangles, summed
+	uint32_t binnedTriangles = 0;
+};
+
+// Triangle after setup, the edge functions are evaluated at the pixel centers in sub pixel units
+struct RasterTriangle
+{
+	// Edge functions: value at the pixel (0, 0) and steps for one pixel in x and y
+	int64_t edgeOrigin[3];
+	int32_t edgeStepX[3];
+	int32_t edgeStepY[3];
+
+	// Depth plane (z / w), same origin and steps
+	double depthOrigin;
+	double depthStepX;
+	double depthStepY;
+
+	// Bounding box in pixels, inclusive and clamped to the screen
+	uint32_t minX, minY, maxX, maxY;
+
+	// Packed visibility value
+	uint32_t visibility;
+};
+
+// CPU counterpart of VisibilityPass.graphics, writes the same packed primitive IDs and depth.
+// The vertices are skinned like SkinMesh.compute, the triangles are clipped against the near plane,
+// the back faces are culled and the visible triangles are binned in screen tiles that are rasterized in parallel.
+// The task scheduler has to be initialized.
+class SoftwareRasterizer
+{
+public:
+	// Cst & Dst
+	SoftwareRasterizer();
+	~SoftwareRasterizer();
+
+	// Init & Release
+	void initialize(uint32_t width, uint32_t height);
+	void release();
+
+	// Renders a frame of the animation interpolated between frameA and frameB, with the camera relative transform of the GPU
+	void render(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor, const float4x4& viewProjection, const float3& cameraPosition);
+
+	// Results of the last frame, row major
+	void read_visibility_buffer(std::vector<uint32_t>& visibility) const;
+	void read_depth_buffer(std::vector<float>& depth) const;
+	const SoftwareRasterizerStats& stats() const { return m_Stats; }
+
+	// Dimensions
+	uint32_t width() const { return m_Width; }
+	uint32_t height() const { return m_Height; }
+
+private:
+	void transform_vertices(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor, const float4x4& viewProjection, const float3& cameraPosition);
+	void setup_chunk(const MeshAnimation& animation, uint32_t chunkIdx);
+	void rasterize_bin(uint32_t binIdx);
+
+private:
+	// Screen
+	uint32_t m_Width = 0;
+	uint32_t m_Height = 0;
+
+	// Bin grid, the targets are padded to a whole number of bins
+	uint32_t m_BinCountX = 0;
+	uint32_t m_BinCountY = 0;
+	uint32_t m_Pitch = 0;
+
+	// Targets
+	std::vector<uint32_t> m_Visibility;
+	std::vector<float> m_Depth;
+
+	// Clip space positions of the skinned vertices
+	std::vector<float4> m_ClipPositions;
+
+	// Per chunk: the triangles it set up, and the indices of these triangles per bin
+	std::vector<std::vector<RasterTriangle>> m_ChunkTriangles;
+	std::vector<std::vector<std::vector<uint32_t>>> m_ChunkBins;
+
+	// Stats
+	SoftwareRasterizerStats m_Stats;
+};
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+#include "render_pipeline/bvh.h"
+#include "scene/mesh.h"
+
+// System includes
+#include <vector>
+
+// Ray interval of ShadowRT.compute
+#define SOFTWARE_SHADOW_TMIN 0.01f
+#define SOFTWARE_SHADOW_TMAX 100.0f
+
+// Offset of the ray origins along the normal, scaled by a random number per pixel
+#define SOFTWARE_SHADOW_NORMAL_OFFSET 0.02f
+
+// Radius of the ground disk that receives the shadows where nothing is rasterized
+#define SOFTWARE_SHADOW_GROUND_RADIUS 4.0f
+
+// Camera of the frame, the view projection is camera relative like on the GPU
+struct SoftwareShadowView
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	float4x4 viewProjection;
+	float4x4 invViewProjection;
+	float3 cameraPosition;
+	float3 sunDirection;
+};
+
+// CPU counterpart of ShadowRT.compute, used for reference masks and as a fallback for headless captures
+namespace software_shadow
+{
+	// Traces a sun ray per pixel against a BVH of the same frame, the mask is row major with 0 for the shadowed pixels and 1 otherwise.
+	// Returns the number of rays traced.
+	uint32_t evaluate(const BVH& bvh, const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor,
+		const std::vector<uint32_t>& visibility, const SoftwareShadowView& view, std::vector<float>& shadow);
+
+	// Number of pixels that differ between two masks
+	uint32_t count_differences(const std::vector<float>& shadowA, const std::vector<float>& shadowB);
+}
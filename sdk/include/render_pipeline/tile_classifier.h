@@ -9,10 +9,25 @@
 
 // Includes
 #include "graphics/types.h"
+#include "render_pipeline/feature_cache.h"
+#include "render_pipeline/types.h"
+#include "tools/shader_utils.h"
 
 // System includes
 #include <string>
 
+// Lists written by the classification, provided every frame by the caller (transients of the render graph)
+struct TileClassifierBuffers
+{
+	GraphicsBuffer activeTiles = 0;
+	GraphicsBuffer uniformTiles = 0;
+	GraphicsBuffer complexTiles = 0;
+	GraphicsBuffer repackedTiles = 0;
+	GraphicsBuffer halfRateTiles = 0;
+	GraphicsBuffer quarterRateTiles = 0;
+	GraphicsBuffer indirect = 0;
+};
+
 class TileClassifier
 {
 public:
@@ -21,21 +36,32 @@ public:
 	~TileClassifier();
 
 	// Init & release
-	void initialize(GraphicsDevice device, const uint2& tileSize, uint32_t numMLPS);
+	void initialize(GraphicsDevice device, const uint2& tileSize, TileShape tileShape, uint32_t numMLPS);
 	void release();
 
 	// Resource loading
-	void reload_shaders(const std::string& shaderLibrary);
+	void reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch);
 
 	// Runtime
-	void classify(CommandBuffer cmdB, ConstantBuffer globalCB, RenderTexture visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer);
+	// The pixels that can reuse the features of the previous frame are left out of the inference lists
+	void classify(CommandBuffer cmdB, ConstantBuffer globalCB, RenderTexture visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, const FeatureCache& featureCache);
+
+	// Sizes of the lists, the tile lists start with their counter and the indirect buffer holds the arguments of the eight dispatches
+	uint64_t tile_list_size() const { return (1 + (uint64_t)m_TileSize.x * m_TileSize.y) * sizeof(uint32_t); }
+	uint64_t repacked_tiles_size() const { return (uint64_t)m_TilePixels * m_TileSize.x * m_TileSize.y * sizeof(uint32_t); }
+	uint64_t indirect_size() const { return 3 * 8 * sizeof(uint32_t); }
+
+	// Lists used by the next classification and by the passes that consume it
+	void set_buffers(const TileClassifierBuffers& buffers) { m_Buffers = buffers; }
 
 	// Resource access
-	GraphicsBuffer active_tiles_buffer() const { return m_ActiveTileBuffer; }
-	GraphicsBuffer uniform_tiles_buffer() const { return m_UniformTileBuffer; }
-	GraphicsBuffer complex_tiles_buffer() const { return m_ComplexTileBuffer; }
-	GraphicsBuffer repacked_tiles_buffer() const { return m_RepackedTilesBuffer; }
-	GraphicsBuffer indirect_buffer() const { return m_IndirectBuffer; }
+	GraphicsBuffer active_tiles_buffer() const { return m_Buffers.activeTiles; }
+	GraphicsBuffer uniform_tiles_buffer() const { return m_Buffers.uniformTiles; }
+	GraphicsBuffer complex_tiles_buffer() const { return m_Buffers.complexTiles; }
+	GraphicsBuffer repacked_tiles_buffer() const { return m_Buffers.repackedTiles; }
+	GraphicsBuffer half_rate_tiles_buffer() const { return m_Buffers.halfRateTiles; }
+	GraphicsBuffer quarter_rate_tiles_buffer() const { return m_Buffers.quarterRateTiles; }
+	GraphicsBuffer indirect_buffer() const { return m_Buffers.indirect; }
 
 private:
 	// Device
@@ -48,13 +74,10 @@ private:
 	ComputeShader m_SecondPassCS = 0;
 
 	// Runtime resources
-	GraphicsBuffer m_ActiveTileBuffer = 0;
-	GraphicsBuffer m_UniformTileBuffer = 0;
-	GraphicsBuffer m_ComplexTileBuffer = 0;
 	GraphicsBuffer m_MLPUsageBuffer = 0;
-	GraphicsBuffer m_RepackedTilesBuffer = 0;
-	GraphicsBuffer m_IndirectBuffer = 0;
+	TileClassifierBuffers m_Buffers = TileClassifierBuffers();
 
 	// Other data
 	uint2 m_TileSize = { 0, 0 };
+	uint32_t m_TilePixels = 0;
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+#include "render_pipeline/types.h"
+
+// System includes
+#include <string>
+#include <vector>
+
+// Material of the pixels of a capture that nothing covers
+#define TILE_SHAPE_EMPTY_PIXEL UINT32_MAX
+
+// Material ID of every pixel of a visibility buffer, row major
+struct VisibilityCapture
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<uint32_t> materials;
+};
+
+// Relative cost of a lane of the passes that depend on the tile shape, the inference of a uniform tile is the unit
+struct TileShapeCostModel
+{
+	// Repacked groups gather scattered pixels, their latent space fetches are less coherent
+	float repackedInference = 1.25f;
+	// First and second classification passes
+	float classification = 0.1f;
+	// Lighting and debug view over the active tiles
+	float shading = 0.25f;
+};
+
+// Work generated by the classification of a frame
+struct TileShapeStats
+{
+	uint32_t numTiles = 0;
+	uint32_t activeTiles = 0;
+	uint32_t uniformTiles = 0;
+	uint32_t complexTiles = 0;
+	uint32_t repackedGroups = 0;
+	uint64_t coveredPixels = 0;
+	// Lanes of the waves launched by the inference (uniform tiles and repacked groups)
+	uint64_t inferenceLanes = 0;
+	// Uniform tiles over active tiles
+	float uniformFraction = 0.0f;
+	// Covered pixels over inference lanes
+	float laneEfficiency = 0.0f;
+	// Lanes of the second pass and of the partially filled repacked groups, relative to the covered pixels
+	float repackOverhead = 0.0f;
+	// Weighted lanes of the whole classification, inference and shading (TileShapeCostModel)
+	double cost = 0.0;
+};
+
+// Tile shapes of the classification, the CPU model mirrors FirstPass.compute and SecondPass.compute
+namespace tile_shape
+{
+	// Dimensions in pixels
+	uint2 dimensions(TileShape shape);
+	uint32_t num_pixels(TileShape shape);
+
+	// Names such as "8x4"
+	const char* name(TileShape shape);
+	bool parse(const std::string& name, TileShape& shape);
+
+	// The wave intrinsics of the classification need a tile to fit in a single wave.
+	// waveLaneRange is the minimal (x) and maximal (y) number of lanes the device can run.
+	bool supported(TileShape shape, const uint2& waveLaneRange);
+
+	// Defines of the shaders that process tiles, nothing for the default shape
+	void shader_defines(TileShape shape, const uint2& waveLaneRange, std::vector<std::string>& defines);
+
+	// Binary capture of a visibility buffer resolved to material IDs
+	bool write_capture(const std::string& path, const VisibilityCapture& capture);
+	bool read_capture(const std::string& path, VisibilityCapture& capture);
+
+	// Classifies a capture, waveLaneCount is the number of lanes of the waves that run a work group smaller than a wave
+	TileShapeStats evaluate(const VisibilityCapture& capture, TileShape shape, uint32_t waveLaneCount, const TileShapeCostModel& costModel);
+}
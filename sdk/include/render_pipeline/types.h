@@ -50,4 +50,15 @@ enum class FilteringMode
 	Linear,
 	Anisotropic,
 	Count
+};
+
+// Width x height of the classification tiles, a tile is processed by a single work group
+enum class TileShape
+{
+	Tile8x4 = 0,
+	Tile4x8,
+	Tile8x8,
+	Tile16x4,
+	Tile4x4,
+	Count
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+
+// System includes
+#include <vector>
+
+// Tiles handled by the inference kernels
+#define VRS_TILE_WIDTH 8
+#define VRS_TILE_HEIGHT 4
+#define VRS_TILE_PIXELS (VRS_TILE_WIDTH * VRS_TILE_HEIGHT)
+
+// Number of features per pixel
+#define VRS_NUM_FEATURES 16
+
+// Falloff of the upsample weights with the UV discontinuity (in pixel footprints)
+#define VRS_EDGE_SHARPNESS 4.0f
+
+// Rate at which the pixels of a tile are inferred, matches INFERENCE_RATE_* in variable_rate.hlsl
+enum class InferenceRate
+{
+	Full = 0,
+	Half,
+	Quarter,
+	Count
+};
+
+// Selection thresholds, expressed in mips of the latent space
+struct VariableRateSettings
+{
+	float halfRateMip = 2.0f;
+	float quarterRateMip = 3.0f;
+	float maxMipSpread = 1.0f;
+};
+
+// Per pixel inputs of a tile, row major
+struct VariableRateTile
+{
+	bool covered[VRS_TILE_PIXELS];
+	uint32_t material[VRS_TILE_PIXELS];
+	float2 uv[VRS_TILE_PIXELS];
+	float2 uvDX[VRS_TILE_PIXELS];
+	float2 uvDY[VRS_TILE_PIXELS];
+	// Normalized LOD (compute_lod)
+	float lod[VRS_TILE_PIXELS];
+};
+
+// Outcome of a sweep over a set of tiles
+struct VariableRateStats
+{
+	uint32_t numTiles[(uint32_t)InferenceRate::Count] = { 0, 0, 0 };
+	uint64_t inferredPixels = 0;
+	uint64_t coveredPixels = 0;
+	double meanSquaredError = 0.0;
+	double psnr = 0.0;
+};
+
+// CPU reference of the tile classification and of the reconstruction done by the GPU (FirstPass.compute, Upsample.compute)
+namespace variable_rate
+{
+	// Normalized LOD thresholds as stored in the global constant buffer, numMips is log2 of the latent space resolution
+	void normalized_thresholds(const VariableRateSettings& settings, float numMips, float& halfRateLOD, float& quarterRateLOD, float& maxLODSpread);
+
+	// Rate of a tile
+	InferenceRate select_rate(const VariableRateTile& tile, float halfRateLOD, float quarterRateLOD, float maxLODSpread);
+
+	// Pixels that are inferred at a given rate
+	bool is_inferred_pixel(uint32_t localX, uint32_t localY, InferenceRate rate);
+	uint32_t inferred_pixels_per_tile(InferenceRate rate);
+
+	// Fills the skipped pixels of a tile from the inferred ones, features holds VRS_NUM_FEATURES values per pixel
+	void upsample_tile(const VariableRateTile& tile, InferenceRate rate, float* features);
+
+	// Classifies and reconstructs the tiles, the error is measured against the full rate features
+	VariableRateStats evaluate(const std::vector<VariableRateTile>& tiles, const std::vector<float>& referenceFeatures, const VariableRateSettings& settings, float numMips);
+}
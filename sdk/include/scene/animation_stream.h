@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "scene/mesh.h"
+#include "tools/mapped_file.h"
+
+// System includes
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Frames kept decoded by default: the current one, the next one and a prefetched one
+#define ANIMATION_STREAM_NUM_SLOTS 3
+
+struct AnimationStreamStats
+{
+	// Frames read from the file by the loader
+	uint32_t decodedFrames = 0;
+	// Acquisitions that had to wait for the loader
+	uint32_t stalls = 0;
+};
+
+// Streams the frames of a .anim file (version 1 or 2) instead of keeping all of them in memory.
+// The file is memory mapped, a loader thread decodes the frames of a window that starts at the requested frame
+// and wraps around the end of the animation, in a fixed number of slots. The frames keep the layout of the files:
+// VertexData for version 1, QuantizedVertexData for version 2 (the delta frames are applied on top of the previous one).
+class AnimationStream
+{
+public:
+	// Cst & Dst
+	AnimationStream();
+	~AnimationStream();
+
+	// Init & Release
+	bool initialize(const std::string& path, uint32_t numSlots = ANIMATION_STREAM_NUM_SLOTS);
+	void release();
+
+	// Data that doesn't change with the animation, the shared vertices of version 1 come from the first frame
+	const std::vector<uint3>& index_buffer() const { return m_Topology.indexBuffer; }
+	const std::vector<SharedVertexData>& shared_vertices() const { return m_Topology.sharedVertices; }
+	const float3& bounds_min() const { return m_Topology.boundsMin; }
+	const float3& bounds_extent() const { return m_Topology.boundsExtent; }
+
+	// Layout of the frames
+	bool quantized() const { return m_Quantized; }
+	uint32_t num_frames() const { return m_NumFrames; }
+	uint32_t num_vertices() const { return m_NumVertices; }
+	uint32_t vertex_size() const { return m_Quantized ? sizeof(QuantizedVertexData) : sizeof(VertexData); }
+	uint32_t num_slots() const { return m_NumSlots; }
+
+	// Moves the window of decoded frames to start at frameIdx
+	void request(uint32_t frameIdx);
+
+	// Decoded frame, num_vertices() * vertex_size() bytes. The frame has to be in the window of the last request,
+	// the pointer is valid until the next request. acquire waits for the loader, try_acquire returns nullptr instead.
+	const char* acquire(uint32_t frameIdx);
+	const char* try_acquire(uint32_t frameIdx);
+
+	// Stats since the initialization
+	AnimationStreamStats stats();
+
+private:
+	struct Slot
+	{
+		// Frame in the slot, UINT32_MAX if none
+		uint32_t frameIdx = UINT32_MAX;
+		bool ready = false;
+		std::vector<char> data;
+	};
+
+	void load_loop();
+	bool in_window(uint32_t frameIdx) const;
+	uint32_t find_slot(uint32_t frameIdx) const;
+	uint32_t next_missing_frame() const;
+	void decode_frame(uint32_t frameIdx, char* output);
+
+private:
+	// File and offset of every frame in it
+	MappedFile m_File;
+	std::vector<uint64_t> m_FrameOffsets;
+
+	// Layout
+	QuantizedMeshAnimation m_Topology;
+	bool m_Quantized = false;
+	uint32_t m_KeyframeInterval = 0;
+	uint32_t m_NumFrames = 0;
+	uint32_t m_NumVertices = 0;
+	uint32_t m_NumSlots = 0;
+
+	// Slots and first frame of the window, protected by the mutex
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::vector<Slot> m_Slots;
+	uint32_t m_WindowStart = 0;
+	AnimationStreamStats m_Stats;
+
+	// Last frame decoded by the loader, the delta frames are applied on top of it
+	std::vector<QuantizedVertexData> m_DeltaFrame;
+	uint32_t m_DeltaFrameIdx = UINT32_MAX;
+
+	// Loading thread
+	std::thread m_Thread;
+	std::atomic<bool> m_Active = false;
+};
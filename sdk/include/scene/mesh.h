@@ -13,6 +13,13 @@
 // System includes
 #include <vector>
 
+// Header of the quantized .anim files ("ANIM", version 2), the version 1 files have no header and start with the index buffer
+#define MESH_ANIMATION_MAGIC 0x4D494E41
+#define MESH_ANIMATION_VERSION 2
+
+// Frames stored as deltas after a key frame, 0 stores every frame as a key frame
+#define MESH_ANIMATION_DEFAULT_KEYFRAME_INTERVAL 8
+
 struct VertexBuffer
 {
     std::vector<VertexData> data;
@@ -24,11 +31,59 @@ struct MeshAnimation
     std::vector<VertexBuffer> vertexBufferArray;
 };
 
+// Attributes that don't change with the animation, stored once
+struct SharedVertexData
+{
+    float2 texCoord;
+    uint32_t matID;
+};
+
+// Attributes of a vertex in a frame, matches the uint4 read by SkinMesh.compute with QUANTIZED_VERTICES.
+// The position is quantized on 16 bits in the bounds of the animation, the normal and the tangent are octahedral encoded on 2x16 bits.
+struct QuantizedVertexData
+{
+    uint16_t position[3];
+    uint16_t normal[2];
+    uint16_t tangent[2];
+    uint16_t padding;
+};
+
+struct QuantizedMeshAnimation
+{
+    std::vector<uint3> indexBuffer;
+    std::vector<SharedVertexData> sharedVertices;
+
+    // Bounds of the positions over every frame
+    float3 boundsMin;
+    float3 boundsExtent;
+
+    std::vector<std::vector<QuantizedVertexData>> frames;
+};
+
 namespace mesh
 {
-    // Import a packed mesh animation from disk
+    // Import a packed mesh animation from disk, quantized files are decoded
     void import_mesh_animation(const char* path, MeshAnimation& meshAnimation);
 
     // Export a packed mesh animation to disk
     void export_mesh_animation(const MeshAnimation& meshAnimation, const char* path);
+
+    // Quantized mesh animations, the version 1 files are quantized when imported
+    bool is_quantized_mesh_animation(const char* path);
+    void import_quantized_mesh_animation(const char* path, QuantizedMeshAnimation& meshAnimation);
+    void export_quantized_mesh_animation(const QuantizedMeshAnimation& meshAnimation, const char* path, uint32_t keyframeInterval = MESH_ANIMATION_DEFAULT_KEYFRAME_INTERVAL);
+
+    // Conversions, the frames are decoded with SSE2 when available, the reference is scalar and produces the same values
+    void quantize_mesh_animation(const MeshAnimation& meshAnimation, QuantizedMeshAnimation& quantizedAnimation);
+    void dequantize_mesh_animation(const QuantizedMeshAnimation& quantizedAnimation, MeshAnimation& meshAnimation);
+    void dequantize_frame(const QuantizedMeshAnimation& quantizedAnimation, uint32_t frameIdx, std::vector<VertexData>& vertices);
+    void dequantize_frame_reference(const QuantizedMeshAnimation& quantizedAnimation, uint32_t frameIdx, std::vector<VertexData>& vertices);
+
+    // Frame by frame reading of a version 2 file in memory, the stream is moved past what was read.
+    // The header returns the number of frames and leaves the frames of meshAnimation empty.
+    uint32_t unpack_quantized_header(const char*& stream, QuantizedMeshAnimation& meshAnimation, uint32_t& keyframeInterval);
+    bool is_key_frame(uint32_t frameIdx, uint32_t keyframeInterval);
+    // A delta frame is applied on top of the previous frame
+    void unpack_quantized_frame(const char*& stream, bool keyFrame, const std::vector<QuantizedVertexData>& previousFrame, std::vector<QuantizedVertexData>& frame);
+    void skip_quantized_frame(const char*& stream, bool keyFrame);
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "scene/mesh.h"
+
+// System includes
+#include <vector>
+
+// Post transform cache simulated by the triangle reordering and the statistics (FIFO, in vertices)
+#define MESH_OPTIMIZER_CACHE_SIZE 16
+
+// A cluster is split once its local ACMR gets below this factor of the ACMR of the whole cluster
+#define MESH_OPTIMIZER_OVERDRAW_THRESHOLD 1.05f
+
+// Cache lines of the vertex fetch statistics, FIFO of MESH_OPTIMIZER_FETCH_CACHE_LINES lines
+#define MESH_OPTIMIZER_FETCH_LINE_SIZE 64
+#define MESH_OPTIMIZER_FETCH_CACHE_LINES 64
+
+struct VertexCacheStats
+{
+	// Vertices transformed (cache misses)
+	uint32_t transformedVertices = 0;
+	// Average cache miss ratio: transformed vertices per triangle, between 0.5 and 3
+	float acmr = 0.0f;
+	// Average transform to vertex ratio: transformed vertices per referenced vertex, 1 is optimal
+	float atvr = 0.0f;
+};
+
+struct VertexFetchStats
+{
+	// Bytes read from memory
+	uint64_t fetchedBytes = 0;
+	// Fetched bytes over the size of the referenced vertices, 1 is optimal
+	float overfetch = 0.0f;
+};
+
+struct MeshOptimizerOptions
+{
+	uint32_t cacheSize = MESH_OPTIMIZER_CACHE_SIZE;
+	// Values below 1 disable the overdraw ordering
+	float overdrawThreshold = MESH_OPTIMIZER_OVERDRAW_THRESHOLD;
+	bool optimizeFetch = true;
+};
+
+// Steps of optimize_mesh_animation that were kept, a step is dropped when it would make the cache or fetch statistics worse than the input ones
+struct MeshOptimizerResult
+{
+	bool reorderedTriangles = false;
+	bool remappedVertices = false;
+};
+
+// Asset time reordering of the index buffers for the visibility pass and the shaders that fetch the vertices of a primitive.
+// Triangles are reordered for the post transform cache with Tipsify (Sander et al. 2007), the clusters it produces are sorted
+// so that the outer surfaces are drawn first, and the vertices are renumbered in order of first use for the fetches.
+namespace mesh_optimizer
+{
+	// Tipsify, clusters receives the first triangle of every cluster (including 0)
+	void optimize_vertex_cache(std::vector<uint3>& indices, uint32_t numVertices, uint32_t cacheSize, std::vector<uint32_t>* clusters = nullptr);
+
+	// Splits the clusters further and sorts them by occlusion potential, from the rest pose positions
+	void optimize_overdraw(std::vector<uint3>& indices, const std::vector<float3>& positions, const std::vector<uint32_t>& clusters, uint32_t cacheSize, float threshold);
+
+	// Renumbers the vertices in order of first use, remap[oldIndex] = newIndex. The unreferenced vertices are moved at the end.
+	// Returns the number of referenced vertices.
+	uint32_t optimize_vertex_fetch(std::vector<uint3>& indices, uint32_t numVertices, std::vector<uint32_t>& remap);
+
+	// Applies a remap to every frame
+	void remap_vertices(MeshAnimation& animation, const std::vector<uint32_t>& remap);
+	void remap_vertices(QuantizedMeshAnimation& animation, const std::vector<uint32_t>& remap);
+
+	// Whole pipeline on an animation, the overdraw uses the first frame. The input order is kept where the optimized one is worse
+	MeshOptimizerResult optimize_mesh_animation(MeshAnimation& animation, const MeshOptimizerOptions& options = MeshOptimizerOptions());
+	MeshOptimizerResult optimize_mesh_animation(QuantizedMeshAnimation& animation, const MeshOptimizerOptions& options = MeshOptimizerOptions());
+
+	// Statistics
+	VertexCacheStats analyze_vertex_cache(const std::vector<uint3>& indices, uint32_t numVertices, uint32_t cacheSize);
+	VertexFetchStats analyze_vertex_fetch(const std::vector<uint3>& indices, uint32_t numVertices, uint32_t vertexSize);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "math/types.h"
+
+// System includes
+#include <vector>
+
+// Limits of a meshlet, the usual mesh shader output sizes
+#define MESHLET_MAX_VERTICES 64
+#define MESHLET_MAX_TRIANGLES 124
+
+// Meshlets whose bounds are refitted by a task
+#define MESHLET_GRAIN_SIZE 64
+
+// Below this spread of the normals (cosine to the axis), the cone of a meshlet is disabled
+#define MESHLET_MIN_CONE_SPREAD 0.1f
+
+// Added to the cutoff of the cones, the rasterizer decides the facing of grazing triangles on snapped positions
+#define MESHLET_CONE_SLACK 0.01f
+
+// Range of the meshlet in the vertex and triangle lists, matches the uint4 read by MeshletCulling.compute
+struct Meshlet
+{
+	uint32_t vertexOffset;
+	uint32_t vertexCount;
+	uint32_t triangleOffset;
+	uint32_t triangleCount;
+};
+
+// Bounds of a meshlet for a pose, matches the two float4 written by MeshletCulling.compute
+struct MeshletBounds
+{
+	// Bounding sphere
+	float3 center;
+	float radius;
+
+	// Normal cone of the front faces, the meshlet is back facing for every view direction within the cutoff (sine of the half angle) of the axis.
+	// A cutoff of 1 disables the test.
+	float3 coneAxis;
+	float coneCutoff;
+};
+
+struct MeshletMesh
+{
+	std::vector<Meshlet> meshlets;
+	// Global vertex indices, vertexCount per meshlet
+	std::vector<uint32_t> vertices;
+	// Primitive IDs of the index buffer, triangleCount per meshlet. The primitive IDs are unchanged so the visibility buffer keeps its meaning
+	std::vector<uint32_t> triangles;
+};
+
+// Planes of the frustum in the camera relative space of VisibilityPass.graphics
+struct MeshletCullingView
+{
+	float4 planes[4];
+	float3 cameraPosition;
+};
+
+struct MeshletCullingStats
+{
+	uint32_t visibleMeshlets = 0;
+	uint32_t visibleTriangles = 0;
+	uint32_t frustumCulled = 0;
+	uint32_t backfaceCulled = 0;
+};
+
+namespace meshlet
+{
+	// Greedy builder, grows every meshlet with the adjacent triangle that adds the fewest vertices, then the one that keeps the normals the closest.
+	// The positions of the rest pose drive the choices.
+	void build(const std::vector<uint3>& indices, const std::vector<float3>& positions, MeshletMesh& mesh);
+
+	// Bounds of every meshlet for a pose, in parallel with the task scheduler
+	void compute_bounds(const MeshletMesh& mesh, const std::vector<uint3>& indices, const std::vector<float3>& positions, std::vector<MeshletBounds>& bounds);
+
+	// View from the camera relative view projection matrix (same convention as mul_transpose) and the camera position
+	MeshletCullingView culling_view(const float4x4& viewProjection, const float3& cameraPosition);
+
+	// Frustum and normal cone tests, conservative
+	bool frustum_visible(const MeshletBounds& bounds, const MeshletCullingView& view);
+	bool cone_visible(const MeshletBounds& bounds, const MeshletCullingView& view);
+
+	// Culls every meshlet, visible receives the primitive IDs that survived in the order of the meshlets
+	MeshletCullingStats cull(const MeshletMesh& mesh, const std::vector<MeshletBounds>& bounds, const MeshletCullingView& view, std::vector<uint32_t>& visible);
+}
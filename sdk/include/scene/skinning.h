@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Includes
+#include "scene/mesh.h"
+
+// System includes
+#include <vector>
+
+// Vertices skinned by a task of the parallel paths
+#define SKINNING_GRAIN_SIZE 4096
+
+// Pair of frames and blend factor of an animation time, same selection as SkinnedMeshRenderer
+struct SkinningFrame
+{
+	uint32_t frameA = 0;
+	uint32_t frameB = 0;
+	float interpolationFactor = 0.0f;
+};
+
+// Positions of every frame of an animation, one stream per axis and numVertices values per frame
+struct PositionStreams
+{
+	uint32_t numVertices = 0;
+	uint32_t numFrames = 0;
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+};
+
+// CPU counterpart of SkinMesh.compute, for the consumers of the current pose that run without a GPU.
+// The vectorized paths use AVX2 when the processor supports it, SSE2 otherwise, and split the vertices across the task scheduler.
+// The reference paths are scalar and single threaded.
+namespace skinning
+{
+	// Frames to interpolate for a time in [0, 1)
+	SkinningFrame animation_frame(uint32_t numFrames, float time);
+
+	// Full vertices, every float of VertexData is interpolated and the material ID is cleared like on the GPU
+	void skin_vertices(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<VertexData>& vertices);
+	void skin_vertices_reference(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<VertexData>& vertices);
+
+	// Positions only, from the vertex buffers or from the transposed streams
+	void transpose_positions(const MeshAnimation& animation, PositionStreams& streams);
+	void skin_positions(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<float3>& positions);
+	void skin_positions(const PositionStreams& streams, const SkinningFrame& frame, std::vector<float3>& positions);
+	void skin_positions_reference(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<float3>& positions);
+
+	// AVX2 kernels of skin_vertices and of skin_positions from the streams, built with /arch:AVX2 and only called when cpu_features::avx2() is true.
+	// They blend [first, last) 2 vertices or 8 positions at a time and return the first vertex left to the caller.
+	uint32_t skin_vertex_range_avx2(const float* verticesA, const float* verticesB, float* output, uint32_t first, uint32_t last, float interpolationFactor);
+	uint32_t skin_stream_range_avx2(const PositionStreams& streams, size_t offsetA, size_t offsetB, float3* output, uint32_t first, uint32_t last, float interpolationFactor);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// Project includes
+#include "render_pipeline/types.h"
+#include "tools/cpu_profiler.h"
+
+// System includes
+#include <map>
+#include <string>
+#include <vector>
+
+// Simulation step of the benchmark frames (seconds), independent from the actual frame time
+#define BENCHMARK_TIME_STEP (1.0 / 60.0)
+
+// Rendering configuration of a benchmark step
+struct BenchmarkConfig
+{
+	uint32_t poi = 0;
+	TextureMode textureMode = TextureMode::Neural;
+	FilteringMode filteringMode = FilteringMode::Anisotropic;
+	bool cooperative = false;
+	bool variableRate = false;
+	bool featureCache = false;
+};
+
+enum class BenchmarkPhase
+{
+	Start = 0,
+	Travel,
+	Warmup,
+	Measure,
+	Done
+};
+
+// Scripted sweep over the camera POIs and the rendering configurations. Each step travels to its POI,
+// warms up, then records the timings of a fixed number of frames that are reduced to percentiles.
+class BenchmarkRunner
+{
+public:
+	// Cst & Dst
+	BenchmarkRunner();
+	~BenchmarkRunner();
+
+	// Builds the steps of the scenario, returns false if the scenario is unknown.
+	// "full": POIs x texture modes x filtering modes x cooperative vectors, "pois": every POI with the initial configuration,
+	// "modes": every configuration on the initial POI, "vrs": every POI with and without variable rate inference,
+	// "cache": every POI with and without the feature cache.
+	bool initialize(const std::string& scenario, uint32_t numPOIs, const BenchmarkConfig& initialConfig, bool cooperativeSupported, uint32_t warmupFrames, uint32_t measuredFrames);
+	void release();
+
+	// Advances the state machine, needs to be called once before every frame. Returns false once every step is done.
+	bool next_frame(bool cameraMoving);
+
+	// Current step
+	bool active() const { return m_Phase != BenchmarkPhase::Done && !m_Steps.empty(); }
+	bool step_started() const { return m_StepStarted; }
+	bool poi_changed() const { return m_POIChanged; }
+	bool measuring() const { return m_Phase == BenchmarkPhase::Measure; }
+	const BenchmarkConfig& config() const { return m_Steps[m_CurrentStep].config; }
+	uint32_t current_step() const { return m_CurrentStep; }
+	uint32_t num_steps() const { return (uint32_t)m_Steps.size(); }
+
+	// Timing of the current frame, ignored outside of the measurement phase
+	void record(const std::string& scope, float durationMS);
+
+	// Writes <prefix>.json and <prefix>.csv with the p50/p95/p99 of every scope of every step
+	bool write_reports(const std::string& prefix, const char* deviceName) const;
+
+private:
+	struct BenchmarkStep
+	{
+		BenchmarkConfig config;
+		std::map<std::string, ScopeHistory> scopes;
+	};
+
+private:
+	std::string m_Scenario = "";
+	std::vector<BenchmarkStep> m_Steps;
+	uint32_t m_WarmupFrames = 0;
+	uint32_t m_MeasuredFrames = 0;
+
+	// State machine
+	BenchmarkPhase m_Phase = BenchmarkPhase::Done;
+	uint32_t m_CurrentStep = 0;
+	uint32_t m_PhaseFrame = 0;
+	bool m_StepStarted = false;
+	bool m_POIChanged = false;
+};
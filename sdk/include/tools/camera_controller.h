@@ -91,6 +91,8 @@ public:
     void load_camera_path(const char* pathName);
     void save_camera_path(const char* pathName);
     void move_to_poi(uint32_t poiIDX);
+    uint32_t num_poi() const { return (uint32_t)m_POIArray.size(); }
+    bool is_playing() const { return m_IsPlaying; }
 
 protected:
     // Render window
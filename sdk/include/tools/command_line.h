@@ -8,6 +8,7 @@
 #pragma once
 
 // Project includes
+#include "graphics/types.h"
 #include "render_pipeline/types.h"
 
 // System includes
@@ -19,6 +20,13 @@ struct CommandLineOptions
 	// Location of the data
 	std::string dataDir = ".";
 
+	// Graphics backend, the null one runs without a GPU and only its CPU timings are meaningful
+#if defined(D3D12_SUPPORTED)
+	GraphicsAPI graphicsAPI = GraphicsAPI::DX12;
+#else
+	GraphicsAPI graphicsAPI = GraphicsAPI::Null;
+#endif
+
 	// Adapter index (as returned by OS)
 	int32_t adapterIndex = -1;
 
@@ -28,9 +36,21 @@ struct CommandLineOptions
 	// Cooperative vectors enabled at start
 	bool enableCooperative = true;
 
+	// Variable rate inference enabled at start
+	bool enableVariableRate = false;
+
+	// Reuse of the features of the previous frame enabled at start
+	bool enableFeatureCache = false;
+
 	// Mesh animation enabled at start
 	bool disableAnimation = false;
 
+	// On-disk DXIL cache
+	bool disableShaderCache = false;
+
+	// Archive of precompiled shader permutations
+	std::string shaderArchive = "";
+
 	// Control the rendering mode
 	RenderingMode renderingMode = RenderingMode::GBufferDeferred;
 
@@ -39,6 +59,15 @@ struct CommandLineOptions
 
 	// Filtering mode
 	FilteringMode filteringMode = FilteringMode::Anisotropic;
+
+	// Shape of the classification tiles
+	TileShape tileShape = TileShape::Tile8x4;
+
+	// Benchmark scenario, empty for interactive runs
+	std::string benchmarkScenario = "";
+	uint32_t benchmarkWarmupFrames = 60;
+	uint32_t benchmarkFrames = 300;
+	std::string benchmarkOutput = "";
 };
 
 namespace command_line
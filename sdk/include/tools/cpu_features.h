@@ -0,0 +1,14 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+namespace cpu_features
+{
+	// True when the processor supports AVX2 and the OS saves the YMM registers, the AVX2 kernels are only called then
+	bool avx2();
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Number of completed scopes a thread can buffer before they are collected, the extra ones are dropped
+#define CPU_PROFILER_THREAD_CAPACITY 4096
+
+// Maximal nesting of the scopes of a thread
+#define CPU_PROFILER_MAX_DEPTH 64
+
+// Timed scope on a CPU thread or a GPU queue
+struct TraceEvent
+{
+	std::string name = "";
+	double startUS = 0.0;
+	double durationUS = 0.0;
+	uint32_t depth = 0;
+
+	// Process (CPU or GPU) and thread (CPU thread or GPU queue) of the event
+	uint32_t process = 0;
+	uint32_t thread = 0;
+};
+
+#define TRACE_PROCESS_CPU 0
+#define TRACE_PROCESS_GPU 1
+
+// Last durations of a scope and their percentiles
+class ScopeHistory
+{
+public:
+	// Cst & Dst
+	ScopeHistory(uint32_t windowSize = 128);
+	~ScopeHistory();
+
+	void push(float durationMS);
+	float last() const { return m_Last; }
+	float percentile(float p) const;
+	uint32_t count() const { return (uint32_t)m_Samples.size(); }
+
+private:
+	std::vector<float> m_Samples;
+	uint32_t m_WindowSize = 0;
+	uint32_t m_Next = 0;
+	float m_Last = 0.0f;
+};
+
+namespace cpu_profiler
+{
+	// Microseconds since the first use of the profiler, of now or of a time of the steady clock (nanoseconds since its epoch)
+	double timestamp_us();
+	double timestamp_us(uint64_t steadyClockNS);
+
+	// Scopes of the calling thread, the name needs to outlive the collection (string literals).
+	// The completed scopes go to a lock-free buffer owned by the thread.
+	void begin_scope(const char* name);
+	void end_scope();
+
+	// Moves the completed scopes of every thread to the output, returns the number of events dropped since the last collection
+	uint32_t collect(std::vector<TraceEvent>& outEvents);
+}
+
+// Times the enclosing block
+class CPUProfileScope
+{
+public:
+	CPUProfileScope(const char* name) { cpu_profiler::begin_scope(name); }
+	~CPUProfileScope() { cpu_profiler::end_scope(); }
+};
+#define CPU_PROFILE_SCOPE_CONCAT_INTERNAL(a, b) a##b
+#define CPU_PROFILE_SCOPE_CONCAT(a, b) CPU_PROFILE_SCOPE_CONCAT_INTERNAL(a, b)
+#define CPU_PROFILE_SCOPE(name) CPUProfileScope CPU_PROFILE_SCOPE_CONCAT(__cpuProfileScope, __LINE__)(name)
+
+// Writes the events in the Chrome trace event format (chrome://tracing, Perfetto)
+bool export_chrome_trace(const char* path, const std::vector<TraceEvent>& events);
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <deque>
+#include <stdint.h>
+#include <vector>
+
+// Timeline of the blocks that were never submitted, they can be recycled right away
+#define DESCRIPTOR_RING_NO_TIMELINE UINT32_MAX
+
+// Ring allocator over a fixed range of descriptors shared by all the command buffers.
+// Space is handed out in contiguous blocks, each block is submitted with the fence value (on a given timeline, one per queue)
+// that signals the end of the work that reads it. Blocks are recycled in allocation order once their fence has been reached.
+class DescriptorRing
+{
+public:
+	// Cst & Dst
+	DescriptorRing();
+	~DescriptorRing();
+
+	// Initialization and release
+	void initialize(uint32_t capacity);
+	void release();
+
+	// Allocates a contiguous block of count descriptors, returns UINT32_MAX if the ring is full
+	uint32_t allocate(uint32_t count);
+
+	// Declares the fence value after which the block at offset can be recycled
+	void submit(uint32_t offset, uint32_t timeline, uint64_t fenceValue);
+
+	// Recycles the blocks whose fence was reached, completedValues is indexed by timeline
+	void retire(const std::vector<uint64_t>& completedValues);
+
+	// Occupancy
+	uint32_t capacity() const { return m_Capacity; }
+	uint32_t used() const { return m_Used; }
+
+private:
+	struct Block
+	{
+		uint32_t offset = 0;
+		uint32_t count = 0;
+		uint32_t timeline = DESCRIPTOR_RING_NO_TIMELINE;
+		uint64_t fenceValue = 0;
+		bool submitted = false;
+	};
+
+private:
+	// Total number of descriptors
+	uint32_t m_Capacity = 0;
+
+	// Next descriptor to allocate and oldest one in use
+	uint32_t m_Head = 0;
+	uint32_t m_Tail = 0;
+
+	// Number of descriptors in use (padding included)
+	uint32_t m_Used = 0;
+
+	// Blocks in allocation order
+	std::deque<Block> m_Blocks;
+};
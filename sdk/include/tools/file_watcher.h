@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Absolute, normalized version of a path so that paths coming from different sources can be compared
+std::string normalize_file_path(const std::string& path);
+
+// Watches a directory and its sub-directories for modified files (ReadDirectoryChangesW on Windows, inotify on Linux)
+class FileWatcher
+{
+public:
+	// Cst & Dst
+	FileWatcher();
+	~FileWatcher();
+
+	// Initialization and release
+	bool initialize(const std::string& directory);
+	void release();
+
+	// Is the watcher running
+	bool active() const;
+
+	// Grabs the normalized paths of the files that were created or modified since the last call.
+	// Returns false if the system dropped events, in which case any file may have changed.
+	bool consume_changes(std::vector<std::string>& outFiles);
+
+private:
+	void watch_loop();
+	void record_change(const std::string& path);
+
+private:
+	// Watched directory
+	std::string m_Directory = "";
+
+	// Watching thread
+	std::thread m_Thread;
+	std::atomic<bool> m_Active = false;
+
+	// Changes since the last query
+	std::mutex m_Mutex;
+	std::set<std::string> m_ChangedFiles;
+	bool m_Overflow = false;
+
+#if defined(_WIN32)
+	// Directory handle and event used to interrupt the wait
+	void* m_DirectoryHandle = nullptr;
+	void* m_StopEvent = nullptr;
+#else
+	// Inotify instance and the directory of each watch descriptor
+	int m_NotifyFD = -1;
+	std::map<int, std::string> m_WatchedDirectories;
+#endif
+};
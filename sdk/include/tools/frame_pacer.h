@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <stdint.h>
+#include <vector>
+
+// Paces the frames recorded on the CPU against the ones executed by the GPU.
+// Every frame gets one of the numFrames slots (command buffer, constant buffers, ...) and a fence value to signal once
+// it has been submitted. A slot can only be recorded again once the GPU reached the value of the frame that last used it.
+class FramePacer
+{
+public:
+	// Cst & Dst
+	FramePacer();
+	~FramePacer();
+
+	// Initialization and release
+	void initialize(uint32_t numFrames);
+	void release();
+
+	// Starts a new frame and returns its slot. outWaitValue is the fence value to wait for before reusing the slot's resources.
+	uint32_t begin_frame(uint64_t& outWaitValue);
+
+	// Ends the current frame and returns the fence value to signal once its work has been submitted
+	uint64_t end_frame();
+
+	// Fence value to wait for to drain all the submitted frames
+	uint64_t last_submitted_value() const { return m_LastValue; }
+
+	// Properties
+	uint32_t num_frames() const { return m_NumFrames; }
+	uint32_t current_slot() const { return m_CurrentSlot; }
+
+private:
+	// Number of frames that can be in flight
+	uint32_t m_NumFrames = 0;
+
+	// Fence value of the last frame that used each slot
+	std::vector<uint64_t> m_SlotValues;
+
+	// Last fence value handed out
+	uint64_t m_LastValue = 0;
+
+	// Slot of the frame being recorded
+	uint32_t m_CurrentSlot = UINT32_MAX;
+	uint64_t m_FrameCount = 0;
+};
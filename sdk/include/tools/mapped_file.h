@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <stdint.h>
+#include <string>
+
+// Read only view of a whole file (CreateFileMapping on Windows, mmap on Linux), the pages are read from disk when first accessed
+class MappedFile
+{
+public:
+	// Cst & Dst
+	MappedFile();
+	~MappedFile();
+
+	// Open and close
+	bool open(const std::string& path);
+	void close();
+
+	// Content of the file, nullptr when not opened
+	const char* data() const { return m_Data; }
+	uint64_t size() const { return m_Size; }
+
+private:
+	const char* m_Data = nullptr;
+	uint64_t m_Size = 0;
+
+#if defined(_WIN32)
+	// File and mapping handles
+	void* m_FileHandle = nullptr;
+	void* m_MappingHandle = nullptr;
+#else
+	int m_FileDescriptor = -1;
+#endif
+};
@@ -9,10 +9,18 @@
 
 // SDK includes
 #include "graphics/types.h"
+#include "tools/cpu_profiler.h"
 
 // Sytem includes
+#include <map>
+#include <string>
 #include <vector>
 
+// Maximal number of GPU scopes recorded in a frame, the extra ones are ignored
+#define PROFILING_MAX_GPU_SCOPES 256
+
+// Named, nested GPU scopes timed with a ring of timestamp regions (one per frame in flight) that are read back without waiting,
+// and collection of the CPU scopes. The sections of the command buffers are GPU scopes as well.
 class ProfilingHelper
 {
 public:
@@ -20,21 +28,83 @@ public:
 	ProfilingHelper();
 	~ProfilingHelper();
 
-	// Initialization and release
-	void initialize(GraphicsDevice device, CommandQueue cmdQ, uint32_t numScopes);
+	// Initialization and release, the timestamps of a frame are read back numFramesInFlight frames later
+	void initialize(GraphicsDevice device, CommandQueue cmdQ, uint32_t numFramesInFlight);
 	void release();
 
-	// Runtime functions
-	void start_profiling(CommandBuffer cmd, uint32_t index);
-	void end_profiling(CommandBuffer cmd, uint32_t index);
-	void process_scopes(CommandQueue cmdQ);
-	uint64_t get_scope_last_duration(uint32_t index);
-	uint64_t get_scope_max_duration(uint32_t index);
-	void reset_durations();
+	// Frame boundaries. begin_frame needs to be called once the GPU is done with the frame submitted numFramesInFlight frames ago,
+	// end_frame resolves the timestamps and needs to be recorded on a command buffer that executes after all the scopes of the frame.
+	void begin_frame();
+	void end_frame(CommandBuffer cmd);
+
+	// GPU scopes are only recorded while enabled, the state is applied at the next frame
+	void set_enabled(bool state) { m_RequestedEnabled = state; }
+	bool enabled() const { return m_Enabled; }
+
+	// Named GPU scopes, the name is copied
+	void begin_scope(CommandBuffer cmd, const char* name);
+	void end_scope(CommandBuffer cmd);
+
+	// Rolling durations (ms) of the scopes, nullptr if the scope was never recorded
+	const ScopeHistory* gpu_scope(const std::string& name) const;
+	const ScopeHistory* cpu_scope(const std::string& name) const;
+
+	// GPU scopes of the last frame that was read back, in recording order
+	const std::vector<TraceEvent>& last_gpu_frame() const { return m_LastGPUFrame; }
+
+	// Records the next numFrames frames and writes them as a Chrome trace
+	void capture_trace(const char* path, uint32_t numFrames);
+	bool capture_pending() const { return m_CaptureFramesLeft > 0; }
+
+private:
+	struct GPUScope
+	{
+		std::string name = "";
+		uint32_t depth = 0;
+		CommandBufferType queue = CommandBufferType::Default;
+		uint32_t beginQuery = 0;
+		uint32_t endQuery = 0;
+	};
+
+	struct FrameRegion
+	{
+		std::vector<GPUScope> scopes;
+		uint32_t numQueries = 0;
+		bool resolved = false;
+
+		// Clock calibration of both queues taken when the frame started, maps their ticks to the CPU timeline
+		uint64_t calibrationTicks[2] = { 0, 0 };
+		double calibrationUS[2] = { 0.0, 0.0 };
+	};
+
+private:
+	static void section_callback(void* userData, CommandBuffer cmd, const char* name);
+	void process_region(FrameRegion& region, uint32_t regionIdx);
 
 private:
-	uint32_t m_NumScopes = 0;
-	std::vector<ProfilingScope> m_Scopes;
-	std::vector<uint64_t> m_LastDurationArray;
-	std::vector<uint64_t> m_MaxDurationArray;
-};
\ No newline at end of file
+	// Timestamps, PROFILING_MAX_GPU_SCOPES pairs per region
+	CommandQueue m_CmdQueue = 0;
+	ProfilingScope m_Timestamps = 0;
+	uint64_t m_Frequencies[2] = { 0, 0 };
+	std::vector<FrameRegion> m_Regions;
+	uint32_t m_CurrentRegion = 0;
+	bool m_Enabled = false;
+	bool m_RequestedEnabled = false;
+
+	// Scopes opened so far, UINT32_MAX for the ones that didn't fit in the region
+	std::vector<uint32_t> m_OpenScopes;
+
+	// Stats
+	std::map<std::string, ScopeHistory> m_GPUStats;
+	std::map<std::string, ScopeHistory> m_CPUStats;
+	std::vector<TraceEvent> m_LastGPUFrame;
+
+	// Trace capture
+	std::string m_CapturePath = "";
+	uint32_t m_CaptureFramesLeft = 0;
+	std::vector<TraceEvent> m_CaptureEvents;
+
+	// Scratch memory
+	std::vector<uint64_t> m_Ticks;
+	std::vector<TraceEvent> m_CPUEvents;
+};
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// SDK includes
+#include "graphics/descriptors.h"
+#include "graphics/types.h"
+#include "tools/tlsf_allocator.h"
+
+// System includes
+#include <functional>
+#include <string>
+#include <vector>
+
+// Handles of the resources and passes of a render graph
+typedef uint32_t RGResource;
+typedef uint32_t RGPass;
+#define RG_INVALID UINT32_MAX
+
+// With asynchronous compute the direct work of a frame is split around the two cross-queue synchronizations:
+// the passes the compute work depends on, the passes that overlap with it and the passes that consume its results.
+#define RG_NUM_DIRECT_SEGMENTS 3
+#define RG_COMPUTE_SEGMENT RG_NUM_DIRECT_SEGMENTS
+
+// Command buffers of a frame, the first direct one is expected to be open when the graph is executed
+struct RGCommandBuffers
+{
+	CommandBuffer direct[RG_NUM_DIRECT_SEGMENTS] = { 0, 0, 0 };
+	CommandBuffer compute = 0;
+};
+
+// How a pass accesses a resource. The state transitions are done by the backend when the resources are bound,
+// the graph only has to take care of the hazards between two unordered accesses.
+enum class RGAccess
+{
+	Read = 0,
+	UnorderedAccess,
+	RenderTarget
+};
+
+// Frame graph rebuilt every frame: passes declare what they read and write, compile() culls the passes that don't contribute
+// to an output, derives the UAV barriers needed between the passes and places the transient buffers and render textures in a single
+// heap, where the ones that are never alive at the same time share byte ranges whatever their type or stride.
+// compile() only works on the declarations and doesn't touch the GPU.
+class RenderGraph
+{
+public:
+	// Cst & Dst
+	RenderGraph();
+	~RenderGraph();
+
+	// Initialization and release, the transient resources and heaps a frame replaces are only destroyed after numFramesInFlight executions
+	void initialize(GraphicsDevice device, uint32_t numFramesInFlight);
+	void release();
+
+	// Declaration, every pass is recorded inside a section named after it so its callback doesn't open one itself
+	void reset();
+	RGResource import_buffer(const char* name, GraphicsBuffer buffer);
+	RGResource import_render_texture(const char* name, RenderTexture renderTexture);
+	RGResource create_transient_buffer(const char* name, uint64_t bufferSize, uint32_t elementSize, uint32_t bufferFlags = 0);
+	RGResource create_transient_render_texture(const char* name, const TextureDescriptor& rtDesc);
+	RGPass add_pass(const char* name, const std::function<void(CommandBuffer)>& execute);
+	void read(RGPass pass, RGResource resource);
+	void write(RGPass pass, RGResource resource, RGAccess access = RGAccess::UnorderedAccess);
+
+	// Resources consumed outside of the graph (swap chain, readbacks, ...) and passes that can't be culled
+	void mark_output(RGResource resource);
+	void set_side_effects(RGPass pass);
+
+	// Passes that can run on the compute queue, they only do so if asynchronous compute is enabled
+	void set_async_compute(RGPass pass);
+	void enable_async_compute(bool state) { m_AsyncEnabled = state; }
+
+	// Culling, transient placement and barrier derivation
+	void compile();
+
+	// Records the passes that survived the compilation in a single command buffer
+	void execute(CommandBuffer cmd);
+
+	// Records the passes on the direct and compute queues, the command buffers before the last synchronization are submitted
+	// to the queue. Returns the command buffer the frame continues on, it is left open.
+	CommandBuffer execute(CommandQueue cmdQ, const RGCommandBuffers& cmdBuffers);
+
+	// Physical resources, the transient ones are only valid once the graph has been executed
+	GraphicsBuffer buffer(RGResource resource) const;
+	RenderTexture render_texture(RGResource resource) const;
+
+	// Compilation results
+	bool pass_culled(RGPass pass) const { return m_Passes[pass].culled; }
+	const std::vector<RGResource>& pass_barriers(RGPass pass) const { return m_Passes[pass].barriers; }
+	const std::vector<RGResource>& pass_activations(RGPass pass) const { return m_Passes[pass].activations; }
+	const std::vector<RGResource>& frame_activations() const { return m_FrameActivations; }
+	uint64_t transient_offset(RGResource resource) const { return m_Resources[resource].heapOffset; }
+	uint64_t transient_footprint(RGResource resource) const { return m_Resources[resource].footprint; }
+	uint64_t transient_memory() const { return m_TransientMemory; }
+	bool async_active() const { return m_AsyncActive; }
+	uint32_t pass_segment(RGPass pass) const { return m_Passes[pass].segment; }
+
+private:
+	enum class ResourceType
+	{
+		Buffer = 0,
+		RenderTexture
+	};
+
+	struct Resource
+	{
+		std::string name = "";
+		ResourceType type = ResourceType::Buffer;
+		bool transient = false;
+		uint64_t handle = 0;
+
+		// Description of the transient resources and the memory they need in the heap
+		uint64_t bufferSize = 0;
+		uint32_t elementSize = 0;
+		uint32_t bufferFlags = 0;
+		TextureDescriptor textureDesc;
+		uint64_t footprint = 0;
+		uint64_t alignment = 0;
+
+		// Compilation state
+		bool output = false;
+		uint32_t firstPass = UINT32_MAX;
+		uint32_t lastPass = 0;
+		uint64_t heapOffset = UINT64_MAX;
+	};
+
+	struct Access
+	{
+		RGResource resource = RG_INVALID;
+		RGAccess access = RGAccess::Read;
+	};
+
+	struct Pass
+	{
+		std::string name = "";
+		std::function<void(CommandBuffer)> execute;
+		std::vector<Access> accesses;
+		bool sideEffects = false;
+		bool asyncCompute = false;
+
+		// Compilation state
+		bool culled = false;
+		uint32_t segment = 0;
+		std::vector<RGResource> barriers;
+		std::vector<RGResource> activations;
+	};
+
+	// Resource placed in the transient heap, kept for the next frames as long as a transient with the same description lands at its offset
+	struct PlacedResource
+	{
+		ResourceType type = ResourceType::Buffer;
+		uint64_t handle = 0;
+		uint64_t heapOffset = 0;
+		uint64_t bufferSize = 0;
+		uint32_t elementSize = 0;
+		uint32_t bufferFlags = 0;
+		TextureDescriptor textureDesc;
+		bool used = false;
+	};
+
+	// Resource or heap that may still be used by a frame in flight
+	struct RetiredResource
+	{
+		ResourceType type = ResourceType::Buffer;
+		uint64_t handle = 0;
+		uint32_t framesLeft = 0;
+	};
+
+	struct RetiredHeap
+	{
+		TransientHeap heap = 0;
+		uint32_t framesLeft = 0;
+	};
+
+private:
+	void cull_passes();
+	void alias_transients();
+	void schedule_queues();
+	void derive_barriers();
+	void derive_activations();
+	void allocate_transients();
+	bool matches(const PlacedResource& placed, const Resource& resource) const;
+	void retire(const PlacedResource& placed);
+	void destroy(ResourceType type, uint64_t handle);
+	void record_activations(const std::vector<RGResource>& resources, CommandBuffer cmd);
+	void record_pass(const Pass& pass, CommandBuffer cmd);
+	void prepare_compute_resources(CommandBuffer cmd);
+	uint64_t physical_key(RGResource resource) const;
+	bool passes_conflict(const Pass& passA, const Pass& passB) const;
+
+private:
+	// Device used for the transient allocations
+	GraphicsDevice m_Device = 0;
+	uint32_t m_NumFramesInFlight = 0;
+
+	// Declarations of the current frame
+	std::vector<Resource> m_Resources;
+	std::vector<Pass> m_Passes;
+	bool m_Compiled = false;
+
+	// Asynchronous compute
+	bool m_AsyncEnabled = false;
+	bool m_AsyncActive = false;
+	Fence m_SyncFence = 0;
+	uint64_t m_SyncValue = 0;
+
+	// Transient memory, the offsets are picked by replaying the lifetimes on the allocator
+	TLSFAllocator m_Allocator;
+	uint64_t m_TransientMemory = 0;
+	TransientHeap m_Heap = 0;
+	uint64_t m_HeapSize = 0;
+	std::vector<PlacedResource> m_PlacedResources;
+	std::vector<RetiredResource> m_RetiredResources;
+	std::vector<RetiredHeap> m_RetiredHeaps;
+
+	// Transients activated before the first pass, the ones first used on the compute queue
+	std::vector<RGResource> m_FrameActivations;
+
+	// Scratch memory for the barriers
+	std::vector<GraphicsBuffer> m_BarrierBuffers;
+	std::vector<RenderTexture> m_BarrierTextures;
+};
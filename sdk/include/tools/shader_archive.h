@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A single kernel compiled with a given set of defines and arguments
+struct ShaderPermutation
+{
+	// Path of the shader file relative to the shader directory
+	std::string filename = "";
+
+	// Entry point and target profile
+	std::string kernel = "";
+	std::string profile = "";
+
+	// Defines, either NAME or NAME=VALUE
+	std::vector<std::string> defines;
+
+	// Compiler arguments, the include directories are not part of it
+	std::vector<std::string> arguments;
+};
+
+namespace shader_archive
+{
+	// Key of a permutation. It doesn't depend on the order of the defines and arguments nor on the location of the shader directory.
+	uint64_t permutation_key(const ShaderPermutation& permutation);
+
+	// Shader path relative to the shader directory in the form used by the keys, empty if the file is outside of the directory
+	std::string relative_path(const std::string& filename, const std::string& shaderDirectory);
+
+	// Parses a permutation manifest and expands every declared shader into the list of its permutations.
+	// ${NAME} references are replaced by the variables, the ones declared in the manifest are only used when missing from the map.
+	bool parse_manifest(const std::string& manifestPath, std::map<std::string, std::string>& variables, std::vector<ShaderPermutation>& outPermutations);
+
+	// Writes an archive from a set of compiled permutations
+	bool write(const std::string& archivePath, const std::vector<uint64_t>& keys, const std::vector<std::vector<char>>& binaries);
+
+	// Loads an archive for the runtime lookups, the shader directory is used to evaluate the relative paths
+	bool initialize(const std::string& archivePath, const std::string& shaderDirectory);
+	void release();
+	bool active();
+
+	// Runtime lookup, the returned pointer stays valid until the archive is released
+	bool find(const std::string& filename, const std::string& kernel, const std::string& profile,
+				const std::vector<std::string>& defines, const std::vector<std::string>& arguments, const char*& outData, uint64_t& outSize);
+}
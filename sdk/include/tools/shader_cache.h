@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Initial value of the hashes
+#define SHADER_CACHE_HASH_SEED 0xcbf29ce484222325ull
+
+namespace shader_cache
+{
+	// Enables the on-disk DXIL cache in a given directory, the least recently used entries are evicted when maxCacheSize (in bytes) is exceeded.
+	// The directory can be shared by concurrent processes.
+	void initialize(const std::string& cacheDirectory, uint64_t maxCacheSize);
+	void release();
+	bool enabled();
+
+	// Hashing (FNV-1a 64)
+	uint64_t hash_bytes(const void* data, uint64_t size, uint64_t seed = SHADER_CACHE_HASH_SEED);
+	uint64_t hash_string(const std::string& str, uint64_t seed = SHADER_CACHE_HASH_SEED);
+	uint64_t hash_wstring(const std::wstring& str, uint64_t seed = SHADER_CACHE_HASH_SEED);
+
+	// Hash of a source file combined with the hashes of all its transitive includes.
+	// Includes are resolved against the directory of the including file first, then against the include directories.
+	// The per file hashes and include lists are kept in a manifest that is only refreshed when a file is modified.
+	uint64_t hash_source_tree(const std::string& filename, const std::vector<std::string>& includeDirectories);
+
+	// Transitive includes of a source file as resolved for the hash
+	void source_dependencies(const std::string& filename, const std::vector<std::string>& includeDirectories, std::vector<std::string>& outDependencies);
+
+	// Fetch a binary from the cache, returns false on a miss
+	bool load(uint64_t key, std::vector<char>& outBinary);
+
+	// Adds a binary to the cache
+	void store(uint64_t key, const void* data, uint64_t size);
+}
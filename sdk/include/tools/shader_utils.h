@@ -10,8 +10,90 @@
 // SDK includes
 #include "graphics/descriptors.h"
 
+// System includes
+#include <string>
+#include <vector>
+
 // Compile a shader and replace if succeded
 void compile_and_replace_compute_shader(GraphicsDevice device, const ComputeShaderDescriptor& csd, ComputeShader& oldCS, bool experimental = false);
 
 // Compile a graphics pipeline and replace if succeded
-void compile_and_replace_graphics_pipeline(GraphicsDevice device, const GraphicsPipelineDescriptor& gpd, GraphicsPipeline& oldGP);
\ No newline at end of file
+void compile_and_replace_graphics_pipeline(GraphicsDevice device, const GraphicsPipelineDescriptor& gpd, GraphicsPipeline& oldGP);
+
+// Functions a batch creates, destroys and tracks its shaders with, those of the graphics backend by default
+struct ShaderCompiler
+{
+	ComputeShader (*create_compute_shader)(GraphicsDevice device, const ComputeShaderDescriptor& csd, bool experimental) = nullptr;
+	void (*destroy_compute_shader)(ComputeShader computeShader) = nullptr;
+	const std::vector<std::string>& (*compute_shader_dependencies)(ComputeShader computeShader) = nullptr;
+	GraphicsPipeline (*create_graphics_pipeline)(GraphicsDevice device, const GraphicsPipelineDescriptor& gpd) = nullptr;
+	void (*destroy_graphics_pipeline)(GraphicsPipeline graphicsPipeline) = nullptr;
+	const std::vector<std::string>& (*graphics_pipeline_dependencies)(GraphicsPipeline graphicsPipeline) = nullptr;
+};
+
+// Compiler of the current graphics backend
+ShaderCompiler backend_shader_compiler();
+
+// Timings of an executed batch
+struct ShaderCompileReport
+{
+	uint32_t numShaders = 0;
+	uint32_t numFailed = 0;
+	uint32_t numThreads = 0;
+
+	// Wall time of the batch and sum of the compile times of its shaders
+	double durationMS = 0.0;
+	double compileDurationMS = 0.0;
+};
+
+// Set of shaders that are compiled in parallel and replaced all at once
+class ShaderCompileBatch
+{
+public:
+	// Cst & Dst
+	ShaderCompileBatch();
+	ShaderCompileBatch(const ShaderCompiler& compiler);
+	~ShaderCompileBatch();
+
+	// Register the shaders to compile, the targets must stay valid until the batch is executed
+	void add_compute_shader(const ComputeShaderDescriptor& csd, ComputeShader& target, bool experimental = false);
+	void add_graphics_pipeline(const GraphicsPipelineDescriptor& gpd, GraphicsPipeline& target);
+
+	// Defines appended to every compute shader registered afterwards
+	void set_compute_defines(const std::vector<std::string>& defines) { m_ComputeDefines = defines; }
+
+	// Compiles all the registered shaders in parallel. If everything compiled, all the targets are replaced,
+	// otherwise the previous ones are kept so that the renderer never runs with a partially updated set.
+	// When changedFiles is provided, existing targets that don't depend on any of these files are left untouched.
+	bool execute(GraphicsDevice device, const std::vector<std::string>* changedFiles = nullptr);
+
+	// Clear the registered shaders
+	void clear();
+
+	// Timings of the last execution
+	const ShaderCompileReport& report() const { return m_Report; }
+
+private:
+	struct ComputeShaderJob
+	{
+		ComputeShaderDescriptor descriptor;
+		ComputeShader* target = nullptr;
+		bool experimental = false;
+		ComputeShader result = 0;
+		double durationMS = 0.0;
+	};
+
+	struct GraphicsPipelineJob
+	{
+		GraphicsPipelineDescriptor descriptor;
+		GraphicsPipeline* target = nullptr;
+		GraphicsPipeline result = 0;
+		double durationMS = 0.0;
+	};
+
+	std::vector<ComputeShaderJob> m_ComputeJobs;
+	std::vector<GraphicsPipelineJob> m_GraphicsJobs;
+	std::vector<std::string> m_ComputeDefines;
+	ShaderCompiler m_Compiler;
+	ShaderCompileReport m_Report;
+};
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+// The producer and consumer indices live on separate cache lines
+#define SPSC_QUEUE_CACHE_LINE 64
+
+// Bounded lock free queue between exactly one producer thread and one consumer thread.
+// The capacity is rounded up to a power of two. push fails when the queue is full, pop when it is empty; neither of them blocks.
+// Each side keeps a copy of the other side's index and only reloads it when the queue looks full (or empty).
+template<typename T>
+class SPSCQueue
+{
+public:
+	// Cst & Dst
+	explicit SPSCQueue(uint32_t capacity);
+	~SPSCQueue();
+
+	// Producer side
+	bool push(const T& value);
+
+	// Consumer side
+	bool pop(T& value);
+
+	// Approximate when called while the other thread is running
+	uint32_t size() const;
+	uint32_t capacity() const { return m_Capacity; }
+
+	// Consumer side, only while nothing is pushed
+	void clear();
+
+private:
+	// Storage
+	std::vector<T> m_Buffer;
+	uint32_t m_Capacity = 0;
+	uint32_t m_Mask = 0;
+
+	// Consumer: next element to pop and last tail it observed
+	alignas(SPSC_QUEUE_CACHE_LINE) std::atomic<uint32_t> m_Head;
+	uint32_t m_CachedTail = 0;
+
+	// Producer: next element to push and last head it observed
+	alignas(SPSC_QUEUE_CACHE_LINE) std::atomic<uint32_t> m_Tail;
+	uint32_t m_CachedHead = 0;
+};
+
+#include "spsc_queue.inl"
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+template<typename T>
+SPSCQueue<T>::SPSCQueue(uint32_t capacity)
+	: m_Head(0)
+	, m_Tail(0)
+{
+	m_Capacity = 1;
+	while (m_Capacity < capacity)
+		m_Capacity <<= 1;
+	m_Mask = m_Capacity - 1;
+	m_Buffer.resize(m_Capacity);
+}
+
+template<typename T>
+SPSCQueue<T>::~SPSCQueue()
+{
+}
+
+template<typename T>
+bool SPSCQueue<T>::push(const T& value)
+{
+	// The indices wrap around 2^32, their difference is the number of elements
+	const uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+	if (tail - m_CachedHead == m_Capacity)
+	{
+		m_CachedHead = m_Head.load(std::memory_order_acquire);
+		if (tail - m_CachedHead == m_Capacity)
+			return false;
+	}
+
+	// Publish the element with the new tail
+	m_Buffer[tail & m_Mask] = value;
+	m_Tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+bool SPSCQueue<T>::pop(T& value)
+{
+	const uint32_t head = m_Head.load(std::memory_order_relaxed);
+	if (head == m_CachedTail)
+	{
+		m_CachedTail = m_Tail.load(std::memory_order_acquire);
+		if (head == m_CachedTail)
+			return false;
+	}
+
+	// Hand the slot back to the producer once it has been read
+	value = m_Buffer[head & m_Mask];
+	m_Head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+uint32_t SPSCQueue<T>::size() const
+{
+	// The head is read first, the tail can only be ahead of it
+	const uint32_t head = m_Head.load(std::memory_order_acquire);
+	return m_Tail.load(std::memory_order_acquire) - head;
+}
+
+template<typename T>
+void SPSCQueue<T>::clear()
+{
+	m_CachedTail = m_Tail.load(std::memory_order_acquire);
+	m_Head.store(m_CachedTail, std::memory_order_release);
+}
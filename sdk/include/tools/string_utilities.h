@@ -18,6 +18,9 @@ std::wstring convert_to_wide(const char* str, uint32_t strLength);
 std::string convert_to_regular(const std::wstring& str);
 void split(const std::string& parString, char parSeparator, std::vector<std::string>& _out);
 
+// Quoted and escaped for a JSON document, the control characters are written as \u escapes
+std::string to_json_string(const std::string& str);
+
 template <typename T>
 T convert_from_string(const std::string& _string)
 {
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <atomic>
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+// Set of tasks that can be waited on as a whole
+struct TaskGroup
+{
+	// Number of tasks that have been spawned and not completed yet
+	std::atomic<uint32_t> pending = 0;
+
+	// Only used by the groups created for a continuation, released by their last task
+	std::function<void()> continuation;
+	TaskGroup* successor = nullptr;
+};
+
+namespace task_scheduler
+{
+	// Creates the worker pool, 0 means one worker per hardware thread minus the calling thread.
+	// The calling thread is registered as the main thread and has its own deque.
+	void initialize(uint32_t numWorkers = 0);
+	void release();
+
+	// Number of threads that execute tasks (workers + main thread)
+	uint32_t num_threads();
+
+	// Index of the calling thread in [0, num_threads()), UINT32_MAX if the thread is foreign to the scheduler
+	uint32_t thread_index();
+
+	// Spawns a task in a group
+	void run(TaskGroup& group, const std::function<void()>& task);
+
+	// Spawns a set of tasks and a continuation that is spawned in the successor group once all of them have completed.
+	// The successor is considered busy until the continuation is done.
+	void run_with_continuation(TaskGroup& successor, const std::vector<std::function<void()>>& tasks, const std::function<void()>& continuation);
+
+	// Waits for all the tasks of a group, the calling thread helps executing pending tasks in the meantime
+	void wait(TaskGroup& group);
+
+	// Splits [begin, end) in ranges of at least minGrain elements and processes them in parallel.
+	// The grain adapts to the number of threads so that each of them gets a few ranges to balance the load.
+	void parallel_for(uint32_t begin, uint32_t end, const std::function<void(uint32_t first, uint32_t last)>& func, uint32_t minGrain = 1);
+}
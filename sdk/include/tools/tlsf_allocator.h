@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+// System includes
+#include <stdint.h>
+#include <vector>
+
+// Handle returned when an allocation can't be satisfied
+#define TLSF_INVALID_ALLOCATION UINT32_MAX
+
+// Second level subdivision of every power of two range
+#define TLSF_SL_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_COUNT 64
+
+// Occupancy of an allocator
+struct TLSFStats
+{
+	uint64_t capacity = 0;
+	uint64_t usedBytes = 0;
+	uint64_t peakBytes = 0;
+	uint64_t largestFreeBlock = 0;
+	uint32_t liveAllocations = 0;
+	uint32_t freeBlocks = 0;
+
+	// 0 when all the free space is contiguous, tends to 1 when it's scattered in small blocks
+	float fragmentation = 0.0f;
+};
+
+// Two-level segregated fit allocator over an abstract range of memory (offsets only, it never touches the memory).
+// Allocations and releases are O(1), sizes are rounded up to the granularity and every offset is a multiple of it.
+class TLSFAllocator
+{
+public:
+	// Cst & Dst
+	TLSFAllocator();
+	~TLSFAllocator();
+
+	// Initialization and release, granularity needs to be a power of two
+	void initialize(uint64_t capacity, uint64_t granularity);
+	void release();
+
+	// Returns the handle of the allocation or TLSF_INVALID_ALLOCATION if no free block is big enough
+	uint32_t allocate(uint64_t size, uint64_t& outOffset);
+	void free(uint32_t allocation);
+
+	// Stats
+	TLSFStats stats() const;
+	uint64_t capacity() const { return m_Capacity; }
+	uint64_t granularity() const { return m_Granularity; }
+	bool empty() const { return m_LiveAllocations == 0; }
+
+private:
+	struct Block
+	{
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		bool free = false;
+
+		// Neighbours in memory
+		uint32_t prevPhysical = TLSF_INVALID_ALLOCATION;
+		uint32_t nextPhysical = TLSF_INVALID_ALLOCATION;
+
+		// Neighbours in the free list of the block's size class
+		uint32_t prevFree = TLSF_INVALID_ALLOCATION;
+		uint32_t nextFree = TLSF_INVALID_ALLOCATION;
+	};
+
+private:
+	void mapping(uint64_t units, uint32_t& fl, uint32_t& sl) const;
+	uint32_t find_free_block(uint64_t units) const;
+	void insert_free_block(uint32_t blockIdx);
+	void remove_free_block(uint32_t blockIdx);
+	uint32_t new_block();
+	void delete_block(uint32_t blockIdx);
+
+private:
+	uint64_t m_Capacity = 0;
+	uint64_t m_Granularity = 0;
+	uint32_t m_GranularityLog2 = 0;
+
+	// Blocks, the released entries are recycled
+	std::vector<Block> m_Blocks;
+	std::vector<uint32_t> m_UnusedBlocks;
+
+	// Free lists and the bitmaps of the non empty ones
+	uint64_t m_FLBitmap = 0;
+	uint32_t m_SLBitmaps[TLSF_FL_COUNT] = {};
+	uint32_t m_FreeHeads[TLSF_FL_COUNT][TLSF_SL_COUNT] = {};
+
+	// Stats
+	uint64_t m_UsedBytes = 0;
+	uint64_t m_PeakBytes = 0;
+	uint32_t m_LiveAllocations = 0;
+};
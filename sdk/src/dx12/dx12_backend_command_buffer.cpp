@@ -222,6 +222,15 @@ namespace d3d12
 			resourceState = targetState;
 		}
 
+		void initialize_texture(DX12CommandBuffer* commandBuffer, DX12Texture* texture)
+		{
+			// Only done once, while the resource is still in the state it was created in. Copy queues can't discard.
+			if (!texture->needsInit || commandBuffer->type == D3D12_COMMAND_LIST_TYPE_COPY)
+				return;
+			commandBuffer->cmdList()->DiscardResource(texture->resource, nullptr);
+			texture->needsInit = false;
+		}
+
 		void uav_barrier_buffer(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer)
 		{
 			// Cast opaque structures
@@ -262,6 +271,78 @@ namespace d3d12
 			uav_barrier_texture(commandBuffer, (Texture)&(dx12_rTex->texture));
 		}
 
+		void uav_barriers(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures)
+		{
+			// Cast opaque structures
+			DX12CommandBuffer* dx12_cmdB = safe_convert<DX12CommandBuffer>(commandBuffer);
+
+			// Only the resources that are still in unordered access need a barrier
+			std::vector<D3D12_RESOURCE_BARRIER> barriers;
+			barriers.reserve(numBuffers + numRenderTextures);
+			D3D12_RESOURCE_BARRIER barrier = {};
+			barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+			barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+			for (uint32_t bufferIdx = 0; bufferIdx < numBuffers; ++bufferIdx)
+			{
+				DX12GraphicsBuffer* dx12_buffer = safe_convert<DX12GraphicsBuffer>(buffers[bufferIdx]);
+				if (dx12_buffer->state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS || dx12_buffer->state == D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE)
+				{
+					barrier.UAV.pResource = dx12_buffer->resource;
+					barriers.push_back(barrier);
+				}
+			}
+			for (uint32_t texIdx = 0; texIdx < numRenderTextures; ++texIdx)
+			{
+				DX12RenderTexture* dx12_rTex = safe_convert<DX12RenderTexture>(renderTextures[texIdx]);
+				if (dx12_rTex->texture.state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+				{
+					barrier.UAV.pResource = dx12_rTex->texture.resource;
+					barriers.push_back(barrier);
+				}
+			}
+
+			// Submit them all at once
+			if (barriers.size() > 0)
+				dx12_cmdB->cmdList()->ResourceBarrier((uint32_t)barriers.size(), barriers.data());
+		}
+
+		void aliasing_barriers(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures)
+		{
+			// Cast opaque structures
+			DX12CommandBuffer* dx12_cmdB = safe_convert<DX12CommandBuffer>(commandBuffer);
+
+			// Any resource of the heap may have been using the memory before
+			std::vector<D3D12_RESOURCE_BARRIER> barriers;
+			barriers.reserve(numBuffers + numRenderTextures);
+			D3D12_RESOURCE_BARRIER barrier = {};
+			barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+			barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+			barrier.Aliasing.pResourceBefore = nullptr;
+			for (uint32_t bufferIdx = 0; bufferIdx < numBuffers; ++bufferIdx)
+			{
+				barrier.Aliasing.pResourceAfter = safe_convert<DX12GraphicsBuffer>(buffers[bufferIdx])->resource;
+				barriers.push_back(barrier);
+			}
+			for (uint32_t texIdx = 0; texIdx < numRenderTextures; ++texIdx)
+			{
+				barrier.Aliasing.pResourceAfter = safe_convert<DX12RenderTexture>(renderTextures[texIdx])->texture.resource;
+				barriers.push_back(barrier);
+			}
+			if (barriers.size() > 0)
+				dx12_cmdB->cmdList()->ResourceBarrier((uint32_t)barriers.size(), barriers.data());
+
+			// The metadata of the render and depth targets is undefined after the switch, they are discarded in their write state
+			for (uint32_t texIdx = 0; texIdx < numRenderTextures; ++texIdx)
+			{
+				DX12Texture* texture = &safe_convert<DX12RenderTexture>(renderTextures[texIdx])->texture;
+				const bool isUAV = (texture->resource->GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) != 0;
+				const D3D12_RESOURCE_STATES writeState = isUAV ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : (texture->isDepth ? D3D12_RESOURCE_STATE_DEPTH_WRITE : D3D12_RESOURCE_STATE_RENDER_TARGET);
+				direct_change_resource_state(dx12_cmdB, texture->resource, texture->state, writeState);
+				texture->needsInit = true;
+				initialize_texture(dx12_cmdB, texture);
+			}
+		}
+
 		void transition_to_common(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer)
 		{
 			// Cast opaque structures
@@ -309,9 +390,37 @@ namespace d3d12
 			DX12RenderTexture* dx12_renderTexture = safe_convert<DX12RenderTexture>(renderTexture);
 
 			// Make sure the state is the right one
+			initialize_texture(dx12_cmdB, &dx12_renderTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_renderTexture->texture.resource, dx12_renderTexture->texture.state, D3D12_RESOURCE_STATE_PRESENT);
 		}
 
+		void transition_for_compute_queue(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures, bool unorderedAccess)
+		{
+			// Cast opaque structures
+			DX12CommandBuffer* dx12_cmdB = safe_convert<DX12CommandBuffer>(commandBuffer);
+
+			// Compute command lists can't leave graphics only states (render target, depth, ...), move the resources to the states
+			// the compute shader bindings expect while still on the direct queue.
+			D3D12_RESOURCE_STATES targetState = unorderedAccess ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : D3D12_RESOURCE_STATE_COMMON;
+			std::vector<D3D12_RESOURCE_BARRIER> barriers;
+			barriers.reserve(numBuffers + numRenderTextures);
+			for (uint32_t bufferIdx = 0; bufferIdx < numBuffers; ++bufferIdx)
+			{
+				DX12GraphicsBuffer* dx12_buffer = safe_convert<DX12GraphicsBuffer>(buffers[bufferIdx]);
+				async_change_resource_state(barriers, dx12_buffer->resource, dx12_buffer->state, targetState);
+			}
+			for (uint32_t texIdx = 0; texIdx < numRenderTextures; ++texIdx)
+			{
+				DX12RenderTexture* dx12_rTex = safe_convert<DX12RenderTexture>(renderTextures[texIdx]);
+				initialize_texture(dx12_cmdB, &dx12_rTex->texture);
+				async_change_resource_state(barriers, dx12_rTex->texture.resource, dx12_rTex->texture.state, targetState);
+			}
+
+			// Submit them all at once
+			if (barriers.size() > 0)
+				dx12_cmdB->cmdList()->ResourceBarrier((uint32_t)barriers.size(), barriers.data());
+		}
+
 		CommandBuffer create_command_buffer(GraphicsDevice graphicsDevice, CommandBufferType commandBufferType)
 		{
 			// Grab the graphics device
@@ -343,6 +452,9 @@ namespace d3d12
 			// Convert to the internal structure
 			DX12CommandBuffer* dx12_cmdB = safe_convert<DX12CommandBuffer>(commandBuffer);
 
+			// Give back the descriptor blocks of a recording that was never executed
+			submit_descriptor_tables(dx12_cmdB, DESCRIPTOR_RING_NO_TIMELINE, 0);
+
 			for (uint32_t cmdIdx = 0; cmdIdx < DX12_NUM_FRAMES; ++cmdIdx)
 			{
 				// Release the command list
@@ -359,6 +471,11 @@ namespace d3d12
 		void reset(CommandBuffer commandBuffer)
 		{
 			DX12CommandBuffer* dx12_cmdB = safe_convert<DX12CommandBuffer>(commandBuffer);
+
+			// Give back the descriptor blocks of a recording that was never executed and recycle the ones the GPU is done with
+			submit_descriptor_tables(dx12_cmdB, DESCRIPTOR_RING_NO_TIMELINE, 0);
+			retire_descriptor_tables(dx12_cmdB->deviceI);
+
 			dx12_cmdB->frameIdx++;
 			dx12_cmdB->cmdAlloc()->Reset();
 			dx12_cmdB->cmdList()->Reset(dx12_cmdB->cmdAlloc(), nullptr);
@@ -370,6 +487,16 @@ namespace d3d12
 			dx12_cmdB->cmdList()->Close();
 		}
 
+		CommandBufferType command_buffer_type(CommandBuffer commandBuffer)
+		{
+			DX12CommandBuffer* dx12_cmdB = safe_convert<DX12CommandBuffer>(commandBuffer);
+			if (dx12_cmdB->type == D3D12_COMMAND_LIST_TYPE_COMPUTE)
+				return CommandBufferType::Compute;
+			else if (dx12_cmdB->type == D3D12_COMMAND_LIST_TYPE_COPY)
+				return CommandBufferType::Copy;
+			return CommandBufferType::Default;
+		}
+
 		void set_render_texture(CommandBuffer commandBuffer, RenderTexture renderTexture)
 		{
 			// Cast opaque structures
@@ -380,6 +507,7 @@ namespace d3d12
 			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(dx12_renderTexture->descriptorHeap->GetCPUDescriptorHandleForHeapStart());
 			rtvHandle.ptr += dx12_renderTexture->heapOffset;
 
+			initialize_texture(dx12_cmdB, &dx12_renderTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_renderTexture->texture.resource, dx12_renderTexture->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET);
 
 			// Set the render target and the current one
@@ -400,6 +528,8 @@ namespace d3d12
 			depthvHandle.ptr += dx12_depthTexture->heapOffset;
 
 			// Flush the two barriers
+			initialize_texture(dx12_cmdB, &dx12_renderTexture->texture);
+			initialize_texture(dx12_cmdB, &dx12_depthTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_renderTexture->texture.resource, dx12_renderTexture->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET,
 				dx12_depthTexture->texture.resource, dx12_depthTexture->texture.state, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
@@ -425,6 +555,9 @@ namespace d3d12
 			depthvHandle.ptr += dx12_depthTexture->heapOffset;
 
 			// Flush the two barriers
+			initialize_texture(dx12_cmdB, &dx12_renderTexture0->texture);
+			initialize_texture(dx12_cmdB, &dx12_renderTexture1->texture);
+			initialize_texture(dx12_cmdB, &dx12_depthTexture->texture);
 			direct_change_resource_state(dx12_cmdB,
 				dx12_renderTexture0->texture.resource, dx12_renderTexture0->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET,
 				dx12_renderTexture1->texture.resource, dx12_renderTexture1->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET,
@@ -455,6 +588,10 @@ namespace d3d12
 			depthvHandle.ptr += dx12_depthTexture->heapOffset;
 
 			// Flush the two barriers
+			initialize_texture(dx12_cmdB, &dx12_renderTexture0->texture);
+			initialize_texture(dx12_cmdB, &dx12_renderTexture1->texture);
+			initialize_texture(dx12_cmdB, &dx12_renderTexture2->texture);
+			initialize_texture(dx12_cmdB, &dx12_depthTexture->texture);
 			direct_change_resource_state(dx12_cmdB,
 				dx12_renderTexture0->texture.resource, dx12_renderTexture0->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET,
 				dx12_renderTexture1->texture.resource, dx12_renderTexture1->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET,
@@ -476,6 +613,7 @@ namespace d3d12
 			rtvHandle.ptr += dx12_renderTexture->heapOffset;
 
 			// Make sure the state is the right one
+			initialize_texture(dx12_cmdB, &dx12_renderTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_renderTexture->texture.resource, dx12_renderTexture->texture.state, D3D12_RESOURCE_STATE_RENDER_TARGET);
 
 			// Clear with the color
@@ -493,6 +631,7 @@ namespace d3d12
 			rtvHandle.ptr += dx12_depthTexture->heapOffset;
 
 			// Make sure the state is the right one
+			initialize_texture(dx12_cmdB, &dx12_depthTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_depthTexture->texture.resource, dx12_depthTexture->texture.state, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
 			// Clear with the color
@@ -510,6 +649,7 @@ namespace d3d12
 			rtvHandle.ptr += dx12_depthTexture->heapOffset;
 
 			// Make sure the state is the right one
+			initialize_texture(dx12_cmdB, &dx12_depthTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_depthTexture->texture.resource, dx12_depthTexture->texture.state, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
 			// Clear with the color
@@ -527,6 +667,7 @@ namespace d3d12
 			rtvHandle.ptr += dx12_stencilTexture->heapOffset;
 
 			// Make sure the state is the right one
+			initialize_texture(dx12_cmdB, &dx12_stencilTexture->texture);
 			direct_change_resource_state(dx12_cmdB, dx12_stencilTexture->texture.resource, dx12_stencilTexture->texture.state, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
 			// Clear with the color
@@ -655,6 +796,8 @@ namespace d3d12
 			DX12RenderTexture* dx12_outputTex = (DX12RenderTexture*)outputTexture;
 
 			// Run the barriers
+			initialize_texture(dx12_commandBuffer, &dx12_inputTex->texture);
+			initialize_texture(dx12_commandBuffer, &dx12_outputTex->texture);
 			direct_change_resource_state(dx12_commandBuffer, dx12_inputTex->texture.resource, dx12_inputTex->texture.state, D3D12_RESOURCE_STATE_COPY_SOURCE,
 				dx12_outputTex->texture.resource, dx12_outputTex->texture.state, D3D12_RESOURCE_STATE_COPY_DEST);
 
@@ -692,6 +835,7 @@ namespace d3d12
 			uint32_t actualheight = std::max(dx12_outputTex->height >> mipIdx, 1u);
 
 			// Prepare the input buffer if needed
+			initialize_texture(dx12_commandBuffer, dx12_outputTex);
 			direct_change_resource_state(dx12_commandBuffer, dx12_inputBuffer->resource, dx12_inputBuffer->state, dx12_inputBuffer->heapType == GraphicsBufferType::Upload ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COPY_SOURCE,
 				dx12_outputTex->resource, dx12_outputTex->state, D3D12_RESOURCE_STATE_COPY_DEST);
 			D3D12_TEXTURE_COPY_LOCATION inputResourceLoc;
@@ -829,6 +973,7 @@ namespace d3d12
 			DX12GraphicsBuffer* dx12_outputBuffer = (DX12GraphicsBuffer*)outputBuffer;
 
 			// Prepare the input texture if needed
+			initialize_texture(dx12_commandBuffer, dx12_inputTex);
 			direct_change_resource_state(dx12_commandBuffer, dx12_inputTex->resource, dx12_inputTex->state, D3D12_RESOURCE_STATE_COPY_SOURCE,
 				dx12_outputBuffer->resource, dx12_outputBuffer->state, D3D12_RESOURCE_STATE_COPY_DEST);
 
@@ -884,124 +1029,108 @@ namespace d3d12
 		{
 		}
 
-		void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, ConstantBuffer constantBuffer)
+		D3D12_CPU_DESCRIPTOR_HANDLE constant_buffer_view(DX12GraphicsDevice* deviceI, DX12GraphicsBuffer* buffer)
 		{
-			// Grab all the internal structures
-			DX12CommandBuffer* dx12_commandBuffer = safe_convert<DX12CommandBuffer>(commandBuffer);
-			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
-			DX12ComputeShader* dx12_cs = safe_convert<DX12ComputeShader>(computeShader);
-			DX12ConstantBuffer* dx12_cb = safe_convert<DX12ConstantBuffer>(constantBuffer);
-			DX12GraphicsBuffer* dx12_cbGB = dx12_cb->mainBuffer;
-
-			// First we need to validate that the right heap will be used
-			validate_compute_shader_heap(dx12_cs, dx12_commandBuffer->frameIdx);
+			// Reuse the view if it was already created
+			const DX12CachedView* cachedView = find_cached_view(buffer->views, DX12ViewType::CBV, 0);
+			if (cachedView != nullptr)
+				return cachedView->handle;
 
-			// Create the view in the compute's heap
+			// Create the view in the staging heap
+			DX12CachedView view;
+			view.type = DX12ViewType::CBV;
+			view.handle = allocate_staging_descriptor(deviceI, deviceI->stagingCSU, view.slot);
 			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvView;
-			cbvView.BufferLocation = dx12_cbGB->resource->GetGPUVirtualAddress();
-			cbvView.SizeInBytes = (uint32_t)dx12_cbGB->bufferSize;
-
-			// Get the binding
-			DX12Binding bind;
-			assert_msg(request_binding(dx12_cs->bindings, name, bind), "Unexistant binding.");
-
-			// Compute the slot on the heap
-			DX12DescriptorHeap& currentHeap = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.cbvCPU);
-			rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-			// Create the CBV
-			deviceI->device->CreateConstantBufferView(&cbvView, rtvHandle);
-
-			// Change the resource's state (if this is a runtime constant buffer)
-			if (dx12_cbGB->heapType != GraphicsBufferType::Upload)
-				async_change_resource_state(dx12_cs->barriersData, dx12_cbGB->resource, dx12_cbGB->state, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+			cbvView.BufferLocation = buffer->resource->GetGPUVirtualAddress();
+			cbvView.SizeInBytes = (uint32_t)buffer->bufferSize;
+			deviceI->device->CreateConstantBufferView(&cbvView, view.handle);
+			buffer->views.push_back(view);
+			return view.handle;
 		}
 
-		void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, GraphicsBuffer graphicsBuffer)
+		D3D12_CPU_DESCRIPTOR_HANDLE buffer_view(DX12GraphicsDevice* deviceI, DX12GraphicsBuffer* buffer, DX12ViewType type, uint64_t bufferOffset)
 		{
-			// Grab all the internal structures
-			DX12CommandBuffer* dx12_commandBuffer = safe_convert<DX12CommandBuffer>(commandBuffer);
-			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
-			DX12ComputeShader* dx12_cs = safe_convert<DX12ComputeShader>(computeShader);
-			DX12GraphicsBuffer* buffer = safe_convert<DX12GraphicsBuffer>(graphicsBuffer);
-
-			// First we need to validate that the right heap will be used
-			validate_compute_shader_heap(dx12_cs, dx12_commandBuffer->frameIdx);
+			// Reuse the view if it was already created
+			const DX12CachedView* cachedView = find_cached_view(buffer->views, type, bufferOffset);
+			if (cachedView != nullptr)
+				return cachedView->handle;
 
-			// Get the binding
-			DX12Binding bind;
-			assert_msg(request_binding(dx12_cs->bindings, name, bind), "Unexistant binding.");
-			if (bind.type == 2)
+			// Create the view in the staging heap
+			DX12CachedView view;
+			view.type = type;
+			view.parameter = bufferOffset;
+			view.handle = allocate_staging_descriptor(deviceI, deviceI->stagingCSU, view.slot);
+			if (type == DX12ViewType::UAV)
 			{
-				// Create the view in the compute's heap
 				D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
 				ZeroMemory(&uavDesc, sizeof(D3D12_UNORDERED_ACCESS_VIEW_DESC));
 				uavDesc.Format = DXGI_FORMAT_UNKNOWN;
 				uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
 				D3D12_BUFFER_UAV bufferUAV;
-				bufferUAV.FirstElement = 0;
-				bufferUAV.NumElements = (uint32_t)buffer->bufferSize / (uint32_t)buffer->elementSize;
+				bufferUAV.FirstElement = bufferOffset / (uint32_t)buffer->elementSize;
+				bufferUAV.NumElements = (uint32_t)buffer->bufferSize / (uint32_t)buffer->elementSize - (uint32_t)bufferUAV.FirstElement;
 				bufferUAV.StructureByteStride = buffer->elementSize;
 				bufferUAV.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
 				bufferUAV.CounterOffsetInBytes = 0;
 				uavDesc.Buffer = bufferUAV;
-
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.uavCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-				// Create the UAV
-				deviceI->device->CreateUnorderedAccessView(buffer->resource, nullptr, &uavDesc, rtvHandle);
-
-				// Change the resource's state
-				async_change_resource_state(dx12_cs->barriersData, buffer->resource, buffer->state, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+				deviceI->device->CreateUnorderedAccessView(buffer->resource, nullptr, &uavDesc, view.handle);
 			}
 			else
 			{
-				// Create the view in the compute's heap
 				D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
 				srvDesc.Format = DXGI_FORMAT_UNKNOWN;
 				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
 				srvDesc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3);
 				D3D12_BUFFER_SRV bufferSRV;
-				bufferSRV.FirstElement = 0;
-				bufferSRV.NumElements = (uint32_t)(buffer->bufferSize / buffer->elementSize);
+				bufferSRV.FirstElement = bufferOffset / (uint32_t)buffer->elementSize;
+				bufferSRV.NumElements = (uint32_t)buffer->bufferSize / (uint32_t)buffer->elementSize - (uint32_t)bufferSRV.FirstElement;
 				bufferSRV.StructureByteStride = buffer->elementSize;
 				bufferSRV.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 				srvDesc.Buffer = bufferSRV;
-
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.srvCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-				// Create the SRV
-				deviceI->device->CreateShaderResourceView(buffer->resource, &srvDesc, rtvHandle);
-
-				// Change the resource's state
-				async_change_resource_state(dx12_cs->barriersData, buffer->resource, buffer->state, D3D12_RESOURCE_STATE_COMMON);
+				deviceI->device->CreateShaderResourceView(buffer->resource, &srvDesc, view.handle);
 			}
+			buffer->views.push_back(view);
+			return view.handle;
 		}
 
-		void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Texture texture, uint32_t mipLevel)
+		D3D12_CPU_DESCRIPTOR_HANDLE rtas_view(DX12GraphicsDevice* deviceI, DX12GraphicsBuffer* rtasBuffer)
 		{
-			// Grab all the internal structures
-			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
-			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
-			DX12ComputeShader* dx12_cs = (DX12ComputeShader*)computeShader;
-			DX12Texture* dx12_tex = (DX12Texture*)texture;
+			// Reuse the view if it was already created
+			const DX12CachedView* cachedView = find_cached_view(rtasBuffer->views, DX12ViewType::RTAS, 0);
+			if (cachedView != nullptr)
+				return cachedView->handle;
 
-			// First we need to validate that the right heap will be used
-			validate_compute_shader_heap(dx12_cs, dx12_commandBuffer->frameIdx);
+			// Create the view in the staging heap
+			DX12CachedView view;
+			view.type = DX12ViewType::RTAS;
+			view.handle = allocate_staging_descriptor(deviceI, deviceI->stagingCSU, view.slot);
+			D3D12_RAYTRACING_ACCELERATION_STRUCTURE_SRV rtasSRV;
+			rtasSRV.Location = rtasBuffer->resource->GetGPUVirtualAddress();
+			D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+			srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+			srvDesc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3);
+			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
+			srvDesc.RaytracingAccelerationStructure = rtasSRV;
+			deviceI->device->CreateShaderResourceView(nullptr, &srvDesc, view.handle);
+			rtasBuffer->views.push_back(view);
+			return view.handle;
+		}
 
-			// Get the binding
-			DX12Binding bind;
-			assert_msg(request_binding(dx12_cs->bindings, name, bind), "Unexistant binding.");
-			if (bind.type == 2)
+		D3D12_CPU_DESCRIPTOR_HANDLE texture_view(DX12GraphicsDevice* deviceI, DX12Texture* dx12_tex, DX12ViewType type, uint32_t mipLevel)
+		{
+			// Reuse the view if it was already created, SRVs cover all the mips
+			const uint64_t parameter = type == DX12ViewType::UAV ? mipLevel : 0;
+			const DX12CachedView* cachedView = find_cached_view(dx12_tex->views, type, parameter);
+			if (cachedView != nullptr)
+				return cachedView->handle;
+
+			// Create the view in the staging heap
+			DX12CachedView view;
+			view.type = type;
+			view.parameter = parameter;
+			view.handle = allocate_staging_descriptor(deviceI, deviceI->stagingCSU, view.slot);
+			if (type == DX12ViewType::UAV)
 			{
-				// Create the view in the compute's heap
 				D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
 				ZeroMemory(&uavDesc, sizeof(D3D12_UNORDERED_ACCESS_VIEW_DESC));
 				uavDesc.Format = dx12_tex->format;
@@ -1043,20 +1172,11 @@ namespace d3d12
 						assert_fail();
 				}
 
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.uavCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
 				// Create the UAV
-				deviceI->device->CreateUnorderedAccessView(dx12_tex->resource, nullptr, &uavDesc, rtvHandle);
-
-				// Change the resource's state
-				async_change_resource_state(dx12_cs->barriersData, dx12_tex->resource, dx12_tex->state, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+				deviceI->device->CreateUnorderedAccessView(dx12_tex->resource, nullptr, &uavDesc, view.handle);
 			}
 			else
 			{
-				// Create the view in the compute's heap
 				D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
 				srvDesc.Format = sanitize_dxgi_format_srv(dx12_tex->format);
 				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
@@ -1101,7 +1221,7 @@ namespace d3d12
 					{
 						D3D12_TEXCUBE_SRV texCube;
 						texCube.MostDetailedMip = 0;
-						texCube.MipLevels = dx12_tex->mipLevels;;
+						texCube.MipLevels = dx12_tex->mipLevels;
 						texCube.ResourceMinLODClamp = 0;
 						srvDesc.TextureCube = texCube;
 						srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
@@ -1111,66 +1231,150 @@ namespace d3d12
 						assert_fail();
 				}
 
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.srvCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
 				// Create the SRV
-				deviceI->device->CreateShaderResourceView(dx12_tex->resource, &srvDesc, rtvHandle);
+				deviceI->device->CreateShaderResourceView(dx12_tex->resource, &srvDesc, view.handle);
+			}
+			dx12_tex->views.push_back(view);
+			return view.handle;
+		}
+
+		D3D12_CPU_DESCRIPTOR_HANDLE sampler_view(DX12GraphicsDevice* deviceI, DX12Sampler* dx12_sampler)
+		{
+			// Reuse the view if it was already created
+			if (dx12_sampler->view.slot != UINT32_MAX)
+				return dx12_sampler->view.handle;
+
+			// Fill the sampler descriptor
+			const SamplerDescriptor& smplDesc = dx12_sampler->resource;
+			D3D12_SAMPLER_DESC samplerDescriptor;
+			samplerDescriptor.Filter = filter_mode_to_dxgi_filter(smplDesc.filterMode);
+			samplerDescriptor.AddressU = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeX;
+			samplerDescriptor.AddressV = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeY;
+			samplerDescriptor.AddressW = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeZ;
+			samplerDescriptor.MipLODBias = 0.0f;
+			samplerDescriptor.MaxAnisotropy = samplerDescriptor.Filter == D3D12_FILTER_ANISOTROPIC ? smplDesc.anisotropy : 0;
+			samplerDescriptor.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+			memset(samplerDescriptor.BorderColor, 0, sizeof(float) * 4);
+			samplerDescriptor.MinLOD = smplDesc.minLOD;
+			samplerDescriptor.MaxLOD = smplDesc.maxLOD;
+
+			// Create it in the staging heap
+			dx12_sampler->view.type = DX12ViewType::Sampler;
+			dx12_sampler->view.handle = allocate_staging_descriptor(deviceI, deviceI->stagingSampler, dx12_sampler->view.slot);
+			deviceI->device->CreateSampler(&samplerDescriptor, dx12_sampler->view.handle);
+			return dx12_sampler->view.handle;
+		}
+
+		void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, ConstantBuffer constantBuffer)
+		{
+			// Grab all the internal structures
+			DX12CommandBuffer* dx12_commandBuffer = safe_convert<DX12CommandBuffer>(commandBuffer);
+			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
+			DX12ComputeShader* dx12_cs = safe_convert<DX12ComputeShader>(computeShader);
+			DX12ConstantBuffer* dx12_cb = safe_convert<DX12ConstantBuffer>(constantBuffer);
+			DX12GraphicsBuffer* dx12_cbGB = dx12_cb->mainBuffer;
+
+			// Get the binding
+			DX12Binding bind;
+			assert_msg(request_binding(dx12_cs->bindingTable, dx12_cs->bindingSlots, bindingID, bind), "Unexistant binding.");
+
+			// Stage the view in the CBV range of the table
+			dx12_cs->boundCSU[dx12_cs->srvCount + dx12_cs->uavCount + bind.slot] = constant_buffer_view(deviceI, dx12_cbGB);
+
+			// Change the resource's state (if this is a runtime constant buffer)
+			if (dx12_cbGB->heapType != GraphicsBufferType::Upload)
+				async_change_resource_state(dx12_cs->barriersData, dx12_cbGB->resource, dx12_cbGB->state, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+		}
+
+		void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, GraphicsBuffer graphicsBuffer)
+		{
+			// Grab all the internal structures
+			DX12CommandBuffer* dx12_commandBuffer = safe_convert<DX12CommandBuffer>(commandBuffer);
+			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
+			DX12ComputeShader* dx12_cs = safe_convert<DX12ComputeShader>(computeShader);
+			DX12GraphicsBuffer* buffer = safe_convert<DX12GraphicsBuffer>(graphicsBuffer);
+
+			// Get the binding
+			DX12Binding bind;
+			assert_msg(request_binding(dx12_cs->bindingTable, dx12_cs->bindingSlots, bindingID, bind), "Unexistant binding.");
+			if (bind.type == 2)
+			{
+				// Stage the view in the UAV range of the table
+				dx12_cs->boundCSU[dx12_cs->srvCount + bind.slot] = buffer_view(deviceI, buffer, DX12ViewType::UAV, 0);
 
 				// Change the resource's state
-				async_change_resource_state(dx12_cs->barriersData, dx12_tex->resource, dx12_tex->state, D3D12_RESOURCE_STATE_COMMON);
+				async_change_resource_state(dx12_cs->barriersData, buffer->resource, buffer->state, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			}
+			else
+			{
+				// Stage the view in the SRV range of the table
+				dx12_cs->boundCSU[bind.slot] = buffer_view(deviceI, buffer, DX12ViewType::SRV, 0);
+
+				// Change the resource's state
+				async_change_resource_state(dx12_cs->barriersData, buffer->resource, buffer->state, D3D12_RESOURCE_STATE_COMMON);
 			}
 		}
 
-		void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, TopLevelAS rtas)
+		void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, Texture texture, uint32_t mipLevel)
 		{
 			// Grab all the internal structures
 			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
 			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
 			DX12ComputeShader* dx12_cs = (DX12ComputeShader*)computeShader;
-			DX12TLAS* dx12_rtas = (DX12TLAS*)rtas;
-
-			// First we need to validate that the right heap will be used
-			validate_compute_shader_heap(dx12_cs, dx12_commandBuffer->frameIdx);
+			DX12Texture* dx12_tex = (DX12Texture*)texture;
+			initialize_texture(dx12_commandBuffer, dx12_tex);
 
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_cs->bindings, name, bind), "Unexistant binding.");
+			assert_msg(request_binding(dx12_cs->bindingTable, dx12_cs->bindingSlots, bindingID, bind), "Unexistant binding.");
+			if (bind.type == 2)
+			{
+				// Stage the view in the UAV range of the table
+				dx12_cs->boundCSU[dx12_cs->srvCount + bind.slot] = texture_view(deviceI, dx12_tex, DX12ViewType::UAV, mipLevel);
 
-			// Create the view in the compute's heap
-			D3D12_RAYTRACING_ACCELERATION_STRUCTURE_SRV rtasSRV;
-			rtasSRV.Location = dx12_rtas->data->resource->GetGPUVirtualAddress();
-			D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
-			srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-			srvDesc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3);
-			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
-			srvDesc.RaytracingAccelerationStructure = rtasSRV;
+				// Change the resource's state
+				async_change_resource_state(dx12_cs->barriersData, dx12_tex->resource, dx12_tex->state, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			}
+			else
+			{
+				// Stage the view in the SRV range of the table
+				dx12_cs->boundCSU[bind.slot] = texture_view(deviceI, dx12_tex, DX12ViewType::SRV, 0);
 
-			// Compute the slot on the heap
-			DX12DescriptorHeap& currentHeap = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.srvCPU);
-			rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
+				// Change the resource's state
+				async_change_resource_state(dx12_cs->barriersData, dx12_tex->resource, dx12_tex->state, D3D12_RESOURCE_STATE_COMMON);
+			}
+		}
 
-			// Create the SRV
-			deviceI->device->CreateShaderResourceView(nullptr, &srvDesc, rtvHandle);
+		void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, TopLevelAS rtas)
+		{
+			// Grab all the internal structures
+			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
+			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
+			DX12ComputeShader* dx12_cs = (DX12ComputeShader*)computeShader;
+			DX12TLAS* dx12_rtas = (DX12TLAS*)rtas;
+
+			// Get the binding
+			DX12Binding bind;
+			assert_msg(request_binding(dx12_cs->bindingTable, dx12_cs->bindingSlots, bindingID, bind), "Unexistant binding.");
+
+			// Stage the view in the SRV range of the table
+			dx12_cs->boundCSU[bind.slot] = rtas_view(deviceI, dx12_rtas->data);
 
 			// Change the resource's state
 			async_change_resource_state(dx12_cs->barriersData, dx12_rtas->data->resource, dx12_rtas->data->state, D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE);
 		}
 
-		void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, RenderTexture renderTexture)
+		void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, RenderTexture renderTexture)
 		{
 			if (renderTexture == 0)
 				return;
 
 			// Grab all the internal structures
 			DX12RenderTexture* dx12_rTex = (DX12RenderTexture*)renderTexture;
-			set_compute_shader_texture(commandBuffer, computeShader, name, (Texture)(&dx12_rTex->texture));
+			set_compute_shader_texture(commandBuffer, computeShader, bindingID, (Texture)(&dx12_rTex->texture));
 		}
 
-		void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Sampler sampler)
+		void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, Sampler sampler)
 		{
 			// Grab all the internal structures
 			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
@@ -1180,29 +1384,10 @@ namespace d3d12
 
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_cs->bindings, name, bind), "Unexistant binding.");
-
-			// Set the sampler
-			const SamplerDescriptor& smplDesc = dx12_sampler->resource;
-			D3D12_SAMPLER_DESC samplerDescriptor;
-			samplerDescriptor.Filter = filter_mode_to_dxgi_filter(smplDesc.filterMode);
-			samplerDescriptor.AddressU = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeX;
-			samplerDescriptor.AddressV = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeY;
-			samplerDescriptor.AddressW = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeZ;
-			samplerDescriptor.MipLODBias = 0.0f;
-			samplerDescriptor.MaxAnisotropy = samplerDescriptor.Filter == D3D12_FILTER_ANISOTROPIC ? smplDesc.anisotropy : 0;
-			samplerDescriptor.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
-			memset(samplerDescriptor.BorderColor, 0, sizeof(float) * 4);
-			samplerDescriptor.MinLOD = smplDesc.minLOD;
-			samplerDescriptor.MaxLOD = smplDesc.maxLOD;
-
-			// Compute the slot on the heap
-			DX12DescriptorHeap& currentHeap = dx12_cs->samplerHeaps[dx12_cs->nextUsableHeap];
-			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.samplerCPU);
-			rtvHandle.ptr += (uint64_t)dx12_device->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER] * bind.slot;
+			assert_msg(request_binding(dx12_cs->bindingTable, dx12_cs->bindingSlots, bindingID, bind), "Unexistant binding.");
 
-			// Set the sampler
-			dx12_device->device->CreateSampler(&samplerDescriptor, rtvHandle);
+			// Stage the sampler
+			dx12_cs->boundSamplers[bind.slot] = sampler_view(dx12_device, dx12_sampler);
 		}
 
 		void dispatch(CommandBuffer commandBuffer, ComputeShader computeShader, uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ)
@@ -1217,36 +1402,17 @@ namespace d3d12
 				cmdI->cmdList()->ResourceBarrier((uint32_t)dx12_cs->barriersData.size(), dx12_cs->barriersData.data());
 			dx12_cs->barriersData.clear();
 
-			// First we need to validate that the right heap will be used
-			validate_compute_shader_heap(dx12_cs, cmdI->frameIdx);
-
 			// Set the pipeline
 			cmdI->cmdList()->SetPipelineState(dx12_cs->pipelineStateObject);
 
 			// Set the root Signature
 			cmdI->cmdList()->SetComputeRootSignature(dx12_cs->rootSignature->rootSignature);
 
-			// Bind the root descriptor tables
-			DX12DescriptorHeap& currentHeap_cbv_srv_uav = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-			DX12DescriptorHeap& currentHeap_sampler = dx12_cs->samplerHeaps[dx12_cs->nextUsableHeap];
-			ID3D12DescriptorHeap* ppHeaps[] = { currentHeap_cbv_srv_uav.descriptorHeap, currentHeap_sampler.descriptorHeap };
-			cmdI->cmdList()->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-
-			// Bind the tables
-			if (dx12_cs->rootSignature->srvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->srvIndex, currentHeap_cbv_srv_uav.srvGPU);
-			if (dx12_cs->rootSignature->uavIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->uavIndex, currentHeap_cbv_srv_uav.uavGPU);
-			if (dx12_cs->rootSignature->cbvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->cbvIndex, currentHeap_cbv_srv_uav.cbvGPU);
-			if (dx12_cs->rootSignature->samplerIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->samplerIndex, currentHeap_sampler.samplerGPU);
+			// Copy the bound views into the shared ring and bind the tables
+			bind_descriptor_tables(cmdI, dx12_cs->rootSignature, true, dx12_cs->boundCSU, dx12_cs->srvCount, dx12_cs->uavCount, dx12_cs->boundSamplers);
 
 			// Dispatch the currently bound shader
 			cmdI->cmdList()->Dispatch(sizeX, sizeY, sizeZ);
-
-			// This heap has been used for the current command buffer batch, we need to move to the next one
-			dx12_cs->nextUsableHeap++;
 		}
 
 		struct IndirectDispatchCommand
@@ -1272,37 +1438,18 @@ namespace d3d12
 				cmdI->cmdList()->ResourceBarrier((uint32_t)dx12_cs->barriersData.size(), dx12_cs->barriersData.data());
 			dx12_cs->barriersData.clear();
 
-			// First we need to validate that the right heap will be used
-			validate_compute_shader_heap(dx12_cs, cmdI->frameIdx);
-
 			// Set the pipeline
 			cmdI->cmdList()->SetPipelineState(dx12_cs->pipelineStateObject);
 
 			// Set the root Signature
 			cmdI->cmdList()->SetComputeRootSignature(dx12_cs->rootSignature->rootSignature);
 
-			// Bind the root descriptor tables
-			DX12DescriptorHeap& currentHeap_cbv_srv_uav = dx12_cs->CSUHeaps[dx12_cs->nextUsableHeap];
-			DX12DescriptorHeap& currentHeap_sampler = dx12_cs->samplerHeaps[dx12_cs->nextUsableHeap];
-			ID3D12DescriptorHeap* ppHeaps[] = { currentHeap_cbv_srv_uav.descriptorHeap, currentHeap_sampler.descriptorHeap };
-			cmdI->cmdList()->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-
-			// Bind the tables
-			if (dx12_cs->rootSignature->srvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->srvIndex, currentHeap_cbv_srv_uav.srvGPU);
-			if (dx12_cs->rootSignature->uavIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->uavIndex, currentHeap_cbv_srv_uav.uavGPU);
-			if (dx12_cs->rootSignature->cbvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->cbvIndex, currentHeap_cbv_srv_uav.cbvGPU);
-			if (dx12_cs->rootSignature->samplerIndex != UINT32_MAX)
-				cmdI->cmdList()->SetComputeRootDescriptorTable(dx12_cs->rootSignature->samplerIndex, currentHeap_sampler.samplerGPU);
+			// Copy the bound views into the shared ring and bind the tables
+			bind_descriptor_tables(cmdI, dx12_cs->rootSignature, true, dx12_cs->boundCSU, dx12_cs->srvCount, dx12_cs->uavCount, dx12_cs->boundSamplers);
 
 
 			// Execute the command
 			cmdI->cmdList()->ExecuteIndirect(dx12_cs->commandSignature, 1, dx12_indirectBuffer->resource, offset, nullptr, 0);
-
-			// This heap has been used for the current command buffer batch, we need to move to the next one
-			dx12_cs->nextUsableHeap++;
 		}
 
 		void set_viewport(CommandBuffer commandBuffer, int32_t offsetX, int32_t offsetY, uint32_t width, uint32_t height)
@@ -1330,7 +1477,7 @@ namespace d3d12
 			cmdI->cmdList()->RSSetScissorRects(1, &surfaceSize);
 		}
 
-		void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, ConstantBuffer constantBuffer)
+		void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, ConstantBuffer constantBuffer)
 		{
 			// Grab all the internal structures
 			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
@@ -1339,32 +1486,19 @@ namespace d3d12
 			DX12ConstantBuffer* dx12_cb = (DX12ConstantBuffer*)constantBuffer;
 			DX12GraphicsBuffer* dx12_cbGB = dx12_cb->mainBuffer;
 
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, dx12_commandBuffer->frameIdx);
-
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_gp->bindings, name, bind), "Unexistant binding.");
-
-			// Create the view in the compute's heap
-			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvView;
-			cbvView.BufferLocation = dx12_cbGB->resource->GetGPUVirtualAddress();
-			cbvView.SizeInBytes = (uint32_t)dx12_cbGB->bufferSize;
+			assert_msg(request_binding(dx12_gp->bindingTable, dx12_gp->bindingSlots, bindingID, bind), "Unexistant binding.");
 
-			// Compute the slot on the heap
-			DX12DescriptorHeap& currentHeap = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.cbvCPU);
-			rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-			// Create the CBV
-			deviceI->device->CreateConstantBufferView(&cbvView, rtvHandle);
+			// Stage the view in the CBV range of the table
+			dx12_gp->boundCSU[dx12_gp->srvCount + dx12_gp->uavCount + bind.slot] = constant_buffer_view(deviceI, dx12_cbGB);
 
 			// Change the resource's state (if this is a runtime constant buffer)
 			if (dx12_cbGB->heapType != GraphicsBufferType::Upload)
 				async_change_resource_state(dx12_gp->barriersData, dx12_cbGB->resource, dx12_cbGB->state, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
 		}
 
-		void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset)
+		void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset)
 		{
 			// Grab all the internal structures
 			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
@@ -1372,156 +1506,65 @@ namespace d3d12
 			DX12GraphicsPipeline* dx12_gp = (DX12GraphicsPipeline*)graphicsPipeline;
 			DX12GraphicsBuffer* buffer = (DX12GraphicsBuffer*)graphicsBuffer;
 
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, dx12_commandBuffer->frameIdx);
-
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_gp->bindings, name, bind), "Unexistant binding.");
-
-			// Create the view in the compute's heap
+			assert_msg(request_binding(dx12_gp->bindingTable, dx12_gp->bindingSlots, bindingID, bind), "Unexistant binding.");
 			if (bind.type == 2)
 			{
-				// Create the view in the compute's heap
-				D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
-				ZeroMemory(&uavDesc, sizeof(D3D12_UNORDERED_ACCESS_VIEW_DESC));
-				uavDesc.Format = DXGI_FORMAT_UNKNOWN;
-				uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
-				D3D12_BUFFER_UAV bufferUAV;
-				bufferUAV.FirstElement = bufferOffset / (uint32_t)buffer->elementSize;
-				bufferUAV.NumElements = (uint32_t)buffer->bufferSize / (uint32_t)buffer->elementSize - (uint32_t)bufferUAV.FirstElement;
-				bufferUAV.StructureByteStride = buffer->elementSize;
-				bufferUAV.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
-				bufferUAV.CounterOffsetInBytes = 0;
-				uavDesc.Buffer = bufferUAV;
-
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.uavCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-				// Create the UAV
-				deviceI->device->CreateUnorderedAccessView(buffer->resource, nullptr, &uavDesc, rtvHandle);
+				// Stage the view in the UAV range of the table
+				dx12_gp->boundCSU[dx12_gp->srvCount + bind.slot] = buffer_view(deviceI, buffer, DX12ViewType::UAV, bufferOffset);
 
 				// Change the resource's state
 				async_change_resource_state(dx12_gp->barriersData, buffer->resource, buffer->state, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 			}
 			else
 			{
-				D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
-				srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-				srvDesc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3);
-				D3D12_BUFFER_SRV bufferSRV;
-				bufferSRV.FirstElement = bufferOffset / (uint32_t)buffer->elementSize;
-				bufferSRV.NumElements = (uint32_t)buffer->bufferSize / (uint32_t)buffer->elementSize - (uint32_t)bufferSRV.FirstElement;
-				bufferSRV.StructureByteStride = buffer->elementSize;
-				bufferSRV.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-				srvDesc.Buffer = bufferSRV;
-
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.srvCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-				// Create the SRV
-				deviceI->device->CreateShaderResourceView(buffer->resource, &srvDesc, rtvHandle);
+				// Stage the view in the SRV range of the table
+				dx12_gp->boundCSU[bind.slot] = buffer_view(deviceI, buffer, DX12ViewType::SRV, bufferOffset);
 
 				// Change the resource's state
 				async_change_resource_state(dx12_gp->barriersData, buffer->resource, buffer->state, D3D12_RESOURCE_STATE_COMMON);
 			}
 		}
 
-		void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Texture texture)
+		void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Texture texture)
 		{
 			// Grab all the internal structures
 			DX12CommandBuffer* dx12_commandBuffer = safe_convert<DX12CommandBuffer>(commandBuffer);
 			DX12GraphicsDevice* deviceI = dx12_commandBuffer->deviceI;
 			DX12GraphicsPipeline* dx12_gp = safe_convert<DX12GraphicsPipeline>(graphicsPipeline);
 			DX12Texture* dx12_tex = safe_convert<DX12Texture>(texture);
-
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, dx12_commandBuffer->frameIdx);
+			initialize_texture(dx12_commandBuffer, dx12_tex);
 
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_gp->bindings, name, bind), "Unexistant binding.");
+			assert_msg(request_binding(dx12_gp->bindingTable, dx12_gp->bindingSlots, bindingID, bind), "Unexistant binding.");
 
-			// Create the view in the compute's heap
+			// Only read access is supported for the pipelines
 			if (bind.type == 2)
 			{
 				assert_fail();
 			}
 			else
 			{
-				// Create the view in the compute's heap
-				D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
-				srvDesc.Format = sanitize_dxgi_format_srv(dx12_tex->format);
-				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-				srvDesc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3);
-				switch (dx12_tex->type)
-				{
-				case TextureType::Tex2D:
-				{
-					D3D12_TEX2D_SRV tex2D;
-					tex2D.MostDetailedMip = 0;
-					tex2D.MipLevels = dx12_tex->mipLevels;
-					tex2D.PlaneSlice = 0;
-					tex2D.ResourceMinLODClamp = 0;
-					srvDesc.Texture2D = tex2D;
-					srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-				}
-				break;
-				case TextureType::Tex2DArray:
-				{
-					D3D12_TEX2D_ARRAY_SRV tex2DArray;
-					tex2DArray.MostDetailedMip = 0;
-					tex2DArray.MipLevels = dx12_tex->mipLevels;
-					tex2DArray.FirstArraySlice = 0;
-					tex2DArray.ArraySize = dx12_tex->depth;
-					tex2DArray.PlaneSlice = 0;
-					tex2DArray.ResourceMinLODClamp = 0;
-					srvDesc.Texture2DArray = tex2DArray;
-					srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
-				}
-				break;
-				case TextureType::TexCube:
-				{
-					D3D12_TEXCUBE_SRV texCube;
-					texCube.MostDetailedMip = 0;
-					texCube.MipLevels = dx12_tex->mipLevels;
-					texCube.ResourceMinLODClamp = 0;
-					srvDesc.TextureCube = texCube;
-					srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
-				}
-				break;
-				default:
-					assert_fail();
-				}
-
-				// Compute the slot on the heap
-				DX12DescriptorHeap& currentHeap = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-				D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.srvCPU);
-				rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
-
-				// Create the SRV
-				deviceI->device->CreateShaderResourceView(dx12_tex->resource, &srvDesc, rtvHandle);
+				// Stage the view in the SRV range of the table
+				dx12_gp->boundCSU[bind.slot] = texture_view(deviceI, dx12_tex, DX12ViewType::SRV, 0);
 
 				// Change the resource's state
 				async_change_resource_state(dx12_gp->barriersData, dx12_tex->resource, dx12_tex->state, dx12_tex->isDepth ? D3D12_RESOURCE_STATE_DEPTH_READ : D3D12_RESOURCE_STATE_COMMON);
 			}
 		}
 
-		void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, RenderTexture renderTexture)
+		void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, RenderTexture renderTexture)
 		{
 			// Cast to internal type
 			DX12RenderTexture* dx12_rTex = safe_convert<DX12RenderTexture>(renderTexture);
 
 			// Bind the texture
-			set_graphics_pipeline_texture(commandBuffer, graphicsPipeline, name, (Texture)&dx12_rTex->texture);
+			set_graphics_pipeline_texture(commandBuffer, graphicsPipeline, bindingID, (Texture)&dx12_rTex->texture);
 		}
 
-		void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Sampler sampler)
+		void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Sampler sampler)
 		{
 			// Grab all the internal structures
 			DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
@@ -1531,32 +1574,13 @@ namespace d3d12
 
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_gp->bindings, name, bind), "Unexistant binding.");
+			assert_msg(request_binding(dx12_gp->bindingTable, dx12_gp->bindingSlots, bindingID, bind), "Unexistant binding.");
 
-			// Set the sampler
-			const SamplerDescriptor& smplDesc = dx12_sampler->resource;
-			D3D12_SAMPLER_DESC samplerDescriptor;
-			samplerDescriptor.Filter = filter_mode_to_dxgi_filter(smplDesc.filterMode);
-			samplerDescriptor.AddressU = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeX;
-			samplerDescriptor.AddressV = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeY;
-			samplerDescriptor.AddressW = (D3D12_TEXTURE_ADDRESS_MODE)smplDesc.modeZ;
-			samplerDescriptor.MipLODBias = 0.0f;
-			samplerDescriptor.MaxAnisotropy = samplerDescriptor.Filter == D3D12_FILTER_ANISOTROPIC ? smplDesc.anisotropy : 0;
-			samplerDescriptor.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
-			memset(samplerDescriptor.BorderColor, 0, sizeof(float) * 4);
-			samplerDescriptor.MinLOD = smplDesc.minLOD;
-			samplerDescriptor.MaxLOD = smplDesc.maxLOD;
-
-			// Compute the slot on the heap
-			DX12DescriptorHeap& currentHeap = dx12_gp->samplerHeaps[dx12_gp->nextUsableHeap];
-			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.samplerCPU);
-			rtvHandle.ptr += (uint64_t)dx12_device->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER] * bind.slot;
-
-			// Set the sampler
-			dx12_device->device->CreateSampler(&samplerDescriptor, rtvHandle);
+			// Stage the sampler
+			dx12_gp->boundSamplers[bind.slot] = sampler_view(dx12_device, dx12_sampler);
 		}
 
-		void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, TopLevelAS rtas)
+		void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, TopLevelAS rtas)
 		{
 			if (rtas == 0)
 				return;
@@ -1567,29 +1591,12 @@ namespace d3d12
 			DX12GraphicsPipeline* dx12_gp = (DX12GraphicsPipeline*)graphicsPipeline;
 			DX12TLAS* dx12_rtas = (DX12TLAS*)rtas;
 
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, dx12_commandBuffer->frameIdx);
-
 			// Get the binding
 			DX12Binding bind;
-			assert_msg(request_binding(dx12_gp->bindings, name, bind), "Unexistant binding.");
-
-			// Create the view in the compute's heap
-			D3D12_RAYTRACING_ACCELERATION_STRUCTURE_SRV rtasSRV;
-			rtasSRV.Location = dx12_rtas->data->resource->GetGPUVirtualAddress();
-			D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
-			srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-			srvDesc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_1, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_2, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3);
-			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
-			srvDesc.RaytracingAccelerationStructure = rtasSRV;
-
-			// Compute the slot on the heap
-			DX12DescriptorHeap& currentHeap = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-			D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle(currentHeap.srvCPU);
-			rtvHandle.ptr += (uint64_t)deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV] * bind.slot;
+			assert_msg(request_binding(dx12_gp->bindingTable, dx12_gp->bindingSlots, bindingID, bind), "Unexistant binding.");
 
-			// Create the SRV
-			deviceI->device->CreateShaderResourceView(nullptr, &srvDesc, rtvHandle);
+			// Stage the view in the SRV range of the table
+			dx12_gp->boundCSU[bind.slot] = rtas_view(deviceI, dx12_rtas->data);
 
 			// Change the resource's state
 			async_change_resource_state(dx12_gp->barriersData, dx12_rtas->data->resource, dx12_rtas->data->state, D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE);
@@ -1607,30 +1614,14 @@ namespace d3d12
 				cmdI->cmdList()->ResourceBarrier((uint32_t)dx12_gp->barriersData.size(), dx12_gp->barriersData.data());
 			dx12_gp->barriersData.clear();
 
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, cmdI->frameIdx);
-
 			// Set the pipeline state
 			cmdI->cmdList()->SetPipelineState(dx12_gp->pipelineStateObject);
 
 			// Set the root signature
 			cmdI->cmdList()->SetGraphicsRootSignature(dx12_gp->rootSignature->rootSignature);
 
-			// Set the descriptor heap
-			DX12DescriptorHeap& currentHeap_cbv_srv_uav = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-			DX12DescriptorHeap& currentHeap_sampler = dx12_gp->samplerHeaps[dx12_gp->nextUsableHeap];
-			ID3D12DescriptorHeap* ppHeaps[] = { currentHeap_cbv_srv_uav.descriptorHeap, currentHeap_sampler.descriptorHeap };
-			cmdI->cmdList()->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-
-			// Set the tables
-			if (dx12_gp->rootSignature->srvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->srvIndex, currentHeap_cbv_srv_uav.srvGPU);
-			if (dx12_gp->rootSignature->uavIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->uavIndex, currentHeap_cbv_srv_uav.uavGPU);
-			if (dx12_gp->rootSignature->cbvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->cbvIndex, currentHeap_cbv_srv_uav.cbvGPU);
-			if (dx12_gp->rootSignature->samplerIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->samplerIndex, currentHeap_sampler.samplerGPU);
+			// Copy the bound views into the shared ring and bind the tables
+			bind_descriptor_tables(cmdI, dx12_gp->rootSignature, false, dx12_gp->boundCSU, dx12_gp->srvCount, dx12_gp->uavCount, dx12_gp->boundSamplers);
 
 			if (primitive == DrawPrimitive::Triangle)
 			{
@@ -1677,9 +1668,6 @@ namespace d3d12
 				cmdI->cmdList()->DrawIndexedInstanced(3 * num_triangles, numInstances, 0, 0, 0);
 			else
 				cmdI->cmdList()->DrawIndexedInstanced(2 * num_triangles, numInstances, 0, 0, 0);
-
-			// This heap has been used for the current command buffer batch, we need to move to the next one
-			dx12_gp->nextUsableHeap++;
 		}
 
 		void draw_procedural(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, uint32_t numTriangles, uint32_t numInstances, DrawPrimitive primitive)
@@ -1693,30 +1681,14 @@ namespace d3d12
 				cmdI->cmdList()->ResourceBarrier((uint32_t)dx12_gp->barriersData.size(), dx12_gp->barriersData.data());
 			dx12_gp->barriersData.clear();
 
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, cmdI->frameIdx);
-
 			// Set the pipeline state
 			cmdI->cmdList()->SetPipelineState(dx12_gp->pipelineStateObject);
 
 			// Set the root signature
 			cmdI->cmdList()->SetGraphicsRootSignature(dx12_gp->rootSignature->rootSignature);
 
-			// Set the descriptor heap
-			DX12DescriptorHeap& currentHeap_cbv_srv_uav = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-			DX12DescriptorHeap& currentHeap_sampler = dx12_gp->samplerHeaps[dx12_gp->nextUsableHeap];
-			ID3D12DescriptorHeap* ppHeaps[] = { currentHeap_cbv_srv_uav.descriptorHeap, currentHeap_sampler.descriptorHeap };
-			cmdI->cmdList()->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-
-			// Set the tables
-			if (dx12_gp->rootSignature->srvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->srvIndex, currentHeap_cbv_srv_uav.srvGPU);
-			if (dx12_gp->rootSignature->uavIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->uavIndex, currentHeap_cbv_srv_uav.uavGPU);
-			if (dx12_gp->rootSignature->cbvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->cbvIndex, currentHeap_cbv_srv_uav.cbvGPU);
-			if (dx12_gp->rootSignature->samplerIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->samplerIndex, currentHeap_sampler.samplerGPU);
+			// Copy the bound views into the shared ring and bind the tables
+			bind_descriptor_tables(cmdI, dx12_gp->rootSignature, false, dx12_gp->boundCSU, dx12_gp->srvCount, dx12_gp->uavCount, dx12_gp->boundSamplers);
 
 			// Set the right primitive
 			if (dx12_gp->hullblob != nullptr && dx12_gp->domainBlob != nullptr)
@@ -1749,9 +1721,6 @@ namespace d3d12
 				cmdI->cmdList()->DrawInstanced(3 * numTriangles, numInstances, 0, 0);
 			else
 				cmdI->cmdList()->DrawInstanced(2 * numTriangles, numInstances, 0, 0);
-
-			// This heap has been used for the current command buffer batch, we need to move to the next one
-			dx12_gp->nextUsableHeap++;
 		}
 
 		void draw_procedural_indirect(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, GraphicsBuffer indirectBuffer, uint64_t bufferOffset)
@@ -1772,30 +1741,14 @@ namespace d3d12
 				cmdI->cmdList()->ResourceBarrier((uint32_t)dx12_gp->barriersData.size(), dx12_gp->barriersData.data());
 			dx12_gp->barriersData.clear();
 
-			// First we need to validate that the right heap will be used
-			validate_graphics_pipeline_heap(dx12_gp, cmdI->frameIdx);
-
 			// Set the pipeline state
 			cmdI->cmdList()->SetPipelineState(dx12_gp->pipelineStateObject);
 
 			// Set the root signature
 			cmdI->cmdList()->SetGraphicsRootSignature(dx12_gp->rootSignature->rootSignature);
 
-			// Set the descriptor heap
-			DX12DescriptorHeap& currentHeap_cbv_srv_uav = dx12_gp->CSUHeaps[dx12_gp->nextUsableHeap];
-			DX12DescriptorHeap& currentHeap_sampler = dx12_gp->samplerHeaps[dx12_gp->nextUsableHeap];
-			ID3D12DescriptorHeap* ppHeaps[] = { currentHeap_cbv_srv_uav.descriptorHeap, currentHeap_sampler.descriptorHeap };
-			cmdI->cmdList()->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-
-			// Set the tables
-			if (dx12_gp->rootSignature->srvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->srvIndex, currentHeap_cbv_srv_uav.srvGPU);
-			if (dx12_gp->rootSignature->uavIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->uavIndex, currentHeap_cbv_srv_uav.uavGPU);
-			if (dx12_gp->rootSignature->cbvIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->cbvIndex, currentHeap_cbv_srv_uav.cbvGPU);
-			if (dx12_gp->rootSignature->samplerIndex != UINT32_MAX)
-				cmdI->cmdList()->SetGraphicsRootDescriptorTable(dx12_gp->rootSignature->samplerIndex, currentHeap_sampler.samplerGPU);
+			// Copy the bound views into the shared ring and bind the tables
+			bind_descriptor_tables(cmdI, dx12_gp->rootSignature, false, dx12_gp->boundCSU, dx12_gp->srvCount, dx12_gp->uavCount, dx12_gp->boundSamplers);
 
 			// Set the right stencil
 			cmdI->cmdList()->OMSetStencilRef(dx12_gp->stencilRef);
@@ -1808,9 +1761,6 @@ namespace d3d12
 
 			// Execute the command
 			cmdI->cmdList()->ExecuteIndirect(dx12_gp->commandSignature, 1, dx12_indirectBuffer->resource, bufferOffset, nullptr, 0);
-
-			// This heap has been used for the current command buffer batch, we need to move to the next one
-			dx12_gp->nextUsableHeap++;
 		}
 
 		void build_blas(CommandBuffer cmdB, BottomLevelAS blas)
@@ -1879,6 +1829,20 @@ namespace d3d12
 			cmdI->cmdList()->ResolveQueryData(query->heap, D3D12_QUERY_TYPE_TIMESTAMP, 0, 2, query->result, 0);
 		}
 
+		void write_timestamp(CommandBuffer commandBuffer, ProfilingScope profilingScope, uint32_t index)
+		{
+			DX12CommandBuffer* cmdI = safe_convert<DX12CommandBuffer>(commandBuffer);
+			DX12Query* query = safe_convert<DX12Query>(profilingScope);
+			cmdI->cmdList()->EndQuery(query->heap, D3D12_QUERY_TYPE_TIMESTAMP, index);
+		}
+
+		void resolve_timestamps(CommandBuffer commandBuffer, ProfilingScope profilingScope, uint32_t first, uint32_t count)
+		{
+			DX12CommandBuffer* cmdI = safe_convert<DX12CommandBuffer>(commandBuffer);
+			DX12Query* query = safe_convert<DX12Query>(profilingScope);
+			cmdI->cmdList()->ResolveQueryData(query->heap, D3D12_QUERY_TYPE_TIMESTAMP, first, count, query->result, sizeof(uint64_t) * first);
+		}
+
 		void convert_mat_32_to_16(CommandBuffer commandBuffer, GraphicsBuffer inputMatrixBuffer, uint64_t inputOffset, GraphicsBuffer outputMatrixBuffer, uint64_t outputOffset, uint32_t width, uint32_t height, bool optimal)
 		{
 			// Convert to internal type
@@ -40,10 +40,14 @@ namespace d3d12
         assert_msg(dx12_device->device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&subQueue.fence)) == S_OK, "Failed to create Fence");
         subQueue.fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
         subQueue.fenceValue = 0;
+
+        // The fence tracks the descriptor tables used by this queue
+        subQueue.timeline = register_timeline(dx12_device, subQueue.fence);
     }
 
-    void destroy_sub_command_queue(DX12CommandSubQueue& subQueue)
+    void destroy_sub_command_queue(DX12GraphicsDevice* dx12_device, DX12CommandSubQueue& subQueue)
     {
+        unregister_timeline(dx12_device, subQueue.timeline);
         subQueue.queue->Release();
         subQueue.fence->Release();
         CloseHandle(subQueue.fenceEvent);
@@ -76,9 +80,9 @@ namespace d3d12
         void destroy_command_queue(CommandQueue commandQueue)
         {
             DX12CommandQueue* dx12_commandQueue = (DX12CommandQueue*)commandQueue;
-            destroy_sub_command_queue(dx12_commandQueue->directSubQueue);
-            destroy_sub_command_queue(dx12_commandQueue->computeSubQueue);
-            destroy_sub_command_queue(dx12_commandQueue->copySubQueue);
+            destroy_sub_command_queue(dx12_commandQueue->deviceI, dx12_commandQueue->directSubQueue);
+            destroy_sub_command_queue(dx12_commandQueue->deviceI, dx12_commandQueue->computeSubQueue);
+            destroy_sub_command_queue(dx12_commandQueue->deviceI, dx12_commandQueue->copySubQueue);
             delete dx12_commandQueue;
         }
 
@@ -88,19 +92,30 @@ namespace d3d12
             DX12CommandBuffer* dx12_commandBuffer = (DX12CommandBuffer*)commandBuffer;
             DX12CommandQueue* dx12_commandQueue = (DX12CommandQueue*)commandQueue;
 
-            ID3D12CommandList* const commandLists[] = { dx12_commandBuffer->cmdList()};
+            // Pick the target queue
+            DX12CommandSubQueue* subQueue = nullptr;
             switch (dx12_commandBuffer->type)
             {
                 case D3D12_COMMAND_LIST_TYPE_DIRECT:
-                    dx12_commandQueue->directSubQueue.queue->ExecuteCommandLists(1, commandLists);
+                    subQueue = &dx12_commandQueue->directSubQueue;
                 break;
                 case D3D12_COMMAND_LIST_TYPE_COMPUTE:
-                    dx12_commandQueue->computeSubQueue.queue->ExecuteCommandLists(1, commandLists);
+                    subQueue = &dx12_commandQueue->computeSubQueue;
                 break;
                 case D3D12_COMMAND_LIST_TYPE_COPY:
-                    dx12_commandQueue->copySubQueue.queue->ExecuteCommandLists(1, commandLists);
+                    subQueue = &dx12_commandQueue->copySubQueue;
                 break;
             }
+            assert_msg(subQueue != nullptr, "Unsupported command buffer type.");
+
+            // Execute the command list
+            ID3D12CommandList* const commandLists[] = { dx12_commandBuffer->cmdList()};
+            subQueue->queue->ExecuteCommandLists(1, commandLists);
+
+            // The descriptor tables of the command buffer can be recycled once the queue reaches this value
+            subQueue->fenceValue++;
+            subQueue->queue->Signal(subQueue->fence, subQueue->fenceValue);
+            submit_descriptor_tables(dx12_commandBuffer, subQueue->timeline, subQueue->fenceValue);
         }
 
         void signal_event_wait(DX12CommandSubQueue& subQueue)
@@ -34,28 +34,12 @@ namespace d3d12
 	{
 		ComputeShader create_compute_shader(GraphicsDevice graphicsDevice, const ComputeShaderDescriptor& csd, bool experimental)
 		{
-			// Convert the strings to wide
-			const std::wstring& filename = convert_to_wide(csd.filename.c_str(), (uint32_t)csd.filename.size());
-			const std::wstring& kernelName = convert_to_wide(csd.kernelname.c_str(), (uint32_t)csd.kernelname.size());
-
 			// Convert the device
 			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
 			ID3D12Device2* device = deviceI->device;
 
-			// Create our internal structure
-			DX12ComputeShader* cS = new DX12ComputeShader();
-
 			D3D12_COMPUTE_PIPELINE_STATE_DESC pso_desc = {};
 
-			// Create the library and the compiler
-			IDxcLibrary* library;
-			DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&library));
-
-			// Load the file into a blob
-			uint32_t code_page = CP_UTF8;
-			IDxcBlobEncoding* source_blob;
-			assert_msg(library->CreateBlobFromFile(filename.c_str(), &code_page, &source_blob) == S_OK, "Failed to load the shader code.");
-
 			// Compilation arguments
 			std::vector<std::wstring> includeDirs;
 			for (int includeDirIdx = 0; includeDirIdx < csd.includeDirectories.size(); ++includeDirIdx)
@@ -119,53 +103,20 @@ namespace d3d12
 			for (int includeDirIdx = 0; includeDirIdx < csd.includeDirectories.size(); ++includeDirIdx)
 				arguments.push_back(includeDirs[includeDirIdx].c_str());
 
-			// Create the compiler
-			IDxcCompiler* compiler;
-			DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler));
-
-			// Create an include handler
-			IDxcIncludeHandler* includeHandler;
-			library->CreateIncludeHandler(&includeHandler);
-
-			// Compile the shader
-			IDxcOperationResult* result;
-			HRESULT hr = compiler->Compile(source_blob, filename.c_str(), kernelName.c_str(), experimental ? L"cs_6_9" : L"cs_6_6", arguments.data(), (uint32_t)arguments.size(), definesArray.data(), (uint32_t)definesArray.size(), includeHandler, &result);
-
-			if (SUCCEEDED(hr))
-				result->GetStatus(&hr);
-			bool compile_succeed = SUCCEEDED(hr);
-
-			// If the compilation failed, print the error
-			IDxcBlobEncoding* error_blob;
-			if (SUCCEEDED(result->GetErrorBuffer(&error_blob)) && error_blob)
-			{
-				// Log the compilation message
-				if (error_blob->GetBufferSize() != 0)
-					printf("[SHADER COMPILATION] %s, %s\n", csd.kernelname.c_str(), (const char*)error_blob->GetBufferPointer());
-
-				// Release the error blob
-				error_blob->Release();
-			}
-
-			// Release the library
-			library->Release();
-
-			// If succeeded, grab the right pointer
-			IDxcBlob* shader_blob = 0;
-			if (compile_succeed)
-				result->GetResult(&shader_blob);
-
-			// Release all the intermediate resources
-			result->Release();
-			source_blob->Release();
-			compiler->Release();
+			// Compile the shader (or grab it from the cache)
+			std::vector<std::string> dependencies;
+			IDxcBlob* shader_blob = compile_shader_kernel(csd.filename, csd.includeDirectories, csd.kernelname, experimental ? L"cs_6_9" : L"cs_6_6", arguments, definesArray, dependencies);
 
 			// If we were not able to compile, leave.
 			if (shader_blob == nullptr)
 				return 0;
 
-			// Keep track of the blob
+			// Create our internal structure
+			DX12ComputeShader* cS = new DX12ComputeShader();
+
+			// Keep track of the blob and of the files it was built from
 			cS->shaderBlob = shader_blob;
+			cS->dependencies = std::move(dependencies);
 
 			// Create the pipeline state object for the shader
 			pso_desc.CS.BytecodeLength = shader_blob->GetBufferSize();
@@ -174,6 +125,7 @@ namespace d3d12
 			// Do the reflection
 			uint32_t cbvCount = 0, srvCount = 0, uavCount = 0, samplerCount = 0;
 			query_bindings(cS->shaderBlob, cbvCount, srvCount, uavCount, samplerCount, cS->bindings);
+			build_binding_table(cS->bindings, cS->bindingTable, cS->bindingSlots);
 
 			// Build the root signature
 			cS->rootSignature = create_root_signature(deviceI, srvCount, uavCount, cbvCount, samplerCount);
@@ -192,11 +144,9 @@ namespace d3d12
 			cS->uavCount = uavCount;
 			cS->samplerCount = samplerCount;
 
-			// Create the descriptor heap for this compute shader
-			cS->CSUHeaps.push_back(create_descriptor_heap_suc(deviceI, srvCount, uavCount, cbvCount));
-			cS->samplerHeaps.push_back(create_descriptor_heap_sampler(deviceI, std::max(samplerCount, 1u)));
-			cS->cmdBatchIndex = UINT32_MAX;
-			cS->nextUsableHeap = 0;
+			// Slots of the views bound to this compute shader
+			cS->boundCSU.resize(srvCount + uavCount + cbvCount);
+			cS->boundSamplers.resize(samplerCount);
 
 			// Create the command signature and append it
 			D3D12_INDIRECT_ARGUMENT_DESC argumentDescs[1];
@@ -219,14 +169,6 @@ namespace d3d12
 			// Grab the internal structure
 			DX12ComputeShader* dx12_computeShader = (DX12ComputeShader*)computeShader;
 
-			// Destroy all the descriptor heaps
-			uint32_t numDescriptorHeaps = (uint32_t)dx12_computeShader->CSUHeaps.size();
-			for (uint32_t heapIdx = 0; heapIdx < numDescriptorHeaps; ++heapIdx)
-			{
-				destroy_descriptor_heap(dx12_computeShader->CSUHeaps[heapIdx]);
-				destroy_descriptor_heap(dx12_computeShader->samplerHeaps[heapIdx]);
-			}
-
 			dx12_computeShader->commandSignature->Release();
 			dx12_computeShader->shaderBlob->Release();
 			dx12_computeShader->pipelineStateObject->Release();
@@ -238,5 +180,11 @@ namespace d3d12
 			// Destroy the internal structure
 			delete dx12_computeShader;
 		}
+
+		const std::vector<std::string>& source_dependencies(ComputeShader computeShader)
+		{
+			DX12ComputeShader* dx12_computeShader = (DX12ComputeShader*)computeShader;
+			return dx12_computeShader->dependencies;
+		}
 	}
 }
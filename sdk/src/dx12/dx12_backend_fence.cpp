@@ -46,5 +46,18 @@ namespace d3d12
             ID3D12Fence* dx12_fence = (ID3D12Fence*)fence;
             return dx12_fence->GetCompletedValue();
         }
+
+        void wait_value(Fence fence, uint64_t value)
+        {
+            ID3D12Fence* dx12_fence = (ID3D12Fence*)fence;
+            if (dx12_fence->GetCompletedValue() >= value)
+                return;
+
+            // Sleep until the GPU reaches the value
+            HANDLE fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+            assert_msg(dx12_fence->SetEventOnCompletion(value, fenceEvent) == S_OK, "Failed to set the fence event.");
+            WaitForSingleObject(fenceEvent, INFINITE);
+            CloseHandle(fenceEvent);
+        }
     }
 }
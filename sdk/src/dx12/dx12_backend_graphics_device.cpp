@@ -206,6 +206,12 @@ namespace d3d12
             assert_msg(dx12_device->device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)) == S_OK, "Failed to query option.");
             dx12_device->supportDoubleShaderOps = options.DoublePrecisionFloatShaderOps;
 
+            // Wave sizes
+            D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+            assert_msg(dx12_device->device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1)) == S_OK, "Failed to query option1.");
+            dx12_device->waveLaneCountMin = options1.WaveLaneCountMin;
+            dx12_device->waveLaneCountMax = options1.WaveLaneCountMax;
+
             // Shader 16-bits
             D3D12_FEATURE_DATA_D3D12_OPTIONS4 options4 = {};
             assert_msg(dx12_device->device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS4, &options4, sizeof(options4)) == S_OK, "Failed to query option4.");
@@ -240,6 +246,12 @@ namespace d3d12
             if (dx12_device->supportCoopVectors)
                 assert_msg(dx12_device->device->QueryInterface(IID_PPV_ARGS(&dx12_device->previewDevice)) == S_OK, "Failed to query preview device.");
 
+            // Staging heaps and shared descriptor rings
+            create_descriptor_rings(dx12_device);
+
+            // Heaps the resources are placed in
+            create_heap_pools(dx12_device);
+
             return (GraphicsDevice)dx12_device;
         }
 
@@ -254,6 +266,10 @@ namespace d3d12
                 && dx12_device->allocatedCS == 0
                 && dx12_device->allocatedGP == 0, "Graphics Device has still active resources");
 
+            // Release the descriptor rings and the resource heaps
+            destroy_descriptor_rings(dx12_device);
+            destroy_heap_pools(dx12_device);
+
             // Release the devfice
             dx12_device->device->Release();
 
@@ -267,6 +283,37 @@ namespace d3d12
             dx12_device->device->SetStablePowerState(state);
         }
 
+        DeviceMemoryStats memory_stats(GraphicsDevice device)
+        {
+            DX12GraphicsDevice* dx12_device = (DX12GraphicsDevice*)device;
+            std::lock_guard<std::mutex> lock(dx12_device->heapMutex);
+
+            // Accumulate the heaps of every pool
+            DeviceMemoryStats stats;
+            for (uint32_t poolIdx = 0; poolIdx < (uint32_t)DX12HeapPoolType::Count; ++poolIdx)
+            {
+                const DX12HeapPool* pool = dx12_device->heapPools[poolIdx];
+                for (const DX12Heap* heap : pool->heaps)
+                {
+                    if (heap == nullptr)
+                        continue;
+                    TLSFStats heapStats = heap->allocator.stats();
+                    stats.heapMemory += heapStats.capacity;
+                    stats.usedMemory += heapStats.usedBytes;
+                    stats.largestFreeBlock = std::max(stats.largestFreeBlock, heapStats.largestFreeBlock);
+                    stats.placedResources += heapStats.liveAllocations;
+                    stats.numHeaps++;
+                }
+                stats.peakMemory += pool->peakMemory;
+            }
+            stats.committedResources = dx12_device->committedResources;
+
+            // The free space of different heaps is never contiguous
+            uint64_t freeMemory = stats.heapMemory - stats.usedMemory;
+            stats.fragmentation = freeMemory > 0 ? 1.0f - (float)((double)stats.largestFreeBlock / (double)freeMemory) : 0.0f;
+            return stats;
+        }
+
         GPUVendor get_gpu_vendor(GraphicsDevice device)
         {
             DX12GraphicsDevice* dx12_device = (DX12GraphicsDevice*)device;
@@ -304,5 +351,11 @@ namespace d3d12
         {
             return CoopMatTier::Other;
         }
+
+        uint2 wave_lane_count_range(GraphicsDevice device)
+        {
+            DX12GraphicsDevice* dx12_device = (DX12GraphicsDevice*)device;
+            return { dx12_device->waveLaneCountMin, dx12_device->waveLaneCountMax };
+        }
     }
 }
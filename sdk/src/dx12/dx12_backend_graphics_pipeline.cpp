@@ -19,36 +19,6 @@ namespace d3d12
 {
     namespace graphics_pipeline
     {
-        IDxcBlob* compile_kernel(IDxcCompiler* compiler, IDxcBlobEncoding* source_blob, const std::wstring& filename, const std::wstring& stageName, std::vector<LPCWSTR>& arguments, std::vector<DxcDefine>& defines, IDxcIncludeHandler* includeHandler, const wchar_t* profile)
-        {
-            // Compile the shader
-            IDxcOperationResult* result;
-            HRESULT hr = compiler->Compile(source_blob, filename.c_str(), stageName.c_str(), profile, arguments.data(), (uint32_t)arguments.size(), defines.data(), (uint32_t)defines.size(), includeHandler, &result);
-
-            // Did we manage to compile it properly
-            if (SUCCEEDED(hr)) result->GetStatus(&hr);
-            bool compile_succeed = SUCCEEDED(hr);
-
-            // If the compilation failed, print the error
-            IDxcBlobEncoding* error_blob;
-            if (SUCCEEDED(result->GetErrorBuffer(&error_blob)) && error_blob)
-            {
-                if (error_blob->GetBufferSize() != 0)
-                    printf("[SHADER COMPILATION] Kernel %s %s\n", convert_to_regular(stageName).c_str(), (const char*)error_blob->GetBufferPointer());
-
-                // Release the error blob
-                error_blob->Release();
-            }
-
-            // If succeeded, grab the right pointer
-            IDxcBlob* shader_blob = nullptr;
-            if (compile_succeed) result->GetResult(&shader_blob);
-            result->Release();
-
-            // Return the result blob
-            return shader_blob;
-        }
-
         void fill_rasterizer_desc(const GraphicsPipelineDescriptor& gpd, D3D12_RASTERIZER_DESC& rasterDesc)
         {
             // Define the rasterization pipeline
@@ -145,48 +115,26 @@ namespace d3d12
         }
 
         GraphicsPipeline create_vertex_graphics_pipeline(GraphicsDevice graphicsDevice, const GraphicsPipelineDescriptor& gpd,
-                                                            IDxcCompiler* compiler, IDxcLibrary* library, IDxcIncludeHandler* includeHandler,
                                                             std::vector<LPCWSTR>& arguments, std::vector<DxcDefine>& definesArray)
         {
             // Cast the graphics device
             DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
 
-            // File name
-            const std::wstring& filename = convert_to_wide(gpd.filename.c_str(), (uint32_t)gpd.filename.size());
-
-            // Vertex pipeline
-            const std::wstring& vertexStage = convert_to_wide(gpd.vertexKernelName.c_str(), (uint32_t)gpd.vertexKernelName.size());
-            const std::wstring& hullStage = convert_to_wide(gpd.hullKernelName.c_str(), (uint32_t)gpd.hullKernelName.size());
-            const std::wstring& domainStage = convert_to_wide(gpd.domainKernelName.c_str(), (uint32_t)gpd.domainKernelName.size());
-            const std::wstring& geometryStage = convert_to_wide(gpd.geometryKernelName.c_str(), (uint32_t)gpd.geometryKernelName.size());
-
-            // Fragment shader
-            const std::wstring& fragmentStage = convert_to_wide(gpd.fragmentKernelName.c_str(), (uint32_t)gpd.fragmentKernelName.size());
-
-            // Load the file into a blob
-            uint32_t code_page = CP_UTF8;
-            IDxcBlobEncoding* source_blob;
-            assert_msg(library->CreateBlobFromFile(filename.c_str(), &code_page, &source_blob) == S_OK, "Failed to load the shader code.");
-
-            // Compile Vertex pipeline
-            IDxcBlob* vertexBlob = compile_kernel(compiler, source_blob, filename, vertexStage, arguments, definesArray, includeHandler, L"vs_6_6");
+            // Compile Vertex pipeline, all the stages share the same file and defines so they share the dependencies
+            std::vector<std::string> dependencies, stageDependencies;
+            IDxcBlob* vertexBlob = compile_shader_kernel(gpd.filename, gpd.includeDirectories, gpd.vertexKernelName, L"vs_6_6", arguments, definesArray, dependencies);
             IDxcBlob* hullBlob = nullptr;
-            if (hullStage != L"")
-                hullBlob = compile_kernel(compiler, source_blob, filename, hullStage, arguments, definesArray, includeHandler, L"hs_6_6");
+            if (gpd.hullKernelName != "")
+                hullBlob = compile_shader_kernel(gpd.filename, gpd.includeDirectories, gpd.hullKernelName, L"hs_6_6", arguments, definesArray, stageDependencies);
             IDxcBlob* domainBlob = nullptr;
-            if (domainStage != L"")
-                domainBlob = compile_kernel(compiler, source_blob, filename, domainStage, arguments, definesArray, includeHandler, L"ds_6_6");
+            if (gpd.domainKernelName != "")
+                domainBlob = compile_shader_kernel(gpd.filename, gpd.includeDirectories, gpd.domainKernelName, L"ds_6_6", arguments, definesArray, stageDependencies);
             IDxcBlob* geometryBlob = nullptr;
-            if (geometryStage != L"")
-                geometryBlob = compile_kernel(compiler, source_blob, filename, geometryStage, arguments, definesArray, includeHandler, L"gs_6_6");
+            if (gpd.geometryKernelName != "")
+                geometryBlob = compile_shader_kernel(gpd.filename, gpd.includeDirectories, gpd.geometryKernelName, L"gs_6_6", arguments, definesArray, stageDependencies);
 
             // Compile the fragment shader
-            IDxcBlob* fragmentBlob = compile_kernel(compiler, source_blob, filename, fragmentStage, arguments, definesArray, includeHandler, L"ps_6_6");
-
-            // Release all the intermediate resources
-            library->Release();
-            source_blob->Release();
-            compiler->Release();
+            IDxcBlob* fragmentBlob = compile_shader_kernel(gpd.filename, gpd.includeDirectories, gpd.fragmentKernelName, L"ps_6_6", arguments, definesArray, stageDependencies);
 
             // If one of the two stages did not compile properly, leave
             if (vertexBlob == nullptr || fragmentBlob == nullptr)
@@ -221,6 +169,9 @@ namespace d3d12
             // Fragment pipeline
             dx12_gp->fragBlob = fragmentBlob;
 
+            // Files the pipeline was built from
+            dx12_gp->dependencies = std::move(dependencies);
+
             // Do the reflection
             uint32_t cbvCount = 0, srvCount = 0, uavCount = 0, samplerCount = 0;
             {
@@ -230,6 +181,7 @@ namespace d3d12
                 if (dx12_gp->domainBlob != nullptr)
                     query_bindings(dx12_gp->domainBlob, cbvCount, srvCount, uavCount, samplerCount, dx12_gp->bindings);
                 query_bindings(dx12_gp->fragBlob, cbvCount, srvCount, uavCount, samplerCount, dx12_gp->bindings);
+                build_binding_table(dx12_gp->bindings, dx12_gp->bindingTable, dx12_gp->bindingSlots);
             }
 
             // Root signature
@@ -324,11 +276,9 @@ namespace d3d12
             commandSignatureDesc.ByteStride = sizeof(D3D12_DRAW_ARGUMENTS);
             assert(deviceI->device->CreateCommandSignature(&commandSignatureDesc, nullptr, IID_PPV_ARGS(&dx12_gp->commandSignature)) == S_OK);
 
-            // Create the descriptor heap for this compute shader
-            dx12_gp->CSUHeaps.push_back(create_descriptor_heap_suc(deviceI, srvCount, uavCount, cbvCount));
-            dx12_gp->samplerHeaps.push_back(create_descriptor_heap_sampler(deviceI, std::max(1u, samplerCount)));
-            dx12_gp->cmdBatchIndex = UINT32_MAX;
-            dx12_gp->nextUsableHeap = 0;
+            // Slots of the views bound to this pipeline
+            dx12_gp->boundCSU.resize(srvCount + uavCount + cbvCount);
+            dx12_gp->boundSamplers.resize(samplerCount);
             dx12_gp->srvCount = srvCount;
             dx12_gp->uavCount = uavCount;
             dx12_gp->cbvCount = cbvCount;
@@ -401,19 +351,7 @@ namespace d3d12
             for (int includeDirIdx = 0; includeDirIdx < gpd.includeDirectories.size(); ++includeDirIdx)
                 arguments.push_back(includeDirs[includeDirIdx].c_str());
 
-            // Create the compiler
-            IDxcCompiler* compiler;
-            DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler));
-
-            // Create the library
-            IDxcLibrary* library;
-            DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&library));
-
-            // Create an include handler
-            IDxcIncludeHandler* includeHandler;
-            library->CreateIncludeHandler(&includeHandler);
-
-            return create_vertex_graphics_pipeline(graphicsDevice, gpd, compiler, library, includeHandler, arguments, definesArray);
+            return create_vertex_graphics_pipeline(graphicsDevice, gpd, arguments, definesArray);
         }
 
         void destroy_graphics_pipeline(GraphicsPipeline graphicsPipeline)
@@ -421,14 +359,6 @@ namespace d3d12
             // Grab the internal structure
             DX12GraphicsPipeline* dx12_gp = (DX12GraphicsPipeline*)graphicsPipeline;
 
-            // Destroy all the descriptor heaps
-            uint32_t numDescriptorHeaps = (uint32_t)dx12_gp->CSUHeaps.size();
-            for (uint32_t heapIdx = 0; heapIdx < numDescriptorHeaps; ++heapIdx)
-            {
-                destroy_descriptor_heap(dx12_gp->CSUHeaps[heapIdx]);
-                destroy_descriptor_heap(dx12_gp->samplerHeaps[heapIdx]);
-            }
-
             // Destroy the dx12 objects
             dx12_gp->commandSignature->Release();
             dx12_gp->pipelineStateObject->Release();
@@ -461,5 +391,11 @@ namespace d3d12
             DX12GraphicsPipeline* dx12_gp = (DX12GraphicsPipeline*)graphicsPipeline;
             dx12_gp->stencilRef = stencilRef;
         }
+
+        const std::vector<std::string>& source_dependencies(GraphicsPipeline graphicsPipeline)
+        {
+            DX12GraphicsPipeline* dx12_gp = (DX12GraphicsPipeline*)graphicsPipeline;
+            return dx12_gp->dependencies;
+        }
     }
 }
@@ -34,18 +34,8 @@ namespace d3d12
 		Texture create_texture(GraphicsDevice graphicsDevice, const TextureDescriptor& rtDesc)
 		{
 			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
-			ID3D12Device1* device = deviceI->device;
 			assert(deviceI != nullptr);
 
-			// Define the heap
-			D3D12_HEAP_PROPERTIES heapProperties = {};
-			heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
-			heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-			heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-
-			// Not sure about this
-			heapProperties.VisibleNodeMask = 1;
-
 			D3D12_RESOURCE_DESC resourceDescriptor = {};
 			resourceDescriptor.Dimension = texture_dimension_to_dx12_resource_dimension(rtDesc.type);
 			resourceDescriptor.Width = rtDesc.width;
@@ -67,13 +57,14 @@ namespace d3d12
 			D3D12_RESOURCE_STATES state = rtDesc.isUAV ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : D3D12_RESOURCE_STATE_COMMON;
 
 			// Create the actual texture
-			ID3D12Resource* resource;
-			assert_msg(device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDescriptor, state, nullptr, IID_PPV_ARGS(&resource)) == S_OK, "Failed to create render target.");
+			DX12Allocation allocation;
+			ID3D12Resource* resource = create_placed_resource(deviceI, DX12HeapPoolType::Textures, resourceDescriptor, state, nullptr, allocation);
 
 			// Create the render texture internal structure
 			DX12Texture* dx12_texture = new DX12Texture();
 			dx12_texture->deviceI = deviceI;
 			dx12_texture->resource = resource;
+			dx12_texture->allocation = allocation;
 			dx12_texture->width = rtDesc.width;
 			dx12_texture->height = rtDesc.height;
 			dx12_texture->depth = rtDesc.depth;
@@ -93,7 +84,8 @@ namespace d3d12
 		void destroy_texture(Texture texture)
 		{
 			DX12Texture* dx12_graphicsTexture = (DX12Texture*)texture;
-			dx12_graphicsTexture->resource->Release();
+			release_cached_views(dx12_graphicsTexture->deviceI, dx12_graphicsTexture->views);
+			release_placed_resource(dx12_graphicsTexture->deviceI, dx12_graphicsTexture->resource, dx12_graphicsTexture->allocation);
 
 			// Resource tracking
 			dx12_graphicsTexture->deviceI->allocatedTextures--;
@@ -125,21 +117,11 @@ namespace d3d12
 			return create_render_texture(graphicsDevice, texDescriptor);
 		}
 
-		RenderTexture create_render_texture(GraphicsDevice graphicsDevice, const TextureDescriptor& rtDesc)
+		D3D12_RESOURCE_DESC render_texture_resource_desc(const TextureDescriptor& rtDesc)
 		{
-			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
-			ID3D12Device1* device = deviceI->device;
-			assert(deviceI != nullptr);
-
 			// Is this a regular render target or a depth stencil texture?
 			bool isDepth = is_depth_format(rtDesc.format);
 
-			// Define the heap
-			D3D12_HEAP_PROPERTIES heapProperties = {};
-			heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
-			heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-			heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-
 			// Create the resource
 			D3D12_RESOURCE_DESC resourceDescriptor = {};
 			resourceDescriptor.Dimension = texture_dimension_to_dx12_resource_dimension(rtDesc.type);
@@ -154,6 +136,21 @@ namespace d3d12
 			// This is a choice for now
 			resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
 
+			// Raise all the relevant flags
+			resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_NONE;
+			resourceDescriptor.Flags |= rtDesc.isUAV ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+			resourceDescriptor.Flags |= isDepth ? D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL : D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+			return resourceDescriptor;
+		}
+
+		// Shared by the render textures of the heap pools and the ones aliased in a transient heap
+		RenderTexture create_render_texture_internal(DX12GraphicsDevice* deviceI, const TextureDescriptor& rtDesc, DX12TransientHeap* transientHeap, uint64_t heapOffset)
+		{
+			assert(deviceI != nullptr);
+			ID3D12Device1* device = deviceI->device;
+			bool isDepth = is_depth_format(rtDesc.format);
+			D3D12_RESOURCE_DESC resourceDescriptor = render_texture_resource_desc(rtDesc);
+
 			// Define the clear value
 			D3D12_CLEAR_VALUE clearValue;
 			clearValue.Format = sanitize_dxgi_format_clear(resourceDescriptor.Format);
@@ -167,11 +164,6 @@ namespace d3d12
 				memcpy(clearValue.Color, &rtDesc.clearColor.x, 4 * sizeof(float));
 			}
 
-			// Raise all the relevant flags
-			resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_NONE;
-			resourceDescriptor.Flags |= rtDesc.isUAV ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
-			resourceDescriptor.Flags |= isDepth ? D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL : D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-				
 			// Resource states
 			D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
 			if (rtDesc.isUAV)
@@ -180,8 +172,9 @@ namespace d3d12
 				state |= isDepth ? D3D12_RESOURCE_STATE_DEPTH_WRITE : D3D12_RESOURCE_STATE_RENDER_TARGET;
 
 			// Create the actual texture
-			ID3D12Resource* resource;
-			assert_msg(device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES, &resourceDescriptor, state, &clearValue, IID_PPV_ARGS(&resource)) == S_OK, "Failed to create render target.");
+			DX12Allocation allocation;
+			ID3D12Resource* resource = transientHeap != nullptr ? create_aliased_resource(transientHeap, heapOffset, resourceDescriptor, state, &clearValue, allocation)
+				: create_placed_resource(deviceI, DX12HeapPoolType::RenderTextures, resourceDescriptor, state, &clearValue, allocation);
 			if (rtDesc.debugName != "")
 				resource->SetName(convert_to_wide(rtDesc.debugName).c_str());
 
@@ -205,6 +198,7 @@ namespace d3d12
 			DX12RenderTexture* dx12_renderTexture = new DX12RenderTexture();
 			dx12_renderTexture->deviceI = deviceI;
 			dx12_renderTexture->texture.resource = resource;
+			dx12_renderTexture->texture.allocation = allocation;
 			dx12_renderTexture->texture.width = rtDesc.width;
 			dx12_renderTexture->texture.height = rtDesc.height;
 			dx12_renderTexture->texture.depth = rtDesc.depth;
@@ -214,6 +208,7 @@ namespace d3d12
 			dx12_renderTexture->texture.state = state;
 			dx12_renderTexture->texture.type = rtDesc.type;
 			dx12_renderTexture->texture.isDepth = isDepth;
+			dx12_renderTexture->texture.needsInit = allocation.pool != UINT32_MAX;
 			dx12_renderTexture->descriptorHeap = descHeap;
 			dx12_renderTexture->heapOffset = 0;
 
@@ -224,11 +219,17 @@ namespace d3d12
 			return (RenderTexture)dx12_renderTexture;
 		}
 
+		RenderTexture create_render_texture(GraphicsDevice graphicsDevice, const TextureDescriptor& rtDesc)
+		{
+			return create_render_texture_internal((DX12GraphicsDevice*)graphicsDevice, rtDesc, nullptr, 0);
+		}
+
 		void destroy_render_texture(RenderTexture renderTexture)
 		{
 			DX12RenderTexture* dx12_graphicsTexture = (DX12RenderTexture*)renderTexture;
+			release_cached_views(dx12_graphicsTexture->deviceI, dx12_graphicsTexture->texture.views);
 			dx12_graphicsTexture->descriptorHeap->Release();
-			dx12_graphicsTexture->texture.resource->Release();
+			release_placed_resource(dx12_graphicsTexture->deviceI, dx12_graphicsTexture->texture.resource, dx12_graphicsTexture->texture.allocation);
 
 			// Resource tracking
 			dx12_graphicsTexture->deviceI->allocatedTextures--;
@@ -245,19 +246,8 @@ namespace d3d12
 			depth = dx12_graphicsTexture->texture.depth;
 		}
 
-		GraphicsBuffer create_graphics_buffer(GraphicsDevice graphicsDevice, uint64_t bufferSize, uint32_t elementSize, GraphicsBufferType bufferType, uint32_t)
+		D3D12_RESOURCE_DESC graphics_buffer_resource_desc(uint64_t bufferSize, GraphicsBufferType bufferType)
 		{
-			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
-
-			// Define the heap
-			D3D12_HEAP_PROPERTIES heapProperties = {};
-			heapProperties.Type = (bufferType == GraphicsBufferType::Default || bufferType == GraphicsBufferType::RTAS) ? D3D12_HEAP_TYPE_DEFAULT : (bufferType == GraphicsBufferType::Upload ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_READBACK);
-			heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-			heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-			heapProperties.CreationNodeMask = 0;
-			heapProperties.VisibleNodeMask = 0;
-
-			// Define the resource descriptor
 			D3D12_RESOURCE_DESC resourceDescriptor;
 			resourceDescriptor.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
 			resourceDescriptor.Alignment = 0;
@@ -271,6 +261,17 @@ namespace d3d12
 			resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 			resourceDescriptor.Flags = (bufferType == GraphicsBufferType::Default || bufferType == GraphicsBufferType::RTAS ) ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
 			resourceDescriptor.Flags |= (bufferType == GraphicsBufferType::RTAS ? D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE : D3D12_RESOURCE_FLAG_NONE);
+			return resourceDescriptor;
+		}
+
+		// Shared by the buffers of the heap pools and the ones aliased in a transient heap, the aliased ones are always default buffers
+		GraphicsBuffer create_graphics_buffer_internal(DX12GraphicsDevice* deviceI, uint64_t bufferSize, uint32_t elementSize, GraphicsBufferType bufferType, DX12TransientHeap* transientHeap, uint64_t heapOffset)
+		{
+			// Pick the heap pool
+			DX12HeapPoolType poolType = (bufferType == GraphicsBufferType::Default || bufferType == GraphicsBufferType::RTAS) ? DX12HeapPoolType::Buffers : (bufferType == GraphicsBufferType::Upload ? DX12HeapPoolType::UploadBuffers : DX12HeapPoolType::ReadbackBuffers);
+
+			// Define the resource descriptor
+			D3D12_RESOURCE_DESC resourceDescriptor = graphics_buffer_resource_desc(bufferSize, bufferType);
 
 			// Resource states
 			D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
@@ -282,14 +283,16 @@ namespace d3d12
 				state = D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE;
 
 			// Create the resource
-			ID3D12Resource* buffer;
-			assert_msg(deviceI->device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDescriptor, state, nullptr, IID_PPV_ARGS(&buffer)) == S_OK, "Failed to create the graphics buffer.");
+			DX12Allocation allocation;
+			ID3D12Resource* buffer = transientHeap != nullptr ? create_aliased_resource(transientHeap, heapOffset, resourceDescriptor, state, nullptr, allocation)
+				: create_placed_resource(deviceI, poolType, resourceDescriptor, state, nullptr, allocation);
 			deviceI->allocatedMemory += bufferSize;
 
 			// Create the buffer internal structure
 			DX12GraphicsBuffer* dx12_graphicsBuffer = new DX12GraphicsBuffer();
 			dx12_graphicsBuffer->device = deviceI;
 			dx12_graphicsBuffer->resource = buffer;
+			dx12_graphicsBuffer->allocation = allocation;
 			dx12_graphicsBuffer->state = state;
 			dx12_graphicsBuffer->heapType = bufferType;
 			dx12_graphicsBuffer->bufferSize = bufferSize;
@@ -302,10 +305,16 @@ namespace d3d12
 			return (GraphicsBuffer)dx12_graphicsBuffer;
 		}
 
+		GraphicsBuffer create_graphics_buffer(GraphicsDevice graphicsDevice, uint64_t bufferSize, uint32_t elementSize, GraphicsBufferType bufferType, uint32_t)
+		{
+			return create_graphics_buffer_internal((DX12GraphicsDevice*)graphicsDevice, bufferSize, elementSize, bufferType, nullptr, 0);
+		}
+
 		void destroy_graphics_buffer(GraphicsBuffer graphicsBuffer)
 		{
 			DX12GraphicsBuffer* dx12_buffer = (DX12GraphicsBuffer*)graphicsBuffer;
-			dx12_buffer->resource->Release();
+			release_cached_views(dx12_buffer->device, dx12_buffer->views);
+			release_placed_resource(dx12_buffer->device, dx12_buffer->resource, dx12_buffer->allocation);
 			dx12_buffer->device->allocatedMemory -= dx12_buffer->bufferSize;
 
 			// Resource tracking
@@ -360,6 +369,63 @@ namespace d3d12
 			dx12_buffer->resource->SetName(wname.c_str());
 		}
 
+		TransientHeap create_transient_heap(GraphicsDevice graphicsDevice, uint64_t heapSize)
+		{
+			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
+
+			// Buffers and render textures share the heap, which needs a resource heap tier 2
+			D3D12_HEAP_DESC heapDesc = {};
+			heapDesc.SizeInBytes = heapSize;
+			heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+			heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+			heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+			heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+			heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES;
+
+			DX12TransientHeap* dx12_heap = new DX12TransientHeap();
+			dx12_heap->deviceI = deviceI;
+			dx12_heap->size = heapSize;
+			assert_msg(deviceI->device->CreateHeap(&heapDesc, IID_PPV_ARGS(&dx12_heap->heap)) == S_OK, "Failed to create transient heap.");
+			return (TransientHeap)dx12_heap;
+		}
+
+		void destroy_transient_heap(TransientHeap transientHeap)
+		{
+			DX12TransientHeap* dx12_heap = (DX12TransientHeap*)transientHeap;
+			dx12_heap->heap->Release();
+			delete dx12_heap;
+		}
+
+		void graphics_buffer_footprint(GraphicsDevice graphicsDevice, uint64_t bufferSize, uint64_t& size, uint64_t& alignment)
+		{
+			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
+			const D3D12_RESOURCE_DESC resourceDescriptor = graphics_buffer_resource_desc(bufferSize, GraphicsBufferType::Default);
+			const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = deviceI->device->GetResourceAllocationInfo(0, 1, &resourceDescriptor);
+			size = allocationInfo.SizeInBytes;
+			alignment = allocationInfo.Alignment;
+		}
+
+		void render_texture_footprint(GraphicsDevice graphicsDevice, const TextureDescriptor& rtDesc, uint64_t& size, uint64_t& alignment)
+		{
+			DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
+			const D3D12_RESOURCE_DESC resourceDescriptor = render_texture_resource_desc(rtDesc);
+			const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = deviceI->device->GetResourceAllocationInfo(0, 1, &resourceDescriptor);
+			size = allocationInfo.SizeInBytes;
+			alignment = allocationInfo.Alignment;
+		}
+
+		GraphicsBuffer create_aliased_graphics_buffer(TransientHeap transientHeap, uint64_t heapOffset, uint64_t bufferSize, uint32_t elementSize, uint32_t)
+		{
+			DX12TransientHeap* dx12_heap = (DX12TransientHeap*)transientHeap;
+			return create_graphics_buffer_internal(dx12_heap->deviceI, bufferSize, elementSize, GraphicsBufferType::Default, dx12_heap, heapOffset);
+		}
+
+		RenderTexture create_aliased_render_texture(TransientHeap transientHeap, uint64_t heapOffset, const TextureDescriptor& rtDesc)
+		{
+			DX12TransientHeap* dx12_heap = (DX12TransientHeap*)transientHeap;
+			return create_render_texture_internal(dx12_heap->deviceI, rtDesc, dx12_heap, heapOffset);
+		}
+
 		ConstantBuffer create_constant_buffer(GraphicsDevice graphicsDevice, uint32_t elementSize, ConstantBufferType bufferType)
 		{
 			// The size needs to be aligned on 256
@@ -443,6 +509,9 @@ namespace d3d12
 		void destroy_sampler(Sampler sampler)
 		{
 			DX12Sampler* beSampler = (DX12Sampler*)sampler;
+			if (beSampler->view.slot != UINT32_MAX)
+				release_staging_descriptor(beSampler->deviceI->stagingSampler, beSampler->view.slot);
+
 			// Resource tracking
 			beSampler->deviceI->allocatedSamplers--;
 			delete beSampler;
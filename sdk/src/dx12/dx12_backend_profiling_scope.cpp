@@ -16,20 +16,20 @@ namespace d3d12
 {
     namespace profiling_scope
     {
-        ProfilingScope create_profiling_scope(GraphicsDevice graphicsDevice)
+        ProfilingScope create_profiling_scope(GraphicsDevice graphicsDevice, uint32_t numTimestamps)
         {
             // Grab the device
             DX12GraphicsDevice* deviceI = (DX12GraphicsDevice*)graphicsDevice;
 
             // Create the query heap
             D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
-            queryHeapDesc.Count = 2;
+            queryHeapDesc.Count = numTimestamps;
             queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
             ID3D12QueryHeap* queryHeap;
             assert_msg(deviceI->device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&queryHeap)) == S_OK, "Failed to create query.");
 
             // Define the resource descriptor
-            D3D12_RESOURCE_DESC resourceDescriptor = { D3D12_RESOURCE_DIMENSION_BUFFER, 0, sizeof(uint64_t) * 2, 1, 1, 1, DXGI_FORMAT_UNKNOWN, 1, 0, D3D12_TEXTURE_LAYOUT_ROW_MAJOR, D3D12_RESOURCE_FLAG_NONE };
+            D3D12_RESOURCE_DESC resourceDescriptor = { D3D12_RESOURCE_DIMENSION_BUFFER, 0, sizeof(uint64_t) * numTimestamps, 1, 1, 1, DXGI_FORMAT_UNKNOWN, 1, 0, D3D12_TEXTURE_LAYOUT_ROW_MAJOR, D3D12_RESOURCE_FLAG_NONE };
 
             D3D12_HEAP_PROPERTIES heap;
             memset(&heap, 0, sizeof(heap));
@@ -57,17 +57,65 @@ namespace d3d12
             delete query;
         }
 
-        uint64_t get_duration_us(ProfilingScope profilingScope, CommandQueue cmdQ, CommandBufferType)
+        uint64_t get_duration_us(ProfilingScope profilingScope, CommandQueue cmdQ, CommandBufferType type)
         {
             DX12Query* query = (DX12Query*)profilingScope;
             DX12CommandQueue* dx12_cmdQ = (DX12CommandQueue*)cmdQ;
 
+            // The timestamps are in ticks of the queue the scope was recorded on
+            uint64_t frequency = dx12_cmdQ->directSubQueue.frequency;
+            if (type == CommandBufferType::Compute)
+                frequency = dx12_cmdQ->computeSubQueue.frequency;
+            else if (type == CommandBufferType::Copy)
+                frequency = dx12_cmdQ->copySubQueue.frequency;
+
             char* data = nullptr;
             D3D12_RANGE range = { 0, sizeof(uint64_t) * 2 };
             query->result->Map(0, &range, (void**)&data);
             uint64_t profileDuration = ((uint64_t*)data)[1] - ((uint64_t*)data)[0];
             query->result->Unmap(0, nullptr);
-            return (uint64_t)(profileDuration / (double)dx12_cmdQ->directSubQueue.frequency * 1e6);
+            return (uint64_t)(profileDuration / (double)frequency * 1e6);
+        }
+
+        void read_timestamps(ProfilingScope profilingScope, uint32_t first, uint32_t count, uint64_t* outTicks)
+        {
+            DX12Query* query = (DX12Query*)profilingScope;
+
+            // Only the requested range is read, the CPU doesn't write anything
+            char* data = nullptr;
+            D3D12_RANGE range = { sizeof(uint64_t) * first, sizeof(uint64_t) * (first + count) };
+            query->result->Map(0, &range, (void**)&data);
+            memcpy(outTicks, data + range.Begin, sizeof(uint64_t) * count);
+            D3D12_RANGE writtenRange = { 0, 0 };
+            query->result->Unmap(0, &writtenRange);
+        }
+
+        uint64_t timestamp_frequency(CommandQueue cmdQ, CommandBufferType type)
+        {
+            DX12CommandQueue* dx12_cmdQ = (DX12CommandQueue*)cmdQ;
+            if (type == CommandBufferType::Compute)
+                return dx12_cmdQ->computeSubQueue.frequency;
+            else if (type == CommandBufferType::Copy)
+                return dx12_cmdQ->copySubQueue.frequency;
+            return dx12_cmdQ->directSubQueue.frequency;
+        }
+
+        void clock_calibration(CommandQueue cmdQ, CommandBufferType type, uint64_t& outGPUTicks, uint64_t& outCPUTimeNS)
+        {
+            DX12CommandQueue* dx12_cmdQ = (DX12CommandQueue*)cmdQ;
+            ID3D12CommandQueue* queue = dx12_cmdQ->directSubQueue.queue;
+            if (type == CommandBufferType::Compute)
+                queue = dx12_cmdQ->computeSubQueue.queue;
+            else if (type == CommandBufferType::Copy)
+                queue = dx12_cmdQ->copySubQueue.queue;
+
+            // The CPU side is a performance counter value, which is what the steady clock counts on Windows
+            uint64_t cpuTicks = 0;
+            assert_msg(queue->GetClockCalibration(&outGPUTicks, &cpuTicks) == S_OK, "Failed to calibrate the GPU clock.");
+            LARGE_INTEGER cpuFrequency;
+            QueryPerformanceFrequency(&cpuFrequency);
+            const uint64_t frequency = (uint64_t)cpuFrequency.QuadPart;
+            outCPUTimeNS = cpuTicks / frequency * 1000000000ull + cpuTicks % frequency * 1000000000ull / frequency;
         }
     }
 }
@@ -96,6 +96,8 @@ namespace d3d12
 				currentTexture.texture.state = D3D12_RESOURCE_STATE_PRESENT;
 				currentTexture.texture.type = TextureType::Tex2D;
 				currentTexture.descriptorHeap = swapChainI->descriptorHeap;
+				currentTexture.deviceI = deviceI;
+				currentTexture.texture.deviceI = deviceI;
 				currentTexture.heapOffset = deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_RTV] * n;
 
 				// Grab the buffer of the swap chain
@@ -119,7 +121,11 @@ namespace d3d12
 
 			// Release the render target views
 			for (uint32_t n = 0; n < DX12_NUM_FRAMES; n++)
-				dx12_swapChain->backBufferRenderTextures[n].texture.resource->Release();
+			{
+				DX12RenderTexture& currentTexture = dx12_swapChain->backBufferRenderTextures[n];
+				release_cached_views(currentTexture.deviceI, currentTexture.texture.views);
+				currentTexture.texture.resource->Release();
+			}
 
 			// Release the DX12 structures
 			dx12_swapChain->descriptorHeap->Release();
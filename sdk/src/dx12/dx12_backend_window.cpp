@@ -14,20 +14,24 @@
 
 // System incldues
 #include <windowsx.h>
+#include <future>
+#include <memory>
+
+// Messages posted to the window thread by the render loop
+#define WM_DESTROY_RENDER_WINDOW (WM_APP + 0)
+#define WM_SET_CURSOR_VISIBILITY (WM_APP + 1)
 
 namespace d3d12
 {
 	namespace window
 	{
-		void handle_messages(RenderWindow)
+		void handle_messages(RenderWindow renderWindow)
 		{
-			// Poll and handle messages
-			MSG msg = {};
-			if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
-			{
-				TranslateMessage(&msg);
-				DispatchMessage(&msg);
-			}
+			// The messages are pumped by the window thread, the input doesn't wait for the frames anymore.
+			// Ask for the next WM_PAINT, the window validates each of them so that its thread sleeps in between.
+			// The render loop waits for it with event_collector::wait_for_activity instead of spinning
+			DX12Window* dx12_window = (DX12Window*)renderWindow;
+			InvalidateRect(dx12_window->window, nullptr, FALSE);
 		}
 
 		LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
@@ -47,12 +51,21 @@ namespace d3d12
 			{
 				case WM_PAINT:
 					event_collector::request_draw();
+					ValidateRect(hwnd, nullptr);
 					break;
 				case WM_CLOSE:
 					event_collector::push_event({FrameEvent::Close, 0, 0});
 					break;
 				case WM_DESTROY:
 					event_collector::push_event({FrameEvent::Destroy, 0, 0});
+					PostQuitMessage(0);
+					break;
+				case WM_DESTROY_RENDER_WINDOW:
+					assert_msg(DestroyWindow(hwnd), "Failed to destroy window.");
+					break;
+				case WM_SET_CURSOR_VISIBILITY:
+					// The display counter of the cursor belongs to the thread of the window
+					ShowCursor((BOOL)wParam);
 					break;
 				case WM_MOUSEMOVE:
 				{
@@ -157,34 +170,18 @@ namespace d3d12
 			return hWnd;
 		}
 
-		RenderWindow create_window(GraphicsDevice, uint64_t hInstance, uint32_t width, uint32_t height, const char* windowName)
+		// Body of the window thread: creates the window, hands it over and pumps its messages until it is destroyed
+		void WindowThread(HINSTANCE hInst, uint32_t width, uint32_t height, std::string windowName, std::shared_ptr<std::promise<HWND>> created)
 		{
-			// Create the window internal structure
-			DX12Window* dx12_window = new DX12Window();
-
-			// Grab the instance
-			HINSTANCE hInst = (HINSTANCE)hInstance;
-
-			// Register the window class
-			RegisterWindowClass(hInst, "TSNCWindow");
-
-			// Handle the mouse
-			TRACKMOUSEEVENT tme;
-			tme.cbSize = sizeof(tme);
-			tme.hwndTrack = dx12_window->window;
-			tme.dwFlags = TME_HOVER | TME_LEAVE;
-			tme.dwHoverTime = HOVER_DEFAULT;
-			TrackMouseEvent(&tme);
-
 			// Evaluate the actual size and location of the window
 			int32_t windowWidth = 1, windowHeight = 1, windowX = 0, windowY = 0;
 			EvaluateWindowParameters(width, height, windowWidth, windowHeight, windowX, windowY);
 
 			// Create the window
-			dx12_window->window = CreateWindowExA(
+			HWND window = CreateWindowExA(
 				0,												// Optional window styles.
 				"TSNCWindow",								// Window class
-				windowName,										// Window text
+				windowName.c_str(),								// Window text
 				WS_OVERLAPPEDWINDOW,							// Window style
 
 				// Size and position
@@ -195,10 +192,50 @@ namespace d3d12
 				hInst,		// Instance handle
 				NULL        // Additional application data
 			);
-			assert_msg(dx12_window->window != nullptr, "Failed to create window.");
+			assert_msg(window != nullptr, "Failed to create window.");
 
-			// Show the window
-			ShowWindow(dx12_window->window, SW_SHOWDEFAULT);
+			// Handle the mouse
+			TRACKMOUSEEVENT tme;
+			tme.cbSize = sizeof(tme);
+			tme.hwndTrack = window;
+			tme.dwFlags = TME_HOVER | TME_LEAVE;
+			tme.dwHoverTime = HOVER_DEFAULT;
+			TrackMouseEvent(&tme);
+
+			// Show the window and hand it over
+			ShowWindow(window, SW_SHOWDEFAULT);
+			created->set_value(window);
+
+			// Blocking pump, every message is handled as soon as it arrives
+			MSG msg = {};
+			while (GetMessage(&msg, NULL, 0, 0) > 0)
+			{
+				TranslateMessage(&msg);
+				DispatchMessage(&msg);
+			}
+		}
+
+		RenderWindow create_window(GraphicsDevice, uint64_t hInstance, uint32_t width, uint32_t height, const char* windowName)
+		{
+			// Create the window internal structure
+			DX12Window* dx12_window = new DX12Window();
+
+			// Grab the instance
+			HINSTANCE hInst = (HINSTANCE)hInstance;
+
+			// Register the window class
+			RegisterWindowClass(hInst, "TSNCWindow");
+
+			// The window belongs to its own thread, wait for it to exist
+			std::shared_ptr<std::promise<HWND>> created = std::make_shared<std::promise<HWND>>();
+			std::future<HWND> window = created->get_future();
+			dx12_window->messageThread = std::thread(WindowThread, hInst, width, height, std::string(windowName), created);
+			dx12_window->window = window.get();
+
+			// ImGui handles the raw messages on this thread, it has to see the capture, focus and key state of the window thread
+			dx12_window->renderThreadId = GetCurrentThreadId();
+			dx12_window->messageThreadId = GetWindowThreadProcessId(dx12_window->window, nullptr);
+			assert_msg(AttachThreadInput(dx12_window->renderThreadId, dx12_window->messageThreadId, TRUE), "AttachThreadInput failed.");
 
 			// Cast the window to the opaque type
 			return (RenderWindow)dx12_window;
@@ -209,8 +246,10 @@ namespace d3d12
 			// Grab the internal windows structure
 			DX12Window* dx12_window = (DX12Window*)renderWindow;
 
-			// Destroy the actual window
-			assert_msg(DestroyWindow(dx12_window->window), "Failed to destroy window.");
+			// Detach the input states, then destroy the actual window on its thread and wait for the thread to stop
+			AttachThreadInput(dx12_window->renderThreadId, dx12_window->messageThreadId, FALSE);
+			PostMessage(dx12_window->window, WM_DESTROY_RENDER_WINDOW, 0, 0);
+			dx12_window->messageThread.join();
 
 			// Clear all the events
 			event_collector::clear();
@@ -231,9 +270,10 @@ namespace d3d12
 			ShowWindow(dx12_window->window, SW_HIDE);
 		}
 
-		void set_cursor_visibility(RenderWindow, bool state)
+		void set_cursor_visibility(RenderWindow renderWindow, bool state)
 		{
-			ShowCursor(state);
+			DX12Window* dx12_window = (DX12Window*)renderWindow;
+			PostMessage(dx12_window->window, WM_SET_CURSOR_VISIBILITY, (WPARAM)state, 0);
 		}
 
 		void set_cursor_pos(RenderWindow window, uint2 position)
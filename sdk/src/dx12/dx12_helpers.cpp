@@ -7,7 +7,11 @@
 
 // SDK includes
 #include "dx12/dx12_helpers.h"
+#include "tools/file_watcher.h"
 #include "tools/security.h"
+#include "tools/shader_archive.h"
+#include "tools/shader_cache.h"
+#include "tools/string_utilities.h"
 
 // System includes
 #include <algorithm>
@@ -283,7 +287,7 @@ namespace d3d12
         return D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
     }
 
-    ID3D12DescriptorHeap* create_descriptor_heap_internal(DX12GraphicsDevice* deviceI, uint32_t numDescriptors, uint32_t opaqueType)
+    ID3D12DescriptorHeap* create_descriptor_heap_internal(DX12GraphicsDevice* deviceI, uint32_t numDescriptors, uint32_t opaqueType, bool shaderVisible)
     {
         // Get the actual type
         D3D12_DESCRIPTOR_HEAP_TYPE type = (D3D12_DESCRIPTOR_HEAP_TYPE)opaqueType;
@@ -292,7 +296,7 @@ namespace d3d12
         D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
         rtvHeapDesc.NumDescriptors = numDescriptors;
         rtvHeapDesc.Type = type;
-        if (type == D3D12_DESCRIPTOR_HEAP_TYPE_RTV || type == D3D12_DESCRIPTOR_HEAP_TYPE_DSV)
+        if (type == D3D12_DESCRIPTOR_HEAP_TYPE_RTV || type == D3D12_DESCRIPTOR_HEAP_TYPE_DSV || !shaderVisible)
             rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
         else
             rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
@@ -307,52 +311,426 @@ namespace d3d12
         descriptorHeap->Release();
     }
 
-    DX12DescriptorHeap create_descriptor_heap_suc(DX12GraphicsDevice* deviceI, uint32_t srvCount, uint32_t uavCount, uint32_t cbvCount)
+    DX12StagingHeap* create_staging_heap(D3D12_DESCRIPTOR_HEAP_TYPE type)
     {
-        // Create the descriptor heap for this compute shader
-        DX12DescriptorHeap descriptorHeap;
-        ID3D12DescriptorHeap* descHeap = create_descriptor_heap_internal(deviceI, srvCount + uavCount + cbvCount, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-        descriptorHeap.descriptorHeap = descHeap;
-        descriptorHeap.type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        DX12StagingHeap* stagingHeap = new DX12StagingHeap();
+        stagingHeap->type = type;
+        return stagingHeap;
+    }
+
+    void destroy_staging_heap(DX12StagingHeap* stagingHeap)
+    {
+        // Every view should have been released with its resource
+        assert_msg(stagingHeap->freeSlots.size() == stagingHeap->numSlots, "Staging heap has still active views.");
+        for (ID3D12DescriptorHeap* page : stagingHeap->pages)
+            page->Release();
+        delete stagingHeap;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE allocate_staging_descriptor(DX12GraphicsDevice* deviceI, DX12StagingHeap* stagingHeap, uint32_t& outSlot)
+    {
+        // Reuse a released slot if possible, otherwise append one and add a page when needed
+        if (!stagingHeap->freeSlots.empty())
+        {
+            outSlot = stagingHeap->freeSlots.back();
+            stagingHeap->freeSlots.pop_back();
+        }
+        else
+        {
+            outSlot = stagingHeap->numSlots++;
+            if (outSlot / DX12_STAGING_PAGE_SIZE == stagingHeap->pages.size())
+                stagingHeap->pages.push_back(create_descriptor_heap_internal(deviceI, DX12_STAGING_PAGE_SIZE, stagingHeap->type, false));
+        }
+
+        // Evaluate the CPU handle
+        D3D12_CPU_DESCRIPTOR_HANDLE handle = stagingHeap->pages[outSlot / DX12_STAGING_PAGE_SIZE]->GetCPUDescriptorHandleForHeapStart();
+        handle.ptr += (uint64_t)deviceI->descriptorSize[stagingHeap->type] * (outSlot % DX12_STAGING_PAGE_SIZE);
+        return handle;
+    }
+
+    void release_staging_descriptor(DX12StagingHeap* stagingHeap, uint32_t slot)
+    {
+        stagingHeap->freeSlots.push_back(slot);
+    }
+
+    const DX12CachedView* find_cached_view(const std::vector<DX12CachedView>& views, DX12ViewType type, uint64_t parameter)
+    {
+        // Resources only have a handful of views
+        for (const DX12CachedView& view : views)
+        {
+            if (view.type == type && view.parameter == parameter)
+                return &view;
+        }
+        return nullptr;
+    }
+
+    void release_cached_views(DX12GraphicsDevice* deviceI, std::vector<DX12CachedView>& views)
+    {
+        for (const DX12CachedView& view : views)
+            release_staging_descriptor(view.type == DX12ViewType::Sampler ? deviceI->stagingSampler : deviceI->stagingCSU, view.slot);
+        views.clear();
+    }
+
+    void create_descriptor_rings(DX12GraphicsDevice* deviceI)
+    {
+        // Staging heaps
+        deviceI->stagingCSU = create_staging_heap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        deviceI->stagingSampler = create_staging_heap(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
+        // Shader visible rings
+        deviceI->ringHeapCSU = create_descriptor_heap_internal(deviceI, DX12_DESCRIPTOR_RING_SIZE, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        deviceI->ringHeapSampler = create_descriptor_heap_internal(deviceI, DX12_SAMPLER_RING_SIZE, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+        deviceI->ringCSU.initialize(DX12_DESCRIPTOR_RING_SIZE);
+        deviceI->ringSampler.initialize(DX12_SAMPLER_RING_SIZE);
+    }
+
+    void destroy_descriptor_rings(DX12GraphicsDevice* deviceI)
+    {
+        deviceI->ringCSU.release();
+        deviceI->ringSampler.release();
+        deviceI->ringHeapCSU->Release();
+        deviceI->ringHeapSampler->Release();
+        destroy_staging_heap(deviceI->stagingCSU);
+        destroy_staging_heap(deviceI->stagingSampler);
+        deviceI->timelines.clear();
+    }
+
+    uint32_t register_timeline(DX12GraphicsDevice* deviceI, ID3D12Fence* fence)
+    {
+        deviceI->timelines.push_back(fence);
+        return (uint32_t)deviceI->timelines.size() - 1;
+    }
+
+    void unregister_timeline(DX12GraphicsDevice* deviceI, uint32_t timeline)
+    {
+        // The queue is gone, so is all the work that was submitted to it
+        deviceI->timelines[timeline] = nullptr;
+    }
+
+    void retire_descriptor_tables(DX12GraphicsDevice* deviceI)
+    {
+        // Grab the progress of every queue
+        uint32_t numTimelines = (uint32_t)deviceI->timelines.size();
+        std::vector<uint64_t> completedValues(numTimelines);
+        for (uint32_t timelineIdx = 0; timelineIdx < numTimelines; ++timelineIdx)
+        {
+            ID3D12Fence* fence = deviceI->timelines[timelineIdx];
+            completedValues[timelineIdx] = fence != nullptr ? fence->GetCompletedValue() : UINT64_MAX;
+        }
+
+        // Recycle the blocks that are not referenced anymore
+        deviceI->ringCSU.retire(completedValues);
+        deviceI->ringSampler.retire(completedValues);
+    }
+
+    uint32_t allocate_descriptor_table(DX12GraphicsDevice* deviceI, DescriptorRing& ring, DX12DescriptorChunk& chunk, std::vector<uint32_t>& blocks, uint32_t chunkSize, uint32_t count)
+    {
+        // Grab a new block of the ring if the current one is exhausted
+        if (chunk.offset == UINT32_MAX || chunk.used + count > chunk.size)
+        {
+            uint32_t size = std::max(chunkSize, count);
+            uint32_t offset = ring.allocate(size);
+            if (offset == UINT32_MAX)
+            {
+                retire_descriptor_tables(deviceI);
+                offset = ring.allocate(size);
+            }
+            assert_msg(offset != UINT32_MAX, "The descriptor ring is full.");
+            chunk.offset = offset;
+            chunk.size = size;
+            chunk.used = 0;
+            blocks.push_back(offset);
+        }
+
+        // Sub-allocate the table
+        uint32_t tableOffset = chunk.offset + chunk.used;
+        chunk.used += count;
+        return tableOffset;
+    }
 
-        // Pre-evaluate the CPU Heap handles
+    D3D12_GPU_DESCRIPTOR_HANDLE copy_descriptor_table(DX12CommandBuffer* commandBuffer, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t tableOffset, ID3D12DescriptorHeap* ringHeap, const std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& boundDescriptors)
+    {
+        DX12GraphicsDevice* deviceI = commandBuffer->deviceI;
+        uint32_t descSize = deviceI->descriptorSize[type];
+
+        // Gather the bound views, the slots that were never bound are left untouched
+        D3D12_CPU_DESCRIPTOR_HANDLE tableStart = ringHeap->GetCPUDescriptorHandleForHeapStart();
+        tableStart.ptr += (uint64_t)descSize * tableOffset;
+        commandBuffer->copySources.clear();
+        commandBuffer->copyDestinations.clear();
+        uint32_t numDescriptors = (uint32_t)boundDescriptors.size();
+        for (uint32_t descIdx = 0; descIdx < numDescriptors; ++descIdx)
+        {
+            if (boundDescriptors[descIdx].ptr == 0)
+                continue;
+            D3D12_CPU_DESCRIPTOR_HANDLE destination = tableStart;
+            destination.ptr += (uint64_t)descSize * descIdx;
+            commandBuffer->copySources.push_back(boundDescriptors[descIdx]);
+            commandBuffer->copyDestinations.push_back(destination);
+        }
+
+        // Single copy call for the whole table, all the ranges have one descriptor
+        uint32_t numCopies = (uint32_t)commandBuffer->copySources.size();
+        if (numCopies > 0)
+            deviceI->device->CopyDescriptors(numCopies, commandBuffer->copyDestinations.data(), nullptr, numCopies, commandBuffer->copySources.data(), nullptr, type);
+
+        // GPU handle of the table
+        D3D12_GPU_DESCRIPTOR_HANDLE tableGPU = ringHeap->GetGPUDescriptorHandleForHeapStart();
+        tableGPU.ptr += (uint64_t)descSize * tableOffset;
+        return tableGPU;
+    }
+
+    void bind_descriptor_tables(DX12CommandBuffer* commandBuffer, const DX12RootSignature* rootSignature, bool compute,
+                                const std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& boundCSU, uint32_t srvCount, uint32_t uavCount, const std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& boundSamplers)
+    {
+        DX12GraphicsDevice* deviceI = commandBuffer->deviceI;
+        ID3D12GraphicsCommandList* cmdList = commandBuffer->cmdList();
+
+        // Fill fresh tables with the staged views
+        D3D12_GPU_DESCRIPTOR_HANDLE csuTable = {};
+        if (boundCSU.size() > 0)
+        {
+            uint32_t tableOffset = allocate_descriptor_table(deviceI, deviceI->ringCSU, commandBuffer->csuChunk, commandBuffer->csuBlocks, DX12_DESCRIPTOR_CHUNK_SIZE, (uint32_t)boundCSU.size());
+            csuTable = copy_descriptor_table(commandBuffer, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, tableOffset, deviceI->ringHeapCSU, boundCSU);
+        }
+        D3D12_GPU_DESCRIPTOR_HANDLE samplerTable = {};
+        if (boundSamplers.size() > 0)
+        {
+            uint32_t tableOffset = allocate_descriptor_table(deviceI, deviceI->ringSampler, commandBuffer->samplerChunk, commandBuffer->samplerBlocks, DX12_SAMPLER_CHUNK_SIZE, (uint32_t)boundSamplers.size());
+            samplerTable = copy_descriptor_table(commandBuffer, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, tableOffset, deviceI->ringHeapSampler, boundSamplers);
+        }
+
+        // Bind the shared heaps
+        ID3D12DescriptorHeap* ppHeaps[] = { deviceI->ringHeapCSU, deviceI->ringHeapSampler };
+        cmdList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
+
+        // Evaluate the location of every table, the SRVs are followed by the UAVs and the CBVs
         uint32_t descSize = deviceI->descriptorSize[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV];
-        descriptorHeap.srvCPU = descHeap->GetCPUDescriptorHandleForHeapStart();
-        descriptorHeap.uavCPU = descriptorHeap.srvCPU;
-        descriptorHeap.uavCPU.ptr += (uint64_t)srvCount * descSize;
-        descriptorHeap.cbvCPU = descriptorHeap.uavCPU;
-        descriptorHeap.cbvCPU.ptr += (uint64_t)uavCount * descSize;
-
-        // Pre-evaluate the GPU Heap handles
-        descriptorHeap.srvGPU = descHeap->GetGPUDescriptorHandleForHeapStart();
-        descriptorHeap.uavGPU = descriptorHeap.srvGPU;
-        descriptorHeap.uavGPU.ptr += (uint64_t)srvCount * descSize;
-        descriptorHeap.cbvGPU = descriptorHeap.uavGPU;
-        descriptorHeap.cbvGPU.ptr += (uint64_t)uavCount * descSize;
+        D3D12_GPU_DESCRIPTOR_HANDLE srvTable = csuTable;
+        D3D12_GPU_DESCRIPTOR_HANDLE uavTable = srvTable;
+        uavTable.ptr += (uint64_t)descSize * srvCount;
+        D3D12_GPU_DESCRIPTOR_HANDLE cbvTable = uavTable;
+        cbvTable.ptr += (uint64_t)descSize * uavCount;
+
+        // Bind the tables
+        if (compute)
+        {
+            if (rootSignature->srvIndex != UINT32_MAX)
+                cmdList->SetComputeRootDescriptorTable(rootSignature->srvIndex, srvTable);
+            if (rootSignature->uavIndex != UINT32_MAX)
+                cmdList->SetComputeRootDescriptorTable(rootSignature->uavIndex, uavTable);
+            if (rootSignature->cbvIndex != UINT32_MAX)
+                cmdList->SetComputeRootDescriptorTable(rootSignature->cbvIndex, cbvTable);
+            if (rootSignature->samplerIndex != UINT32_MAX)
+                cmdList->SetComputeRootDescriptorTable(rootSignature->samplerIndex, samplerTable);
+        }
+        else
+        {
+            if (rootSignature->srvIndex != UINT32_MAX)
+                cmdList->SetGraphicsRootDescriptorTable(rootSignature->srvIndex, srvTable);
+            if (rootSignature->uavIndex != UINT32_MAX)
+                cmdList->SetGraphicsRootDescriptorTable(rootSignature->uavIndex, uavTable);
+            if (rootSignature->cbvIndex != UINT32_MAX)
+                cmdList->SetGraphicsRootDescriptorTable(rootSignature->cbvIndex, cbvTable);
+            if (rootSignature->samplerIndex != UINT32_MAX)
+                cmdList->SetGraphicsRootDescriptorTable(rootSignature->samplerIndex, samplerTable);
+        }
+    }
 
-        return descriptorHeap;
+    void submit_descriptor_tables(DX12CommandBuffer* commandBuffer, uint32_t timeline, uint64_t fenceValue)
+    {
+        DX12GraphicsDevice* deviceI = commandBuffer->deviceI;
+
+        // The blocks stay alive until the fence is reached
+        for (uint32_t offset : commandBuffer->csuBlocks)
+            deviceI->ringCSU.submit(offset, timeline, fenceValue);
+        for (uint32_t offset : commandBuffer->samplerBlocks)
+            deviceI->ringSampler.submit(offset, timeline, fenceValue);
+        commandBuffer->csuBlocks.clear();
+        commandBuffer->samplerBlocks.clear();
+
+        // The next recording starts with new blocks
+        commandBuffer->csuChunk = DX12DescriptorChunk();
+        commandBuffer->samplerChunk = DX12DescriptorChunk();
     }
 
-    DX12DescriptorHeap create_descriptor_heap_sampler(DX12GraphicsDevice* deviceI, uint32_t samplerCount)
+    void create_heap_pools(DX12GraphicsDevice* deviceI)
     {
-        // Create the descriptor heap for this compute shader
-        DX12DescriptorHeap descriptorHeap;
-        ID3D12DescriptorHeap* descHeap = create_descriptor_heap_internal(deviceI, samplerCount, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
-        descriptorHeap.descriptorHeap = descHeap;
-        descriptorHeap.type = D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
+        // Heap type, allowed resources and placement alignment of every pool
+        const D3D12_HEAP_TYPE types[] = { D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_TYPE_READBACK, D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_DEFAULT };
+        const D3D12_HEAP_FLAGS flags[] = { D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS,
+                                            D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES, D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES, D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES };
+        const uint64_t alignments[] = { D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+                                        D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT };
+
+        // The heaps themselves are only created when a resource needs them
+        for (uint32_t poolIdx = 0; poolIdx < (uint32_t)DX12HeapPoolType::Count; ++poolIdx)
+        {
+            DX12HeapPool* pool = new DX12HeapPool();
+            pool->type = types[poolIdx];
+            pool->flags = flags[poolIdx];
+            pool->alignment = alignments[poolIdx];
+            deviceI->heapPools[poolIdx] = pool;
+        }
+    }
+
+    void destroy_heap_pools(DX12GraphicsDevice* deviceI)
+    {
+        for (uint32_t poolIdx = 0; poolIdx < (uint32_t)DX12HeapPoolType::Count; ++poolIdx)
+        {
+            DX12HeapPool* pool = deviceI->heapPools[poolIdx];
+            for (DX12Heap* heap : pool->heaps)
+            {
+                if (heap == nullptr)
+                    continue;
+                assert_msg(heap->allocator.empty(), "Heap has still active resources.");
+                heap->allocator.release();
+                heap->heap->Release();
+                delete heap;
+            }
+            delete pool;
+            deviceI->heapPools[poolIdx] = nullptr;
+        }
+    }
+
+    uint32_t create_heap(DX12GraphicsDevice* deviceI, DX12HeapPool* pool)
+    {
+        D3D12_HEAP_DESC heapDesc = {};
+        heapDesc.SizeInBytes = DX12_HEAP_SIZE;
+        heapDesc.Properties.Type = pool->type;
+        heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        heapDesc.Flags = pool->flags;
+
+        DX12Heap* heap = new DX12Heap();
+        assert_msg(deviceI->device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap->heap)) == S_OK, "Failed to create heap.");
+        heap->allocator.initialize(DX12_HEAP_SIZE, pool->alignment);
+
+        // Fill the slot of a released heap if any
+        for (uint32_t heapIdx = 0; heapIdx < (uint32_t)pool->heaps.size(); ++heapIdx)
+        {
+            if (pool->heaps[heapIdx] == nullptr)
+            {
+                pool->heaps[heapIdx] = heap;
+                return heapIdx;
+            }
+        }
+        pool->heaps.push_back(heap);
+        return (uint32_t)pool->heaps.size() - 1;
+    }
+
+    ID3D12Resource* create_placed_resource(DX12GraphicsDevice* deviceI, DX12HeapPoolType poolType, const D3D12_RESOURCE_DESC& resourceDesc, D3D12_RESOURCE_STATES state, const D3D12_CLEAR_VALUE* clearValue, DX12Allocation& outAllocation)
+    {
+        ID3D12Device1* device = deviceI->device;
+        D3D12_RESOURCE_DESC placedDesc = resourceDesc;
 
-        // Pre-evaluate the CPU Heap handles
-        descriptorHeap.samplerCPU = descHeap->GetCPUDescriptorHandleForHeapStart();
+        // Textures that fit in a few pages go to the pool with the small placement alignment
+        D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = {};
+        if (poolType == DX12HeapPoolType::Textures)
+        {
+            placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+            allocationInfo = device->GetResourceAllocationInfo(0, 1, &placedDesc);
+            if (allocationInfo.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+                poolType = DX12HeapPoolType::SmallTextures;
+            else
+                placedDesc.Alignment = resourceDesc.Alignment;
+        }
+        if (poolType != DX12HeapPoolType::SmallTextures)
+            allocationInfo = device->GetResourceAllocationInfo(0, 1, &placedDesc);
 
-        // Pre-evaluate the GPU Heap handles
-        descriptorHeap.samplerGPU = descHeap->GetGPUDescriptorHandleForHeapStart();
+        ID3D12Resource* resource = nullptr;
+        DX12HeapPool* pool = deviceI->heapPools[(uint32_t)poolType];
+        if (allocationInfo.SizeInBytes <= DX12_HEAP_SIZE)
+        {
+            std::lock_guard<std::mutex> lock(deviceI->heapMutex);
 
-        return descriptorHeap;
+            // First heap of the pool with a free block big enough
+            uint64_t offset = 0;
+            uint32_t heapIdx = UINT32_MAX;
+            uint32_t block = TLSF_INVALID_ALLOCATION;
+            for (uint32_t candidateIdx = 0; candidateIdx < (uint32_t)pool->heaps.size() && block == TLSF_INVALID_ALLOCATION; ++candidateIdx)
+            {
+                if (pool->heaps[candidateIdx] == nullptr)
+                    continue;
+                block = pool->heaps[candidateIdx]->allocator.allocate(allocationInfo.SizeInBytes, offset);
+                heapIdx = candidateIdx;
+            }
+
+            // Otherwise grow the pool
+            if (block == TLSF_INVALID_ALLOCATION)
+            {
+                heapIdx = create_heap(deviceI, pool);
+                block = pool->heaps[heapIdx]->allocator.allocate(allocationInfo.SizeInBytes, offset);
+                assert_msg(block != TLSF_INVALID_ALLOCATION, "Failed to allocate in a new heap.");
+            }
+            assert_msg(device->CreatePlacedResource(pool->heaps[heapIdx]->heap, offset, &placedDesc, state, clearValue, IID_PPV_ARGS(&resource)) == S_OK, "Failed to create placed resource.");
+
+            // Keep track of the allocation
+            outAllocation.pool = (uint32_t)poolType;
+            outAllocation.heap = heapIdx;
+            outAllocation.block = block;
+            outAllocation.size = (allocationInfo.SizeInBytes + pool->alignment - 1) & ~(pool->alignment - 1);
+            pool->usedMemory += outAllocation.size;
+            pool->peakMemory = std::max(pool->peakMemory, pool->usedMemory);
+        }
+        else
+        {
+            // Too big to share a heap
+            D3D12_HEAP_PROPERTIES heapProperties = {};
+            heapProperties.Type = pool->type;
+            heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+            heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+            assert_msg(device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &placedDesc, state, clearValue, IID_PPV_ARGS(&resource)) == S_OK, "Failed to create committed resource.");
+            outAllocation = DX12Allocation();
+            outAllocation.size = allocationInfo.SizeInBytes;
+            deviceI->committedResources++;
+        }
+        return resource;
     }
 
-    void destroy_descriptor_heap(DX12DescriptorHeap& descriptorHeap)
+    ID3D12Resource* create_aliased_resource(DX12TransientHeap* transientHeap, uint64_t heapOffset, const D3D12_RESOURCE_DESC& resourceDesc, D3D12_RESOURCE_STATES state, const D3D12_CLEAR_VALUE* clearValue, DX12Allocation& outAllocation)
     {
-        descriptorHeap.descriptorHeap->Release();
+        ID3D12Device1* device = transientHeap->deviceI->device;
+        const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = device->GetResourceAllocationInfo(0, 1, &resourceDesc);
+        assert_msg(heapOffset % allocationInfo.Alignment == 0 && heapOffset + allocationInfo.SizeInBytes <= transientHeap->size, "Aliased resource out of the transient heap.");
+
+        ID3D12Resource* resource = nullptr;
+        assert_msg(device->CreatePlacedResource(transientHeap->heap, heapOffset, &resourceDesc, state, clearValue, IID_PPV_ARGS(&resource)) == S_OK, "Failed to create aliased resource.");
+
+        // The range belongs to the heap, nothing to give back on release
+        outAllocation = DX12Allocation();
+        outAllocation.pool = DX12_ALIASED_POOL;
+        outAllocation.size = allocationInfo.SizeInBytes;
+        return resource;
+    }
+
+    void release_placed_resource(DX12GraphicsDevice* deviceI, ID3D12Resource* resource, const DX12Allocation& allocation)
+    {
+        resource->Release();
+        if (allocation.pool == UINT32_MAX)
+        {
+            deviceI->committedResources--;
+            return;
+        }
+        if (allocation.pool == DX12_ALIASED_POOL)
+            return;
+
+        // Give the range back to its heap
+        std::lock_guard<std::mutex> lock(deviceI->heapMutex);
+        DX12HeapPool* pool = deviceI->heapPools[allocation.pool];
+        DX12Heap* heap = pool->heaps[allocation.heap];
+        heap->allocator.free(allocation.block);
+        pool->usedMemory -= allocation.size;
+
+        // The first heap of a pool is kept around, the other ones are released as soon as they are empty
+        if (allocation.heap != 0 && heap->allocator.empty())
+        {
+            heap->allocator.release();
+            heap->heap->Release();
+            delete heap;
+            pool->heaps[allocation.heap] = nullptr;
+        }
     }
 
     DX12RootSignature* create_root_signature(DX12GraphicsDevice* deviceI, uint32_t srvCount, uint32_t uavCount, uint32_t cbvCount, uint32_t samplerCount)
@@ -466,11 +844,249 @@ namespace d3d12
         delete rootSignature;
     }
 
+    // Releases the DXC instances when the owning thread exits
+    struct DX12ShaderCompilerHolder
+    {
+        DX12ShaderCompiler instance;
+
+        ~DX12ShaderCompilerHolder()
+        {
+            if (instance.includeHandler != nullptr)
+                instance.includeHandler->Release();
+            if (instance.utils != nullptr)
+                instance.utils->Release();
+            if (instance.compiler != nullptr)
+                instance.compiler->Release();
+            if (instance.library != nullptr)
+                instance.library->Release();
+        }
+    };
+
+    DX12ShaderCompiler& thread_shader_compiler()
+    {
+        // DXC objects are not thread safe, but creating them for every compile is expensive, so each thread keeps its own set
+        static thread_local DX12ShaderCompilerHolder holder;
+        DX12ShaderCompiler& dxc = holder.instance;
+        if (dxc.compiler == nullptr)
+        {
+            DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&dxc.library));
+            DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxc.compiler));
+            DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxc.utils));
+            dxc.library->CreateIncludeHandler(&dxc.includeHandler);
+
+            // Grab the version and commit of the compiler
+            IDxcVersionInfo* versionInfo = nullptr;
+            if (dxc.compiler->QueryInterface(IID_PPV_ARGS(&versionInfo)) == S_OK)
+            {
+                UINT32 major = 0, minor = 0;
+                versionInfo->GetVersion(&major, &minor);
+                dxc.version = std::to_string(major) + "." + std::to_string(minor);
+
+                IDxcVersionInfo2* versionInfo2 = nullptr;
+                if (versionInfo->QueryInterface(IID_PPV_ARGS(&versionInfo2)) == S_OK)
+                {
+                    UINT32 commitCount = 0;
+                    char* commitHash = nullptr;
+                    versionInfo2->GetCommitInfo(&commitCount, &commitHash);
+                    if (commitHash != nullptr)
+                    {
+                        dxc.version += "-";
+                        dxc.version += commitHash;
+                        CoTaskMemFree(commitHash);
+                    }
+                    versionInfo2->Release();
+                }
+                versionInfo->Release();
+            }
+        }
+        return dxc;
+    }
+
+    // Forwards to the default include handler and records the files that were actually included
+    class DX12RecordingIncludeHandler : public IDxcIncludeHandler
+    {
+    public:
+        DX12RecordingIncludeHandler(IDxcIncludeHandler* defaultHandler)
+        : m_DefaultHandler(defaultHandler)
+        {
+        }
+
+        HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource) override
+        {
+            HRESULT hr = m_DefaultHandler->LoadSource(pFilename, ppIncludeSource);
+            if (SUCCEEDED(hr))
+                m_IncludedFiles.push_back(normalize_file_path(convert_to_regular(pFilename)));
+            return hr;
+        }
+
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+        {
+            if (riid == __uuidof(IDxcIncludeHandler) || riid == __uuidof(IUnknown))
+            {
+                *ppvObject = static_cast<IDxcIncludeHandler*>(this);
+                return S_OK;
+            }
+            *ppvObject = nullptr;
+            return E_NOINTERFACE;
+        }
+
+        // Lives on the stack for the duration of a compile
+        ULONG STDMETHODCALLTYPE AddRef() override { return 1; }
+        ULONG STDMETHODCALLTYPE Release() override { return 1; }
+
+        const std::vector<std::string>& included_files() const { return m_IncludedFiles; }
+
+    private:
+        IDxcIncludeHandler* m_DefaultHandler = nullptr;
+        std::vector<std::string> m_IncludedFiles;
+    };
+
+    IDxcBlob* compile_shader_kernel(const std::string& filename, const std::vector<std::string>& includeDirectories, const std::string& kernelName, const wchar_t* profile,
+                                    const std::vector<LPCWSTR>& arguments, const std::vector<DxcDefine>& defines, std::vector<std::string>& outDependencies)
+    {
+        // The source file is always a dependency
+        outDependencies.clear();
+        outDependencies.push_back(normalize_file_path(filename));
+
+        // Grab the DXC instances of this thread
+        DX12ShaderCompiler& dxc = thread_shader_compiler();
+
+        // Precompiled permutations come first
+        if (shader_archive::active())
+        {
+            // Defines and arguments in the form used by the archive keys, include directories excluded
+            std::vector<std::string> permutationDefines;
+            for (const DxcDefine& define : defines)
+            {
+                std::string permutationDefine = convert_to_regular(define.Name);
+                if (define.Value != nullptr && define.Value[0] != L'\0')
+                    permutationDefine += "=" + convert_to_regular(define.Value);
+                permutationDefines.push_back(permutationDefine);
+            }
+            std::vector<std::string> permutationArguments;
+            for (LPCWSTR argument : arguments)
+            {
+                if (wcsncmp(argument, L"-I", 2) != 0)
+                    permutationArguments.push_back(convert_to_regular(argument));
+            }
+
+            const char* binary = nullptr;
+            uint64_t binarySize = 0;
+            if (shader_archive::find(filename, kernelName, convert_to_regular(profile), permutationDefines, permutationArguments, binary, binarySize))
+            {
+                IDxcBlobEncoding* archiveBlob = nullptr;
+                if (dxc.utils->CreateBlob(binary, (uint32_t)binarySize, DXC_CP_ACP, &archiveBlob) == S_OK)
+                    return archiveBlob;
+            }
+
+#if defined(SHADER_ARCHIVE_ONLY)
+            printf("[SHADER ARCHIVE] %s (%s) is missing from the archive.\n", filename.c_str(), kernelName.c_str());
+            return nullptr;
+#endif
+        }
+
+#if defined(SHADER_ARCHIVE_ONLY)
+        // Shipping builds never invoke the compiler
+        (void)includeDirectories;
+        printf("[SHADER ARCHIVE] No archive loaded, %s (%s) can't be compiled.\n", filename.c_str(), kernelName.c_str());
+        return nullptr;
+#else
+        // Convert the strings to wide
+        const std::wstring& filenameW = convert_to_wide(filename.c_str(), (uint32_t)filename.size());
+        const std::wstring& kernelNameW = convert_to_wide(kernelName.c_str(), (uint32_t)kernelName.size());
+
+        // Evaluate the cache key, everything that can change the output of the compiler is part of it
+        uint64_t cacheKey = 0;
+        if (shader_cache::enabled())
+        {
+            cacheKey = shader_cache::hash_source_tree(filename, includeDirectories);
+            cacheKey = shader_cache::hash_string(filename, cacheKey);
+            cacheKey = shader_cache::hash_wstring(kernelNameW, cacheKey);
+            cacheKey = shader_cache::hash_wstring(profile, cacheKey);
+            for (LPCWSTR argument : arguments)
+                cacheKey = shader_cache::hash_wstring(argument, cacheKey);
+            for (const DxcDefine& define : defines)
+            {
+                cacheKey = shader_cache::hash_wstring(define.Name, cacheKey);
+                cacheKey = shader_cache::hash_wstring(define.Value != nullptr ? define.Value : L"", cacheKey);
+            }
+            cacheKey = shader_cache::hash_string(dxc.version, cacheKey);
+
+            // Cache hit, no need to compile
+            std::vector<char> binary;
+            if (shader_cache::load(cacheKey, binary))
+            {
+                IDxcBlobEncoding* cachedBlob = nullptr;
+                if (dxc.utils->CreateBlob(binary.data(), (uint32_t)binary.size(), DXC_CP_ACP, &cachedBlob) == S_OK)
+                {
+                    // The include tree that produced the key gives us the dependencies
+                    std::vector<std::string> includes;
+                    shader_cache::source_dependencies(filename, includeDirectories, includes);
+                    for (const std::string& include : includes)
+                    {
+                        const std::string normalized = normalize_file_path(include);
+                        if (std::find(outDependencies.begin(), outDependencies.end(), normalized) == outDependencies.end())
+                            outDependencies.push_back(normalized);
+                    }
+                    return cachedBlob;
+                }
+            }
+        }
+
+        // Load the file into a blob
+        uint32_t code_page = CP_UTF8;
+        IDxcBlobEncoding* source_blob;
+        assert_msg(dxc.library->CreateBlobFromFile(filenameW.c_str(), &code_page, &source_blob) == S_OK, "Failed to load the shader code.");
+
+        // Compile the shader
+        IDxcOperationResult* result;
+        DX12RecordingIncludeHandler includeHandler(dxc.includeHandler);
+        HRESULT hr = dxc.compiler->Compile(source_blob, filenameW.c_str(), kernelNameW.c_str(), profile, (LPCWSTR*)arguments.data(), (uint32_t)arguments.size(), defines.data(), (uint32_t)defines.size(), &includeHandler, &result);
+
+        // Keep track of the includes for the hot reload
+        for (const std::string& include : includeHandler.included_files())
+        {
+            if (std::find(outDependencies.begin(), outDependencies.end(), include) == outDependencies.end())
+                outDependencies.push_back(include);
+        }
+
+        if (SUCCEEDED(hr))
+            result->GetStatus(&hr);
+        bool compile_succeed = SUCCEEDED(hr);
+
+        // If the compilation failed, print the error
+        IDxcBlobEncoding* error_blob;
+        if (SUCCEEDED(result->GetErrorBuffer(&error_blob)) && error_blob)
+        {
+            // Log the compilation message
+            if (error_blob->GetBufferSize() != 0)
+                printf("[SHADER COMPILATION] %s, %s\n", kernelName.c_str(), (const char*)error_blob->GetBufferPointer());
+
+            // Release the error blob
+            error_blob->Release();
+        }
+
+        // If succeeded, grab the right pointer
+        IDxcBlob* shader_blob = nullptr;
+        if (compile_succeed)
+            result->GetResult(&shader_blob);
+
+        // Release all the intermediate resources
+        result->Release();
+        source_blob->Release();
+
+        // Keep it for the next runs
+        if (shader_blob != nullptr && shader_cache::enabled())
+            shader_cache::store(cacheKey, shader_blob->GetBufferPointer(), shader_blob->GetBufferSize());
+
+        return shader_blob;
+#endif
+    }
+
     void query_bindings(IDxcBlob* blob, uint32_t& cbvCount, uint32_t& srvCount, uint32_t& uavCount, uint32_t& samplerCount, std::map<std::string, DX12Binding>& outBindings)
     {
-        // Create the dxcUtils
-        IDxcUtils* utils;
-        DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils));
+        // Grab the dxcUtils of this thread
+        IDxcUtils* utils = thread_shader_compiler().utils;
 
         // Step 2: Prepare DxcBuffer
         DxcBuffer dxcBuffer = {};
@@ -481,7 +1097,6 @@ namespace d3d12
         // Create the reflection
         ID3D12ShaderReflection* reflection;
         utils->CreateReflection(&dxcBuffer, IID_PPV_ARGS(&reflection));
-        utils->Release();
 
         // Grab the descriptor
         D3D12_SHADER_DESC shaderDesc;
@@ -536,58 +1151,28 @@ namespace d3d12
             cbvCount = 1;
     }
 
-    bool request_binding(const std::map<std::string, DX12Binding>& bindings, const char* name, DX12Binding& outBind)
-    {
-        auto it = bindings.find(name);
-        if (it != bindings.end())
-        {
-            outBind = it->second;
-            return true;
-        }
-        return false;
-    }
-
-    void validate_compute_shader_heap(DX12ComputeShader* computeShader, uint32_t cmdBatchIndex)
+    void build_binding_table(const std::map<std::string, DX12Binding>& bindings, BindingTable& outTable, std::vector<DX12Binding>& outSlots)
     {
-        // We need to check if we've entered a new frame. If it is the case we just need to:
-        //  - Update the next usable heap to the first one and we're done
-        //  - Update the command buffer batch index accordinly
-        // This is true because we always have at least one allocated heap.
-        if (computeShader->cmdBatchIndex != cmdBatchIndex)
-        {
-            computeShader->nextUsableHeap = 0;
-            computeShader->cmdBatchIndex = cmdBatchIndex;
-            return;
-        }
-
-        // If we're tracking properly the current batch but a new heap is required, we need to allocate it.
-        if (computeShader->CSUHeaps.size() == computeShader->nextUsableHeap)
+        // Identifiers and slots in the same order, the table indexes both
+        std::vector<BindingID> bindingIDs;
+        bindingIDs.reserve(bindings.size());
+        outSlots.clear();
+        outSlots.reserve(bindings.size());
+        for (const auto& binding : bindings)
         {
-            // Make sure there are enough heaps
-            computeShader->CSUHeaps.push_back(create_descriptor_heap_suc(computeShader->device, computeShader->srvCount, computeShader->uavCount, computeShader->cbvCount));
-            computeShader->samplerHeaps.push_back(create_descriptor_heap_sampler(computeShader->device, std::max(computeShader->samplerCount, 1u)));
+            bindingIDs.push_back(binding_id(binding.first.c_str()));
+            outSlots.push_back(binding.second);
         }
+        outTable.build(bindingIDs.data(), (uint32_t)bindingIDs.size());
     }
 
-    void validate_graphics_pipeline_heap(DX12GraphicsPipeline* graphicsPipeline, uint32_t cmdBatchIndex)
+    bool request_binding(const BindingTable& bindingTable, const std::vector<DX12Binding>& bindingSlots, BindingID bindingID, DX12Binding& outBind)
     {
-        // We need to check if we've entered a new frame. If it is the case we just need to:
-        //  - Update the next usable heap to the first one and we're done
-        //  - Update the command buffer batch index accordinly
-        // This is true because we always have at least one allocated heap.
-        if (graphicsPipeline->cmdBatchIndex != cmdBatchIndex)
-        {
-            graphicsPipeline->nextUsableHeap = 0;
-            graphicsPipeline->cmdBatchIndex = cmdBatchIndex;
-            return;
-        }
-
-        // If we're tracking properly the current batch but a new heap is required, we need to allocate it.
-        if (graphicsPipeline->CSUHeaps.size() == graphicsPipeline->nextUsableHeap)
-        {
-            graphicsPipeline->CSUHeaps.push_back(create_descriptor_heap_suc(graphicsPipeline->device, graphicsPipeline->srvCount, graphicsPipeline->uavCount, graphicsPipeline->cbvCount));
-            graphicsPipeline->samplerHeaps.push_back(create_descriptor_heap_sampler(graphicsPipeline->device, std::max(graphicsPipeline->samplerCount, 1u)));
-        }
+        uint32_t slotIdx = bindingTable.find(bindingID);
+        if (slotIdx == BINDING_TABLE_EMPTY)
+            return false;
+        outBind = bindingSlots[slotIdx];
+        return true;
     }
 
     GPUVendor vendor_id_to_vendor(uint32_t vendorID)
@@ -10,6 +10,7 @@
 #if defined(D3D12_SUPPORTED)
 #include "dx12/dx12_backend.h"
 #endif
+#include "null/null_backend.h"
 #include "tools/security.h"
 
 struct BackendPointers
@@ -23,7 +24,9 @@ struct BackendPointers
     const char* (*__device__get_device_name)(GraphicsDevice graphicsDevice) = nullptr;
     bool (*__device__feature_support)(GraphicsDevice device, GPUFeature feature) = nullptr;
     CoopMatTier (*__device__coop_mat_tier)(GraphicsDevice device) = nullptr;
+    uint2 (*__device__wave_lane_count_range)(GraphicsDevice device) = nullptr;
     void(*__device__set_stable_power_state)(GraphicsDevice device, bool state) = nullptr;
+    DeviceMemoryStats(*__device__memory_stats)(GraphicsDevice device) = nullptr;
 #pragma endregion
 
 #pragma region command_queue
@@ -43,6 +46,7 @@ struct BackendPointers
     // Generic operations
     void (*__command_buffer__reset)(CommandBuffer commandBuffer) = nullptr;
     void (*__command_buffer__close)(CommandBuffer commandBuffer) = nullptr;
+    CommandBufferType (*__command_buffer__command_buffer_type)(CommandBuffer commandBuffer) = nullptr;
 
     // Render Texture
     void (*__command_buffer__clear_render_texture)(CommandBuffer, RenderTexture, const float4&) = nullptr;
@@ -73,30 +77,33 @@ struct BackendPointers
     void (*__command_buffer__uav_barrier_buffer)(CommandBuffer, GraphicsBuffer) = nullptr;
     void (*__command_buffer__uav_barrier_texture)(CommandBuffer, Texture) = nullptr;
     void (*__command_buffer__uav_barrier_render_texture)(CommandBuffer, RenderTexture) = nullptr;
+    void (*__command_buffer__uav_barriers)(CommandBuffer, const GraphicsBuffer*, uint32_t, const RenderTexture*, uint32_t) = nullptr;
+    void (*__command_buffer__aliasing_barriers)(CommandBuffer, const GraphicsBuffer*, uint32_t, const RenderTexture*, uint32_t) = nullptr;
 
     // Transitions
     void (*__command_buffer__transition_to_common)(CommandBuffer, GraphicsBuffer) = nullptr;
     void (*__command_buffer__transition_to_copy_source)(CommandBuffer, GraphicsBuffer) = nullptr;
     void (*__command_buffer__transition_to_present)(CommandBuffer, RenderTexture) = nullptr;
+    void (*__command_buffer__transition_for_compute_queue)(CommandBuffer, const GraphicsBuffer*, uint32_t, const RenderTexture*, uint32_t, bool) = nullptr;
 
     // Compute Shader
-    void (*__command_buffer__set_compute_shader_cbuffer)(CommandBuffer, ComputeShader, const char*, ConstantBuffer) = nullptr;
-    void (*__command_buffer__set_compute_shader_buffer)(CommandBuffer, ComputeShader, const char*, GraphicsBuffer) = nullptr;
-    void (*__command_buffer__set_compute_shader_texture)(CommandBuffer, ComputeShader, const char*, Texture, uint32_t) = nullptr;
-    void (*__command_buffer__set_compute_shader_render_texture)(CommandBuffer, ComputeShader, const char*, RenderTexture) = nullptr;
-    void (*__command_buffer__set_compute_shader_sampler)(CommandBuffer, ComputeShader, const char*, Sampler) = nullptr;
-    void (*__command_buffer__set_compute_shader_rtas)(CommandBuffer, ComputeShader, const char*, TopLevelAS) = nullptr;
+    void (*__command_buffer__set_compute_shader_cbuffer)(CommandBuffer, ComputeShader, BindingID, ConstantBuffer) = nullptr;
+    void (*__command_buffer__set_compute_shader_buffer)(CommandBuffer, ComputeShader, BindingID, GraphicsBuffer) = nullptr;
+    void (*__command_buffer__set_compute_shader_texture)(CommandBuffer, ComputeShader, BindingID, Texture, uint32_t) = nullptr;
+    void (*__command_buffer__set_compute_shader_render_texture)(CommandBuffer, ComputeShader, BindingID, RenderTexture) = nullptr;
+    void (*__command_buffer__set_compute_shader_sampler)(CommandBuffer, ComputeShader, BindingID, Sampler) = nullptr;
+    void (*__command_buffer__set_compute_shader_rtas)(CommandBuffer, ComputeShader, BindingID, TopLevelAS) = nullptr;
     void (*__command_buffer__dispatch)(CommandBuffer, ComputeShader, uint32_t, uint32_t, uint32_t) = nullptr;
     void (*__command_buffer__dispatch_indirect)(CommandBuffer, ComputeShader, GraphicsBuffer, uint32_t) = nullptr;
 
     // Graphics Pipeline
     void (*__command_buffer__set_viewport)(CommandBuffer, int32_t, int32_t, uint32_t, uint32_t) = nullptr;
-    void (*__command_buffer__set_graphics_pipeline_cbuffer)(CommandBuffer, GraphicsPipeline, const char*, ConstantBuffer) = nullptr;
-    void (*__command_buffer__set_graphics_pipeline_buffer)(CommandBuffer, GraphicsPipeline, const char*, GraphicsBuffer, uint64_t) = nullptr;
-    void (*__command_buffer__set_graphics_pipeline_texture)(CommandBuffer, GraphicsPipeline, const char*, Texture) = nullptr;
-    void (*__command_buffer__set_graphics_pipeline_render_texture)(CommandBuffer, GraphicsPipeline, const char*, RenderTexture) = nullptr;
-    void (*__command_buffer__set_graphics_pipeline_sampler)(CommandBuffer, GraphicsPipeline, const char*, Sampler) = nullptr;
-    void (*__command_buffer__set_graphics_pipeline_rtas)(CommandBuffer, GraphicsPipeline, const char*, TopLevelAS) = nullptr;
+    void (*__command_buffer__set_graphics_pipeline_cbuffer)(CommandBuffer, GraphicsPipeline, BindingID, ConstantBuffer) = nullptr;
+    void (*__command_buffer__set_graphics_pipeline_buffer)(CommandBuffer, GraphicsPipeline, BindingID, GraphicsBuffer, uint64_t) = nullptr;
+    void (*__command_buffer__set_graphics_pipeline_texture)(CommandBuffer, GraphicsPipeline, BindingID, Texture) = nullptr;
+    void (*__command_buffer__set_graphics_pipeline_render_texture)(CommandBuffer, GraphicsPipeline, BindingID, RenderTexture) = nullptr;
+    void (*__command_buffer__set_graphics_pipeline_sampler)(CommandBuffer, GraphicsPipeline, BindingID, Sampler) = nullptr;
+    void (*__command_buffer__set_graphics_pipeline_rtas)(CommandBuffer, GraphicsPipeline, BindingID, TopLevelAS) = nullptr;
     void (*__command_buffer__draw_indexed)(CommandBuffer, GraphicsPipeline, GraphicsBuffer, GraphicsBuffer, uint32_t, uint32_t, DrawPrimitive) = nullptr;
     void (*__command_buffer__draw_procedural)(CommandBuffer, GraphicsPipeline, uint32_t, uint32_t, DrawPrimitive) = nullptr;
     void (*__command_buffer__draw_procedural_indirect)(CommandBuffer, GraphicsPipeline, GraphicsBuffer, uint64_t) = nullptr;
@@ -112,6 +119,8 @@ struct BackendPointers
     // Profiling
     void (*__command_buffer__enable_profiling_scope)(CommandBuffer, ProfilingScope) = nullptr;
     void (*__command_buffer__disable_profiling_scope)(CommandBuffer, ProfilingScope) = nullptr;
+    void (*__command_buffer__write_timestamp)(CommandBuffer, ProfilingScope, uint32_t) = nullptr;
+    void (*__command_buffer__resolve_timestamps)(CommandBuffer, ProfilingScope, uint32_t, uint32_t) = nullptr;
 
     // Misc
     void (*__command_buffer__convert_mat_32_to_16)(CommandBuffer, GraphicsBuffer, uint64_t, GraphicsBuffer, uint64_t, uint32_t, uint32_t, bool) = nullptr;
@@ -161,6 +170,13 @@ struct BackendPointers
     void (*__graphics_resources__release_cpu_buffer)(GraphicsBuffer) = nullptr;
     void (*__graphics_resources__set_buffer_debug_name)(GraphicsBuffer, const char*) = nullptr;
 
+    TransientHeap(*__graphics_resources__create_transient_heap)(GraphicsDevice, uint64_t) = nullptr;
+    void (*__graphics_resources__destroy_transient_heap)(TransientHeap) = nullptr;
+    void (*__graphics_resources__graphics_buffer_footprint)(GraphicsDevice, uint64_t, uint64_t&, uint64_t&) = nullptr;
+    void (*__graphics_resources__render_texture_footprint)(GraphicsDevice, const TextureDescriptor&, uint64_t&, uint64_t&) = nullptr;
+    GraphicsBuffer(*__graphics_resources__create_aliased_graphics_buffer)(TransientHeap, uint64_t, uint64_t, uint32_t, uint32_t) = nullptr;
+    RenderTexture(*__graphics_resources__create_aliased_render_texture)(TransientHeap, uint64_t, const TextureDescriptor&) = nullptr;
+
     ConstantBuffer(*__graphics_resources__create_constant_buffer)(GraphicsDevice, uint32_t, ConstantBufferType) = nullptr;
     void (*__graphics_resources__destroy_constant_buffer)(ConstantBuffer) = nullptr;
     void (*__graphics_resources__set_constant_buffer)(ConstantBuffer, const char*, uint32_t) = nullptr;
@@ -177,18 +193,31 @@ struct BackendPointers
 #pragma region compute_shader
     ComputeShader(*__compute_shader__create_compute_shader)(GraphicsDevice graphicsDevice, const ComputeShaderDescriptor& computeShaderDescriptor, bool experimental) = nullptr;
     void (*__compute_shader__destroy_compute_shader)(ComputeShader computeShader) = nullptr;
+    const std::vector<std::string>& (*__compute_shader__source_dependencies)(ComputeShader computeShader) = nullptr;
 #pragma endregion
 
 #pragma region graphics_pipeline
     GraphicsPipeline(*__graphics_pipeline__create_graphics_pipeline)(GraphicsDevice graphicsDevice, const GraphicsPipelineDescriptor& graphicsPipelineDescriptor) = nullptr;
     void (*__graphics_pipeline__destroy_graphics_pipeline)(GraphicsPipeline graphicsPipeline) = nullptr;
     void (*__graphics_pipeline__set_stencil_ref)(GraphicsPipeline graphicsPipeline, uint8_t stencilRef) = nullptr;
+    const std::vector<std::string>& (*__graphics_pipeline__source_dependencies)(GraphicsPipeline graphicsPipeline) = nullptr;
 #pragma endregion
 
 #pragma region profiling_scope
-    ProfilingScope (*__profiling_scope__create_profiling_scope) (GraphicsDevice graphicsDevice) = nullptr;
+    ProfilingScope (*__profiling_scope__create_profiling_scope) (GraphicsDevice graphicsDevice, uint32_t numTimestamps) = nullptr;
     void (*__profiling_scope__destroy_profiling_scope) (ProfilingScope profilingScope) = nullptr;
     uint64_t (*__profiling_scope__get_duration_us) (ProfilingScope profilingScope, CommandQueue cmdQ, CommandBufferType type) = nullptr;
+    void (*__profiling_scope__read_timestamps) (ProfilingScope profilingScope, uint32_t first, uint32_t count, uint64_t* outTicks) = nullptr;
+    uint64_t (*__profiling_scope__timestamp_frequency) (CommandQueue cmdQ, CommandBufferType type) = nullptr;
+    void (*__profiling_scope__clock_calibration) (CommandQueue cmdQ, CommandBufferType type, uint64_t& outGPUTicks, uint64_t& outCPUTimeNS) = nullptr;
+#pragma endregion
+
+#pragma region fence
+    Fence (*__fence__create_fence)(GraphicsDevice graphicsDevice, uint64_t initialValue) = nullptr;
+    void (*__fence__destroy_fence)(Fence fence) = nullptr;
+    void (*__fence__set_value)(Fence fence, uint64_t value) = nullptr;
+    uint64_t (*__fence__get_value)(Fence fence) = nullptr;
+    void (*__fence__wait_value)(Fence fence, uint64_t value) = nullptr;
 #pragma endregion
 
 #pragma region imgui
@@ -205,6 +234,10 @@ struct BackendPointers
 // Global pointers
 BackendPointers g_Backend;
 
+// Listener of the command buffer sections, independent from the API
+graphics::command_buffer::SectionCallback g_SectionCallback = nullptr;
+void* g_SectionUserData = nullptr;
+
 namespace graphics
 {
     bool setup_graphics_api(GraphicsAPI graphicsAPI)
@@ -222,7 +255,9 @@ namespace graphics
                 g_Backend.__device__get_device_name = d3d12::device::get_device_name;
                 g_Backend.__device__feature_support = d3d12::device::feature_support;
                 g_Backend.__device__coop_mat_tier = d3d12::device::coop_mat_tier;
+                g_Backend.__device__wave_lane_count_range = d3d12::device::wave_lane_count_range;
                 g_Backend.__device__set_stable_power_state = d3d12::device::set_stable_power_state;
+                g_Backend.__device__memory_stats = d3d12::device::memory_stats;
 
                 // Command Queue
                 g_Backend.__command_queue__create_command_queue = d3d12::command_queue::create_command_queue;
@@ -237,6 +272,7 @@ namespace graphics
                 g_Backend.__command_buffer__destroy_command_buffer = d3d12::command_buffer::destroy_command_buffer;
                 g_Backend.__command_buffer__reset = d3d12::command_buffer::reset;
                 g_Backend.__command_buffer__close = d3d12::command_buffer::close;
+                g_Backend.__command_buffer__command_buffer_type = d3d12::command_buffer::command_buffer_type;
                 g_Backend.__command_buffer__clear_render_texture = d3d12::command_buffer::clear_render_texture;
                 g_Backend.__command_buffer__clear_depth_texture = d3d12::command_buffer::clear_depth_texture;
                 g_Backend.__command_buffer__clear_depth_stencil_texture = d3d12::command_buffer::clear_depth_stencil_texture;
@@ -261,9 +297,12 @@ namespace graphics
                 g_Backend.__command_buffer__uav_barrier_buffer = d3d12::command_buffer::uav_barrier_buffer;
                 g_Backend.__command_buffer__uav_barrier_texture = d3d12::command_buffer::uav_barrier_texture;
                 g_Backend.__command_buffer__uav_barrier_render_texture = d3d12::command_buffer::uav_barrier_render_texture;
+                g_Backend.__command_buffer__uav_barriers = d3d12::command_buffer::uav_barriers;
+                g_Backend.__command_buffer__aliasing_barriers = d3d12::command_buffer::aliasing_barriers;
                 g_Backend.__command_buffer__transition_to_common = d3d12::command_buffer::transition_to_common;
                 g_Backend.__command_buffer__transition_to_copy_source = d3d12::command_buffer::transition_to_copy_source;
                 g_Backend.__command_buffer__transition_to_present = d3d12::command_buffer::transition_to_present;
+                g_Backend.__command_buffer__transition_for_compute_queue = d3d12::command_buffer::transition_for_compute_queue;
                 g_Backend.__command_buffer__set_compute_shader_cbuffer = d3d12::command_buffer::set_compute_shader_cbuffer;
                 g_Backend.__command_buffer__set_compute_shader_buffer = d3d12::command_buffer::set_compute_shader_buffer;
                 g_Backend.__command_buffer__set_compute_shader_texture = d3d12::command_buffer::set_compute_shader_texture;
@@ -288,6 +327,8 @@ namespace graphics
                 g_Backend.__command_buffer__end_section = d3d12::command_buffer::end_section;
                 g_Backend.__command_buffer__enable_profiling_scope = d3d12::command_buffer::enable_profiling_scope;
                 g_Backend.__command_buffer__disable_profiling_scope = d3d12::command_buffer::disable_profiling_scope;
+                g_Backend.__command_buffer__write_timestamp = d3d12::command_buffer::write_timestamp;
+                g_Backend.__command_buffer__resolve_timestamps = d3d12::command_buffer::resolve_timestamps;
                 g_Backend.__command_buffer__convert_mat_32_to_16 = d3d12::command_buffer::convert_mat_32_to_16;
 
                 // Window
@@ -328,6 +369,12 @@ namespace graphics
                 g_Backend.__graphics_resources__allocate_cpu_buffer = d3d12::resources::allocate_cpu_buffer;
                 g_Backend.__graphics_resources__release_cpu_buffer = d3d12::resources::release_cpu_buffer;
                 g_Backend.__graphics_resources__set_buffer_debug_name = d3d12::resources::set_buffer_debug_name;
+                g_Backend.__graphics_resources__create_transient_heap = d3d12::resources::create_transient_heap;
+                g_Backend.__graphics_resources__destroy_transient_heap = d3d12::resources::destroy_transient_heap;
+                g_Backend.__graphics_resources__graphics_buffer_footprint = d3d12::resources::graphics_buffer_footprint;
+                g_Backend.__graphics_resources__render_texture_footprint = d3d12::resources::render_texture_footprint;
+                g_Backend.__graphics_resources__create_aliased_graphics_buffer = d3d12::resources::create_aliased_graphics_buffer;
+                g_Backend.__graphics_resources__create_aliased_render_texture = d3d12::resources::create_aliased_render_texture;
                 g_Backend.__graphics_resources__create_constant_buffer = d3d12::resources::create_constant_buffer;
                 g_Backend.__graphics_resources__destroy_constant_buffer = d3d12::resources::destroy_constant_buffer;
                 g_Backend.__graphics_resources__set_constant_buffer = d3d12::resources::set_constant_buffer;
@@ -341,16 +388,28 @@ namespace graphics
                 // Compute shader
                 g_Backend.__compute_shader__create_compute_shader = d3d12::compute_shader::create_compute_shader;
                 g_Backend.__compute_shader__destroy_compute_shader = d3d12::compute_shader::destroy_compute_shader;
+                g_Backend.__compute_shader__source_dependencies = d3d12::compute_shader::source_dependencies;
 
                 // Graphics Pipeline
                 g_Backend.__graphics_pipeline__create_graphics_pipeline = d3d12::graphics_pipeline::create_graphics_pipeline;
                 g_Backend.__graphics_pipeline__destroy_graphics_pipeline = d3d12::graphics_pipeline::destroy_graphics_pipeline;
                 g_Backend.__graphics_pipeline__set_stencil_ref = d3d12::graphics_pipeline::set_stencil_ref;
+                g_Backend.__graphics_pipeline__source_dependencies = d3d12::graphics_pipeline::source_dependencies;
 
                 // Profiling scope
                 g_Backend.__profiling_scope__create_profiling_scope = d3d12::profiling_scope::create_profiling_scope;
                 g_Backend.__profiling_scope__destroy_profiling_scope = d3d12::profiling_scope::destroy_profiling_scope;
                 g_Backend.__profiling_scope__get_duration_us = d3d12::profiling_scope::get_duration_us;
+                g_Backend.__profiling_scope__read_timestamps = d3d12::profiling_scope::read_timestamps;
+                g_Backend.__profiling_scope__timestamp_frequency = d3d12::profiling_scope::timestamp_frequency;
+                g_Backend.__profiling_scope__clock_calibration = d3d12::profiling_scope::clock_calibration;
+
+                // Fence
+                g_Backend.__fence__create_fence = d3d12::fence::create_fence;
+                g_Backend.__fence__destroy_fence = d3d12::fence::destroy_fence;
+                g_Backend.__fence__set_value = d3d12::fence::set_value;
+                g_Backend.__fence__get_value = d3d12::fence::get_value;
+                g_Backend.__fence__wait_value = d3d12::fence::wait_value;
 
                 // IMGUI
                 g_Backend.__imgui__initialize_imgui = d3d12::imgui::initialize_imgui;
@@ -367,6 +426,183 @@ namespace graphics
                 printf("DX12 not supported by this build.\n");
 #endif
             break;
+            case GraphicsAPI::Null:
+                // Device
+                g_Backend.__device__enable_experimental_features = null_backend::device::enable_experimental_features;
+                g_Backend.__device__enable_debug_layer = null_backend::device::enable_debug_layer;
+                g_Backend.__device__create_graphics_device = null_backend::device::create_graphics_device;
+                g_Backend.__device__destroy_graphics_device = null_backend::device::destroy_graphics_device;
+                g_Backend.__device__get_gpu_vendor = null_backend::device::get_gpu_vendor;
+                g_Backend.__device__get_device_name = null_backend::device::get_device_name;
+                g_Backend.__device__feature_support = null_backend::device::feature_support;
+                g_Backend.__device__coop_mat_tier = null_backend::device::coop_mat_tier;
+                g_Backend.__device__wave_lane_count_range = null_backend::device::wave_lane_count_range;
+                g_Backend.__device__set_stable_power_state = null_backend::device::set_stable_power_state;
+                g_Backend.__device__memory_stats = null_backend::device::memory_stats;
+
+                // Command Queue
+                g_Backend.__command_queue__create_command_queue = null_backend::command_queue::create_command_queue;
+                g_Backend.__command_queue__destroy_command_queue = null_backend::command_queue::destroy_command_queue;
+                g_Backend.__command_queue__execute_command_buffer = null_backend::command_queue::execute_command_buffer;
+                g_Backend.__command_queue__signal = null_backend::command_queue::signal;
+                g_Backend.__command_queue__wait = null_backend::command_queue::wait;
+                g_Backend.__command_queue__flush = null_backend::command_queue::flush;
+
+                // Command Buffer
+                g_Backend.__command_buffer__create_command_buffer = null_backend::command_buffer::create_command_buffer;
+                g_Backend.__command_buffer__destroy_command_buffer = null_backend::command_buffer::destroy_command_buffer;
+                g_Backend.__command_buffer__reset = null_backend::command_buffer::reset;
+                g_Backend.__command_buffer__close = null_backend::command_buffer::close;
+                g_Backend.__command_buffer__command_buffer_type = null_backend::command_buffer::command_buffer_type;
+                g_Backend.__command_buffer__clear_render_texture = null_backend::command_buffer::clear_render_texture;
+                g_Backend.__command_buffer__clear_depth_texture = null_backend::command_buffer::clear_depth_texture;
+                g_Backend.__command_buffer__clear_depth_stencil_texture = null_backend::command_buffer::clear_depth_stencil_texture;
+                g_Backend.__command_buffer__clear_stencil_texture = null_backend::command_buffer::clear_stencil_texture;
+                g_Backend.__command_buffer__set_render_texture_1 = null_backend::command_buffer::set_render_texture;
+                g_Backend.__command_buffer__set_render_texture_2 = null_backend::command_buffer::set_render_texture;
+                g_Backend.__command_buffer__set_render_texture_3 = null_backend::command_buffer::set_render_texture;
+                g_Backend.__command_buffer__set_render_texture_4 = null_backend::command_buffer::set_render_texture;
+                g_Backend.__command_buffer__copy_graphics_buffer_1 = null_backend::command_buffer::copy_graphics_buffer;
+                g_Backend.__command_buffer__copy_graphics_buffer_2 = null_backend::command_buffer::copy_graphics_buffer;
+                g_Backend.__command_buffer__upload_constant_buffer_1 = null_backend::command_buffer::upload_constant_buffer;
+                g_Backend.__command_buffer__upload_constant_buffer_2 = null_backend::command_buffer::upload_constant_buffer;
+                g_Backend.__command_buffer__copy_texture_1 = null_backend::command_buffer::copy_texture;
+                g_Backend.__command_buffer__copy_texture_2 = null_backend::command_buffer::copy_texture;
+                g_Backend.__command_buffer__copy_render_texture = null_backend::command_buffer::copy_render_texture;
+                g_Backend.__command_buffer__copy_buffer_into_texture = null_backend::command_buffer::copy_buffer_into_texture;
+                g_Backend.__command_buffer__copy_buffer_into_texture_mip = null_backend::command_buffer::copy_buffer_into_texture_mip;
+                g_Backend.__command_buffer__copy_buffer_into_texture_mips = null_backend::command_buffer::copy_buffer_into_texture_mips;
+                g_Backend.__command_buffer__copy_buffer_into_render_texture = null_backend::command_buffer::copy_buffer_into_render_texture;
+                g_Backend.__command_buffer__copy_texture_into_buffer = null_backend::command_buffer::copy_texture_into_buffer;
+                g_Backend.__command_buffer__copy_render_texture_into_buffer = null_backend::command_buffer::copy_render_texture_into_buffer;
+                g_Backend.__command_buffer__uav_barrier_buffer = null_backend::command_buffer::uav_barrier_buffer;
+                g_Backend.__command_buffer__uav_barrier_texture = null_backend::command_buffer::uav_barrier_texture;
+                g_Backend.__command_buffer__uav_barrier_render_texture = null_backend::command_buffer::uav_barrier_render_texture;
+                g_Backend.__command_buffer__uav_barriers = null_backend::command_buffer::uav_barriers;
+                g_Backend.__command_buffer__aliasing_barriers = null_backend::command_buffer::aliasing_barriers;
+                g_Backend.__command_buffer__transition_to_common = null_backend::command_buffer::transition_to_common;
+                g_Backend.__command_buffer__transition_to_copy_source = null_backend::command_buffer::transition_to_copy_source;
+                g_Backend.__command_buffer__transition_to_present = null_backend::command_buffer::transition_to_present;
+                g_Backend.__command_buffer__transition_for_compute_queue = null_backend::command_buffer::transition_for_compute_queue;
+                g_Backend.__command_buffer__set_compute_shader_cbuffer = null_backend::command_buffer::set_compute_shader_cbuffer;
+                g_Backend.__command_buffer__set_compute_shader_buffer = null_backend::command_buffer::set_compute_shader_buffer;
+                g_Backend.__command_buffer__set_compute_shader_texture = null_backend::command_buffer::set_compute_shader_texture;
+                g_Backend.__command_buffer__set_compute_shader_render_texture = null_backend::command_buffer::set_compute_shader_render_texture;
+                g_Backend.__command_buffer__set_compute_shader_sampler = null_backend::command_buffer::set_compute_shader_sampler;
+                g_Backend.__command_buffer__set_compute_shader_rtas = null_backend::command_buffer::set_compute_shader_rtas;
+                g_Backend.__command_buffer__dispatch = null_backend::command_buffer::dispatch;
+                g_Backend.__command_buffer__dispatch_indirect = null_backend::command_buffer::dispatch_indirect;
+                g_Backend.__command_buffer__set_viewport = null_backend::command_buffer::set_viewport;
+                g_Backend.__command_buffer__set_graphics_pipeline_cbuffer = null_backend::command_buffer::set_graphics_pipeline_cbuffer;
+                g_Backend.__command_buffer__set_graphics_pipeline_buffer = null_backend::command_buffer::set_graphics_pipeline_buffer;
+                g_Backend.__command_buffer__set_graphics_pipeline_texture = null_backend::command_buffer::set_graphics_pipeline_texture;
+                g_Backend.__command_buffer__set_graphics_pipeline_render_texture = null_backend::command_buffer::set_graphics_pipeline_render_texture;
+                g_Backend.__command_buffer__set_graphics_pipeline_sampler = null_backend::command_buffer::set_graphics_pipeline_sampler;
+                g_Backend.__command_buffer__set_graphics_pipeline_rtas = null_backend::command_buffer::set_graphics_pipeline_rtas;
+                g_Backend.__command_buffer__draw_indexed = null_backend::command_buffer::draw_indexed;
+                g_Backend.__command_buffer__draw_procedural = null_backend::command_buffer::draw_procedural;
+                g_Backend.__command_buffer__draw_procedural_indirect = null_backend::command_buffer::draw_procedural_indirect;
+                g_Backend.__command_buffer__build_blas = null_backend::command_buffer::build_blas;
+                g_Backend.__command_buffer__build_tlas = null_backend::command_buffer::build_tlas;
+                g_Backend.__command_buffer__start_section = null_backend::command_buffer::start_section;
+                g_Backend.__command_buffer__end_section = null_backend::command_buffer::end_section;
+                g_Backend.__command_buffer__enable_profiling_scope = null_backend::command_buffer::enable_profiling_scope;
+                g_Backend.__command_buffer__disable_profiling_scope = null_backend::command_buffer::disable_profiling_scope;
+                g_Backend.__command_buffer__write_timestamp = null_backend::command_buffer::write_timestamp;
+                g_Backend.__command_buffer__resolve_timestamps = null_backend::command_buffer::resolve_timestamps;
+                g_Backend.__command_buffer__convert_mat_32_to_16 = null_backend::command_buffer::convert_mat_32_to_16;
+
+                // Window
+                g_Backend.__window__create_window = null_backend::window::create_window;
+                g_Backend.__window__destroy_window = null_backend::window::destroy_window;
+                g_Backend.__window__viewport_size = null_backend::window::viewport_size;
+                g_Backend.__window__viewport_center = null_backend::window::viewport_center;
+                g_Backend.__window__viewport_bounds = null_backend::window::viewport_bounds;
+                g_Backend.__window__window_size = null_backend::window::window_size;
+                g_Backend.__window__window_center = null_backend::window::window_center;
+                g_Backend.__window__window_bounds = null_backend::window::window_bounds;
+                g_Backend.__window__handle_messages = null_backend::window::handle_messages;
+                g_Backend.__window__show = null_backend::window::show;
+                g_Backend.__window__hide = null_backend::window::hide;
+                g_Backend.__window__set_cursor_visibility = null_backend::window::set_cursor_visibility;
+                g_Backend.__window__set_cursor_pos = null_backend::window::set_cursor_pos;
+
+                // Swap Chain
+                g_Backend.__swap_chain__create_swap_chain = null_backend::swap_chain::create_swap_chain;
+                g_Backend.__swap_chain__destroy_swap_chain = null_backend::swap_chain::destroy_swap_chain;
+                g_Backend.__swap_chain__get_current_render_texture = null_backend::swap_chain::get_current_render_texture;
+                g_Backend.__swap_chain__present = null_backend::swap_chain::present;
+
+                // Graphics Resources
+                g_Backend.__graphics_resources__create_sampler = null_backend::resources::create_sampler;
+                g_Backend.__graphics_resources__destroy_sampler = null_backend::resources::destroy_sampler;
+                g_Backend.__graphics_resources__create_texture_1 = null_backend::resources::create_texture;
+                g_Backend.__graphics_resources__create_texture_2 = null_backend::resources::create_texture;
+                g_Backend.__graphics_resources__destroy_texture = null_backend::resources::destroy_texture;
+                g_Backend.__graphics_resources__texture_dimensions = null_backend::resources::texture_dimensions;
+                g_Backend.__graphics_resources__create_render_texture_1 = null_backend::resources::create_render_texture;
+                g_Backend.__graphics_resources__create_render_texture_2 = null_backend::resources::create_render_texture;
+                g_Backend.__graphics_resources__destroy_render_texture = null_backend::resources::destroy_render_texture;
+                g_Backend.__graphics_resources__render_texture_dimensions = null_backend::resources::render_texture_dimensions;
+                g_Backend.__graphics_resources__create_graphics_buffer = null_backend::resources::create_graphics_buffer;
+                g_Backend.__graphics_resources__destroy_graphics_buffer = null_backend::resources::destroy_graphics_buffer;
+                g_Backend.__graphics_resources__set_buffer_data = null_backend::resources::set_buffer_data;
+                g_Backend.__graphics_resources__allocate_cpu_buffer = null_backend::resources::allocate_cpu_buffer;
+                g_Backend.__graphics_resources__release_cpu_buffer = null_backend::resources::release_cpu_buffer;
+                g_Backend.__graphics_resources__set_buffer_debug_name = null_backend::resources::set_buffer_debug_name;
+                g_Backend.__graphics_resources__create_transient_heap = null_backend::resources::create_transient_heap;
+                g_Backend.__graphics_resources__destroy_transient_heap = null_backend::resources::destroy_transient_heap;
+                g_Backend.__graphics_resources__graphics_buffer_footprint = null_backend::resources::graphics_buffer_footprint;
+                g_Backend.__graphics_resources__render_texture_footprint = null_backend::resources::render_texture_footprint;
+                g_Backend.__graphics_resources__create_aliased_graphics_buffer = null_backend::resources::create_aliased_graphics_buffer;
+                g_Backend.__graphics_resources__create_aliased_render_texture = null_backend::resources::create_aliased_render_texture;
+                g_Backend.__graphics_resources__create_constant_buffer = null_backend::resources::create_constant_buffer;
+                g_Backend.__graphics_resources__destroy_constant_buffer = null_backend::resources::destroy_constant_buffer;
+                g_Backend.__graphics_resources__set_constant_buffer = null_backend::resources::set_constant_buffer;
+                g_Backend.__graphics_resources__create_blas = null_backend::resources::create_blas;
+                g_Backend.__graphics_resources__destroy_blas = null_backend::resources::destroy_blas;
+                g_Backend.__graphics_resources__create_tlas = null_backend::resources::create_tlas;
+                g_Backend.__graphics_resources__destroy_tlas = null_backend::resources::destroy_tlas;
+                g_Backend.__graphics_resources__set_tlas_instance = null_backend::resources::set_tlas_instance;
+                g_Backend.__graphics_resources__upload_tlas_instance_data = null_backend::resources::upload_tlas_instance_data;
+
+                // Compute shader
+                g_Backend.__compute_shader__create_compute_shader = null_backend::compute_shader::create_compute_shader;
+                g_Backend.__compute_shader__destroy_compute_shader = null_backend::compute_shader::destroy_compute_shader;
+                g_Backend.__compute_shader__source_dependencies = null_backend::compute_shader::source_dependencies;
+
+                // Graphics Pipeline
+                g_Backend.__graphics_pipeline__create_graphics_pipeline = null_backend::graphics_pipeline::create_graphics_pipeline;
+                g_Backend.__graphics_pipeline__destroy_graphics_pipeline = null_backend::graphics_pipeline::destroy_graphics_pipeline;
+                g_Backend.__graphics_pipeline__set_stencil_ref = null_backend::graphics_pipeline::set_stencil_ref;
+                g_Backend.__graphics_pipeline__source_dependencies = null_backend::graphics_pipeline::source_dependencies;
+
+                // Profiling scope
+                g_Backend.__profiling_scope__create_profiling_scope = null_backend::profiling_scope::create_profiling_scope;
+                g_Backend.__profiling_scope__destroy_profiling_scope = null_backend::profiling_scope::destroy_profiling_scope;
+                g_Backend.__profiling_scope__get_duration_us = null_backend::profiling_scope::get_duration_us;
+                g_Backend.__profiling_scope__read_timestamps = null_backend::profiling_scope::read_timestamps;
+                g_Backend.__profiling_scope__timestamp_frequency = null_backend::profiling_scope::timestamp_frequency;
+                g_Backend.__profiling_scope__clock_calibration = null_backend::profiling_scope::clock_calibration;
+
+                // Fence
+                g_Backend.__fence__create_fence = null_backend::fence::create_fence;
+                g_Backend.__fence__destroy_fence = null_backend::fence::destroy_fence;
+                g_Backend.__fence__set_value = null_backend::fence::set_value;
+                g_Backend.__fence__get_value = null_backend::fence::get_value;
+                g_Backend.__fence__wait_value = null_backend::fence::wait_value;
+
+                // IMGUI
+                g_Backend.__imgui__initialize_imgui = null_backend::imgui::initialize_imgui;
+                g_Backend.__imgui__release_imgui = null_backend::imgui::release_imgui;
+                g_Backend.__imgui__start_frame = null_backend::imgui::start_frame;
+                g_Backend.__imgui__end_frame = null_backend::imgui::end_frame;
+                g_Backend.__imgui__draw_frame = null_backend::imgui::draw_frame;
+                g_Backend.__imgui__handle_input = null_backend::imgui::handle_input;
+
+                // All pointers set, valid state
+                printf("Null API set up.\n");
+                return true;
             default:
                 printf("Unknown graphics API.\n");
         }
@@ -384,7 +620,9 @@ namespace graphics
         const char* get_device_name(GraphicsDevice device) { return g_Backend.__device__get_device_name(device); }
         bool feature_support(GraphicsDevice device, GPUFeature feature) { return g_Backend.__device__feature_support(device, feature); }
         CoopMatTier coop_mat_tier(GraphicsDevice device) { return g_Backend.__device__coop_mat_tier(device); }
+        uint2 wave_lane_count_range(GraphicsDevice device) { return g_Backend.__device__wave_lane_count_range(device); }
         void set_stable_power_state(GraphicsDevice device, bool state) { g_Backend.__device__set_stable_power_state(device, state); }
+        DeviceMemoryStats memory_stats(GraphicsDevice device) { return g_Backend.__device__memory_stats(device); }
     }
 
     namespace command_queue
@@ -403,6 +641,7 @@ namespace graphics
         void destroy_command_buffer(CommandBuffer command_buffer) { g_Backend.__command_buffer__destroy_command_buffer(command_buffer); }
         void reset(CommandBuffer commandBuffer) { g_Backend.__command_buffer__reset(commandBuffer); }
         void close(CommandBuffer commandBuffer) { g_Backend.__command_buffer__close(commandBuffer); }
+        CommandBufferType command_buffer_type(CommandBuffer commandBuffer) { return g_Backend.__command_buffer__command_buffer_type(commandBuffer); }
         void clear_render_texture(CommandBuffer commandBuffer, RenderTexture renderTexture, const float4& color) { g_Backend.__command_buffer__clear_render_texture(commandBuffer, renderTexture, color); }
         void clear_depth_texture(CommandBuffer commandBuffer, RenderTexture depthTexture, float value) { g_Backend.__command_buffer__clear_depth_texture(commandBuffer, depthTexture, value); }
         void clear_depth_stencil_texture(CommandBuffer commandBuffer, RenderTexture depthTexture, float depth, uint8_t stencil) { g_Backend.__command_buffer__clear_depth_stencil_texture(commandBuffer, depthTexture, depth, stencil); }
@@ -428,26 +667,29 @@ namespace graphics
         void uav_barrier_buffer(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer) { g_Backend.__command_buffer__uav_barrier_buffer(commandBuffer, targetBuffer); }
         void uav_barrier_texture(CommandBuffer commandBuffer, Texture texture) { g_Backend.__command_buffer__uav_barrier_texture(commandBuffer, texture); }
         void uav_barrier_render_texture(CommandBuffer commandBuffer, RenderTexture renderTexture) { g_Backend.__command_buffer__uav_barrier_render_texture(commandBuffer, renderTexture); }
+        void uav_barriers(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures) { g_Backend.__command_buffer__uav_barriers(commandBuffer, buffers, numBuffers, renderTextures, numRenderTextures); }
+        void aliasing_barriers(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures) { g_Backend.__command_buffer__aliasing_barriers(commandBuffer, buffers, numBuffers, renderTextures, numRenderTextures); }
         void transition_to_common(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer) { g_Backend.__command_buffer__transition_to_common(commandBuffer, targetBuffer); }
         void transition_to_copy_source(CommandBuffer commandBuffer, GraphicsBuffer targetBuffer) { g_Backend.__command_buffer__transition_to_copy_source(commandBuffer, targetBuffer); }
         void transition_to_present(CommandBuffer commandBuffer, RenderTexture renderTexture) { g_Backend.__command_buffer__transition_to_present(commandBuffer, renderTexture); }
+        void transition_for_compute_queue(CommandBuffer commandBuffer, const GraphicsBuffer* buffers, uint32_t numBuffers, const RenderTexture* renderTextures, uint32_t numRenderTextures, bool unorderedAccess) { g_Backend.__command_buffer__transition_for_compute_queue(commandBuffer, buffers, numBuffers, renderTextures, numRenderTextures, unorderedAccess); }
         
-        void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, ConstantBuffer constantBuffer) { g_Backend.__command_buffer__set_compute_shader_cbuffer(commandBuffer, computeShader, name, constantBuffer); }
-        void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, GraphicsBuffer graphicsBuffer) { g_Backend.__command_buffer__set_compute_shader_buffer(commandBuffer, computeShader, name, graphicsBuffer); }
-        void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Texture texture, uint32_t mipLevel) { g_Backend.__command_buffer__set_compute_shader_texture(commandBuffer, computeShader, name, texture, mipLevel); }
-        void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, RenderTexture texture) { g_Backend.__command_buffer__set_compute_shader_render_texture(commandBuffer, computeShader, name, texture); }
-        void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, Sampler sampler) { g_Backend.__command_buffer__set_compute_shader_sampler(commandBuffer, computeShader, name, sampler); }
-        void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, const char* name, TopLevelAS rtas) { g_Backend.__command_buffer__set_compute_shader_rtas(commandBuffer, computeShader, name, rtas); }
+        void set_compute_shader_cbuffer(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, ConstantBuffer constantBuffer) { g_Backend.__command_buffer__set_compute_shader_cbuffer(commandBuffer, computeShader, bindingID, constantBuffer); }
+        void set_compute_shader_buffer(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, GraphicsBuffer graphicsBuffer) { g_Backend.__command_buffer__set_compute_shader_buffer(commandBuffer, computeShader, bindingID, graphicsBuffer); }
+        void set_compute_shader_texture(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, Texture texture, uint32_t mipLevel) { g_Backend.__command_buffer__set_compute_shader_texture(commandBuffer, computeShader, bindingID, texture, mipLevel); }
+        void set_compute_shader_render_texture(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, RenderTexture texture) { g_Backend.__command_buffer__set_compute_shader_render_texture(commandBuffer, computeShader, bindingID, texture); }
+        void set_compute_shader_sampler(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, Sampler sampler) { g_Backend.__command_buffer__set_compute_shader_sampler(commandBuffer, computeShader, bindingID, sampler); }
+        void set_compute_shader_rtas(CommandBuffer commandBuffer, ComputeShader computeShader, BindingID bindingID, TopLevelAS rtas) { g_Backend.__command_buffer__set_compute_shader_rtas(commandBuffer, computeShader, bindingID, rtas); }
         void dispatch(CommandBuffer commandBuffer, ComputeShader computeShader, uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ) { g_Backend.__command_buffer__dispatch(commandBuffer, computeShader, sizeX, sizeY, sizeZ); }
         void dispatch_indirect(CommandBuffer commandBuffer, ComputeShader computeShader, GraphicsBuffer indirectBuffer, uint32_t offset) { g_Backend.__command_buffer__dispatch_indirect(commandBuffer, computeShader, indirectBuffer, offset); }
         
         void set_viewport(CommandBuffer commandBuffer, int32_t offsetX, int32_t offsetY, uint32_t width, uint32_t height) { g_Backend.__command_buffer__set_viewport(commandBuffer, offsetX, offsetY, width, height); }
-        void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, ConstantBuffer constantBuffer) { g_Backend.__command_buffer__set_graphics_pipeline_cbuffer(commandBuffer, graphicsPipeline, name, constantBuffer); }
-        void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset) { g_Backend.__command_buffer__set_graphics_pipeline_buffer(commandBuffer, graphicsPipeline, name, graphicsBuffer, bufferOffset); }
-        void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Texture texture) { g_Backend.__command_buffer__set_graphics_pipeline_texture(commandBuffer, graphicsPipeline, name, texture); }
-        void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, RenderTexture renderTexture) { g_Backend.__command_buffer__set_graphics_pipeline_render_texture(commandBuffer, graphicsPipeline, name, renderTexture); }
-        void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, Sampler sampler) { g_Backend.__command_buffer__set_graphics_pipeline_sampler(commandBuffer, graphicsPipeline, name, sampler); }
-        void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, const char* name, TopLevelAS rtas) { g_Backend.__command_buffer__set_graphics_pipeline_rtas(commandBuffer, graphicsPipeline, name, rtas); }
+        void set_graphics_pipeline_cbuffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, ConstantBuffer constantBuffer) { g_Backend.__command_buffer__set_graphics_pipeline_cbuffer(commandBuffer, graphicsPipeline, bindingID, constantBuffer); }
+        void set_graphics_pipeline_buffer(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, GraphicsBuffer graphicsBuffer, uint64_t bufferOffset) { g_Backend.__command_buffer__set_graphics_pipeline_buffer(commandBuffer, graphicsPipeline, bindingID, graphicsBuffer, bufferOffset); }
+        void set_graphics_pipeline_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Texture texture) { g_Backend.__command_buffer__set_graphics_pipeline_texture(commandBuffer, graphicsPipeline, bindingID, texture); }
+        void set_graphics_pipeline_render_texture(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, RenderTexture renderTexture) { g_Backend.__command_buffer__set_graphics_pipeline_render_texture(commandBuffer, graphicsPipeline, bindingID, renderTexture); }
+        void set_graphics_pipeline_sampler(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Sampler sampler) { g_Backend.__command_buffer__set_graphics_pipeline_sampler(commandBuffer, graphicsPipeline, bindingID, sampler); }
+        void set_graphics_pipeline_rtas(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, TopLevelAS rtas) { g_Backend.__command_buffer__set_graphics_pipeline_rtas(commandBuffer, graphicsPipeline, bindingID, rtas); }
         void draw_indexed(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, uint32_t numTriangles, uint32_t numInstances, DrawPrimitive primitive) { g_Backend.__command_buffer__draw_indexed(commandBuffer, graphicsPipeline, vertexBuffer, indexBuffer, numTriangles, numInstances, primitive); }
         void draw_procedural(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, uint32_t numTriangles, uint32_t numInstances, DrawPrimitive primitive) { g_Backend.__command_buffer__draw_procedural(commandBuffer, graphicsPipeline, numTriangles, numInstances, primitive); }
         void draw_procedural_indirect(CommandBuffer commandBuffer, GraphicsPipeline graphicsPipeline, GraphicsBuffer indirectBuffer, uint64_t buffeOffset) { g_Backend.__command_buffer__draw_procedural_indirect(commandBuffer, graphicsPipeline, indirectBuffer, buffeOffset); }
@@ -455,11 +697,24 @@ namespace graphics
         void build_blas(CommandBuffer cmdB, BottomLevelAS blas) { g_Backend.__command_buffer__build_blas(cmdB, blas); }
         void build_tlas(CommandBuffer cmdB, TopLevelAS tlas) { g_Backend.__command_buffer__build_tlas(cmdB, tlas); }
 
-        void start_section(CommandBuffer commandBuffer, const std::string& eventName) { g_Backend.__command_buffer__start_section(commandBuffer, eventName); }
-        void end_section(CommandBuffer commandBuffer) { g_Backend.__command_buffer__end_section(commandBuffer); }
+        void start_section(CommandBuffer commandBuffer, const std::string& eventName)
+        {
+            g_Backend.__command_buffer__start_section(commandBuffer, eventName);
+            if (g_SectionCallback != nullptr)
+                g_SectionCallback(g_SectionUserData, commandBuffer, eventName.c_str());
+        }
+        void end_section(CommandBuffer commandBuffer)
+        {
+            if (g_SectionCallback != nullptr)
+                g_SectionCallback(g_SectionUserData, commandBuffer, nullptr);
+            g_Backend.__command_buffer__end_section(commandBuffer);
+        }
+        void set_section_listener(SectionCallback callback, void* userData) { g_SectionCallback = callback; g_SectionUserData = userData; }
 
         void enable_profiling_scope(CommandBuffer commandBuffer, ProfilingScope scope) { g_Backend.__command_buffer__enable_profiling_scope(commandBuffer, scope); }
         void disable_profiling_scope(CommandBuffer commandBuffer, ProfilingScope scope) { g_Backend.__command_buffer__disable_profiling_scope(commandBuffer, scope); }
+        void write_timestamp(CommandBuffer commandBuffer, ProfilingScope scope, uint32_t index) { g_Backend.__command_buffer__write_timestamp(commandBuffer, scope, index); }
+        void resolve_timestamps(CommandBuffer commandBuffer, ProfilingScope scope, uint32_t first, uint32_t count) { g_Backend.__command_buffer__resolve_timestamps(commandBuffer, scope, first, count); }
 
         void convert_mat_32_to_16(CommandBuffer commandBuffer, GraphicsBuffer inputMatrixBuffer, uint64_t inputOffset, GraphicsBuffer outputMatrixBuffer, uint64_t outputOffset, uint32_t width, uint32_t height, bool optimal) { g_Backend.__command_buffer__convert_mat_32_to_16(commandBuffer, inputMatrixBuffer, inputOffset, outputMatrixBuffer, outputOffset, width, height, optimal); }
     }
@@ -511,6 +766,13 @@ namespace graphics
         void release_cpu_buffer(GraphicsBuffer gb) { g_Backend.__graphics_resources__release_cpu_buffer(gb); }
         void set_buffer_debug_name(GraphicsBuffer gb, const char* name) { g_Backend.__graphics_resources__set_buffer_debug_name(gb, name); }
 
+        TransientHeap create_transient_heap(GraphicsDevice gd, uint64_t size) { return g_Backend.__graphics_resources__create_transient_heap(gd, size); }
+        void destroy_transient_heap(TransientHeap heap) { g_Backend.__graphics_resources__destroy_transient_heap(heap); }
+        void graphics_buffer_footprint(GraphicsDevice gd, uint64_t bufferSize, uint64_t& size, uint64_t& alignment) { g_Backend.__graphics_resources__graphics_buffer_footprint(gd, bufferSize, size, alignment); }
+        void render_texture_footprint(GraphicsDevice gd, const TextureDescriptor& desc, uint64_t& size, uint64_t& alignment) { g_Backend.__graphics_resources__render_texture_footprint(gd, desc, size, alignment); }
+        GraphicsBuffer create_aliased_graphics_buffer(TransientHeap heap, uint64_t offset, uint64_t size, uint32_t elemSize, uint32_t flags) { return g_Backend.__graphics_resources__create_aliased_graphics_buffer(heap, offset, size, elemSize, flags); }
+        RenderTexture create_aliased_render_texture(TransientHeap heap, uint64_t offset, const TextureDescriptor& desc) { return g_Backend.__graphics_resources__create_aliased_render_texture(heap, offset, desc); }
+
         ConstantBuffer create_constant_buffer(GraphicsDevice gd, uint32_t elemSize, ConstantBufferType type) { return g_Backend.__graphics_resources__create_constant_buffer(gd, elemSize, type); }
         void destroy_constant_buffer(ConstantBuffer cb) { g_Backend.__graphics_resources__destroy_constant_buffer(cb); }
         void set_constant_buffer(ConstantBuffer cb, const char* data, uint32_t size) { g_Backend.__graphics_resources__set_constant_buffer(cb, data, size); }
@@ -528,6 +790,7 @@ namespace graphics
     {
         ComputeShader create_compute_shader(GraphicsDevice graphicsDevice, const ComputeShaderDescriptor& csd, bool experimental) { return g_Backend.__compute_shader__create_compute_shader(graphicsDevice, csd, experimental); }
         void destroy_compute_shader(ComputeShader computeShader) { g_Backend.__compute_shader__destroy_compute_shader(computeShader); }
+        const std::vector<std::string>& source_dependencies(ComputeShader computeShader) { return g_Backend.__compute_shader__source_dependencies(computeShader); }
     }
 
     namespace graphics_pipeline
@@ -535,13 +798,26 @@ namespace graphics
         GraphicsPipeline create_graphics_pipeline(GraphicsDevice graphicsDevice, const GraphicsPipelineDescriptor& graphicsPipelineDescriptor) { return g_Backend.__graphics_pipeline__create_graphics_pipeline(graphicsDevice, graphicsPipelineDescriptor); }
         void destroy_graphics_pipeline(GraphicsPipeline graphicsPipeline) { g_Backend.__graphics_pipeline__destroy_graphics_pipeline(graphicsPipeline); }
         void set_stencil_ref(GraphicsPipeline graphicsPipeline, uint8_t stencilRef) { g_Backend.__graphics_pipeline__set_stencil_ref(graphicsPipeline, stencilRef); }
+        const std::vector<std::string>& source_dependencies(GraphicsPipeline graphicsPipeline) { return g_Backend.__graphics_pipeline__source_dependencies(graphicsPipeline); }
     }
 
     namespace profiling_scope
     {
-        ProfilingScope create_profiling_scope(GraphicsDevice graphicsDevice) { return g_Backend.__profiling_scope__create_profiling_scope(graphicsDevice); }
+        ProfilingScope create_profiling_scope(GraphicsDevice graphicsDevice, uint32_t numTimestamps) { return g_Backend.__profiling_scope__create_profiling_scope(graphicsDevice, numTimestamps); }
         void destroy_profiling_scope(ProfilingScope profilingScope) { g_Backend.__profiling_scope__destroy_profiling_scope(profilingScope); }
         uint64_t get_duration_us(ProfilingScope profilingScope, CommandQueue cmdQ, CommandBufferType type) { return g_Backend.__profiling_scope__get_duration_us(profilingScope, cmdQ, type); };
+        void read_timestamps(ProfilingScope profilingScope, uint32_t first, uint32_t count, uint64_t* outTicks) { g_Backend.__profiling_scope__read_timestamps(profilingScope, first, count, outTicks); }
+        uint64_t timestamp_frequency(CommandQueue cmdQ, CommandBufferType type) { return g_Backend.__profiling_scope__timestamp_frequency(cmdQ, type); }
+        void clock_calibration(CommandQueue cmdQ, CommandBufferType type, uint64_t& outGPUTicks, uint64_t& outCPUTimeNS) { g_Backend.__profiling_scope__clock_calibration(cmdQ, type, outGPUTicks, outCPUTimeNS); }
+    }
+
+    namespace fence
+    {
+        Fence create_fence(GraphicsDevice graphicsDevice, uint64_t initialValue) { return g_Backend.__fence__create_fence(graphicsDevice, initialValue); }
+        void destroy_fence(Fence fence) { g_Backend.__fence__destroy_fence(fence); }
+        void set_value(Fence fence, uint64_t value) { g_Backend.__fence__set_value(fence, value); }
+        uint64_t get_value(Fence fence) { return g_Backend.__fence__get_value(fence); }
+        void wait_value(Fence fence, uint64_t value) { g_Backend.__fence__wait_value(fence, value); }
     }
 
     namespace imgui
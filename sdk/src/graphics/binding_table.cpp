@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "graphics/binding_table.h"
+#include "tools/security.h"
+
+void BindingTable::build(const BindingID* bindingIDs, uint32_t numBindings)
+{
+	// Power of two with at least one free entry per binding, so that a miss always ends on a free entry
+	uint32_t numEntries = 4;
+	while (numEntries < numBindings * 2)
+		numEntries *= 2;
+	m_Mask = numEntries - 1;
+	m_NumBindings = numBindings;
+	m_IDs.assign(numEntries, 0);
+	m_Slots.assign(numEntries, BINDING_TABLE_EMPTY);
+
+	for (uint32_t bindingIdx = 0; bindingIdx < numBindings; ++bindingIdx)
+	{
+		const BindingID bindingID = bindingIDs[bindingIdx];
+		uint32_t entryIdx = bindingID & m_Mask;
+		while (m_Slots[entryIdx] != BINDING_TABLE_EMPTY)
+		{
+			assert_msg(m_IDs[entryIdx] != bindingID, "Binding identifier collision, rename one of the resources.");
+			entryIdx = (entryIdx + 1) & m_Mask;
+		}
+		m_IDs[entryIdx] = bindingID;
+		m_Slots[entryIdx] = bindingIdx;
+	}
+}
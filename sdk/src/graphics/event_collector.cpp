@@ -7,52 +7,77 @@
 
 // Internal includes
 #include "graphics/event_collector.h"
+#include "tools/spsc_queue.h"
 
 namespace event_collector
 {
 	// Queue that is used to keep track of the events
-	static std::queue<EventData> eventQueue;
+	static SPSCQueue<EventData> eventQueue(EVENT_QUEUE_CAPACITY);
 
 	// Flag that tracks if a rendering should be done
-	static bool drawRequested = false;
+	static std::atomic<bool> drawRequested(false);
+
+	// Events that didn't fit in the queue
+	static std::atomic<uint32_t> droppedEvents(0);
+
+	// Bumped by the window thread for every event and draw request, the render loop sleeps on it
+	static std::atomic<uint32_t> activity(0);
+
+	static void signal_activity()
+	{
+		activity.fetch_add(1, std::memory_order_release);
+		activity.notify_one();
+	}
 
 	// If an event has been recorded process it
 	bool peek_event(EventData& event)
 	{
-		if (eventQueue.size() > 0)
+		return eventQueue.pop(event);
+	}
+
+	// Keep track of this event
+	bool push_event(const EventData& event)
+	{
+		if (eventQueue.push(event))
 		{
-			event = eventQueue.front();
-			eventQueue.pop();
+			signal_activity();
 			return true;
 		}
+		droppedEvents.fetch_add(1, std::memory_order_relaxed);
 		return false;
 	}
 
-	// Keep track of this event
-	void push_event(const EventData& event)
+	void request_draw()
 	{
-		eventQueue.push(event);
+		drawRequested.store(true, std::memory_order_release);
+		signal_activity();
 	}
 
-	void request_draw()
+	void wait_for_activity()
 	{
-		drawRequested = true;
+		// The counter is read before the checks, anything signaled after them changes it and wakes the wait
+		uint32_t observed = activity.load(std::memory_order_acquire);
+		while (!drawRequested.load(std::memory_order_acquire) && eventQueue.size() == 0)
+		{
+			activity.wait(observed, std::memory_order_acquire);
+			observed = activity.load(std::memory_order_acquire);
+		}
 	}
 
-	bool active_draw_request()
+	bool consume_draw_request()
 	{
-		return drawRequested;
+		return drawRequested.exchange(false, std::memory_order_acq_rel);
 	}
 
-	void draw_done()
+	uint32_t dropped_events()
 	{
-		drawRequested = false;
+		return droppedEvents.load(std::memory_order_relaxed);
 	}
 
 	void clear()
 	{
-		drawRequested = false;
-		std::queue<EventData> empty;
-		std::swap(eventQueue, empty);
+		drawRequested.store(false, std::memory_order_relaxed);
+		droppedEvents.store(0, std::memory_order_relaxed);
+		eventQueue.clear();
 	}
 }
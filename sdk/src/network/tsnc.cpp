@@ -207,10 +207,10 @@ void TSNC::upload_network(CommandQueue cmdQ, CommandBuffer cmdB)
     }
 }
 
-void TSNC::reload_shaders(const std::string& shaderLibrary)
+void TSNC::reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch)
 {
     ComputeShaderDescriptor csd;
     csd.includeDirectories.push_back(shaderLibrary);
     csd.filename = shaderLibrary + "\\FP32toFP16.compute";
-    compile_and_replace_compute_shader(m_Device, csd, m_FP32toFP16CS);
+    batch.add_compute_shader(csd, m_FP32toFP16CS);
 }
\ No newline at end of file
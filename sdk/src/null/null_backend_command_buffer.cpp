@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "null/null_backend.h"
+#include "null/null_containers.h"
+#include "tools/security.h"
+
+// System includes
+#include <string.h>
+
+namespace null_backend
+{
+    namespace command_buffer
+    {
+        static void record_work(CommandBuffer commandBuffer)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            NullCommand command;
+            command.type = NullCommandType::Work;
+            command.durationNs = cmdI->device->commandDurationNs;
+            cmdI->commands.push_back(command);
+        }
+
+        static void bind_resource(uint64_t shader, BindingID bindingID, uint64_t resource)
+        {
+            NullShader* shaderI = (NullShader*)shader;
+            const uint32_t slotIdx = shaderI->bindingTable.find(bindingID);
+            assert_msg(slotIdx != BINDING_TABLE_EMPTY, "Unexistant binding.");
+            shaderI->boundResources[slotIdx] = resource;
+        }
+
+        CommandBuffer create_command_buffer(GraphicsDevice graphicsDevice, CommandBufferType commandBufferType)
+        {
+            NullCommandBuffer* cmdI = new NullCommandBuffer();
+            cmdI->device = (NullGraphicsDevice*)graphicsDevice;
+            cmdI->type = commandBufferType;
+            return (CommandBuffer)cmdI;
+        }
+
+        void destroy_command_buffer(CommandBuffer commandBuffer)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            delete cmdI;
+        }
+
+        void reset(CommandBuffer commandBuffer)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            cmdI->commands.clear();
+            cmdI->closed = false;
+            cmdI->sectionDepth = 0;
+        }
+
+        void close(CommandBuffer commandBuffer)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            assert_msg(cmdI->sectionDepth == 0, "Command buffer closed with open sections.");
+            cmdI->closed = true;
+        }
+
+        CommandBufferType command_buffer_type(CommandBuffer commandBuffer)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            return cmdI->type;
+        }
+
+#pragma region Render Texture
+        void clear_render_texture(CommandBuffer commandBuffer, RenderTexture, const float4&) { record_work(commandBuffer); }
+        void clear_depth_texture(CommandBuffer commandBuffer, RenderTexture, float) { record_work(commandBuffer); }
+        void clear_depth_stencil_texture(CommandBuffer commandBuffer, RenderTexture, float, uint8_t) { record_work(commandBuffer); }
+        void clear_stencil_texture(CommandBuffer commandBuffer, RenderTexture, uint8_t) { record_work(commandBuffer); }
+        void set_render_texture(CommandBuffer, RenderTexture) {}
+        void set_render_texture(CommandBuffer, RenderTexture, RenderTexture) {}
+        void set_render_texture(CommandBuffer, RenderTexture, RenderTexture, RenderTexture) {}
+        void set_render_texture(CommandBuffer, RenderTexture, RenderTexture, RenderTexture, RenderTexture) {}
+#pragma endregion
+
+#pragma region Copy
+        void copy_graphics_buffer(CommandBuffer commandBuffer, GraphicsBuffer inputBuffer, GraphicsBuffer outputBuffer)
+        {
+            NullBuffer* inputI = (NullBuffer*)inputBuffer;
+            NullBuffer* outputI = (NullBuffer*)outputBuffer;
+            assert_msg(inputI->data.size() == outputI->data.size(), "Copied buffers have different sizes.");
+            outputI->data = inputI->data;
+            record_work(commandBuffer);
+        }
+
+        void copy_graphics_buffer(CommandBuffer commandBuffer, GraphicsBuffer inputBuffer, uint32_t inputOffset, GraphicsBuffer outputBuffer, uint32_t outputOffset, uint64_t size)
+        {
+            NullBuffer* inputI = (NullBuffer*)inputBuffer;
+            NullBuffer* outputI = (NullBuffer*)outputBuffer;
+            assert_msg(inputOffset + size <= inputI->data.size() && outputOffset + size <= outputI->data.size(), "Copy out of the buffer bounds.");
+            memcpy(outputI->data.data() + outputOffset, inputI->data.data() + inputOffset, size);
+            record_work(commandBuffer);
+        }
+
+        void upload_constant_buffer(CommandBuffer commandBuffer, ConstantBuffer, ConstantBuffer) { record_work(commandBuffer); }
+        void upload_constant_buffer(CommandBuffer commandBuffer, ConstantBuffer) { record_work(commandBuffer); }
+        void copy_texture(CommandBuffer commandBuffer, Texture, Texture) { record_work(commandBuffer); }
+        void copy_texture(CommandBuffer commandBuffer, RenderTexture, uint32_t, RenderTexture, uint32_t) { record_work(commandBuffer); }
+        void copy_render_texture(CommandBuffer commandBuffer, RenderTexture, RenderTexture) { record_work(commandBuffer); }
+        void copy_buffer_into_texture(CommandBuffer commandBuffer, GraphicsBuffer, uint64_t, Texture, uint32_t, uint32_t) { record_work(commandBuffer); }
+        void copy_buffer_into_texture_mip(CommandBuffer commandBuffer, GraphicsBuffer, uint64_t, Texture, uint32_t) { record_work(commandBuffer); }
+        void copy_buffer_into_texture_mips(CommandBuffer commandBuffer, GraphicsBuffer, uint64_t, uint32_t, Texture, uint32_t) { record_work(commandBuffer); }
+        void copy_buffer_into_render_texture(CommandBuffer commandBuffer, GraphicsBuffer, uint64_t, Texture, uint32_t) { record_work(commandBuffer); }
+        void copy_texture_into_buffer(CommandBuffer commandBuffer, Texture, uint32_t, uint32_t, GraphicsBuffer, uint64_t) { record_work(commandBuffer); }
+        void copy_render_texture_into_buffer(CommandBuffer commandBuffer, RenderTexture, uint32_t, GraphicsBuffer, uint64_t) { record_work(commandBuffer); }
+#pragma endregion
+
+#pragma region UAV barrier
+        void uav_barrier_buffer(CommandBuffer, GraphicsBuffer) {}
+        void uav_barrier_texture(CommandBuffer, Texture) {}
+        void uav_barrier_render_texture(CommandBuffer, RenderTexture) {}
+        void uav_barriers(CommandBuffer, const GraphicsBuffer*, uint32_t, const RenderTexture*, uint32_t) {}
+#pragma endregion
+
+#pragma region Aliasing barrier
+        void aliasing_barriers(CommandBuffer, const GraphicsBuffer*, uint32_t, const RenderTexture*, uint32_t) {}
+#pragma endregion
+
+#pragma region Transitions
+        void transition_to_common(CommandBuffer, GraphicsBuffer) {}
+        void transition_to_copy_source(CommandBuffer, GraphicsBuffer) {}
+        void transition_to_present(CommandBuffer, RenderTexture) {}
+        void transition_for_compute_queue(CommandBuffer, const GraphicsBuffer*, uint32_t, const RenderTexture*, uint32_t, bool) {}
+#pragma endregion
+
+#pragma region Compute Shader
+        void set_compute_shader_cbuffer(CommandBuffer, ComputeShader computeShader, BindingID bindingID, ConstantBuffer constantBuffer) { bind_resource(computeShader, bindingID, constantBuffer); }
+        void set_compute_shader_buffer(CommandBuffer, ComputeShader computeShader, BindingID bindingID, GraphicsBuffer graphicsBuffer) { bind_resource(computeShader, bindingID, graphicsBuffer); }
+        void set_compute_shader_texture(CommandBuffer, ComputeShader computeShader, BindingID bindingID, Texture texture, uint32_t) { bind_resource(computeShader, bindingID, texture); }
+        void set_compute_shader_render_texture(CommandBuffer, ComputeShader computeShader, BindingID bindingID, RenderTexture texture) { bind_resource(computeShader, bindingID, texture); }
+        void set_compute_shader_sampler(CommandBuffer, ComputeShader computeShader, BindingID bindingID, Sampler sampler) { bind_resource(computeShader, bindingID, sampler); }
+        void set_compute_shader_rtas(CommandBuffer, ComputeShader computeShader, BindingID bindingID, TopLevelAS rtas) { bind_resource(computeShader, bindingID, rtas); }
+        void dispatch(CommandBuffer commandBuffer, ComputeShader, uint32_t, uint32_t, uint32_t) { record_work(commandBuffer); }
+        void dispatch_indirect(CommandBuffer commandBuffer, ComputeShader, GraphicsBuffer, uint32_t) { record_work(commandBuffer); }
+#pragma endregion
+
+#pragma region Graphics Pipeline
+        void set_viewport(CommandBuffer, int32_t, int32_t, uint32_t, uint32_t) {}
+        void set_graphics_pipeline_cbuffer(CommandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, ConstantBuffer constantBuffer) { bind_resource(graphicsPipeline, bindingID, constantBuffer); }
+        void set_graphics_pipeline_buffer(CommandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, GraphicsBuffer graphicsBuffer, uint64_t) { bind_resource(graphicsPipeline, bindingID, graphicsBuffer); }
+        void set_graphics_pipeline_texture(CommandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Texture texture) { bind_resource(graphicsPipeline, bindingID, texture); }
+        void set_graphics_pipeline_render_texture(CommandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, RenderTexture renderTexture) { bind_resource(graphicsPipeline, bindingID, renderTexture); }
+        void set_graphics_pipeline_sampler(CommandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, Sampler sampler) { bind_resource(graphicsPipeline, bindingID, sampler); }
+        void set_graphics_pipeline_rtas(CommandBuffer, GraphicsPipeline graphicsPipeline, BindingID bindingID, TopLevelAS rtas) { bind_resource(graphicsPipeline, bindingID, rtas); }
+        void draw_indexed(CommandBuffer commandBuffer, GraphicsPipeline, GraphicsBuffer, GraphicsBuffer, uint32_t, uint32_t, DrawPrimitive) { record_work(commandBuffer); }
+        void draw_procedural(CommandBuffer commandBuffer, GraphicsPipeline, uint32_t, uint32_t, DrawPrimitive) { record_work(commandBuffer); }
+        void draw_procedural_indirect(CommandBuffer commandBuffer, GraphicsPipeline, GraphicsBuffer, uint64_t) { record_work(commandBuffer); }
+#pragma endregion
+
+#pragma region Ray Tracing
+        void build_blas(CommandBuffer cmdB, BottomLevelAS) { record_work(cmdB); }
+        void build_tlas(CommandBuffer cmdB, TopLevelAS) { record_work(cmdB); }
+#pragma endregion
+
+#pragma region Events
+        void start_section(CommandBuffer commandBuffer, const std::string&)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            cmdI->sectionDepth++;
+        }
+
+        void end_section(CommandBuffer commandBuffer)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            assert_msg(cmdI->sectionDepth > 0, "Section ended without being started.");
+            cmdI->sectionDepth--;
+        }
+#pragma endregion
+
+#pragma region Profiling scopes
+        void enable_profiling_scope(CommandBuffer commandBuffer, ProfilingScope scope)
+        {
+            write_timestamp(commandBuffer, scope, 0);
+        }
+
+        void disable_profiling_scope(CommandBuffer commandBuffer, ProfilingScope scope)
+        {
+            write_timestamp(commandBuffer, scope, 1);
+            resolve_timestamps(commandBuffer, scope, 0, 2);
+        }
+
+        void write_timestamp(CommandBuffer commandBuffer, ProfilingScope scope, uint32_t index)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            NullQuery* queryI = (NullQuery*)scope;
+            assert_msg(index < queryI->written.size(), "Timestamp index out of the profiling scope.");
+            NullCommand command;
+            command.type = NullCommandType::Timestamp;
+            command.query = queryI;
+            command.first = index;
+            cmdI->commands.push_back(command);
+        }
+
+        void resolve_timestamps(CommandBuffer commandBuffer, ProfilingScope scope, uint32_t first, uint32_t count)
+        {
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            NullQuery* queryI = (NullQuery*)scope;
+            assert_msg(first + count <= queryI->written.size(), "Resolved timestamps out of the profiling scope.");
+            NullCommand command;
+            command.type = NullCommandType::Resolve;
+            command.query = queryI;
+            command.first = first;
+            command.count = count;
+            cmdI->commands.push_back(command);
+        }
+#pragma endregion
+
+#pragma region Misc
+        void convert_mat_32_to_16(CommandBuffer commandBuffer, GraphicsBuffer, uint64_t, GraphicsBuffer, uint64_t, uint32_t, uint32_t, bool) { record_work(commandBuffer); }
+#pragma endregion
+    }
+}
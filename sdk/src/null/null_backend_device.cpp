@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "null/null_backend.h"
+#include "null/null_containers.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace null_backend
+{
+    uint64_t now_ns()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void sleep_until_ns(uint64_t timeNs)
+    {
+        const uint64_t currentNs = now_ns();
+        if (timeNs > currentNs)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(timeNs - currentNs));
+    }
+
+    static uint32_t sub_queue_index(CommandBufferType type)
+    {
+        return type == CommandBufferType::Compute ? 1 : (type == CommandBufferType::Copy ? 2 : 0);
+    }
+
+    // Values the simulated GPU reached, the highest one wins like for a monotonic fence
+    static void retire_values(NullFence* fence, uint64_t timeNs)
+    {
+        auto reached = [timeNs](const std::pair<uint64_t, uint64_t>& pending) { return pending.second <= timeNs; };
+        for (const std::pair<uint64_t, uint64_t>& pending : fence->pendingValues)
+        {
+            if (reached(pending))
+                fence->completedValue = std::max(fence->completedValue, pending.first);
+        }
+        fence->pendingValues.erase(std::remove_if(fence->pendingValues.begin(), fence->pendingValues.end(), reached), fence->pendingValues.end());
+    }
+
+    static uint64_t to_ticks(uint64_t timeNs)
+    {
+        return (timeNs + NULL_GPU_CLOCK_OFFSET_NS) / (1000000000ull / NULL_TIMESTAMP_FREQUENCY);
+    }
+
+    namespace device
+    {
+        void enable_experimental_features() {}
+        void enable_debug_layer() {}
+
+        GraphicsDevice create_graphics_device(DevicePickStrategy, uint32_t)
+        {
+            NullGraphicsDevice* deviceI = new NullGraphicsDevice();
+            return (GraphicsDevice)deviceI;
+        }
+
+        void destroy_graphics_device(GraphicsDevice graphicsDevice)
+        {
+            NullGraphicsDevice* deviceI = (NullGraphicsDevice*)graphicsDevice;
+            delete deviceI;
+        }
+
+        GPUVendor get_gpu_vendor(GraphicsDevice)
+        {
+            return GPUVendor::Other;
+        }
+
+        const char* get_device_name(GraphicsDevice)
+        {
+            return "Null device";
+        }
+
+        bool feature_support(GraphicsDevice, GPUFeature)
+        {
+            return false;
+        }
+
+        CoopMatTier coop_mat_tier(GraphicsDevice)
+        {
+            return CoopMatTier::Other;
+        }
+
+        uint2 wave_lane_count_range(GraphicsDevice)
+        {
+            return { 32, 32 };
+        }
+
+        void set_stable_power_state(GraphicsDevice, bool) {}
+
+        DeviceMemoryStats memory_stats(GraphicsDevice graphicsDevice)
+        {
+            NullGraphicsDevice* deviceI = (NullGraphicsDevice*)graphicsDevice;
+            DeviceMemoryStats stats;
+            stats.heapMemory = deviceI->peakMemory;
+            stats.usedMemory = deviceI->usedMemory;
+            stats.peakMemory = deviceI->peakMemory;
+            stats.largestFreeBlock = deviceI->peakMemory - deviceI->usedMemory;
+            return stats;
+        }
+
+        void set_command_duration(GraphicsDevice graphicsDevice, uint64_t durationNs)
+        {
+            NullGraphicsDevice* deviceI = (NullGraphicsDevice*)graphicsDevice;
+            deviceI->commandDurationNs = durationNs;
+        }
+    }
+
+    namespace command_queue
+    {
+        CommandQueue create_command_queue(GraphicsDevice graphicsDevice, CommandQueuePriority, CommandQueuePriority, CommandQueuePriority)
+        {
+            NullCommandQueue* queueI = new NullCommandQueue();
+            queueI->device = (NullGraphicsDevice*)graphicsDevice;
+            return (CommandQueue)queueI;
+        }
+
+        void destroy_command_queue(CommandQueue commandQueue)
+        {
+            NullCommandQueue* queueI = (NullCommandQueue*)commandQueue;
+            delete queueI;
+        }
+
+        void execute_command_buffer(CommandQueue commandQueue, CommandBuffer commandBuffer, bool)
+        {
+            NullCommandQueue* queueI = (NullCommandQueue*)commandQueue;
+            NullCommandBuffer* cmdI = (NullCommandBuffer*)commandBuffer;
+            assert_msg(cmdI->closed, "Command buffer executed before being closed.");
+
+            // The command buffer starts once the GPU is done with the previous ones of the sub queue
+            uint64_t& busyUntil = queueI->busyUntil[sub_queue_index(cmdI->type)];
+            uint64_t cursor = std::max(now_ns(), busyUntil);
+            for (const NullCommand& command : cmdI->commands)
+            {
+                switch (command.type)
+                {
+                    case NullCommandType::Work:
+                        cursor += command.durationNs;
+                        break;
+                    case NullCommandType::Timestamp:
+                        command.query->written[command.first] = to_ticks(cursor);
+                        break;
+                    case NullCommandType::Resolve:
+                        std::copy(command.query->written.begin() + command.first, command.query->written.begin() + command.first + command.count, command.query->resolved.begin() + command.first);
+                        break;
+                }
+            }
+            busyUntil = cursor;
+        }
+
+        void signal(CommandQueue commandQueue, Fence fence, uint64_t value, CommandBufferType type)
+        {
+            NullCommandQueue* queueI = (NullCommandQueue*)commandQueue;
+            NullFence* fenceI = (NullFence*)fence;
+            std::lock_guard<std::mutex> lock(fenceI->mutex);
+            fenceI->pendingValues.push_back({ value, queueI->busyUntil[sub_queue_index(type)] });
+        }
+
+        void wait(CommandQueue commandQueue, Fence fence, uint64_t value, CommandBufferType type)
+        {
+            NullCommandQueue* queueI = (NullCommandQueue*)commandQueue;
+            NullFence* fenceI = (NullFence*)fence;
+            std::lock_guard<std::mutex> lock(fenceI->mutex);
+            if (fenceI->completedValue >= value)
+                return;
+
+            // The sub queue stalls until the signal is reached
+            uint64_t reachedNs = UINT64_MAX;
+            for (const std::pair<uint64_t, uint64_t>& pending : fenceI->pendingValues)
+            {
+                if (pending.first >= value)
+                    reachedNs = std::min(reachedNs, pending.second);
+            }
+            assert_msg(reachedNs != UINT64_MAX, "Queue waiting on a fence value that was never signaled.");
+            uint64_t& busyUntil = queueI->busyUntil[sub_queue_index(type)];
+            busyUntil = std::max(busyUntil, reachedNs);
+        }
+
+        void flush(CommandQueue commandQueue, CommandBufferType type)
+        {
+            NullCommandQueue* queueI = (NullCommandQueue*)commandQueue;
+            sleep_until_ns(queueI->busyUntil[sub_queue_index(type)]);
+        }
+    }
+
+    namespace fence
+    {
+        Fence create_fence(GraphicsDevice, uint64_t initialValue)
+        {
+            NullFence* fenceI = new NullFence();
+            fenceI->completedValue = initialValue;
+            return (Fence)fenceI;
+        }
+
+        void destroy_fence(Fence fence)
+        {
+            NullFence* fenceI = (NullFence*)fence;
+            delete fenceI;
+        }
+
+        void set_value(Fence fence, uint64_t value)
+        {
+            NullFence* fenceI = (NullFence*)fence;
+            std::lock_guard<std::mutex> lock(fenceI->mutex);
+            fenceI->completedValue = value;
+        }
+
+        uint64_t get_value(Fence fence)
+        {
+            NullFence* fenceI = (NullFence*)fence;
+            std::lock_guard<std::mutex> lock(fenceI->mutex);
+            retire_values(fenceI, now_ns());
+            return fenceI->completedValue;
+        }
+
+        void wait_value(Fence fence, uint64_t value)
+        {
+            NullFence* fenceI = (NullFence*)fence;
+            uint64_t reachedNs = UINT64_MAX;
+            {
+                std::lock_guard<std::mutex> lock(fenceI->mutex);
+                retire_values(fenceI, now_ns());
+                if (fenceI->completedValue >= value)
+                    return;
+                for (const std::pair<uint64_t, uint64_t>& pending : fenceI->pendingValues)
+                {
+                    if (pending.first >= value)
+                        reachedNs = std::min(reachedNs, pending.second);
+                }
+            }
+
+            // Nothing else can signal it, it would block forever
+            assert_msg(reachedNs != UINT64_MAX, "Waiting on a fence value that was never signaled.");
+            sleep_until_ns(reachedNs);
+
+            std::lock_guard<std::mutex> lock(fenceI->mutex);
+            retire_values(fenceI, reachedNs);
+        }
+    }
+
+    namespace profiling_scope
+    {
+        ProfilingScope create_profiling_scope(GraphicsDevice, uint32_t numTimestamps)
+        {
+            NullQuery* queryI = new NullQuery();
+            queryI->written.resize(numTimestamps, 0);
+            queryI->resolved.resize(numTimestamps, 0);
+            return (ProfilingScope)queryI;
+        }
+
+        void destroy_profiling_scope(ProfilingScope profilingScope)
+        {
+            NullQuery* queryI = (NullQuery*)profilingScope;
+            delete queryI;
+        }
+
+        uint64_t get_duration_us(ProfilingScope profilingScope, CommandQueue, CommandBufferType)
+        {
+            NullQuery* queryI = (NullQuery*)profilingScope;
+            return (uint64_t)((queryI->resolved[1] - queryI->resolved[0]) / (double)NULL_TIMESTAMP_FREQUENCY * 1e6);
+        }
+
+        void read_timestamps(ProfilingScope profilingScope, uint32_t first, uint32_t count, uint64_t* outTicks)
+        {
+            NullQuery* queryI = (NullQuery*)profilingScope;
+            std::copy(queryI->resolved.begin() + first, queryI->resolved.begin() + first + count, outTicks);
+        }
+
+        uint64_t timestamp_frequency(CommandQueue, CommandBufferType)
+        {
+            return NULL_TIMESTAMP_FREQUENCY;
+        }
+
+        void clock_calibration(CommandQueue, CommandBufferType, uint64_t& outGPUTicks, uint64_t& outCPUTimeNS)
+        {
+            outCPUTimeNS = now_ns();
+            outGPUTicks = to_ticks(outCPUTimeNS);
+        }
+    }
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "null/null_backend.h"
+#include "null/null_containers.h"
+#include "tools/shader_cache.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <ctype.h>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string.h>
+
+namespace null_backend
+{
+    // Stands for the reflection: every name declared with a register in the source tree is a binding of the shader.
+    // The registers themselves often are macros, they are not needed to validate the names.
+    static void reflect_shader(const std::string& filename, const std::vector<std::string>& includeDirectories, NullShader* shaderI)
+    {
+        shader_cache::source_dependencies(filename, includeDirectories, shaderI->dependencies);
+        assert_msg(!shaderI->dependencies.empty(), "Failed to open the shader source.");
+
+        std::set<std::string> names;
+        for (const std::string& dependency : shaderI->dependencies)
+        {
+            std::ifstream file(dependency);
+            const std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            for (size_t registerPos = source.find("register("); registerPos != std::string::npos; registerPos = source.find("register(", registerPos + 1))
+            {
+                // Walk back over the colon, the spaces and the array size to the end of the name
+                size_t end = source.rfind(':', registerPos);
+                if (end == std::string::npos)
+                    continue;
+                while (end > 0 && isspace((unsigned char)source[end - 1]))
+                    end--;
+                if (end > 0 && source[end - 1] == ']')
+                {
+                    end = source.rfind('[', end - 1);
+                    while (end != std::string::npos && end > 0 && isspace((unsigned char)source[end - 1]))
+                        end--;
+                }
+                if (end == std::string::npos)
+                    continue;
+                size_t start = end;
+                while (start > 0 && (isalnum((unsigned char)source[start - 1]) || source[start - 1] == '_'))
+                    start--;
+                if (start < end)
+                    names.insert(source.substr(start, end - start));
+            }
+        }
+
+        std::vector<BindingID> bindingIDs;
+        for (const std::string& name : names)
+            bindingIDs.push_back(binding_id(name.c_str()));
+        shaderI->bindingTable.build(bindingIDs.data(), (uint32_t)bindingIDs.size());
+        shaderI->boundResources.assign(bindingIDs.size(), 0);
+    }
+
+    // Bytes per texel of the uncompressed formats, the ones render textures use
+    static uint32_t texel_size(TextureFormat format)
+    {
+        if (format <= TextureFormat::R8_UInt)
+            return 1;
+        if (format <= TextureFormat::R8G8_UInt)
+            return 2;
+        if (format <= TextureFormat::R8G8B8A8_SInt)
+            return 4;
+        if (format <= TextureFormat::R16_UInt)
+            return 2;
+        if (format <= TextureFormat::R16G16_UInt)
+            return 4;
+        if (format <= TextureFormat::R16G16B16A16_SInt)
+            return 8;
+        if (format <= TextureFormat::R32_UInt)
+            return 4;
+        if (format <= TextureFormat::R32G32_UInt)
+            return 8;
+        if (format <= TextureFormat::R32G32B32_Float)
+            return 12;
+        if (format <= TextureFormat::R32G32B32A32_SInt)
+            return 16;
+        return format == TextureFormat::Depth32Stencil8 ? 8 : 4;
+    }
+
+    namespace resources
+    {
+#pragma region Sampler
+        Sampler create_sampler(GraphicsDevice, const SamplerDescriptor& smplDesc)
+        {
+            NullSampler* samplerI = new NullSampler();
+            samplerI->descriptor = smplDesc;
+            return (Sampler)samplerI;
+        }
+
+        void destroy_sampler(Sampler sampler)
+        {
+            NullSampler* samplerI = (NullSampler*)sampler;
+            delete samplerI;
+        }
+#pragma endregion
+
+#pragma region Texture
+        Texture create_texture(GraphicsDevice graphicsDevice, TextureType type, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipCount, bool isUAV, TextureFormat format, float4 clearColor, const char* debugName)
+        {
+            TextureDescriptor texDesc;
+            texDesc.type = type;
+            texDesc.width = width;
+            texDesc.height = height;
+            texDesc.depth = depth;
+            texDesc.mipCount = mipCount;
+            texDesc.isUAV = isUAV;
+            texDesc.format = format;
+            texDesc.clearColor = clearColor;
+            texDesc.debugName = debugName != nullptr ? debugName : "";
+            return create_texture(graphicsDevice, texDesc);
+        }
+
+        Texture create_texture(GraphicsDevice, const TextureDescriptor& rtDesc)
+        {
+            NullTexture* textureI = new NullTexture();
+            textureI->descriptor = rtDesc;
+            return (Texture)textureI;
+        }
+
+        void destroy_texture(Texture texture)
+        {
+            NullTexture* textureI = (NullTexture*)texture;
+            if (textureI->heap != nullptr)
+                textureI->heap->numResources--;
+            delete textureI;
+        }
+
+        void texture_dimensions(Texture texture, uint32_t& width, uint32_t& height, uint32_t& depth)
+        {
+            NullTexture* textureI = (NullTexture*)texture;
+            width = textureI->descriptor.width;
+            height = textureI->descriptor.height;
+            depth = textureI->descriptor.depth;
+        }
+#pragma endregion
+
+#pragma region Render Texture
+        RenderTexture create_render_texture(GraphicsDevice graphicsDevice, TextureType type, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipCount, bool isUAV, TextureFormat format, float4 clearColor, const char* debugName)
+        {
+            return (RenderTexture)create_texture(graphicsDevice, type, width, height, depth, mipCount, isUAV, format, clearColor, debugName);
+        }
+
+        RenderTexture create_render_texture(GraphicsDevice graphicsDevice, const TextureDescriptor& rtDesc)
+        {
+            return (RenderTexture)create_texture(graphicsDevice, rtDesc);
+        }
+
+        void destroy_render_texture(RenderTexture renderTexture)
+        {
+            destroy_texture((Texture)renderTexture);
+        }
+
+        void render_texture_dimensions(RenderTexture renderTexture, uint32_t& width, uint32_t& height, uint32_t& depth)
+        {
+            texture_dimensions((Texture)renderTexture, width, height, depth);
+        }
+#pragma endregion
+
+#pragma region Graphics Buffer
+        GraphicsBuffer create_graphics_buffer(GraphicsDevice graphicsDevice, uint64_t bufferSize, uint32_t elementSize, GraphicsBufferType bufferType, uint32_t)
+        {
+            NullBuffer* bufferI = new NullBuffer();
+            bufferI->device = (NullGraphicsDevice*)graphicsDevice;
+            bufferI->type = bufferType;
+            bufferI->elementSize = elementSize;
+            bufferI->data.resize(bufferSize, 0);
+
+            // Track the memory like the heaps of the device
+            bufferI->device->usedMemory += bufferSize;
+            bufferI->device->peakMemory = std::max(bufferI->device->peakMemory, bufferI->device->usedMemory);
+            return (GraphicsBuffer)bufferI;
+        }
+
+        void destroy_graphics_buffer(GraphicsBuffer graphicsBuffer)
+        {
+            NullBuffer* bufferI = (NullBuffer*)graphicsBuffer;
+            if (bufferI->device != nullptr)
+                bufferI->device->usedMemory -= bufferI->data.size();
+            if (bufferI->heap != nullptr)
+                bufferI->heap->numResources--;
+            delete bufferI;
+        }
+
+        void set_buffer_data(GraphicsBuffer graphicsBuffer, const char* buffer, uint64_t bufferSize, uint32_t bufferOffset)
+        {
+            NullBuffer* bufferI = (NullBuffer*)graphicsBuffer;
+            assert_msg(bufferOffset + bufferSize <= bufferI->data.size(), "Data out of the buffer bounds.");
+            memcpy(bufferI->data.data() + bufferOffset, buffer, bufferSize);
+        }
+
+        char* allocate_cpu_buffer(GraphicsBuffer graphicsBuffer)
+        {
+            NullBuffer* bufferI = (NullBuffer*)graphicsBuffer;
+            return bufferI->data.data();
+        }
+
+        void release_cpu_buffer(GraphicsBuffer) {}
+        void set_buffer_debug_name(GraphicsBuffer, const char*) {}
+#pragma endregion
+
+#pragma region Transient Heap
+        TransientHeap create_transient_heap(GraphicsDevice graphicsDevice, uint64_t heapSize)
+        {
+            NullTransientHeap* heapI = new NullTransientHeap();
+            heapI->device = (NullGraphicsDevice*)graphicsDevice;
+            heapI->size = heapSize;
+            heapI->device->usedMemory += heapSize;
+            heapI->device->peakMemory = std::max(heapI->device->peakMemory, heapI->device->usedMemory);
+            return (TransientHeap)heapI;
+        }
+
+        void destroy_transient_heap(TransientHeap transientHeap)
+        {
+            NullTransientHeap* heapI = (NullTransientHeap*)transientHeap;
+            assert_msg(heapI->numResources == 0, "Transient heap has still aliased resources.");
+            heapI->device->usedMemory -= heapI->size;
+            delete heapI;
+        }
+
+        void graphics_buffer_footprint(GraphicsDevice, uint64_t bufferSize, uint64_t& size, uint64_t& alignment)
+        {
+            alignment = NULL_PLACEMENT_ALIGNMENT;
+            size = (bufferSize + alignment - 1) & ~(alignment - 1);
+        }
+
+        void render_texture_footprint(GraphicsDevice, const TextureDescriptor& rtDesc, uint64_t& size, uint64_t& alignment)
+        {
+            // Unpadded mip chain, the driver would add the tiling on top of it
+            uint64_t textureSize = 0;
+            for (uint32_t mipIdx = 0; mipIdx < std::max(rtDesc.mipCount, 1u); ++mipIdx)
+                textureSize += (uint64_t)std::max(rtDesc.width >> mipIdx, 1u) * std::max(rtDesc.height >> mipIdx, 1u) * std::max(rtDesc.depth, 1u) * texel_size(rtDesc.format);
+            alignment = NULL_PLACEMENT_ALIGNMENT;
+            size = (textureSize + alignment - 1) & ~(alignment - 1);
+        }
+
+        GraphicsBuffer create_aliased_graphics_buffer(TransientHeap transientHeap, uint64_t heapOffset, uint64_t bufferSize, uint32_t elementSize, uint32_t)
+        {
+            NullTransientHeap* heapI = (NullTransientHeap*)transientHeap;
+            assert_msg(heapOffset % NULL_PLACEMENT_ALIGNMENT == 0 && heapOffset + bufferSize <= heapI->size, "Aliased buffer out of the transient heap.");
+            NullBuffer* bufferI = new NullBuffer();
+            bufferI->elementSize = elementSize;
+            bufferI->data.resize(bufferSize, 0);
+            bufferI->heap = heapI;
+            bufferI->heapOffset = heapOffset;
+            heapI->numResources++;
+            return (GraphicsBuffer)bufferI;
+        }
+
+        RenderTexture create_aliased_render_texture(TransientHeap transientHeap, uint64_t heapOffset, const TextureDescriptor& rtDesc)
+        {
+            NullTransientHeap* heapI = (NullTransientHeap*)transientHeap;
+            uint64_t size = 0, alignment = 0;
+            render_texture_footprint((GraphicsDevice)heapI->device, rtDesc, size, alignment);
+            assert_msg(heapOffset % alignment == 0 && heapOffset + size <= heapI->size, "Aliased render texture out of the transient heap.");
+            NullTexture* textureI = new NullTexture();
+            textureI->descriptor = rtDesc;
+            textureI->heap = heapI;
+            textureI->heapOffset = heapOffset;
+            heapI->numResources++;
+            return (RenderTexture)textureI;
+        }
+#pragma endregion
+
+#pragma region Constant Buffer
+        ConstantBuffer create_constant_buffer(GraphicsDevice, uint32_t elementSize, ConstantBufferType)
+        {
+            NullBuffer* bufferI = new NullBuffer();
+            bufferI->elementSize = elementSize;
+            bufferI->data.resize(elementSize, 0);
+            return (ConstantBuffer)bufferI;
+        }
+
+        void destroy_constant_buffer(ConstantBuffer constantBuffer)
+        {
+            NullBuffer* bufferI = (NullBuffer*)constantBuffer;
+            delete bufferI;
+        }
+
+        void set_constant_buffer(ConstantBuffer constantBuffer, const char* bufferData, uint32_t bufferSize)
+        {
+            NullBuffer* bufferI = (NullBuffer*)constantBuffer;
+            assert_msg(bufferSize <= bufferI->data.size(), "Data bigger than the constant buffer.");
+            memcpy(bufferI->data.data(), bufferData, bufferSize);
+        }
+#pragma endregion
+
+#pragma region BLAS
+        BottomLevelAS create_blas(GraphicsDevice, GraphicsBuffer vertexBuffer, uint32_t, GraphicsBuffer indexBuffer, uint32_t numTriangles, uint32_t)
+        {
+            NullBLAS* blasI = new NullBLAS();
+            blasI->vertexBuffer = vertexBuffer;
+            blasI->indexBuffer = indexBuffer;
+            blasI->numTriangles = numTriangles;
+            return (BottomLevelAS)blasI;
+        }
+
+        void destroy_blas(BottomLevelAS blas)
+        {
+            NullBLAS* blasI = (NullBLAS*)blas;
+            delete blasI;
+        }
+#pragma endregion
+
+#pragma region TLAS
+        TopLevelAS create_tlas(GraphicsDevice, uint32_t numBLAS)
+        {
+            NullTLAS* tlasI = new NullTLAS();
+            tlasI->instances.resize(numBLAS, 0);
+            return (TopLevelAS)tlasI;
+        }
+
+        void destroy_tlas(TopLevelAS tlas)
+        {
+            NullTLAS* tlasI = (NullTLAS*)tlas;
+            delete tlasI;
+        }
+
+        void set_tlas_instance(TopLevelAS tlas, BottomLevelAS blas, uint32_t index)
+        {
+            NullTLAS* tlasI = (NullTLAS*)tlas;
+            assert_msg(index < tlasI->instances.size(), "Instance out of the TLAS.");
+            tlasI->instances[index] = blas;
+        }
+
+        void upload_tlas_instance_data(TopLevelAS) {}
+#pragma endregion
+    }
+
+    namespace compute_shader
+    {
+        ComputeShader create_compute_shader(GraphicsDevice, const ComputeShaderDescriptor& computeShaderDescriptor, bool)
+        {
+            NullShader* shaderI = new NullShader();
+            reflect_shader(computeShaderDescriptor.filename, computeShaderDescriptor.includeDirectories, shaderI);
+            return (ComputeShader)shaderI;
+        }
+
+        void destroy_compute_shader(ComputeShader computeShader)
+        {
+            NullShader* shaderI = (NullShader*)computeShader;
+            delete shaderI;
+        }
+
+        const std::vector<std::string>& source_dependencies(ComputeShader computeShader)
+        {
+            NullShader* shaderI = (NullShader*)computeShader;
+            return shaderI->dependencies;
+        }
+    }
+
+    namespace graphics_pipeline
+    {
+        GraphicsPipeline create_graphics_pipeline(GraphicsDevice, const GraphicsPipelineDescriptor& graphicsPipelineDescriptor)
+        {
+            NullShader* shaderI = new NullShader();
+            reflect_shader(graphicsPipelineDescriptor.filename, graphicsPipelineDescriptor.includeDirectories, shaderI);
+            return (GraphicsPipeline)shaderI;
+        }
+
+        void destroy_graphics_pipeline(GraphicsPipeline graphicsPipeline)
+        {
+            NullShader* shaderI = (NullShader*)graphicsPipeline;
+            delete shaderI;
+        }
+
+        void set_stencil_ref(GraphicsPipeline, uint8_t) {}
+
+        const std::vector<std::string>& source_dependencies(GraphicsPipeline graphicsPipeline)
+        {
+            NullShader* shaderI = (NullShader*)graphicsPipeline;
+            return shaderI->dependencies;
+        }
+    }
+}
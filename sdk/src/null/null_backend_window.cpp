@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "null/null_backend.h"
+#include "null/null_containers.h"
+#include "tools/security.h"
+
+namespace null_backend
+{
+    // Off screen, nothing is ever shown
+    struct NullWindow
+    {
+        uint2 size = { 0, 0 };
+    };
+
+    struct NullSwapChain
+    {
+        RenderTexture backBuffer = 0;
+    };
+
+    namespace window
+    {
+        RenderWindow create_window(GraphicsDevice, uint64_t, uint32_t width, uint32_t height, const char*)
+        {
+            NullWindow* windowI = new NullWindow();
+            windowI->size = { width, height };
+            return (RenderWindow)windowI;
+        }
+
+        void destroy_window(RenderWindow renderWindow)
+        {
+            NullWindow* windowI = (NullWindow*)renderWindow;
+            delete windowI;
+        }
+
+        void viewport_size(RenderWindow window, uint2& size)
+        {
+            NullWindow* windowI = (NullWindow*)window;
+            size = windowI->size;
+        }
+
+        uint2 viewport_center(RenderWindow window)
+        {
+            NullWindow* windowI = (NullWindow*)window;
+            return { windowI->size.x / 2, windowI->size.y / 2 };
+        }
+
+        void viewport_bounds(RenderWindow renderWindow, uint4& bounds)
+        {
+            NullWindow* windowI = (NullWindow*)renderWindow;
+            bounds = { 0, 0, windowI->size.x, windowI->size.y };
+        }
+
+        void window_size(RenderWindow window, uint2& size) { viewport_size(window, size); }
+        uint2 window_center(RenderWindow window) { return viewport_center(window); }
+        void window_bounds(RenderWindow renderWindow, uint4& bounds) { viewport_bounds(renderWindow, bounds); }
+
+        void handle_messages(RenderWindow) {}
+        void show(RenderWindow) {}
+        void hide(RenderWindow) {}
+        void set_cursor_visibility(RenderWindow, bool) {}
+        void set_cursor_pos(RenderWindow, uint2) {}
+    }
+
+    namespace swap_chain
+    {
+        SwapChain create_swap_chain(RenderWindow window, GraphicsDevice graphicsDevice, CommandQueue, TextureFormat format)
+        {
+            NullWindow* windowI = (NullWindow*)window;
+            NullSwapChain* swapChainI = new NullSwapChain();
+            swapChainI->backBuffer = resources::create_render_texture(graphicsDevice, TextureType::Tex2D, windowI->size.x, windowI->size.y, 1, 1, false, format, { 0.0f, 0.0f, 0.0f, 0.0f }, "Back buffer");
+            return (SwapChain)swapChainI;
+        }
+
+        void destroy_swap_chain(SwapChain swapChain)
+        {
+            NullSwapChain* swapChainI = (NullSwapChain*)swapChain;
+            resources::destroy_render_texture(swapChainI->backBuffer);
+            delete swapChainI;
+        }
+
+        RenderTexture get_current_render_texture(SwapChain swapChain)
+        {
+            NullSwapChain* swapChainI = (NullSwapChain*)swapChain;
+            return swapChainI->backBuffer;
+        }
+
+        void present(SwapChain, CommandQueue) {}
+    }
+
+    namespace imgui
+    {
+        // No ImGui context is created, the callers skip the UI
+        bool initialize_imgui(GraphicsDevice, RenderWindow, TextureFormat)
+        {
+            return false;
+        }
+
+        void release_imgui() {}
+        void start_frame() {}
+        void end_frame() {}
+        void draw_frame(CommandBuffer, RenderTexture) {}
+        void handle_input(RenderWindow, const EventData&) {}
+    }
+}
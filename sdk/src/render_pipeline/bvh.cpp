@@ -0,0 +1,665 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/bvh.h"
+#include "scene/skinning.h"
+#include "tools/cpu_features.h"
+#include "tools/security.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <float.h>
+#include <functional>
+#include <math.h>
+#if defined(_M_X64) || defined(__SSE2__)
+#define BVH_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+#define BVH_AVX2
+#endif
+
+// Nodes of a traversal stack
+#define BVH_STACK_SIZE (BVH_MAX_DEPTH * (BVH_WIDTH - 1) + 1)
+
+#if defined(BVH_AVX2)
+// Queried once, the slab test falls back to two SSE2 halves without AVX2
+static const bool s_UseAVX2 = cpu_features::avx2();
+#endif
+
+struct AABB
+{
+    float3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    void grow(const float3& p)
+    {
+        min = { std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z) };
+        max = { std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z) };
+    }
+
+    // Empty boxes leave the bounds unchanged
+    void grow(const AABB& box)
+    {
+        min = { std::min(min.x, box.min.x), std::min(min.y, box.min.y), std::min(min.z, box.min.z) };
+        max = { std::max(max.x, box.max.x), std::max(max.y, box.max.y), std::max(max.z, box.max.z) };
+    }
+
+    float area() const
+    {
+        if (min.x > max.x)
+            return 0.0f;
+        const float extentX = max.x - min.x, extentY = max.y - min.y, extentZ = max.z - min.z;
+        return 2.0f * (extentX * extentY + extentY * extentZ + extentZ * extentX);
+    }
+};
+
+// Node of the intermediate binary tree
+struct BinaryNode
+{
+    AABB bounds;
+    uint32_t left = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+// State shared by the tasks of a build
+struct BinaryBuild
+{
+    std::vector<AABB> triangleBounds;
+    std::vector<float3> centroids;
+    std::vector<uint32_t> triangles;
+    std::vector<BinaryNode> nodes;
+    std::atomic<uint32_t> numNodes = 0;
+};
+
+static float axis_value(const float3& v, uint32_t axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+// Binned SAH split of a node, the children are built in parallel above BVH_PARALLEL_THRESHOLD triangles
+static void build_binary_node(BinaryBuild& build, uint32_t nodeIdx)
+{
+    BinaryNode& node = build.nodes[nodeIdx];
+    AABB centroidBounds;
+    node.bounds = AABB();
+    for (uint32_t triIdx = node.first; triIdx < node.first + node.count; ++triIdx)
+    {
+        node.bounds.grow(build.triangleBounds[build.triangles[triIdx]]);
+        centroidBounds.grow(build.centroids[build.triangles[triIdx]]);
+    }
+    if (node.count <= BVH_LEAF_SIZE)
+        return;
+
+    // Best split plane of the three axes
+    float bestCost = FLT_MAX;
+    uint32_t bestAxis = 0;
+    uint32_t bestBin = 0;
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        const float axisMin = axis_value(centroidBounds.min, axis);
+        const float extent = axis_value(centroidBounds.max, axis) - axisMin;
+        if (extent <= 0.0f)
+            continue;
+
+        AABB binBounds[BVH_NUM_BINS];
+        uint32_t binCounts[BVH_NUM_BINS] = {};
+        const float scale = BVH_NUM_BINS / extent;
+        for (uint32_t triIdx = node.first; triIdx < node.first + node.count; ++triIdx)
+        {
+            uint32_t triangle = build.triangles[triIdx];
+            uint32_t binIdx = std::min((uint32_t)((axis_value(build.centroids[triangle], axis) - axisMin) * scale), (uint32_t)BVH_NUM_BINS - 1);
+            binCounts[binIdx]++;
+            binBounds[binIdx].grow(build.triangleBounds[triangle]);
+        }
+
+        // Sweep from the right, then from the left
+        float rightArea[BVH_NUM_BINS];
+        uint32_t rightCount[BVH_NUM_BINS];
+        AABB accumulated;
+        uint32_t count = 0;
+        for (uint32_t binIdx = BVH_NUM_BINS - 1; binIdx > 0; --binIdx)
+        {
+            accumulated.grow(binBounds[binIdx]);
+            count += binCounts[binIdx];
+            rightArea[binIdx] = accumulated.area();
+            rightCount[binIdx] = count;
+        }
+        accumulated = AABB();
+        count = 0;
+        for (uint32_t binIdx = 0; binIdx < BVH_NUM_BINS - 1; ++binIdx)
+        {
+            accumulated.grow(binBounds[binIdx]);
+            count += binCounts[binIdx];
+            float cost = count * accumulated.area() + rightCount[binIdx + 1] * rightArea[binIdx + 1];
+            if (count > 0 && rightCount[binIdx + 1] > 0 && cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = binIdx;
+            }
+        }
+    }
+
+    // Partition the triangles, identical centroids are split in the middle
+    uint32_t* first = build.triangles.data() + node.first;
+    uint32_t* last = first + node.count;
+    uint32_t* middle = first + node.count / 2;
+    if (bestCost < FLT_MAX)
+    {
+        const float axisMin = axis_value(centroidBounds.min, bestAxis);
+        const float scale = BVH_NUM_BINS / (axis_value(centroidBounds.max, bestAxis) - axisMin);
+        middle = std::partition(first, last, [&](uint32_t triangle)
+        {
+            return std::min((uint32_t)((axis_value(build.centroids[triangle], bestAxis) - axisMin) * scale), (uint32_t)BVH_NUM_BINS - 1) <= bestBin;
+        });
+    }
+
+    // Children are allocated in pairs
+    const uint32_t leftIdx = build.numNodes.fetch_add(2);
+    const uint32_t leftCount = (uint32_t)(middle - first);
+    node.left = leftIdx;
+    build.nodes[leftIdx].first = node.first;
+    build.nodes[leftIdx].count = leftCount;
+    build.nodes[leftIdx + 1].first = node.first + leftCount;
+    build.nodes[leftIdx + 1].count = node.count - leftCount;
+    if (node.count > BVH_PARALLEL_THRESHOLD)
+    {
+        TaskGroup group;
+        task_scheduler::run(group, [&build, leftIdx]() { build_binary_node(build, leftIdx); });
+        build_binary_node(build, leftIdx + 1);
+        task_scheduler::wait(group);
+    }
+    else
+    {
+        build_binary_node(build, leftIdx);
+        build_binary_node(build, leftIdx + 1);
+    }
+}
+
+// Slab test of a ray against the children of a node, returns a bit per child that is hit and the entry distances
+static uint32_t intersect_children(const BVHNode& node, const float3& origin, const float3& invDirection, float tMin, float tMax, float* tNear)
+{
+#if defined(BVH_AVX2)
+    if (s_UseAVX2)
+        return bvh::intersect_children_avx2(node, origin, invDirection, tMin, tMax, tNear);
+#endif
+#if defined(BVH_SSE2)
+    uint32_t hitMask = 0;
+    const __m128 originX = _mm_set1_ps(origin.x), originY = _mm_set1_ps(origin.y), originZ = _mm_set1_ps(origin.z);
+    const __m128 invX = _mm_set1_ps(invDirection.x), invY = _mm_set1_ps(invDirection.y), invZ = _mm_set1_ps(invDirection.z);
+    for (uint32_t half = 0; half < BVH_WIDTH; half += 4)
+    {
+        __m128 t0X = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minX + half), originX), invX);
+        __m128 t1X = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxX + half), originX), invX);
+        __m128 t0Y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minY + half), originY), invY);
+        __m128 t1Y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxY + half), originY), invY);
+        __m128 t0Z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minZ + half), originZ), invZ);
+        __m128 t1Z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxZ + half), originZ), invZ);
+        __m128 entry = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0X, t1X), _mm_min_ps(t0Y, t1Y)), _mm_max_ps(_mm_min_ps(t0Z, t1Z), _mm_set1_ps(tMin)));
+        __m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0X, t1X), _mm_max_ps(t0Y, t1Y)), _mm_min_ps(_mm_max_ps(t0Z, t1Z), _mm_set1_ps(tMax)));
+        _mm_storeu_ps(tNear + half, entry);
+        hitMask |= (uint32_t)_mm_movemask_ps(_mm_cmple_ps(entry, exit)) << half;
+    }
+    return hitMask;
+#else
+    uint32_t hitMask = 0;
+    for (uint32_t childIdx = 0; childIdx < BVH_WIDTH; ++childIdx)
+    {
+        float t0X = (node.minX[childIdx] - origin.x) * invDirection.x, t1X = (node.maxX[childIdx] - origin.x) * invDirection.x;
+        float t0Y = (node.minY[childIdx] - origin.y) * invDirection.y, t1Y = (node.maxY[childIdx] - origin.y) * invDirection.y;
+        float t0Z = (node.minZ[childIdx] - origin.z) * invDirection.z, t1Z = (node.maxZ[childIdx] - origin.z) * invDirection.z;
+        float entry = std::max(std::max(std::min(t0X, t1X), std::min(t0Y, t1Y)), std::max(std::min(t0Z, t1Z), tMin));
+        float exit = std::min(std::min(std::max(t0X, t1X), std::max(t0Y, t1Y)), std::min(std::max(t0Z, t1Z), tMax));
+        tNear[childIdx] = entry;
+        hitMask |= (entry <= exit ? 1u : 0u) << childIdx;
+    }
+    return hitMask;
+#endif
+}
+
+// Möller-Trumbore against the triangles of a leaf, the front faces have a positive determinant.
+// Returns a bit per triangle hit in [tMin, tMax] and their distances and barycentrics.
+static uint32_t intersect_leaf(const BVHLeaf& leaf, const float3& origin, const float3& direction, float tMin, float tMax, float* t, float* u, float* v)
+{
+#if defined(BVH_SSE2)
+    const __m128 dirX = _mm_set1_ps(direction.x), dirY = _mm_set1_ps(direction.y), dirZ = _mm_set1_ps(direction.z);
+    const __m128 e1X = _mm_loadu_ps(leaf.e1X), e1Y = _mm_loadu_ps(leaf.e1Y), e1Z = _mm_loadu_ps(leaf.e1Z);
+    const __m128 e2X = _mm_loadu_ps(leaf.e2X), e2Y = _mm_loadu_ps(leaf.e2Y), e2Z = _mm_loadu_ps(leaf.e2Z);
+
+    // pvec = direction x e2
+    __m128 pX = _mm_sub_ps(_mm_mul_ps(dirY, e2Z), _mm_mul_ps(dirZ, e2Y));
+    __m128 pY = _mm_sub_ps(_mm_mul_ps(dirZ, e2X), _mm_mul_ps(dirX, e2Z));
+    __m128 pZ = _mm_sub_ps(_mm_mul_ps(dirX, e2Y), _mm_mul_ps(dirY, e2X));
+    __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1X, pX), _mm_mul_ps(e1Y, pY)), _mm_mul_ps(e1Z, pZ));
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+    // tvec = origin - v0
+    __m128 tX = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_loadu_ps(leaf.v0X));
+    __m128 tY = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_loadu_ps(leaf.v0Y));
+    __m128 tZ = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_loadu_ps(leaf.v0Z));
+    __m128 baryU = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tX, pX), _mm_mul_ps(tY, pY)), _mm_mul_ps(tZ, pZ)), invDet);
+
+    // qvec = tvec x e1
+    __m128 qX = _mm_sub_ps(_mm_mul_ps(tY, e1Z), _mm_mul_ps(tZ, e1Y));
+    __m128 qY = _mm_sub_ps(_mm_mul_ps(tZ, e1X), _mm_mul_ps(tX, e1Z));
+    __m128 qZ = _mm_sub_ps(_mm_mul_ps(tX, e1Y), _mm_mul_ps(tY, e1X));
+    __m128 baryV = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qX), _mm_mul_ps(dirY, qY)), _mm_mul_ps(dirZ, qZ)), invDet);
+    __m128 distance = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2X, qX), _mm_mul_ps(e2Y, qY)), _mm_mul_ps(e2Z, qZ)), invDet);
+
+    // Front facing, inside the triangle and in the interval, the padding has a null determinant
+    const __m128 zero = _mm_setzero_ps();
+    __m128 valid = _mm_and_ps(_mm_cmpgt_ps(det, zero), _mm_cmpge_ps(baryU, zero));
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(baryV, zero), _mm_cmple_ps(_mm_add_ps(baryU, baryV), _mm_set1_ps(1.0f))));
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(distance, _mm_set1_ps(tMin)), _mm_cmple_ps(distance, _mm_set1_ps(tMax))));
+    _mm_storeu_ps(t, distance);
+    _mm_storeu_ps(u, baryU);
+    _mm_storeu_ps(v, baryV);
+    return (uint32_t)_mm_movemask_ps(valid);
+#else
+    uint32_t hitMask = 0;
+    for (uint32_t triIdx = 0; triIdx < BVH_LEAF_SIZE; ++triIdx)
+    {
+        float3 e1 = { leaf.e1X[triIdx], leaf.e1Y[triIdx], leaf.e1Z[triIdx] };
+        float3 e2 = { leaf.e2X[triIdx], leaf.e2Y[triIdx], leaf.e2Z[triIdx] };
+        float3 pvec = cross(direction, e2);
+        float det = dot(e1, pvec);
+        if (!(det > 0.0f))
+            continue;
+        float invDet = 1.0f / det;
+        float3 tvec = origin - float3({ leaf.v0X[triIdx], leaf.v0Y[triIdx], leaf.v0Z[triIdx] });
+        u[triIdx] = dot(tvec, pvec) * invDet;
+        float3 qvec = cross(tvec, e1);
+        v[triIdx] = dot(direction, qvec) * invDet;
+        t[triIdx] = dot(e2, qvec) * invDet;
+        if (u[triIdx] >= 0.0f && v[triIdx] >= 0.0f && u[triIdx] + v[triIdx] <= 1.0f && t[triIdx] >= tMin && t[triIdx] <= tMax)
+            hitMask |= 1u << triIdx;
+    }
+    return hitMask;
+#endif
+}
+
+// Zero components would produce NaNs in the slab test
+static float3 safe_inverse(const float3& direction)
+{
+    const float epsilon = 1e-20f;
+    float3 safe = { fabsf(direction.x) < epsilon ? copysignf(epsilon, direction.x) : direction.x,
+        fabsf(direction.y) < epsilon ? copysignf(epsilon, direction.y) : direction.y,
+        fabsf(direction.z) < epsilon ? copysignf(epsilon, direction.z) : direction.z };
+    return { 1.0f / safe.x, 1.0f / safe.y, 1.0f / safe.z };
+}
+
+BVH::BVH()
+{
+}
+
+BVH::~BVH()
+{
+}
+
+void BVH::build(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor)
+{
+    skin(animation, frameA, frameB, interpolationFactor);
+
+    // Bounds and centroids of the triangles
+    const uint32_t numTriangles = (uint32_t)animation.indexBuffer.size();
+    BinaryBuild build;
+    build.triangleBounds.resize(numTriangles);
+    build.centroids.resize(numTriangles);
+    build.triangles.resize(numTriangles);
+    task_scheduler::parallel_for(0, numTriangles, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t triIdx = first; triIdx < last; ++triIdx)
+        {
+            const uint3& indices = animation.indexBuffer[triIdx];
+            AABB& bounds = build.triangleBounds[triIdx];
+            bounds = AABB();
+            bounds.grow(m_Positions[indices.x]);
+            bounds.grow(m_Positions[indices.y]);
+            bounds.grow(m_Positions[indices.z]);
+            build.centroids[triIdx] = (bounds.min + bounds.max) * 0.5f;
+            build.triangles[triIdx] = triIdx;
+        }
+    }, 1024);
+
+    // Binary tree, a full binary tree has at most 2n - 1 nodes
+    build.nodes.resize(std::max(2 * numTriangles, 1u));
+    build.nodes[0].first = 0;
+    build.nodes[0].count = numTriangles;
+    build.numNodes = 1;
+    build_binary_node(build, 0);
+
+    // Collapse into 8 wide nodes, every node opens its largest children until it has 8 of them
+    m_Nodes.clear();
+    m_Leaves.clear();
+    m_LeafTriangles.clear();
+    m_Levels.clear();
+    std::function<uint32_t(uint32_t, uint32_t)> collapse = [&](uint32_t binaryIdx, uint32_t depth) -> uint32_t
+    {
+        const uint32_t nodeIdx = (uint32_t)m_Nodes.size();
+        m_Nodes.push_back(BVHNode());
+        if (m_Levels.size() <= depth)
+            m_Levels.resize(depth + 1);
+        m_Levels[depth].push_back(nodeIdx);
+
+        uint32_t candidates[BVH_WIDTH];
+        uint32_t numCandidates = 0;
+        if (build.nodes[binaryIdx].count <= BVH_LEAF_SIZE)
+            candidates[numCandidates++] = binaryIdx;
+        else
+        {
+            candidates[numCandidates++] = build.nodes[binaryIdx].left;
+            candidates[numCandidates++] = build.nodes[binaryIdx].left + 1;
+        }
+        while (numCandidates < BVH_WIDTH)
+        {
+            int32_t largest = -1;
+            float largestArea = -1.0f;
+            for (uint32_t candIdx = 0; candIdx < numCandidates; ++candIdx)
+            {
+                const BinaryNode& candidate = build.nodes[candidates[candIdx]];
+                if (candidate.count > BVH_LEAF_SIZE && candidate.bounds.area() > largestArea)
+                {
+                    largest = (int32_t)candIdx;
+                    largestArea = candidate.bounds.area();
+                }
+            }
+            if (largest < 0)
+                break;
+            const uint32_t opened = candidates[largest];
+            candidates[largest] = build.nodes[opened].left;
+            candidates[numCandidates++] = build.nodes[opened].left + 1;
+        }
+
+        // The vector of nodes grows during the recursion, the children are written at the end
+        uint32_t children[BVH_WIDTH];
+        for (uint32_t childIdx = 0; childIdx < BVH_WIDTH; ++childIdx)
+        {
+            if (childIdx >= numCandidates)
+            {
+                children[childIdx] = BVH_EMPTY_CHILD;
+                continue;
+            }
+            const BinaryNode& candidate = build.nodes[candidates[childIdx]];
+            if (candidate.count <= BVH_LEAF_SIZE)
+            {
+                children[childIdx] = BVH_LEAF_FLAG | (uint32_t)m_Leaves.size();
+                m_Leaves.push_back(BVHLeaf());
+                for (uint32_t triIdx = 0; triIdx < BVH_LEAF_SIZE; ++triIdx)
+                    m_LeafTriangles.push_back(triIdx < candidate.count ? build.triangles[candidate.first + triIdx] : UINT32_MAX);
+            }
+            else
+                children[childIdx] = collapse(candidates[childIdx], depth + 1);
+        }
+        std::copy(children, children + BVH_WIDTH, m_Nodes[nodeIdx].children);
+        return nodeIdx;
+    };
+    if (numTriangles > 0)
+        collapse(0, 0);
+    assert_msg(m_Levels.size() <= BVH_MAX_DEPTH, "The BVH is too deep for the traversal stack.");
+
+    // Triangles and bounds
+    update_leaves(animation);
+    update_nodes();
+
+    // Stats
+    m_Stats.numTriangles = numTriangles;
+    m_Stats.numNodes = (uint32_t)m_Nodes.size();
+    m_Stats.numLeaves = (uint32_t)m_Leaves.size();
+    m_Stats.depth = (uint32_t)m_Levels.size();
+    m_Stats.buildCost = evaluate_cost();
+    m_Stats.cost = m_Stats.buildCost;
+}
+
+void BVH::release()
+{
+    m_Positions.clear();
+    m_Nodes.clear();
+    m_Leaves.clear();
+    m_LeafTriangles.clear();
+    m_Levels.clear();
+    m_Stats = BVHStats();
+}
+
+void BVH::refit(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor)
+{
+    skin(animation, frameA, frameB, interpolationFactor);
+    update_leaves(animation);
+    update_nodes();
+    m_Stats.cost = evaluate_cost();
+}
+
+void BVH::skin(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor)
+{
+    // Same interpolation as SkinMesh.compute
+    SkinningFrame frame;
+    frame.frameA = frameA;
+    frame.frameB = frameB;
+    frame.interpolationFactor = interpolationFactor;
+    skinning::skin_positions(animation, frame, m_Positions);
+}
+
+void BVH::update_leaves(const MeshAnimation& animation)
+{
+    task_scheduler::parallel_for(0, (uint32_t)m_Leaves.size(), [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t leafIdx = first; leafIdx < last; ++leafIdx)
+        {
+            BVHLeaf& leaf = m_Leaves[leafIdx];
+            for (uint32_t triIdx = 0; triIdx < BVH_LEAF_SIZE; ++triIdx)
+            {
+                const uint32_t primitiveID = m_LeafTriangles[leafIdx * BVH_LEAF_SIZE + triIdx];
+                float3 v0 = { 0.0f, 0.0f, 0.0f }, e1 = { 0.0f, 0.0f, 0.0f }, e2 = { 0.0f, 0.0f, 0.0f };
+                if (primitiveID != UINT32_MAX)
+                {
+                    const uint3& indices = animation.indexBuffer[primitiveID];
+                    v0 = m_Positions[indices.x];
+                    e1 = m_Positions[indices.y] - v0;
+                    e2 = m_Positions[indices.z] - v0;
+                }
+                leaf.v0X[triIdx] = v0.x; leaf.v0Y[triIdx] = v0.y; leaf.v0Z[triIdx] = v0.z;
+                leaf.e1X[triIdx] = e1.x; leaf.e1Y[triIdx] = e1.y; leaf.e1Z[triIdx] = e1.z;
+                leaf.e2X[triIdx] = e2.x; leaf.e2Y[triIdx] = e2.y; leaf.e2Z[triIdx] = e2.z;
+                leaf.primitiveID[triIdx] = primitiveID;
+            }
+        }
+    }, 256);
+}
+
+void BVH::update_nodes()
+{
+    // The children of a level are all on the next one
+    for (uint32_t levelIdx = (uint32_t)m_Levels.size(); levelIdx > 0; --levelIdx)
+    {
+        const std::vector<uint32_t>& level = m_Levels[levelIdx - 1];
+        task_scheduler::parallel_for(0, (uint32_t)level.size(), [&](uint32_t first, uint32_t last)
+        {
+            for (uint32_t idx = first; idx < last; ++idx)
+            {
+                BVHNode& node = m_Nodes[level[idx]];
+                for (uint32_t childIdx = 0; childIdx < BVH_WIDTH; ++childIdx)
+                {
+                    const uint32_t child = node.children[childIdx];
+                    AABB bounds;
+                    if (child == BVH_EMPTY_CHILD)
+                        bounds.min = bounds.max = { 0.0f, 0.0f, 0.0f };
+                    else if (child & BVH_LEAF_FLAG)
+                    {
+                        const BVHLeaf& leaf = m_Leaves[child & ~BVH_LEAF_FLAG];
+                        for (uint32_t triIdx = 0; triIdx < BVH_LEAF_SIZE; ++triIdx)
+                        {
+                            if (leaf.primitiveID[triIdx] == UINT32_MAX)
+                                continue;
+                            float3 v0 = { leaf.v0X[triIdx], leaf.v0Y[triIdx], leaf.v0Z[triIdx] };
+                            bounds.grow(v0);
+                            bounds.grow(v0 + float3({ leaf.e1X[triIdx], leaf.e1Y[triIdx], leaf.e1Z[triIdx] }));
+                            bounds.grow(v0 + float3({ leaf.e2X[triIdx], leaf.e2Y[triIdx], leaf.e2Z[triIdx] }));
+                        }
+                    }
+                    else
+                    {
+                        const BVHNode& childNode = m_Nodes[child];
+                        for (uint32_t grandChildIdx = 0; grandChildIdx < BVH_WIDTH; ++grandChildIdx)
+                        {
+                            if (childNode.children[grandChildIdx] == BVH_EMPTY_CHILD)
+                                continue;
+                            bounds.grow(float3({ childNode.minX[grandChildIdx], childNode.minY[grandChildIdx], childNode.minZ[grandChildIdx] }));
+                            bounds.grow(float3({ childNode.maxX[grandChildIdx], childNode.maxY[grandChildIdx], childNode.maxZ[grandChildIdx] }));
+                        }
+                    }
+                    node.minX[childIdx] = bounds.min.x; node.minY[childIdx] = bounds.min.y; node.minZ[childIdx] = bounds.min.z;
+                    node.maxX[childIdx] = bounds.max.x; node.maxY[childIdx] = bounds.max.y; node.maxZ[childIdx] = bounds.max.z;
+                }
+            }
+        }, 64);
+    }
+}
+
+float BVH::evaluate_cost() const
+{
+    if (m_Nodes.empty())
+        return 0.0f;
+
+    // Expected number of tests of a random ray that hits the root, the tests of a node are those of its children
+    AABB rootBounds;
+    uint32_t rootChildren = 0;
+    double cost = 0.0;
+    for (uint32_t nodeIdx = 0; nodeIdx < (uint32_t)m_Nodes.size(); ++nodeIdx)
+    {
+        const BVHNode& node = m_Nodes[nodeIdx];
+        for (uint32_t childIdx = 0; childIdx < BVH_WIDTH; ++childIdx)
+        {
+            const uint32_t child = node.children[childIdx];
+            if (child == BVH_EMPTY_CHILD)
+                continue;
+            AABB bounds;
+            bounds.grow(float3({ node.minX[childIdx], node.minY[childIdx], node.minZ[childIdx] }));
+            bounds.grow(float3({ node.maxX[childIdx], node.maxY[childIdx], node.maxZ[childIdx] }));
+            if (nodeIdx == 0)
+            {
+                rootBounds.grow(bounds);
+                rootChildren++;
+            }
+
+            uint32_t numTests = 0;
+            if (child & BVH_LEAF_FLAG)
+            {
+                for (uint32_t triIdx = 0; triIdx < BVH_LEAF_SIZE; ++triIdx)
+                    numTests += m_LeafTriangles[(child & ~BVH_LEAF_FLAG) * BVH_LEAF_SIZE + triIdx] != UINT32_MAX ? 1 : 0;
+                cost += bounds.area() * numTests * BVH_TRIANGLE_COST;
+            }
+            else
+            {
+                for (uint32_t grandChildIdx = 0; grandChildIdx < BVH_WIDTH; ++grandChildIdx)
+                    numTests += m_Nodes[child].children[grandChildIdx] != BVH_EMPTY_CHILD ? 1 : 0;
+                cost += bounds.area() * numTests * BVH_NODE_COST;
+            }
+        }
+    }
+    const float rootArea = rootBounds.area();
+    return rootArea > 0.0f ? (float)(rootChildren * BVH_NODE_COST + cost / rootArea) : 0.0f;
+}
+
+bool BVH::occluded(const float3& origin, const float3& direction, float tMin, float tMax) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    const float3 invDirection = safe_inverse(direction);
+    uint32_t stack[BVH_STACK_SIZE];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const BVHNode& node = m_Nodes[stack[--stackSize]];
+        float tNear[BVH_WIDTH];
+        uint32_t hitMask = intersect_children(node, origin, invDirection, tMin, tMax, tNear);
+        for (uint32_t childIdx = 0; childIdx < BVH_WIDTH; ++childIdx)
+        {
+            const uint32_t child = node.children[childIdx];
+            if (!(hitMask & (1u << childIdx)) || child == BVH_EMPTY_CHILD)
+                continue;
+            if (child & BVH_LEAF_FLAG)
+            {
+                // Any hit is enough
+                float t[BVH_LEAF_SIZE], u[BVH_LEAF_SIZE], v[BVH_LEAF_SIZE];
+                if (intersect_leaf(m_Leaves[child & ~BVH_LEAF_FLAG], origin, direction, tMin, tMax, t, u, v) != 0)
+                    return true;
+            }
+            else
+                stack[stackSize++] = child;
+        }
+    }
+    return false;
+}
+
+bool BVH::intersect(const float3& origin, const float3& direction, float tMin, float tMax, BVHHit& hit) const
+{
+    hit = BVHHit();
+    if (m_Nodes.empty())
+        return false;
+
+    const float3 invDirection = safe_inverse(direction);
+    uint32_t stack[BVH_STACK_SIZE];
+    float stackDistance[BVH_STACK_SIZE];
+    uint32_t stackSize = 0;
+    stack[stackSize] = 0;
+    stackDistance[stackSize++] = tMin;
+    while (stackSize > 0)
+    {
+        --stackSize;
+        if (stackDistance[stackSize] > tMax)
+            continue;
+        const BVHNode& node = m_Nodes[stack[stackSize]];
+        float tNear[BVH_WIDTH];
+        uint32_t hitMask = intersect_children(node, origin, invDirection, tMin, tMax, tNear);
+
+        // Inner children are pushed from the farthest to the closest one
+        const uint32_t firstPushed = stackSize;
+        for (uint32_t childIdx = 0; childIdx < BVH_WIDTH; ++childIdx)
+        {
+            const uint32_t child = node.children[childIdx];
+            if (!(hitMask & (1u << childIdx)) || child == BVH_EMPTY_CHILD)
+                continue;
+            if (child & BVH_LEAF_FLAG)
+            {
+                const BVHLeaf& leaf = m_Leaves[child & ~BVH_LEAF_FLAG];
+                float t[BVH_LEAF_SIZE], u[BVH_LEAF_SIZE], v[BVH_LEAF_SIZE];
+                uint32_t triangleMask = intersect_leaf(leaf, origin, direction, tMin, tMax, t, u, v);
+                for (uint32_t triIdx = 0; triIdx < BVH_LEAF_SIZE; ++triIdx)
+                {
+                    if ((triangleMask & (1u << triIdx)) && t[triIdx] <= tMax)
+                    {
+                        tMax = t[triIdx];
+                        hit.t = t[triIdx];
+                        hit.u = u[triIdx];
+                        hit.v = v[triIdx];
+                        hit.primitiveID = leaf.primitiveID[triIdx];
+                    }
+                }
+            }
+            else
+            {
+                uint32_t slot = stackSize++;
+                while (slot > firstPushed && stackDistance[slot - 1] < tNear[childIdx])
+                {
+                    stack[slot] = stack[slot - 1];
+                    stackDistance[slot] = stackDistance[slot - 1];
+                    --slot;
+                }
+                stack[slot] = child;
+                stackDistance[slot] = tNear[childIdx];
+            }
+        }
+    }
+    return hit.primitiveID != UINT32_MAX;
+}
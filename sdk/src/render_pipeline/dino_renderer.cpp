@@ -8,14 +8,21 @@
 // Includes
 #include "graphics/backend.h"
 #include "graphics/event_collector.h"
+#include "render_pipeline/shader_bindings.h"
 
 #include "render_pipeline/constant_buffers.h"
 #include "render_pipeline/dino_renderer.h"
+#include "render_pipeline/gbuffer_codec.h"
 
+#include "tools/cpu_profiler.h"
+#include "tools/file_watcher.h"
 #include "tools/security.h"
+#include "tools/shader_archive.h"
+#include "tools/shader_cache.h"
 #include "tools/shader_utils.h"
 #include "tools/string_utilities.h"
 #include "tools/imgui_helpers.h"
+#include "tools/task_scheduler.h"
 
 #include "imgui/imgui.h"
 
@@ -27,6 +34,15 @@
 #define NUM_PROFILING_FRAMES 50
 #define FRAME_BUFFER_FORMAT TextureFormat::R16G16B16A16_Float
 
+// Number of frames the CPU can record ahead of the GPU
+#define NUM_FRAMES_IN_FLIGHT 2
+
+// Budget of the on-disk shader cache
+#define SHADER_CACHE_SIZE (256ull << 20)
+
+// Archive loaded by the shipping builds when none is specified
+#define DEFAULT_SHADER_ARCHIVE "shader_archive.bin"
+
 DinoRenderer::DinoRenderer()
 {
 }
@@ -52,8 +68,28 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
     // Path library
     const std::string& pathLibrary = m_ProjectDir + "\\paths";
 
+    // Worker pool shared by the CPU side work
+    task_scheduler::initialize();
+
+    // On-disk DXIL cache
+    if (!options.disableShaderCache)
+        shader_cache::initialize(m_ProjectDir + "\\shader_cache", SHADER_CACHE_SIZE);
+
+    // Precompiled shader permutations, shipping builds can't compile anything that is not in the archive
+#if defined(SHADER_ARCHIVE_ONLY)
+    const std::string& shaderArchive = options.shaderArchive != "" ? options.shaderArchive : m_ProjectDir + "\\" + DEFAULT_SHADER_ARCHIVE;
+    assert_msg(shader_archive::initialize(shaderArchive, m_ProjectDir + "\\shaders"), "Failed to load the shader archive.");
+#else
+    if (options.shaderArchive != "")
+        shader_archive::initialize(options.shaderArchive, m_ProjectDir + "\\shaders");
+#endif
+
+    // Track the shader edits so that F5 only recompiles what changed
+    m_ShaderWatcher.initialize(m_ProjectDir + "\\shaders");
+
     // Create the graphics components
-    graphics::setup_graphics_api(GraphicsAPI::DX12);
+    m_GraphicsAPI = options.graphicsAPI;
+    assert_msg(graphics::setup_graphics_api(m_GraphicsAPI), "Failed to set up the graphics API.");
     // graphics::device::enable_debug_layer();
     graphics::device::enable_experimental_features();
 
@@ -66,11 +102,39 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
     m_Window = graphics::window::create_window(m_Device, (uint64_t)hInstance, 1920, 1080, "BC1 Neural Compression");
     m_CmdQueue = graphics::command_queue::create_command_queue(m_Device);
     m_SwapChain = graphics::swap_chain::create_swap_chain(m_Window, m_Device, m_CmdQueue, FRAME_BUFFER_FORMAT);
-    m_CmdBuffer = graphics::command_buffer::create_command_buffer(m_Device);
+
+    // Frame contexts
+    m_Frames.resize(NUM_FRAMES_IN_FLIGHT);
+    for (FrameContext& frame : m_Frames)
+    {
+        for (uint32_t segmentIdx = 0; segmentIdx < RG_NUM_DIRECT_SEGMENTS; ++segmentIdx)
+            frame.cmdBuffers.direct[segmentIdx] = graphics::command_buffer::create_command_buffer(m_Device);
+        frame.cmdBuffers.compute = graphics::command_buffer::create_command_buffer(m_Device, CommandBufferType::Compute);
+    }
+    m_FramePacer.initialize(NUM_FRAMES_IN_FLIGHT);
+    m_FrameFence = graphics::fence::create_fence(m_Device);
+    m_CmdBuffer = m_Frames[0].cmdBuffers.direct[0];
 
     // Coop vector support
     m_CooperativeVectorsSupported = graphics::device::feature_support(m_Device, GPUFeature::CoopVector);
 
+    // Classification tile shape, a tile needs to fit in a single wave
+    m_WaveLaneRange = graphics::device::wave_lane_count_range(m_Device);
+    m_TileShape = options.tileShape;
+    if (!tile_shape::supported(m_TileShape, m_WaveLaneRange))
+    {
+        printf("Tile shape %s doesn't fit the waves of the device (%u to %u lanes), using 8x4.\n", tile_shape::name(m_TileShape), m_WaveLaneRange.x, m_WaveLaneRange.y);
+        m_TileShape = TileShape::Tile8x4;
+    }
+#if defined(SHADER_ARCHIVE_ONLY)
+    // The archive only holds the shaders of the default shape
+    if (m_TileShape != TileShape::Tile8x4)
+    {
+        printf("Tile shape %s is not in the shader archive, using 8x4.\n", tile_shape::name(m_TileShape));
+        m_TileShape = TileShape::Tile8x4;
+    }
+#endif
+
     // Imgui Init
     graphics::imgui::initialize_imgui(m_Device, m_Window, FRAME_BUFFER_FORMAT);
 
@@ -78,7 +142,8 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
     uint2 screenSize;
     graphics::window::viewport_size(m_Window, screenSize);
     m_ScreenSizeI = screenSize;
-    m_TileSizeI = { m_ScreenSizeI.x / 8, m_ScreenSizeI.y / 4 };
+    const uint2 tileDimensions = tile_shape::dimensions(m_TileShape);
+    m_TileSizeI = { m_ScreenSizeI.x / tileDimensions.x, m_ScreenSizeI.y / tileDimensions.y };
     m_ScreenSize = float4({ (float)m_ScreenSizeI.x, (float)m_ScreenSizeI.y, 1.0f / m_ScreenSizeI.x, 1.0f / m_ScreenSizeI.y });
 
     // Camera controls
@@ -94,12 +159,37 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
     m_UseCooperativeVectors = m_CooperativeVectorsSupported ? options.enableCooperative : false;
     m_EnableCounters = false;
     m_EnableFiltering = true;
+    m_EnableAsyncCompute = true;
+    m_EnableVariableRate = options.enableVariableRate;
+    m_EnableFeatureCache = options.enableFeatureCache;
     m_DurationArray.resize(NUM_PROFILING_FRAMES, 0.0f);
     m_DrawArray.resize(NUM_PROFILING_FRAMES, 0.0f);
     m_CurrentDuration = 0;
 
-    // Constant buffer
-    m_GlobalCB = graphics::resources::create_constant_buffer(m_Device, sizeof(GlobalCB), ConstantBufferType::Mixed);
+    // Scripted benchmark, the counters are forced on and the UI is hidden so that it doesn't weigh on the timings
+    if (options.benchmarkScenario != "")
+    {
+        BenchmarkConfig initialConfig;
+        initialConfig.poi = options.initialPOI;
+        initialConfig.textureMode = m_TextureMode;
+        initialConfig.filteringMode = m_FilteringMode;
+        initialConfig.cooperative = m_UseCooperativeVectors;
+        initialConfig.variableRate = m_EnableVariableRate;
+        initialConfig.featureCache = m_EnableFeatureCache;
+
+        // The GPU timings are read back a few frames late, the warmup needs to cover that latency
+        uint32_t warmupFrames = std::max(options.benchmarkWarmupFrames, (uint32_t)NUM_FRAMES_IN_FLIGHT);
+        bool validScenario = m_Benchmark.initialize(options.benchmarkScenario, m_CameraController.num_poi(), initialConfig, m_CooperativeVectorsSupported, warmupFrames, options.benchmarkFrames);
+        assert_msg(validScenario, "Unknown benchmark scenario.");
+        m_BenchmarkOutput = options.benchmarkOutput != "" ? options.benchmarkOutput : "benchmark_" + options.benchmarkScenario;
+        m_EnableCounters = true;
+        m_DisplayUI = false;
+    }
+
+    // Constant buffers, one per frame so that an upload never overwrites data a frame in flight reads
+    for (FrameContext& frame : m_Frames)
+        frame.globalCB = graphics::resources::create_constant_buffer(m_Device, sizeof(GlobalCB), ConstantBufferType::Mixed);
+    m_GlobalCB = m_Frames[0].globalCB;
 
     // Render textures
     {
@@ -125,12 +215,12 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
         descriptor.debugName = "Visibility Buffer";
         m_VisibilityBuffer = graphics::resources::create_render_texture(m_Device, descriptor);
 
-        // Shadow texture
-        descriptor.isUAV = true;
-        descriptor.format = TextureFormat::R8_UNorm;
-        descriptor.clearColor = float4({ 0.0f, 0.0f, 0.0f, 0.0f });
-        descriptor.debugName = "Shadow Texture";
-        m_ShadowTexture = graphics::resources::create_render_texture(m_Device, descriptor);
+        // Shadow texture, placed by the render graph every frame
+        m_ShadowDescriptor = descriptor;
+        m_ShadowDescriptor.isUAV = true;
+        m_ShadowDescriptor.format = TextureFormat::R8_UNorm;
+        m_ShadowDescriptor.clearColor = float4({ 0.0f, 0.0f, 0.0f, 0.0f });
+        m_ShadowDescriptor.debugName = "Shadow Texture";
 
         // Color texture
         descriptor.isUAV = true;
@@ -147,13 +237,14 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
     m_MeshRenderer.initialize(m_Device, geometryLibrary + "\\michel.anim");
     m_IBL.initialize(m_Device, textureLibrary);
     m_TexManager.initialize(m_Device);
-    m_Classifier.initialize(m_Device, m_TileSizeI, 1);
+    m_Classifier.initialize(m_Device, m_TileSizeI, m_TileShape, 1);
 
     // Load the models
     m_TSNC.reload_network((modelLibrary + "\\michel\\bc1_mip"), 1);
+    m_FeatureCache.initialize(m_Device, m_ScreenSizeI, m_TileSizeI, m_TileShape);
 
     // Load the shaders
-    reload_shaders();
+    reload_shaders(false);
 
     // Upload to the GPU
     m_TSNC.upload_network(m_CmdQueue, m_CmdBuffer);
@@ -162,29 +253,40 @@ void DinoRenderer::initialize(uint64_t hInstance, const CommandLineOptions& opti
     m_TexManager.upload_textures(m_CmdQueue, m_CmdBuffer, modelLibrary, "michel");
 
     // Tools
-    m_ProfilingHelper.initialize(m_Device, m_CmdQueue, 2);
+    m_ProfilingHelper.initialize(m_Device, m_CmdQueue, NUM_FRAMES_IN_FLIGHT);
 
-    // Allocate the intermediate graphics buffers
-    const uint32_t numPixels = m_ScreenSizeI.x * m_ScreenSizeI.y;
-    const uint32_t numChannels = m_TSNC.texture_size().z;
-    m_GBuffer = graphics::resources::create_graphics_buffer(m_Device, numPixels * sizeof(uint16_t) * numChannels, sizeof(uint16_t), GraphicsBufferType::Default);
+    // Frame graph, the intermediate graphics buffers are allocated by the graph
+    m_RenderGraph.initialize(m_Device, NUM_FRAMES_IN_FLIGHT);
 
     // Post setups
     m_MeshRenderer.set_animation_state(!options.disableAnimation);
 }
 
-void DinoRenderer::reload_shaders()
+void DinoRenderer::reload_shaders(bool incremental)
 {
     // Model library
     std::string shaderLibrary = m_ProjectDir;
     shaderLibrary += "\\shaders";
 
+    // All the shaders are compiled in parallel and swapped at the end
+    ShaderCompileBatch batch;
+
+    // Components that don't work on tiles
+    m_TSNC.reload_shaders(shaderLibrary, batch);
+    m_MeshRenderer.reload_shaders(shaderLibrary, batch);
+    m_IBL.reload_shaders(shaderLibrary, batch);
+
+    // Everything below is dispatched per tile
+    std::vector<std::string> tileDefines;
+    tile_shape::shader_defines(m_TileShape, m_WaveLaneRange, tileDefines);
+    batch.set_compute_defines(tileDefines);
+
     // Shadows
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Lighting\\ShadowRT.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_ShadowRTCS);
+        batch.add_compute_shader(csd, m_ShadowRTCS);
     }
 
     // Debug view
@@ -192,7 +294,7 @@ void DinoRenderer::reload_shaders()
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Lighting\\DebugView.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_DebugViewCS);
+        batch.add_compute_shader(csd, m_DebugViewCS);
     }
 
     // Post process
@@ -202,31 +304,50 @@ void DinoRenderer::reload_shaders()
         gpd.includeDirectories.push_back(shaderLibrary);
         gpd.isProcedural = true;
         gpd.rtFormat[0] = TextureFormat::R16G16B16A16_Float;
-        compile_and_replace_graphics_pipeline(m_Device, gpd, m_UberPostGP);
+        batch.add_graphics_pipeline(gpd, m_UberPostGP);
     }
 
     // Components
-    m_TSNC.reload_shaders(shaderLibrary);
-    m_GBufferRenderer.reload_shaders(shaderLibrary, m_TSNC.shader_defines());
-    m_MaterialRenderer.reload_shaders(shaderLibrary, m_TSNC);
-    m_MeshRenderer.reload_shaders(shaderLibrary);
-    m_IBL.reload_shaders(shaderLibrary);
-    m_Classifier.reload_shaders(shaderLibrary);
+    m_GBufferRenderer.reload_shaders(shaderLibrary, m_TSNC.shader_defines(), batch);
+    m_MaterialRenderer.reload_shaders(shaderLibrary, m_TSNC, batch);
+    m_Classifier.reload_shaders(shaderLibrary, batch);
+    m_FeatureCache.reload_shaders(shaderLibrary, batch);
+
+    // Accumulate the files touched since the last successful reload, nothing is swapped when a batch fails
+    // so the changes are kept until they compile.
+    std::vector<std::string> changedFiles;
+    bool changesComplete = m_ShaderWatcher.active() && m_ShaderWatcher.consume_changes(changedFiles);
+    m_PendingShaderChanges.insert(m_PendingShaderChanges.end(), changedFiles.begin(), changedFiles.end());
+    m_ShaderChangesLost = m_ShaderChangesLost || !changesComplete;
+
+    // The previous shaders may still be used by the frames in flight
+    wait_for_frames();
+
+    // Compile and swap
+    bool success = (incremental && !m_ShaderChangesLost) ? batch.execute(m_Device, &m_PendingShaderChanges) : batch.execute(m_Device);
+    if (success)
+    {
+        m_PendingShaderChanges.clear();
+        m_ShaderChangesLost = false;
+    }
 }
 
 void DinoRenderer::release()
 {
-    // Constant buffer
-    graphics::resources::destroy_constant_buffer(m_GlobalCB);
+    // Make sure the GPU is done with all the frames
+    wait_for_frames();
+
+    // Constant buffers
+    for (FrameContext& frame : m_Frames)
+        graphics::resources::destroy_constant_buffer(frame.globalCB);
 
     // Render textures
     graphics::resources::destroy_render_texture(m_VisibilityBuffer);
     graphics::resources::destroy_render_texture(m_DepthTexture);
     graphics::resources::destroy_render_texture(m_ColorTexture);
-    graphics::resources::destroy_render_texture(m_ShadowTexture);
 
-    // Buffers
-    graphics::resources::destroy_graphics_buffer(m_GBuffer);
+    // Frame graph and its transient buffers
+    m_RenderGraph.release();
     
     // Shaders
     graphics::compute_shader::destroy_compute_shader(m_ShadowRTCS);
@@ -242,16 +363,33 @@ void DinoRenderer::release()
     m_TexManager.release();
     m_ProfilingHelper.release();
     m_Classifier.release();
+    m_FeatureCache.release();
 
     // Imgui
     graphics::imgui::release_imgui();
 
+    // Frame contexts
+    for (FrameContext& frame : m_Frames)
+    {
+        for (uint32_t segmentIdx = 0; segmentIdx < RG_NUM_DIRECT_SEGMENTS; ++segmentIdx)
+            graphics::command_buffer::destroy_command_buffer(frame.cmdBuffers.direct[segmentIdx]);
+        graphics::command_buffer::destroy_command_buffer(frame.cmdBuffers.compute);
+    }
+    m_Frames.clear();
+    graphics::fence::destroy_fence(m_FrameFence);
+    m_FramePacer.release();
+
     // Rendering components
-    graphics::command_buffer::destroy_command_buffer(m_CmdBuffer);
     graphics::swap_chain::destroy_swap_chain(m_SwapChain);
     graphics::command_queue::destroy_command_queue(m_CmdQueue);
     graphics::window::destroy_window(m_Window);
     graphics::device::destroy_graphics_device(m_Device);
+
+    // Shader watcher, archive, cache and worker pool
+    m_ShaderWatcher.release();
+    shader_archive::release();
+    shader_cache::release();
+    task_scheduler::release();
 }
 
 void DinoRenderer::render_ui(CommandBuffer cmdB, RenderTexture rt)
@@ -295,6 +433,41 @@ void DinoRenderer::render_ui(CommandBuffer cmdB, RenderTexture rt)
             imgui_dropdown_enum<DebugMode>(m_DebugMode, "Debug Mode", debug_mode_labels);
         }
 
+        // Variable rate inference, only the GBuffer path keeps features that can be upsampled
+        if (m_TextureMode == TextureMode::Neural && m_RenderingMode != RenderingMode::MaterialPass)
+        {
+            ImGui::Checkbox("Variable Rate Inference", &m_EnableVariableRate);
+            if (m_EnableVariableRate)
+            {
+                ImGui::SliderFloat("Half Rate Mip", &m_VariableRateSettings.halfRateMip, 0.0f, 8.0f);
+                ImGui::SliderFloat("Quarter Rate Mip", &m_VariableRateSettings.quarterRateMip, m_VariableRateSettings.halfRateMip, 8.0f);
+                ImGui::SliderFloat("Max Mip Spread", &m_VariableRateSettings.maxMipSpread, 0.0f, 4.0f);
+            }
+        }
+
+        // Temporal reuse of the inferred features, same restriction
+        if (m_TextureMode == TextureMode::Neural && m_RenderingMode != RenderingMode::MaterialPass)
+        {
+            ImGui::Checkbox("Feature Cache", &m_EnableFeatureCache);
+            if (m_EnableFeatureCache)
+            {
+                int refreshPeriod = (int)m_FeatureCacheSettings.refreshPeriod;
+                ImGui::SliderInt("Refresh Period", &refreshPeriod, 1, 32);
+                m_FeatureCacheSettings.refreshPeriod = (uint32_t)refreshPeriod;
+                ImGui::SliderFloat("Max UV Delta", &m_FeatureCacheSettings.maxUVDelta, 0.0f, 2.0f);
+                ImGui::SliderFloat("Max Mip Delta", &m_FeatureCacheSettings.maxMipDelta, 0.0f, 1.0f);
+            }
+        }
+
+        // Scheduling
+        ImGui::Checkbox("Async Compute Shadows", &m_EnableAsyncCompute);
+
+        // Classification tiles, the visibility captures feed the tile_shape_autotune tool
+        ImGui::Text("Tile Shape: %s", tile_shape::name(m_TileShape));
+        ImGui::SameLine();
+        if (ImGui::Button("Capture Visibility"))
+            m_VisibilityCaptureRequested = true;
+
         // Mesh renderer
         m_MeshRenderer.render_ui();
 
@@ -303,7 +476,7 @@ void DinoRenderer::render_ui(CommandBuffer cmdB, RenderTexture rt)
 
         ImGui::SeparatorText("Interactions");
         ImGui::Text("Mouse Right Button: Camera interaction.");
-        ImGui::Text("F5: Recompile shaders.");
+        ImGui::Text("F5: Recompile the modified shaders.");
         ImGui::Text("F6: Performance counters view.");
         ImGui::Text("F11: Toggle UI.");
     }
@@ -328,12 +501,36 @@ void DinoRenderer::render_ui(CommandBuffer cmdB, RenderTexture rt)
         }
 
         ImGui::SetNextWindowPos(ImVec2(1620, 0), ImGuiCond_Always);
-        ImGui::SetNextWindowSize(ImVec2(300, 180.0f));
+        ImGui::SetNextWindowSize(ImVec2(300, 400.0f));
         ImGui::Begin("Peformance Window");
 
         std::string label = "Current pass time ";
         label += to_string_with_precision(m_DurationArray[m_CurrentDuration], 3) + "(ms)";
         ImGui::PlotHistogram("##Histogram", m_DrawArray.data(), (uint32_t)m_DrawArray.size(), 0, label.c_str(), 0.0f, 1.5f * maxV, ImVec2(285, 145));
+
+        // Per queue timings
+        ImGui::Text("Frame: %.3f(ms)", m_DirectDurationMS);
+        ImGui::Text("Shadows (%s queue): %.3f(ms)", m_RenderGraph.async_active() ? "compute" : "direct", m_ShadowDurationMS);
+
+        // Scopes of the last frame read back, last duration and 95th percentile
+        if (ImGui::CollapsingHeader("Scopes"))
+        {
+            for (const TraceEvent& gpuEvent : m_ProfilingHelper.last_gpu_frame())
+            {
+                const ScopeHistory* history = m_ProfilingHelper.gpu_scope(gpuEvent.name);
+                ImGui::Text("%*s%s: %.3f / %.3f(ms)", gpuEvent.depth * 2, "", gpuEvent.name.c_str(), history->last(), history->percentile(95.0f));
+            }
+        }
+
+        // Chrome trace of the next frames
+        if (m_ProfilingHelper.capture_pending())
+            ImGui::Text("Capturing trace...");
+        else if (ImGui::Button("Capture trace"))
+            m_ProfilingHelper.capture_trace("frame_trace.json", 60);
+
+        // Resource heaps
+        DeviceMemoryStats memoryStats = graphics::device::memory_stats(m_Device);
+        ImGui::Text("Heaps: %.1f/%.1f(MB), frag %.0f%%", memoryStats.usedMemory / (1024.0f * 1024.0f), memoryStats.heapMemory / (1024.0f * 1024.0f), memoryStats.fragmentation * 100.0f);
         ImGui::End();
 
 
@@ -367,6 +564,26 @@ void DinoRenderer::update_constant_buffers(CommandBuffer cmdB)
     globalCB._FrameIndex = m_FrameIndex;
     globalCB._SunDirection = float3({ 0.57735026919, 0.57735026919 , 0.57735026919 });
 
+    // The material pass reads the uniform tiles without any upsample, the reduced rate lists have to stay empty
+    if (m_EnableVariableRate && m_TextureMode == TextureMode::Neural && m_RenderingMode != RenderingMode::MaterialPass)
+        variable_rate::normalized_thresholds(m_VariableRateSettings, globalCB._NumTextureLOD.x, globalCB._VRSHalfRateLOD, globalCB._VRSQuarterRateLOD, globalCB._VRSMaxLODSpread);
+    else
+    {
+        // The normalized LOD never goes above 1
+        globalCB._VRSHalfRateLOD = 2.0f;
+        globalCB._VRSQuarterRateLOD = 2.0f;
+        globalCB._VRSMaxLODSpread = 0.0f;
+    }
+
+    // Reuse of the features of the previous frame
+    globalCB._CacheMode = (uint32_t)m_FeatureCache.mode();
+    globalCB._CacheRefreshPeriod = std::max(m_FeatureCacheSettings.refreshPeriod, 1u);
+    globalCB._CacheFrameIndex = m_FeatureCache.frame_index();
+    globalCB._PrevCameraPosition = m_FeatureCache.prev_camera_position();
+    globalCB._PrevViewProjectionMatrix = m_FeatureCache.prev_view_projection();
+    globalCB._CacheMaxUVDelta = m_FeatureCacheSettings.maxUVDelta;
+    globalCB._CacheMaxLODDelta = m_FeatureCacheSettings.maxMipDelta / globalCB._NumTextureLOD.x;
+
     // Only one MLP for this application
     globalCB._MLPCount = 1;
 
@@ -375,178 +592,338 @@ void DinoRenderer::update_constant_buffers(CommandBuffer cmdB)
     graphics::command_buffer::upload_constant_buffer(cmdB, m_GlobalCB);
 }
 
-void DinoRenderer::render_frame()
+void DinoRenderer::wait_for_frames()
 {
-    // Reset the command buffer
-    graphics::command_buffer::reset(m_CmdBuffer);
-    if (m_EnableCounters)
-        m_ProfilingHelper.start_profiling(m_CmdBuffer, 0);
+    graphics::fence::wait_value(m_FrameFence, m_FramePacer.last_submitted_value());
+}
 
-    // Update the constant buffers
-    update_constant_buffers(m_CmdBuffer);
+void DinoRenderer::build_render_graph(RenderTexture backBuffer)
+{
+    m_RenderGraph.reset();
+
+    // Imported resources
+    RGResource visibilityRes = m_RenderGraph.import_render_texture("Visibility Buffer", m_VisibilityBuffer);
+    RGResource depthRes = m_RenderGraph.import_render_texture("Depth Texture", m_DepthTexture);
+    RGResource colorRes = m_RenderGraph.import_render_texture("Color Texture", m_ColorTexture);
+    RGResource backBufferRes = m_RenderGraph.import_render_texture("Back Buffer", backBuffer);
+    RGResource vertexRes = m_RenderGraph.import_buffer("Vertex Buffer", m_MeshRenderer.vertex_buffer());
+    RGResource indexRes = m_RenderGraph.import_buffer("Index Buffer", m_MeshRenderer.index_buffer());
+    RGResource displacementRes = m_RenderGraph.import_buffer("Displacement Buffer", m_MeshRenderer.displacement_buffer());
+    RGResource featureKeysRes = m_RenderGraph.import_buffer("Feature Keys", m_FeatureCache.keys_buffer());
+    RGResource featureKeyHistoryRes = m_RenderGraph.import_buffer("Feature Key History", m_FeatureCache.history_keys_buffer());
+    RGResource featureHistoryRes = m_RenderGraph.import_buffer("Feature History", m_FeatureCache.history_features_buffer());
+    RGResource reuseRes = m_RenderGraph.import_buffer("Reuse Buffer", m_FeatureCache.reuse_buffer());
+    m_RenderGraph.mark_output(backBufferRes);
+
+    // The shadows and the classification lists only live during the frame, they share the transient heap with the GBuffer
+    RGResource shadowRes = m_RenderGraph.create_transient_render_texture("Shadow Texture", m_ShadowDescriptor);
+    RGResource activeTilesRes = m_RenderGraph.create_transient_buffer("Active Tiles", m_Classifier.tile_list_size(), sizeof(uint32_t));
+    RGResource uniformTilesRes = m_RenderGraph.create_transient_buffer("Uniform Tiles", m_Classifier.tile_list_size(), sizeof(uint32_t));
+    RGResource complexTilesRes = m_RenderGraph.create_transient_buffer("Complex Tiles", m_Classifier.tile_list_size(), sizeof(uint32_t));
+    RGResource repackedTilesRes = m_RenderGraph.create_transient_buffer("Repacked Tiles", m_Classifier.repacked_tiles_size(), sizeof(uint32_t));
+    RGResource halfRateTilesRes = m_RenderGraph.create_transient_buffer("Half Rate Tiles", m_Classifier.tile_list_size(), sizeof(uint32_t));
+    RGResource quarterRateTilesRes = m_RenderGraph.create_transient_buffer("Quarter Rate Tiles", m_Classifier.tile_list_size(), sizeof(uint32_t));
+    RGResource indirectRes = m_RenderGraph.create_transient_buffer("Indirect Buffer", m_Classifier.indirect_size(), sizeof(uint32_t), (uint32_t)GraphicsBufferFlags::Indirect);
+
+    // The GBuffer only lives between its generation and the lighting, unless the next frame reuses it
+    const uint32_t numPixels = m_ScreenSizeI.x * m_ScreenSizeI.y;
+    RGResource gbufferRes = m_FeatureCache.mode() != FeatureCacheMode::Disabled ? m_RenderGraph.import_buffer("GBuffer", m_FeatureCache.features_buffer())
+        : m_RenderGraph.create_transient_buffer("GBuffer", numPixels * GBUFFER_PIXEL_SIZE, GBUFFER_PIXEL_SIZE);
 
-    // Update the skinning
-    m_MeshRenderer.update_mesh(m_CmdBuffer, m_GlobalCB);
+    // Update the skinning, also refreshes the acceleration structures
+    RGPass skinningPass = m_RenderGraph.add_pass("Skinning", [this](CommandBuffer cmd)
+    {
+        m_MeshRenderer.update_mesh(cmd, m_GlobalCB);
+    });
+    m_RenderGraph.write(skinningPass, vertexRes);
+    m_RenderGraph.write(skinningPass, displacementRes);
+    m_RenderGraph.set_side_effects(skinningPass);
 
     // Clear the render textures
-    graphics::command_buffer::start_section(m_CmdBuffer, "Clear targets");
+    RGPass clearPass = m_RenderGraph.add_pass("Clear targets", [this](CommandBuffer cmd)
     {
-        graphics::command_buffer::clear_render_texture(m_CmdBuffer, m_VisibilityBuffer, float4({ 0.0, 0.0, 0.0, 1.0 }));
+        graphics::command_buffer::clear_render_texture(cmd, m_VisibilityBuffer, float4({ 0.0, 0.0, 0.0, 1.0 }));
         if (m_RenderingMode == RenderingMode::Debug)
-            graphics::command_buffer::clear_render_texture(m_CmdBuffer, m_ColorTexture, float4({ 0.5, 0.5, 0.5, 1.0 }));
-        graphics::command_buffer::clear_depth_texture(m_CmdBuffer, m_DepthTexture, 1.0f);
-    }
-    graphics::command_buffer::end_section(m_CmdBuffer);
-    
-
-    // Set the viewport for the frame
-    graphics::command_buffer::set_viewport(m_CmdBuffer, 0, 0, m_ScreenSizeI.x, m_ScreenSizeI.y);
+            graphics::command_buffer::clear_render_texture(cmd, m_ColorTexture, float4({ 0.5, 0.5, 0.5, 1.0 }));
+        graphics::command_buffer::clear_depth_texture(cmd, m_DepthTexture, 1.0f);
+    });
+    m_RenderGraph.write(clearPass, visibilityRes, RGAccess::RenderTarget);
+    m_RenderGraph.write(clearPass, depthRes, RGAccess::RenderTarget);
+    if (m_RenderingMode == RenderingMode::Debug)
+        m_RenderGraph.write(clearPass, colorRes, RGAccess::RenderTarget);
 
     // Render the visibility buffer
-    m_MeshRenderer.render_mesh(m_CmdBuffer, m_GlobalCB, m_VisibilityBuffer, m_DepthTexture);
-
-    // Render the shadows
-    graphics::command_buffer::start_section(m_CmdBuffer, "Trace shadows");
+    RGPass visibilityPass = m_RenderGraph.add_pass("Visibility", [this](CommandBuffer cmd)
+    {
+        graphics::command_buffer::set_viewport(cmd, 0, 0, m_ScreenSizeI.x, m_ScreenSizeI.y);
+        m_MeshRenderer.render_mesh(cmd, m_GlobalCB, m_VisibilityBuffer, m_DepthTexture);
+    });
+    m_RenderGraph.read(visibilityPass, vertexRes);
+    m_RenderGraph.read(visibilityPass, indexRes);
+    m_RenderGraph.write(visibilityPass, visibilityRes, RGAccess::RenderTarget);
+    m_RenderGraph.write(visibilityPass, depthRes, RGAccess::RenderTarget);
+
+    // Render the shadows, they only depend on the visibility buffer and can overlap with the classification and the inference
+    // The section of the pass is the "Trace shadows" profiling scope read back for the performance window
+    RGPass shadowPass = m_RenderGraph.add_pass("Trace shadows", [this, shadowRes](CommandBuffer cmd)
     {
         // CBVs
-        graphics::command_buffer::set_compute_shader_cbuffer(m_CmdBuffer, m_ShadowRTCS, "_GlobalCB", m_GlobalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmd, m_ShadowRTCS, shader_binding::GlobalCB, m_GlobalCB);
 
         // SRVs
-        graphics::command_buffer::set_compute_shader_render_texture(m_CmdBuffer, m_ShadowRTCS, "_VisibilityBuffer", m_VisibilityBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(m_CmdBuffer, m_ShadowRTCS, "_VertexBuffer", m_MeshRenderer.vertex_buffer());
-        graphics::command_buffer::set_compute_shader_buffer(m_CmdBuffer, m_ShadowRTCS, "_IndexBuffer", m_MeshRenderer.index_buffer());
-        graphics::command_buffer::set_compute_shader_rtas(m_CmdBuffer, m_ShadowRTCS, "_SceneRTAS", m_MeshRenderer.tlas());
+        graphics::command_buffer::set_compute_shader_render_texture(cmd, m_ShadowRTCS, shader_binding::VisibilityBuffer, m_VisibilityBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmd, m_ShadowRTCS, shader_binding::VertexBuffer, m_MeshRenderer.vertex_buffer());
+        graphics::command_buffer::set_compute_shader_buffer(cmd, m_ShadowRTCS, shader_binding::IndexBuffer, m_MeshRenderer.index_buffer());
+        graphics::command_buffer::set_compute_shader_rtas(cmd, m_ShadowRTCS, shader_binding::SceneRTAS, m_MeshRenderer.tlas());
 
         // UAVs
-        graphics::command_buffer::set_compute_shader_render_texture(m_CmdBuffer, m_ShadowRTCS, "_ShadowTextureRW", m_ShadowTexture);
+        graphics::command_buffer::set_compute_shader_render_texture(cmd, m_ShadowRTCS, shader_binding::ShadowTextureRW, m_RenderGraph.render_texture(shadowRes));
+
+        // Dispatch
+        graphics::command_buffer::dispatch(cmd, m_ShadowRTCS, m_TileSizeI.x, m_TileSizeI.y, 1);
+    });
+    m_RenderGraph.read(shadowPass, visibilityRes);
+    m_RenderGraph.read(shadowPass, vertexRes);
+    m_RenderGraph.read(shadowPass, indexRes);
+    m_RenderGraph.write(shadowPass, shadowRes);
+    m_RenderGraph.set_async_compute(shadowPass);
+
+    // Classification, the passes that consume it read the lists of this frame through the classifier
+    RGResource classifierResources[] = { activeTilesRes, uniformTilesRes, complexTilesRes, repackedTilesRes, halfRateTilesRes, quarterRateTilesRes, indirectRes };
+    RGPass classificationPass = m_RenderGraph.add_pass("Classification", [this, classifierResources](CommandBuffer cmd)
+    {
+        TileClassifierBuffers buffers;
+        buffers.activeTiles = m_RenderGraph.buffer(classifierResources[0]);
+        buffers.uniformTiles = m_RenderGraph.buffer(classifierResources[1]);
+        buffers.complexTiles = m_RenderGraph.buffer(classifierResources[2]);
+        buffers.repackedTiles = m_RenderGraph.buffer(classifierResources[3]);
+        buffers.halfRateTiles = m_RenderGraph.buffer(classifierResources[4]);
+        buffers.quarterRateTiles = m_RenderGraph.buffer(classifierResources[5]);
+        buffers.indirect = m_RenderGraph.buffer(classifierResources[6]);
+        m_Classifier.set_buffers(buffers);
+        m_Classifier.classify(cmd, m_GlobalCB, m_VisibilityBuffer, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_FeatureCache);
+    });
+    m_RenderGraph.read(classificationPass, visibilityRes);
+    m_RenderGraph.read(classificationPass, vertexRes);
+    m_RenderGraph.read(classificationPass, indexRes);
+    m_RenderGraph.write(classificationPass, activeTilesRes);
+    m_RenderGraph.write(classificationPass, uniformTilesRes);
+    m_RenderGraph.write(classificationPass, complexTilesRes);
+    m_RenderGraph.write(classificationPass, repackedTilesRes);
+    m_RenderGraph.write(classificationPass, halfRateTilesRes);
+    m_RenderGraph.write(classificationPass, quarterRateTilesRes);
+    m_RenderGraph.read(classificationPass, featureKeyHistoryRes);
+    m_RenderGraph.write(classificationPass, featureKeysRes);
+    m_RenderGraph.write(classificationPass, reuseRes);
+    m_RenderGraph.write(classificationPass, indirectRes);
+
+    // GBuffer generation, culled when nothing consumes it
+    RGPass gbufferPass = m_RenderGraph.add_pass("GBuffer", [this, gbufferRes](CommandBuffer cmd)
+    {
+        GraphicsBuffer gbuffer = m_RenderGraph.buffer(gbufferRes);
 
-        // Dispatch + Barrier
-        graphics::command_buffer::dispatch(m_CmdBuffer, m_ShadowRTCS, m_TileSizeI.x, m_TileSizeI.y, 1);
-        graphics::command_buffer::uav_barrier_render_texture(m_CmdBuffer, m_ShadowTexture);
+        // Depending on if it's the neural path or the other path
+        if (m_TextureMode == TextureMode::Neural)
+        {
+            m_FeatureCache.resolve(cmd, m_GlobalCB, m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer());
+            m_GBufferRenderer.evaluate_neural_cmp_indirect(cmd, m_GlobalCB,
+                m_VisibilityBuffer, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), gbuffer,
+                m_Classifier, m_UseCooperativeVectors, m_TSNC, m_FilteringMode);
+        }
+        else
+        {
+            // Grab the right texture set
+            const TextureSet& texSet = m_TexManager.texture_set(m_TextureMode == TextureMode::BC6H);
+            m_GBufferRenderer.evaluate_indirect(cmd, m_GlobalCB, m_VisibilityBuffer, m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer(), gbuffer, texSet, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_FilteringMode);
+        }
+    });
+    m_RenderGraph.read(gbufferPass, visibilityRes);
+    m_RenderGraph.read(gbufferPass, vertexRes);
+    m_RenderGraph.read(gbufferPass, indexRes);
+    m_RenderGraph.read(gbufferPass, activeTilesRes);
+    m_RenderGraph.read(gbufferPass, uniformTilesRes);
+    m_RenderGraph.read(gbufferPass, repackedTilesRes);
+    m_RenderGraph.read(gbufferPass, halfRateTilesRes);
+    m_RenderGraph.read(gbufferPass, quarterRateTilesRes);
+    m_RenderGraph.read(gbufferPass, reuseRes);
+    m_RenderGraph.read(gbufferPass, featureHistoryRes);
+    m_RenderGraph.read(gbufferPass, indirectRes);
+    m_RenderGraph.write(gbufferPass, gbufferRes);
+
+    // Render the background
+    if (m_RenderingMode != RenderingMode::Debug)
+    {
+        RGPass backgroundPass = m_RenderGraph.add_pass("Background", [this, shadowRes](CommandBuffer cmd)
+        {
+            m_IBL.render_cubemap(cmd, m_GlobalCB, m_ColorTexture, m_RenderGraph.render_texture(shadowRes), m_MeshRenderer.displacement_buffer());
+        });
+        m_RenderGraph.read(backgroundPass, shadowRes);
+        m_RenderGraph.read(backgroundPass, displacementRes);
+        m_RenderGraph.write(backgroundPass, colorRes);
     }
-    graphics::command_buffer::end_section(m_CmdBuffer);
-
-    // Classification
-    m_Classifier.classify(m_CmdBuffer, m_GlobalCB, m_VisibilityBuffer, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer());
 
     // Trigger the right rendering path
     switch (m_RenderingMode)
     {
         case RenderingMode::GBufferDeferred:
-        case RenderingMode::Debug:
         {
-            // Depending on if it's the neural path or the other path
-            if (m_TextureMode == TextureMode::Neural)
-            {
-                if (m_EnableCounters)
-                    m_ProfilingHelper.start_profiling(m_CmdBuffer, 1);
-
-                m_GBufferRenderer.evaluate_neural_cmp_indirect(m_CmdBuffer, m_GlobalCB,
-                    m_VisibilityBuffer, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_GBuffer,
-                    m_Classifier, m_UseCooperativeVectors, m_TSNC, m_FilteringMode);
-
-                if (m_EnableCounters)
-                    m_ProfilingHelper.end_profiling(m_CmdBuffer, 1);
-            }
-            else
+            // Render the lighting
+            RGPass lightingPass = m_RenderGraph.add_pass("Lighting", [this, gbufferRes, shadowRes](CommandBuffer cmd)
             {
-                // Grab the right texture set
-                const TextureSet& texSet = m_TexManager.texture_set(m_TextureMode == TextureMode::BC6H);
-
-                //  GBuffer generation
-                if (m_EnableCounters)
-                    m_ProfilingHelper.start_profiling(m_CmdBuffer, 1);
-                m_GBufferRenderer.evaluate_indirect(m_CmdBuffer, m_GlobalCB, m_VisibilityBuffer, m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer(), m_GBuffer, texSet, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_FilteringMode);
-                if (m_EnableCounters)
-                    m_ProfilingHelper.end_profiling(m_CmdBuffer, 1);
-            }
-
-            switch (m_RenderingMode)
+                m_GBufferRenderer.lighting_indirect(cmd, m_GlobalCB, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_IBL, m_RenderGraph.buffer(gbufferRes), m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer(), m_VisibilityBuffer, m_RenderGraph.render_texture(shadowRes), m_ColorTexture);
+            });
+            m_RenderGraph.read(lightingPass, gbufferRes);
+            m_RenderGraph.read(lightingPass, visibilityRes);
+            m_RenderGraph.read(lightingPass, shadowRes);
+            m_RenderGraph.read(lightingPass, vertexRes);
+            m_RenderGraph.read(lightingPass, indexRes);
+            m_RenderGraph.read(lightingPass, activeTilesRes);
+            m_RenderGraph.read(lightingPass, indirectRes);
+            m_RenderGraph.write(lightingPass, colorRes);
+        }
+        break;
+        case RenderingMode::Debug:
+        {
+            RGPass debugPass = m_RenderGraph.add_pass("Debug view", [this, gbufferRes](CommandBuffer cmd)
             {
-                case RenderingMode::GBufferDeferred:
-                {
-                    // First render the background
-                    m_IBL.render_cubemap(m_CmdBuffer, m_GlobalCB, m_ColorTexture, m_ShadowTexture, m_MeshRenderer.displacement_buffer());
-
-                    // Render the lighting
-                    m_GBufferRenderer.lighting_indirect(m_CmdBuffer, m_GlobalCB, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_IBL, m_GBuffer, m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer(), m_VisibilityBuffer, m_ShadowTexture, m_ColorTexture);
-                }
-                break;
-                case RenderingMode::Debug:
-                {
-                    // CBVs
-                    graphics::command_buffer::set_compute_shader_cbuffer(m_CmdBuffer, m_DebugViewCS, "_GlobalCB", m_GlobalCB);
-
-                    // SRVs
-                    graphics::command_buffer::set_compute_shader_render_texture(m_CmdBuffer, m_DebugViewCS, "_VisibilityBuffer", m_VisibilityBuffer);
-                    graphics::command_buffer::set_compute_shader_buffer(m_CmdBuffer, m_DebugViewCS, "_InferenceBuffer", m_GBuffer);
-                    graphics::command_buffer::set_compute_shader_buffer(m_CmdBuffer, m_DebugViewCS, "_IndexationBuffer", m_Classifier.active_tiles_buffer());
-
-                    // UAVs
-                    graphics::command_buffer::set_compute_shader_render_texture(m_CmdBuffer, m_DebugViewCS, "_ColorTextureRW", m_ColorTexture);
-
-                    // Dispatch + Barrier
-                    graphics::command_buffer::dispatch_indirect(m_CmdBuffer, m_DebugViewCS, m_Classifier.indirect_buffer());
-                    graphics::command_buffer::uav_barrier_render_texture(m_CmdBuffer, m_ColorTexture);
-                }
-                break;
-            }
+                // CBVs
+                graphics::command_buffer::set_compute_shader_cbuffer(cmd, m_DebugViewCS, shader_binding::GlobalCB, m_GlobalCB);
+
+                // SRVs
+                graphics::command_buffer::set_compute_shader_render_texture(cmd, m_DebugViewCS, shader_binding::VisibilityBuffer, m_VisibilityBuffer);
+                graphics::command_buffer::set_compute_shader_buffer(cmd, m_DebugViewCS, shader_binding::InferenceBuffer, m_RenderGraph.buffer(gbufferRes));
+                graphics::command_buffer::set_compute_shader_buffer(cmd, m_DebugViewCS, shader_binding::IndexationBuffer, m_Classifier.active_tiles_buffer());
+
+                // UAVs
+                graphics::command_buffer::set_compute_shader_render_texture(cmd, m_DebugViewCS, shader_binding::ColorTextureRW, m_ColorTexture);
+
+                // Dispatch
+                graphics::command_buffer::dispatch_indirect(cmd, m_DebugViewCS, m_Classifier.indirect_buffer());
+            });
+            m_RenderGraph.read(debugPass, gbufferRes);
+            m_RenderGraph.read(debugPass, visibilityRes);
+            m_RenderGraph.read(debugPass, activeTilesRes);
+            m_RenderGraph.read(debugPass, indirectRes);
+            m_RenderGraph.write(debugPass, colorRes);
         }
         break;
         case RenderingMode::MaterialPass:
         {
-            // Render the background
-            m_IBL.render_cubemap(m_CmdBuffer, m_GlobalCB, m_ColorTexture, m_ShadowTexture, m_MeshRenderer.displacement_buffer());
-
-            // Depending on if it's the neural path or the other path
-            if (m_TextureMode == TextureMode::Neural)
+            RGPass materialPass = m_RenderGraph.add_pass("Material", [this, shadowRes](CommandBuffer cmd)
             {
-                if (m_EnableCounters)
-                    m_ProfilingHelper.start_profiling(m_CmdBuffer, 1);
+                // Depending on if it's the neural path or the other path
+                if (m_TextureMode == TextureMode::Neural)
                 {
-                    m_MaterialRenderer.evaluate_neural_cmp_indirect(m_CmdBuffer, m_GlobalCB, m_TSNC, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(),
+                    m_MaterialRenderer.evaluate_neural_cmp_indirect(cmd, m_GlobalCB, m_TSNC, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(),
                         m_IBL, m_UseCooperativeVectors, m_FilteringMode,
-                        m_VisibilityBuffer, m_ShadowTexture, m_Classifier, m_ColorTexture);
+                        m_VisibilityBuffer, m_RenderGraph.render_texture(shadowRes), m_Classifier, m_ColorTexture);
                 }
-
-                if (m_EnableCounters)
-                    m_ProfilingHelper.end_profiling(m_CmdBuffer, 1);
-            }
-            else
-            {
-                // Grab the right texture set
-                const TextureSet& texSet = m_TexManager.texture_set(m_TextureMode == TextureMode::BC6H);
-
-                // GBuffer generation
-                if (m_EnableCounters)
-                    m_ProfilingHelper.start_profiling(m_CmdBuffer, 1);
-                m_MaterialRenderer.evaluate_indirect(m_CmdBuffer, m_GlobalCB, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_IBL, texSet, m_FilteringMode, m_VisibilityBuffer,
-                    m_ShadowTexture, m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer(), m_ColorTexture);
-                if (m_EnableCounters)
-                    m_ProfilingHelper.end_profiling(m_CmdBuffer, 1);
-            }
+                else
+                {
+                    // Grab the right texture set
+                    const TextureSet& texSet = m_TexManager.texture_set(m_TextureMode == TextureMode::BC6H);
+                    m_MaterialRenderer.evaluate_indirect(cmd, m_GlobalCB, m_MeshRenderer.vertex_buffer(), m_MeshRenderer.index_buffer(), m_IBL, texSet, m_FilteringMode, m_VisibilityBuffer,
+                        m_RenderGraph.render_texture(shadowRes), m_Classifier.active_tiles_buffer(), m_Classifier.indirect_buffer(), m_ColorTexture);
+                }
+            });
+            m_RenderGraph.read(materialPass, visibilityRes);
+            m_RenderGraph.read(materialPass, shadowRes);
+            m_RenderGraph.read(materialPass, vertexRes);
+            m_RenderGraph.read(materialPass, indexRes);
+            m_RenderGraph.read(materialPass, activeTilesRes);
+            m_RenderGraph.read(materialPass, uniformTilesRes);
+            m_RenderGraph.read(materialPass, repackedTilesRes);
+            m_RenderGraph.read(materialPass, indirectRes);
+            m_RenderGraph.write(materialPass, colorRes);
         }
         break;
     }
-    if (m_EnableCounters)
-        m_ProfilingHelper.end_profiling(m_CmdBuffer, 0);
+
+    // Post process
+    RGPass postPass = m_RenderGraph.add_pass("Post process", [this, backBuffer](CommandBuffer cmd)
+    {
+        graphics::command_buffer::set_viewport(cmd, 0, 0, m_ScreenSizeI.x, m_ScreenSizeI.y);
+        graphics::command_buffer::set_render_texture(cmd, backBuffer);
+        graphics::command_buffer::set_graphics_pipeline_cbuffer(cmd, m_UberPostGP, shader_binding::GlobalCB, m_GlobalCB);
+        graphics::command_buffer::set_graphics_pipeline_render_texture(cmd, m_UberPostGP, shader_binding::ColorTextureIn, m_ColorTexture);
+        graphics::command_buffer::draw_procedural(cmd, m_UberPostGP, 1, 1);
+    });
+    m_RenderGraph.read(postPass, colorRes);
+    m_RenderGraph.write(postPass, backBufferRes, RGAccess::RenderTarget);
+
+    // Render UI
+    RGPass uiPass = m_RenderGraph.add_pass("UI", [this, backBuffer](CommandBuffer cmd)
+    {
+        render_ui(cmd, backBuffer);
+    });
+    m_RenderGraph.write(uiPass, backBufferRes, RGAccess::RenderTarget);
+}
+
+void DinoRenderer::render_frame()
+{
+    CPU_PROFILE_SCOPE("Render frame");
+
+    // Grab the next frame context, its resources can only be reused once the GPU is done with the frame that last used them
+    uint64_t waitValue = 0;
+    const FrameContext& frame = m_Frames[m_FramePacer.begin_frame(waitValue)];
+    {
+        CPU_PROFILE_SCOPE("Wait for GPU");
+        graphics::fence::wait_value(m_FrameFence, waitValue);
+    }
+    m_CmdBuffer = frame.cmdBuffers.direct[0];
+    m_GlobalCB = frame.globalCB;
+
+    // The timestamps of the frame that used this context are available now
+    m_ProfilingHelper.set_enabled(m_EnableCounters);
+    m_ProfilingHelper.begin_frame();
+
+    // Reset the command buffer
+    graphics::command_buffer::reset(m_CmdBuffer);
+    m_ProfilingHelper.begin_scope(m_CmdBuffer, "Frame");
+
+    // Swap the feature history, anything that changes the inferred features invalidates it
+    {
+        const Camera& camera = m_CameraController.get_camera();
+        bool featureCacheActive = m_EnableFeatureCache && m_TextureMode == TextureMode::Neural && m_RenderingMode != RenderingMode::MaterialPass;
+        uint32_t cacheConfiguration = (uint32_t)m_FilteringMode | (m_UseCooperativeVectors ? 0x10 : 0) | (m_EnableVariableRate ? 0x20 : 0);
+        m_FeatureCache.begin_frame(featureCacheActive, cacheConfiguration, camera.viewProjection, camera.position);
+    }
+
+    // Update the constant buffers
+    update_constant_buffers(m_CmdBuffer);
 
     // Grab the current swap chain render target
     RenderTexture rTexture = graphics::swap_chain::get_current_render_texture(m_SwapChain);
-    
-    // Post process
-    graphics::command_buffer::start_section(m_CmdBuffer, "Post process");
+
+    // Declare the frame
+    {
+        CPU_PROFILE_SCOPE("Build render graph");
+        build_render_graph(rTexture);
+    }
     {
-        graphics::command_buffer::set_viewport(m_CmdBuffer, 0, 0, m_ScreenSizeI.x, m_ScreenSizeI.y);
-        graphics::command_buffer::set_render_texture(m_CmdBuffer, rTexture);
-        graphics::command_buffer::set_graphics_pipeline_cbuffer(m_CmdBuffer, m_UberPostGP, "_GlobalCB", m_GlobalCB);
-        graphics::command_buffer::set_graphics_pipeline_render_texture(m_CmdBuffer, m_UberPostGP, "_ColorTextureIn", m_ColorTexture);
-        graphics::command_buffer::draw_procedural(m_CmdBuffer, m_UberPostGP, 1, 1);
+        CPU_PROFILE_SCOPE("Compile render graph");
+        m_RenderGraph.enable_async_compute(m_EnableAsyncCompute);
+        m_RenderGraph.compile();
     }
-    graphics::command_buffer::end_section(m_CmdBuffer);
 
-    // Render UI
-    render_ui(m_CmdBuffer, rTexture);
+    // The work before the cross-queue synchronizations is submitted by the graph, the frame continues on the last command buffer
+    {
+        CPU_PROFILE_SCOPE("Record passes");
+        m_CmdBuffer = m_RenderGraph.execute(m_CmdQueue, frame.cmdBuffers);
+    }
+
+    // Close the frame scope and resolve the timestamps, the last command buffer executes after every queue is done
+    m_ProfilingHelper.end_scope(m_CmdBuffer);
+    m_ProfilingHelper.end_frame(m_CmdBuffer);
+
+    // Read back the visibility buffer of this frame
+    GraphicsBuffer visibilityReadback = 0;
+    if (m_VisibilityCaptureRequested)
+    {
+        visibilityReadback = graphics::resources::create_graphics_buffer(m_Device, m_ScreenSizeI.x * m_ScreenSizeI.y * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Readback);
+        graphics::command_buffer::copy_render_texture_into_buffer(m_CmdBuffer, m_VisibilityBuffer, 0, visibilityReadback, 0);
+        m_VisibilityCaptureRequested = false;
+    }
 
     // Set the render target in present mode
     graphics::command_buffer::transition_to_present(m_CmdBuffer, rTexture);
@@ -558,10 +935,44 @@ void DinoRenderer::render_frame()
     graphics::command_queue::execute_command_buffer(m_CmdQueue, m_CmdBuffer);
 
     // Present
-    graphics::swap_chain::present(m_SwapChain, m_CmdQueue);
+    {
+        CPU_PROFILE_SCOPE("Present");
+        graphics::swap_chain::present(m_SwapChain, m_CmdQueue);
+    }
+
+    // Signal the end of the frame, the CPU moves on to the next one without waiting for the GPU
+    graphics::command_queue::signal(m_CmdQueue, m_FrameFence, m_FramePacer.end_frame());
 
-    // Flush the queue
-    graphics::command_queue::flush(m_CmdQueue);
+    // Captures are rare, they can afford a stall
+    if (visibilityReadback != 0)
+        write_visibility_capture(visibilityReadback);
+}
+
+void DinoRenderer::write_visibility_capture(GraphicsBuffer readbackBuffer)
+{
+    // Wait for the copy
+    wait_for_frames();
+
+    // Resolve the primitives to materials
+    VisibilityCapture capture;
+    capture.width = m_ScreenSizeI.x;
+    capture.height = m_ScreenSizeI.y;
+    capture.materials.resize(capture.width * capture.height);
+    const uint32_t* visibilityData = (const uint32_t*)graphics::resources::allocate_cpu_buffer(readbackBuffer);
+    for (uint32_t pixelIdx = 0; pixelIdx < (uint32_t)capture.materials.size(); ++pixelIdx)
+    {
+        uint32_t visibility = visibilityData[pixelIdx];
+        capture.materials[pixelIdx] = (visibility & 0x80000000) != 0 ? m_MeshRenderer.material_id(visibility & 0x7FFFFFFF) : TILE_SHAPE_EMPTY_PIXEL;
+    }
+    graphics::resources::release_cpu_buffer(readbackBuffer);
+    graphics::resources::destroy_graphics_buffer(readbackBuffer);
+
+    // One file per capture
+    const std::string path = "visibility_capture_" + std::to_string(m_NumVisibilityCaptures++) + ".bin";
+    if (tile_shape::write_capture(path, capture))
+        printf("Visibility buffer written to %s.\n", path.c_str());
+    else
+        printf("Failed to write the visibility capture %s.\n", path.c_str());
 }
 
 
@@ -571,7 +982,7 @@ void DinoRenderer::process_key_event(uint32_t keyCode, bool state)
     {
         case 0x74: // F5
             if (state)
-                reload_shaders();
+                reload_shaders(true);
             break;
         case 0x75: // F6
             if (state)
@@ -596,8 +1007,15 @@ void DinoRenderer::render_loop()
     {
         auto start = std::chrono::high_resolution_clock::now();
 
-        // Handle the messages
-        graphics::window::handle_messages(m_Window);
+        // The messages are pumped by the window thread, ask for the next paint
+        {
+            CPU_PROFILE_SCOPE("Handle messages");
+            graphics::window::handle_messages(m_Window);
+        }
+
+        // Sleep until the paint or an event arrives instead of spinning, a benchmark renders continuously
+        if (!m_Benchmark.active())
+            event_collector::wait_for_activity();
         uint2 windowCenter = graphics::window::window_center(m_Window);
 
         // Process the events
@@ -638,19 +1056,33 @@ void DinoRenderer::render_loop()
             graphics::window::set_cursor_pos(m_Window, windowCenter);
         }
 
-        // Draw if needed
-        if (event_collector::active_draw_request())
+        // Benchmark step, the reports are written once the sweep is done
+        if (m_Benchmark.active() && !begin_benchmark_frame())
+        {
+            if (!m_Benchmark.write_reports(m_BenchmarkOutput, graphics::device::get_device_name(m_Device)))
+                printf("Failed to write the benchmark reports %s.\n", m_BenchmarkOutput.c_str());
+            activeLoop = false;
+        }
+
+        // Draw if needed, a benchmark renders continuously. The request is consumed before rendering so that a paint that arrives meanwhile isn't lost
+        if (event_collector::consume_draw_request() || m_Benchmark.active())
         {
             render_frame();
             m_FrameIndex++;
-            event_collector::draw_done();
+            if (m_Benchmark.measuring())
+                record_benchmark_frame();
         }
 
         // Query the time
         if (m_EnableCounters && lastUpdate > 0.1)
         {
-            m_ProfilingHelper.process_scopes(m_CmdQueue);
-            float passDurationMS = m_ProfilingHelper.get_scope_last_duration(1) / 1e3f;
+            // The scopes are read back by the profiler a few frames later, no need to wait for the GPU
+            const ScopeHistory* passScope = m_ProfilingHelper.gpu_scope(m_RenderingMode == RenderingMode::MaterialPass ? "Material" : "GBuffer");
+            const ScopeHistory* frameScope = m_ProfilingHelper.gpu_scope("Frame");
+            const ScopeHistory* shadowScope = m_ProfilingHelper.gpu_scope("Trace shadows");
+            float passDurationMS = passScope != nullptr ? passScope->last() : 0.0f;
+            m_DirectDurationMS = frameScope != nullptr ? frameScope->last() : 0.0f;
+            m_ShadowDurationMS = shadowScope != nullptr ? shadowScope->last() : 0.0f;
 
             // Move to the next time
             m_CurrentDuration++;
@@ -664,14 +1096,63 @@ void DinoRenderer::render_loop()
         // Evaluate the time
         auto stop = std::chrono::high_resolution_clock::now();
         std::chrono::nanoseconds duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-        double deltaTime = duration.count() / 1e9;
+        double deltaTime = m_Benchmark.active() ? BENCHMARK_TIME_STEP : duration.count() / 1e9;
 
         // Update the system
-        update(deltaTime);
+        {
+            CPU_PROFILE_SCOPE("Update");
+            update(deltaTime);
+        }
         lastUpdate += (float)deltaTime;
     }
 }
 
+bool DinoRenderer::begin_benchmark_frame()
+{
+    if (!m_Benchmark.next_frame(m_CameraController.is_playing()))
+        return false;
+
+    // Apply the configuration of the new step, the camera only travels if the POI changed
+    if (m_Benchmark.step_started())
+    {
+        const BenchmarkConfig& config = m_Benchmark.config();
+        m_TextureMode = config.textureMode;
+        m_FilteringMode = config.filteringMode;
+        m_UseCooperativeVectors = config.cooperative;
+        m_EnableVariableRate = config.variableRate;
+        m_EnableFeatureCache = config.featureCache;
+        if (m_Benchmark.poi_changed())
+            m_CameraController.setup_play_path(config.poi);
+        printf("Benchmark step %u/%u\n", m_Benchmark.current_step() + 1, m_Benchmark.num_steps());
+    }
+    return true;
+}
+
+void DinoRenderer::record_benchmark_frame()
+{
+    // Frame and passes, the deeper scopes are left to the traces. The null backend only simulates them.
+    if (m_GraphicsAPI != GraphicsAPI::Null)
+    {
+        for (const TraceEvent& gpuEvent : m_ProfilingHelper.last_gpu_frame())
+        {
+            if (gpuEvent.depth <= 1)
+                m_Benchmark.record(gpuEvent.name, (float)(gpuEvent.durationUS / 1e3));
+        }
+    }
+
+    // CPU cost of recording and submitting the frame, then of its steps
+    const ScopeHistory* cpuFrame = m_ProfilingHelper.cpu_scope("Render frame");
+    if (cpuFrame != nullptr)
+        m_Benchmark.record("CPU frame", cpuFrame->last());
+    const char* cpuSteps[] = { "Update", "Wait for GPU", "Build render graph", "Compile render graph", "Record passes", "Present" };
+    for (const char* cpuStep : cpuSteps)
+    {
+        const ScopeHistory* cpuScope = m_ProfilingHelper.cpu_scope(cpuStep);
+        if (cpuScope != nullptr)
+            m_Benchmark.record(std::string("CPU ") + cpuStep, cpuScope->last());
+    }
+}
+
 void DinoRenderer::update(double deltaTime)
 {
     // Add to the time
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "graphics/backend.h"
+#include "render_pipeline/feature_cache.h"
+#include "render_pipeline/gbuffer_codec.h"
+#include "render_pipeline/shader_bindings.h"
+#include "render_pipeline/tile_shape.h"
+
+FeatureCache::FeatureCache()
+{
+}
+
+FeatureCache::~FeatureCache()
+{
+}
+
+void FeatureCache::initialize(GraphicsDevice device, const uint2& screenSize, const uint2& tileSize, TileShape tileShape)
+{
+    // Keep track of the device
+    m_Device = device;
+
+    // The features are stored per tile, the keys and reuse sources per pixel
+    const uint32_t numPixels = screenSize.x * screenSize.y;
+    const uint32_t numTilePixels = tileSize.x * tileSize.y * tile_shape::num_pixels(tileShape);
+    for (uint32_t bufferIdx = 0; bufferIdx < 2; ++bufferIdx)
+    {
+        m_FeatureBuffers[bufferIdx] = graphics::resources::create_graphics_buffer(m_Device, numTilePixels * GBUFFER_PIXEL_SIZE, GBUFFER_PIXEL_SIZE, GraphicsBufferType::Default);
+        m_KeyBuffers[bufferIdx] = graphics::resources::create_graphics_buffer(m_Device, numPixels * 4 * sizeof(uint32_t), 4 * sizeof(uint32_t), GraphicsBufferType::Default);
+    }
+    m_ReuseBuffer = graphics::resources::create_graphics_buffer(m_Device, numPixels * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
+}
+
+void FeatureCache::release()
+{
+    // Graphics resources
+    for (uint32_t bufferIdx = 0; bufferIdx < 2; ++bufferIdx)
+    {
+        graphics::resources::destroy_graphics_buffer(m_FeatureBuffers[bufferIdx]);
+        graphics::resources::destroy_graphics_buffer(m_KeyBuffers[bufferIdx]);
+    }
+    graphics::resources::destroy_graphics_buffer(m_ReuseBuffer);
+
+    // Shaders
+    graphics::compute_shader::destroy_compute_shader(m_ReuseCS);
+}
+
+void FeatureCache::reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch)
+{
+    ComputeShaderDescriptor csd;
+    csd.includeDirectories.push_back(shaderLibrary);
+    csd.filename = shaderLibrary + "\\GBuffer\\Reuse.compute";
+    batch.add_compute_shader(csd, m_ReuseCS);
+
+    // The inference may have changed
+    invalidate();
+}
+
+FeatureCacheMode FeatureCache::begin_frame(bool enabled, uint32_t configuration, const float4x4& viewProjection, const float3& cameraPosition)
+{
+    // The history is what the previous frame wrote
+    m_CurrentIdx = 1 - m_CurrentIdx;
+    bool historyValid = m_HistoryRecorded && configuration == m_Configuration;
+    m_HistoryRecorded = enabled;
+    m_Configuration = configuration;
+    m_Mode = !enabled ? FeatureCacheMode::Disabled : (historyValid ? FeatureCacheMode::Reuse : FeatureCacheMode::Record);
+
+    // Cameras of both frames
+    m_PrevViewProjection = m_ViewProjection;
+    m_PrevCameraPosition = m_CameraPosition;
+    m_ViewProjection = viewProjection;
+    m_CameraPosition = cameraPosition;
+
+    // Keeps rotating the refreshed tiles whatever happens to the camera
+    m_FrameIndex++;
+    return m_Mode;
+}
+
+void FeatureCache::resolve(CommandBuffer cmdB, ConstantBuffer globalCB, GraphicsBuffer tileBuffer, GraphicsBuffer indirectBuffer)
+{
+    if (m_Mode != FeatureCacheMode::Reuse)
+        return;
+
+    graphics::command_buffer::start_section(cmdB, "Reuse features");
+
+    // CBVs
+    graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_ReuseCS, shader_binding::GlobalCB, globalCB);
+
+    // SRVs
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ReuseCS, shader_binding::TileBuffer, tileBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ReuseCS, shader_binding::ReuseBuffer, m_ReuseBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ReuseCS, shader_binding::HistoryBuffer, history_features_buffer());
+
+    // UAVs
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ReuseCS, shader_binding::InferenceBufferRW, features_buffer());
+
+    // Dispatch over the active tiles
+    graphics::command_buffer::dispatch_indirect(cmdB, m_ReuseCS, indirectBuffer, 0);
+
+    graphics::command_buffer::end_section(cmdB);
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/feature_cache.h"
+
+// System includes
+#include <algorithm>
+#include <math.h>
+
+namespace feature_cache
+{
+    bool is_refresh_tile(uint32_t tileIdx, uint32_t frameIndex, uint32_t refreshPeriod)
+    {
+        uint32_t hash = (tileIdx * 0x9E3779B1u) >> 16;
+        return (hash + frameIndex) % refreshPeriod == 0;
+    }
+
+    bool validate_reuse(const FeatureCacheKey& key, const float2& uvDX, const float2& uvDY, const FeatureCacheKey& prevKey, const FeatureCacheSettings& settings, float numMips)
+    {
+        if (!prevKey.valid || prevKey.material != key.material)
+            return false;
+        float footprint = std::max(std::max(length(uvDX), length(uvDY)), 1e-8f);
+        return length(prevKey.uv - key.uv) <= settings.maxUVDelta * footprint && fabsf(prevKey.lod - key.lod) <= settings.maxMipDelta / numMips;
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/gbuffer_codec.h"
+
+// System includes
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+// Shared exponent layout
+#define RGB9E5_MANTISSA_BITS 9
+#define RGB9E5_EXPONENT_BIAS 15
+#define RGB9E5_MAX_VALUE 65408.0f
+
+namespace gbuffer_codec
+{
+    static uint32_t pack_unorm(float value, uint32_t numBits)
+    {
+        return (uint32_t)(clamp(value, 0.0f, 1.0f) * (float)((1u << numBits) - 1) + 0.5f);
+    }
+
+    static float unpack_unorm(uint32_t value, uint32_t numBits)
+    {
+        return (float)value / (float)((1u << numBits) - 1);
+    }
+
+    uint32_t pack_rgb9e5(const float3& color)
+    {
+        float r = clamp(color.x, 0.0f, RGB9E5_MAX_VALUE);
+        float g = clamp(color.y, 0.0f, RGB9E5_MAX_VALUE);
+        float b = clamp(color.z, 0.0f, RGB9E5_MAX_VALUE);
+        float maxChannel = max3(r, g, b);
+
+        // Exponent of the largest channel, read from the float like the shader does
+        uint32_t maxBits;
+        memcpy(&maxBits, &maxChannel, sizeof(float));
+        int32_t maxExponent = (int32_t)((maxBits >> 23) & 0xFF) - 127;
+        int32_t sharedExponent = std::max(-RGB9E5_EXPONENT_BIAS - 1, maxExponent) + 1 + RGB9E5_EXPONENT_BIAS;
+
+        // The rounding can overflow the mantissa of the largest channel
+        float scale = exp2f((float)(sharedExponent - RGB9E5_EXPONENT_BIAS - RGB9E5_MANTISSA_BITS));
+        if ((uint32_t)floorf(maxChannel / scale + 0.5f) == (1u << RGB9E5_MANTISSA_BITS))
+        {
+            sharedExponent++;
+            scale *= 2.0f;
+        }
+
+        uint32_t mantissaR = (uint32_t)floorf(r / scale + 0.5f);
+        uint32_t mantissaG = (uint32_t)floorf(g / scale + 0.5f);
+        uint32_t mantissaB = (uint32_t)floorf(b / scale + 0.5f);
+        return mantissaR | (mantissaG << 9) | (mantissaB << 18) | ((uint32_t)sharedExponent << 27);
+    }
+
+    float3 unpack_rgb9e5(uint32_t value)
+    {
+        float scale = exp2f((float)((int32_t)(value >> 27) - RGB9E5_EXPONENT_BIAS - RGB9E5_MANTISSA_BITS));
+        return float3({ (value & 0x1FF) * scale, ((value >> 9) & 0x1FF) * scale, ((value >> 18) & 0x1FF) * scale });
+    }
+
+    float2 octahedral_encode(const float3& normal)
+    {
+        float norm1 = std::max(fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z), FLT_MIN);
+        float2 encoded = { normal.x / norm1, normal.y / norm1 };
+        if (normal.z < 0.0f)
+        {
+            float2 folded = { (1.0f - fabsf(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f), (1.0f - fabsf(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f) };
+            encoded = folded;
+        }
+        return float2({ encoded.x * 0.5f + 0.5f, encoded.y * 0.5f + 0.5f });
+    }
+
+    float3 octahedral_decode(const float2& encoded)
+    {
+        float3 normal = { encoded.x * 2.0f - 1.0f, encoded.y * 2.0f - 1.0f, 0.0f };
+        normal.z = 1.0f - fabsf(normal.x) - fabsf(normal.y);
+        float t = clamp(-normal.z, 0.0f, 1.0f);
+        normal.x += normal.x >= 0.0f ? -t : t;
+        normal.y += normal.y >= 0.0f ? -t : t;
+        return normalize(normal);
+    }
+
+    uint4 encode(const float* channels)
+    {
+        // The network outputs the normal remapped to [0, 1]
+        const float* normalTS = channels + GBUFFER_NORMAL_OFFSET;
+        float2 octNormal = octahedral_encode(float3({ normalTS[0] * 2.0f - 1.0f, normalTS[1] * 2.0f - 1.0f, normalTS[2] * 2.0f - 1.0f }));
+
+        uint4 data;
+        data.x = pack_rgb9e5(float3({ channels[GBUFFER_DIFFUSE_OFFSET], channels[GBUFFER_DIFFUSE_OFFSET + 1], channels[GBUFFER_DIFFUSE_OFFSET + 2] }));
+        data.y = pack_unorm(octNormal.x, 16) | (pack_unorm(octNormal.y, 16) << 16);
+        data.z = pack_unorm(channels[GBUFFER_AO_OFFSET], 8) | (pack_unorm(channels[GBUFFER_ROUGHNESS_OFFSET], 8) << 8)
+            | (pack_unorm(channels[GBUFFER_METALNESS_OFFSET], 8) << 16) | (pack_unorm(channels[GBUFFER_THICKNESS_OFFSET], 8) << 24);
+        data.w = pack_unorm(channels[GBUFFER_MASK_OFFSET], 8) | (pack_unorm(channels[GBUFFER_MASK_OFFSET + 1], 8) << 8) | (pack_unorm(channels[GBUFFER_DISPLACEMENT_OFFSET], 16) << 16);
+        return data;
+    }
+
+    void decode(const uint4& data, float* channels)
+    {
+        for (uint32_t channelIdx = 0; channelIdx < GBUFFER_NUM_CHANNELS; ++channelIdx)
+            channels[channelIdx] = 0.0f;
+
+        float3 diffuse = unpack_rgb9e5(data.x);
+        channels[GBUFFER_DIFFUSE_OFFSET] = diffuse.x;
+        channels[GBUFFER_DIFFUSE_OFFSET + 1] = diffuse.y;
+        channels[GBUFFER_DIFFUSE_OFFSET + 2] = diffuse.z;
+
+        float3 normal = octahedral_decode(float2({ unpack_unorm(data.y & 0xFFFF, 16), unpack_unorm(data.y >> 16, 16) }));
+        channels[GBUFFER_NORMAL_OFFSET] = normal.x * 0.5f + 0.5f;
+        channels[GBUFFER_NORMAL_OFFSET + 1] = normal.y * 0.5f + 0.5f;
+        channels[GBUFFER_NORMAL_OFFSET + 2] = normal.z * 0.5f + 0.5f;
+
+        channels[GBUFFER_AO_OFFSET] = unpack_unorm(data.z & 0xFF, 8);
+        channels[GBUFFER_ROUGHNESS_OFFSET] = unpack_unorm((data.z >> 8) & 0xFF, 8);
+        channels[GBUFFER_METALNESS_OFFSET] = unpack_unorm((data.z >> 16) & 0xFF, 8);
+        channels[GBUFFER_THICKNESS_OFFSET] = unpack_unorm(data.z >> 24, 8);
+        channels[GBUFFER_MASK_OFFSET] = unpack_unorm(data.w & 0xFF, 8);
+        channels[GBUFFER_MASK_OFFSET + 1] = unpack_unorm((data.w >> 8) & 0xFF, 8);
+        channels[GBUFFER_DISPLACEMENT_OFFSET] = unpack_unorm(data.w >> 16, 16);
+    }
+}
@@ -11,6 +11,7 @@
 #include "tools/security.h"
 #include "tools/shader_utils.h"
 #include "tools/gpu_helpers.h"
+#include "render_pipeline/shader_bindings.h"
 
 GBufferRenderer::GBufferRenderer()
 {
@@ -45,22 +46,28 @@ void GBufferRenderer::release()
     graphics::compute_shader::destroy_compute_shader(m_TextureCS);
     graphics::compute_shader::destroy_compute_shader(m_FMABC1CS);
     graphics::compute_shader::destroy_compute_shader(m_FMABC1_Repacked_CS);
+    graphics::compute_shader::destroy_compute_shader(m_FMABC1_Half_CS);
+    graphics::compute_shader::destroy_compute_shader(m_FMABC1_Quarter_CS);
     if (m_CoopVectors)
     {
         graphics::compute_shader::destroy_compute_shader(m_CVBC1CS);
         graphics::compute_shader::destroy_compute_shader(m_CVBC1_Repacked_CS);
+        graphics::compute_shader::destroy_compute_shader(m_CVBC1_Half_CS);
+        graphics::compute_shader::destroy_compute_shader(m_CVBC1_Quarter_CS);
     }
+    graphics::compute_shader::destroy_compute_shader(m_UpsampleHalfCS);
+    graphics::compute_shader::destroy_compute_shader(m_UpsampleQuarterCS);
     graphics::compute_shader::destroy_compute_shader(m_DeferredLightingCS);
 }
 
-void GBufferRenderer::reload_shaders(const std::string& shaderLibrary, const std::vector<std::string>& shaderDefines)
+void GBufferRenderer::reload_shaders(const std::string& shaderLibrary, const std::vector<std::string>& shaderDefines, ShaderCompileBatch& batch)
 {
     // Texture sampling
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\GBuffer\\Textures\\Inference.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_TextureCS);
+        batch.add_compute_shader(csd, m_TextureCS);
     }
 
     // FMA Inference
@@ -73,10 +80,17 @@ void GBufferRenderer::reload_shaders(const std::string& shaderLibrary, const std
 
         // BC1 version
         csd.kernelname = "main";
-        compile_and_replace_compute_shader(m_Device, csd, m_FMABC1CS);
+        batch.add_compute_shader(csd, m_FMABC1CS);
 
         csd.kernelname = "main_repacked";
-        compile_and_replace_compute_shader(m_Device, csd, m_FMABC1_Repacked_CS);
+        batch.add_compute_shader(csd, m_FMABC1_Repacked_CS);
+
+        // Reduced rate versions
+        csd.kernelname = "main_half";
+        batch.add_compute_shader(csd, m_FMABC1_Half_CS);
+
+        csd.kernelname = "main_quarter";
+        batch.add_compute_shader(csd, m_FMABC1_Quarter_CS);
     }
 
     // Coop vector inference
@@ -91,11 +105,31 @@ void GBufferRenderer::reload_shaders(const std::string& shaderLibrary, const std
 
         // BC1 version
         csd.kernelname = "main";
-        compile_and_replace_compute_shader(m_Device, csd, m_CVBC1CS, true);
+        batch.add_compute_shader(csd, m_CVBC1CS, true);
 
         // Repacked version
         csd.kernelname = "main_repacked";
-        compile_and_replace_compute_shader(m_Device, csd, m_CVBC1_Repacked_CS, true);
+        batch.add_compute_shader(csd, m_CVBC1_Repacked_CS, true);
+
+        // Reduced rate versions
+        csd.kernelname = "main_half";
+        batch.add_compute_shader(csd, m_CVBC1_Half_CS, true);
+
+        csd.kernelname = "main_quarter";
+        batch.add_compute_shader(csd, m_CVBC1_Quarter_CS, true);
+    }
+
+    // Reconstruction of the reduced rate tiles
+    {
+        ComputeShaderDescriptor csd;
+        csd.includeDirectories.push_back(shaderLibrary);
+        csd.filename = shaderLibrary + "\\GBuffer\\Upsample.compute";
+
+        csd.kernelname = "main_half";
+        batch.add_compute_shader(csd, m_UpsampleHalfCS);
+
+        csd.kernelname = "main_quarter";
+        batch.add_compute_shader(csd, m_UpsampleQuarterCS);
     }
 
     // Deferred lighting
@@ -103,7 +137,7 @@ void GBufferRenderer::reload_shaders(const std::string& shaderLibrary, const std
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Lighting\\Lit.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_DeferredLightingCS);
+        batch.add_compute_shader(csd, m_DeferredLightingCS);
     }
 }
 
@@ -112,41 +146,40 @@ void GBufferRenderer::evaluate_indirect(CommandBuffer cmdB, ConstantBuffer globa
     const TextureSet& texSet, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, FilteringMode filteringMode)
 {
     // CBVs
-    graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_TextureCS, "_GlobalCB", globalCB);
+    graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_TextureCS, shader_binding::GlobalCB, globalCB);
 
     // Common buffers
-    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TextureCS, "_VisibilityBuffer", visibilityBuffer);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, "_TileBuffer", indexationBuffer);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, "_VertexBuffer", vertexBuffer);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, "_IndexBuffer", indexBuffer);
+    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TextureCS, shader_binding::VisibilityBuffer, visibilityBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, shader_binding::TileBuffer, indexationBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, shader_binding::VertexBuffer, vertexBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, shader_binding::IndexBuffer, indexBuffer);
 
     // Texture materials
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, "_Texture0", texSet.tex0);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, "_Texture1", texSet.tex1);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, "_Texture2", texSet.tex2);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, "_Texture3", texSet.tex3);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, "_Texture4", texSet.tex4);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, shader_binding::Texture0, texSet.tex0);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, shader_binding::Texture1, texSet.tex1);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, shader_binding::Texture2, texSet.tex2);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, shader_binding::Texture3, texSet.tex3);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TextureCS, shader_binding::Texture4, texSet.tex4);
 
     // Sampler
     switch (filteringMode)
     {
         case FilteringMode::Nearest:
-            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TextureCS, "s_texture_sampler", m_NearestSampler);
+            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TextureCS, shader_binding::TextureSampler, m_NearestSampler);
         break;
         case FilteringMode::Linear:
-            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TextureCS, "s_texture_sampler", m_LinearSampler);
+            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TextureCS, shader_binding::TextureSampler, m_LinearSampler);
         break;
         case FilteringMode::Anisotropic:
-            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TextureCS, "s_texture_sampler", m_AnisoSampler);
+            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TextureCS, shader_binding::TextureSampler, m_AnisoSampler);
         break;
     }
 
     // Output buffer
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, "_OutputBufferRW", outputBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TextureCS, shader_binding::OutputBufferRW, outputBuffer);
 
-    // Dispatch + Barrier
+    // Dispatch, the render graph takes care of the barrier with the next pass
     graphics::command_buffer::dispatch_indirect(cmdB, m_TextureCS, indirectBuffer);
-    graphics::command_buffer::uav_barrier_buffer(cmdB, outputBuffer);
 }
 
 void GBufferRenderer::partial_inference(CommandBuffer cmdB, ComputeShader targetCS, uint32_t indirectOffset, GraphicsBuffer tileBuffer, ConstantBuffer globalCB, GraphicsBuffer visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, GraphicsBuffer outputBuffer,
@@ -159,49 +192,48 @@ void GBufferRenderer::partial_inference(CommandBuffer cmdB, ComputeShader target
     if (targetCS != 0)
     {
         // Constant buffers
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, targetCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, targetCS, shader_binding::GlobalCB, globalCB);
 
         // Common buffers
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, "_VisibilityBuffer", visibilityBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_TileBuffer", tileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_VertexBuffer", vertexBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_IndexBuffer", indexBuffer);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, shader_binding::VisibilityBuffer, visibilityBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::TileBuffer, tileBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::VertexBuffer, vertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::IndexBuffer, indexBuffer);
 
         // Latent Space
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS0Texture", gpuNwk.tex0);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS1Texture", gpuNwk.tex1);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS2Texture", gpuNwk.tex2);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS3Texture", gpuNwk.tex3);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_UVOffsetBuffer", network.uv_offset_buffer());
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS0Texture, gpuNwk.tex0);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS1Texture, gpuNwk.tex1);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS2Texture, gpuNwk.tex2);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS3Texture, gpuNwk.tex3);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::UVOffsetBuffer, network.uv_offset_buffer());
 
         // Sampler
         switch (filteringMode)
         {
             case FilteringMode::Nearest:
-                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "bc1_linear_clamp_sampler", m_NearestSampler);
+                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::BC1LinearClampSampler, m_NearestSampler);
                 break;
             case FilteringMode::Linear:
-                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "bc1_linear_clamp_sampler", m_LinearSampler);
+                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::BC1LinearClampSampler, m_LinearSampler);
                 break;
             case FilteringMode::Anisotropic:
-                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "bc1_linear_clamp_sampler", m_AnisoSampler);
+                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::BC1LinearClampSampler, m_AnisoSampler);
                 break;
         }
 
         // MLPs
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPWeight0Buffer", useCoopVectors ? gpuNwk.mlp.weight0OptimalBuffer : gpuNwk.mlp.weight0Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPBias0Buffer", gpuNwk.mlp.bias0Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPWeight1Buffer", useCoopVectors ? gpuNwk.mlp.weight1OptimalBuffer : gpuNwk.mlp.weight1Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPBias1Buffer", gpuNwk.mlp.bias1Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPWeight2Buffer", useCoopVectors ? gpuNwk.mlp.weight2OptimalBuffer : gpuNwk.mlp.weight2Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPBias2Buffer", gpuNwk.mlp.bias2Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPWeight0Buffer, useCoopVectors ? gpuNwk.mlp.weight0OptimalBuffer : gpuNwk.mlp.weight0Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPBias0Buffer, gpuNwk.mlp.bias0Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPWeight1Buffer, useCoopVectors ? gpuNwk.mlp.weight1OptimalBuffer : gpuNwk.mlp.weight1Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPBias1Buffer, gpuNwk.mlp.bias1Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPWeight2Buffer, useCoopVectors ? gpuNwk.mlp.weight2OptimalBuffer : gpuNwk.mlp.weight2Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPBias2Buffer, gpuNwk.mlp.bias2Buffer);
 
         // Output buffer
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_OutputBufferRW", outputBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::OutputBufferRW, outputBuffer);
 
-        // Dispatch + Barrier
+        // Dispatch
         graphics::command_buffer::dispatch_indirect(cmdB, targetCS, classifier.indirect_buffer(), indirectOffset);
-        graphics::command_buffer::uav_barrier_buffer(cmdB, outputBuffer);
     }
 }
 
@@ -214,11 +246,50 @@ void GBufferRenderer::evaluate_neural_cmp_indirect(CommandBuffer cmdB, ConstantB
     partial_inference(cmdB, uniformCS, 3 * sizeof(uint32_t), classifier.uniform_tiles_buffer(), globalCB, visibilityBuffer, vertexBuffer, indexBuffer, outputBuffer, classifier, useCoopVectors, network, filteringMode);
     graphics::command_buffer::end_section(cmdB);
 
+    // Both kernels write the output buffer, the barrier after the second one is derived by the render graph
+    graphics::command_buffer::uav_barrier_buffer(cmdB, outputBuffer);
+
     // Repacked inference
     ComputeShader repackedCS = useCoopVectors ? m_CVBC1_Repacked_CS : m_FMABC1_Repacked_CS;
     graphics::command_buffer::start_section(cmdB, "Repacked inference");
     partial_inference(cmdB, repackedCS, 9 * sizeof(uint32_t), classifier.repacked_tiles_buffer(), globalCB, visibilityBuffer, vertexBuffer, indexBuffer, outputBuffer, classifier, useCoopVectors, network, filteringMode);
     graphics::command_buffer::end_section(cmdB);
+
+    // Reduced rate inference, these tiles are not part of the uniform ones so the pixels don't overlap
+    ComputeShader halfCS = useCoopVectors ? m_CVBC1_Half_CS : m_FMABC1_Half_CS;
+    ComputeShader quarterCS = useCoopVectors ? m_CVBC1_Quarter_CS : m_FMABC1_Quarter_CS;
+    graphics::command_buffer::start_section(cmdB, "Reduced rate inference");
+    partial_inference(cmdB, halfCS, 12 * sizeof(uint32_t), classifier.half_rate_tiles_buffer(), globalCB, visibilityBuffer, vertexBuffer, indexBuffer, outputBuffer, classifier, useCoopVectors, network, filteringMode);
+    partial_inference(cmdB, quarterCS, 15 * sizeof(uint32_t), classifier.quarter_rate_tiles_buffer(), globalCB, visibilityBuffer, vertexBuffer, indexBuffer, outputBuffer, classifier, useCoopVectors, network, filteringMode);
+    graphics::command_buffer::end_section(cmdB);
+
+    // The upsample reads the inferred pixels
+    graphics::command_buffer::uav_barrier_buffer(cmdB, outputBuffer);
+
+    // Reconstruct the skipped pixels
+    graphics::command_buffer::start_section(cmdB, "Upsample");
+    upsample_indirect(cmdB, m_UpsampleHalfCS, 18 * sizeof(uint32_t), classifier.half_rate_tiles_buffer(), globalCB, visibilityBuffer, vertexBuffer, indexBuffer, outputBuffer, classifier);
+    upsample_indirect(cmdB, m_UpsampleQuarterCS, 21 * sizeof(uint32_t), classifier.quarter_rate_tiles_buffer(), globalCB, visibilityBuffer, vertexBuffer, indexBuffer, outputBuffer, classifier);
+    graphics::command_buffer::end_section(cmdB);
+}
+
+void GBufferRenderer::upsample_indirect(CommandBuffer cmdB, ComputeShader targetCS, uint32_t indirectOffset, GraphicsBuffer tileBuffer, ConstantBuffer globalCB, GraphicsBuffer visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, GraphicsBuffer outputBuffer,
+    const TileClassifier& classifier)
+{
+    // CBVs
+    graphics::command_buffer::set_compute_shader_cbuffer(cmdB, targetCS, shader_binding::GlobalCB, globalCB);
+
+    // SRVs
+    graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, shader_binding::VisibilityBuffer, visibilityBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::TileBuffer, tileBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::VertexBuffer, vertexBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::IndexBuffer, indexBuffer);
+
+    // UAVs
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::InferenceBufferRW, outputBuffer);
+
+    // Dispatch, both kernels touch different tiles
+    graphics::command_buffer::dispatch_indirect(cmdB, targetCS, classifier.indirect_buffer(), indirectOffset);
 }
 
 void GBufferRenderer::lighting_indirect(CommandBuffer cmdB, ConstantBuffer globalCB, 
@@ -229,30 +300,29 @@ void GBufferRenderer::lighting_indirect(CommandBuffer cmdB, ConstantBuffer globa
     graphics::command_buffer::start_section(cmdB, "Deferred Lighting");
     {
         // CBV
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_DeferredLightingCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_DeferredLightingCS, shader_binding::GlobalCB, globalCB);
 
         // Input buffers
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_DeferredLightingCS, "_VisibilityBuffer", visibilityBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, "_InferenceBuffer", gbuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, "_TileBuffer", tileBuffer);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, m_DeferredLightingCS, "_PreIntegratedFGDTexture", ibl.pre_integrated_fgd());
-        graphics::command_buffer::set_compute_shader_texture(cmdB, m_DeferredLightingCS, "_ConvolvedIBLTexture", ibl.convolved_ggx_ibl());
-        graphics::command_buffer::set_compute_shader_texture(cmdB, m_DeferredLightingCS, "_IndirectDiffuseTexture", ibl.convolved_lambert_ibl());
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, "_VertexBuffer", vertexBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, "_IndexBuffer", indexBuffer);
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_DeferredLightingCS, "_ShadowTexture", shadowTexture);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_DeferredLightingCS, shader_binding::VisibilityBuffer, visibilityBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, shader_binding::InferenceBuffer, gbuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, shader_binding::TileBuffer, tileBuffer);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, m_DeferredLightingCS, shader_binding::PreIntegratedFGDTexture, ibl.pre_integrated_fgd());
+        graphics::command_buffer::set_compute_shader_texture(cmdB, m_DeferredLightingCS, shader_binding::ConvolvedIBLTexture, ibl.convolved_ggx_ibl());
+        graphics::command_buffer::set_compute_shader_texture(cmdB, m_DeferredLightingCS, shader_binding::IndirectDiffuseTexture, ibl.convolved_lambert_ibl());
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, shader_binding::VertexBuffer, vertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DeferredLightingCS, shader_binding::IndexBuffer, indexBuffer);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_DeferredLightingCS, shader_binding::ShadowTexture, shadowTexture);
 
         // Output buffer
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_DeferredLightingCS, "_ColorTextureRW", colorTexture);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_DeferredLightingCS, shader_binding::ColorTextureRW, colorTexture);
 
         // Samplers
-        graphics::command_buffer::set_compute_shader_sampler(cmdB, m_DeferredLightingCS, "s_fgd_sampler", ibl.fgd_sampler());
-        graphics::command_buffer::set_compute_shader_sampler(cmdB, m_DeferredLightingCS, "s_ggx_sampler", ibl.ggx_sampler());
-        graphics::command_buffer::set_compute_shader_sampler(cmdB, m_DeferredLightingCS, "s_lambert_sampler", ibl.lambert_sampler());
+        graphics::command_buffer::set_compute_shader_sampler(cmdB, m_DeferredLightingCS, shader_binding::FGDSampler, ibl.fgd_sampler());
+        graphics::command_buffer::set_compute_shader_sampler(cmdB, m_DeferredLightingCS, shader_binding::GGXSampler, ibl.ggx_sampler());
+        graphics::command_buffer::set_compute_shader_sampler(cmdB, m_DeferredLightingCS, shader_binding::LambertSampler, ibl.lambert_sampler());
 
-        // Dispatch + Barrier
+        // Dispatch
         graphics::command_buffer::dispatch_indirect(cmdB, m_DeferredLightingCS, indirectBuffer);
-        graphics::command_buffer::uav_barrier_render_texture(cmdB, colorTexture);
     }
     graphics::command_buffer::end_section(cmdB);
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "tools/texture_utils.h"
 #include "tools/shader_utils.h"
 #include "tools/security.h"
+#include "render_pipeline/shader_bindings.h"
 
 IBL::IBL()
 {
@@ -215,7 +216,7 @@ void IBL::upload_textures(CommandQueue cmdQ, CommandBuffer cmdB)
     }
 }
 
-void IBL::reload_shaders(const std::string& shaderLibrary)
+void IBL::reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch)
 {
     // Cubemap rendering
     {
@@ -223,7 +224,7 @@ void IBL::reload_shaders(const std::string& shaderLibrary)
         gpd.filename = shaderLibrary + "\\Cubemap.graphics";
         gpd.includeDirectories.push_back(shaderLibrary);
         gpd.isProcedural = true;
-        compile_and_replace_graphics_pipeline(m_Device, gpd, m_CubemapGP);
+        batch.add_graphics_pipeline(gpd, m_CubemapGP);
     }
 }
 
@@ -233,16 +234,16 @@ void IBL::render_cubemap(CommandBuffer cmdB, ConstantBuffer globalCB, RenderText
     graphics::command_buffer::set_render_texture(cmdB, colorTexture);
 
     // Constant buffer
-    graphics::command_buffer::set_graphics_pipeline_cbuffer(cmdB, m_CubemapGP, "_GlobalCB", globalCB);
+    graphics::command_buffer::set_graphics_pipeline_cbuffer(cmdB, m_CubemapGP, shader_binding::GlobalCB, globalCB);
 
     // Input data
-    graphics::command_buffer::set_graphics_pipeline_texture(cmdB, m_CubemapGP, "_BackgroundTexture", m_BackgroundTexture);
-    graphics::command_buffer::set_graphics_pipeline_texture(cmdB, m_CubemapGP, "_IndirectDiffuseTexture", m_ConvolvedLambertTexture);
-    graphics::command_buffer::set_graphics_pipeline_render_texture(cmdB, m_CubemapGP, "_ShadowTexture", shadowTexture);
-    graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, m_CubemapGP, "_DisplacementBuffer", displacementBuffer);
+    graphics::command_buffer::set_graphics_pipeline_texture(cmdB, m_CubemapGP, shader_binding::BackgroundTexture, m_BackgroundTexture);
+    graphics::command_buffer::set_graphics_pipeline_texture(cmdB, m_CubemapGP, shader_binding::IndirectDiffuseTexture, m_ConvolvedLambertTexture);
+    graphics::command_buffer::set_graphics_pipeline_render_texture(cmdB, m_CubemapGP, shader_binding::ShadowTexture, shadowTexture);
+    graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, m_CubemapGP, shader_binding::DisplacementBuffer, displacementBuffer);
 
     // Sampler
-    graphics::command_buffer::set_graphics_pipeline_sampler(cmdB, m_CubemapGP, "sampler_linear_clamp", m_LambertSampler);
+    graphics::command_buffer::set_graphics_pipeline_sampler(cmdB, m_CubemapGP, shader_binding::LinearClampSampler, m_LambertSampler);
 
     // Draw
     graphics::command_buffer::draw_procedural(cmdB, m_CubemapGP, 1, 1);
@@ -7,6 +7,7 @@
 
 // Includes
 #include "graphics/backend.h"
+#include "render_pipeline/shader_bindings.h"
 
 #include "render_pipeline/material_renderer.h"
 
@@ -55,14 +56,14 @@ void MaterialRenderer::release()
     }
 }
 
-void MaterialRenderer::reload_shaders(const std::string& shaderLibrary, const TSNC& network)
+void MaterialRenderer::reload_shaders(const std::string& shaderLibrary, const TSNC& network, ShaderCompileBatch& batch)
 {
     // Textures
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Material\\Textures\\MaterialPass.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_TexturesCS);
+        batch.add_compute_shader(csd, m_TexturesCS);
     }
 
     // FMA inference
@@ -76,11 +77,11 @@ void MaterialRenderer::reload_shaders(const std::string& shaderLibrary, const TS
 
         // BC1 version
         csd.kernelname = "main";
-        compile_and_replace_compute_shader(m_Device, csd, m_FMABC1CS);
+        batch.add_compute_shader(csd, m_FMABC1CS);
 
         // BC1 version Repacked
         csd.kernelname = "main_repacked";
-        compile_and_replace_compute_shader(m_Device, csd, m_FMABC1_Repacked_CS);
+        batch.add_compute_shader(csd, m_FMABC1_Repacked_CS);
     }
 
     // Coop vector inference
@@ -96,11 +97,11 @@ void MaterialRenderer::reload_shaders(const std::string& shaderLibrary, const TS
 
         // BC1 version
         csd.kernelname = "main";
-        compile_and_replace_compute_shader(m_Device, csd, m_CVBC1CS, true);
+        batch.add_compute_shader(csd, m_CVBC1CS, true);
 
         // BC1 version Repacked
         csd.kernelname = "main_repacked";
-        compile_and_replace_compute_shader(m_Device, csd, m_CVBC1_Repacked_CS, true);
+        batch.add_compute_shader(csd, m_CVBC1_Repacked_CS, true);
     }
 }
 
@@ -109,48 +110,47 @@ void MaterialRenderer::evaluate_indirect(CommandBuffer cmdB, ConstantBuffer glob
     RenderTexture visilityBuffer, GraphicsBuffer shadowTexture, GraphicsBuffer indexationBuffer, GraphicsBuffer indirectBuffer, RenderTexture colorTexture)
 {
     // Constant buffer
-    graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_TexturesCS, "_GlobalCB", globalCB);
+    graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_TexturesCS, shader_binding::GlobalCB, globalCB);
 
     // SRVs
-    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TexturesCS, "_VisibilityBuffer", visilityBuffer);
-    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TexturesCS, "_ShadowTexture", shadowTexture);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TexturesCS, "_TileBuffer", indexationBuffer);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TexturesCS, "_VertexBuffer", vertexBuffer);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TexturesCS, "_IndexBuffer", indexBuffer);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_PreIntegratedFGDTexture", ibl.pre_integrated_fgd());
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_ConvolvedIBLTexture", ibl.convolved_ggx_ibl());
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_IndirectDiffuseTexture", ibl.convolved_lambert_ibl());
+    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TexturesCS, shader_binding::VisibilityBuffer, visilityBuffer);
+    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TexturesCS, shader_binding::ShadowTexture, shadowTexture);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TexturesCS, shader_binding::TileBuffer, indexationBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TexturesCS, shader_binding::VertexBuffer, vertexBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, m_TexturesCS, shader_binding::IndexBuffer, indexBuffer);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::PreIntegratedFGDTexture, ibl.pre_integrated_fgd());
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::ConvolvedIBLTexture, ibl.convolved_ggx_ibl());
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::IndirectDiffuseTexture, ibl.convolved_lambert_ibl());
 
     // Material texture
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_Texture0", texSet.tex0);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_Texture1", texSet.tex1);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_Texture2", texSet.tex2);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_Texture3", texSet.tex3);
-    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, "_Texture4", texSet.tex4);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::Texture0, texSet.tex0);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::Texture1, texSet.tex1);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::Texture2, texSet.tex2);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::Texture3, texSet.tex3);
+    graphics::command_buffer::set_compute_shader_texture(cmdB, m_TexturesCS, shader_binding::Texture4, texSet.tex4);
 
     // Samplers
-    graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, "s_fgd_sampler", ibl.fgd_sampler());
-    graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, "s_ggx_sampler", ibl.ggx_sampler());
-    graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, "s_lambert_sampler", ibl.lambert_sampler());
+    graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, shader_binding::FGDSampler, ibl.fgd_sampler());
+    graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, shader_binding::GGXSampler, ibl.ggx_sampler());
+    graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, shader_binding::LambertSampler, ibl.lambert_sampler());
     switch (filteringMode)
     {
         case FilteringMode::Nearest:
-            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, "s_texture_sampler", m_NearestSampler);
+            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, shader_binding::TextureSampler, m_NearestSampler);
             break;
         case FilteringMode::Linear:
-            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, "s_texture_sampler", m_LinearSampler);
+            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, shader_binding::TextureSampler, m_LinearSampler);
             break;
         case FilteringMode::Anisotropic:
-            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, "s_texture_sampler", m_AnisoSampler);
+            graphics::command_buffer::set_compute_shader_sampler(cmdB, m_TexturesCS, shader_binding::TextureSampler, m_AnisoSampler);
             break;
     }
 
     // Output buffer
-    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TexturesCS, "_ColorTextureRW", colorTexture);
+    graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_TexturesCS, shader_binding::ColorTextureRW, colorTexture);
 
-    // Dispatch + barrier
+    // Dispatch, the render graph takes care of the barrier with the next pass
     graphics::command_buffer::dispatch_indirect(cmdB, m_TexturesCS, indirectBuffer);
-    graphics::command_buffer::uav_barrier_render_texture(cmdB, colorTexture);
 }
 
 void MaterialRenderer::partial_inference(CommandBuffer cmdB, ComputeShader targetCS, uint32_t indirectOffset, GraphicsBuffer tileBuffer, ConstantBuffer globalCB,
@@ -163,58 +163,57 @@ void MaterialRenderer::partial_inference(CommandBuffer cmdB, ComputeShader targe
     if (targetCS != 0)
     {
         // CBVs
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, targetCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, targetCS, shader_binding::GlobalCB, globalCB);
 
         // Input buffers
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, "_VisibilityBuffer", visilityBuffer);
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, "_ShadowTexture", shadowTexture);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_TileBuffer", tileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_VertexBuffer", vertexBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_IndexBuffer", indexBuffer);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_PreIntegratedFGDTexture", ibl.pre_integrated_fgd());
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_ConvolvedIBLTexture", ibl.convolved_ggx_ibl());
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_IndirectDiffuseTexture", ibl.convolved_lambert_ibl());
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, shader_binding::VisibilityBuffer, visilityBuffer);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, shader_binding::ShadowTexture, shadowTexture);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::TileBuffer, tileBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::VertexBuffer, vertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::IndexBuffer, indexBuffer);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::PreIntegratedFGDTexture, ibl.pre_integrated_fgd());
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::ConvolvedIBLTexture, ibl.convolved_ggx_ibl());
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::IndirectDiffuseTexture, ibl.convolved_lambert_ibl());
 
         // Samplers
-        graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "s_fgd_sampler", ibl.fgd_sampler());
-        graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "s_ggx_sampler", ibl.ggx_sampler());
-        graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "s_lambert_sampler", ibl.lambert_sampler());
+        graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::FGDSampler, ibl.fgd_sampler());
+        graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::GGXSampler, ibl.ggx_sampler());
+        graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::LambertSampler, ibl.lambert_sampler());
 
         // Output buffer
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, "_ColorTextureRW", colorTexture);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, targetCS, shader_binding::ColorTextureRW, colorTexture);
 
         // Latent Space
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS0Texture", gpuNwk.tex0);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS1Texture", gpuNwk.tex1);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS2Texture", gpuNwk.tex2);
-        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, "_LS3Texture", gpuNwk.tex3);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_UVOffsetBuffer", network.uv_offset_buffer());
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS0Texture, gpuNwk.tex0);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS1Texture, gpuNwk.tex1);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS2Texture, gpuNwk.tex2);
+        graphics::command_buffer::set_compute_shader_texture(cmdB, targetCS, shader_binding::LS3Texture, gpuNwk.tex3);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::UVOffsetBuffer, network.uv_offset_buffer());
 
         // Samplers
         switch (filteringMode)
         {
             case FilteringMode::Nearest:
-                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "bc1_linear_clamp_sampler", m_NearestSampler);
+                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::BC1LinearClampSampler, m_NearestSampler);
                 break;
             case FilteringMode::Linear:
-                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "bc1_linear_clamp_sampler", m_LinearSampler);
+                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::BC1LinearClampSampler, m_LinearSampler);
                 break;
             case FilteringMode::Anisotropic:
-                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, "bc1_linear_clamp_sampler", m_AnisoSampler);
+                graphics::command_buffer::set_compute_shader_sampler(cmdB, targetCS, shader_binding::BC1LinearClampSampler, m_AnisoSampler);
                 break;
         }
 
         // MLPs
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPWeight0Buffer", useCooperativeVectors ? gpuNwk.mlp.weight0OptimalBuffer : gpuNwk.mlp.weight0Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPBias0Buffer", gpuNwk.mlp.bias0Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPWeight1Buffer", useCooperativeVectors ? gpuNwk.mlp.weight1OptimalBuffer : gpuNwk.mlp.weight1Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPBias1Buffer", gpuNwk.mlp.bias1Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPWeight2Buffer", useCooperativeVectors ? gpuNwk.mlp.weight2OptimalBuffer : gpuNwk.mlp.weight2Buffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, "_MLPBias2Buffer", gpuNwk.mlp.bias2Buffer);
-
-        // Dispatch + barrier
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPWeight0Buffer, useCooperativeVectors ? gpuNwk.mlp.weight0OptimalBuffer : gpuNwk.mlp.weight0Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPBias0Buffer, gpuNwk.mlp.bias0Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPWeight1Buffer, useCooperativeVectors ? gpuNwk.mlp.weight1OptimalBuffer : gpuNwk.mlp.weight1Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPBias1Buffer, gpuNwk.mlp.bias1Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPWeight2Buffer, useCooperativeVectors ? gpuNwk.mlp.weight2OptimalBuffer : gpuNwk.mlp.weight2Buffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, targetCS, shader_binding::MLPBias2Buffer, gpuNwk.mlp.bias2Buffer);
+
+        // Dispatch
         graphics::command_buffer::dispatch_indirect(cmdB, targetCS, classifier.indirect_buffer(), indirectOffset);
-        graphics::command_buffer::uav_barrier_render_texture(cmdB, colorTexture);
     }
 }
 
@@ -228,6 +227,8 @@ void MaterialRenderer::evaluate_neural_cmp_indirect(CommandBuffer cmdB, Constant
     partial_inference(cmdB, uniformTileCS, 3 * sizeof(uint32_t), classifier.uniform_tiles_buffer(), globalCB, network, vertexBuffer, indexBuffer, ibl, useCooperativeVectors, filteringMode, visilityBuffer, shadowTexture, classifier, colorTexture);
     graphics::command_buffer::end_section(cmdB);
 
+    // Both kernels write the color texture, the barrier after the second one is derived by the render graph
+    graphics::command_buffer::uav_barrier_render_texture(cmdB, colorTexture);
 
     // Pick the right kernel
     ComputeShader repackedTilesCS = useCooperativeVectors ? m_CVBC1_Repacked_CS : m_FMABC1_Repacked_CS;
@@ -9,9 +9,17 @@
 #include "render_pipeline/skinned_mesh_renderer.h"
 #include "graphics/backend.h"
 #include "math/operators.h"
+#include "tools/security.h"
 #include "tools/shader_utils.h"
 #include "tools/dirent.h"
 #include "imgui/imgui.h"
+#include "render_pipeline/shader_bindings.h"
+
+// Frames kept in video memory: the current one, the next one and a prefetched one
+#define SKINNED_MESH_RESIDENT_FRAMES 3
+
+// Updates that can be in flight on the GPU (frames in flight of DinoRenderer + 1), each of them has its own staging buffer
+#define SKINNED_MESH_UPLOAD_LATENCY 3
 
 SkinnedMeshRenderer::SkinnedMeshRenderer()
 {
@@ -26,24 +34,54 @@ void SkinnedMeshRenderer::initialize(GraphicsDevice device, const std::string& m
     //Keep track of the device
 	m_Device = device;
 
-    // Import the animation
-    mesh::import_mesh_animation(modelName.c_str(), m_AnimMesh);
+    // Open the animation, the frames are read when needed
+    if (!m_AnimStream.initialize(modelName, SKINNED_MESH_RESIDENT_FRAMES))
+        assert_fail_msg("Failed to open the mesh animation.");
+    m_Quantized = m_AnimStream.quantized();
+    m_NumFrames = m_AnimStream.num_frames();
+    m_NumTriangles = (uint32_t)m_AnimStream.index_buffer().size();
+    m_NumVertices = m_AnimStream.num_vertices();
 
     // Set up the animation data
-    m_NumFrames = (uint32_t)m_AnimMesh.vertexBufferArray.size();
-    m_NumTriangles = (uint32_t)m_AnimMesh.indexBuffer.size();
-    m_NumVertices = (uint32_t)m_AnimMesh.vertexBufferArray[0].data.size();
-    m_AnimVertexBuffer.resize(m_NumFrames);
     m_ActiveAnimation = false;
     m_AnimationSpeed = 0.0;
 
-    // Allocate the runtime buffers
+    // Allocate the runtime buffers, the memory doesn't depend on the number of frames
     m_AnimIndexBuffer = graphics::resources::create_graphics_buffer(m_Device, m_NumTriangles * sizeof(uint3), sizeof(uint32_t), GraphicsBufferType::Default);
-    for (uint32_t idx = 0; idx < m_NumFrames; ++idx)
-        m_AnimVertexBuffer[idx] = graphics::resources::create_graphics_buffer(m_Device, m_NumVertices * sizeof(VertexData), sizeof(VertexData), GraphicsBufferType::Default);
+    const uint32_t frameVertexSize = m_AnimStream.vertex_size();
+    const uint64_t frameSize = (uint64_t)m_NumVertices * frameVertexSize;
+    m_AnimVertexBuffer.resize(m_AnimStream.num_slots());
+    m_ResidentFrames.assign(m_AnimStream.num_slots(), UINT32_MAX);
+    for (uint32_t idx = 0; idx < m_AnimStream.num_slots(); ++idx)
+        m_AnimVertexBuffer[idx] = graphics::resources::create_graphics_buffer(m_Device, frameSize, frameVertexSize, GraphicsBufferType::Default);
+    m_UploadBuffers.resize(SKINNED_MESH_UPLOAD_LATENCY);
+    for (uint32_t idx = 0; idx < SKINNED_MESH_UPLOAD_LATENCY; ++idx)
+        m_UploadBuffers[idx] = graphics::resources::create_graphics_buffer(m_Device, frameSize * m_AnimStream.num_slots(), frameVertexSize, GraphicsBufferType::Upload);
+    m_UpdateIndex = 0;
+    if (m_Quantized)
+    {
+        m_SharedVertexBuffer = graphics::resources::create_graphics_buffer(m_Device, m_NumVertices * sizeof(SharedVertexData), sizeof(SharedVertexData), GraphicsBufferType::Default);
+
+        // Dequantization of the positions, same as dequantize_frame
+        const float3& boundsMin = m_AnimStream.bounds_min();
+        const float3& boundsExtent = m_AnimStream.bounds_extent();
+        float4 quantizationData[2] = { { boundsMin.x, boundsMin.y, boundsMin.z, 0.0f },
+            { boundsExtent.x / 65535.0f, boundsExtent.y / 65535.0f, boundsExtent.z / 65535.0f, 0.0f } };
+        m_QuantizationCB = graphics::resources::create_constant_buffer(m_Device, sizeof(quantizationData), ConstantBufferType::Static);
+        graphics::resources::set_constant_buffer(m_QuantizationCB, (const char*)quantizationData, sizeof(quantizationData));
+    }
     m_SkinnedVertexBuffer = graphics::resources::create_graphics_buffer(m_Device, m_NumVertices * sizeof(VertexData), sizeof(VertexData), GraphicsBufferType::Default);
     m_DisplacementBuffer = graphics::resources::create_graphics_buffer(m_Device, 4 * sizeof(float), sizeof(float), GraphicsBufferType::Default);
 
+    // Meshlets, the bounds are refitted on the GPU every frame and the visible primitives are drawn indirectly
+    build_meshlets();
+    m_MeshletBuffer = graphics::resources::create_graphics_buffer(m_Device, m_NumMeshlets * sizeof(Meshlet), sizeof(uint4), GraphicsBufferType::Default);
+    m_MeshletVertexBuffer = graphics::resources::create_graphics_buffer(m_Device, m_Meshlets.vertices.size() * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
+    m_MeshletTriangleBuffer = graphics::resources::create_graphics_buffer(m_Device, m_Meshlets.triangles.size() * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
+    m_MeshletBoundsBuffer = graphics::resources::create_graphics_buffer(m_Device, m_NumMeshlets * sizeof(MeshletBounds), sizeof(float4), GraphicsBufferType::Default);
+    m_VisibleTriangleBuffer = graphics::resources::create_graphics_buffer(m_Device, m_NumTriangles * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
+    m_IndirectDrawBuffer = graphics::resources::create_graphics_buffer(m_Device, 4 * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default, (uint32_t)GraphicsBufferFlags::Indirect);
+
     // Ray tracing data
     m_BLAS = graphics::resources::create_blas(m_Device, m_SkinnedVertexBuffer, m_NumVertices, m_AnimIndexBuffer, m_NumTriangles, sizeof(VertexData));
     m_TLAS = graphics::resources::create_tlas(m_Device, 1);
@@ -57,13 +95,35 @@ void SkinnedMeshRenderer::release()
     graphics::resources::destroy_graphics_buffer(m_AnimIndexBuffer);
     graphics::resources::destroy_graphics_buffer(m_SkinnedVertexBuffer);
     graphics::resources::destroy_graphics_buffer(m_DisplacementBuffer);
-    for (uint32_t idx = 0; idx < m_NumFrames; ++idx)
+    graphics::resources::destroy_graphics_buffer(m_MeshletBuffer);
+    graphics::resources::destroy_graphics_buffer(m_MeshletVertexBuffer);
+    graphics::resources::destroy_graphics_buffer(m_MeshletTriangleBuffer);
+    graphics::resources::destroy_graphics_buffer(m_MeshletBoundsBuffer);
+    graphics::resources::destroy_graphics_buffer(m_VisibleTriangleBuffer);
+    graphics::resources::destroy_graphics_buffer(m_IndirectDrawBuffer);
+    if (m_Quantized)
+    {
+        graphics::resources::destroy_graphics_buffer(m_SharedVertexBuffer);
+        graphics::resources::destroy_constant_buffer(m_QuantizationCB);
+    }
+    for (uint32_t idx = 0; idx < (uint32_t)m_AnimVertexBuffer.size(); ++idx)
         graphics::resources::destroy_graphics_buffer(m_AnimVertexBuffer[idx]);
+    for (uint32_t idx = 0; idx < (uint32_t)m_UploadBuffers.size(); ++idx)
+        graphics::resources::destroy_graphics_buffer(m_UploadBuffers[idx]);
+    m_AnimVertexBuffer.clear();
+    m_UploadBuffers.clear();
+
+    // Animation
+    m_AnimStream.release();
 
     // Shaders
     graphics::compute_shader::destroy_compute_shader(m_SkinCS);
     graphics::compute_shader::destroy_compute_shader(m_DisplEvalCS);
+    graphics::compute_shader::destroy_compute_shader(m_MeshletBoundsCS);
+    graphics::compute_shader::destroy_compute_shader(m_MeshletResetCS);
+    graphics::compute_shader::destroy_compute_shader(m_MeshletCullingCS);
     graphics::graphics_pipeline::destroy_graphics_pipeline(m_VisibilityPassGP);
+    graphics::graphics_pipeline::destroy_graphics_pipeline(m_VisibilityPassCulledGP);
 
     // Ray tracing data
     graphics::resources::destroy_blas(m_BLAS);
@@ -71,14 +131,16 @@ void SkinnedMeshRenderer::release()
 }
 
 // Resource loading
-void SkinnedMeshRenderer::reload_shaders(const std::string& shaderLibrary)
+void SkinnedMeshRenderer::reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch)
 {
     // Skinning
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Mesh\\SkinMesh.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_SkinCS);
+        if (m_Quantized)
+            csd.defines.push_back("QUANTIZED_VERTICES");
+        batch.add_compute_shader(csd, m_SkinCS);
     }
 
     // Displacement evaluation
@@ -86,10 +148,29 @@ void SkinnedMeshRenderer::reload_shaders(const std::string& shaderLibrary)
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Mesh\\DisplacementEvaluation.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_DisplEvalCS);
+        batch.add_compute_shader(csd, m_DisplEvalCS);
+    }
+
+    // Meshlet bounds
+    {
+        ComputeShaderDescriptor csd;
+        csd.includeDirectories.push_back(shaderLibrary);
+        csd.filename = shaderLibrary + "\\Mesh\\MeshletBounds.compute";
+        batch.add_compute_shader(csd, m_MeshletBoundsCS);
     }
 
-    // Visibility pass
+    // Meshlet culling
+    {
+        ComputeShaderDescriptor csd;
+        csd.includeDirectories.push_back(shaderLibrary);
+        csd.filename = shaderLibrary + "\\Mesh\\MeshletCulling.compute";
+        csd.kernelname = "reset";
+        batch.add_compute_shader(csd, m_MeshletResetCS);
+        csd.kernelname = "main";
+        batch.add_compute_shader(csd, m_MeshletCullingCS);
+    }
+
+    // Visibility pass, over every primitive or over the ones that survived the meshlet culling
     {
         GraphicsPipelineDescriptor gpd;
         gpd.includeDirectories.push_back(shaderLibrary);
@@ -100,7 +181,9 @@ void SkinnedMeshRenderer::reload_shaders(const std::string& shaderLibrary)
         gpd.depthStencilState.depthWrite = true;
         gpd.depthStencilState.depthStencilFormat = TextureFormat::Depth32Stencil8;
         gpd.cullMode = CullMode::Back;
-        compile_and_replace_graphics_pipeline(m_Device, gpd, m_VisibilityPassGP);
+        batch.add_graphics_pipeline(gpd, m_VisibilityPassGP);
+        gpd.defines.push_back("MESHLET_CULLING");
+        batch.add_graphics_pipeline(gpd, m_VisibilityPassCulledGP);
     }
 }
 
@@ -121,11 +204,11 @@ void upload_index_buffer(GraphicsDevice device, CommandQueue cmdQ, CommandBuffer
     graphics::resources::destroy_graphics_buffer(indexBufferUp);
 }
 
-void upload_vertex_buffer(GraphicsDevice device, CommandQueue cmdQ, CommandBuffer cmdB, const std::vector<VertexData>& vertexBufferData, GraphicsBuffer vertexBuffer)
+void upload_vertex_buffer(GraphicsDevice device, CommandQueue cmdQ, CommandBuffer cmdB, const void* vertexBufferData, uint64_t bufferSize, uint32_t vertexSize, GraphicsBuffer vertexBuffer)
 {
     // Create the upload vertex buffer
-    GraphicsBuffer vertexBufferUp = graphics::resources::create_graphics_buffer(device, vertexBufferData.size() * sizeof(VertexData), sizeof(VertexData), GraphicsBufferType::Upload);
-    graphics::resources::set_buffer_data(vertexBufferUp, (char*)vertexBufferData.data(), vertexBufferData.size() * sizeof(VertexData));
+    GraphicsBuffer vertexBufferUp = graphics::resources::create_graphics_buffer(device, bufferSize, vertexSize, GraphicsBufferType::Upload);
+    graphics::resources::set_buffer_data(vertexBufferUp, (char*)vertexBufferData, bufferSize);
 
     // Reset the command buffer
     graphics::command_buffer::reset(cmdB);
@@ -141,14 +224,81 @@ void upload_vertex_buffer(GraphicsDevice device, CommandQueue cmdQ, CommandBuffe
     graphics::resources::destroy_graphics_buffer(vertexBufferUp);
 }
 
+template<typename T>
+void upload_vertex_buffer(GraphicsDevice device, CommandQueue cmdQ, CommandBuffer cmdB, const std::vector<T>& vertexBufferData, GraphicsBuffer vertexBuffer)
+{
+    upload_vertex_buffer(device, cmdQ, cmdB, vertexBufferData.data(), vertexBufferData.size() * sizeof(T), sizeof(T), vertexBuffer);
+}
+
 void SkinnedMeshRenderer::upload_geometry(CommandQueue cmdQ, CommandBuffer cmdB)
 {
     // Upload index buffers
-    upload_index_buffer(m_Device, cmdQ, cmdB, m_AnimMesh.indexBuffer, m_AnimIndexBuffer);
+    upload_index_buffer(m_Device, cmdQ, cmdB, m_AnimStream.index_buffer(), m_AnimIndexBuffer);
+
+    // Upload the attributes shared by the quantized frames, the frames are streamed by update_mesh
+    if (m_Quantized)
+        upload_vertex_buffer(m_Device, cmdQ, cmdB, m_AnimStream.shared_vertices(), m_SharedVertexBuffer);
+
+    // Upload the meshlets, only their bounds change with the animation
+    upload_vertex_buffer(m_Device, cmdQ, cmdB, m_Meshlets.meshlets, m_MeshletBuffer);
+    upload_vertex_buffer(m_Device, cmdQ, cmdB, m_Meshlets.vertices, m_MeshletVertexBuffer);
+    upload_vertex_buffer(m_Device, cmdQ, cmdB, m_Meshlets.triangles, m_MeshletTriangleBuffer);
+}
+
+void SkinnedMeshRenderer::build_meshlets()
+{
+    // Positions of the first frame, quantized or not
+    m_AnimStream.request(0);
+    const char* frameData = m_AnimStream.acquire(0);
+    std::vector<float3> positions(m_NumVertices);
+    const float3& boundsMin = m_AnimStream.bounds_min();
+    const float3& boundsExtent = m_AnimStream.bounds_extent();
+    for (uint32_t vertIdx = 0; vertIdx < m_NumVertices; ++vertIdx)
+    {
+        if (m_Quantized)
+        {
+            QuantizedVertexData vertex;
+            memcpy(&vertex, frameData + (size_t)vertIdx * sizeof(QuantizedVertexData), sizeof(QuantizedVertexData));
+            positions[vertIdx] = boundsMin + boundsExtent * float3({ vertex.position[0] / 65535.0f, vertex.position[1] / 65535.0f, vertex.position[2] / 65535.0f });
+        }
+        else
+            memcpy(&positions[vertIdx], frameData + (size_t)vertIdx * sizeof(VertexData) + offsetof(VertexData, position), sizeof(float3));
+    }
 
-    // Upload all the vertex buffers
-    for (uint32_t idx = 0; idx < m_NumFrames; ++idx)
-        upload_vertex_buffer(m_Device, cmdQ, cmdB, m_AnimMesh.vertexBufferArray[idx].data, m_AnimVertexBuffer[idx]);
+    // The primitive IDs are kept, the index buffer doesn't change
+    meshlet::build(m_AnimStream.index_buffer(), positions, m_Meshlets);
+    m_NumMeshlets = (uint32_t)m_Meshlets.meshlets.size();
+}
+
+uint32_t SkinnedMeshRenderer::make_resident(CommandBuffer cmdB, uint32_t frameIdx, bool wait, uint32_t& numUploads)
+{
+    // Already in video memory
+    const uint32_t numSlots = (uint32_t)m_ResidentFrames.size();
+    for (uint32_t slotIdx = 0; slotIdx < numSlots; ++slotIdx)
+    {
+        if (m_ResidentFrames[slotIdx] == frameIdx)
+            return slotIdx;
+    }
+
+    // The prefetched frames are only uploaded once the loader has them
+    const char* frameData = wait ? m_AnimStream.acquire(frameIdx) : m_AnimStream.try_acquire(frameIdx);
+    if (frameData == nullptr)
+        return UINT32_MAX;
+
+    // Replace a frame that left the window of the stream
+    const uint32_t keyFrame = current_animation_frame();
+    uint32_t slotIdx = 0;
+    while (m_ResidentFrames[slotIdx] != UINT32_MAX && (m_ResidentFrames[slotIdx] + m_NumFrames - keyFrame) % m_NumFrames < numSlots)
+        slotIdx++;
+    m_ResidentFrames[slotIdx] = frameIdx;
+
+    // Stage and copy
+    const uint64_t frameSize = (uint64_t)m_NumVertices * m_AnimStream.vertex_size();
+    GraphicsBuffer uploadBuffer = m_UploadBuffers[m_UpdateIndex % SKINNED_MESH_UPLOAD_LATENCY];
+    graphics::resources::set_buffer_data(uploadBuffer, frameData, frameSize, (uint32_t)(numUploads * frameSize));
+    graphics::command_buffer::copy_graphics_buffer(cmdB, uploadBuffer, (uint32_t)(numUploads * frameSize), m_AnimVertexBuffer[slotIdx], 0, frameSize);
+    numUploads++;
+    return slotIdx;
 }
 
 void SkinnedMeshRenderer::update_mesh(CommandBuffer cmdB, ConstantBuffer globalCB)
@@ -157,33 +307,63 @@ void SkinnedMeshRenderer::update_mesh(CommandBuffer cmdB, ConstantBuffer globalC
     uint32_t keyFrame = current_animation_frame();
     uint32_t nextFrame = next_animation_frame();
 
+    // Stream the frames, the loader runs ahead of the current one
+    m_AnimStream.request(keyFrame);
+    uint32_t numUploads = 0;
+    uint32_t keySlot = make_resident(cmdB, keyFrame, true, numUploads);
+    uint32_t nextSlot = make_resident(cmdB, nextFrame, true, numUploads);
+    for (uint32_t offset = 2; offset < (uint32_t)m_ResidentFrames.size(); ++offset)
+        make_resident(cmdB, (keyFrame + offset) % m_NumFrames, false, numUploads);
+    m_UpdateIndex++;
+
     // Skinning
     {
         // Constant buffers
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_SkinCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_SkinCS, shader_binding::GlobalCB, globalCB);
+        if (m_Quantized)
+            graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_SkinCS, shader_binding::QuantizationCB, m_QuantizationCB);
 
         // Input buffers
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, "_VertexBufferA", m_AnimVertexBuffer[keyFrame]);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, "_VertexBufferB", m_AnimVertexBuffer[nextFrame]);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, shader_binding::VertexBufferA, m_AnimVertexBuffer[keySlot]);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, shader_binding::VertexBufferB, m_AnimVertexBuffer[nextSlot]);
+        if (m_Quantized)
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, shader_binding::SharedVertexBuffer, m_SharedVertexBuffer);
 
         // Output buffers
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, "_VertexBufferRW", m_SkinnedVertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SkinCS, shader_binding::VertexBufferRW, m_SkinnedVertexBuffer);
 
         // Dispatch + Barrier
         graphics::command_buffer::dispatch(cmdB, m_SkinCS, (m_NumVertices + 31) / 32, 1, 1);
         graphics::command_buffer::uav_barrier_buffer(cmdB, m_SkinnedVertexBuffer);
     }
 
+    // Meshlet bounds of the skinned vertices
+    {
+        // Input buffers
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletBoundsCS, shader_binding::VertexBuffer, m_SkinnedVertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletBoundsCS, shader_binding::IndexBuffer, m_AnimIndexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletBoundsCS, shader_binding::MeshletBuffer, m_MeshletBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletBoundsCS, shader_binding::MeshletVertexBuffer, m_MeshletVertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletBoundsCS, shader_binding::MeshletTriangleBuffer, m_MeshletTriangleBuffer);
+
+        // Output buffers
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletBoundsCS, shader_binding::MeshletBoundsBufferRW, m_MeshletBoundsBuffer);
+
+        // Dispatch + Barrier
+        graphics::command_buffer::dispatch(cmdB, m_MeshletBoundsCS, m_NumMeshlets, 1, 1);
+        graphics::command_buffer::uav_barrier_buffer(cmdB, m_MeshletBoundsBuffer);
+    }
+
     // Displacement Eval
     {
         // Constant buffers
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_DisplEvalCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_DisplEvalCS, shader_binding::GlobalCB, globalCB);
 
         // Input buffers
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DisplEvalCS, "_SkinnedVertexBuffer", m_SkinnedVertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DisplEvalCS, shader_binding::SkinnedVertexBuffer, m_SkinnedVertexBuffer);
 
         // Output buffers
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DisplEvalCS, "_DisplacementBuffer", m_DisplacementBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_DisplEvalCS, shader_binding::DisplacementBuffer, m_DisplacementBuffer);
 
         // Dispatch + Barrier
         graphics::command_buffer::dispatch(cmdB, m_DisplEvalCS, 1, 1, 1);
@@ -197,20 +377,58 @@ void SkinnedMeshRenderer::update_mesh(CommandBuffer cmdB, ConstantBuffer globalC
 
 void SkinnedMeshRenderer::render_mesh(CommandBuffer cmdB, ConstantBuffer globalCB, RenderTexture colorBuffer, RenderTexture depthBuffer)
 {
+    // Frustum and back face culling of the meshlets for the camera of the frame
+    if (m_MeshletCulling)
+    {
+        graphics::command_buffer::start_section(cmdB, "Meshlet Culling");
+        {
+            // Empty the draw
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletResetCS, shader_binding::IndirectDrawBufferRW, m_IndirectDrawBuffer);
+            graphics::command_buffer::dispatch(cmdB, m_MeshletResetCS, 1, 1, 1);
+            graphics::command_buffer::uav_barrier_buffer(cmdB, m_IndirectDrawBuffer);
+
+            // Constant buffers
+            graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_MeshletCullingCS, shader_binding::GlobalCB, globalCB);
+
+            // Input buffers
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletCullingCS, shader_binding::MeshletBuffer, m_MeshletBuffer);
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletCullingCS, shader_binding::MeshletTriangleBuffer, m_MeshletTriangleBuffer);
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletCullingCS, shader_binding::MeshletBoundsBuffer, m_MeshletBoundsBuffer);
+
+            // Output buffers
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletCullingCS, shader_binding::IndirectDrawBufferRW, m_IndirectDrawBuffer);
+            graphics::command_buffer::set_compute_shader_buffer(cmdB, m_MeshletCullingCS, shader_binding::VisibleTriangleBufferRW, m_VisibleTriangleBuffer);
+
+            // Dispatch + Barrier
+            graphics::command_buffer::dispatch(cmdB, m_MeshletCullingCS, m_NumMeshlets, 1, 1);
+            graphics::command_buffer::uav_barrier_buffer(cmdB, m_IndirectDrawBuffer);
+            graphics::command_buffer::uav_barrier_buffer(cmdB, m_VisibleTriangleBuffer);
+        }
+        graphics::command_buffer::end_section(cmdB);
+    }
+
     graphics::command_buffer::start_section(cmdB, "Visibility Buffer Pass");
     {
+        GraphicsPipeline visibilityGP = m_MeshletCulling ? m_VisibilityPassCulledGP : m_VisibilityPassGP;
+
         // Render Target
         graphics::command_buffer::set_render_texture(cmdB, colorBuffer, depthBuffer);
 
         // Constant buffers
-        graphics::command_buffer::set_graphics_pipeline_cbuffer(cmdB, m_VisibilityPassGP, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_graphics_pipeline_cbuffer(cmdB, visibilityGP, shader_binding::GlobalCB, globalCB);
 
         // Input buffers
-        graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, m_VisibilityPassGP, "_VertexBuffer", m_SkinnedVertexBuffer);
-        graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, m_VisibilityPassGP, "_IndexBuffer", m_AnimIndexBuffer);
+        graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, visibilityGP, shader_binding::VertexBuffer, m_SkinnedVertexBuffer);
+        graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, visibilityGP, shader_binding::IndexBuffer, m_AnimIndexBuffer);
 
         // Draw
-        graphics::command_buffer::draw_procedural(cmdB, m_VisibilityPassGP, m_NumTriangles, 1);
+        if (m_MeshletCulling)
+        {
+            graphics::command_buffer::set_graphics_pipeline_buffer(cmdB, visibilityGP, shader_binding::VisibleTriangleBuffer, m_VisibleTriangleBuffer);
+            graphics::command_buffer::draw_procedural_indirect(cmdB, visibilityGP, m_IndirectDrawBuffer);
+        }
+        else
+            graphics::command_buffer::draw_procedural(cmdB, visibilityGP, m_NumTriangles, 1);
     }
     graphics::command_buffer::end_section(cmdB);
 }
@@ -259,6 +477,12 @@ GraphicsBuffer SkinnedMeshRenderer::index_buffer() const
     return m_AnimIndexBuffer;
 }
 
+uint32_t SkinnedMeshRenderer::material_id(uint32_t primitiveID) const
+{
+    // Same as mat_id, the material doesn't change with the animation
+    return m_AnimStream.shared_vertices()[m_AnimStream.index_buffer()[primitiveID].x].matID;
+}
+
 uint32_t SkinnedMeshRenderer::current_animation_frame() const
 {
     return uint32_t(m_CurrentTime * m_NumFrames) % m_NumFrames;
@@ -295,4 +519,5 @@ void SkinnedMeshRenderer::render_ui()
     float enthusiasm = 1.0f - (m_Duration - 0.5f) / 2.5f;
     ImGui::SliderFloat("Enthusiasm", &enthusiasm, 0.0f, 1.0f);
     m_Duration = lerp(0.5f, 3.0f, 1.0f - enthusiasm);
+    ImGui::Checkbox("Meshlet culling", &m_MeshletCulling);
 }
\ No newline at end of file
@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/software_rasterizer.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <algorithm>
+#include <math.h>
+#if defined(_M_X64) || defined(__SSE2__)
+#define SOFTWARE_RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+// Distance in pixels beyond the screen before the triangles are clipped, keeps the edge functions in range
+#define SOFTWARE_RASTER_GUARD_BAND 8192.0f
+
+// Same as pack_visibility_buffer
+#define PACK_VISIBILITY(primitiveID) (((primitiveID) & 0x7FFFFFFF) | 0x80000000)
+
+// A triangle clipped by the 5 planes has at most 8 vertices
+#define MAX_CLIPPED_VERTICES 8
+
+// Signed distances to the near plane and to the guard band planes, positive inside
+static float clip_distance(const float4& position, uint32_t planeIdx, const float2& guardBand)
+{
+    switch (planeIdx)
+    {
+        case 0:
+            return position.z;
+        case 1:
+            return guardBand.x * position.w - position.x;
+        case 2:
+            return guardBand.x * position.w + position.x;
+        case 3:
+            return guardBand.y * position.w - position.y;
+        default:
+            return guardBand.y * position.w + position.y;
+    }
+}
+
+// Sutherland-Hodgman against the planes, returns the number of vertices of the polygon
+static uint32_t clip_triangle(const float4* triangle, const float2& guardBand, float4* polygon)
+{
+    float4 buffer[MAX_CLIPPED_VERTICES];
+    float4* input = buffer;
+    float4* output = polygon;
+    uint32_t numVertices = 3;
+    input[0] = triangle[0];
+    input[1] = triangle[1];
+    input[2] = triangle[2];
+    for (uint32_t planeIdx = 0; planeIdx < 5 && numVertices > 0; ++planeIdx)
+    {
+        uint32_t numOutput = 0;
+        for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+        {
+            const float4& current = input[vertIdx];
+            const float4& next = input[(vertIdx + 1) % numVertices];
+            float currentDistance = clip_distance(current, planeIdx, guardBand);
+            float nextDistance = clip_distance(next, planeIdx, guardBand);
+            if (currentDistance >= 0.0f)
+                output[numOutput++] = current;
+            if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+                output[numOutput++] = lerp(current, next, currentDistance / (currentDistance - nextDistance));
+        }
+        numVertices = numOutput;
+        std::swap(input, output);
+    }
+
+    // The last pass may have written in the local buffer
+    if (input != polygon)
+        std::copy(input, input + numVertices, polygon);
+    return numVertices;
+}
+
+static bool inside_guard_band(const float4& position, const float2& guardBand)
+{
+    for (uint32_t planeIdx = 0; planeIdx < 5; ++planeIdx)
+    {
+        if (clip_distance(position, planeIdx, guardBand) < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+// Snaps the vertices and builds the edge functions, false if the triangle is culled or covers no pixel center
+static bool setup_triangle(const float4* clipPositions, uint32_t width, uint32_t height, uint32_t visibility, RasterTriangle& triangle)
+{
+    const float subPixelScale = (float)(1 << SOFTWARE_RASTER_SUBPIXEL_BITS);
+    int64_t posX[3], posY[3];
+    double depth[3];
+    for (uint32_t vertIdx = 0; vertIdx < 3; ++vertIdx)
+    {
+        const float4& position = clipPositions[vertIdx];
+        float invW = 1.0f / position.w;
+        float screenX = (position.x * invW * 0.5f + 0.5f) * width;
+        float screenY = (0.5f - position.y * invW * 0.5f) * height;
+        posX[vertIdx] = (int64_t)floorf(screenX * subPixelScale + 0.5f);
+        posY[vertIdx] = (int64_t)floorf(screenY * subPixelScale + 0.5f);
+        depth[vertIdx] = position.z * invW;
+    }
+
+    // Front faces are counter clockwise on the render target (FrontCounterClockwise), their area is negative with y down.
+    // Swap two vertices so that the edge functions are positive inside.
+    int64_t area = (posX[1] - posX[0]) * (posY[2] - posY[0]) - (posX[2] - posX[0]) * (posY[1] - posY[0]);
+    if (area >= 0)
+        return false;
+    std::swap(posX[1], posX[2]);
+    std::swap(posY[1], posY[2]);
+    std::swap(depth[1], depth[2]);
+    area = -area;
+
+    // Pixels whose center is in the bounding box
+    const int64_t halfPixel = 1 << (SOFTWARE_RASTER_SUBPIXEL_BITS - 1);
+    const int64_t pixelSize = 1 << SOFTWARE_RASTER_SUBPIXEL_BITS;
+    int64_t minX = (std::min(std::min(posX[0], posX[1]), posX[2]) - halfPixel + pixelSize - 1) >> SOFTWARE_RASTER_SUBPIXEL_BITS;
+    int64_t minY = (std::min(std::min(posY[0], posY[1]), posY[2]) - halfPixel + pixelSize - 1) >> SOFTWARE_RASTER_SUBPIXEL_BITS;
+    int64_t maxX = (std::max(std::max(posX[0], posX[1]), posX[2]) - halfPixel) >> SOFTWARE_RASTER_SUBPIXEL_BITS;
+    int64_t maxY = (std::max(std::max(posY[0], posY[1]), posY[2]) - halfPixel) >> SOFTWARE_RASTER_SUBPIXEL_BITS;
+    minX = std::max<int64_t>(minX, 0);
+    minY = std::max<int64_t>(minY, 0);
+    maxX = std::min<int64_t>(maxX, width - 1);
+    maxY = std::min<int64_t>(maxY, height - 1);
+    if (minX > maxX || minY > maxY)
+        return false;
+    triangle.minX = (uint32_t)minX;
+    triangle.minY = (uint32_t)minY;
+    triangle.maxX = (uint32_t)maxX;
+    triangle.maxY = (uint32_t)maxY;
+
+    // Edge k goes from vertex k to vertex k + 1 and is opposite to vertex k + 2
+    triangle.depthOrigin = 0.0;
+    triangle.depthStepX = 0.0;
+    triangle.depthStepY = 0.0;
+    for (uint32_t edgeIdx = 0; edgeIdx < 3; ++edgeIdx)
+    {
+        uint32_t nextIdx = (edgeIdx + 1) % 3;
+        int64_t dx = posX[nextIdx] - posX[edgeIdx];
+        int64_t dy = posY[nextIdx] - posY[edgeIdx];
+        int64_t origin = dx * (halfPixel - posY[edgeIdx]) - dy * (halfPixel - posX[edgeIdx]);
+        int64_t stepX = -dy * pixelSize;
+        int64_t stepY = dx * pixelSize;
+
+        // Barycentric of the opposite vertex
+        double weight = depth[(edgeIdx + 2) % 3] / (double)area;
+        triangle.depthOrigin += origin * weight;
+        triangle.depthStepX += stepX * weight;
+        triangle.depthStepY += stepY * weight;
+
+        // Top-left rule, the pixel centers on a top or left edge are covered
+        bool topLeft = (dy == 0 && dx > 0) || dy < 0;
+        triangle.edgeOrigin[edgeIdx] = origin + (topLeft ? 1 : 0);
+        triangle.edgeStepX[edgeIdx] = (int32_t)stepX;
+        triangle.edgeStepY[edgeIdx] = (int32_t)stepY;
+    }
+    triangle.visibility = visibility;
+    return true;
+}
+
+#if defined(SOFTWARE_RASTER_SSE2)
+// Writes the pixels of a block that pass the coverage and depth test (LEqual), four pixels at a time
+static void rasterize_block(const int32_t* edge, const int32_t* edgeStepX, const int32_t* edgeStepY, float depth, float depthStepX, float depthStepY,
+    uint32_t visibility, uint32_t* visibilityRow, float* depthRow, uint32_t pitch)
+{
+    // Values of the first four pixels of the row and steps to the next four and to the next row
+    __m128i rowEdge[3], halfEdgeStep[3], rowEdgeStep[3];
+    for (uint32_t edgeIdx = 0; edgeIdx < 3; ++edgeIdx)
+    {
+        int32_t step = edgeStepX[edgeIdx];
+        rowEdge[edgeIdx] = _mm_setr_epi32(edge[edgeIdx], edge[edgeIdx] + step, edge[edgeIdx] + 2 * step, edge[edgeIdx] + 3 * step);
+        halfEdgeStep[edgeIdx] = _mm_set1_epi32(4 * step);
+        rowEdgeStep[edgeIdx] = _mm_set1_epi32(edgeStepY[edgeIdx]);
+    }
+    __m128 rowDepth = _mm_setr_ps(depth, depth + depthStepX, depth + 2.0f * depthStepX, depth + 3.0f * depthStepX);
+    const __m128 halfDepthStep = _mm_set1_ps(4.0f * depthStepX);
+    const __m128 rowDepthStep = _mm_set1_ps(depthStepY);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i packedValue = _mm_set1_epi32((int32_t)visibility);
+
+    for (uint32_t localY = 0; localY < SOFTWARE_RASTER_BLOCK_SIZE; ++localY)
+    {
+        __m128i edge0 = rowEdge[0], edge1 = rowEdge[1], edge2 = rowEdge[2];
+        __m128 pixelDepth = rowDepth;
+        for (uint32_t localX = 0; localX < SOFTWARE_RASTER_BLOCK_SIZE; localX += 4)
+        {
+            // Inside the three edges and closer than the current depth
+            __m128i mask = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(edge0, zero), _mm_cmpgt_epi32(edge1, zero)), _mm_cmpgt_epi32(edge2, zero));
+            __m128 currentDepth = _mm_loadu_ps(depthRow + localX);
+            mask = _mm_and_si128(mask, _mm_castps_si128(_mm_cmple_ps(pixelDepth, currentDepth)));
+            if (_mm_movemask_epi8(mask) != 0)
+            {
+                __m128 maskPS = _mm_castsi128_ps(mask);
+                _mm_storeu_ps(depthRow + localX, _mm_or_ps(_mm_and_ps(maskPS, pixelDepth), _mm_andnot_ps(maskPS, currentDepth)));
+                __m128i currentVisibility = _mm_loadu_si128((const __m128i*)(visibilityRow + localX));
+                _mm_storeu_si128((__m128i*)(visibilityRow + localX), _mm_or_si128(_mm_and_si128(mask, packedValue), _mm_andnot_si128(mask, currentVisibility)));
+            }
+            edge0 = _mm_add_epi32(edge0, halfEdgeStep[0]);
+            edge1 = _mm_add_epi32(edge1, halfEdgeStep[1]);
+            edge2 = _mm_add_epi32(edge2, halfEdgeStep[2]);
+            pixelDepth = _mm_add_ps(pixelDepth, halfDepthStep);
+        }
+
+        // Next row
+        for (uint32_t edgeIdx = 0; edgeIdx < 3; ++edgeIdx)
+            rowEdge[edgeIdx] = _mm_add_epi32(rowEdge[edgeIdx], rowEdgeStep[edgeIdx]);
+        rowDepth = _mm_add_ps(rowDepth, rowDepthStep);
+        visibilityRow += pitch;
+        depthRow += pitch;
+    }
+}
+#else
+// Writes the pixels of a block that pass the coverage and depth test (LEqual)
+static void rasterize_block(const int32_t* edge, const int32_t* edgeStepX, const int32_t* edgeStepY, float depth, float depthStepX, float depthStepY,
+    uint32_t visibility, uint32_t* visibilityRow, float* depthRow, uint32_t pitch)
+{
+    for (uint32_t localY = 0; localY < SOFTWARE_RASTER_BLOCK_SIZE; ++localY)
+    {
+        for (uint32_t localX = 0; localX < SOFTWARE_RASTER_BLOCK_SIZE; ++localX)
+        {
+            bool covered = true;
+            for (uint32_t edgeIdx = 0; edgeIdx < 3; ++edgeIdx)
+                covered &= edge[edgeIdx] + (int32_t)localX * edgeStepX[edgeIdx] + (int32_t)localY * edgeStepY[edgeIdx] > 0;
+            float pixelDepth = depth + localX * depthStepX + localY * depthStepY;
+            if (covered && pixelDepth <= depthRow[localX])
+            {
+                depthRow[localX] = pixelDepth;
+                visibilityRow[localX] = visibility;
+            }
+        }
+        visibilityRow += pitch;
+        depthRow += pitch;
+    }
+}
+#endif
+
+SoftwareRasterizer::SoftwareRasterizer()
+{
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+}
+
+void SoftwareRasterizer::initialize(uint32_t width, uint32_t height)
+{
+    m_Width = width;
+    m_Height = height;
+
+    // The targets are padded so that the blocks never need to be clipped to the screen
+    m_BinCountX = (width + SOFTWARE_RASTER_BIN_SIZE - 1) / SOFTWARE_RASTER_BIN_SIZE;
+    m_BinCountY = (height + SOFTWARE_RASTER_BIN_SIZE - 1) / SOFTWARE_RASTER_BIN_SIZE;
+    m_Pitch = m_BinCountX * SOFTWARE_RASTER_BIN_SIZE;
+    m_Visibility.assign((size_t)m_Pitch * m_BinCountY * SOFTWARE_RASTER_BIN_SIZE, SOFTWARE_RASTER_EMPTY_PIXEL);
+    m_Depth.assign(m_Visibility.size(), 1.0f);
+}
+
+void SoftwareRasterizer::release()
+{
+    m_Visibility.clear();
+    m_Depth.clear();
+    m_ClipPositions.clear();
+    m_ChunkTriangles.clear();
+    m_ChunkBins.clear();
+}
+
+void SoftwareRasterizer::render(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor, const float4x4& viewProjection, const float3& cameraPosition)
+{
+    // Skinning and projection of the vertices
+    transform_vertices(animation, frameA, frameB, interpolationFactor, viewProjection, cameraPosition);
+
+    // Setup and binning of the triangles, the chunks keep the primitive order for the depth ties
+    const uint32_t numTriangles = (uint32_t)animation.indexBuffer.size();
+    const uint32_t numChunks = (numTriangles + SOFTWARE_RASTER_CHUNK_SIZE - 1) / SOFTWARE_RASTER_CHUNK_SIZE;
+    const uint32_t numBins = m_BinCountX * m_BinCountY;
+    m_ChunkTriangles.resize(numChunks);
+    m_ChunkBins.resize(numChunks);
+    for (std::vector<std::vector<uint32_t>>& bins : m_ChunkBins)
+        bins.resize(numBins);
+    task_scheduler::parallel_for(0, numChunks, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t chunkIdx = first; chunkIdx < last; ++chunkIdx)
+            setup_chunk(animation, chunkIdx);
+    });
+
+    // Every bin clears and rasterizes its pixels
+    task_scheduler::parallel_for(0, numBins, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t binIdx = first; binIdx < last; ++binIdx)
+            rasterize_bin(binIdx);
+    });
+
+    // Stats
+    m_Stats = SoftwareRasterizerStats();
+    m_Stats.numTriangles = numTriangles;
+    for (uint32_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+    {
+        m_Stats.rasterizedTriangles += (uint32_t)m_ChunkTriangles[chunkIdx].size();
+        for (const std::vector<uint32_t>& bin : m_ChunkBins[chunkIdx])
+            m_Stats.binnedTriangles += (uint32_t)bin.size();
+    }
+}
+
+void SoftwareRasterizer::transform_vertices(const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor, const float4x4& viewProjection, const float3& cameraPosition)
+{
+    const std::vector<VertexData>& verticesA = animation.vertexBufferArray[frameA].data;
+    const std::vector<VertexData>& verticesB = animation.vertexBufferArray[frameB].data;
+    const uint32_t numVertices = (uint32_t)verticesA.size();
+    m_ClipPositions.resize(numVertices);
+    task_scheduler::parallel_for(0, numVertices, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t vertIdx = first; vertIdx < last; ++vertIdx)
+        {
+            // Same interpolation as SkinMesh.compute and same camera relative transform as VisibilityPass.graphics
+            float3 position = lerp(verticesA[vertIdx].position, verticesB[vertIdx].position, interpolationFactor) - cameraPosition;
+            m_ClipPositions[vertIdx] = mul_transpose(viewProjection, float4({ position.x, position.y, position.z, 1.0f }));
+        }
+    }, 1024);
+}
+
+void SoftwareRasterizer::setup_chunk(const MeshAnimation& animation, uint32_t chunkIdx)
+{
+    std::vector<RasterTriangle>& triangles = m_ChunkTriangles[chunkIdx];
+    std::vector<std::vector<uint32_t>>& bins = m_ChunkBins[chunkIdx];
+    triangles.clear();
+    for (std::vector<uint32_t>& bin : bins)
+        bin.clear();
+
+    // Guard band in clip space
+    const float2 guardBand = { 1.0f + 2.0f * SOFTWARE_RASTER_GUARD_BAND / m_Width, 1.0f + 2.0f * SOFTWARE_RASTER_GUARD_BAND / m_Height };
+
+    const uint32_t firstTriangle = chunkIdx * SOFTWARE_RASTER_CHUNK_SIZE;
+    const uint32_t lastTriangle = std::min(firstTriangle + SOFTWARE_RASTER_CHUNK_SIZE, (uint32_t)animation.indexBuffer.size());
+    for (uint32_t primitiveID = firstTriangle; primitiveID < lastTriangle; ++primitiveID)
+    {
+        const uint3& indices = animation.indexBuffer[primitiveID];
+        float4 vertices[3] = { m_ClipPositions[indices.x], m_ClipPositions[indices.y], m_ClipPositions[indices.z] };
+
+        // Trivial rejection against one of the planes
+        bool rejected = false;
+        const float2 unitBand = { 1.0f, 1.0f };
+        for (uint32_t planeIdx = 0; planeIdx < 5 && !rejected; ++planeIdx)
+        {
+            rejected = clip_distance(vertices[0], planeIdx, unitBand) < 0.0f && clip_distance(vertices[1], planeIdx, unitBand) < 0.0f
+                && clip_distance(vertices[2], planeIdx, unitBand) < 0.0f;
+        }
+        if (rejected)
+            continue;
+
+        // Most triangles don't need to be clipped
+        float4 polygon[MAX_CLIPPED_VERTICES];
+        uint32_t numVertices = 3;
+        if (inside_guard_band(vertices[0], guardBand) && inside_guard_band(vertices[1], guardBand) && inside_guard_band(vertices[2], guardBand))
+            std::copy(vertices, vertices + 3, polygon);
+        else
+            numVertices = clip_triangle(vertices, guardBand, polygon);
+
+        // Fan of the clipped polygon, all of its triangles share the primitive ID
+        for (uint32_t fanIdx = 1; fanIdx + 1 < numVertices; ++fanIdx)
+        {
+            const float4 fan[3] = { polygon[0], polygon[fanIdx], polygon[fanIdx + 1] };
+            RasterTriangle triangle;
+            if (!setup_triangle(fan, m_Width, m_Height, PACK_VISIBILITY(primitiveID), triangle))
+                continue;
+
+            // Bins overlapped by the bounding box
+            uint32_t triangleIdx = (uint32_t)triangles.size();
+            triangles.push_back(triangle);
+            for (uint32_t binY = triangle.minY / SOFTWARE_RASTER_BIN_SIZE; binY <= triangle.maxY / SOFTWARE_RASTER_BIN_SIZE; ++binY)
+            {
+                for (uint32_t binX = triangle.minX / SOFTWARE_RASTER_BIN_SIZE; binX <= triangle.maxX / SOFTWARE_RASTER_BIN_SIZE; ++binX)
+                    bins[binX + binY * m_BinCountX].push_back(triangleIdx);
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::rasterize_bin(uint32_t binIdx)
+{
+    const uint32_t binMinX = (binIdx % m_BinCountX) * SOFTWARE_RASTER_BIN_SIZE;
+    const uint32_t binMinY = (binIdx / m_BinCountX) * SOFTWARE_RASTER_BIN_SIZE;
+
+    // Clear, same values as the GPU targets
+    for (uint32_t y = binMinY; y < binMinY + SOFTWARE_RASTER_BIN_SIZE; ++y)
+    {
+        std::fill_n(m_Visibility.begin() + (size_t)y * m_Pitch + binMinX, SOFTWARE_RASTER_BIN_SIZE, SOFTWARE_RASTER_EMPTY_PIXEL);
+        std::fill_n(m_Depth.begin() + (size_t)y * m_Pitch + binMinX, SOFTWARE_RASTER_BIN_SIZE, 1.0f);
+    }
+
+    for (uint32_t chunkIdx = 0; chunkIdx < (uint32_t)m_ChunkTriangles.size(); ++chunkIdx)
+    {
+        const std::vector<RasterTriangle>& triangles = m_ChunkTriangles[chunkIdx];
+        for (uint32_t triangleIdx : m_ChunkBins[chunkIdx][binIdx])
+        {
+            const RasterTriangle& triangle = triangles[triangleIdx];
+
+            // Blocks of the bin that intersect the bounding box
+            const uint32_t blockMask = ~(uint32_t)(SOFTWARE_RASTER_BLOCK_SIZE - 1);
+            const uint32_t firstX = std::max(triangle.minX, binMinX) & blockMask;
+            const uint32_t firstY = std::max(triangle.minY, binMinY) & blockMask;
+            const uint32_t lastX = std::min(triangle.maxX, binMinX + SOFTWARE_RASTER_BIN_SIZE - 1);
+            const uint32_t lastY = std::min(triangle.maxY, binMinY + SOFTWARE_RASTER_BIN_SIZE - 1);
+            for (uint32_t blockY = firstY; blockY <= lastY; blockY += SOFTWARE_RASTER_BLOCK_SIZE)
+            {
+                for (uint32_t blockX = firstX; blockX <= lastX; blockX += SOFTWARE_RASTER_BLOCK_SIZE)
+                {
+                    // Range of every edge function over the block
+                    int32_t edge[3], edgeStepX[3], edgeStepY[3];
+                    bool rejected = false;
+                    for (uint32_t edgeIdx = 0; edgeIdx < 3 && !rejected; ++edgeIdx)
+                    {
+                        const int64_t stepX = triangle.edgeStepX[edgeIdx];
+                        const int64_t stepY = triangle.edgeStepY[edgeIdx];
+                        const int64_t corner = triangle.edgeOrigin[edgeIdx] + stepX * blockX + stepY * blockY;
+                        const int64_t extent = SOFTWARE_RASTER_BLOCK_SIZE - 1;
+                        const int64_t maxValue = corner + std::max<int64_t>(stepX, 0) * extent + std::max<int64_t>(stepY, 0) * extent;
+                        const int64_t minValue = corner + std::min<int64_t>(stepX, 0) * extent + std::min<int64_t>(stepY, 0) * extent;
+                        rejected = maxValue <= 0;
+                        if (minValue > 0)
+                        {
+                            // The whole block is inside this edge
+                            edge[edgeIdx] = 1;
+                            edgeStepX[edgeIdx] = 0;
+                            edgeStepY[edgeIdx] = 0;
+                        }
+                        else
+                        {
+                            // Close to the edge, the values of the block fit in 32 bits
+                            edge[edgeIdx] = (int32_t)corner;
+                            edgeStepX[edgeIdx] = (int32_t)stepX;
+                            edgeStepY[edgeIdx] = (int32_t)stepY;
+                        }
+                    }
+                    if (rejected)
+                        continue;
+
+                    float depth = (float)(triangle.depthOrigin + triangle.depthStepX * blockX + triangle.depthStepY * blockY);
+                    const size_t offset = (size_t)blockY * m_Pitch + blockX;
+                    rasterize_block(edge, edgeStepX, edgeStepY, depth, (float)triangle.depthStepX, (float)triangle.depthStepY,
+                        triangle.visibility, m_Visibility.data() + offset, m_Depth.data() + offset, m_Pitch);
+                }
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::read_visibility_buffer(std::vector<uint32_t>& visibility) const
+{
+    visibility.resize((size_t)m_Width * m_Height);
+    for (uint32_t y = 0; y < m_Height; ++y)
+        std::copy_n(m_Visibility.begin() + (size_t)y * m_Pitch, m_Width, visibility.begin() + (size_t)y * m_Width);
+}
+
+void SoftwareRasterizer::read_depth_buffer(std::vector<float>& depth) const
+{
+    depth.resize((size_t)m_Width * m_Height);
+    for (uint32_t y = 0; y < m_Height; ++y)
+        std::copy_n(m_Depth.begin() + (size_t)y * m_Pitch, m_Width, depth.begin() + (size_t)y * m_Width);
+}
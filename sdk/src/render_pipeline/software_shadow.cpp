@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/software_shadow.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <math.h>
+#include <string.h>
+
+// Same generator as random.hlsl
+static uint32_t hash(uint32_t seed)
+{
+    seed = (seed ^ 61u) ^ (seed >> 16u);
+    seed *= 9u;
+    seed = seed ^ (seed >> 4u);
+    seed *= 0x27d4eb2du;
+    seed = seed ^ (seed >> 15u);
+    return seed;
+}
+
+static uint32_t bit_reverse(uint32_t x)
+{
+    x = ((x & 0x55555555u) << 1u) | ((x & 0xAAAAAAAAu) >> 1u);
+    x = ((x & 0x33333333u) << 2u) | ((x & 0xCCCCCCCCu) >> 2u);
+    x = ((x & 0x0F0F0F0Fu) << 4u) | ((x & 0xF0F0F0F0u) >> 4u);
+    x = ((x & 0x00FF00FFu) << 8u) | ((x & 0xFF00FF00u) >> 8u);
+    x = ((x & 0x0000FFFFu) << 16u) | ((x & 0xFFFF0000u) >> 16u);
+    return x;
+}
+
+static uint32_t dilate(uint32_t x)
+{
+    x = (x | (x << 8)) & 0x00FF00FFu;
+    x = (x | (x << 4)) & 0x0F0F0F0Fu;
+    x = (x | (x << 2)) & 0x33333333u;
+    x = (x | (x << 1)) & 0x55555555u;
+    return x;
+}
+
+static uint32_t bayer_matrix_coefficient(uint32_t i, uint32_t j, uint32_t matrixSize)
+{
+    uint32_t z = dilate(i ^ j) | (dilate(j) << 1);
+    return bit_reverse(z) >> (32 - (matrixSize << 1));
+}
+
+static uint32_t pixel_seed(uint32_t x, uint32_t y)
+{
+    return hash(bayer_matrix_coefficient(x & 255, y & 255, 16));
+}
+
+static float urng(uint32_t& seed)
+{
+    seed = 1664525u * seed + 1013904223u;
+    uint32_t bits = 0x3F800000u | (seed & ((1u << 23) - 1u));
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value - 1.0f;
+}
+
+// Perspective correct barycentrics of calc_full_bary, ndc is evaluated at the corner of the pixel like evaluate_ndc_coordinates
+static float3 pixel_barycentrics(const float3& p0, const float3& p1, const float3& p2, uint32_t x, uint32_t y, const SoftwareShadowView& view)
+{
+    const float4 pt0 = mul_transpose(view.viewProjection, float4({ p0.x - view.cameraPosition.x, p0.y - view.cameraPosition.y, p0.z - view.cameraPosition.z, 1.0f }));
+    const float4 pt1 = mul_transpose(view.viewProjection, float4({ p1.x - view.cameraPosition.x, p1.y - view.cameraPosition.y, p1.z - view.cameraPosition.z, 1.0f }));
+    const float4 pt2 = mul_transpose(view.viewProjection, float4({ p2.x - view.cameraPosition.x, p2.y - view.cameraPosition.y, p2.z - view.cameraPosition.z, 1.0f }));
+    const float3 invW = { 1.0f / pt0.w, 1.0f / pt1.w, 1.0f / pt2.w };
+    const float2 ndc0 = { pt0.x * invW.x, pt0.y * invW.x };
+    const float2 ndc1 = { pt1.x * invW.y, pt1.y * invW.y };
+    const float2 ndc2 = { pt2.x * invW.z, pt2.y * invW.z };
+
+    const float invDet = 1.0f / ((ndc2.x - ndc1.x) * (ndc0.y - ndc1.y) - (ndc2.y - ndc1.y) * (ndc0.x - ndc1.x));
+    const float3 dx = float3({ ndc1.y - ndc2.y, ndc2.y - ndc0.y, ndc0.y - ndc1.y }) * invDet * invW;
+    const float3 dy = float3({ ndc2.x - ndc1.x, ndc0.x - ndc2.x, ndc1.x - ndc0.x }) * invDet * invW;
+
+    const float2 pixelNDC = { x / (float)view.width * 2.0f - 1.0f, -(y / (float)view.height * 2.0f - 1.0f) };
+    const float2 delta = { pixelNDC.x - ndc0.x, pixelNDC.y - ndc0.y };
+    const float interpW = 1.0f / (invW.x + delta.x * (dx.x + dx.y + dx.z) + delta.y * (dy.x + dy.y + dy.z));
+    return { interpW * (invW.x + delta.x * dx.x + delta.y * dy.x), interpW * (delta.x * dx.y + delta.y * dy.y), interpW * (delta.x * dx.z + delta.y * dy.z) };
+}
+
+namespace software_shadow
+{
+    uint32_t evaluate(const BVH& bvh, const MeshAnimation& animation, uint32_t frameA, uint32_t frameB, float interpolationFactor,
+        const std::vector<uint32_t>& visibility, const SoftwareShadowView& view, std::vector<float>& shadow)
+    {
+        const std::vector<float3>& positions = bvh.positions();
+        const std::vector<VertexData>& verticesA = animation.vertexBufferArray[frameA].data;
+        const std::vector<VertexData>& verticesB = animation.vertexBufferArray[frameB].data;
+        shadow.resize(view.width * view.height);
+        std::atomic<uint32_t> numRays = 0;
+
+        // Rows are processed in parallel
+        task_scheduler::parallel_for(0, view.height, [&](uint32_t first, uint32_t last)
+        {
+            uint32_t rowRays = 0;
+            for (uint32_t y = first; y < last; ++y)
+            {
+                for (uint32_t x = 0; x < view.width; ++x)
+                {
+                    const uint32_t visibilityData = visibility[y * view.width + x];
+                    float3 origin;
+                    bool validRay = false;
+                    if (visibilityData & 0x80000000)
+                    {
+                        // Origin on the surface, pushed along the interpolated normal
+                        uint32_t seed = pixel_seed(x, y);
+                        const uint3& indices = animation.indexBuffer[visibilityData & 0x7FFFFFFF];
+                        const float3 bary = pixel_barycentrics(positions[indices.x], positions[indices.y], positions[indices.z], x, y, view);
+                        const float3 normalWS = lerp(verticesA[indices.x].normal, verticesB[indices.x].normal, interpolationFactor) * bary.x
+                            + lerp(verticesA[indices.y].normal, verticesB[indices.y].normal, interpolationFactor) * bary.y
+                            + lerp(verticesA[indices.z].normal, verticesB[indices.z].normal, interpolationFactor) * bary.z;
+                        origin = positions[indices.x] * bary.x + positions[indices.y] * bary.y + positions[indices.z] * bary.z + normalWS * (urng(seed) * SOFTWARE_SHADOW_NORMAL_OFFSET);
+                        validRay = true;
+                    }
+                    else
+                    {
+                        // Camera ray against the ground plane
+                        const float2 positionNDC = { (x + 0.5f) / view.width, 1.0f - (y + 0.5f) / view.height };
+                        const float4 positionCS = { positionNDC.x * 2.0f - 1.0f, positionNDC.y * 2.0f - 1.0f, 1.0f, 1.0f };
+                        const float4 hpositionWS = mul_transpose(view.invViewProjection, positionCS);
+                        const float3 rayDir = normalize(float3({ hpositionWS.x, hpositionWS.y, hpositionWS.z }) * (1.0f / hpositionWS.w));
+                        const float t = rayDir.y > 1e-6f ? -1.0f : -view.cameraPosition.y / rayDir.y;
+                        origin = view.cameraPosition + rayDir * t;
+                        validRay = t > 0.0f && length(origin) < SOFTWARE_SHADOW_GROUND_RADIUS;
+                    }
+
+                    float value = 1.0f;
+                    if (validRay)
+                    {
+                        value = bvh.occluded(origin, view.sunDirection, SOFTWARE_SHADOW_TMIN, SOFTWARE_SHADOW_TMAX) ? 0.0f : 1.0f;
+                        rowRays++;
+                    }
+                    shadow[y * view.width + x] = value;
+                }
+            }
+            numRays += rowRays;
+        }, 4);
+        return numRays;
+    }
+
+    uint32_t count_differences(const std::vector<float>& shadowA, const std::vector<float>& shadowB)
+    {
+        uint32_t numDifferences = 0;
+        for (uint32_t pixelIdx = 0; pixelIdx < (uint32_t)std::min(shadowA.size(), shadowB.size()); ++pixelIdx)
+            numDifferences += shadowA[pixelIdx] != shadowB[pixelIdx] ? 1 : 0;
+        return numDifferences;
+    }
+}
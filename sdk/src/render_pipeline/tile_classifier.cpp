@@ -7,11 +7,12 @@
 
 // Includes
 #include "graphics/backend.h"
+#include "render_pipeline/shader_bindings.h"
 #include "render_pipeline/tile_classifier.h"
+#include "render_pipeline/tile_shape.h"
+#include "tools/security.h"
 #include "tools/shader_utils.h"
 
-#define WORK_GROUP_SIZE 32
-
 TileClassifier::TileClassifier()
 {
 }
@@ -20,33 +21,23 @@ TileClassifier::~TileClassifier()
 {
 }
 
-void TileClassifier::initialize(GraphicsDevice device, const uint2& tileSize, uint32_t numMLPS)
+void TileClassifier::initialize(GraphicsDevice device, const uint2& tileSize, TileShape tileShape, uint32_t numMLPS)
 {
     // Keep track of the device
     m_Device = device;
 
     // Keep the size
     m_TileSize = tileSize;
-    const uint32_t numTiles = tileSize.x * tileSize.y;
+    m_TilePixels = tile_shape::num_pixels(tileShape);
 
-    // Allocate the buffers
-    m_ActiveTileBuffer = graphics::resources::create_graphics_buffer(m_Device, (1 + numTiles) * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
-    m_UniformTileBuffer = graphics::resources::create_graphics_buffer(m_Device, (1 + numTiles) * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
-    m_ComplexTileBuffer = graphics::resources::create_graphics_buffer(m_Device, (1 + numTiles) * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
+    // The per-MLP counters stay inside the classification, the lists are provided by the caller
     m_MLPUsageBuffer = graphics::resources::create_graphics_buffer(m_Device, 2 * numMLPS * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
-    m_RepackedTilesBuffer = graphics::resources::create_graphics_buffer(m_Device, WORK_GROUP_SIZE * numTiles * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default);
-    m_IndirectBuffer = graphics::resources::create_graphics_buffer(m_Device, 3 * 4 * sizeof(uint32_t), sizeof(uint32_t), GraphicsBufferType::Default, (uint32_t)GraphicsBufferFlags::Indirect);
 }
 
 void TileClassifier::release()
 {
     // Graphics resources
-    graphics::resources::destroy_graphics_buffer(m_ActiveTileBuffer);
-    graphics::resources::destroy_graphics_buffer(m_UniformTileBuffer);
-    graphics::resources::destroy_graphics_buffer(m_ComplexTileBuffer);
     graphics::resources::destroy_graphics_buffer(m_MLPUsageBuffer);
-    graphics::resources::destroy_graphics_buffer(m_RepackedTilesBuffer);
-    graphics::resources::destroy_graphics_buffer(m_IndirectBuffer);
 
     // Shaders
     graphics::compute_shader::destroy_compute_shader(m_PrepareIndirectionCS);
@@ -55,114 +46,125 @@ void TileClassifier::release()
     graphics::compute_shader::destroy_compute_shader(m_SecondPassCS);
 }
 
-void TileClassifier::reload_shaders(const std::string& shaderLibrary)
+void TileClassifier::reload_shaders(const std::string& shaderLibrary, ShaderCompileBatch& batch)
 {
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Classification\\PrepareIndirection.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_PrepareIndirectionCS);
+        batch.add_compute_shader(csd, m_PrepareIndirectionCS);
     }
 
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Classification\\Reset.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_ResetCS);
+        batch.add_compute_shader(csd, m_ResetCS);
     }
 
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Classification\\FirstPass.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_FirstPassCS);
+        batch.add_compute_shader(csd, m_FirstPassCS);
     }
 
     {
         ComputeShaderDescriptor csd;
         csd.includeDirectories.push_back(shaderLibrary);
         csd.filename = shaderLibrary + "\\Classification\\SecondPass.compute";
-        compile_and_replace_compute_shader(m_Device, csd, m_SecondPassCS);
+        batch.add_compute_shader(csd, m_SecondPassCS);
     }
 }
 
-void TileClassifier::classify(CommandBuffer cmdB, ConstantBuffer globalCB, RenderTexture visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer)
+void TileClassifier::classify(CommandBuffer cmdB, ConstantBuffer globalCB, RenderTexture visibilityBuffer, GraphicsBuffer vertexBuffer, GraphicsBuffer indexBuffer, const FeatureCache& featureCache)
 {
+    assert_msg(m_Buffers.activeTiles != 0 && m_Buffers.indirect != 0, "The classification lists need to be set before the classification.");
     graphics::command_buffer::start_section(cmdB, "Tile classification");
 
     // Clear the classification data
     {
         // CBVs
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_ResetCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_ResetCS, shader_binding::GlobalCB, globalCB);
 
         // Buffers
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, "_ActiveTileBufferRW", m_ActiveTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, "_UniformTileBufferRW", m_UniformTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, "_ComplexTileBufferRW", m_ComplexTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, "_MLPUsageBufferRW", m_MLPUsageBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, shader_binding::ActiveTileBufferRW, m_Buffers.activeTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, shader_binding::UniformTileBufferRW, m_Buffers.uniformTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, shader_binding::ComplexTileBufferRW, m_Buffers.complexTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, shader_binding::MLPUsageBufferRW, m_MLPUsageBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, shader_binding::HalfRateTileBufferRW, m_Buffers.halfRateTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_ResetCS, shader_binding::QuarterRateTileBufferRW, m_Buffers.quarterRateTiles);
 
         // Dispatch + Barrier
         graphics::command_buffer::dispatch(cmdB, m_ResetCS, 1, 1, 1);
-        graphics::command_buffer::uav_barrier_buffer(cmdB, m_UniformTileBuffer);
+        graphics::command_buffer::uav_barrier_buffer(cmdB, m_Buffers.uniformTiles);
     }
 
     // First classification
     {
         // CBVs
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_FirstPassCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_FirstPassCS, shader_binding::GlobalCB, globalCB);
 
         // SRVs
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_FirstPassCS, "_VisibilityBuffer", visibilityBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, "_VertexBuffer", vertexBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, "_IndexBuffer", indexBuffer);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_FirstPassCS, shader_binding::VisibilityBuffer, visibilityBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::VertexBuffer, vertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::IndexBuffer, indexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::FeatureCacheHistory, featureCache.history_keys_buffer());
 
         // UAVs
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, "_ActiveTileBufferRW", m_ActiveTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, "_UniformTileBufferRW", m_UniformTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, "_ComplexTileBufferRW", m_ComplexTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, "_MLPUsageBufferRW", m_MLPUsageBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::ActiveTileBufferRW, m_Buffers.activeTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::UniformTileBufferRW, m_Buffers.uniformTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::ComplexTileBufferRW, m_Buffers.complexTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::MLPUsageBufferRW, m_MLPUsageBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::HalfRateTileBufferRW, m_Buffers.halfRateTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::QuarterRateTileBufferRW, m_Buffers.quarterRateTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::FeatureCacheKeysRW, featureCache.keys_buffer());
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_FirstPassCS, shader_binding::ReuseBufferRW, featureCache.reuse_buffer());
 
         // Dispatch + Barrier
         graphics::command_buffer::dispatch(cmdB, m_FirstPassCS, m_TileSize.x, m_TileSize.y, 1);
-        graphics::command_buffer::uav_barrier_buffer(cmdB, m_UniformTileBuffer);
+        graphics::command_buffer::uav_barrier_buffer(cmdB, m_Buffers.uniformTiles);
     }
 
     // Prepare the indirection
     {
         // CBVs
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_PrepareIndirectionCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_PrepareIndirectionCS, shader_binding::GlobalCB, globalCB);
 
         // SRVs
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, "_ActiveTileBuffer", m_ActiveTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, "_UniformTileBuffer", m_UniformTileBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, "_ComplexTileBuffer", m_ComplexTileBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::ActiveTileBuffer, m_Buffers.activeTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::UniformTileBuffer, m_Buffers.uniformTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::ComplexTileBuffer, m_Buffers.complexTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::HalfRateTileBuffer, m_Buffers.halfRateTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::QuarterRateTileBuffer, m_Buffers.quarterRateTiles);
 
         // UAVs
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, "_MLPUsageBufferRW", m_MLPUsageBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, "_IndirectDispatchBufferRW", m_IndirectBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::MLPUsageBufferRW, m_MLPUsageBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_PrepareIndirectionCS, shader_binding::IndirectDispatchBufferRW, m_Buffers.indirect);
 
         // Dispatch + Barrier
         graphics::command_buffer::dispatch(cmdB, m_PrepareIndirectionCS, 1, 1, 1);
-        graphics::command_buffer::uav_barrier_buffer(cmdB, m_IndirectBuffer);
+        graphics::command_buffer::uav_barrier_buffer(cmdB, m_Buffers.indirect);
     }
 
     // Second classification
     {
         // CBUffers
-        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_SecondPassCS, "_GlobalCB", globalCB);
+        graphics::command_buffer::set_compute_shader_cbuffer(cmdB, m_SecondPassCS, shader_binding::GlobalCB, globalCB);
 
         // SRVs
-        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_SecondPassCS, "_VisibilityBuffer", visibilityBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, "_VertexBuffer", vertexBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, "_IndexBuffer", indexBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, "_ComplexTileBuffer", m_ComplexTileBuffer);
+        graphics::command_buffer::set_compute_shader_render_texture(cmdB, m_SecondPassCS, shader_binding::VisibilityBuffer, visibilityBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, shader_binding::VertexBuffer, vertexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, shader_binding::IndexBuffer, indexBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, shader_binding::ComplexTileBuffer, m_Buffers.complexTiles);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, shader_binding::ReuseBuffer, featureCache.reuse_buffer());
 
         // UAVs
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, "_MLPUsageBufferRW", m_MLPUsageBuffer);
-        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, "_IndexedTilesBufferRW", m_RepackedTilesBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, shader_binding::MLPUsageBufferRW, m_MLPUsageBuffer);
+        graphics::command_buffer::set_compute_shader_buffer(cmdB, m_SecondPassCS, shader_binding::IndexedTilesBufferRW, m_Buffers.repackedTiles);
 
         // Dispatch + Barrier
-        graphics::command_buffer::dispatch_indirect(cmdB, m_SecondPassCS, m_IndirectBuffer, 6 * sizeof(uint32_t));
+        graphics::command_buffer::dispatch_indirect(cmdB, m_SecondPassCS, m_Buffers.indirect, 6 * sizeof(uint32_t));
     }
 
     graphics::command_buffer::end_section(cmdB);
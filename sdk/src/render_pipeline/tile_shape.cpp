@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "render_pipeline/tile_shape.h"
+
+// System includes
+#include <algorithm>
+#include <fstream>
+
+// Header of the capture files
+#define VISIBILITY_CAPTURE_MAGIC 0x53495654 // "TVIS"
+#define VISIBILITY_CAPTURE_VERSION 1
+
+namespace tile_shape
+{
+    uint2 dimensions(TileShape shape)
+    {
+        switch (shape)
+        {
+            case TileShape::Tile4x8:
+                return { 4, 8 };
+            case TileShape::Tile8x8:
+                return { 8, 8 };
+            case TileShape::Tile16x4:
+                return { 16, 4 };
+            case TileShape::Tile4x4:
+                return { 4, 4 };
+            default:
+                return { 8, 4 };
+        }
+    }
+
+    uint32_t num_pixels(TileShape shape)
+    {
+        uint2 dims = dimensions(shape);
+        return dims.x * dims.y;
+    }
+
+    const char* name(TileShape shape)
+    {
+        switch (shape)
+        {
+            case TileShape::Tile4x8:
+                return "4x8";
+            case TileShape::Tile8x8:
+                return "8x8";
+            case TileShape::Tile16x4:
+                return "16x4";
+            case TileShape::Tile4x4:
+                return "4x4";
+            default:
+                return "8x4";
+        }
+    }
+
+    bool parse(const std::string& shapeName, TileShape& shape)
+    {
+        for (uint32_t shapeIdx = 0; shapeIdx < (uint32_t)TileShape::Count; ++shapeIdx)
+        {
+            if (shapeName == name((TileShape)shapeIdx))
+            {
+                shape = (TileShape)shapeIdx;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool supported(TileShape shape, const uint2& waveLaneRange)
+    {
+        // The default shape keeps the shaders as they have always been
+        if (shape == TileShape::Tile8x4)
+            return true;
+
+        // Tiles larger than a wave are forced to the wave size of their pixel count
+        return num_pixels(shape) <= waveLaneRange.y;
+    }
+
+    void shader_defines(TileShape shape, const uint2& waveLaneRange, std::vector<std::string>& defines)
+    {
+        // Nothing for the default shape so that the cached and archived permutations stay valid
+        if (shape == TileShape::Tile8x4)
+            return;
+
+        uint2 dims = dimensions(shape);
+        defines.push_back("TILE_WIDTH " + std::to_string(dims.x));
+        defines.push_back("TILE_HEIGHT " + std::to_string(dims.y));
+
+        // A device that can run smaller waves could split the tile
+        if (num_pixels(shape) > waveLaneRange.x)
+            defines.push_back("TILE_WAVE_SIZE " + std::to_string(num_pixels(shape)));
+    }
+
+    bool write_capture(const std::string& path, const VisibilityCapture& capture)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        const uint32_t header[4] = { VISIBILITY_CAPTURE_MAGIC, VISIBILITY_CAPTURE_VERSION, capture.width, capture.height };
+        file.write((const char*)header, sizeof(header));
+        file.write((const char*)capture.materials.data(), capture.materials.size() * sizeof(uint32_t));
+        return (bool)file;
+    }
+
+    bool read_capture(const std::string& path, VisibilityCapture& capture)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        uint32_t header[4] = { 0, 0, 0, 0 };
+        file.read((char*)header, sizeof(header));
+        if (!file || header[0] != VISIBILITY_CAPTURE_MAGIC || header[1] != VISIBILITY_CAPTURE_VERSION)
+            return false;
+        capture.width = header[2];
+        capture.height = header[3];
+        capture.materials.resize((size_t)capture.width * capture.height);
+        file.read((char*)capture.materials.data(), capture.materials.size() * sizeof(uint32_t));
+        return (bool)file;
+    }
+
+    TileShapeStats evaluate(const VisibilityCapture& capture, TileShape shape, uint32_t waveLaneCount, const TileShapeCostModel& costModel)
+    {
+        TileShapeStats stats;
+        const uint2 dims = dimensions(shape);
+        const uint32_t tilePixels = dims.x * dims.y;
+
+        // Same tile grid as the renderer, the incomplete tiles of the borders are not dispatched
+        const uint32_t tileCountX = capture.width / dims.x;
+        const uint32_t tileCountY = capture.height / dims.y;
+        stats.numTiles = tileCountX * tileCountY;
+
+        // Pixels of the complex tiles, per material
+        std::vector<uint32_t> materialUsage;
+        uint64_t complexPixels = 0;
+        for (uint32_t tileY = 0; tileY < tileCountY; ++tileY)
+        {
+            for (uint32_t tileX = 0; tileX < tileCountX; ++tileX)
+            {
+                // Covered pixels and the range of their materials, like the wave reductions of FirstPass.compute
+                uint32_t numCovered = 0;
+                uint32_t minID = UINT32_MAX;
+                uint32_t maxID = 0;
+                for (uint32_t localY = 0; localY < dims.y; ++localY)
+                {
+                    for (uint32_t localX = 0; localX < dims.x; ++localX)
+                    {
+                        uint32_t matID = capture.materials[(tileX * dims.x + localX) + (tileY * dims.y + localY) * capture.width];
+                        if (matID == TILE_SHAPE_EMPTY_PIXEL)
+                            continue;
+                        numCovered++;
+                        minID = std::min(minID, matID);
+                        maxID = std::max(maxID, matID);
+                    }
+                }
+                if (numCovered == 0)
+                    continue;
+
+                stats.activeTiles++;
+                stats.coveredPixels += numCovered;
+                if (minID == maxID)
+                {
+                    stats.uniformTiles++;
+                    continue;
+                }
+
+                // The pixels of the complex tiles are repacked per material
+                stats.complexTiles++;
+                complexPixels += numCovered;
+                if (materialUsage.size() <= maxID)
+                    materialUsage.resize(maxID + 1, 0);
+                for (uint32_t localY = 0; localY < dims.y; ++localY)
+                {
+                    for (uint32_t localX = 0; localX < dims.x; ++localX)
+                    {
+                        uint32_t matID = capture.materials[(tileX * dims.x + localX) + (tileY * dims.y + localY) * capture.width];
+                        if (matID != TILE_SHAPE_EMPTY_PIXEL)
+                            materialUsage[matID]++;
+                    }
+                }
+            }
+        }
+
+        // Same rounding as PrepareIndirection.compute
+        for (uint32_t usage : materialUsage)
+            stats.repackedGroups += (usage + tilePixels - 1) / tilePixels;
+
+        // A work group smaller than a wave still occupies the whole wave
+        const uint64_t groupLanes = std::max(tilePixels, waveLaneCount);
+        stats.inferenceLanes = (stats.uniformTiles + stats.repackedGroups) * groupLanes;
+        const uint64_t classificationLanes = (stats.numTiles + stats.complexTiles) * groupLanes;
+        const uint64_t shadingLanes = stats.activeTiles * groupLanes;
+
+        // Ratios
+        stats.uniformFraction = stats.activeTiles > 0 ? stats.uniformTiles / (float)stats.activeTiles : 0.0f;
+        stats.laneEfficiency = stats.inferenceLanes > 0 ? stats.coveredPixels / (float)stats.inferenceLanes : 0.0f;
+        stats.repackOverhead = stats.coveredPixels > 0 ? (stats.complexTiles * groupLanes + stats.repackedGroups * groupLanes - complexPixels) / (float)stats.coveredPixels : 0.0f;
+        stats.cost = (double)stats.uniformTiles * groupLanes + (double)stats.repackedGroups * groupLanes * costModel.repackedInference
+            + (double)classificationLanes * costModel.classification + (double)shadingLanes * costModel.shading;
+        return stats;
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "render_pipeline/variable_rate.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+namespace variable_rate
+{
+    void normalized_thresholds(const VariableRateSettings& settings, float numMips, float& halfRateLOD, float& quarterRateLOD, float& maxLODSpread)
+    {
+        halfRateLOD = settings.halfRateMip / numMips;
+        quarterRateLOD = settings.quarterRateMip / numMips;
+        maxLODSpread = settings.maxMipSpread / numMips;
+    }
+
+    InferenceRate select_rate(const VariableRateTile& tile, float halfRateLOD, float quarterRateLOD, float maxLODSpread)
+    {
+        // Only fully covered tiles of a single material
+        float minLOD = FLT_MAX;
+        float maxLOD = -FLT_MAX;
+        for (uint32_t pixelIdx = 0; pixelIdx < VRS_TILE_PIXELS; ++pixelIdx)
+        {
+            if (!tile.covered[pixelIdx] || tile.material[pixelIdx] != tile.material[0])
+                return InferenceRate::Full;
+            minLOD = std::min(minLOD, tile.lod[pixelIdx]);
+            maxLOD = std::max(maxLOD, tile.lod[pixelIdx]);
+        }
+
+        // Whose footprint doesn't vary too much
+        if (maxLOD - minLOD > maxLODSpread)
+            return InferenceRate::Full;
+        if (minLOD >= quarterRateLOD)
+            return InferenceRate::Quarter;
+        if (minLOD >= halfRateLOD)
+            return InferenceRate::Half;
+        return InferenceRate::Full;
+    }
+
+    bool is_inferred_pixel(uint32_t localX, uint32_t localY, InferenceRate rate)
+    {
+        switch (rate)
+        {
+            case InferenceRate::Half:
+                return (localX & 0x1) == 0;
+            case InferenceRate::Quarter:
+                return (localX & 0x1) == 0 && (localY & 0x1) == 0;
+            default:
+                return true;
+        }
+    }
+
+    uint32_t inferred_pixels_per_tile(InferenceRate rate)
+    {
+        switch (rate)
+        {
+            case InferenceRate::Half:
+                return VRS_TILE_PIXELS / 2;
+            case InferenceRate::Quarter:
+                return VRS_TILE_PIXELS / 4;
+            default:
+                return VRS_TILE_PIXELS;
+        }
+    }
+
+    static float edge_weight(const float2& uv, const float2& uvDX, const float2& uvDY, const float2& tapUV, float offsetX, float offsetY)
+    {
+        float2 predictedUV = uv + uvDX * offsetX + uvDY * offsetY;
+        float footprint = std::max(std::max(length(uvDX), length(uvDY)), 1e-8f);
+        float error = length(tapUV - predictedUV) / footprint;
+        return 1.0f / (1.0f + error * error * VRS_EDGE_SHARPNESS);
+    }
+
+    void upsample_tile(const VariableRateTile& tile, InferenceRate rate, float* features)
+    {
+        if (rate == InferenceRate::Full)
+            return;
+
+        for (uint32_t localY = 0; localY < VRS_TILE_HEIGHT; ++localY)
+        {
+            for (uint32_t localX = 0; localX < VRS_TILE_WIDTH; ++localX)
+            {
+                if (is_inferred_pixel(localX, localY, rate))
+                    continue;
+
+                // Bilinear taps on the inferred pixels of the tile
+                uint32_t baseX = localX & ~0x1u;
+                uint32_t baseY = rate == InferenceRate::Half ? localY : localY & ~0x1u;
+                float fx = (localX & 0x1) != 0 ? 0.5f : 0.0f;
+                float fy = rate == InferenceRate::Quarter && (localY & 0x1) != 0 ? 0.5f : 0.0f;
+                bool hasRight = baseX + 2 < VRS_TILE_WIDTH;
+                bool hasBottom = baseY + 2 < VRS_TILE_HEIGHT;
+                const uint32_t tapX[4] = { baseX, baseX + 2, baseX, baseX + 2 };
+                const uint32_t tapY[4] = { baseY, baseY, baseY + 2, baseY + 2 };
+                const float tapWeights[4] = { (1.0f - fx) * (1.0f - fy), hasRight ? fx * (1.0f - fy) : 0.0f,
+                    hasBottom ? (1.0f - fx) * fy : 0.0f, hasRight && hasBottom ? fx * fy : 0.0f };
+
+                // Blend them
+                uint32_t pixelIdx = localX + localY * VRS_TILE_WIDTH;
+                float blended[VRS_NUM_FEATURES] = {};
+                float totalWeight = 0.0f;
+                for (uint32_t tapIdx = 0; tapIdx < 4; ++tapIdx)
+                {
+                    if (tapWeights[tapIdx] == 0.0f)
+                        continue;
+                    uint32_t tapPixelIdx = tapX[tapIdx] + tapY[tapIdx] * VRS_TILE_WIDTH;
+                    float weight = tapWeights[tapIdx] * edge_weight(tile.uv[pixelIdx], tile.uvDX[pixelIdx], tile.uvDY[pixelIdx], tile.uv[tapPixelIdx],
+                        (float)tapX[tapIdx] - (float)localX, (float)tapY[tapIdx] - (float)localY);
+                    for (uint32_t featIdx = 0; featIdx < VRS_NUM_FEATURES; ++featIdx)
+                        blended[featIdx] += weight * features[tapPixelIdx * VRS_NUM_FEATURES + featIdx];
+                    totalWeight += weight;
+                }
+
+                // Export
+                for (uint32_t featIdx = 0; featIdx < VRS_NUM_FEATURES; ++featIdx)
+                    features[pixelIdx * VRS_NUM_FEATURES + featIdx] = blended[featIdx] / totalWeight;
+            }
+        }
+    }
+
+    VariableRateStats evaluate(const std::vector<VariableRateTile>& tiles, const std::vector<float>& referenceFeatures, const VariableRateSettings& settings, float numMips)
+    {
+        assert_msg(referenceFeatures.size() == tiles.size() * VRS_TILE_PIXELS * VRS_NUM_FEATURES, "The reference features don't match the tiles.");
+        float halfRateLOD, quarterRateLOD, maxLODSpread;
+        normalized_thresholds(settings, numMips, halfRateLOD, quarterRateLOD, maxLODSpread);
+
+        VariableRateStats stats;
+        std::vector<float> features(VRS_TILE_PIXELS * VRS_NUM_FEATURES);
+        double squaredError = 0.0;
+        for (uint32_t tileIdx = 0; tileIdx < (uint32_t)tiles.size(); ++tileIdx)
+        {
+            const VariableRateTile& tile = tiles[tileIdx];
+            const float* reference = referenceFeatures.data() + tileIdx * VRS_TILE_PIXELS * VRS_NUM_FEATURES;
+
+            // Classify
+            InferenceRate rate = select_rate(tile, halfRateLOD, quarterRateLOD, maxLODSpread);
+            stats.numTiles[(uint32_t)rate]++;
+
+            // Only keep the features of the inferred pixels and reconstruct the others
+            for (uint32_t pixelIdx = 0; pixelIdx < VRS_TILE_PIXELS; ++pixelIdx)
+            {
+                bool inferred = is_inferred_pixel(pixelIdx % VRS_TILE_WIDTH, pixelIdx / VRS_TILE_WIDTH, rate);
+                for (uint32_t featIdx = 0; featIdx < VRS_NUM_FEATURES; ++featIdx)
+                    features[pixelIdx * VRS_NUM_FEATURES + featIdx] = inferred ? reference[pixelIdx * VRS_NUM_FEATURES + featIdx] : 0.0f;
+                if (tile.covered[pixelIdx])
+                {
+                    stats.coveredPixels++;
+                    stats.inferredPixels += inferred ? 1 : 0;
+                }
+            }
+            upsample_tile(tile, rate, features.data());
+
+            // Error of the covered pixels
+            for (uint32_t pixelIdx = 0; pixelIdx < VRS_TILE_PIXELS; ++pixelIdx)
+            {
+                if (!tile.covered[pixelIdx])
+                    continue;
+                for (uint32_t featIdx = 0; featIdx < VRS_NUM_FEATURES; ++featIdx)
+                {
+                    double diff = features[pixelIdx * VRS_NUM_FEATURES + featIdx] - reference[pixelIdx * VRS_NUM_FEATURES + featIdx];
+                    squaredError += diff * diff;
+                }
+            }
+        }
+
+        // The features are in [0, 1]
+        stats.meanSquaredError = stats.coveredPixels > 0 ? squaredError / (stats.coveredPixels * VRS_NUM_FEATURES) : 0.0;
+        stats.psnr = stats.meanSquaredError > 0.0 ? 10.0 * log10(1.0 / stats.meanSquaredError) : 100.0;
+        return stats;
+    }
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "scene/animation_stream.h"
+#include "tools/security.h"
+#include "tools/stream.h"
+
+// System includes
+#include <algorithm>
+#include <string.h>
+
+AnimationStream::AnimationStream()
+{
+}
+
+AnimationStream::~AnimationStream()
+{
+    release();
+}
+
+bool AnimationStream::initialize(const std::string& path, uint32_t numSlots)
+{
+    release();
+    if (!m_File.open(path))
+        return false;
+
+    // Only the sizes of the frames are read to find them, their pages stay on disk
+    const char* stream = m_File.data();
+    const char* fileEnd = m_File.data() + m_File.size();
+    m_Quantized = mesh::is_quantized_mesh_animation(path.c_str());
+    if (m_Quantized)
+    {
+        m_NumFrames = mesh::unpack_quantized_header(stream, m_Topology, m_KeyframeInterval);
+        m_NumVertices = (uint32_t)m_Topology.sharedVertices.size();
+        m_FrameOffsets.resize(m_NumFrames);
+        for (uint32_t frameIdx = 0; frameIdx < m_NumFrames && stream < fileEnd; ++frameIdx)
+        {
+            m_FrameOffsets[frameIdx] = (uint64_t)(stream - m_File.data());
+            mesh::skip_quantized_frame(stream, mesh::is_key_frame(frameIdx, m_KeyframeInterval));
+        }
+    }
+    else
+    {
+        unpack_vector_bytes(stream, m_Topology.indexBuffer);
+        unpack_bytes(stream, m_NumFrames);
+        m_FrameOffsets.resize(m_NumFrames);
+        for (uint32_t frameIdx = 0; frameIdx < m_NumFrames && stream < fileEnd; ++frameIdx)
+        {
+            m_FrameOffsets[frameIdx] = (uint64_t)(stream - m_File.data());
+            size_t numVertices;
+            unpack_bytes(stream, numVertices);
+            stream += numVertices * sizeof(VertexData);
+            m_NumVertices = (uint32_t)numVertices;
+        }
+
+        // The texture coordinates and the materials don't change with the animation
+        if (m_NumFrames > 0)
+        {
+            // The frames are not aligned in the file
+            const char* firstFrame = m_File.data() + m_FrameOffsets[0] + sizeof(size_t);
+            m_Topology.sharedVertices.resize(m_NumVertices);
+            for (uint32_t vertIdx = 0; vertIdx < m_NumVertices; ++vertIdx)
+            {
+                VertexData vertex;
+                memcpy(&vertex, firstFrame + vertIdx * sizeof(VertexData), sizeof(VertexData));
+                m_Topology.sharedVertices[vertIdx].texCoord = vertex.texCoord;
+                m_Topology.sharedVertices[vertIdx].matID = vertex.matID;
+            }
+        }
+    }
+    if (m_NumFrames == 0 || stream > fileEnd)
+    {
+        printf("[ANIMATION STREAM] %s is empty or truncated.\n", path.c_str());
+        release();
+        return false;
+    }
+
+    // Slots, the window never covers more than the animation
+    m_NumSlots = std::max(std::min(numSlots, m_NumFrames), 1u);
+    m_Slots.resize(m_NumSlots);
+    for (Slot& slot : m_Slots)
+        slot.data.resize((size_t)m_NumVertices * vertex_size());
+    m_WindowStart = 0;
+    m_Stats = AnimationStreamStats();
+
+    // Start loading the first frames
+    m_Active = true;
+    m_Thread = std::thread(&AnimationStream::load_loop, this);
+    return true;
+}
+
+void AnimationStream::release()
+{
+    if (m_Thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Active = false;
+        }
+        m_Condition.notify_all();
+        m_Thread.join();
+    }
+    m_File.close();
+    m_FrameOffsets.clear();
+    m_Slots.clear();
+    m_Topology = QuantizedMeshAnimation();
+    m_DeltaFrame.clear();
+    m_DeltaFrameIdx = UINT32_MAX;
+    m_NumFrames = 0;
+    m_NumVertices = 0;
+}
+
+void AnimationStream::request(uint32_t frameIdx)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_WindowStart == frameIdx % m_NumFrames)
+            return;
+        m_WindowStart = frameIdx % m_NumFrames;
+    }
+    m_Condition.notify_all();
+}
+
+const char* AnimationStream::acquire(uint32_t frameIdx)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    assert_msg(in_window(frameIdx), "The frame is outside of the requested window.");
+    uint32_t slotIdx = find_slot(frameIdx);
+    if (slotIdx == UINT32_MAX || !m_Slots[slotIdx].ready)
+    {
+        m_Stats.stalls++;
+        m_Condition.wait(lock, [&]() { slotIdx = find_slot(frameIdx); return slotIdx != UINT32_MAX && m_Slots[slotIdx].ready; });
+    }
+    return m_Slots[slotIdx].data.data();
+}
+
+const char* AnimationStream::try_acquire(uint32_t frameIdx)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!in_window(frameIdx))
+        return nullptr;
+    uint32_t slotIdx = find_slot(frameIdx);
+    return slotIdx != UINT32_MAX && m_Slots[slotIdx].ready ? m_Slots[slotIdx].data.data() : nullptr;
+}
+
+AnimationStreamStats AnimationStream::stats()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+bool AnimationStream::in_window(uint32_t frameIdx) const
+{
+    return (frameIdx + m_NumFrames - m_WindowStart) % m_NumFrames < m_NumSlots;
+}
+
+uint32_t AnimationStream::find_slot(uint32_t frameIdx) const
+{
+    for (uint32_t slotIdx = 0; slotIdx < m_NumSlots; ++slotIdx)
+    {
+        if (m_Slots[slotIdx].frameIdx == frameIdx)
+            return slotIdx;
+    }
+    return UINT32_MAX;
+}
+
+uint32_t AnimationStream::next_missing_frame() const
+{
+    // Closest to the start of the window first
+    for (uint32_t offset = 0; offset < m_NumSlots; ++offset)
+    {
+        uint32_t frameIdx = (m_WindowStart + offset) % m_NumFrames;
+        if (find_slot(frameIdx) == UINT32_MAX)
+            return frameIdx;
+    }
+    return UINT32_MAX;
+}
+
+void AnimationStream::load_loop()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true)
+    {
+        uint32_t frameIdx = UINT32_MAX;
+        m_Condition.wait(lock, [&]() { frameIdx = next_missing_frame(); return !m_Active || frameIdx != UINT32_MAX; });
+        if (!m_Active)
+            break;
+
+        // A frame of the window is missing, so at least one slot holds a frame outside of it
+        uint32_t slotIdx = 0;
+        while (m_Slots[slotIdx].frameIdx != UINT32_MAX && in_window(m_Slots[slotIdx].frameIdx))
+            slotIdx++;
+        Slot& slot = m_Slots[slotIdx];
+        slot.frameIdx = frameIdx;
+        slot.ready = false;
+
+        // Nobody reads the slot until it is ready
+        lock.unlock();
+        decode_frame(frameIdx, slot.data.data());
+        lock.lock();
+
+        slot.ready = true;
+        m_Stats.decodedFrames++;
+        m_Condition.notify_all();
+    }
+}
+
+void AnimationStream::decode_frame(uint32_t frameIdx, char* output)
+{
+    const size_t frameSize = (size_t)m_NumVertices * vertex_size();
+    if (!m_Quantized)
+    {
+        memcpy(output, m_File.data() + m_FrameOffsets[frameIdx] + sizeof(size_t), frameSize);
+        return;
+    }
+
+    // The delta frames are decoded from the closest key frame unless the previous frame was the last one decoded
+    uint32_t firstFrame = m_DeltaFrameIdx + 1 == frameIdx ? frameIdx : frameIdx - (m_KeyframeInterval != 0 ? frameIdx % m_KeyframeInterval : 0);
+    if (m_DeltaFrameIdx == frameIdx)
+        firstFrame = frameIdx + 1;
+    std::vector<QuantizedVertexData> frame;
+    for (uint32_t currentIdx = firstFrame; currentIdx <= frameIdx; ++currentIdx)
+    {
+        const char* stream = m_File.data() + m_FrameOffsets[currentIdx];
+        mesh::unpack_quantized_frame(stream, mesh::is_key_frame(currentIdx, m_KeyframeInterval), m_DeltaFrame, frame);
+        m_DeltaFrame.swap(frame);
+        m_DeltaFrameIdx = currentIdx;
+    }
+    memcpy(output, m_DeltaFrame.data(), frameSize);
+}
@@ -9,40 +9,192 @@
 #include "scene/mesh.h"
 #include "tools/stream.h"
 
-namespace mesh
+// System includes
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#if defined(_M_X64) || defined(__SSE2__)
+#define MESH_SSE2
+#include <emmintrin.h>
+#endif
+
+// Largest quantized value
+#define QUANTIZATION_RANGE 65535.0f
+
+// Components of QuantizedVertexData that are delta coded
+#define QUANTIZED_COMPONENTS 7
+
+static void read_file(const char* path, std::vector<char>& binaryFile)
 {
-    void import_mesh_animation(const char* path, MeshAnimation& meshAnimation)
+    // Read from disk
+    FILE* pFile;
+    pFile = fopen(path, "rb");
+    fseek(pFile, 0L, SEEK_END);
+    size_t fileSize = _ftelli64(pFile);
+    binaryFile.resize(fileSize);
+    _fseeki64(pFile, 0L, SEEK_SET);
+    rewind(pFile);
+    fread(binaryFile.data(), sizeof(char), fileSize, pFile);
+    fclose(pFile);
+}
+
+static void write_file(const char* path, const std::vector<char>& binaryFile)
+{
+    // Write to disk
+    FILE* pFile;
+    pFile = fopen(path, "wb");
+    fwrite(binaryFile.data(), sizeof(char), binaryFile.size(), pFile);
+    fclose(pFile);
+}
+
+static bool has_quantized_header(const std::vector<char>& binaryFile)
+{
+    uint32_t magic = 0;
+    if (binaryFile.size() >= sizeof(uint32_t))
+        memcpy(&magic, binaryFile.data(), sizeof(uint32_t));
+    return magic == MESH_ANIMATION_MAGIC;
+}
+
+static void unpack_mesh_animation(const char* binaryPtr, MeshAnimation& meshAnimation)
+{
+    // Read the index buffers
+    unpack_vector_bytes(binaryPtr, meshAnimation.indexBuffer);
+
+    // Read the number of frames
+    uint32_t numFrames;
+    unpack_bytes(binaryPtr, numFrames);
+
+    // Read the vertex buffers
+    meshAnimation.vertexBufferArray.resize(numFrames);
+    for (uint32_t idx = 0; idx < numFrames; ++idx)
     {
-        // Vector that will hold our packed meshAnimation 
-        std::vector<char> binaryFile;
+        unpack_vector_bytes(binaryPtr, meshAnimation.vertexBufferArray[idx].data);
+    }
+}
 
-        // Read from disk
-        FILE* pFile;
-        pFile = fopen(path, "rb");
-        fseek(pFile, 0L, SEEK_END);
-        size_t fileSize = _ftelli64(pFile);
-        binaryFile.resize(fileSize);
-        _fseeki64(pFile, 0L, SEEK_SET);
-        rewind(pFile);
-        fread(binaryFile.data(), sizeof(char), fileSize, pFile);
-        fclose(pFile);
+// Octahedral mapping of a direction to two values in [0, 65535]
+static void encode_octahedral(const float3& direction, uint16_t* output)
+{
+    float sum = fabsf(direction.x) + fabsf(direction.y) + fabsf(direction.z);
+    float x = sum > 0.0f ? direction.x / sum : 0.0f;
+    float y = sum > 0.0f ? direction.y / sum : 0.0f;
+    if (sum > 0.0f && direction.z < 0.0f)
+    {
+        float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    output[0] = (uint16_t)roundf(std::min(std::max(x * 0.5f + 0.5f, 0.0f), 1.0f) * QUANTIZATION_RANGE);
+    output[1] = (uint16_t)roundf(std::min(std::max(y * 0.5f + 0.5f, 0.0f), 1.0f) * QUANTIZATION_RANGE);
+}
 
-        // Pack the structure in a buffer
-        const char* binaryPtr = binaryFile.data();
+// Same operations as the SSE2 path and as decode_octahedral in vertex_quantization.hlsl
+static float3 decode_octahedral(uint16_t u, uint16_t v)
+{
+    const float scale = 2.0f / QUANTIZATION_RANGE;
+    float x = (float)u * scale - 1.0f;
+    float y = (float)v * scale - 1.0f;
+    float z = (1.0f - fabsf(x)) - fabsf(y);
+    float t = std::max(-z, 0.0f);
+    x = x >= 0.0f ? x - t : x + t;
+    y = y >= 0.0f ? y - t : y + t;
+    float len = sqrtf((x * x + y * y) + z * z);
+    return { x / len, y / len, z / len };
+}
+
+static void dequantize_vertex(const QuantizedMeshAnimation& quantizedAnimation, const QuantizedVertexData& quantized, const SharedVertexData& shared, VertexData& vertex)
+{
+    vertex.position.x = (float)quantized.position[0] * (quantizedAnimation.boundsExtent.x / QUANTIZATION_RANGE) + quantizedAnimation.boundsMin.x;
+    vertex.position.y = (float)quantized.position[1] * (quantizedAnimation.boundsExtent.y / QUANTIZATION_RANGE) + quantizedAnimation.boundsMin.y;
+    vertex.position.z = (float)quantized.position[2] * (quantizedAnimation.boundsExtent.z / QUANTIZATION_RANGE) + quantizedAnimation.boundsMin.z;
+    vertex.normal = decode_octahedral(quantized.normal[0], quantized.normal[1]);
+    vertex.tangent = decode_octahedral(quantized.tangent[0], quantized.tangent[1]);
+    vertex.texCoord = shared.texCoord;
+    vertex.matID = shared.matID;
+}
+
+// Deltas between consecutive frames, zig-zag and variable length coded per component
+static void pack_frame_deltas(std::vector<char>& buffer, const std::vector<QuantizedVertexData>& previous, const std::vector<QuantizedVertexData>& current)
+{
+    std::vector<uint8_t> bytes;
+    for (uint32_t compIdx = 0; compIdx < QUANTIZED_COMPONENTS; ++compIdx)
+    {
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)current.size(); ++vertIdx)
+        {
+            int16_t delta = (int16_t)(uint16_t)(((const uint16_t*)&current[vertIdx])[compIdx] - ((const uint16_t*)&previous[vertIdx])[compIdx]);
+            uint32_t zigzag = (uint32_t)((delta << 1) ^ (delta >> 15)) & 0xFFFF;
+            while (zigzag >= 0x80)
+            {
+                bytes.push_back((uint8_t)(zigzag | 0x80));
+                zigzag >>= 7;
+            }
+            bytes.push_back((uint8_t)zigzag);
+        }
+    }
+    pack_vector_bytes(buffer, bytes);
+}
+
+static void unpack_frame_deltas(const char*& stream, const std::vector<QuantizedVertexData>& previous, std::vector<QuantizedVertexData>& current)
+{
+    std::vector<uint8_t> bytes;
+    unpack_vector_bytes(stream, bytes);
+    current.resize(previous.size());
+    const uint8_t* byte = bytes.data();
+    for (uint32_t compIdx = 0; compIdx < QUANTIZED_COMPONENTS; ++compIdx)
+    {
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)current.size(); ++vertIdx)
+        {
+            uint32_t zigzag = 0;
+            for (uint32_t shift = 0; ; shift += 7)
+            {
+                uint8_t value = *byte++;
+                zigzag |= (uint32_t)(value & 0x7F) << shift;
+                if (!(value & 0x80))
+                    break;
+            }
+            uint16_t delta = (uint16_t)((zigzag >> 1) ^ (0u - (zigzag & 1)));
+            ((uint16_t*)&current[vertIdx])[compIdx] = (uint16_t)(((const uint16_t*)&previous[vertIdx])[compIdx] + delta);
+        }
+    }
+    for (QuantizedVertexData& vertex : current)
+        vertex.padding = 0;
+}
 
-        // Read the index buffers
-        unpack_vector_bytes(binaryPtr, meshAnimation.indexBuffer);
+static void unpack_quantized_mesh_animation(const char* binaryPtr, QuantizedMeshAnimation& meshAnimation)
+{
+    uint32_t keyframeInterval;
+    uint32_t numFrames = mesh::unpack_quantized_header(binaryPtr, meshAnimation, keyframeInterval);
 
-        // Read the number of frames
-        uint32_t numFrames;
-        unpack_bytes(binaryPtr, numFrames);
+    // Key frames and deltas
+    meshAnimation.frames.resize(numFrames);
+    for (uint32_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+    {
+        bool keyFrame = mesh::is_key_frame(frameIdx, keyframeInterval);
+        mesh::unpack_quantized_frame(binaryPtr, keyFrame, keyFrame ? meshAnimation.frames[frameIdx] : meshAnimation.frames[frameIdx - 1], meshAnimation.frames[frameIdx]);
+    }
+}
 
-        // Read the vertex buffers
-        meshAnimation.vertexBufferArray.resize(numFrames);
-        for (uint32_t idx = 0; idx < numFrames; ++idx)
+namespace mesh
+{
+    void import_mesh_animation(const char* path, MeshAnimation& meshAnimation)
+    {
+        // Vector that will hold our packed meshAnimation 
+        std::vector<char> binaryFile;
+        read_file(path, binaryFile);
+
+        // Quantized version
+        if (has_quantized_header(binaryFile))
         {
-            unpack_vector_bytes(binaryPtr, meshAnimation.vertexBufferArray[idx].data);
+            QuantizedMeshAnimation quantizedAnimation;
+            unpack_quantized_mesh_animation(binaryFile.data(), quantizedAnimation);
+            dequantize_mesh_animation(quantizedAnimation, meshAnimation);
+            return;
         }
+
+        // Pack the structure in a buffer
+        unpack_mesh_animation(binaryFile.data(), meshAnimation);
     }
 
     void export_mesh_animation(const MeshAnimation& meshAnimation, const char* path)
@@ -62,9 +214,250 @@ namespace mesh
             pack_vector_bytes(binaryFile, meshAnimation.vertexBufferArray[idx].data);
 
         // Write to disk
-        FILE* pFile;
-        pFile = fopen(path, "wb");
-        fwrite(binaryFile.data(), sizeof(char), binaryFile.size(), pFile);
+        write_file(path, binaryFile);
+    }
+
+    bool is_quantized_mesh_animation(const char* path)
+    {
+        uint32_t magic = 0;
+        FILE* pFile = fopen(path, "rb");
+        if (pFile == nullptr)
+            return false;
+        size_t numRead = fread(&magic, sizeof(uint32_t), 1, pFile);
         fclose(pFile);
+        return numRead == 1 && magic == MESH_ANIMATION_MAGIC;
+    }
+
+    void import_quantized_mesh_animation(const char* path, QuantizedMeshAnimation& meshAnimation)
+    {
+        std::vector<char> binaryFile;
+        read_file(path, binaryFile);
+
+        // Version 1, quantized on load
+        if (!has_quantized_header(binaryFile))
+        {
+            MeshAnimation fullAnimation;
+            unpack_mesh_animation(binaryFile.data(), fullAnimation);
+            quantize_mesh_animation(fullAnimation, meshAnimation);
+            return;
+        }
+
+        unpack_quantized_mesh_animation(binaryFile.data(), meshAnimation);
+    }
+
+    void export_quantized_mesh_animation(const QuantizedMeshAnimation& meshAnimation, const char* path, uint32_t keyframeInterval)
+    {
+        std::vector<char> binaryFile;
+
+        // Header
+        const uint32_t numFrames = (uint32_t)meshAnimation.frames.size();
+        pack_bytes(binaryFile, (uint32_t)MESH_ANIMATION_MAGIC);
+        pack_bytes(binaryFile, (uint32_t)MESH_ANIMATION_VERSION);
+        pack_bytes(binaryFile, numFrames);
+        pack_bytes(binaryFile, keyframeInterval);
+
+        // Data shared by the frames
+        pack_vector_bytes(binaryFile, meshAnimation.indexBuffer);
+        pack_vector_bytes(binaryFile, meshAnimation.sharedVertices);
+        pack_bytes(binaryFile, meshAnimation.boundsMin);
+        pack_bytes(binaryFile, meshAnimation.boundsExtent);
+
+        // Key frames and deltas
+        for (uint32_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+        {
+            if (is_key_frame(frameIdx, keyframeInterval))
+                pack_vector_bytes(binaryFile, meshAnimation.frames[frameIdx]);
+            else
+                pack_frame_deltas(binaryFile, meshAnimation.frames[frameIdx - 1], meshAnimation.frames[frameIdx]);
+        }
+
+        write_file(path, binaryFile);
+    }
+
+    void quantize_mesh_animation(const MeshAnimation& meshAnimation, QuantizedMeshAnimation& quantizedAnimation)
+    {
+        const uint32_t numFrames = (uint32_t)meshAnimation.vertexBufferArray.size();
+        const uint32_t numVertices = numFrames > 0 ? (uint32_t)meshAnimation.vertexBufferArray[0].data.size() : 0;
+        quantizedAnimation.indexBuffer = meshAnimation.indexBuffer;
+
+        // The texture coordinates and materials of the first frame are kept
+        quantizedAnimation.sharedVertices.resize(numVertices);
+        for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+        {
+            quantizedAnimation.sharedVertices[vertIdx].texCoord = meshAnimation.vertexBufferArray[0].data[vertIdx].texCoord;
+            quantizedAnimation.sharedVertices[vertIdx].matID = meshAnimation.vertexBufferArray[0].data[vertIdx].matID;
+        }
+
+        // Bounds of every frame, flat axes keep a unit extent
+        float3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (const VertexBuffer& frame : meshAnimation.vertexBufferArray)
+        {
+            for (const VertexData& vertex : frame.data)
+            {
+                boundsMin = { std::min(boundsMin.x, vertex.position.x), std::min(boundsMin.y, vertex.position.y), std::min(boundsMin.z, vertex.position.z) };
+                boundsMax = { std::max(boundsMax.x, vertex.position.x), std::max(boundsMax.y, vertex.position.y), std::max(boundsMax.z, vertex.position.z) };
+            }
+        }
+        if (numVertices == 0)
+            boundsMin = boundsMax = { 0.0f, 0.0f, 0.0f };
+        quantizedAnimation.boundsMin = boundsMin;
+        quantizedAnimation.boundsExtent = { boundsMax.x > boundsMin.x ? boundsMax.x - boundsMin.x : 1.0f,
+            boundsMax.y > boundsMin.y ? boundsMax.y - boundsMin.y : 1.0f,
+            boundsMax.z > boundsMin.z ? boundsMax.z - boundsMin.z : 1.0f };
+
+        // Frames
+        const float3& extent = quantizedAnimation.boundsExtent;
+        quantizedAnimation.frames.resize(numFrames);
+        for (uint32_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+        {
+            const std::vector<VertexData>& vertices = meshAnimation.vertexBufferArray[frameIdx].data;
+            std::vector<QuantizedVertexData>& frame = quantizedAnimation.frames[frameIdx];
+            frame.resize(numVertices);
+            for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+            {
+                const VertexData& vertex = vertices[vertIdx];
+                QuantizedVertexData& quantized = frame[vertIdx];
+                quantized.position[0] = (uint16_t)roundf(std::min(std::max((vertex.position.x - boundsMin.x) / extent.x, 0.0f), 1.0f) * QUANTIZATION_RANGE);
+                quantized.position[1] = (uint16_t)roundf(std::min(std::max((vertex.position.y - boundsMin.y) / extent.y, 0.0f), 1.0f) * QUANTIZATION_RANGE);
+                quantized.position[2] = (uint16_t)roundf(std::min(std::max((vertex.position.z - boundsMin.z) / extent.z, 0.0f), 1.0f) * QUANTIZATION_RANGE);
+                encode_octahedral(vertex.normal, quantized.normal);
+                encode_octahedral(vertex.tangent, quantized.tangent);
+                quantized.padding = 0;
+            }
+        }
+    }
+
+    void dequantize_mesh_animation(const QuantizedMeshAnimation& quantizedAnimation, MeshAnimation& meshAnimation)
+    {
+        meshAnimation.indexBuffer = quantizedAnimation.indexBuffer;
+        meshAnimation.vertexBufferArray.resize(quantizedAnimation.frames.size());
+        for (uint32_t frameIdx = 0; frameIdx < (uint32_t)quantizedAnimation.frames.size(); ++frameIdx)
+            dequantize_frame(quantizedAnimation, frameIdx, meshAnimation.vertexBufferArray[frameIdx].data);
+    }
+
+    void dequantize_frame(const QuantizedMeshAnimation& quantizedAnimation, uint32_t frameIdx, std::vector<VertexData>& vertices)
+    {
+        const std::vector<QuantizedVertexData>& frame = quantizedAnimation.frames[frameIdx];
+        const uint32_t numVertices = (uint32_t)frame.size();
+        vertices.resize(numVertices);
+        uint32_t vertIdx = 0;
+#if defined(MESH_SSE2)
+        // Four vertices at a time, transposed to one register per component
+        const __m128 positionScaleX = _mm_set1_ps(quantizedAnimation.boundsExtent.x / QUANTIZATION_RANGE);
+        const __m128 positionScaleY = _mm_set1_ps(quantizedAnimation.boundsExtent.y / QUANTIZATION_RANGE);
+        const __m128 positionScaleZ = _mm_set1_ps(quantizedAnimation.boundsExtent.z / QUANTIZATION_RANGE);
+        const __m128 boundsMinX = _mm_set1_ps(quantizedAnimation.boundsMin.x);
+        const __m128 boundsMinY = _mm_set1_ps(quantizedAnimation.boundsMin.y);
+        const __m128 boundsMinZ = _mm_set1_ps(quantizedAnimation.boundsMin.z);
+        const __m128 octScale = _mm_set1_ps(2.0f / QUANTIZATION_RANGE);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128i zeroi = _mm_setzero_si128();
+        auto decode_octahedral_x4 = [&](__m128 u, __m128 v, __m128& x, __m128& y, __m128& z)
+        {
+            x = _mm_sub_ps(_mm_mul_ps(u, octScale), one);
+            y = _mm_sub_ps(_mm_mul_ps(v, octScale), one);
+            z = _mm_sub_ps(_mm_sub_ps(one, _mm_and_ps(x, absMask)), _mm_and_ps(y, absMask));
+            __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+            __m128 positiveX = _mm_cmpge_ps(x, zero);
+            __m128 positiveY = _mm_cmpge_ps(y, zero);
+            x = _mm_or_ps(_mm_and_ps(positiveX, _mm_sub_ps(x, t)), _mm_andnot_ps(positiveX, _mm_add_ps(x, t)));
+            y = _mm_or_ps(_mm_and_ps(positiveY, _mm_sub_ps(y, t)), _mm_andnot_ps(positiveY, _mm_add_ps(y, t)));
+            __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+            x = _mm_div_ps(x, len);
+            y = _mm_div_ps(y, len);
+            z = _mm_div_ps(z, len);
+        };
+        for (; vertIdx + 4 <= numVertices; vertIdx += 4)
+        {
+            // Rows of 8 components per vertex, low and high halves
+            __m128 low[4], high[4];
+            for (uint32_t laneIdx = 0; laneIdx < 4; ++laneIdx)
+            {
+                __m128i packed = _mm_loadu_si128((const __m128i*)&frame[vertIdx + laneIdx]);
+                low[laneIdx] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(packed, zeroi));
+                high[laneIdx] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(packed, zeroi));
+            }
+            _MM_TRANSPOSE4_PS(low[0], low[1], low[2], low[3]);
+            _MM_TRANSPOSE4_PS(high[0], high[1], high[2], high[3]);
+
+            // Attributes
+            __m128 positionX = _mm_add_ps(_mm_mul_ps(low[0], positionScaleX), boundsMinX);
+            __m128 positionY = _mm_add_ps(_mm_mul_ps(low[1], positionScaleY), boundsMinY);
+            __m128 positionZ = _mm_add_ps(_mm_mul_ps(low[2], positionScaleZ), boundsMinZ);
+            __m128 normalX, normalY, normalZ, tangentX, tangentY, tangentZ;
+            decode_octahedral_x4(low[3], high[0], normalX, normalY, normalZ);
+            decode_octahedral_x4(high[1], high[2], tangentX, tangentY, tangentZ);
+
+            // Back to the layout of VertexData, three float4 per vertex
+            const SharedVertexData* shared = &quantizedAnimation.sharedVertices[vertIdx];
+            __m128 texCoordX = _mm_setr_ps(shared[0].texCoord.x, shared[1].texCoord.x, shared[2].texCoord.x, shared[3].texCoord.x);
+            __m128 texCoordY = _mm_setr_ps(shared[0].texCoord.y, shared[1].texCoord.y, shared[2].texCoord.y, shared[3].texCoord.y);
+            __m128 matID = _mm_castsi128_ps(_mm_setr_epi32((int)shared[0].matID, (int)shared[1].matID, (int)shared[2].matID, (int)shared[3].matID));
+            _MM_TRANSPOSE4_PS(positionX, positionY, positionZ, normalX);
+            _MM_TRANSPOSE4_PS(normalY, normalZ, tangentX, tangentY);
+            _MM_TRANSPOSE4_PS(tangentZ, texCoordX, texCoordY, matID);
+            const __m128 data0[4] = { positionX, positionY, positionZ, normalX };
+            const __m128 data1[4] = { normalY, normalZ, tangentX, tangentY };
+            const __m128 data2[4] = { tangentZ, texCoordX, texCoordY, matID };
+            for (uint32_t laneIdx = 0; laneIdx < 4; ++laneIdx)
+            {
+                float* output = &vertices[vertIdx + laneIdx].position.x;
+                _mm_storeu_ps(output, data0[laneIdx]);
+                _mm_storeu_ps(output + 4, data1[laneIdx]);
+                _mm_storeu_ps(output + 8, data2[laneIdx]);
+            }
+        }
+#endif
+        for (; vertIdx < numVertices; ++vertIdx)
+            dequantize_vertex(quantizedAnimation, frame[vertIdx], quantizedAnimation.sharedVertices[vertIdx], vertices[vertIdx]);
+    }
+
+    void dequantize_frame_reference(const QuantizedMeshAnimation& quantizedAnimation, uint32_t frameIdx, std::vector<VertexData>& vertices)
+    {
+        const std::vector<QuantizedVertexData>& frame = quantizedAnimation.frames[frameIdx];
+        vertices.resize(frame.size());
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)frame.size(); ++vertIdx)
+            dequantize_vertex(quantizedAnimation, frame[vertIdx], quantizedAnimation.sharedVertices[vertIdx], vertices[vertIdx]);
+    }
+
+    uint32_t unpack_quantized_header(const char*& stream, QuantizedMeshAnimation& meshAnimation, uint32_t& keyframeInterval)
+    {
+        // Header
+        uint32_t magic, version, numFrames;
+        unpack_bytes(stream, magic);
+        unpack_bytes(stream, version);
+        unpack_bytes(stream, numFrames);
+        unpack_bytes(stream, keyframeInterval);
+
+        // Data shared by the frames
+        unpack_vector_bytes(stream, meshAnimation.indexBuffer);
+        unpack_vector_bytes(stream, meshAnimation.sharedVertices);
+        unpack_bytes(stream, meshAnimation.boundsMin);
+        unpack_bytes(stream, meshAnimation.boundsExtent);
+        meshAnimation.frames.clear();
+        return numFrames;
+    }
+
+    bool is_key_frame(uint32_t frameIdx, uint32_t keyframeInterval)
+    {
+        return keyframeInterval == 0 || frameIdx % keyframeInterval == 0;
+    }
+
+    void unpack_quantized_frame(const char*& stream, bool keyFrame, const std::vector<QuantizedVertexData>& previousFrame, std::vector<QuantizedVertexData>& frame)
+    {
+        if (keyFrame)
+            unpack_vector_bytes(stream, frame);
+        else
+            unpack_frame_deltas(stream, previousFrame, frame);
+    }
+
+    void skip_quantized_frame(const char*& stream, bool keyFrame)
+    {
+        size_t numElements;
+        unpack_bytes(stream, numElements);
+        stream += numElements * (keyFrame ? sizeof(QuantizedVertexData) : sizeof(uint8_t));
     }
 }
\ No newline at end of file
@@ -0,0 +1,455 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "scene/mesh_optimizer.h"
+#include "math/operators.h"
+
+// System includes
+#include <algorithm>
+#include <math.h>
+
+// Triangles using every vertex, in CSR form
+struct VertexAdjacency
+{
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+static void build_adjacency(const std::vector<uint3>& indices, uint32_t numVertices, VertexAdjacency& adjacency)
+{
+    adjacency.offsets.assign(numVertices + 1, 0);
+    for (const uint3& triangle : indices)
+    {
+        adjacency.offsets[triangle.x + 1]++;
+        adjacency.offsets[triangle.y + 1]++;
+        adjacency.offsets[triangle.z + 1]++;
+    }
+    for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+        adjacency.offsets[vertIdx + 1] += adjacency.offsets[vertIdx];
+
+    std::vector<uint32_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    adjacency.triangles.resize(indices.size() * 3);
+    for (uint32_t triIdx = 0; triIdx < (uint32_t)indices.size(); ++triIdx)
+    {
+        adjacency.triangles[cursor[indices[triIdx].x]++] = triIdx;
+        adjacency.triangles[cursor[indices[triIdx].y]++] = triIdx;
+        adjacency.triangles[cursor[indices[triIdx].z]++] = triIdx;
+    }
+}
+
+// FIFO cache, returns the number of misses of a triangle
+static uint32_t simulate_fifo(const uint3& triangle, std::vector<uint32_t>& timestamps, uint32_t& time, uint32_t cacheSize)
+{
+    uint32_t misses = 0;
+    const uint32_t vertices[3] = { triangle.x, triangle.y, triangle.z };
+    for (uint32_t vertIdx : vertices)
+    {
+        if (time - timestamps[vertIdx] > cacheSize)
+        {
+            timestamps[vertIdx] = time++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+static void triangle_geometry(const uint3& triangle, const std::vector<float3>& positions, float3& centroid, float3& normal, float& area)
+{
+    const float3& p0 = positions[triangle.x];
+    const float3& p1 = positions[triangle.y];
+    const float3& p2 = positions[triangle.z];
+    normal = cross(p1 - p0, p2 - p0);
+    area = length(normal) * 0.5f;
+    centroid = (p0 + p1 + p2) * (1.0f / 3.0f);
+}
+
+// Tipsify, overdraw and fetch ordering of the triangles of a mesh. The input triangle order is restored when the optimized one
+// transforms or fetches more, and the remap is only kept when it fetches less than the vertex order it replaces.
+static MeshOptimizerResult optimize_indices(std::vector<uint3>& indices, const std::vector<float3>& positions, uint32_t vertexSize, const MeshOptimizerOptions& options, std::vector<uint32_t>& remap)
+{
+    MeshOptimizerResult result;
+    const uint32_t numVertices = (uint32_t)positions.size();
+    const std::vector<uint3> inputIndices = indices;
+    const float inputACMR = mesh_optimizer::analyze_vertex_cache(indices, numVertices, options.cacheSize).acmr;
+    const uint64_t inputFetch = mesh_optimizer::analyze_vertex_fetch(indices, numVertices, vertexSize).fetchedBytes;
+
+    // Triangles
+    std::vector<uint32_t> clusters;
+    mesh_optimizer::optimize_vertex_cache(indices, numVertices, options.cacheSize, &clusters);
+    mesh_optimizer::optimize_overdraw(indices, positions, clusters, options.cacheSize, options.overdrawThreshold);
+    const float acmr = mesh_optimizer::analyze_vertex_cache(indices, numVertices, options.cacheSize).acmr;
+
+    // Vertices, in order of first use of the reordered triangles
+    uint64_t fetch = mesh_optimizer::analyze_vertex_fetch(indices, numVertices, vertexSize).fetchedBytes;
+    std::vector<uint3> remappedIndices;
+    uint64_t remappedFetch = UINT64_MAX;
+    if (options.optimizeFetch)
+    {
+        remappedIndices = indices;
+        mesh_optimizer::optimize_vertex_fetch(remappedIndices, numVertices, remap);
+        remappedFetch = mesh_optimizer::analyze_vertex_fetch(remappedIndices, numVertices, vertexSize).fetchedBytes;
+    }
+    result.reorderedTriangles = acmr <= inputACMR && std::min(fetch, remappedFetch) <= inputFetch;
+
+    // Back to the input triangles, their own first use order may still fetch less than the input vertex order
+    if (!result.reorderedTriangles)
+    {
+        indices = inputIndices;
+        fetch = inputFetch;
+        if (options.optimizeFetch)
+        {
+            remappedIndices = indices;
+            mesh_optimizer::optimize_vertex_fetch(remappedIndices, numVertices, remap);
+            remappedFetch = mesh_optimizer::analyze_vertex_fetch(remappedIndices, numVertices, vertexSize).fetchedBytes;
+        }
+    }
+    result.remappedVertices = options.optimizeFetch && remappedFetch < fetch;
+    if (result.remappedVertices)
+        indices.swap(remappedIndices);
+    return result;
+}
+
+namespace mesh_optimizer
+{
+    void optimize_vertex_cache(std::vector<uint3>& indices, uint32_t numVertices, uint32_t cacheSize, std::vector<uint32_t>* clusters)
+    {
+        const uint32_t numTriangles = (uint32_t)indices.size();
+        if (clusters != nullptr)
+            clusters->clear();
+        if (numTriangles == 0)
+            return;
+
+        VertexAdjacency adjacency;
+        build_adjacency(indices, numVertices, adjacency);
+
+        // Live triangles per vertex, cache time stamps, dead end stack
+        std::vector<uint32_t> liveTriangles(numVertices);
+        for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+            liveTriangles[vertIdx] = adjacency.offsets[vertIdx + 1] - adjacency.offsets[vertIdx];
+        std::vector<uint32_t> timestamps(numVertices, 0);
+        std::vector<uint32_t> deadEnds;
+        std::vector<bool> emitted(numTriangles, false);
+        std::vector<uint32_t> candidates;
+        std::vector<uint3> output;
+        output.reserve(numTriangles);
+
+        uint32_t time = cacheSize + 1;
+        uint32_t cursor = 0;
+        uint32_t fanningVertex = 0;
+        while (liveTriangles[fanningVertex] == 0 && fanningVertex + 1 < numVertices)
+            fanningVertex++;
+        if (clusters != nullptr)
+            clusters->push_back(0);
+
+        while (fanningVertex != UINT32_MAX)
+        {
+            // Emit every remaining triangle around the fanning vertex
+            candidates.clear();
+            for (uint32_t adjIdx = adjacency.offsets[fanningVertex]; adjIdx < adjacency.offsets[fanningVertex + 1]; ++adjIdx)
+            {
+                uint32_t triIdx = adjacency.triangles[adjIdx];
+                if (emitted[triIdx])
+                    continue;
+                emitted[triIdx] = true;
+                const uint3& triangle = indices[triIdx];
+                output.push_back(triangle);
+                const uint32_t vertices[3] = { triangle.x, triangle.y, triangle.z };
+                for (uint32_t vertIdx : vertices)
+                {
+                    deadEnds.push_back(vertIdx);
+                    candidates.push_back(vertIdx);
+                    liveTriangles[vertIdx]--;
+                    if (time - timestamps[vertIdx] > cacheSize)
+                        timestamps[vertIdx] = time++;
+                }
+            }
+
+            // Next fanning vertex: the candidate that stays the longest in the cache once fanned
+            uint32_t nextVertex = UINT32_MAX;
+            int32_t bestPriority = -1;
+            for (uint32_t vertIdx : candidates)
+            {
+                if (liveTriangles[vertIdx] == 0)
+                    continue;
+                int32_t priority = 0;
+                if (time - timestamps[vertIdx] + 2 * liveTriangles[vertIdx] <= cacheSize)
+                    priority = (int32_t)(time - timestamps[vertIdx]);
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    nextVertex = vertIdx;
+                }
+            }
+
+            // Dead end, the recently used vertices first, then the input order. A new cluster starts there
+            if (nextVertex == UINT32_MAX)
+            {
+                while (!deadEnds.empty() && nextVertex == UINT32_MAX)
+                {
+                    uint32_t vertIdx = deadEnds.back();
+                    deadEnds.pop_back();
+                    if (liveTriangles[vertIdx] > 0)
+                        nextVertex = vertIdx;
+                }
+                while (nextVertex == UINT32_MAX && cursor < numVertices)
+                {
+                    if (liveTriangles[cursor] > 0)
+                        nextVertex = cursor;
+                    cursor++;
+                }
+                if (nextVertex != UINT32_MAX && clusters != nullptr)
+                    clusters->push_back((uint32_t)output.size());
+            }
+            fanningVertex = nextVertex;
+        }
+        indices.swap(output);
+    }
+
+    void optimize_overdraw(std::vector<uint3>& indices, const std::vector<float3>& positions, const std::vector<uint32_t>& clusters, uint32_t cacheSize, float threshold)
+    {
+        const uint32_t numTriangles = (uint32_t)indices.size();
+        if (numTriangles == 0 || threshold < 1.0f)
+            return;
+
+        // Soft boundaries: a cluster is cut as soon as its running ACMR is within the threshold of the ACMR of the whole cluster
+        std::vector<uint32_t> softClusters;
+        std::vector<uint32_t> timestamps(positions.size(), 0);
+        uint32_t time = cacheSize + 1;
+        for (uint32_t clusterIdx = 0; clusterIdx < (uint32_t)clusters.size(); ++clusterIdx)
+        {
+            const uint32_t begin = clusters[clusterIdx];
+            const uint32_t end = clusterIdx + 1 < clusters.size() ? clusters[clusterIdx + 1] : numTriangles;
+
+            // ACMR of the whole cluster, starting from an empty cache
+            time += cacheSize + 1;
+            uint32_t clusterMisses = 0;
+            for (uint32_t triIdx = begin; triIdx < end; ++triIdx)
+                clusterMisses += simulate_fifo(indices[triIdx], timestamps, time, cacheSize);
+            const float clusterACMR = clusterMisses / (float)(end - begin);
+
+            time += cacheSize + 1;
+            softClusters.push_back(begin);
+            uint32_t misses = 0, start = begin;
+            for (uint32_t triIdx = begin; triIdx < end; ++triIdx)
+            {
+                misses += simulate_fifo(indices[triIdx], timestamps, time, cacheSize);
+                if (triIdx + 1 < end && misses / (float)(triIdx + 1 - start) <= clusterACMR * threshold)
+                {
+                    softClusters.push_back(triIdx + 1);
+                    start = triIdx + 1;
+                    misses = 0;
+                    time += cacheSize + 1;
+                }
+            }
+        }
+
+        // Center of the mesh, area weighted
+        float3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+        float meshArea = 0.0f, orientation = 0.0f;
+        for (const uint3& triangle : indices)
+        {
+            float3 centroid, normal;
+            float area;
+            triangle_geometry(triangle, positions, centroid, normal, area);
+            meshCentroid = meshCentroid + centroid * area;
+            meshArea += area;
+        }
+        meshCentroid = meshCentroid * (meshArea > 0.0f ? 1.0f / meshArea : 0.0f);
+
+        // Occlusion potential of every cluster: how much its surface faces away from the center
+        const uint32_t numClusters = (uint32_t)softClusters.size();
+        std::vector<float> potentials(numClusters);
+        for (uint32_t clusterIdx = 0; clusterIdx < numClusters; ++clusterIdx)
+        {
+            const uint32_t begin = softClusters[clusterIdx];
+            const uint32_t end = clusterIdx + 1 < numClusters ? softClusters[clusterIdx + 1] : numTriangles;
+            float3 clusterCentroid = { 0.0f, 0.0f, 0.0f };
+            float3 clusterNormal = { 0.0f, 0.0f, 0.0f };
+            float clusterArea = 0.0f;
+            for (uint32_t triIdx = begin; triIdx < end; ++triIdx)
+            {
+                float3 centroid, normal;
+                float area;
+                triangle_geometry(indices[triIdx], positions, centroid, normal, area);
+                clusterCentroid = clusterCentroid + centroid * area;
+                clusterNormal = clusterNormal + normal;
+                clusterArea += area;
+            }
+            clusterCentroid = clusterCentroid * (clusterArea > 0.0f ? 1.0f / clusterArea : 0.0f);
+            float normalLength = length(clusterNormal);
+            potentials[clusterIdx] = normalLength > 0.0f ? dot(clusterCentroid - meshCentroid, clusterNormal) / normalLength : 0.0f;
+            orientation += dot(clusterCentroid - meshCentroid, clusterNormal);
+        }
+
+        // The winding of the mesh decides which side of the triangles is the outside
+        if (orientation < 0.0f)
+        {
+            for (float& potential : potentials)
+                potential = -potential;
+        }
+
+        // Outer clusters first
+        std::vector<uint32_t> order(numClusters);
+        for (uint32_t clusterIdx = 0; clusterIdx < numClusters; ++clusterIdx)
+            order[clusterIdx] = clusterIdx;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return potentials[a] > potentials[b]; });
+        std::vector<uint3> output;
+        output.reserve(numTriangles);
+        for (uint32_t clusterIdx : order)
+        {
+            const uint32_t begin = softClusters[clusterIdx];
+            const uint32_t end = clusterIdx + 1 < numClusters ? softClusters[clusterIdx + 1] : numTriangles;
+            output.insert(output.end(), indices.begin() + begin, indices.begin() + end);
+        }
+        indices.swap(output);
+    }
+
+    uint32_t optimize_vertex_fetch(std::vector<uint3>& indices, uint32_t numVertices, std::vector<uint32_t>& remap)
+    {
+        remap.assign(numVertices, UINT32_MAX);
+        uint32_t nextIndex = 0;
+        for (uint3& triangle : indices)
+        {
+            uint32_t* vertices = &triangle.x;
+            for (uint32_t cornerIdx = 0; cornerIdx < 3; ++cornerIdx)
+            {
+                if (remap[vertices[cornerIdx]] == UINT32_MAX)
+                    remap[vertices[cornerIdx]] = nextIndex++;
+                vertices[cornerIdx] = remap[vertices[cornerIdx]];
+            }
+        }
+        const uint32_t numReferenced = nextIndex;
+        for (uint32_t& index : remap)
+        {
+            if (index == UINT32_MAX)
+                index = nextIndex++;
+        }
+        return numReferenced;
+    }
+
+    void remap_vertices(MeshAnimation& animation, const std::vector<uint32_t>& remap)
+    {
+        std::vector<VertexData> vertices;
+        for (VertexBuffer& frame : animation.vertexBufferArray)
+        {
+            vertices.resize(frame.data.size());
+            for (uint32_t vertIdx = 0; vertIdx < (uint32_t)frame.data.size(); ++vertIdx)
+                vertices[remap[vertIdx]] = frame.data[vertIdx];
+            frame.data.swap(vertices);
+        }
+    }
+
+    void remap_vertices(QuantizedMeshAnimation& animation, const std::vector<uint32_t>& remap)
+    {
+        std::vector<SharedVertexData> sharedVertices(animation.sharedVertices.size());
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)sharedVertices.size(); ++vertIdx)
+            sharedVertices[remap[vertIdx]] = animation.sharedVertices[vertIdx];
+        animation.sharedVertices.swap(sharedVertices);
+
+        std::vector<QuantizedVertexData> vertices;
+        for (std::vector<QuantizedVertexData>& frame : animation.frames)
+        {
+            vertices.resize(frame.size());
+            for (uint32_t vertIdx = 0; vertIdx < (uint32_t)frame.size(); ++vertIdx)
+                vertices[remap[vertIdx]] = frame[vertIdx];
+            frame.swap(vertices);
+        }
+    }
+
+    MeshOptimizerResult optimize_mesh_animation(MeshAnimation& animation, const MeshOptimizerOptions& options)
+    {
+        if (animation.vertexBufferArray.empty())
+            return MeshOptimizerResult();
+        const std::vector<VertexData>& restPose = animation.vertexBufferArray[0].data;
+        std::vector<float3> positions(restPose.size());
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)restPose.size(); ++vertIdx)
+            positions[vertIdx] = restPose[vertIdx].position;
+
+        std::vector<uint32_t> remap;
+        const MeshOptimizerResult result = optimize_indices(animation.indexBuffer, positions, sizeof(VertexData), options, remap);
+        if (result.remappedVertices)
+            remap_vertices(animation, remap);
+        return result;
+    }
+
+    MeshOptimizerResult optimize_mesh_animation(QuantizedMeshAnimation& animation, const MeshOptimizerOptions& options)
+    {
+        if (animation.frames.empty())
+            return MeshOptimizerResult();
+        std::vector<VertexData> restPose;
+        mesh::dequantize_frame_reference(animation, 0, restPose);
+        std::vector<float3> positions(animation.sharedVertices.size());
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)positions.size(); ++vertIdx)
+            positions[vertIdx] = restPose[vertIdx].position;
+
+        std::vector<uint32_t> remap;
+        const MeshOptimizerResult result = optimize_indices(animation.indexBuffer, positions, sizeof(QuantizedVertexData), options, remap);
+        if (result.remappedVertices)
+            remap_vertices(animation, remap);
+        return result;
+    }
+
+    VertexCacheStats analyze_vertex_cache(const std::vector<uint3>& indices, uint32_t numVertices, uint32_t cacheSize)
+    {
+        VertexCacheStats stats;
+        std::vector<uint32_t> timestamps(numVertices, 0);
+        std::vector<bool> referenced(numVertices, false);
+        uint32_t time = cacheSize + 1;
+        uint32_t numReferenced = 0;
+        for (const uint3& triangle : indices)
+        {
+            stats.transformedVertices += simulate_fifo(triangle, timestamps, time, cacheSize);
+            const uint32_t vertices[3] = { triangle.x, triangle.y, triangle.z };
+            for (uint32_t vertIdx : vertices)
+            {
+                numReferenced += referenced[vertIdx] ? 0 : 1;
+                referenced[vertIdx] = true;
+            }
+        }
+        stats.acmr = indices.empty() ? 0.0f : stats.transformedVertices / (float)indices.size();
+        stats.atvr = numReferenced == 0 ? 0.0f : stats.transformedVertices / (float)numReferenced;
+        return stats;
+    }
+
+    VertexFetchStats analyze_vertex_fetch(const std::vector<uint3>& indices, uint32_t numVertices, uint32_t vertexSize)
+    {
+        // FIFO of cache lines
+        VertexFetchStats stats;
+        const uint64_t numLines = ((uint64_t)numVertices * vertexSize + MESH_OPTIMIZER_FETCH_LINE_SIZE - 1) / MESH_OPTIMIZER_FETCH_LINE_SIZE;
+        std::vector<uint32_t> timestamps(numLines, 0);
+        std::vector<bool> referenced(numVertices, false);
+        uint32_t time = MESH_OPTIMIZER_FETCH_CACHE_LINES + 1;
+        uint64_t referencedBytes = 0;
+        for (const uint3& triangle : indices)
+        {
+            const uint32_t vertices[3] = { triangle.x, triangle.y, triangle.z };
+            for (uint32_t vertIdx : vertices)
+            {
+                if (!referenced[vertIdx])
+                {
+                    referenced[vertIdx] = true;
+                    referencedBytes += vertexSize;
+                }
+
+                // Lines overlapped by the vertex
+                const uint64_t firstLine = (uint64_t)vertIdx * vertexSize / MESH_OPTIMIZER_FETCH_LINE_SIZE;
+                const uint64_t lastLine = ((uint64_t)vertIdx * vertexSize + vertexSize - 1) / MESH_OPTIMIZER_FETCH_LINE_SIZE;
+                for (uint64_t lineIdx = firstLine; lineIdx <= lastLine; ++lineIdx)
+                {
+                    if (time - timestamps[lineIdx] > MESH_OPTIMIZER_FETCH_CACHE_LINES)
+                    {
+                        timestamps[lineIdx] = time++;
+                        stats.fetchedBytes += MESH_OPTIMIZER_FETCH_LINE_SIZE;
+                    }
+                }
+            }
+        }
+        stats.overfetch = referencedBytes == 0 ? 0.0f : stats.fetchedBytes / (float)referencedBytes;
+        return stats;
+    }
+}
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "scene/meshlet.h"
+#include "math/operators.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <algorithm>
+#include <math.h>
+
+// Triangles using every vertex, in CSR form
+struct VertexAdjacency
+{
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+static void build_adjacency(const std::vector<uint3>& indices, uint32_t numVertices, VertexAdjacency& adjacency)
+{
+    adjacency.offsets.assign(numVertices + 1, 0);
+    for (const uint3& triangle : indices)
+    {
+        adjacency.offsets[triangle.x + 1]++;
+        adjacency.offsets[triangle.y + 1]++;
+        adjacency.offsets[triangle.z + 1]++;
+    }
+    for (uint32_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+        adjacency.offsets[vertIdx + 1] += adjacency.offsets[vertIdx];
+
+    std::vector<uint32_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    adjacency.triangles.resize(indices.size() * 3);
+    for (uint32_t triIdx = 0; triIdx < (uint32_t)indices.size(); ++triIdx)
+    {
+        adjacency.triangles[cursor[indices[triIdx].x]++] = triIdx;
+        adjacency.triangles[cursor[indices[triIdx].y]++] = triIdx;
+        adjacency.triangles[cursor[indices[triIdx].z]++] = triIdx;
+    }
+}
+
+// Normal of the side the visibility pass keeps. The front faces are counter clockwise on the render target,
+// which flips y, so they are clockwise around this normal in world space.
+static float3 front_normal(const std::vector<float3>& positions, const uint3& triangle)
+{
+    const float3& p0 = positions[triangle.x];
+    return cross(positions[triangle.z] - p0, positions[triangle.y] - p0);
+}
+
+namespace meshlet
+{
+    void build(const std::vector<uint3>& indices, const std::vector<float3>& positions, MeshletMesh& mesh)
+    {
+        const uint32_t numTriangles = (uint32_t)indices.size();
+        const uint32_t numVertices = (uint32_t)positions.size();
+        mesh.meshlets.clear();
+        mesh.vertices.clear();
+        mesh.triangles.clear();
+        mesh.triangles.reserve(numTriangles);
+
+        VertexAdjacency adjacency;
+        build_adjacency(indices, numVertices, adjacency);
+
+        // Unit normals and centroids of the triangles, a degenerate triangle has a null normal
+        std::vector<float3> normals(numTriangles);
+        std::vector<float3> centroids(numTriangles);
+        for (uint32_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+        {
+            const uint3& triangle = indices[triIdx];
+            const float3 normal = front_normal(positions, triangle);
+            const float normalLength = length(normal);
+            normals[triIdx] = normalLength > 0.0f ? normal / normalLength : float3({ 0.0f, 0.0f, 0.0f });
+            centroids[triIdx] = (positions[triangle.x] + positions[triangle.y] + positions[triangle.z]) / 3.0f;
+        }
+
+        // Stamps of the meshlet a vertex or a candidate triangle was last added to
+        std::vector<uint32_t> vertexStamp(numVertices, UINT32_MAX);
+        std::vector<uint32_t> candidateStamp(numTriangles, UINT32_MAX);
+        std::vector<uint8_t> emitted(numTriangles, 0);
+        std::vector<uint32_t> candidates;
+        uint32_t seedIdx = 0;
+        while (true)
+        {
+            // The meshlets start from the first triangle left, in the order of the index buffer
+            while (seedIdx < numTriangles && emitted[seedIdx])
+                seedIdx++;
+            if (seedIdx == numTriangles)
+                break;
+
+            const uint32_t meshletIdx = (uint32_t)mesh.meshlets.size();
+            Meshlet meshlet = { (uint32_t)mesh.vertices.size(), 0, (uint32_t)mesh.triangles.size(), 0 };
+            float3 normalSum = { 0.0f, 0.0f, 0.0f };
+            float3 centroidSum = { 0.0f, 0.0f, 0.0f };
+            candidates.clear();
+
+            uint32_t triIdx = seedIdx;
+            while (triIdx != UINT32_MAX)
+            {
+                // Add the triangle, its neighbors become candidates
+                emitted[triIdx] = 1;
+                mesh.triangles.push_back(triIdx);
+                meshlet.triangleCount++;
+                normalSum = normalSum + normals[triIdx];
+                centroidSum = centroidSum + centroids[triIdx];
+                for (uint32_t cornerIdx = 0; cornerIdx < 3; ++cornerIdx)
+                {
+                    const uint32_t vertIdx = at(indices[triIdx], cornerIdx);
+                    if (vertexStamp[vertIdx] == meshletIdx)
+                        continue;
+                    vertexStamp[vertIdx] = meshletIdx;
+                    mesh.vertices.push_back(vertIdx);
+                    meshlet.vertexCount++;
+                    for (uint32_t adjIdx = adjacency.offsets[vertIdx]; adjIdx < adjacency.offsets[vertIdx + 1]; ++adjIdx)
+                    {
+                        const uint32_t neighborIdx = adjacency.triangles[adjIdx];
+                        if (!emitted[neighborIdx] && candidateStamp[neighborIdx] != meshletIdx)
+                        {
+                            candidateStamp[neighborIdx] = meshletIdx;
+                            candidates.push_back(neighborIdx);
+                        }
+                    }
+                }
+                if (meshlet.triangleCount == MESHLET_MAX_TRIANGLES)
+                    break;
+
+                // Fewest new vertices first, then the closest triangle weighted by how much its normal diverges from the meshlet
+                const float normalSumLength = length(normalSum);
+                const float3 axis = normalSumLength > 0.0f ? normalSum / normalSumLength : normalSum;
+                const float3 center = centroidSum / (float)meshlet.triangleCount;
+                triIdx = UINT32_MAX;
+                uint32_t bestNewVertices = 4;
+                float bestCost = 0.0f;
+                for (uint32_t candIdx = 0; candIdx < (uint32_t)candidates.size();)
+                {
+                    const uint32_t candidate = candidates[candIdx];
+                    if (emitted[candidate])
+                    {
+                        candidates[candIdx] = candidates.back();
+                        candidates.pop_back();
+                        continue;
+                    }
+                    candIdx++;
+
+                    const uint3& triangle = indices[candidate];
+                    const uint32_t newVertices = (vertexStamp[triangle.x] != meshletIdx ? 1 : 0) + (vertexStamp[triangle.y] != meshletIdx ? 1 : 0)
+                        + (vertexStamp[triangle.z] != meshletIdx ? 1 : 0);
+                    if (meshlet.vertexCount + newVertices > MESHLET_MAX_VERTICES || newVertices > bestNewVertices)
+                        continue;
+                    const float cost = length(centroids[candidate] - center) * (2.0f - dot(normals[candidate], axis));
+                    if (newVertices < bestNewVertices || cost < bestCost)
+                    {
+                        triIdx = candidate;
+                        bestNewVertices = newVertices;
+                        bestCost = cost;
+                    }
+                }
+            }
+            mesh.meshlets.push_back(meshlet);
+        }
+    }
+
+    static MeshletBounds meshlet_bounds(const MeshletMesh& mesh, const Meshlet& meshlet, const std::vector<uint3>& indices, const std::vector<float3>& positions)
+    {
+        MeshletBounds bounds;
+
+        // Sphere around the center of the box
+        float3 minP = positions[mesh.vertices[meshlet.vertexOffset]];
+        float3 maxP = minP;
+        for (uint32_t vertIdx = 1; vertIdx < meshlet.vertexCount; ++vertIdx)
+        {
+            const float3& position = positions[mesh.vertices[meshlet.vertexOffset + vertIdx]];
+            minP = min(minP, position);
+            maxP = max(maxP, position);
+        }
+        bounds.center = (minP + maxP) * 0.5f;
+        float radius2 = 0.0f;
+        for (uint32_t vertIdx = 0; vertIdx < meshlet.vertexCount; ++vertIdx)
+        {
+            const float3 offset = positions[mesh.vertices[meshlet.vertexOffset + vertIdx]] - bounds.center;
+            radius2 = std::max(radius2, dot(offset, offset));
+        }
+        bounds.radius = sqrtf(radius2);
+
+        // Cone of the unit normals, the degenerate triangles face every direction and are ignored
+        float3 normals[MESHLET_MAX_TRIANGLES];
+        uint32_t numNormals = 0;
+        float3 normalSum = { 0.0f, 0.0f, 0.0f };
+        for (uint32_t triIdx = 0; triIdx < meshlet.triangleCount; ++triIdx)
+        {
+            const float3 normal = front_normal(positions, indices[mesh.triangles[meshlet.triangleOffset + triIdx]]);
+            const float normalLength = length(normal);
+            if (normalLength > 0.0f)
+            {
+                normals[numNormals] = normal / normalLength;
+                normalSum = normalSum + normals[numNormals++];
+            }
+        }
+        const float normalSumLength = length(normalSum);
+        bounds.coneAxis = normalSumLength > 0.0f ? normalSum / normalSumLength : float3({ 0.0f, 0.0f, 1.0f });
+        float minDot = normalSumLength > 0.0f ? 1.0f : -1.0f;
+        for (uint32_t normalIdx = 0; normalIdx < numNormals; ++normalIdx)
+            minDot = std::min(minDot, dot(normals[normalIdx], bounds.coneAxis));
+        bounds.coneCutoff = minDot < MESHLET_MIN_CONE_SPREAD ? 1.0f : std::min(sqrtf(1.0f - minDot * minDot) + MESHLET_CONE_SLACK, 1.0f);
+        return bounds;
+    }
+
+    void compute_bounds(const MeshletMesh& mesh, const std::vector<uint3>& indices, const std::vector<float3>& positions, std::vector<MeshletBounds>& bounds)
+    {
+        bounds.resize(mesh.meshlets.size());
+        task_scheduler::parallel_for(0, (uint32_t)mesh.meshlets.size(), [&](uint32_t first, uint32_t last)
+            {
+                for (uint32_t meshletIdx = first; meshletIdx < last; ++meshletIdx)
+                    bounds[meshletIdx] = meshlet_bounds(mesh, mesh.meshlets[meshletIdx], indices, positions);
+            }, MESHLET_GRAIN_SIZE);
+    }
+
+    MeshletCullingView culling_view(const float4x4& viewProjection, const float3& cameraPosition)
+    {
+        // Rows of the clip space transform of mul_transpose
+        const float4 rowX = { viewProjection.m[0], viewProjection.m[4], viewProjection.m[8], viewProjection.m[12] };
+        const float4 rowY = { viewProjection.m[1], viewProjection.m[5], viewProjection.m[9], viewProjection.m[13] };
+        const float4 rowW = { viewProjection.m[3], viewProjection.m[7], viewProjection.m[11], viewProjection.m[15] };
+
+        // Left, right, bottom and top planes. They meet at the camera so they also reject what is behind it,
+        // the far plane is far enough to be ignored
+        MeshletCullingView view;
+        view.cameraPosition = cameraPosition;
+        view.planes[0] = rowW + rowX;
+        view.planes[1] = rowW - rowX;
+        view.planes[2] = rowW + rowY;
+        view.planes[3] = rowW - rowY;
+        for (uint32_t planeIdx = 0; planeIdx < 4; ++planeIdx)
+        {
+            // Unit normal, moved from the camera relative space to world space
+            float4& plane = view.planes[planeIdx];
+            plane = plane / length(xyz(plane));
+            plane.w -= dot(xyz(plane), cameraPosition);
+        }
+        return view;
+    }
+
+    bool frustum_visible(const MeshletBounds& bounds, const MeshletCullingView& view)
+    {
+        for (uint32_t planeIdx = 0; planeIdx < 4; ++planeIdx)
+        {
+            const float4& plane = view.planes[planeIdx];
+            if (dot(xyz(plane), bounds.center) + plane.w < -bounds.radius)
+                return false;
+        }
+        return true;
+    }
+
+    bool cone_visible(const MeshletBounds& bounds, const MeshletCullingView& view)
+    {
+        // Every point of the sphere sees the back of every triangle of the cone
+        const float3 direction = bounds.center - view.cameraPosition;
+        return dot(direction, bounds.coneAxis) < bounds.coneCutoff * length(direction) + bounds.radius;
+    }
+
+    MeshletCullingStats cull(const MeshletMesh& mesh, const std::vector<MeshletBounds>& bounds, const MeshletCullingView& view, std::vector<uint32_t>& visible)
+    {
+        MeshletCullingStats stats;
+        visible.clear();
+        for (uint32_t meshletIdx = 0; meshletIdx < (uint32_t)mesh.meshlets.size(); ++meshletIdx)
+        {
+            if (!frustum_visible(bounds[meshletIdx], view))
+            {
+                stats.frustumCulled++;
+                continue;
+            }
+            if (!cone_visible(bounds[meshletIdx], view))
+            {
+                stats.backfaceCulled++;
+                continue;
+            }
+            const Meshlet& meshlet = mesh.meshlets[meshletIdx];
+            visible.insert(visible.end(), mesh.triangles.begin() + meshlet.triangleOffset, mesh.triangles.begin() + meshlet.triangleOffset + meshlet.triangleCount);
+            stats.visibleMeshlets++;
+            stats.visibleTriangles += meshlet.triangleCount;
+        }
+        return stats;
+    }
+}
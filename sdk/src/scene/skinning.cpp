@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "math/operators.h"
+#include "scene/skinning.h"
+#include "tools/cpu_features.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <string.h>
+#if defined(_M_X64) || defined(__SSE2__)
+#define SKINNING_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+#define SKINNING_AVX2
+#endif
+
+// VertexData seen as the three float4 of SkinMesh.compute
+#define SKINNING_VERTEX_FLOATS 12
+static_assert(sizeof(VertexData) == SKINNING_VERTEX_FLOATS * sizeof(float), "VertexData has to match data0..2 of SkinMesh.compute");
+
+#if defined(SKINNING_AVX2)
+// Queried once, the SSE2 loops skin whatever the AVX2 kernels leave
+static const bool s_UseAVX2 = cpu_features::avx2();
+#endif
+
+// Same formulation as lerp in math/operators.h so that both paths produce identical results
+static float lerp_scalar(float v0, float v1, float f, float c)
+{
+    return v0 * c + v1 * f;
+}
+
+static void skin_vertex_range(const float* verticesA, const float* verticesB, float* output, uint32_t first, uint32_t last, float interpolationFactor)
+{
+    const float complement = 1.0f - interpolationFactor;
+    uint32_t vertIdx = first;
+#if defined(SKINNING_AVX2)
+    if (s_UseAVX2)
+        vertIdx = skinning::skin_vertex_range_avx2(verticesA, verticesB, output, first, last, interpolationFactor);
+#endif
+#if defined(SKINNING_SSE2)
+    const __m128 f = _mm_set1_ps(interpolationFactor);
+    const __m128 c = _mm_set1_ps(complement);
+    // Clears the last lane of data2 before the blend, the material ID is an integer that would be a denormal float
+    const __m128 data2Mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    for (; vertIdx < last; ++vertIdx)
+    {
+        const float* a = verticesA + vertIdx * SKINNING_VERTEX_FLOATS;
+        const float* b = verticesB + vertIdx * SKINNING_VERTEX_FLOATS;
+        float* o = output + vertIdx * SKINNING_VERTEX_FLOATS;
+        _mm_storeu_ps(o, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a), c), _mm_mul_ps(_mm_loadu_ps(b), f)));
+        _mm_storeu_ps(o + 4, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + 4), c), _mm_mul_ps(_mm_loadu_ps(b + 4), f)));
+        _mm_storeu_ps(o + 8, _mm_add_ps(_mm_mul_ps(_mm_and_ps(_mm_loadu_ps(a + 8), data2Mask), c), _mm_mul_ps(_mm_and_ps(_mm_loadu_ps(b + 8), data2Mask), f)));
+    }
+#endif
+    for (; vertIdx < last; ++vertIdx)
+    {
+        const float* a = verticesA + vertIdx * SKINNING_VERTEX_FLOATS;
+        const float* b = verticesB + vertIdx * SKINNING_VERTEX_FLOATS;
+        float* o = output + vertIdx * SKINNING_VERTEX_FLOATS;
+        for (uint32_t floatIdx = 0; floatIdx < SKINNING_VERTEX_FLOATS - 1; ++floatIdx)
+            o[floatIdx] = lerp_scalar(a[floatIdx], b[floatIdx], interpolationFactor, complement);
+        memset(o + SKINNING_VERTEX_FLOATS - 1, 0, sizeof(float));
+    }
+}
+
+static void skin_position_range(const std::vector<VertexData>& verticesA, const std::vector<VertexData>& verticesB, float3* output, uint32_t first, uint32_t last, float interpolationFactor)
+{
+    const float complement = 1.0f - interpolationFactor;
+    uint32_t vertIdx = first;
+#if defined(SKINNING_SSE2)
+    // The position is loaded with the first component of the normal, the extra lane lands on the next output and is overwritten by it.
+    // The last vertex of the range is left to the scalar loop so that the ranges of other tasks are never touched.
+    const __m128 f = _mm_set1_ps(interpolationFactor);
+    const __m128 c = _mm_set1_ps(complement);
+    for (; vertIdx + 1 < last; ++vertIdx)
+    {
+        __m128 position = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&verticesA[vertIdx].position.x), c), _mm_mul_ps(_mm_loadu_ps(&verticesB[vertIdx].position.x), f));
+        _mm_storeu_ps(&output[vertIdx].x, position);
+    }
+#endif
+    for (; vertIdx < last; ++vertIdx)
+    {
+        output[vertIdx].x = lerp_scalar(verticesA[vertIdx].position.x, verticesB[vertIdx].position.x, interpolationFactor, complement);
+        output[vertIdx].y = lerp_scalar(verticesA[vertIdx].position.y, verticesB[vertIdx].position.y, interpolationFactor, complement);
+        output[vertIdx].z = lerp_scalar(verticesA[vertIdx].position.z, verticesB[vertIdx].position.z, interpolationFactor, complement);
+    }
+}
+
+namespace skinning
+{
+    SkinningFrame animation_frame(uint32_t numFrames, float time)
+    {
+        SkinningFrame frame;
+        frame.frameA = uint32_t(time * numFrames) % numFrames;
+        frame.frameB = (frame.frameA + 1) % numFrames;
+        frame.interpolationFactor = time * numFrames - frame.frameA;
+        return frame;
+    }
+
+    void skin_vertices(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<VertexData>& vertices)
+    {
+        const float* verticesA = &animation.vertexBufferArray[frame.frameA].data.data()->position.x;
+        const float* verticesB = &animation.vertexBufferArray[frame.frameB].data.data()->position.x;
+        const uint32_t numVertices = (uint32_t)animation.vertexBufferArray[frame.frameA].data.size();
+        vertices.resize(numVertices);
+        float* output = &vertices.data()->position.x;
+        task_scheduler::parallel_for(0, numVertices, [&](uint32_t first, uint32_t last)
+        {
+            skin_vertex_range(verticesA, verticesB, output, first, last, frame.interpolationFactor);
+        }, SKINNING_GRAIN_SIZE);
+    }
+
+    void skin_vertices_reference(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<VertexData>& vertices)
+    {
+        const std::vector<VertexData>& verticesA = animation.vertexBufferArray[frame.frameA].data;
+        const std::vector<VertexData>& verticesB = animation.vertexBufferArray[frame.frameB].data;
+        vertices.resize(verticesA.size());
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)verticesA.size(); ++vertIdx)
+        {
+            VertexData& vertex = vertices[vertIdx];
+            vertex.position = lerp(verticesA[vertIdx].position, verticesB[vertIdx].position, frame.interpolationFactor);
+            vertex.normal = lerp(verticesA[vertIdx].normal, verticesB[vertIdx].normal, frame.interpolationFactor);
+            vertex.tangent = lerp(verticesA[vertIdx].tangent, verticesB[vertIdx].tangent, frame.interpolationFactor);
+            vertex.texCoord = lerp(verticesA[vertIdx].texCoord, verticesB[vertIdx].texCoord, frame.interpolationFactor);
+            vertex.matID = 0;
+        }
+    }
+
+    void transpose_positions(const MeshAnimation& animation, PositionStreams& streams)
+    {
+        streams.numFrames = (uint32_t)animation.vertexBufferArray.size();
+        streams.numVertices = streams.numFrames > 0 ? (uint32_t)animation.vertexBufferArray[0].data.size() : 0;
+        const size_t numValues = (size_t)streams.numFrames * streams.numVertices;
+        streams.x.resize(numValues);
+        streams.y.resize(numValues);
+        streams.z.resize(numValues);
+        for (uint32_t frameIdx = 0; frameIdx < streams.numFrames; ++frameIdx)
+        {
+            const std::vector<VertexData>& vertices = animation.vertexBufferArray[frameIdx].data;
+            const size_t offset = (size_t)frameIdx * streams.numVertices;
+            for (uint32_t vertIdx = 0; vertIdx < streams.numVertices; ++vertIdx)
+            {
+                streams.x[offset + vertIdx] = vertices[vertIdx].position.x;
+                streams.y[offset + vertIdx] = vertices[vertIdx].position.y;
+                streams.z[offset + vertIdx] = vertices[vertIdx].position.z;
+            }
+        }
+    }
+
+    void skin_positions(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<float3>& positions)
+    {
+        const std::vector<VertexData>& verticesA = animation.vertexBufferArray[frame.frameA].data;
+        const std::vector<VertexData>& verticesB = animation.vertexBufferArray[frame.frameB].data;
+        positions.resize(verticesA.size());
+        task_scheduler::parallel_for(0, (uint32_t)verticesA.size(), [&](uint32_t first, uint32_t last)
+        {
+            skin_position_range(verticesA, verticesB, positions.data(), first, last, frame.interpolationFactor);
+        }, SKINNING_GRAIN_SIZE);
+    }
+
+    void skin_positions(const PositionStreams& streams, const SkinningFrame& frame, std::vector<float3>& positions)
+    {
+        const size_t offsetA = (size_t)frame.frameA * streams.numVertices;
+        const size_t offsetB = (size_t)frame.frameB * streams.numVertices;
+        positions.resize(streams.numVertices);
+        task_scheduler::parallel_for(0, streams.numVertices, [&](uint32_t first, uint32_t last)
+        {
+            const float f = frame.interpolationFactor;
+            const float c = 1.0f - f;
+            uint32_t vertIdx = first;
+#if defined(SKINNING_AVX2)
+            if (s_UseAVX2)
+                vertIdx = skin_stream_range_avx2(streams, offsetA, offsetB, positions.data(), first, last, f);
+#endif
+#if defined(SKINNING_SSE2)
+            // Four vertices per iteration, interleaved back into float3
+            const __m128 f4 = _mm_set1_ps(f);
+            const __m128 c4 = _mm_set1_ps(c);
+            for (; vertIdx + 4 <= last; vertIdx += 4)
+            {
+                __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&streams.x[offsetA + vertIdx]), c4), _mm_mul_ps(_mm_loadu_ps(&streams.x[offsetB + vertIdx]), f4));
+                __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&streams.y[offsetA + vertIdx]), c4), _mm_mul_ps(_mm_loadu_ps(&streams.y[offsetB + vertIdx]), f4));
+                __m128 z = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&streams.z[offsetA + vertIdx]), c4), _mm_mul_ps(_mm_loadu_ps(&streams.z[offsetB + vertIdx]), f4));
+
+                // x0 y0 x1 y1 | x2 y2 x3 y3 | z0 z1 x1 y1 | z2 z3 x3 y3
+                __m128 xy01 = _mm_unpacklo_ps(x, y);
+                __m128 xy23 = _mm_unpackhi_ps(x, y);
+                __m128 z01xy1 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(3, 2, 1, 0));
+                __m128 z23xy3 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+                float* output = &positions[vertIdx].x;
+                _mm_storeu_ps(output, _mm_shuffle_ps(xy01, z01xy1, _MM_SHUFFLE(2, 0, 1, 0)));
+                _mm_storeu_ps(output + 4, _mm_shuffle_ps(z01xy1, xy23, _MM_SHUFFLE(1, 0, 1, 3)));
+                _mm_storeu_ps(output + 8, _mm_shuffle_ps(z23xy3, z23xy3, _MM_SHUFFLE(1, 3, 2, 0)));
+            }
+#endif
+            for (; vertIdx < last; ++vertIdx)
+            {
+                positions[vertIdx].x = lerp_scalar(streams.x[offsetA + vertIdx], streams.x[offsetB + vertIdx], f, c);
+                positions[vertIdx].y = lerp_scalar(streams.y[offsetA + vertIdx], streams.y[offsetB + vertIdx], f, c);
+                positions[vertIdx].z = lerp_scalar(streams.z[offsetA + vertIdx], streams.z[offsetB + vertIdx], f, c);
+            }
+        }, SKINNING_GRAIN_SIZE);
+    }
+
+    void skin_positions_reference(const MeshAnimation& animation, const SkinningFrame& frame, std::vector<float3>& positions)
+    {
+        const std::vector<VertexData>& verticesA = animation.vertexBufferArray[frame.frameA].data;
+        const std::vector<VertexData>& verticesB = animation.vertexBufferArray[frame.frameB].data;
+        positions.resize(verticesA.size());
+        for (uint32_t vertIdx = 0; vertIdx < (uint32_t)verticesA.size(); ++vertIdx)
+            positions[vertIdx] = lerp(verticesA[vertIdx].position, verticesB[vertIdx].position, frame.interpolationFactor);
+    }
+}
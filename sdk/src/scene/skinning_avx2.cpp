@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Includes
+#include "scene/skinning.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+// System includes
+#include <immintrin.h>
+
+// VertexData seen as the three float4 of SkinMesh.compute
+#define SKINNING_VERTEX_FLOATS 12
+
+// Four blended positions interleaved back into float3, same shuffles as the SSE2 path of skinning.cpp
+static void store_positions(float* output, __m128 x, __m128 y, __m128 z)
+{
+    // x0 y0 x1 y1 | x2 y2 x3 y3 | z0 z1 x1 y1 | z2 z3 x3 y3
+    __m128 xy01 = _mm_unpacklo_ps(x, y);
+    __m128 xy23 = _mm_unpackhi_ps(x, y);
+    __m128 z01xy1 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(3, 2, 1, 0));
+    __m128 z23xy3 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+    _mm_storeu_ps(output, _mm_shuffle_ps(xy01, z01xy1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(output + 4, _mm_shuffle_ps(z01xy1, xy23, _MM_SHUFFLE(1, 0, 1, 3)));
+    _mm_storeu_ps(output + 8, _mm_shuffle_ps(z23xy3, z23xy3, _MM_SHUFFLE(1, 3, 2, 0)));
+}
+
+namespace skinning
+{
+    uint32_t skin_vertex_range_avx2(const float* verticesA, const float* verticesB, float* output, uint32_t first, uint32_t last, float interpolationFactor)
+    {
+        const __m256 f = _mm256_set1_ps(interpolationFactor);
+        const __m256 c = _mm256_set1_ps(1.0f - interpolationFactor);
+
+        // Two vertices are three registers, the material IDs are the fourth lane of the second one and the last lane of the third one
+        const __m256 middleMask = _mm256_castsi256_ps(_mm256_set_epi32(-1, -1, -1, -1, 0, -1, -1, -1));
+        const __m256 lastMask = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, -1, -1, -1, -1));
+        uint32_t vertIdx = first;
+        for (; vertIdx + 2 <= last; vertIdx += 2)
+        {
+            const float* a = verticesA + vertIdx * SKINNING_VERTEX_FLOATS;
+            const float* b = verticesB + vertIdx * SKINNING_VERTEX_FLOATS;
+            float* o = output + vertIdx * SKINNING_VERTEX_FLOATS;
+            _mm256_storeu_ps(o, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a), c), _mm256_mul_ps(_mm256_loadu_ps(b), f)));
+            _mm256_storeu_ps(o + 8, _mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(_mm256_loadu_ps(a + 8), middleMask), c), _mm256_mul_ps(_mm256_and_ps(_mm256_loadu_ps(b + 8), middleMask), f)));
+            _mm256_storeu_ps(o + 16, _mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(_mm256_loadu_ps(a + 16), lastMask), c), _mm256_mul_ps(_mm256_and_ps(_mm256_loadu_ps(b + 16), lastMask), f)));
+        }
+        return vertIdx;
+    }
+
+    uint32_t skin_stream_range_avx2(const PositionStreams& streams, size_t offsetA, size_t offsetB, float3* output, uint32_t first, uint32_t last, float interpolationFactor)
+    {
+        const __m256 f = _mm256_set1_ps(interpolationFactor);
+        const __m256 c = _mm256_set1_ps(1.0f - interpolationFactor);
+        uint32_t vertIdx = first;
+        for (; vertIdx + 8 <= last; vertIdx += 8)
+        {
+            __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&streams.x[offsetA + vertIdx]), c), _mm256_mul_ps(_mm256_loadu_ps(&streams.x[offsetB + vertIdx]), f));
+            __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&streams.y[offsetA + vertIdx]), c), _mm256_mul_ps(_mm256_loadu_ps(&streams.y[offsetB + vertIdx]), f));
+            __m256 z = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&streams.z[offsetA + vertIdx]), c), _mm256_mul_ps(_mm256_loadu_ps(&streams.z[offsetB + vertIdx]), f));
+            store_positions(&output[vertIdx].x, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+            store_positions(&output[vertIdx + 4].x, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+        }
+        return vertIdx;
+    }
+}
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/benchmark_runner.h"
+#include "tools/string_utilities.h"
+
+// System includes
+#include <algorithm>
+#include <fstream>
+
+static const char* texture_mode_names[] = { "Uncompressed", "BC6H", "Neural" };
+static const char* filtering_mode_names[] = { "Nearest", "Linear", "Anisotropic" };
+
+BenchmarkRunner::BenchmarkRunner()
+{
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+}
+
+bool BenchmarkRunner::initialize(const std::string& scenario, uint32_t numPOIs, const BenchmarkConfig& initialConfig, bool cooperativeSupported, uint32_t warmupFrames, uint32_t measuredFrames)
+{
+	if (scenario != "full" && scenario != "pois" && scenario != "modes" && scenario != "vrs" && scenario != "cache")
+		return false;
+	m_Scenario = scenario;
+	m_WarmupFrames = warmupFrames;
+	m_MeasuredFrames = std::max(measuredFrames, 1u);
+	m_Steps.clear();
+
+	// Dimensions of the sweep
+	std::vector<uint32_t> pois = { initialConfig.poi };
+	std::vector<BenchmarkConfig> modes = { initialConfig };
+	if (scenario == "full" || scenario == "pois" || scenario == "vrs" || scenario == "cache")
+	{
+		pois.clear();
+		for (uint32_t poiIdx = 0; poiIdx < numPOIs; ++poiIdx)
+			pois.push_back(poiIdx);
+	}
+	if (scenario == "full" || scenario == "modes")
+	{
+		modes.clear();
+		for (uint32_t texIdx = 0; texIdx < (uint32_t)TextureMode::Count; ++texIdx)
+		{
+			for (uint32_t filterIdx = 0; filterIdx < (uint32_t)FilteringMode::Count; ++filterIdx)
+			{
+				// Cooperative vectors only change the neural path
+				BenchmarkConfig config;
+				config.textureMode = (TextureMode)texIdx;
+				config.filteringMode = (FilteringMode)filterIdx;
+				config.cooperative = false;
+				modes.push_back(config);
+				if (config.textureMode == TextureMode::Neural && cooperativeSupported)
+				{
+					config.cooperative = true;
+					modes.push_back(config);
+				}
+			}
+		}
+	}
+	if (scenario == "vrs" || scenario == "cache")
+	{
+		// Only the neural path has a reduced rate or a feature cache
+		modes.clear();
+		BenchmarkConfig config = initialConfig;
+		config.textureMode = TextureMode::Neural;
+		bool& toggle = scenario == "vrs" ? config.variableRate : config.featureCache;
+		toggle = false;
+		modes.push_back(config);
+		toggle = true;
+		modes.push_back(config);
+	}
+
+	// POI major so that the camera only travels when the POI changes
+	for (uint32_t poi : pois)
+	{
+		for (const BenchmarkConfig& mode : modes)
+		{
+			BenchmarkStep step;
+			step.config = mode;
+			step.config.poi = poi;
+			m_Steps.push_back(step);
+		}
+	}
+
+	m_Phase = BenchmarkPhase::Start;
+	m_CurrentStep = 0;
+	m_PhaseFrame = 0;
+	return true;
+}
+
+void BenchmarkRunner::release()
+{
+	m_Steps.clear();
+	m_Phase = BenchmarkPhase::Done;
+}
+
+bool BenchmarkRunner::next_frame(bool cameraMoving)
+{
+	m_StepStarted = false;
+	m_POIChanged = false;
+	switch (m_Phase)
+	{
+		case BenchmarkPhase::Start:
+			m_StepStarted = true;
+			m_POIChanged = true;
+			m_Phase = BenchmarkPhase::Travel;
+			break;
+		case BenchmarkPhase::Travel:
+			// The camera path started on the previous frame, wait for it to reach the POI
+			if (!cameraMoving)
+			{
+				m_Phase = m_WarmupFrames > 0 ? BenchmarkPhase::Warmup : BenchmarkPhase::Measure;
+				m_PhaseFrame = 0;
+			}
+			break;
+		case BenchmarkPhase::Warmup:
+			if (++m_PhaseFrame >= m_WarmupFrames)
+			{
+				m_Phase = BenchmarkPhase::Measure;
+				m_PhaseFrame = 0;
+			}
+			break;
+		case BenchmarkPhase::Measure:
+			if (++m_PhaseFrame >= m_MeasuredFrames)
+			{
+				if (m_CurrentStep + 1 < (uint32_t)m_Steps.size())
+				{
+					m_CurrentStep++;
+					m_StepStarted = true;
+					m_POIChanged = m_Steps[m_CurrentStep].config.poi != m_Steps[m_CurrentStep - 1].config.poi;
+					m_Phase = BenchmarkPhase::Travel;
+				}
+				else
+					m_Phase = BenchmarkPhase::Done;
+				m_PhaseFrame = 0;
+			}
+			break;
+		case BenchmarkPhase::Done:
+			break;
+	}
+	return m_Phase != BenchmarkPhase::Done;
+}
+
+void BenchmarkRunner::record(const std::string& scope, float durationMS)
+{
+	if (m_Phase != BenchmarkPhase::Measure)
+		return;
+
+	// The window keeps every sample of the step
+	std::map<std::string, ScopeHistory>& scopes = m_Steps[m_CurrentStep].scopes;
+	auto it = scopes.find(scope);
+	if (it == scopes.end())
+		it = scopes.emplace(scope, ScopeHistory(m_MeasuredFrames)).first;
+	it->second.push(durationMS);
+}
+
+bool BenchmarkRunner::write_reports(const std::string& prefix, const char* deviceName) const
+{
+	std::ofstream jsonFile(prefix + ".json", std::ios::trunc);
+	std::ofstream csvFile(prefix + ".csv", std::ios::trunc);
+	if (!jsonFile.is_open() || !csvFile.is_open())
+		return false;
+	jsonFile.precision(4);
+	jsonFile << std::fixed;
+	csvFile.precision(4);
+	csvFile << std::fixed;
+
+	// Header
+	jsonFile << "{\n\"scenario\": ";
+	jsonFile << to_json_string(m_Scenario);
+	jsonFile << ",\n\"device\": ";
+	jsonFile << to_json_string(deviceName != nullptr ? deviceName : "");
+	jsonFile << ",\n\"timeStep\": " << BENCHMARK_TIME_STEP << ",\n\"warmupFrames\": " << m_WarmupFrames << ",\n\"measuredFrames\": " << m_MeasuredFrames << ",\n\"steps\": [";
+	csvFile << "poi,texture_mode,filtering_mode,cooperative,variable_rate,feature_cache,scope,samples,p50_ms,p95_ms,p99_ms\n";
+
+	for (uint32_t stepIdx = 0; stepIdx < (uint32_t)m_Steps.size(); ++stepIdx)
+	{
+		const BenchmarkStep& step = m_Steps[stepIdx];
+		const char* texName = texture_mode_names[(uint32_t)step.config.textureMode];
+		const char* filterName = filtering_mode_names[(uint32_t)step.config.filteringMode];
+		jsonFile << (stepIdx == 0 ? "\n" : ",\n") << "{\"poi\": " << step.config.poi << ", \"textureMode\": \"" << texName << "\", \"filteringMode\": \"" << filterName
+			<< "\", \"cooperative\": " << (step.config.cooperative ? "true" : "false") << ", \"variableRate\": " << (step.config.variableRate ? "true" : "false")
+			<< ", \"featureCache\": " << (step.config.featureCache ? "true" : "false") << ", \"scopes\": {";
+
+		bool firstScope = true;
+		for (const auto& scope : step.scopes)
+		{
+			float p50 = scope.second.percentile(50.0f);
+			float p95 = scope.second.percentile(95.0f);
+			float p99 = scope.second.percentile(99.0f);
+			jsonFile << (firstScope ? "" : ", ");
+			jsonFile << to_json_string(scope.first);
+			jsonFile << ": {\"samples\": " << scope.second.count() << ", \"p50\": " << p50 << ", \"p95\": " << p95 << ", \"p99\": " << p99 << "}";
+			firstScope = false;
+
+			// Scope names are quoted, they may contain spaces
+			csvFile << step.config.poi << "," << texName << "," << filterName << "," << (step.config.cooperative ? 1 : 0) << "," << (step.config.variableRate ? 1 : 0) << "," << (step.config.featureCache ? 1 : 0) << ",\"" << scope.first << "\"," << scope.second.count()
+				<< "," << p50 << "," << p95 << "," << p99 << "\n";
+		}
+		jsonFile << "}}";
+	}
+	jsonFile << "\n]\n}\n";
+	return jsonFile.good() && csvFile.good();
+}
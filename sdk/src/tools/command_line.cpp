@@ -8,6 +8,7 @@
  // Includes
 #include "tools/command_line.h"
 #include "math/operators.h"
+#include "render_pipeline/tile_shape.h"
 
 // System includes
 #include <algorithm>
@@ -45,6 +46,11 @@ namespace command_line
 				commandLineOptions.adapterIndex = atoi(args[current_arg_idx + 1].c_str());
 				current_arg_idx += 2;
 			}
+			else if (args[current_arg_idx] == "--null-backend")
+			{
+				commandLineOptions.graphicsAPI = GraphicsAPI::Null;
+				current_arg_idx += 1;
+			}
 			else if (args[current_arg_idx] == "--poi")
 			{
 				if (current_arg_idx == num_args - 1)
@@ -60,11 +66,36 @@ namespace command_line
 				commandLineOptions.enableCooperative = false;
 				current_arg_idx += 1;
 			}
+			else if (args[current_arg_idx] == "--variable-rate")
+			{
+				commandLineOptions.enableVariableRate = true;
+				current_arg_idx += 1;
+			}
+			else if (args[current_arg_idx] == "--feature-cache")
+			{
+				commandLineOptions.enableFeatureCache = true;
+				current_arg_idx += 1;
+			}
 			else if (args[current_arg_idx] == "--disable-animation")
 			{
 				commandLineOptions.disableAnimation = true;
 				current_arg_idx += 1;
 			}
+			else if (args[current_arg_idx] == "--disable-shader-cache")
+			{
+				commandLineOptions.disableShaderCache = true;
+				current_arg_idx += 1;
+			}
+			else if (args[current_arg_idx] == "--shader-archive")
+			{
+				if (current_arg_idx == num_args - 1)
+				{
+					printf("Command line parser: please provide a shader archive.");
+					continue;
+				}
+				commandLineOptions.shaderArchive = args[current_arg_idx + 1];
+				current_arg_idx += 2;
+			}
 			else if (args[current_arg_idx] == "--rendering-mode")
 			{
 				if (current_arg_idx == num_args - 1)
@@ -95,17 +126,78 @@ namespace command_line
 				commandLineOptions.filteringMode = (FilteringMode)clamp(atoi(args[current_arg_idx + 1].c_str()), 0, 2);
 				current_arg_idx += 2;
 			}
+			else if (args[current_arg_idx] == "--tile-shape")
+			{
+				if (current_arg_idx == num_args - 1)
+				{
+					printf("Command line parser: please provide a tile shape [8x4, 4x8, 8x8, 16x4, 4x4].");
+					continue;
+				}
+				if (!tile_shape::parse(args[current_arg_idx + 1], commandLineOptions.tileShape))
+					printf("Command line parser: unknown tile shape %s.", args[current_arg_idx + 1].c_str());
+				current_arg_idx += 2;
+			}
+			else if (args[current_arg_idx] == "--benchmark")
+			{
+				if (current_arg_idx == num_args - 1)
+				{
+					printf("Command line parser: please provide a benchmark scenario [full, pois, modes, vrs, cache].");
+					continue;
+				}
+				commandLineOptions.benchmarkScenario = args[current_arg_idx + 1];
+				current_arg_idx += 2;
+			}
+			else if (args[current_arg_idx] == "--benchmark-warmup")
+			{
+				if (current_arg_idx == num_args - 1)
+				{
+					printf("Command line parser: please provide a number of warmup frames.");
+					continue;
+				}
+				commandLineOptions.benchmarkWarmupFrames = (uint32_t)std::max(atoi(args[current_arg_idx + 1].c_str()), 0);
+				current_arg_idx += 2;
+			}
+			else if (args[current_arg_idx] == "--benchmark-frames")
+			{
+				if (current_arg_idx == num_args - 1)
+				{
+					printf("Command line parser: please provide a number of measured frames.");
+					continue;
+				}
+				commandLineOptions.benchmarkFrames = (uint32_t)std::max(atoi(args[current_arg_idx + 1].c_str()), 1);
+				current_arg_idx += 2;
+			}
+			else if (args[current_arg_idx] == "--benchmark-output")
+			{
+				if (current_arg_idx == num_args - 1)
+				{
+					printf("Command line parser: please provide a report prefix.");
+					continue;
+				}
+				commandLineOptions.benchmarkOutput = args[current_arg_idx + 1];
+				current_arg_idx += 2;
+			}
 			else if (args[current_arg_idx] == "--help")
 			{
 				printf("Option list:\n");
 				printf("--data-dir Location of the resource folders.\n");
 				printf("--adapter-id Integer that allows to pick the desired GPU [-1 = Largest VRAM, >= 0 System adapter ID].\n");
+				printf("--null-backend Run on the backend without a GPU, the GPU timings are simulated and a benchmark only reports the CPU ones.\n");
 				printf("--poi Integer that allows to pick the initial camera location.\n");
 				printf("--disable-coop Disable cooperative vector usage at launch.\n");
+				printf("--variable-rate Infer the low detail tiles at half or quarter rate at launch (GBuffer and Debug rendering modes).\n");
+				printf("--feature-cache Reuse the features inferred in the previous frame at launch (GBuffer and Debug rendering modes).\n");
 				printf("--disable-animation Disable mesh animation at launch.\n");
+				printf("--disable-shader-cache Always compile the shaders from source instead of using the on-disk DXIL cache.\n");
+				printf("--shader-archive Load the shaders from an archive built by shader_precompiler, missing permutations are compiled.\n");
 				printf("--rendering-mode Pick the rendering mode [0 = Material, 1 = GBuffer, 2 = Debug].\n");
 				printf("--texture-mode Pick the texture mode [0 = Uncompressed, 1 = BC6, 2 = Neural].\n");
 				printf("--filtering-mode Pick the filtering mode [0 = Nearest, 1 = Linear, 2 = Anisotropic].\n");
+				printf("--tile-shape Shape of the classification tiles [8x4 (default), 4x8, 8x8, 16x4, 4x4], falls back to 8x4 if a tile doesn't fit in a wave of the device.\n");
+				printf("--benchmark Run a benchmark sweep, write the reports and exit [full = POIs x modes, pois = every POI, modes = every mode on the initial POI, vrs = every POI with and without variable rate inference, cache = every POI with and without the feature cache].\n");
+				printf("--benchmark-warmup Number of frames rendered before measuring each benchmark step (default 60).\n");
+				printf("--benchmark-frames Number of frames measured for each benchmark step (default 300).\n");
+				printf("--benchmark-output Prefix of the benchmark reports, <prefix>.json and <prefix>.csv (default benchmark_<scenario>).\n");
 				return false;
 			}
 			else
@@ -0,0 +1,41 @@
+/*
+* Copyright (C) 2025 Intel Corporation
+*
+* SPDX-License-Identifier: MIT
+*
+*/
+
+// Includes
+#include "tools/cpu_features.h"
+
+// System includes
+#if defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace cpu_features
+{
+	bool avx2()
+	{
+#if defined(_M_X64)
+		// OSXSAVE and AVX, then the XMM and YMM states enabled in XCR0
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 0);
+		if (cpuInfo[0] < 7)
+			return false;
+		__cpuid(cpuInfo, 1);
+		const bool osxsave = (cpuInfo[2] & (1 << 27)) != 0;
+		const bool avx = (cpuInfo[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		// AVX2 in the extended features
+		__cpuidex(cpuInfo, 7, 0);
+		return (cpuInfo[1] & (1 << 5)) != 0;
+#elif defined(__x86_64__)
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/cpu_profiler.h"
+#include "tools/security.h"
+#include "tools/string_utilities.h"
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+// Completed scope as stored by the threads
+struct RawEvent
+{
+	const char* name = nullptr;
+	double startUS = 0.0;
+	double endUS = 0.0;
+	uint32_t depth = 0;
+};
+
+// Single producer (the owning thread), single consumer (the collection) ring of completed scopes.
+// The producer only writes the head and the consumer only writes the tail, no lock is taken on either side.
+struct ThreadBuffer
+{
+	RawEvent events[CPU_PROFILER_THREAD_CAPACITY];
+	std::atomic<uint32_t> head = 0;
+	std::atomic<uint32_t> tail = 0;
+	std::atomic<uint32_t> dropped = 0;
+	uint32_t threadIndex = 0;
+
+	// Open scopes, only touched by the owning thread
+	const char* stackNames[CPU_PROFILER_MAX_DEPTH] = {};
+	double stackStarts[CPU_PROFILER_MAX_DEPTH] = {};
+	uint32_t depth = 0;
+};
+
+// Every thread that ever opened a scope, the buffers are kept until the end of the process
+static std::mutex g_RegistryMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> g_ThreadBuffers;
+static thread_local ThreadBuffer* t_ThreadBuffer = nullptr;
+static const std::chrono::steady_clock::time_point g_Origin = std::chrono::steady_clock::now();
+
+static ThreadBuffer* thread_buffer()
+{
+	// Registration only happens once per thread
+	if (t_ThreadBuffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(g_RegistryMutex);
+		g_ThreadBuffers.push_back(std::make_unique<ThreadBuffer>());
+		t_ThreadBuffer = g_ThreadBuffers.back().get();
+		t_ThreadBuffer->threadIndex = (uint32_t)g_ThreadBuffers.size() - 1;
+	}
+	return t_ThreadBuffer;
+}
+
+ScopeHistory::ScopeHistory(uint32_t windowSize)
+{
+	m_WindowSize = std::max(windowSize, 1u);
+	m_Samples.reserve(m_WindowSize);
+}
+
+ScopeHistory::~ScopeHistory()
+{
+}
+
+void ScopeHistory::push(float durationMS)
+{
+	m_Last = durationMS;
+	if (m_Samples.size() < m_WindowSize)
+		m_Samples.push_back(durationMS);
+	else
+		m_Samples[m_Next] = durationMS;
+	m_Next = (m_Next + 1) % m_WindowSize;
+}
+
+float ScopeHistory::percentile(float p) const
+{
+	if (m_Samples.empty())
+		return 0.0f;
+
+	// Nearest rank on a copy of the window
+	std::vector<float> sorted = m_Samples;
+	uint32_t rank = (uint32_t)std::min((size_t)(p / 100.0f * (sorted.size() - 1) + 0.5f), sorted.size() - 1);
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+	return sorted[rank];
+}
+
+namespace cpu_profiler
+{
+	double timestamp_us()
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - g_Origin).count();
+	}
+
+	double timestamp_us(uint64_t steadyClockNS)
+	{
+		const std::chrono::steady_clock::time_point time(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(steadyClockNS)));
+		return std::chrono::duration<double, std::micro>(time - g_Origin).count();
+	}
+
+	void begin_scope(const char* name)
+	{
+		ThreadBuffer* buffer = thread_buffer();
+		if (buffer->depth < CPU_PROFILER_MAX_DEPTH)
+		{
+			buffer->stackNames[buffer->depth] = name;
+			buffer->stackStarts[buffer->depth] = timestamp_us();
+		}
+		buffer->depth++;
+	}
+
+	void end_scope()
+	{
+		ThreadBuffer* buffer = thread_buffer();
+		assert_msg(buffer->depth > 0, "Unbalanced CPU profiling scope.");
+		buffer->depth--;
+		if (buffer->depth >= CPU_PROFILER_MAX_DEPTH)
+			return;
+
+		// Drop the event if the collection didn't keep up
+		uint32_t head = buffer->head.load(std::memory_order_relaxed);
+		uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+		if (head - tail >= CPU_PROFILER_THREAD_CAPACITY)
+		{
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// Fill the slot and publish it
+		RawEvent& rawEvent = buffer->events[head % CPU_PROFILER_THREAD_CAPACITY];
+		rawEvent.name = buffer->stackNames[buffer->depth];
+		rawEvent.startUS = buffer->stackStarts[buffer->depth];
+		rawEvent.endUS = timestamp_us();
+		rawEvent.depth = buffer->depth;
+		buffer->head.store(head + 1, std::memory_order_release);
+	}
+
+	uint32_t collect(std::vector<TraceEvent>& outEvents)
+	{
+		// Snapshot of the registered threads, the buffers themselves are never released
+		std::vector<ThreadBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> lock(g_RegistryMutex);
+			for (const std::unique_ptr<ThreadBuffer>& buffer : g_ThreadBuffers)
+				buffers.push_back(buffer.get());
+		}
+
+		uint32_t dropped = 0;
+		for (ThreadBuffer* buffer : buffers)
+		{
+			uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+			uint32_t head = buffer->head.load(std::memory_order_acquire);
+			for (; tail != head; ++tail)
+			{
+				const RawEvent& rawEvent = buffer->events[tail % CPU_PROFILER_THREAD_CAPACITY];
+				TraceEvent traceEvent;
+				traceEvent.name = rawEvent.name;
+				traceEvent.startUS = rawEvent.startUS;
+				traceEvent.durationUS = rawEvent.endUS - rawEvent.startUS;
+				traceEvent.depth = rawEvent.depth;
+				traceEvent.process = TRACE_PROCESS_CPU;
+				traceEvent.thread = buffer->threadIndex;
+				outEvents.push_back(traceEvent);
+			}
+			buffer->tail.store(tail, std::memory_order_release);
+			dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+		}
+		return dropped;
+	}
+}
+
+bool export_chrome_trace(const char* path, const std::vector<TraceEvent>& events)
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	// Name the processes and the threads
+	file << "{\"traceEvents\":[\n";
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << TRACE_PROCESS_CPU << ",\"args\":{\"name\":\"CPU\"}},\n";
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << TRACE_PROCESS_GPU << ",\"args\":{\"name\":\"GPU\"}}";
+	std::vector<uint64_t> namedThreads;
+	for (const TraceEvent& traceEvent : events)
+	{
+		uint64_t key = ((uint64_t)traceEvent.process << 32) | traceEvent.thread;
+		if (std::find(namedThreads.begin(), namedThreads.end(), key) != namedThreads.end())
+			continue;
+		namedThreads.push_back(key);
+		file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << traceEvent.process << ",\"tid\":" << traceEvent.thread << ",\"args\":{\"name\":\"";
+		if (traceEvent.process == TRACE_PROCESS_GPU)
+			file << (traceEvent.thread == 0 ? "Direct queue" : "Compute queue");
+		else
+			file << "Thread " << traceEvent.thread;
+		file << "\"}}";
+	}
+
+	// Complete events
+	file.precision(3);
+	file << std::fixed;
+	for (const TraceEvent& traceEvent : events)
+	{
+		file << ",\n{\"name\":";
+		file << to_json_string(traceEvent.name);
+		file << ",\"cat\":\"" << (traceEvent.process == TRACE_PROCESS_GPU ? "GPU" : "CPU") << "\",\"ph\":\"X\",\"ts\":" << traceEvent.startUS << ",\"dur\":" << traceEvent.durationUS
+			<< ",\"pid\":" << traceEvent.process << ",\"tid\":" << traceEvent.thread << "}";
+	}
+	file << "\n]}\n";
+	return file.good();
+}
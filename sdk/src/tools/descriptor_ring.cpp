@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/descriptor_ring.h"
+#include "tools/security.h"
+
+DescriptorRing::DescriptorRing()
+{
+}
+
+DescriptorRing::~DescriptorRing()
+{
+}
+
+void DescriptorRing::initialize(uint32_t capacity)
+{
+	m_Capacity = capacity;
+	m_Head = 0;
+	m_Tail = 0;
+	m_Used = 0;
+	m_Blocks.clear();
+}
+
+void DescriptorRing::release()
+{
+	m_Capacity = 0;
+	m_Head = 0;
+	m_Tail = 0;
+	m_Used = 0;
+	m_Blocks.clear();
+}
+
+uint32_t DescriptorRing::allocate(uint32_t count)
+{
+	if (count == 0 || count > m_Capacity)
+		return UINT32_MAX;
+
+	// Empty ring, restart from the beginning to limit the fragmentation
+	if (m_Used == 0)
+	{
+		m_Head = 0;
+		m_Tail = 0;
+	}
+
+	uint32_t offset = UINT32_MAX;
+	if (m_Used == 0 || m_Head > m_Tail)
+	{
+		// The free space is [head, capacity) and [0, tail)
+		if (m_Capacity - m_Head >= count)
+			offset = m_Head;
+		else if (m_Tail >= count)
+		{
+			// Skip the end of the ring so that the block stays contiguous, the padding is released with the previous blocks
+			Block padding;
+			padding.offset = m_Head;
+			padding.count = m_Capacity - m_Head;
+			padding.submitted = true;
+			m_Blocks.push_back(padding);
+			m_Used += padding.count;
+			offset = 0;
+		}
+	}
+	else if (m_Head < m_Tail)
+	{
+		// The free space is [head, tail)
+		if (m_Tail - m_Head >= count)
+			offset = m_Head;
+	}
+
+	// Head and tail are equal and the ring is not empty, everything is in use
+	if (offset == UINT32_MAX)
+		return UINT32_MAX;
+
+	// Register the block
+	Block block;
+	block.offset = offset;
+	block.count = count;
+	m_Blocks.push_back(block);
+	m_Used += count;
+	m_Head = (offset + count) % m_Capacity;
+	return offset;
+}
+
+void DescriptorRing::submit(uint32_t offset, uint32_t timeline, uint64_t fenceValue)
+{
+	// Blocks are usually submitted shortly after their allocation, start from the most recent ones
+	for (auto it = m_Blocks.rbegin(); it != m_Blocks.rend(); ++it)
+	{
+		if (it->offset == offset && !it->submitted)
+		{
+			it->timeline = timeline;
+			it->fenceValue = fenceValue;
+			it->submitted = true;
+			return;
+		}
+	}
+	assert_fail_msg("Submitting a descriptor block that is not in flight.");
+}
+
+void DescriptorRing::retire(const std::vector<uint64_t>& completedValues)
+{
+	while (!m_Blocks.empty())
+	{
+		// A block still being recorded keeps all the following ones alive
+		const Block& block = m_Blocks.front();
+		if (!block.submitted)
+			break;
+		if (block.timeline != DESCRIPTOR_RING_NO_TIMELINE && (block.timeline >= completedValues.size() || completedValues[block.timeline] < block.fenceValue))
+			break;
+
+		// Give the space back
+		m_Tail = (block.offset + block.count) % m_Capacity;
+		m_Used -= block.count;
+		m_Blocks.pop_front();
+	}
+
+	if (m_Used == 0)
+	{
+		m_Head = 0;
+		m_Tail = 0;
+	}
+}
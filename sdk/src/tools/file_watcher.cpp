@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/file_watcher.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <filesystem>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Size of the buffer that receives the notifications
+#define FILE_WATCHER_BUFFER_SIZE (64 * 1024)
+
+// Interval at which the inotify thread checks for a stop request (ms)
+#define FILE_WATCHER_POLL_INTERVAL 100
+
+std::string normalize_file_path(const std::string& path)
+{
+	std::error_code ec;
+	std::filesystem::path absolutePath = std::filesystem::absolute(std::filesystem::path(path), ec);
+	if (ec)
+		absolutePath = std::filesystem::path(path);
+	std::string normalized = absolutePath.lexically_normal().make_preferred().string();
+#if defined(_WIN32)
+	// Case insensitive file system
+	std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](char c) { return (char)tolower(c); });
+#endif
+	return normalized;
+}
+
+FileWatcher::FileWatcher()
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+bool FileWatcher::initialize(const std::string& directory)
+{
+	m_Directory = directory;
+	m_Overflow = false;
+	m_ChangedFiles.clear();
+
+#if defined(_WIN32)
+	// Open the directory for overlapped notifications
+	std::wstring directoryW(directory.begin(), directory.end());
+	HANDLE dirHandle = CreateFileW(directoryW.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (dirHandle == INVALID_HANDLE_VALUE)
+	{
+		printf("[FILE WATCHER] Failed to watch %s.\n", directory.c_str());
+		return false;
+	}
+	m_DirectoryHandle = dirHandle;
+	m_StopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#else
+	m_NotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_NotifyFD < 0)
+	{
+		printf("[FILE WATCHER] Failed to create the inotify instance.\n");
+		return false;
+	}
+
+	// Inotify is not recursive, every sub-directory needs its own watch
+	std::error_code ec;
+	std::vector<std::string> directories = { directory };
+	for (std::filesystem::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+	{
+		if (it->is_directory(ec))
+			directories.push_back(it->path().string());
+	}
+	for (const std::string& dir : directories)
+	{
+		int wd = inotify_add_watch(m_NotifyFD, dir.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO);
+		if (wd >= 0)
+			m_WatchedDirectories[wd] = dir;
+	}
+	if (m_WatchedDirectories.empty())
+	{
+		printf("[FILE WATCHER] Failed to watch %s.\n", directory.c_str());
+		close(m_NotifyFD);
+		m_NotifyFD = -1;
+		return false;
+	}
+#endif
+
+	// Start the thread
+	m_Active.store(true);
+	m_Thread = std::thread(&FileWatcher::watch_loop, this);
+	return true;
+}
+
+void FileWatcher::release()
+{
+	if (!m_Active.load())
+		return;
+
+	// Stop the thread
+	m_Active.store(false);
+#if defined(_WIN32)
+	SetEvent((HANDLE)m_StopEvent);
+#endif
+	m_Thread.join();
+
+	// Release the handles
+#if defined(_WIN32)
+	CloseHandle((HANDLE)m_StopEvent);
+	CloseHandle((HANDLE)m_DirectoryHandle);
+	m_StopEvent = nullptr;
+	m_DirectoryHandle = nullptr;
+#else
+	for (auto& watch : m_WatchedDirectories)
+		inotify_rm_watch(m_NotifyFD, watch.first);
+	m_WatchedDirectories.clear();
+	close(m_NotifyFD);
+	m_NotifyFD = -1;
+#endif
+}
+
+bool FileWatcher::active() const
+{
+	return m_Active.load();
+}
+
+bool FileWatcher::consume_changes(std::vector<std::string>& outFiles)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	outFiles.assign(m_ChangedFiles.begin(), m_ChangedFiles.end());
+	m_ChangedFiles.clear();
+	bool complete = !m_Overflow;
+	m_Overflow = false;
+	return complete;
+}
+
+void FileWatcher::record_change(const std::string& path)
+{
+	std::string normalized = normalize_file_path(path);
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_ChangedFiles.insert(normalized);
+}
+
+#if defined(_WIN32)
+void FileWatcher::watch_loop()
+{
+	HANDLE dirHandle = (HANDLE)m_DirectoryHandle;
+	std::vector<DWORD> buffer(FILE_WATCHER_BUFFER_SIZE / sizeof(DWORD));
+
+	OVERLAPPED overlapped = {};
+	overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	while (m_Active.load())
+	{
+		// Request the next batch of notifications
+		ResetEvent(overlapped.hEvent);
+		const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+		if (!ReadDirectoryChangesW(dirHandle, buffer.data(), (DWORD)(buffer.size() * sizeof(DWORD)), TRUE, filter, nullptr, &overlapped, nullptr))
+			break;
+
+		// Wait for a notification or a stop request
+		HANDLE handles[2] = { overlapped.hEvent, (HANDLE)m_StopEvent };
+		DWORD waitResult = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+		DWORD numBytes = 0;
+		if (waitResult != WAIT_OBJECT_0)
+		{
+			CancelIo(dirHandle);
+			GetOverlappedResult(dirHandle, &overlapped, &numBytes, TRUE);
+			break;
+		}
+		if (!GetOverlappedResult(dirHandle, &overlapped, &numBytes, FALSE))
+			break;
+
+		// The buffer was too small, the notifications are lost
+		if (numBytes == 0)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Overflow = true;
+			continue;
+		}
+
+		// Process the notifications
+		const char* cursor = (const char*)buffer.data();
+		while (true)
+		{
+			const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)cursor;
+			if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+			{
+				std::wstring relativePath(info->FileName, info->FileNameLength / sizeof(WCHAR));
+				record_change((std::filesystem::path(m_Directory) / std::filesystem::path(relativePath)).string());
+			}
+			if (info->NextEntryOffset == 0)
+				break;
+			cursor += info->NextEntryOffset;
+		}
+	}
+	CloseHandle(overlapped.hEvent);
+}
+#else
+void FileWatcher::watch_loop()
+{
+	std::vector<char> buffer(FILE_WATCHER_BUFFER_SIZE);
+	while (m_Active.load())
+	{
+		// Wait for events with a timeout so that we can notice the stop request
+		pollfd pfd = { m_NotifyFD, POLLIN, 0 };
+		if (poll(&pfd, 1, FILE_WATCHER_POLL_INTERVAL) <= 0)
+			continue;
+
+		ssize_t numBytes = read(m_NotifyFD, buffer.data(), buffer.size());
+		if (numBytes <= 0)
+			continue;
+
+		// Process the events
+		for (ssize_t offset = 0; offset < numBytes;)
+		{
+			const inotify_event* event = (const inotify_event*)(buffer.data() + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Overflow = true;
+				continue;
+			}
+
+			auto dirIt = m_WatchedDirectories.find(event->wd);
+			if (dirIt == m_WatchedDirectories.end() || event->len == 0)
+				continue;
+			const std::string path = (std::filesystem::path(dirIt->second) / event->name).string();
+
+			// New sub-directories need to be watched too
+			if (event->mask & IN_ISDIR)
+			{
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					int wd = inotify_add_watch(m_NotifyFD, path.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO);
+					if (wd >= 0)
+						m_WatchedDirectories[wd] = path;
+				}
+				continue;
+			}
+			record_change(path);
+		}
+	}
+}
+#endif
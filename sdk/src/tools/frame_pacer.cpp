@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/frame_pacer.h"
+#include "tools/security.h"
+
+FramePacer::FramePacer()
+{
+}
+
+FramePacer::~FramePacer()
+{
+}
+
+void FramePacer::initialize(uint32_t numFrames)
+{
+	assert_msg(numFrames > 0, "At least one frame is required.");
+	m_NumFrames = numFrames;
+	m_SlotValues.assign(numFrames, 0);
+	m_LastValue = 0;
+	m_CurrentSlot = UINT32_MAX;
+	m_FrameCount = 0;
+}
+
+void FramePacer::release()
+{
+	m_NumFrames = 0;
+	m_SlotValues.clear();
+}
+
+uint32_t FramePacer::begin_frame(uint64_t& outWaitValue)
+{
+	assert_msg(m_CurrentSlot == UINT32_MAX, "The previous frame was not ended.");
+
+	// Slots are used in a round robin fashion, the oldest frame is the one that used the slot last
+	m_CurrentSlot = (uint32_t)(m_FrameCount % m_NumFrames);
+	outWaitValue = m_SlotValues[m_CurrentSlot];
+	return m_CurrentSlot;
+}
+
+uint64_t FramePacer::end_frame()
+{
+	assert_msg(m_CurrentSlot != UINT32_MAX, "No frame is being recorded.");
+
+	// Values are strictly increasing so that a single fence covers all the slots
+	m_LastValue++;
+	m_SlotValues[m_CurrentSlot] = m_LastValue;
+	m_CurrentSlot = UINT32_MAX;
+	m_FrameCount++;
+	return m_LastValue;
+}
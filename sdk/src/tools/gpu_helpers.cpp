@@ -7,6 +7,7 @@
 
 // Includes
 #include "graphics/backend.h"
+#include "render_pipeline/shader_bindings.h"
 #include "tools/gpu_helpers.h"
 
 #define CONVERT_KERNEL_WORKGROUP_SIZE 1024
@@ -27,8 +28,8 @@ void sync_convert_and_upload_buffer_to_gpu(GraphicsDevice device, CommandQueue c
     graphics::command_buffer::reset(cmdB);
 
     // Copy the input buffer to the processing buffers
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, convertCS, "_InputBuffer", uploadBuffer);
-    graphics::command_buffer::set_compute_shader_buffer(cmdB, convertCS, "_OutputBufferRW", convertedBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, convertCS, shader_binding::InputBuffer, uploadBuffer);
+    graphics::command_buffer::set_compute_shader_buffer(cmdB, convertCS, shader_binding::OutputBufferRW, convertedBuffer);
     graphics::command_buffer::dispatch(cmdB, convertCS, (uint32_t)((numElements + CONVERT_KERNEL_WORKGROUP_SIZE - 1) / CONVERT_KERNEL_WORKGROUP_SIZE), 1, 1);
 
     // Only copy the raw one if defined
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/mapped_file.h"
+
+// System includes
+#include <stdio.h>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+	close();
+
+#if defined(_WIN32)
+	// Sequential hint, the frames are mostly read in order
+	HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		printf("[MAPPED FILE] Failed to open %s.\n", path.c_str());
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(fileHandle, &fileSize);
+	HANDLE mappingHandle = fileSize.QuadPart > 0 ? CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	const void* view = mappingHandle != nullptr ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr)
+	{
+		printf("[MAPPED FILE] Failed to map %s.\n", path.c_str());
+		if (mappingHandle != nullptr)
+			CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+	m_FileHandle = fileHandle;
+	m_MappingHandle = mappingHandle;
+	m_Data = (const char*)view;
+	m_Size = (uint64_t)fileSize.QuadPart;
+#else
+	int fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fileDescriptor < 0)
+	{
+		printf("[MAPPED FILE] Failed to open %s.\n", path.c_str());
+		return false;
+	}
+	struct stat fileStat;
+	void* view = fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0 ? mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) : MAP_FAILED;
+	if (view == MAP_FAILED)
+	{
+		printf("[MAPPED FILE] Failed to map %s.\n", path.c_str());
+		::close(fileDescriptor);
+		return false;
+	}
+	madvise(view, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+	m_FileDescriptor = fileDescriptor;
+	m_Data = (const char*)view;
+	m_Size = (uint64_t)fileStat.st_size;
+#endif
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (m_Data == nullptr)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(m_Data);
+	CloseHandle(m_MappingHandle);
+	CloseHandle(m_FileHandle);
+	m_FileHandle = nullptr;
+	m_MappingHandle = nullptr;
+#else
+	munmap((void*)m_Data, (size_t)m_Size);
+	::close(m_FileDescriptor);
+	m_FileDescriptor = -1;
+#endif
+	m_Data = nullptr;
+	m_Size = 0;
+}
@@ -8,6 +8,7 @@
 // Includes
 #include "graphics/backend.h"
 #include "tools/profiling_helper.h"
+#include "tools/security.h"
 
 // System includes
 #include <algorithm>
@@ -20,59 +21,164 @@ ProfilingHelper::~ProfilingHelper()
 {
 }
 
-void ProfilingHelper::initialize(GraphicsDevice device, CommandQueue, uint32_t numScopes)
+void ProfilingHelper::initialize(GraphicsDevice device, CommandQueue cmdQ, uint32_t numFramesInFlight)
 {
-	m_NumScopes = numScopes;
-	m_Scopes.resize(m_NumScopes);
-	m_LastDurationArray.resize(m_NumScopes);
-	m_MaxDurationArray.resize(m_NumScopes);
-	for (uint32_t scopeIdx = 0; scopeIdx < m_NumScopes; ++scopeIdx)
+	// One region of timestamps per frame in flight
+	m_CmdQueue = cmdQ;
+	m_Regions.resize(std::max(numFramesInFlight, 1u));
+	m_Timestamps = graphics::profiling_scope::create_profiling_scope(device, (uint32_t)m_Regions.size() * PROFILING_MAX_GPU_SCOPES * 2);
+	m_Ticks.resize(PROFILING_MAX_GPU_SCOPES * 2);
+	m_Frequencies[0] = graphics::profiling_scope::timestamp_frequency(cmdQ, CommandBufferType::Default);
+	m_Frequencies[1] = graphics::profiling_scope::timestamp_frequency(cmdQ, CommandBufferType::Compute);
+
+	// Every section becomes a scope
+	graphics::command_buffer::set_section_listener(&ProfilingHelper::section_callback, this);
+}
+
+void ProfilingHelper::release()
+{
+	graphics::command_buffer::set_section_listener(nullptr, nullptr);
+	graphics::profiling_scope::destroy_profiling_scope(m_Timestamps);
+	m_Regions.clear();
+	m_OpenScopes.clear();
+}
+
+void ProfilingHelper::section_callback(void* userData, CommandBuffer cmd, const char* name)
+{
+	ProfilingHelper* helper = (ProfilingHelper*)userData;
+	if (name != nullptr)
+		helper->begin_scope(cmd, name);
+	else
+		helper->end_scope(cmd);
+}
+
+void ProfilingHelper::begin_frame()
+{
+	// CPU scopes completed since the last frame
+	m_CPUEvents.clear();
+	cpu_profiler::collect(m_CPUEvents);
+	for (const TraceEvent& cpuEvent : m_CPUEvents)
+		m_CPUStats[cpuEvent.name].push((float)(cpuEvent.durationUS / 1e3));
+	if (m_CaptureFramesLeft > 0)
+		m_CaptureEvents.insert(m_CaptureEvents.end(), m_CPUEvents.begin(), m_CPUEvents.end());
+
+	// The region we're about to reuse holds the oldest frame in flight, the GPU is done with it
+	m_CurrentRegion = (m_CurrentRegion + 1) % (uint32_t)m_Regions.size();
+	FrameRegion& region = m_Regions[m_CurrentRegion];
+	if (region.resolved)
+		process_region(region, m_CurrentRegion);
+
+	// Flush the capture
+	if (m_CaptureFramesLeft > 0 && --m_CaptureFramesLeft == 0)
 	{
-		m_Scopes[scopeIdx] = graphics::profiling_scope::create_profiling_scope(device);
+		export_chrome_trace(m_CapturePath.c_str(), m_CaptureEvents);
+		m_CaptureEvents.clear();
 	}
+
+	// Start the new frame
+	assert_msg(m_OpenScopes.empty(), "GPU profiling scopes were left open.");
+	region.scopes.clear();
+	region.numQueries = 0;
+	region.resolved = false;
+	for (uint32_t queueIdx = 0; queueIdx < 2; ++queueIdx)
+	{
+		uint64_t cpuTimeNS = 0;
+		graphics::profiling_scope::clock_calibration(m_CmdQueue, queueIdx == 1 ? CommandBufferType::Compute : CommandBufferType::Default, region.calibrationTicks[queueIdx], cpuTimeNS);
+		region.calibrationUS[queueIdx] = cpu_profiler::timestamp_us(cpuTimeNS);
+	}
+	m_Enabled = m_RequestedEnabled;
 }
 
-void ProfilingHelper::release()
+void ProfilingHelper::end_frame(CommandBuffer cmd)
 {
-	for (uint32_t scopeIdx = 0; scopeIdx < m_NumScopes; ++scopeIdx)
-		graphics::profiling_scope::destroy_profiling_scope(m_Scopes[scopeIdx]);
+	FrameRegion& region = m_Regions[m_CurrentRegion];
+	if (!m_Enabled || region.numQueries == 0)
+		return;
+	graphics::command_buffer::resolve_timestamps(cmd, m_Timestamps, m_CurrentRegion * PROFILING_MAX_GPU_SCOPES * 2, region.numQueries);
+	region.resolved = true;
 }
 
-void ProfilingHelper::start_profiling(CommandBuffer cmd, uint32_t index)
+void ProfilingHelper::begin_scope(CommandBuffer cmd, const char* name)
 {
-	graphics::command_buffer::enable_profiling_scope(cmd, m_Scopes[index]);
+	if (!m_Enabled)
+		return;
+
+	// Keep the nesting balanced even if the region is full
+	FrameRegion& region = m_Regions[m_CurrentRegion];
+	if (region.scopes.size() >= PROFILING_MAX_GPU_SCOPES)
+	{
+		m_OpenScopes.push_back(UINT32_MAX);
+		return;
+	}
+
+	GPUScope scope;
+	scope.name = name;
+	scope.depth = (uint32_t)m_OpenScopes.size();
+	scope.queue = graphics::command_buffer::command_buffer_type(cmd);
+	scope.beginQuery = region.numQueries++;
+	m_OpenScopes.push_back((uint32_t)region.scopes.size());
+	graphics::command_buffer::write_timestamp(cmd, m_Timestamps, m_CurrentRegion * PROFILING_MAX_GPU_SCOPES * 2 + scope.beginQuery);
+	region.scopes.push_back(scope);
 }
 
-void ProfilingHelper::end_profiling(CommandBuffer cmd, uint32_t index)
+void ProfilingHelper::end_scope(CommandBuffer cmd)
 {
-	graphics::command_buffer::disable_profiling_scope(cmd, m_Scopes[index]);
+	if (!m_Enabled)
+		return;
+	assert_msg(!m_OpenScopes.empty(), "Unbalanced GPU profiling scope.");
+	uint32_t scopeIdx = m_OpenScopes.back();
+	m_OpenScopes.pop_back();
+	if (scopeIdx == UINT32_MAX)
+		return;
+
+	FrameRegion& region = m_Regions[m_CurrentRegion];
+	GPUScope& scope = region.scopes[scopeIdx];
+	scope.endQuery = region.numQueries++;
+	graphics::command_buffer::write_timestamp(cmd, m_Timestamps, m_CurrentRegion * PROFILING_MAX_GPU_SCOPES * 2 + scope.endQuery);
 }
 
-void ProfilingHelper::process_scopes(CommandQueue cmdQ)
+void ProfilingHelper::process_region(FrameRegion& region, uint32_t regionIdx)
 {
-	for (uint32_t scopeIdx = 0; scopeIdx < m_NumScopes; ++scopeIdx)
+	graphics::profiling_scope::read_timestamps(m_Timestamps, regionIdx * PROFILING_MAX_GPU_SCOPES * 2, region.numQueries, m_Ticks.data());
+
+	m_LastGPUFrame.clear();
+	for (const GPUScope& scope : region.scopes)
 	{
-		uint64_t updateDuration = graphics::profiling_scope::get_duration_us(m_Scopes[scopeIdx], cmdQ);
-		m_MaxDurationArray[scopeIdx] = std::max(m_MaxDurationArray[scopeIdx], updateDuration);
-		m_LastDurationArray[scopeIdx] = updateDuration;
+		uint32_t queueIdx = scope.queue == CommandBufferType::Compute ? 1 : 0;
+		double frequency = (double)m_Frequencies[queueIdx];
+		uint64_t beginTick = m_Ticks[scope.beginQuery];
+		uint64_t endTick = std::max(m_Ticks[scope.endQuery], beginTick);
+
+		TraceEvent gpuEvent;
+		gpuEvent.name = scope.name;
+		gpuEvent.startUS = region.calibrationUS[queueIdx] + ((int64_t)(beginTick - region.calibrationTicks[queueIdx])) / frequency * 1e6;
+		gpuEvent.durationUS = (endTick - beginTick) / frequency * 1e6;
+		gpuEvent.depth = scope.depth;
+		gpuEvent.process = TRACE_PROCESS_GPU;
+		gpuEvent.thread = queueIdx;
+		m_LastGPUFrame.push_back(gpuEvent);
+		m_GPUStats[scope.name].push((float)(gpuEvent.durationUS / 1e3));
 	}
+	if (m_CaptureFramesLeft > 0)
+		m_CaptureEvents.insert(m_CaptureEvents.end(), m_LastGPUFrame.begin(), m_LastGPUFrame.end());
+	region.resolved = false;
 }
 
-uint64_t ProfilingHelper::get_scope_last_duration(uint32_t index)
+const ScopeHistory* ProfilingHelper::gpu_scope(const std::string& name) const
 {
-	return m_LastDurationArray[index];
+	auto it = m_GPUStats.find(name);
+	return it != m_GPUStats.end() ? &it->second : nullptr;
 }
 
-uint64_t ProfilingHelper::get_scope_max_duration(uint32_t index)
+const ScopeHistory* ProfilingHelper::cpu_scope(const std::string& name) const
 {
-	return m_MaxDurationArray[index];
+	auto it = m_CPUStats.find(name);
+	return it != m_CPUStats.end() ? &it->second : nullptr;
 }
 
-void ProfilingHelper::reset_durations()
+void ProfilingHelper::capture_trace(const char* path, uint32_t numFrames)
 {
-	for (uint32_t scopeIdx = 0; scopeIdx < m_NumScopes; ++scopeIdx)
-	{
-		m_MaxDurationArray[scopeIdx] = 0;
-		m_LastDurationArray[scopeIdx] = 0;
-	}
+	m_CapturePath = path;
+	m_CaptureFramesLeft = numFrames;
+	m_CaptureEvents.clear();
 }
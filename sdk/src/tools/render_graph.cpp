@@ -0,0 +1,714 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "graphics/backend.h"
+#include "tools/render_graph.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <map>
+#include <string.h>
+
+RenderGraph::RenderGraph()
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+void RenderGraph::initialize(GraphicsDevice device, uint32_t numFramesInFlight)
+{
+	m_Device = device;
+	m_NumFramesInFlight = numFramesInFlight;
+	m_SyncFence = graphics::fence::create_fence(m_Device);
+	m_SyncValue = 0;
+	reset();
+}
+
+void RenderGraph::release()
+{
+	// The caller guarantees that the GPU is done with the graph, the placed resources go before their heaps
+	for (const PlacedResource& placed : m_PlacedResources)
+		destroy(placed.type, placed.handle);
+	m_PlacedResources.clear();
+	for (const RetiredResource& retired : m_RetiredResources)
+		destroy(retired.type, retired.handle);
+	m_RetiredResources.clear();
+	for (const RetiredHeap& retiredHeap : m_RetiredHeaps)
+		graphics::resources::destroy_transient_heap(retiredHeap.heap);
+	m_RetiredHeaps.clear();
+	if (m_Heap != 0)
+		graphics::resources::destroy_transient_heap(m_Heap);
+	m_Heap = 0;
+	m_HeapSize = 0;
+	graphics::fence::destroy_fence(m_SyncFence);
+	m_SyncFence = 0;
+	reset();
+}
+
+void RenderGraph::reset()
+{
+	m_Resources.clear();
+	m_Passes.clear();
+	m_FrameActivations.clear();
+	m_TransientMemory = 0;
+	m_Compiled = false;
+	m_AsyncActive = false;
+}
+
+RGResource RenderGraph::import_buffer(const char* name, GraphicsBuffer buffer)
+{
+	Resource resource;
+	resource.name = name;
+	resource.type = ResourceType::Buffer;
+	resource.handle = buffer;
+	m_Resources.push_back(resource);
+	return (RGResource)(m_Resources.size() - 1);
+}
+
+RGResource RenderGraph::import_render_texture(const char* name, RenderTexture renderTexture)
+{
+	Resource resource;
+	resource.name = name;
+	resource.type = ResourceType::RenderTexture;
+	resource.handle = renderTexture;
+	m_Resources.push_back(resource);
+	return (RGResource)(m_Resources.size() - 1);
+}
+
+RGResource RenderGraph::create_transient_buffer(const char* name, uint64_t bufferSize, uint32_t elementSize, uint32_t bufferFlags)
+{
+	Resource resource;
+	resource.name = name;
+	resource.type = ResourceType::Buffer;
+	resource.transient = true;
+	resource.bufferSize = bufferSize;
+	resource.elementSize = elementSize;
+	resource.bufferFlags = bufferFlags;
+	graphics::resources::graphics_buffer_footprint(m_Device, bufferSize, resource.footprint, resource.alignment);
+	m_Resources.push_back(resource);
+	return (RGResource)(m_Resources.size() - 1);
+}
+
+RGResource RenderGraph::create_transient_render_texture(const char* name, const TextureDescriptor& rtDesc)
+{
+	Resource resource;
+	resource.name = name;
+	resource.type = ResourceType::RenderTexture;
+	resource.transient = true;
+	resource.textureDesc = rtDesc;
+	if (resource.textureDesc.debugName.empty())
+		resource.textureDesc.debugName = name;
+	graphics::resources::render_texture_footprint(m_Device, rtDesc, resource.footprint, resource.alignment);
+	m_Resources.push_back(resource);
+	return (RGResource)(m_Resources.size() - 1);
+}
+
+RGPass RenderGraph::add_pass(const char* name, const std::function<void(CommandBuffer)>& execute)
+{
+	Pass pass;
+	pass.name = name;
+	pass.execute = execute;
+	m_Passes.push_back(pass);
+	return (RGPass)(m_Passes.size() - 1);
+}
+
+void RenderGraph::read(RGPass pass, RGResource resource)
+{
+	assert_msg(pass < m_Passes.size() && resource < m_Resources.size(), "Invalid render graph handle.");
+	Access access;
+	access.resource = resource;
+	access.access = RGAccess::Read;
+	m_Passes[pass].accesses.push_back(access);
+}
+
+void RenderGraph::write(RGPass pass, RGResource resource, RGAccess accessType)
+{
+	assert_msg(pass < m_Passes.size() && resource < m_Resources.size(), "Invalid render graph handle.");
+	assert_msg(accessType != RGAccess::Read, "A write needs to be an unordered access or a render target.");
+	Access access;
+	access.resource = resource;
+	access.access = accessType;
+	m_Passes[pass].accesses.push_back(access);
+}
+
+void RenderGraph::mark_output(RGResource resource)
+{
+	m_Resources[resource].output = true;
+}
+
+void RenderGraph::set_side_effects(RGPass pass)
+{
+	m_Passes[pass].sideEffects = true;
+}
+
+void RenderGraph::set_async_compute(RGPass pass)
+{
+	m_Passes[pass].asyncCompute = true;
+}
+
+void RenderGraph::compile()
+{
+	cull_passes();
+	alias_transients();
+	schedule_queues();
+	derive_barriers();
+	derive_activations();
+	m_Compiled = true;
+}
+
+void RenderGraph::cull_passes()
+{
+	// Walk the passes backwards starting from the outputs, a pass survives if it writes something that is consumed later
+	std::vector<bool> needed(m_Resources.size(), false);
+	for (uint32_t resIdx = 0; resIdx < m_Resources.size(); ++resIdx)
+		needed[resIdx] = m_Resources[resIdx].output;
+
+	for (uint32_t passIdx = (uint32_t)m_Passes.size(); passIdx-- > 0;)
+	{
+		Pass& pass = m_Passes[passIdx];
+		bool alive = pass.sideEffects;
+		for (const Access& access : pass.accesses)
+			alive |= access.access != RGAccess::Read && needed[access.resource];
+		pass.culled = !alive;
+		if (!alive)
+			continue;
+
+		// Writes are not assumed to cover the whole resource (tiles, clears, blending), the previous writers are kept alive too
+		for (const Access& access : pass.accesses)
+			needed[access.resource] = true;
+	}
+}
+
+void RenderGraph::alias_transients()
+{
+	// Lifetime of the transient resources over the surviving passes
+	for (Resource& resource : m_Resources)
+	{
+		resource.firstPass = UINT32_MAX;
+		resource.lastPass = 0;
+		resource.heapOffset = UINT64_MAX;
+	}
+	for (uint32_t passIdx = 0; passIdx < m_Passes.size(); ++passIdx)
+	{
+		if (m_Passes[passIdx].culled)
+			continue;
+		for (const Access& access : m_Passes[passIdx].accesses)
+		{
+			Resource& resource = m_Resources[access.resource];
+			resource.firstPass = std::min(resource.firstPass, passIdx);
+			resource.lastPass = std::max(resource.lastPass, passIdx);
+		}
+	}
+
+	// The compute passes run concurrently with an unknown range of direct passes, their transients can't share memory
+	if (m_AsyncEnabled)
+	{
+		for (const Pass& pass : m_Passes)
+		{
+			if (pass.culled || !pass.asyncCompute)
+				continue;
+			for (const Access& access : pass.accesses)
+			{
+				m_Resources[access.resource].firstPass = 0;
+				m_Resources[access.resource].lastPass = (uint32_t)m_Passes.size() - 1;
+			}
+		}
+	}
+
+	// Transients in the order they come alive, the biggest first among the ones of a pass so that the smaller ones fill the gaps they leave
+	std::vector<RGResource> transients;
+	uint64_t granularity = 1;
+	uint64_t capacity = 0;
+	for (uint32_t resIdx = 0; resIdx < m_Resources.size(); ++resIdx)
+	{
+		const Resource& resource = m_Resources[resIdx];
+		if (!resource.transient || resource.firstPass == UINT32_MAX)
+			continue;
+		transients.push_back(resIdx);
+		granularity = std::max(granularity, resource.alignment);
+	}
+	for (RGResource resIdx : transients)
+		capacity += (m_Resources[resIdx].footprint + granularity - 1) & ~(granularity - 1);
+	std::stable_sort(transients.begin(), transients.end(), [&](RGResource a, RGResource b)
+	{
+		const Resource& resA = m_Resources[a];
+		const Resource& resB = m_Resources[b];
+		return resA.firstPass != resB.firstPass ? resA.firstPass < resB.firstPass : resA.footprint > resB.footprint;
+	});
+
+	// Replay the lifetimes on the allocator: a transient takes a range at its first pass and gives it back after its last one, so the
+	// later transients reuse the byte ranges whatever their type or stride. The capacity grows until the fit finds a block for everyone.
+	bool placed = transients.empty();
+	while (!placed)
+	{
+		placed = true;
+		m_TransientMemory = 0;
+		m_Allocator.initialize(capacity, granularity);
+		std::vector<std::pair<RGResource, uint32_t>> alive;
+		for (RGResource resIdx : transients)
+		{
+			Resource& resource = m_Resources[resIdx];
+			for (uint32_t aliveIdx = 0; aliveIdx < alive.size();)
+			{
+				if (m_Resources[alive[aliveIdx].first].lastPass < resource.firstPass)
+				{
+					m_Allocator.free(alive[aliveIdx].second);
+					alive.erase(alive.begin() + aliveIdx);
+				}
+				else
+					++aliveIdx;
+			}
+
+			uint32_t allocation = m_Allocator.allocate(resource.footprint, resource.heapOffset);
+			if (allocation == TLSF_INVALID_ALLOCATION)
+			{
+				placed = false;
+				capacity *= 2;
+				break;
+			}
+			alive.push_back({ resIdx, allocation });
+			m_TransientMemory = std::max(m_TransientMemory, resource.heapOffset + resource.footprint);
+		}
+		m_Allocator.release();
+	}
+}
+
+uint64_t RenderGraph::physical_key(RGResource resIdx) const
+{
+	// The transients that share memory are never alive at the same time, the aliasing barrier of the next one orders them
+	const Resource& resource = m_Resources[resIdx];
+	return resource.transient ? (UINT64_MAX - resIdx) : resource.handle;
+}
+
+bool RenderGraph::passes_conflict(const Pass& passA, const Pass& passB) const
+{
+	for (const Access& accessA : passA.accesses)
+	{
+		for (const Access& accessB : passB.accesses)
+		{
+			if ((accessA.access != RGAccess::Read || accessB.access != RGAccess::Read) && physical_key(accessA.resource) == physical_key(accessB.resource))
+				return true;
+		}
+	}
+	return false;
+}
+
+void RenderGraph::schedule_queues()
+{
+	m_AsyncActive = false;
+	for (Pass& pass : m_Passes)
+		pass.segment = 0;
+	if (!m_AsyncEnabled)
+		return;
+
+	// The compute work starts after the last direct pass it conflicts with and the direct queue waits for it before the first
+	// later pass that conflicts with it
+	bool computeWork = false;
+	uint32_t signalPass = RG_INVALID;
+	uint32_t waitPass = (uint32_t)m_Passes.size();
+	for (uint32_t computeIdx = 0; computeIdx < m_Passes.size(); ++computeIdx)
+	{
+		const Pass& computePass = m_Passes[computeIdx];
+		if (computePass.culled || !computePass.asyncCompute)
+			continue;
+		computeWork = true;
+
+		for (uint32_t directIdx = 0; directIdx < m_Passes.size(); ++directIdx)
+		{
+			const Pass& directPass = m_Passes[directIdx];
+			if (directPass.culled || directPass.asyncCompute || !passes_conflict(directPass, computePass))
+				continue;
+			if (directIdx < computeIdx)
+				signalPass = (signalPass == RG_INVALID) ? directIdx : std::max(signalPass, directIdx);
+			else
+				waitPass = std::min(waitPass, directIdx);
+		}
+	}
+
+	// A single synchronization in each direction can't order the compute work, everything stays on the direct queue
+	if (!computeWork || (signalPass != RG_INVALID && signalPass >= waitPass))
+		return;
+
+	// Assign the segments
+	for (uint32_t passIdx = 0; passIdx < m_Passes.size(); ++passIdx)
+	{
+		Pass& pass = m_Passes[passIdx];
+		if (pass.asyncCompute)
+			pass.segment = RG_COMPUTE_SEGMENT;
+		else if (signalPass != RG_INVALID && passIdx <= signalPass)
+			pass.segment = 0;
+		else
+			pass.segment = passIdx < waitPass ? 1 : 2;
+	}
+	m_AsyncActive = true;
+}
+
+void RenderGraph::derive_barriers()
+{
+	// Last access of every physical resource
+	std::map<uint64_t, RGAccess> lastAccess;
+	for (Pass& pass : m_Passes)
+	{
+		pass.barriers.clear();
+		if (pass.culled)
+			continue;
+
+		// Two unordered accesses in a row need a barrier, any other combination goes through a state transition at bind time
+		std::vector<uint64_t> barrierKeys;
+		for (const Access& access : pass.accesses)
+		{
+			if (access.access != RGAccess::UnorderedAccess)
+				continue;
+			uint64_t key = physical_key(access.resource);
+			auto it = lastAccess.find(key);
+			if (it == lastAccess.end() || it->second != RGAccess::UnorderedAccess)
+				continue;
+			if (std::find(barrierKeys.begin(), barrierKeys.end(), key) != barrierKeys.end())
+				continue;
+			barrierKeys.push_back(key);
+			pass.barriers.push_back(access.resource);
+		}
+
+		// Reads win over writes inside a pass, the resource will be transitioned anyway
+		std::map<uint64_t, RGAccess> passAccess;
+		for (const Access& access : pass.accesses)
+		{
+			uint64_t key = physical_key(access.resource);
+			auto it = passAccess.find(key);
+			if (it == passAccess.end() || access.access == RGAccess::Read)
+				passAccess[key] = access.access;
+		}
+		for (const auto& access : passAccess)
+			lastAccess[access.first] = access.second;
+	}
+}
+
+void RenderGraph::derive_activations()
+{
+	// A transient takes over its memory right before its first pass. The ones the compute queue uses are alive for the whole frame
+	// and don't share memory with anything, they are activated on the direct queue before any pass.
+	m_FrameActivations.clear();
+	for (Pass& pass : m_Passes)
+		pass.activations.clear();
+	for (uint32_t resIdx = 0; resIdx < m_Resources.size(); ++resIdx)
+	{
+		const Resource& resource = m_Resources[resIdx];
+		if (!resource.transient || resource.heapOffset == UINT64_MAX)
+			continue;
+
+		bool computeQueue = false;
+		uint32_t firstPass = (uint32_t)m_Passes.size();
+		for (uint32_t passIdx = 0; passIdx < m_Passes.size(); ++passIdx)
+		{
+			const Pass& pass = m_Passes[passIdx];
+			if (pass.culled)
+				continue;
+			for (const Access& access : pass.accesses)
+			{
+				if (access.resource != resIdx)
+					continue;
+				computeQueue |= pass.segment == RG_COMPUTE_SEGMENT;
+				firstPass = std::min(firstPass, passIdx);
+			}
+		}
+		if (computeQueue)
+			m_FrameActivations.push_back(resIdx);
+		else
+			m_Passes[firstPass].activations.push_back(resIdx);
+	}
+}
+
+bool RenderGraph::matches(const PlacedResource& placed, const Resource& resource) const
+{
+	if (placed.used || placed.type != resource.type || placed.heapOffset != resource.heapOffset)
+		return false;
+	if (resource.type == ResourceType::Buffer)
+		return placed.bufferSize == resource.bufferSize && placed.elementSize == resource.elementSize && placed.bufferFlags == resource.bufferFlags;
+	const TextureDescriptor& descA = placed.textureDesc;
+	const TextureDescriptor& descB = resource.textureDesc;
+	return descA.type == descB.type && descA.width == descB.width && descA.height == descB.height && descA.depth == descB.depth && descA.mipCount == descB.mipCount
+		&& descA.isUAV == descB.isUAV && descA.format == descB.format && memcmp(&descA.clearColor, &descB.clearColor, sizeof(float4)) == 0;
+}
+
+void RenderGraph::retire(const PlacedResource& placed)
+{
+	// Frames in flight may still be using it
+	RetiredResource retired;
+	retired.type = placed.type;
+	retired.handle = placed.handle;
+	retired.framesLeft = std::max(m_NumFramesInFlight, 1u);
+	m_RetiredResources.push_back(retired);
+}
+
+void RenderGraph::destroy(ResourceType type, uint64_t handle)
+{
+	if (type == ResourceType::Buffer)
+		graphics::resources::destroy_graphics_buffer(handle);
+	else
+		graphics::resources::destroy_render_texture(handle);
+}
+
+void RenderGraph::allocate_transients()
+{
+	// Age the resources and the heaps that were replaced during the previous frames, a heap always outlives its resources
+	for (uint32_t retIdx = 0; retIdx < m_RetiredResources.size();)
+	{
+		RetiredResource& retired = m_RetiredResources[retIdx];
+		if (--retired.framesLeft == 0)
+		{
+			destroy(retired.type, retired.handle);
+			m_RetiredResources.erase(m_RetiredResources.begin() + retIdx);
+		}
+		else
+			++retIdx;
+	}
+	for (uint32_t retIdx = 0; retIdx < m_RetiredHeaps.size();)
+	{
+		RetiredHeap& retiredHeap = m_RetiredHeaps[retIdx];
+		if (--retiredHeap.framesLeft == 0)
+		{
+			graphics::resources::destroy_transient_heap(retiredHeap.heap);
+			m_RetiredHeaps.erase(m_RetiredHeaps.begin() + retIdx);
+		}
+		else
+			++retIdx;
+	}
+
+	// The heap persists across frames and is only replaced when the placement outgrows it, along with everything placed in it
+	if (m_TransientMemory > m_HeapSize)
+	{
+		for (const PlacedResource& placed : m_PlacedResources)
+			retire(placed);
+		m_PlacedResources.clear();
+		if (m_Heap != 0)
+		{
+			RetiredHeap retiredHeap;
+			retiredHeap.heap = m_Heap;
+			retiredHeap.framesLeft = std::max(m_NumFramesInFlight, 1u);
+			m_RetiredHeaps.push_back(retiredHeap);
+		}
+		m_Heap = graphics::resources::create_transient_heap(m_Device, m_TransientMemory);
+		m_HeapSize = m_TransientMemory;
+	}
+
+	// A transient reuses the placed resource with its description at its offset, the ones that changed are placed again
+	for (PlacedResource& placed : m_PlacedResources)
+		placed.used = false;
+	for (Resource& resource : m_Resources)
+	{
+		if (!resource.transient || resource.heapOffset == UINT64_MAX)
+			continue;
+
+		uint32_t placedIdx = 0;
+		while (placedIdx < m_PlacedResources.size() && !matches(m_PlacedResources[placedIdx], resource))
+			++placedIdx;
+		if (placedIdx == m_PlacedResources.size())
+		{
+			PlacedResource placed;
+			placed.type = resource.type;
+			placed.heapOffset = resource.heapOffset;
+			placed.bufferSize = resource.bufferSize;
+			placed.elementSize = resource.elementSize;
+			placed.bufferFlags = resource.bufferFlags;
+			placed.textureDesc = resource.textureDesc;
+			if (resource.type == ResourceType::Buffer)
+			{
+				placed.handle = graphics::resources::create_aliased_graphics_buffer(m_Heap, resource.heapOffset, resource.bufferSize, resource.elementSize, resource.bufferFlags);
+				graphics::resources::set_buffer_debug_name(placed.handle, resource.name.c_str());
+			}
+			else
+				placed.handle = graphics::resources::create_aliased_render_texture(m_Heap, resource.heapOffset, resource.textureDesc);
+			m_PlacedResources.push_back(placed);
+		}
+		m_PlacedResources[placedIdx].used = true;
+		resource.handle = m_PlacedResources[placedIdx].handle;
+	}
+
+	// The placed resources no transient asked for this frame
+	for (uint32_t placedIdx = 0; placedIdx < m_PlacedResources.size();)
+	{
+		if (!m_PlacedResources[placedIdx].used)
+		{
+			retire(m_PlacedResources[placedIdx]);
+			m_PlacedResources.erase(m_PlacedResources.begin() + placedIdx);
+		}
+		else
+			++placedIdx;
+	}
+}
+
+void RenderGraph::record_activations(const std::vector<RGResource>& resources, CommandBuffer cmd)
+{
+	m_BarrierBuffers.clear();
+	m_BarrierTextures.clear();
+	for (RGResource resIdx : resources)
+	{
+		const Resource& resource = m_Resources[resIdx];
+		if (resource.type == ResourceType::Buffer)
+			m_BarrierBuffers.push_back(resource.handle);
+		else
+			m_BarrierTextures.push_back(resource.handle);
+	}
+	if (m_BarrierBuffers.size() + m_BarrierTextures.size() > 0)
+		graphics::command_buffer::aliasing_barriers(cmd, m_BarrierBuffers.data(), (uint32_t)m_BarrierBuffers.size(), m_BarrierTextures.data(), (uint32_t)m_BarrierTextures.size());
+}
+
+void RenderGraph::record_pass(const Pass& pass, CommandBuffer cmd)
+{
+	// The transients that come alive take over their memory first
+	record_activations(pass.activations, cmd);
+
+	// All the barriers of the pass are submitted at once
+	m_BarrierBuffers.clear();
+	m_BarrierTextures.clear();
+	for (RGResource resIdx : pass.barriers)
+	{
+		const Resource& resource = m_Resources[resIdx];
+		if (resource.type == ResourceType::Buffer)
+			m_BarrierBuffers.push_back(resource.handle);
+		else
+			m_BarrierTextures.push_back(resource.handle);
+	}
+	if (m_BarrierBuffers.size() + m_BarrierTextures.size() > 0)
+		graphics::command_buffer::uav_barriers(cmd, m_BarrierBuffers.data(), (uint32_t)m_BarrierBuffers.size(), m_BarrierTextures.data(), (uint32_t)m_BarrierTextures.size());
+
+	// Every pass is a section, which also makes it a profiling scope
+	graphics::command_buffer::start_section(cmd, pass.name);
+	pass.execute(cmd);
+	graphics::command_buffer::end_section(cmd);
+}
+
+void RenderGraph::prepare_compute_resources(CommandBuffer cmd)
+{
+	// Strongest access of every resource used on the compute queue
+	std::map<uint64_t, Access> computeAccess;
+	for (const Pass& pass : m_Passes)
+	{
+		if (pass.culled || pass.segment != RG_COMPUTE_SEGMENT)
+			continue;
+		for (const Access& access : pass.accesses)
+		{
+			assert_msg(access.access != RGAccess::RenderTarget, "Render targets can't be written on the compute queue.");
+			Access& entry = computeAccess[physical_key(access.resource)];
+			if (entry.resource == RG_INVALID || access.access == RGAccess::UnorderedAccess)
+				entry = access;
+		}
+	}
+
+	// Transition the read and the written resources in two batches
+	for (uint32_t unorderedAccess = 0; unorderedAccess < 2; ++unorderedAccess)
+	{
+		m_BarrierBuffers.clear();
+		m_BarrierTextures.clear();
+		for (const auto& entry : computeAccess)
+		{
+			if ((entry.second.access == RGAccess::UnorderedAccess) != (unorderedAccess == 1))
+				continue;
+			const Resource& resource = m_Resources[entry.second.resource];
+			if (resource.type == ResourceType::Buffer)
+				m_BarrierBuffers.push_back(resource.handle);
+			else
+				m_BarrierTextures.push_back(resource.handle);
+		}
+		if (m_BarrierBuffers.size() + m_BarrierTextures.size() > 0)
+			graphics::command_buffer::transition_for_compute_queue(cmd, m_BarrierBuffers.data(), (uint32_t)m_BarrierBuffers.size(), m_BarrierTextures.data(), (uint32_t)m_BarrierTextures.size(), unorderedAccess == 1);
+	}
+}
+
+void RenderGraph::execute(CommandBuffer cmd)
+{
+	assert_msg(m_Compiled, "The render graph needs to be compiled before being executed.");
+	allocate_transients();
+
+	record_activations(m_FrameActivations, cmd);
+	for (const Pass& pass : m_Passes)
+	{
+		if (!pass.culled)
+			record_pass(pass, cmd);
+	}
+}
+
+CommandBuffer RenderGraph::execute(CommandQueue cmdQ, const RGCommandBuffers& cmdBuffers)
+{
+	assert_msg(m_Compiled, "The render graph needs to be compiled before being executed.");
+	if (!m_AsyncActive)
+	{
+		execute(cmdBuffers.direct[0]);
+		return cmdBuffers.direct[0];
+	}
+	allocate_transients();
+
+	// Passes the compute work depends on, the resources it uses are moved to states the compute queue can handle
+	CommandBuffer cmd = cmdBuffers.direct[0];
+	record_activations(m_FrameActivations, cmd);
+	for (const Pass& pass : m_Passes)
+	{
+		if (!pass.culled && pass.segment == 0)
+			record_pass(pass, cmd);
+	}
+	prepare_compute_resources(cmd);
+	graphics::command_buffer::close(cmd);
+	graphics::command_queue::execute_command_buffer(cmdQ, cmd);
+	graphics::command_queue::signal(cmdQ, m_SyncFence, ++m_SyncValue);
+
+	// Compute work
+	cmd = cmdBuffers.compute;
+	graphics::command_buffer::reset(cmd);
+	for (const Pass& pass : m_Passes)
+	{
+		if (!pass.culled && pass.segment == RG_COMPUTE_SEGMENT)
+			record_pass(pass, cmd);
+	}
+	graphics::command_buffer::close(cmd);
+	graphics::command_queue::wait(cmdQ, m_SyncFence, m_SyncValue, CommandBufferType::Compute);
+	graphics::command_queue::execute_command_buffer(cmdQ, cmd);
+	graphics::command_queue::signal(cmdQ, m_SyncFence, ++m_SyncValue, CommandBufferType::Compute);
+
+	// Direct passes that overlap with the compute work
+	bool overlap = false;
+	for (const Pass& pass : m_Passes)
+		overlap |= !pass.culled && pass.segment == 1;
+	if (overlap)
+	{
+		cmd = cmdBuffers.direct[1];
+		graphics::command_buffer::reset(cmd);
+		for (const Pass& pass : m_Passes)
+		{
+			if (!pass.culled && pass.segment == 1)
+				record_pass(pass, cmd);
+		}
+		graphics::command_buffer::close(cmd);
+		graphics::command_queue::execute_command_buffer(cmdQ, cmd);
+	}
+
+	// The consumers of the compute work wait for it on the GPU
+	graphics::command_queue::wait(cmdQ, m_SyncFence, m_SyncValue);
+	cmd = cmdBuffers.direct[2];
+	graphics::command_buffer::reset(cmd);
+	for (const Pass& pass : m_Passes)
+	{
+		if (!pass.culled && pass.segment == 2)
+			record_pass(pass, cmd);
+	}
+	return cmd;
+}
+
+GraphicsBuffer RenderGraph::buffer(RGResource resource) const
+{
+	assert_msg(m_Resources[resource].type == ResourceType::Buffer, "The render graph resource is not a buffer.");
+	return m_Resources[resource].handle;
+}
+
+RenderTexture RenderGraph::render_texture(RGResource resource) const
+{
+	assert_msg(m_Resources[resource].type == ResourceType::RenderTexture, "The render graph resource is not a render texture.");
+	return m_Resources[resource].handle;
+}
\ No newline at end of file
@@ -17,6 +17,8 @@ void __handle_fail(const char* msg, const char* file_name, int)
 {
 	printf("[ERROR] %s\n", msg);
 	printf("Triggered at %s\n", file_name);
+#if defined(_WIN32)
 	__debugbreak();
+#endif
 	exit(-1);
 }
@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/shader_archive.h"
+#include "tools/shader_cache.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+
+// Archive file header
+#define SHADER_ARCHIVE_MAGIC 0x41505354 // 'TSPA'
+#define SHADER_ARCHIVE_VERSION 1
+
+// Layout: header, index sorted by key, binaries
+struct ShaderArchiveHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t numEntries;
+};
+
+struct ShaderArchiveEntry
+{
+	uint64_t key;
+	uint64_t offset;
+	uint64_t size;
+	uint64_t payloadHash;
+};
+
+// Shader block of a manifest
+struct ManifestShader
+{
+	std::string filename;
+	std::vector<std::pair<std::string, std::string>> kernels;
+	std::vector<std::string> defines;
+	std::vector<std::string> arguments;
+	std::vector<std::vector<std::vector<std::string>>> axes;
+};
+
+namespace shader_archive
+{
+	// Runtime state
+	static std::vector<char> archiveData;
+	static const ShaderArchiveEntry* entries = nullptr;
+	static uint64_t numEntries = 0;
+	static std::string shaderDir = "";
+	static bool loaded = false;
+
+	static std::string trim(const std::string& str)
+	{
+		const size_t first = str.find_first_not_of(" \t\r\n");
+		if (first == std::string::npos)
+			return "";
+		const size_t last = str.find_last_not_of(" \t\r\n");
+		return str.substr(first, last - first + 1);
+	}
+
+	static std::vector<std::string> split_list(const std::string& str, char separator)
+	{
+		std::vector<std::string> items;
+		std::stringstream stream(str);
+		std::string item;
+		while (std::getline(stream, item, separator))
+		{
+			item = trim(item);
+			if (item != "" && item != "~")
+				items.push_back(item);
+		}
+		return items;
+	}
+
+	static std::string normalize_path(const std::string& path)
+	{
+		std::string normalized = path;
+		std::replace(normalized.begin(), normalized.end(), '\\', '/');
+		std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](char c) { return (char)tolower(c); });
+		while (normalized.size() > 0 && normalized.back() == '/')
+			normalized.pop_back();
+		return normalized;
+	}
+
+	uint64_t permutation_key(const ShaderPermutation& permutation)
+	{
+		std::vector<std::string> defines = permutation.defines;
+		std::sort(defines.begin(), defines.end());
+		std::vector<std::string> arguments = permutation.arguments;
+		std::sort(arguments.begin(), arguments.end());
+
+		// The counts are hashed so that a define can't be confused with an argument
+		uint64_t key = shader_cache::hash_string(normalize_path(permutation.filename));
+		key = shader_cache::hash_string(permutation.kernel, key);
+		key = shader_cache::hash_string(permutation.profile, key);
+		uint64_t counts[2] = { defines.size(), arguments.size() };
+		key = shader_cache::hash_bytes(counts, sizeof(counts), key);
+		for (const std::string& define : defines)
+			key = shader_cache::hash_string(define, key);
+		for (const std::string& argument : arguments)
+			key = shader_cache::hash_string(argument, key);
+		return key;
+	}
+
+	std::string relative_path(const std::string& filename, const std::string& shaderDirectory)
+	{
+		const std::string file = normalize_path(filename);
+		const std::string root = normalize_path(shaderDirectory) + "/";
+		if (file.compare(0, root.size(), root) != 0)
+			return "";
+		return file.substr(root.size());
+	}
+
+	static bool substitute_variables(std::string& line, const std::map<std::string, std::string>& variables, const std::string& manifestPath, uint32_t lineIdx)
+	{
+		size_t start = line.find("${");
+		while (start != std::string::npos)
+		{
+			const size_t end = line.find('}', start);
+			if (end == std::string::npos)
+			{
+				printf("[SHADER ARCHIVE] %s(%u): unterminated variable.\n", manifestPath.c_str(), lineIdx);
+				return false;
+			}
+			const std::string name = line.substr(start + 2, end - start - 2);
+			auto it = variables.find(name);
+			if (it == variables.end())
+			{
+				printf("[SHADER ARCHIVE] %s(%u): undefined variable %s.\n", manifestPath.c_str(), lineIdx, name.c_str());
+				return false;
+			}
+			line.replace(start, end - start + 1, it->second);
+			start = line.find("${", start + it->second.size());
+		}
+		return true;
+	}
+
+	static void expand_shader(const ManifestShader& shader, std::vector<ShaderPermutation>& outPermutations)
+	{
+		// Cartesian product of the axes, the first axis varies the fastest
+		uint64_t numCombinations = 1;
+		for (const auto& axis : shader.axes)
+			numCombinations *= axis.size();
+
+		for (const auto& kernel : shader.kernels)
+		{
+			for (uint64_t combination = 0; combination < numCombinations; ++combination)
+			{
+				ShaderPermutation permutation;
+				permutation.filename = shader.filename;
+				permutation.profile = kernel.first;
+				permutation.kernel = kernel.second;
+				permutation.defines = shader.defines;
+				permutation.arguments = shader.arguments;
+
+				// Items of an alternative that start with a dash are compiler arguments
+				uint64_t remainder = combination;
+				for (const auto& axis : shader.axes)
+				{
+					for (const std::string& item : axis[remainder % axis.size()])
+					{
+						if (item[0] == '-')
+							permutation.arguments.push_back(item);
+						else
+							permutation.defines.push_back(item);
+					}
+					remainder /= axis.size();
+				}
+				outPermutations.push_back(permutation);
+			}
+		}
+	}
+
+	bool parse_manifest(const std::string& manifestPath, std::map<std::string, std::string>& variables, std::vector<ShaderPermutation>& outPermutations)
+	{
+		std::ifstream file(manifestPath);
+		if (!file.is_open())
+		{
+			printf("[SHADER ARCHIVE] Failed to open %s.\n", manifestPath.c_str());
+			return false;
+		}
+
+		std::vector<ManifestShader> shaders;
+		std::string line;
+		uint32_t lineIdx = 0;
+		while (std::getline(file, line))
+		{
+			lineIdx++;
+
+			// Skip the comments and the empty lines
+			line = trim(line);
+			if (line == "" || line[0] == '#')
+				continue;
+
+			// Split the keyword
+			const size_t separator = line.find_first_of(" \t");
+			const std::string keyword = line.substr(0, separator);
+			std::string content = separator != std::string::npos ? trim(line.substr(separator)) : "";
+
+			// Variables are declared with a default value that the command line can override
+			if (keyword == "variable")
+			{
+				const size_t valueSeparator = content.find_first_of(" \t");
+				const std::string name = content.substr(0, valueSeparator);
+				if (variables.find(name) == variables.end())
+					variables[name] = valueSeparator != std::string::npos ? trim(content.substr(valueSeparator)) : "";
+				continue;
+			}
+
+			if (!substitute_variables(content, variables, manifestPath, lineIdx))
+				return false;
+
+			if (keyword == "shader")
+			{
+				// shader <file> <profile>:<kernel> ...
+				std::vector<std::string> tokens = split_list(content, ' ');
+				ManifestShader shader;
+				shader.filename = tokens.size() > 0 ? tokens[0] : "";
+				for (uint32_t tokenIdx = 1; tokenIdx < tokens.size(); ++tokenIdx)
+				{
+					const size_t colon = tokens[tokenIdx].find(':');
+					if (colon == std::string::npos)
+					{
+						printf("[SHADER ARCHIVE] %s(%u): expected <profile>:<kernel>, got %s.\n", manifestPath.c_str(), lineIdx, tokens[tokenIdx].c_str());
+						return false;
+					}
+					shader.kernels.push_back({ tokens[tokenIdx].substr(0, colon), tokens[tokenIdx].substr(colon + 1) });
+				}
+				if (shader.kernels.empty())
+				{
+					printf("[SHADER ARCHIVE] %s(%u): a shader needs at least one kernel.\n", manifestPath.c_str(), lineIdx);
+					return false;
+				}
+				shaders.push_back(shader);
+				continue;
+			}
+
+			// Everything else belongs to a shader block
+			if (shaders.empty())
+			{
+				printf("[SHADER ARCHIVE] %s(%u): %s outside of a shader block.\n", manifestPath.c_str(), lineIdx, keyword.c_str());
+				return false;
+			}
+			ManifestShader& shader = shaders.back();
+			if (keyword == "defines")
+			{
+				std::vector<std::string> defines = split_list(content, ',');
+				shader.defines.insert(shader.defines.end(), defines.begin(), defines.end());
+			}
+			else if (keyword == "arguments")
+			{
+				std::vector<std::string> arguments = split_list(content, ',');
+				shader.arguments.insert(shader.arguments.end(), arguments.begin(), arguments.end());
+			}
+			else if (keyword == "axis")
+			{
+				// Alternatives are separated by pipes, an alternative is a comma separated list, ~ stands for nothing
+				std::vector<std::vector<std::string>> axis;
+				std::stringstream stream(content);
+				std::string alternative;
+				while (std::getline(stream, alternative, '|'))
+					axis.push_back(split_list(alternative, ','));
+				shader.axes.push_back(axis);
+			}
+			else
+			{
+				printf("[SHADER ARCHIVE] %s(%u): unknown keyword %s.\n", manifestPath.c_str(), lineIdx, keyword.c_str());
+				return false;
+			}
+		}
+
+		// Expand all the shaders
+		for (const ManifestShader& shader : shaders)
+			expand_shader(shader, outPermutations);
+		return true;
+	}
+
+	bool write(const std::string& archivePath, const std::vector<uint64_t>& keys, const std::vector<std::vector<char>>& binaries)
+	{
+		assert_msg(keys.size() == binaries.size(), "Every key needs a binary.");
+
+		// Build the index sorted by key
+		std::vector<uint32_t> order(keys.size());
+		for (uint32_t idx = 0; idx < (uint32_t)order.size(); ++idx)
+			order[idx] = idx;
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+		std::vector<ShaderArchiveEntry> index(keys.size());
+		uint64_t offset = sizeof(ShaderArchiveHeader) + sizeof(ShaderArchiveEntry) * index.size();
+		for (uint32_t entryIdx = 0; entryIdx < (uint32_t)order.size(); ++entryIdx)
+		{
+			const std::vector<char>& binary = binaries[order[entryIdx]];
+			if (entryIdx > 0 && keys[order[entryIdx]] == keys[order[entryIdx - 1]])
+			{
+				printf("[SHADER ARCHIVE] Duplicated permutation %016llx.\n", (unsigned long long)keys[order[entryIdx]]);
+				return false;
+			}
+			index[entryIdx].key = keys[order[entryIdx]];
+			index[entryIdx].offset = offset;
+			index[entryIdx].size = binary.size();
+			index[entryIdx].payloadHash = shader_cache::hash_bytes(binary.data(), binary.size());
+			offset += binary.size();
+		}
+
+		std::ofstream file(archivePath, std::ios::binary);
+		if (!file.is_open())
+		{
+			printf("[SHADER ARCHIVE] Failed to create %s.\n", archivePath.c_str());
+			return false;
+		}
+		ShaderArchiveHeader header = { SHADER_ARCHIVE_MAGIC, SHADER_ARCHIVE_VERSION, index.size() };
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)index.data(), sizeof(ShaderArchiveEntry) * index.size());
+		for (uint32_t entryIdx = 0; entryIdx < (uint32_t)order.size(); ++entryIdx)
+		{
+			const std::vector<char>& binary = binaries[order[entryIdx]];
+			file.write(binary.data(), binary.size());
+		}
+		return (bool)file;
+	}
+
+	bool initialize(const std::string& archivePath, const std::string& shaderDirectory)
+	{
+		release();
+
+		// Load the whole archive
+		std::ifstream file(archivePath, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			printf("[SHADER ARCHIVE] Failed to open %s.\n", archivePath.c_str());
+			return false;
+		}
+		archiveData.resize((size_t)file.tellg());
+		file.seekg(0);
+		file.read(archiveData.data(), archiveData.size());
+
+		// Validate the header and the index
+		bool valid = (bool)file && archiveData.size() >= sizeof(ShaderArchiveHeader);
+		const ShaderArchiveHeader* header = (const ShaderArchiveHeader*)archiveData.data();
+		valid = valid && header->magic == SHADER_ARCHIVE_MAGIC && header->version == SHADER_ARCHIVE_VERSION;
+		valid = valid && header->numEntries <= (archiveData.size() - sizeof(ShaderArchiveHeader)) / sizeof(ShaderArchiveEntry);
+		if (valid)
+		{
+			entries = (const ShaderArchiveEntry*)(archiveData.data() + sizeof(ShaderArchiveHeader));
+			numEntries = header->numEntries;
+			for (uint64_t entryIdx = 0; entryIdx < numEntries && valid; ++entryIdx)
+			{
+				const ShaderArchiveEntry& entry = entries[entryIdx];
+				valid = entry.offset <= archiveData.size() && entry.size <= archiveData.size() - entry.offset;
+				valid = valid && shader_cache::hash_bytes(archiveData.data() + entry.offset, entry.size) == entry.payloadHash;
+			}
+		}
+
+		if (!valid)
+		{
+			printf("[SHADER ARCHIVE] %s is corrupted or was built by another version.\n", archivePath.c_str());
+			release();
+			return false;
+		}
+
+		shaderDir = shaderDirectory;
+		loaded = true;
+		printf("[SHADER ARCHIVE] %llu permutations loaded from %s\n", (unsigned long long)numEntries, archivePath.c_str());
+		return true;
+	}
+
+	void release()
+	{
+		archiveData.clear();
+		archiveData.shrink_to_fit();
+		entries = nullptr;
+		numEntries = 0;
+		shaderDir = "";
+		loaded = false;
+	}
+
+	bool active()
+	{
+		return loaded;
+	}
+
+	bool find(const std::string& filename, const std::string& kernel, const std::string& profile,
+				const std::vector<std::string>& defines, const std::vector<std::string>& arguments, const char*& outData, uint64_t& outSize)
+	{
+		if (!loaded)
+			return false;
+
+		// Build the key
+		ShaderPermutation permutation;
+		permutation.filename = relative_path(filename, shaderDir);
+		if (permutation.filename == "")
+			return false;
+		permutation.kernel = kernel;
+		permutation.profile = profile;
+		permutation.defines = defines;
+		permutation.arguments = arguments;
+		const uint64_t key = permutation_key(permutation);
+
+		// Binary search in the index
+		const ShaderArchiveEntry* entry = std::lower_bound(entries, entries + numEntries, key, [](const ShaderArchiveEntry& e, uint64_t k) { return e.key < k; });
+		if (entry == entries + numEntries || entry->key != key)
+			return false;
+		outData = archiveData.data() + entry->offset;
+		outSize = entry->size;
+		return true;
+	}
+}
@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/shader_cache.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdio.h>
+#include <thread>
+
+// Cache file header
+#define SHADER_CACHE_MAGIC 0x4C495844 // 'DXIL'
+#define SHADER_CACHE_VERSION 1
+#define SHADER_CACHE_EXTENSION ".dxil"
+#define SHADER_CACHE_TMP_EXTENSION ".tmp"
+
+// Once the cache exceeds its budget, it is trimmed down to this ratio of the budget
+#define SHADER_CACHE_EVICTION_RATIO 0.8
+
+// Temporary files older than this (in seconds) are considered as leftovers of a crashed process
+#define SHADER_CACHE_STALE_TMP_AGE 3600
+
+struct ShaderCacheHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint64_t size;
+	uint64_t payloadHash;
+};
+
+// Manifest entry for a single source file
+struct SourceFileEntry
+{
+	std::filesystem::file_time_type writeTime;
+	uint64_t fileSize = 0;
+	uint64_t contentHash = 0;
+	std::vector<std::string> includes;
+};
+
+namespace shader_cache
+{
+	// Cache state
+	static std::filesystem::path cacheDir;
+	static uint64_t maxSize = 0;
+	static std::atomic<uint64_t> currentSize = 0;
+	static std::atomic<bool> active = false;
+	static std::mutex evictionMutex;
+
+	// Stats
+	static std::atomic<uint32_t> numHits = 0;
+	static std::atomic<uint32_t> numMisses = 0;
+
+	// Include manifest
+	static std::mutex manifestMutex;
+	static std::map<std::string, SourceFileEntry> manifest;
+
+	// Used to generate unique temporary file names
+	static std::atomic<uint64_t> tmpCounter = 0;
+
+	static std::string key_to_string(uint64_t key)
+	{
+		char buffer[17];
+		snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)key);
+		return buffer;
+	}
+
+	static void evict()
+	{
+		std::lock_guard<std::mutex> lock(evictionMutex);
+
+		// List the entries of the cache
+		struct CacheFile
+		{
+			std::filesystem::path path;
+			std::filesystem::file_time_type writeTime;
+			uint64_t size;
+		};
+		std::vector<CacheFile> files;
+		uint64_t totalSize = 0;
+		std::error_code ec;
+		const std::filesystem::file_time_type now = std::filesystem::file_time_type::clock::now();
+		for (std::filesystem::directory_iterator it(cacheDir, ec), end; !ec && it != end; it.increment(ec))
+		{
+			const std::filesystem::path& path = it->path();
+			std::error_code fileEC;
+			std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, fileEC);
+			if (fileEC)
+				continue;
+
+			// Clean the temporary files left by crashed processes
+			if (path.extension() == SHADER_CACHE_TMP_EXTENSION)
+			{
+				if (now - writeTime > std::chrono::seconds(SHADER_CACHE_STALE_TMP_AGE))
+					std::filesystem::remove(path, fileEC);
+				continue;
+			}
+
+			if (path.extension() != SHADER_CACHE_EXTENSION)
+				continue;
+			uint64_t fileSize = (uint64_t)std::filesystem::file_size(path, fileEC);
+			if (fileEC)
+				continue;
+			files.push_back({ path, writeTime, fileSize });
+			totalSize += fileSize;
+		}
+
+		// Remove the least recently used ones until we are back under budget.
+		// Another process may be reading or removing the same file, errors are simply ignored.
+		if (totalSize > maxSize)
+		{
+			std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) { return a.writeTime < b.writeTime; });
+			const uint64_t targetSize = (uint64_t)(maxSize * SHADER_CACHE_EVICTION_RATIO);
+			for (uint32_t fileIdx = 0; fileIdx < files.size() && totalSize > targetSize; ++fileIdx)
+			{
+				std::error_code fileEC;
+				if (std::filesystem::remove(files[fileIdx].path, fileEC))
+					totalSize -= files[fileIdx].size;
+			}
+		}
+		currentSize.store(totalSize);
+	}
+
+	void initialize(const std::string& cacheDirectory, uint64_t maxCacheSize)
+	{
+		cacheDir = std::filesystem::path(cacheDirectory);
+		maxSize = maxCacheSize;
+
+		// Make sure the directory exists
+		std::error_code ec;
+		std::filesystem::create_directories(cacheDir, ec);
+		if (!std::filesystem::is_directory(cacheDir, ec))
+		{
+			printf("[SHADER CACHE] Failed to create %s, the cache is disabled.\n", cacheDirectory.c_str());
+			return;
+		}
+
+		// Evaluate the current size and trim if needed
+		evict();
+		active.store(true);
+	}
+
+	void release()
+	{
+		if (active.load())
+			printf("[SHADER CACHE] %u hits, %u misses.\n", numHits.load(), numMisses.load());
+		active.store(false);
+		numHits.store(0);
+		numMisses.store(0);
+
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		manifest.clear();
+	}
+
+	bool enabled()
+	{
+		return active.load();
+	}
+
+	uint64_t hash_bytes(const void* data, uint64_t size, uint64_t seed)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		uint64_t hash = seed;
+		for (uint64_t byteIdx = 0; byteIdx < size; ++byteIdx)
+		{
+			hash ^= bytes[byteIdx];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	uint64_t hash_string(const std::string& str, uint64_t seed)
+	{
+		// Include the size so that concatenations don't collide
+		uint64_t size = str.size();
+		seed = hash_bytes(&size, sizeof(size), seed);
+		return hash_bytes(str.data(), str.size(), seed);
+	}
+
+	uint64_t hash_wstring(const std::wstring& str, uint64_t seed)
+	{
+		uint64_t size = str.size();
+		seed = hash_bytes(&size, sizeof(size), seed);
+		return hash_bytes(str.data(), str.size() * sizeof(wchar_t), seed);
+	}
+
+	static void parse_includes(const std::string& content, std::vector<std::string>& outIncludes)
+	{
+		size_t pos = 0;
+		while (pos < content.size())
+		{
+			size_t lineEnd = content.find('\n', pos);
+			if (lineEnd == std::string::npos)
+				lineEnd = content.size();
+
+			// Look for: # include "file" or # include <file>
+			size_t cursor = content.find_first_not_of(" \t", pos);
+			if (cursor != std::string::npos && cursor < lineEnd && content[cursor] == '#')
+			{
+				cursor = content.find_first_not_of(" \t", cursor + 1);
+				if (cursor != std::string::npos && content.compare(cursor, 7, "include") == 0)
+				{
+					cursor = content.find_first_not_of(" \t", cursor + 7);
+					if (cursor != std::string::npos && cursor < lineEnd && (content[cursor] == '"' || content[cursor] == '<'))
+					{
+						char closing = content[cursor] == '"' ? '"' : '>';
+						size_t nameEnd = content.find(closing, cursor + 1);
+						if (nameEnd != std::string::npos && nameEnd < lineEnd)
+							outIncludes.push_back(content.substr(cursor + 1, nameEnd - cursor - 1));
+					}
+				}
+			}
+			pos = lineEnd + 1;
+		}
+	}
+
+	static std::string resolve_include(const std::string& include, const std::filesystem::path& parentDir, const std::vector<std::string>& includeDirectories)
+	{
+		std::error_code ec;
+		std::filesystem::path candidate = parentDir / include;
+		if (std::filesystem::is_regular_file(candidate, ec))
+			return candidate.lexically_normal().string();
+		for (const std::string& dir : includeDirectories)
+		{
+			candidate = std::filesystem::path(dir) / include;
+			if (std::filesystem::is_regular_file(candidate, ec))
+				return candidate.lexically_normal().string();
+		}
+		return "";
+	}
+
+	// Returns false if the file doesn't exist
+	static bool query_file(const std::string& filename, const std::vector<std::string>& includeDirectories, uint64_t& outHash, std::vector<std::string>& outIncludes)
+	{
+		std::error_code ec;
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(filename, ec);
+		if (ec)
+			return false;
+		uint64_t fileSize = (uint64_t)std::filesystem::file_size(filename, ec);
+		if (ec)
+			return false;
+
+		// The include resolution depends on the include directories
+		std::string manifestKey = filename;
+		for (const std::string& dir : includeDirectories)
+			manifestKey += "|" + dir;
+
+		// Up to date in the manifest?
+		{
+			std::lock_guard<std::mutex> lock(manifestMutex);
+			auto it = manifest.find(manifestKey);
+			if (it != manifest.end() && it->second.writeTime == writeTime && it->second.fileSize == fileSize)
+			{
+				outHash = it->second.contentHash;
+				outIncludes = it->second.includes;
+				return true;
+			}
+		}
+
+		// Read and parse the file
+		std::ifstream file(filename, std::ios::binary);
+		if (!file.is_open())
+			return false;
+		std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		SourceFileEntry entry;
+		entry.writeTime = writeTime;
+		entry.fileSize = fileSize;
+		entry.contentHash = hash_string(content);
+
+		std::vector<std::string> rawIncludes;
+		parse_includes(content, rawIncludes);
+		const std::filesystem::path parentDir = std::filesystem::path(filename).parent_path();
+		for (const std::string& include : rawIncludes)
+		{
+			// Unresolved includes are kept by name so that they still take part in the hash
+			std::string resolved = resolve_include(include, parentDir, includeDirectories);
+			entry.includes.push_back(resolved.empty() ? include : resolved);
+		}
+
+		outHash = entry.contentHash;
+		outIncludes = entry.includes;
+
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		manifest[manifestKey] = std::move(entry);
+		return true;
+	}
+
+	static uint64_t visit_source_tree(const std::string& filename, const std::vector<std::string>& includeDirectories, std::set<std::string>& visited, std::vector<std::string>* outDependencies, uint64_t hash)
+	{
+		// Include guards/pragma once, every file only contributes once
+		if (!visited.insert(filename).second)
+			return hash;
+
+		uint64_t fileHash = 0;
+		std::vector<std::string> includes;
+		if (!query_file(filename, includeDirectories, fileHash, includes))
+			return hash_string(filename, hash);
+		if (outDependencies != nullptr)
+			outDependencies->push_back(filename);
+
+		hash = hash_bytes(&fileHash, sizeof(fileHash), hash);
+		for (const std::string& include : includes)
+			hash = visit_source_tree(include, includeDirectories, visited, outDependencies, hash);
+		return hash;
+	}
+
+	uint64_t hash_source_tree(const std::string& filename, const std::vector<std::string>& includeDirectories)
+	{
+		std::set<std::string> visited;
+		return visit_source_tree(std::filesystem::path(filename).lexically_normal().string(), includeDirectories, visited, nullptr, SHADER_CACHE_HASH_SEED);
+	}
+
+	void source_dependencies(const std::string& filename, const std::vector<std::string>& includeDirectories, std::vector<std::string>& outDependencies)
+	{
+		std::set<std::string> visited;
+		outDependencies.clear();
+		visit_source_tree(std::filesystem::path(filename).lexically_normal().string(), includeDirectories, visited, &outDependencies, SHADER_CACHE_HASH_SEED);
+	}
+
+	bool load(uint64_t key, std::vector<char>& outBinary)
+	{
+		if (!active.load())
+			return false;
+
+		const std::filesystem::path path = cacheDir / (key_to_string(key) + SHADER_CACHE_EXTENSION);
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			numMisses++;
+			return false;
+		}
+
+		// Validate the entry, a corrupted or truncated one is dropped
+		ShaderCacheHeader header = {};
+		bool valid = (bool)file.read((char*)&header, sizeof(header));
+		valid = valid && header.magic == SHADER_CACHE_MAGIC && header.version == SHADER_CACHE_VERSION && header.key == key;
+		if (valid)
+		{
+			outBinary.resize(header.size);
+			valid = (bool)file.read(outBinary.data(), header.size);
+			valid = valid && hash_bytes(outBinary.data(), header.size) == header.payloadHash;
+		}
+		file.close();
+
+		std::error_code ec;
+		if (!valid)
+		{
+			std::filesystem::remove(path, ec);
+			outBinary.clear();
+			numMisses++;
+			return false;
+		}
+
+		// Mark as recently used for the eviction
+		std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+		numHits++;
+		return true;
+	}
+
+	void store(uint64_t key, const void* data, uint64_t size)
+	{
+		if (!active.load())
+			return;
+
+		// Unique temporary name so that concurrent writers (threads or processes) never share a file
+		const std::string keyStr = key_to_string(key);
+		const uint64_t counter = tmpCounter.fetch_add(1);
+		const uint64_t unique = hash_bytes(&counter, sizeof(counter), (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count()) ^ (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+		const std::filesystem::path tmpPath = cacheDir / (keyStr + "." + key_to_string(unique) + SHADER_CACHE_TMP_EXTENSION);
+		const std::filesystem::path path = cacheDir / (keyStr + SHADER_CACHE_EXTENSION);
+
+		// Write the temporary file
+		ShaderCacheHeader header;
+		header.magic = SHADER_CACHE_MAGIC;
+		header.version = SHADER_CACHE_VERSION;
+		header.key = key;
+		header.size = size;
+		header.payloadHash = hash_bytes(data, size);
+		bool written = false;
+		{
+			std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+			if (file.is_open())
+			{
+				file.write((const char*)&header, sizeof(header));
+				file.write((const char*)data, size);
+				file.flush();
+				written = file.good();
+			}
+		}
+
+		// Publish it atomically, readers either see the previous entry or the complete new one
+		std::error_code ec;
+		if (written)
+			std::filesystem::rename(tmpPath, path, ec);
+		if (!written || ec)
+		{
+			std::filesystem::remove(tmpPath, ec);
+			return;
+		}
+
+		// Trim if we went over budget
+		if (currentSize.fetch_add(size + sizeof(header)) + size + sizeof(header) > maxSize)
+			evict();
+	}
+}
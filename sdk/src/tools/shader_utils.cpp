@@ -7,8 +7,16 @@
 
 // Includes
 #include "graphics/backend.h"
+#include "tools/file_watcher.h"
 #include "tools/security.h"
 #include "tools/shader_utils.h"
+#include "tools/task_scheduler.h"
+
+// System includes
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <stdio.h>
 
 void compile_and_replace_compute_shader(GraphicsDevice device, const ComputeShaderDescriptor& csd, ComputeShader& oldCS, bool experimental)
 {
@@ -40,4 +48,171 @@ void compile_and_replace_graphics_pipeline(GraphicsDevice device, const Graphics
         oldGP = newGP;
     }
     assert_msg(oldGP != 0, (gpd.filename + " failed to compile.").c_str());
-}
\ No newline at end of file
+}
+
+ShaderCompiler backend_shader_compiler()
+{
+    ShaderCompiler compiler;
+    compiler.create_compute_shader = graphics::compute_shader::create_compute_shader;
+    compiler.destroy_compute_shader = graphics::compute_shader::destroy_compute_shader;
+    compiler.compute_shader_dependencies = graphics::compute_shader::source_dependencies;
+    compiler.create_graphics_pipeline = graphics::graphics_pipeline::create_graphics_pipeline;
+    compiler.destroy_graphics_pipeline = graphics::graphics_pipeline::destroy_graphics_pipeline;
+    compiler.graphics_pipeline_dependencies = graphics::graphics_pipeline::source_dependencies;
+    return compiler;
+}
+
+ShaderCompileBatch::ShaderCompileBatch()
+{
+    m_Compiler = backend_shader_compiler();
+}
+
+ShaderCompileBatch::ShaderCompileBatch(const ShaderCompiler& compiler)
+{
+    m_Compiler = compiler;
+}
+
+ShaderCompileBatch::~ShaderCompileBatch()
+{
+}
+
+void ShaderCompileBatch::add_compute_shader(const ComputeShaderDescriptor& csd, ComputeShader& target, bool experimental)
+{
+    ComputeShaderJob job;
+    job.descriptor = csd;
+    job.descriptor.defines.insert(job.descriptor.defines.end(), m_ComputeDefines.begin(), m_ComputeDefines.end());
+    job.target = &target;
+    job.experimental = experimental;
+    m_ComputeJobs.push_back(job);
+}
+
+void ShaderCompileBatch::add_graphics_pipeline(const GraphicsPipelineDescriptor& gpd, GraphicsPipeline& target)
+{
+    GraphicsPipelineJob job;
+    job.descriptor = gpd;
+    job.target = &target;
+    m_GraphicsJobs.push_back(job);
+}
+
+static bool depends_on(const std::vector<std::string>& dependencies, const std::set<std::string>& changedFiles)
+{
+    for (const std::string& dependency : dependencies)
+    {
+        if (changedFiles.find(dependency) != changedFiles.end())
+            return true;
+    }
+    return false;
+}
+
+bool ShaderCompileBatch::execute(GraphicsDevice device, const std::vector<std::string>* changedFiles)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    m_Report = ShaderCompileReport();
+
+    // Only keep the shaders that were never compiled or that depend on one of the changed files
+    if (changedFiles != nullptr)
+    {
+        std::set<std::string> changedSet;
+        for (const std::string& file : *changedFiles)
+            changedSet.insert(normalize_file_path(file));
+
+        const uint32_t numRegistered = (uint32_t)(m_ComputeJobs.size() + m_GraphicsJobs.size());
+        m_ComputeJobs.erase(std::remove_if(m_ComputeJobs.begin(), m_ComputeJobs.end(), [&](const ComputeShaderJob& job)
+        {
+            return *job.target != 0 && !depends_on(m_Compiler.compute_shader_dependencies(*job.target), changedSet);
+        }), m_ComputeJobs.end());
+        m_GraphicsJobs.erase(std::remove_if(m_GraphicsJobs.begin(), m_GraphicsJobs.end(), [&](const GraphicsPipelineJob& job)
+        {
+            return *job.target != 0 && !depends_on(m_Compiler.graphics_pipeline_dependencies(*job.target), changedSet);
+        }), m_GraphicsJobs.end());
+
+        const uint32_t numAffected = (uint32_t)(m_ComputeJobs.size() + m_GraphicsJobs.size());
+        printf("[SHADER COMPILATION] %u file(s) changed, %u/%u shaders affected\n", (uint32_t)changedSet.size(), numAffected, numRegistered);
+        if (numAffected == 0)
+            return true;
+    }
+
+    // One task per shader, the graphics pipelines are placed after the compute shaders
+    const uint32_t numComputeJobs = (uint32_t)m_ComputeJobs.size();
+    const uint32_t numJobs = numComputeJobs + (uint32_t)m_GraphicsJobs.size();
+    task_scheduler::parallel_for(0, numJobs, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t jobIdx = first; jobIdx < last; ++jobIdx)
+        {
+            auto jobStart = std::chrono::high_resolution_clock::now();
+            double* duration = nullptr;
+            if (jobIdx < numComputeJobs)
+            {
+                ComputeShaderJob& job = m_ComputeJobs[jobIdx];
+                job.result = m_Compiler.create_compute_shader(device, job.descriptor, job.experimental);
+                duration = &job.durationMS;
+            }
+            else
+            {
+                GraphicsPipelineJob& job = m_GraphicsJobs[jobIdx - numComputeJobs];
+                job.result = m_Compiler.create_graphics_pipeline(device, job.descriptor);
+                duration = &job.durationMS;
+            }
+            auto jobStop = std::chrono::high_resolution_clock::now();
+            *duration = std::chrono::duration_cast<std::chrono::microseconds>(jobStop - jobStart).count() / 1e3;
+        }
+    });
+
+    // Did everything compile?
+    for (const ComputeShaderJob& job : m_ComputeJobs)
+    {
+        m_Report.compileDurationMS += job.durationMS;
+        if (job.result == 0)
+        {
+            printf("[SHADER COMPILATION] %s (%s) failed to compile.\n", job.descriptor.filename.c_str(), job.descriptor.kernelname.c_str());
+            m_Report.numFailed++;
+        }
+    }
+    for (const GraphicsPipelineJob& job : m_GraphicsJobs)
+    {
+        m_Report.compileDurationMS += job.durationMS;
+        if (job.result == 0)
+        {
+            printf("[SHADER COMPILATION] %s failed to compile.\n", job.descriptor.filename.c_str());
+            m_Report.numFailed++;
+        }
+    }
+    const bool success = m_Report.numFailed == 0;
+
+    // Swap everything or nothing
+    for (ComputeShaderJob& job : m_ComputeJobs)
+    {
+        ComputeShader& destroyed = success ? *job.target : job.result;
+        if (destroyed != 0)
+            m_Compiler.destroy_compute_shader(destroyed);
+        if (success)
+            *job.target = job.result;
+        assert_msg(*job.target != 0, (job.descriptor.filename + " failed to compile.").c_str());
+    }
+    for (GraphicsPipelineJob& job : m_GraphicsJobs)
+    {
+        GraphicsPipeline& destroyed = success ? *job.target : job.result;
+        if (destroyed != 0)
+            m_Compiler.destroy_graphics_pipeline(destroyed);
+        if (success)
+            *job.target = job.result;
+        assert_msg(*job.target != 0, (job.descriptor.filename + " failed to compile.").c_str());
+    }
+
+    // Timing report
+    auto stop = std::chrono::high_resolution_clock::now();
+    m_Report.numShaders = numJobs;
+    m_Report.numThreads = task_scheduler::num_threads();
+    m_Report.durationMS = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / 1e3;
+    printf("[SHADER COMPILATION] %u shaders compiled in %.1f ms on %u threads (%.1f ms of compilation)\n", m_Report.numShaders, m_Report.durationMS, m_Report.numThreads, m_Report.compileDurationMS);
+
+    // The jobs have been consumed
+    clear();
+    return success;
+}
+
+void ShaderCompileBatch::clear()
+{
+    m_ComputeJobs.clear();
+    m_GraphicsJobs.clear();
+}
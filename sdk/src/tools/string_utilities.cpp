@@ -8,6 +8,9 @@
 // Includes
 #include "tools/string_utilities.h"
 
+// System includes
+#include <stdio.h>
+
 std::wstring convert_to_wide(const std::string& str)
 {
 	size_t stringSize = str.size();
@@ -41,3 +44,26 @@ void split(const std::string& parString, char parSeparator, std::vector<std::str
 		_out.push_back(item);
 	}
 }
+
+std::string to_json_string(const std::string& str)
+{
+	std::string result = "\"";
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			result += '\\';
+			result += c;
+		}
+		else if ((unsigned char)c < 0x20)
+		{
+			char escaped[8];
+			snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+			result += escaped;
+		}
+		else
+			result += c;
+	}
+	result += '"';
+	return result;
+}
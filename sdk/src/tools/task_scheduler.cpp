@@ -0,0 +1,401 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/task_scheduler.h"
+#include "tools/security.h"
+
+// System includes
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Maximal number of tasks a worker deque can hold, overflow goes to the shared queue
+#define TASK_DEQUE_CAPACITY 4096
+
+// Number of ranges we target per thread in a parallel for
+#define PARALLEL_FOR_RANGES_PER_THREAD 4
+
+struct Task
+{
+	std::function<void()> func;
+	TaskGroup* group = nullptr;
+};
+
+// Chase-Lev work stealing deque (Le et al. 2013, "Correct and Efficient Work-Stealing for Weak Memory Models").
+// The owner pushes and pops at the bottom, thieves steal at the top. The ring has a fixed size and push fails when full.
+// Top/bottom accesses that take part in the owner/thief race are sequentially consistent instead of relying on standalone fences.
+class WorkDeque
+{
+public:
+	bool push(Task* task)
+	{
+		int64_t b = m_Bottom.load(std::memory_order_relaxed);
+		int64_t t = m_Top.load(std::memory_order_acquire);
+		if (b - t >= TASK_DEQUE_CAPACITY)
+			return false;
+		m_Buffer[b & (TASK_DEQUE_CAPACITY - 1)].store(task, std::memory_order_relaxed);
+		m_Bottom.store(b + 1, std::memory_order_seq_cst);
+		return true;
+	}
+
+	Task* pop()
+	{
+		int64_t b = m_Bottom.load(std::memory_order_relaxed) - 1;
+		m_Bottom.store(b, std::memory_order_seq_cst);
+		int64_t t = m_Top.load(std::memory_order_seq_cst);
+		if (t > b)
+		{
+			// Empty
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Task* task = m_Buffer[b & (TASK_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (t == b)
+		{
+			// Last element, race against the thieves
+			if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				task = nullptr;
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return task;
+	}
+
+	Task* steal()
+	{
+		int64_t t = m_Top.load(std::memory_order_seq_cst);
+		int64_t b = m_Bottom.load(std::memory_order_seq_cst);
+		if (t >= b)
+			return nullptr;
+
+		// The slot can't be recycled before top moves, so it is safe to read it before the CAS
+		Task* task = m_Buffer[t & (TASK_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+		return task;
+	}
+
+private:
+	alignas(64) std::atomic<int64_t> m_Top = 0;
+	alignas(64) std::atomic<int64_t> m_Bottom = 0;
+	std::atomic<Task*> m_Buffer[TASK_DEQUE_CAPACITY] = {};
+};
+
+namespace task_scheduler
+{
+	// Threads of the pool, index 0 is the main thread and doesn't have a std::thread
+	static std::vector<std::thread> workers;
+	static std::vector<std::unique_ptr<WorkDeque>> deques;
+	static uint32_t numThreads = 0;
+	static std::atomic<bool> active = false;
+
+	// Queue for tasks spawned from threads that are foreign to the pool or when a deque is full
+	static std::mutex sharedMutex;
+	static std::deque<Task*> sharedQueue;
+	static std::atomic<uint32_t> sharedQueueSize = 0;
+
+	// Sleep/wake mechanism for the idle workers
+	static std::mutex sleepMutex;
+	static std::condition_variable sleepCV;
+	static std::atomic<uint64_t> wakeEpoch = 0;
+	static std::atomic<uint32_t> numSleepers = 0;
+
+	// Per thread data
+	static thread_local uint32_t threadIndex = UINT32_MAX;
+	static thread_local uint32_t randomState = 0;
+
+	static uint32_t next_random()
+	{
+		// Xorshift32, never seeded with 0 where it would stay. Foreign threads are seeded from their id so that they don't all start stealing from the same victim
+		uint32_t x = randomState;
+		if (x == 0)
+		{
+			const uint32_t seed = threadIndex != UINT32_MAX ? threadIndex + 1 : (uint32_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+			x = (seed * 0x9E3779B9u) | 1;
+		}
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		randomState = x;
+		return x;
+	}
+
+	static void push_shared(Task* task)
+	{
+		std::lock_guard<std::mutex> lock(sharedMutex);
+		sharedQueue.push_back(task);
+		sharedQueueSize.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	static Task* pop_shared()
+	{
+		if (sharedQueueSize.load(std::memory_order_seq_cst) == 0)
+			return nullptr;
+		std::lock_guard<std::mutex> lock(sharedMutex);
+		if (sharedQueue.empty())
+			return nullptr;
+		Task* task = sharedQueue.front();
+		sharedQueue.pop_front();
+		sharedQueueSize.fetch_sub(1, std::memory_order_seq_cst);
+		return task;
+	}
+
+	static Task* find_task(uint32_t thIdx)
+	{
+		// Our own deque first (LIFO, cache friendly)
+		if (thIdx != UINT32_MAX)
+		{
+			Task* task = deques[thIdx]->pop();
+			if (task != nullptr)
+				return task;
+		}
+
+		// Then try to steal from a random victim
+		uint32_t start = next_random() % numThreads;
+		for (uint32_t offset = 0; offset < numThreads; ++offset)
+		{
+			uint32_t victim = (start + offset) % numThreads;
+			if (victim == thIdx)
+				continue;
+			Task* task = deques[victim]->steal();
+			if (task != nullptr)
+				return task;
+		}
+
+		// Finally the shared queue
+		return pop_shared();
+	}
+
+	static void wake_workers()
+	{
+		// Only pay for the lock if someone is actually sleeping
+		if (numSleepers.load(std::memory_order_seq_cst) == 0)
+			return;
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+		}
+		sleepCV.notify_one();
+	}
+
+	static void spawn(TaskGroup* group, std::function<void()>&& func)
+	{
+		Task* task = new Task();
+		task->func = std::move(func);
+		task->group = group;
+
+		if (threadIndex == UINT32_MAX || !deques[threadIndex]->push(task))
+			push_shared(task);
+		wake_workers();
+	}
+
+	static void release_reference(TaskGroup* group)
+	{
+		// Continuation groups are owned by the scheduler, the successor is read before the decrement
+		// as a waiting thread can release the group as soon as the counter reaches zero.
+		TaskGroup* successor = group->successor;
+		if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && successor != nullptr)
+		{
+			spawn(successor, std::move(group->continuation));
+			delete group;
+		}
+	}
+
+	static void execute_task(Task* task)
+	{
+		TaskGroup* group = task->group;
+		task->func();
+		delete task;
+		release_reference(group);
+	}
+
+	static void worker_loop(uint32_t thIdx)
+	{
+		threadIndex = thIdx;
+		while (true)
+		{
+			Task* task = find_task(thIdx);
+			if (task != nullptr)
+			{
+				execute_task(task);
+				continue;
+			}
+
+			// Announce that we are going to sleep, then look for work one last time.
+			// Either we see the task that was pushed, or the producer sees us and bumps the epoch.
+			uint64_t epoch = wakeEpoch.load(std::memory_order_seq_cst);
+			numSleepers.fetch_add(1, std::memory_order_seq_cst);
+			task = find_task(thIdx);
+			if (task != nullptr)
+			{
+				numSleepers.fetch_sub(1, std::memory_order_seq_cst);
+				execute_task(task);
+				continue;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				sleepCV.wait(lock, [&] { return wakeEpoch.load(std::memory_order_seq_cst) != epoch || !active.load(std::memory_order_seq_cst); });
+			}
+			numSleepers.fetch_sub(1, std::memory_order_seq_cst);
+
+			if (!active.load(std::memory_order_seq_cst))
+				break;
+		}
+	}
+
+	void initialize(uint32_t numWorkers)
+	{
+		assert_msg(!active.load(), "Task scheduler already initialized.");
+
+		// By default, one thread per hardware thread, the main thread included
+		if (numWorkers == 0)
+		{
+			uint32_t hwThreads = std::thread::hardware_concurrency();
+			numWorkers = hwThreads > 1 ? hwThreads - 1 : 1;
+		}
+
+		// Create the deques
+		numThreads = numWorkers + 1;
+		deques.resize(numThreads);
+		for (uint32_t thIdx = 0; thIdx < numThreads; ++thIdx)
+			deques[thIdx] = std::make_unique<WorkDeque>();
+
+		// The calling thread is the main thread
+		threadIndex = 0;
+		active.store(true);
+
+		// Spawn the workers
+		workers.resize(numWorkers);
+		for (uint32_t wIdx = 0; wIdx < numWorkers; ++wIdx)
+			workers[wIdx] = std::thread(worker_loop, wIdx + 1);
+	}
+
+	void release()
+	{
+		if (!active.load())
+			return;
+
+		// Stop the workers
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			active.store(false);
+			wakeEpoch.fetch_add(1);
+		}
+		sleepCV.notify_all();
+		for (std::thread& worker : workers)
+			worker.join();
+		workers.clear();
+
+		// Everything should have been waited on
+		assert_msg(sharedQueue.empty(), "Task scheduler released with pending tasks.");
+		deques.clear();
+		numThreads = 0;
+		threadIndex = UINT32_MAX;
+	}
+
+	uint32_t num_threads()
+	{
+		return numThreads > 0 ? numThreads : 1;
+	}
+
+	uint32_t thread_index()
+	{
+		return threadIndex;
+	}
+
+	void run(TaskGroup& group, const std::function<void()>& task)
+	{
+		// Without a pool, execute inline
+		if (!active.load(std::memory_order_relaxed))
+		{
+			task();
+			return;
+		}
+
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+		spawn(&group, std::function<void()>(task));
+	}
+
+	void run_with_continuation(TaskGroup& successor, const std::vector<std::function<void()>>& tasks, const std::function<void()>& continuation)
+	{
+		// Without a pool, execute inline
+		if (!active.load(std::memory_order_relaxed))
+		{
+			for (const std::function<void()>& task : tasks)
+				task();
+			continuation();
+			return;
+		}
+
+		// The successor is busy until the continuation is done
+		successor.pending.fetch_add(1, std::memory_order_relaxed);
+
+		// The spawning thread holds a reference until every task is spawned so that the continuation can't fire early
+		TaskGroup* group = new TaskGroup();
+		group->continuation = continuation;
+		group->successor = &successor;
+		group->pending.store((uint32_t)tasks.size() + 1, std::memory_order_relaxed);
+		for (const std::function<void()>& task : tasks)
+			spawn(group, std::function<void()>(task));
+		release_reference(group);
+	}
+
+	void wait(TaskGroup& group)
+	{
+		// Without a pool, every task was executed inline
+		if (!active.load(std::memory_order_relaxed))
+			return;
+
+		// Help until the group is done
+		uint32_t thIdx = threadIndex;
+		while (group.pending.load(std::memory_order_acquire) != 0)
+		{
+			Task* task = find_task(thIdx);
+			if (task != nullptr)
+				execute_task(task);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	static void split_range(TaskGroup& group, uint32_t first, uint32_t last, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		// Hand the upper halves to the thieves and keep the lower one, thieves end up with the biggest chunks
+		while (last - first > grain)
+		{
+			uint32_t mid = first + (last - first) / 2;
+			run(group, [&group, mid, last, grain, &func]() { split_range(group, mid, last, grain, func); });
+			last = mid;
+		}
+		func(first, last);
+	}
+
+	void parallel_for(uint32_t begin, uint32_t end, const std::function<void(uint32_t first, uint32_t last)>& func, uint32_t minGrain)
+	{
+		if (end <= begin)
+			return;
+
+		// Adapt the grain to the number of threads
+		uint32_t count = end - begin;
+		uint32_t grain = std::max(std::max(minGrain, 1u), count / (num_threads() * PARALLEL_FOR_RANGES_PER_THREAD));
+		if (count <= grain || !active.load(std::memory_order_relaxed))
+		{
+			func(begin, end);
+			return;
+		}
+
+		TaskGroup group;
+		split_range(group, begin, end, grain, func);
+		wait(group);
+	}
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Internal includes
+#include "tools/security.h"
+#include "tools/tlsf_allocator.h"
+
+// System includes
+#include <algorithm>
+#include <bit>
+
+TLSFAllocator::TLSFAllocator()
+{
+}
+
+TLSFAllocator::~TLSFAllocator()
+{
+}
+
+void TLSFAllocator::initialize(uint64_t capacity, uint64_t granularity)
+{
+	assert_msg(std::has_single_bit(granularity), "The granularity of the allocator needs to be a power of two.");
+	m_Granularity = granularity;
+	m_GranularityLog2 = (uint32_t)std::countr_zero(granularity);
+	m_Capacity = capacity & ~(granularity - 1);
+
+	// Reset the free lists
+	m_Blocks.clear();
+	m_UnusedBlocks.clear();
+	m_FLBitmap = 0;
+	for (uint32_t fl = 0; fl < TLSF_FL_COUNT; ++fl)
+	{
+		m_SLBitmaps[fl] = 0;
+		for (uint32_t sl = 0; sl < TLSF_SL_COUNT; ++sl)
+			m_FreeHeads[fl][sl] = TLSF_INVALID_ALLOCATION;
+	}
+	m_UsedBytes = 0;
+	m_PeakBytes = 0;
+	m_LiveAllocations = 0;
+
+	// The whole range starts as a single free block
+	if (m_Capacity > 0)
+	{
+		uint32_t blockIdx = new_block();
+		m_Blocks[blockIdx].offset = 0;
+		m_Blocks[blockIdx].size = m_Capacity;
+		insert_free_block(blockIdx);
+	}
+}
+
+void TLSFAllocator::release()
+{
+	m_Blocks.clear();
+	m_UnusedBlocks.clear();
+	m_FLBitmap = 0;
+	for (uint32_t fl = 0; fl < TLSF_FL_COUNT; ++fl)
+		m_SLBitmaps[fl] = 0;
+	m_Capacity = 0;
+	m_UsedBytes = 0;
+	m_LiveAllocations = 0;
+}
+
+void TLSFAllocator::mapping(uint64_t units, uint32_t& fl, uint32_t& sl) const
+{
+	// The small sizes are spread linearly in the first level
+	if (units < TLSF_SL_COUNT)
+	{
+		fl = 0;
+		sl = (uint32_t)units;
+	}
+	else
+	{
+		uint32_t msb = (uint32_t)std::bit_width(units) - 1;
+		fl = msb - TLSF_SL_LOG2 + 1;
+		sl = (uint32_t)(units >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+	}
+}
+
+uint32_t TLSFAllocator::find_free_block(uint64_t units) const
+{
+	// Round the request up to the next size class so that any block of the class fits
+	if (units >= TLSF_SL_COUNT)
+	{
+		uint32_t msb = (uint32_t)std::bit_width(units) - 1;
+		units += (1ull << (msb - TLSF_SL_LOG2)) - 1;
+	}
+	uint32_t fl, sl;
+	mapping(units, fl, sl);
+	if (fl >= TLSF_FL_COUNT)
+		return TLSF_INVALID_ALLOCATION;
+
+	// Look in the class or a bigger one of the same level, then in the next non empty level
+	uint32_t slMap = m_SLBitmaps[fl] & (~0u << sl);
+	if (slMap == 0)
+	{
+		uint64_t flMap = (fl + 1 < TLSF_FL_COUNT) ? (m_FLBitmap & (~0ull << (fl + 1))) : 0;
+		if (flMap == 0)
+			return TLSF_INVALID_ALLOCATION;
+		fl = (uint32_t)std::countr_zero(flMap);
+		slMap = m_SLBitmaps[fl];
+	}
+	sl = (uint32_t)std::countr_zero(slMap);
+	return m_FreeHeads[fl][sl];
+}
+
+void TLSFAllocator::insert_free_block(uint32_t blockIdx)
+{
+	Block& block = m_Blocks[blockIdx];
+	uint32_t fl, sl;
+	mapping(block.size >> m_GranularityLog2, fl, sl);
+
+	// Push at the head of the list
+	block.free = true;
+	block.prevFree = TLSF_INVALID_ALLOCATION;
+	block.nextFree = m_FreeHeads[fl][sl];
+	if (block.nextFree != TLSF_INVALID_ALLOCATION)
+		m_Blocks[block.nextFree].prevFree = blockIdx;
+	m_FreeHeads[fl][sl] = blockIdx;
+	m_FLBitmap |= 1ull << fl;
+	m_SLBitmaps[fl] |= 1u << sl;
+}
+
+void TLSFAllocator::remove_free_block(uint32_t blockIdx)
+{
+	Block& block = m_Blocks[blockIdx];
+	uint32_t fl, sl;
+	mapping(block.size >> m_GranularityLog2, fl, sl);
+
+	// Unlink it
+	if (block.prevFree != TLSF_INVALID_ALLOCATION)
+		m_Blocks[block.prevFree].nextFree = block.nextFree;
+	else
+		m_FreeHeads[fl][sl] = block.nextFree;
+	if (block.nextFree != TLSF_INVALID_ALLOCATION)
+		m_Blocks[block.nextFree].prevFree = block.prevFree;
+
+	// Clear the bitmaps if the list became empty
+	if (m_FreeHeads[fl][sl] == TLSF_INVALID_ALLOCATION)
+	{
+		m_SLBitmaps[fl] &= ~(1u << sl);
+		if (m_SLBitmaps[fl] == 0)
+			m_FLBitmap &= ~(1ull << fl);
+	}
+	block.free = false;
+	block.prevFree = TLSF_INVALID_ALLOCATION;
+	block.nextFree = TLSF_INVALID_ALLOCATION;
+}
+
+uint32_t TLSFAllocator::new_block()
+{
+	if (!m_UnusedBlocks.empty())
+	{
+		uint32_t blockIdx = m_UnusedBlocks.back();
+		m_UnusedBlocks.pop_back();
+		m_Blocks[blockIdx] = Block();
+		return blockIdx;
+	}
+	m_Blocks.push_back(Block());
+	return (uint32_t)(m_Blocks.size() - 1);
+}
+
+void TLSFAllocator::delete_block(uint32_t blockIdx)
+{
+	m_Blocks[blockIdx].size = 0;
+	m_UnusedBlocks.push_back(blockIdx);
+}
+
+uint32_t TLSFAllocator::allocate(uint64_t size, uint64_t& outOffset)
+{
+	// Round to the granularity
+	size = std::max(size, (uint64_t)1);
+	size = (size + m_Granularity - 1) & ~(m_Granularity - 1);
+	if (size > m_Capacity)
+		return TLSF_INVALID_ALLOCATION;
+
+	uint32_t blockIdx = find_free_block(size >> m_GranularityLog2);
+	if (blockIdx == TLSF_INVALID_ALLOCATION)
+		return TLSF_INVALID_ALLOCATION;
+	remove_free_block(blockIdx);
+
+	// Give the remainder back to the free lists
+	if (m_Blocks[blockIdx].size > size)
+	{
+		uint32_t remainderIdx = new_block();
+		Block& block = m_Blocks[blockIdx];
+		Block& remainder = m_Blocks[remainderIdx];
+		remainder.offset = block.offset + size;
+		remainder.size = block.size - size;
+		remainder.prevPhysical = blockIdx;
+		remainder.nextPhysical = block.nextPhysical;
+		if (block.nextPhysical != TLSF_INVALID_ALLOCATION)
+			m_Blocks[block.nextPhysical].prevPhysical = remainderIdx;
+		block.nextPhysical = remainderIdx;
+		block.size = size;
+		insert_free_block(remainderIdx);
+	}
+
+	// Stats
+	m_UsedBytes += size;
+	m_PeakBytes = std::max(m_PeakBytes, m_UsedBytes);
+	m_LiveAllocations++;
+
+	outOffset = m_Blocks[blockIdx].offset;
+	return blockIdx;
+}
+
+void TLSFAllocator::free(uint32_t allocation)
+{
+	assert_msg(allocation < m_Blocks.size() && !m_Blocks[allocation].free && m_Blocks[allocation].size != 0, "Releasing an invalid allocation.");
+	uint32_t blockIdx = allocation;
+
+	// Stats
+	m_UsedBytes -= m_Blocks[blockIdx].size;
+	m_LiveAllocations--;
+
+	// Merge with the next block
+	uint32_t nextIdx = m_Blocks[blockIdx].nextPhysical;
+	if (nextIdx != TLSF_INVALID_ALLOCATION && m_Blocks[nextIdx].free)
+	{
+		remove_free_block(nextIdx);
+		Block& block = m_Blocks[blockIdx];
+		block.size += m_Blocks[nextIdx].size;
+		block.nextPhysical = m_Blocks[nextIdx].nextPhysical;
+		if (block.nextPhysical != TLSF_INVALID_ALLOCATION)
+			m_Blocks[block.nextPhysical].prevPhysical = blockIdx;
+		delete_block(nextIdx);
+	}
+
+	// Merge with the previous block
+	uint32_t prevIdx = m_Blocks[blockIdx].prevPhysical;
+	if (prevIdx != TLSF_INVALID_ALLOCATION && m_Blocks[prevIdx].free)
+	{
+		remove_free_block(prevIdx);
+		Block& prev = m_Blocks[prevIdx];
+		prev.size += m_Blocks[blockIdx].size;
+		prev.nextPhysical = m_Blocks[blockIdx].nextPhysical;
+		if (prev.nextPhysical != TLSF_INVALID_ALLOCATION)
+			m_Blocks[prev.nextPhysical].prevPhysical = prevIdx;
+		delete_block(blockIdx);
+		blockIdx = prevIdx;
+	}
+
+	insert_free_block(blockIdx);
+}
+
+TLSFStats TLSFAllocator::stats() const
+{
+	TLSFStats stats;
+	stats.capacity = m_Capacity;
+	stats.usedBytes = m_UsedBytes;
+	stats.peakBytes = m_PeakBytes;
+	stats.liveAllocations = m_LiveAllocations;
+
+	// Walk the free lists
+	uint64_t freeBytes = 0;
+	for (uint32_t fl = 0; fl < TLSF_FL_COUNT; ++fl)
+	{
+		if (m_SLBitmaps[fl] == 0)
+			continue;
+		for (uint32_t sl = 0; sl < TLSF_SL_COUNT; ++sl)
+		{
+			for (uint32_t blockIdx = m_FreeHeads[fl][sl]; blockIdx != TLSF_INVALID_ALLOCATION; blockIdx = m_Blocks[blockIdx].nextFree)
+			{
+				freeBytes += m_Blocks[blockIdx].size;
+				stats.largestFreeBlock = std::max(stats.largestFreeBlock, m_Blocks[blockIdx].size);
+				stats.freeBlocks++;
+			}
+		}
+	}
+	stats.fragmentation = freeBytes > 0 ? 1.0f - (float)((double)stats.largestFreeBlock / (double)freeBytes) : 0.0f;
+	return stats;
+}
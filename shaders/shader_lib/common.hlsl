@@ -30,6 +30,22 @@
 #define FIXED_EXPOSURE 5.0
 #define FINAL_GAMMA 1.8
 
+// Classification tile, overridden by the pipeline (render_pipeline/tile_shape.h)
+#ifndef TILE_WIDTH
+#define TILE_WIDTH 8
+#endif
+#ifndef TILE_HEIGHT
+#define TILE_HEIGHT 4
+#endif
+#define TILE_PIXELS (TILE_WIDTH * TILE_HEIGHT)
+
+// The wave intrinsics of the classification need the whole tile in a single wave
+#if defined(TILE_WAVE_SIZE)
+#define TILE_WAVE_SIZE_ATTRIBUTE [WaveSize(TILE_WAVE_SIZE)]
+#else
+#define TILE_WAVE_SIZE_ATTRIBUTE
+#endif
+
 // Material data
 #define AO_OFFSET 0
 #define DIFFUSE_OFFSET 1
@@ -95,7 +111,7 @@ uint2 pixel_coords_from_work_group_id(uint32_t workGroupID, uint2 groupThreadID,
     uint wgY = workGroupID / tileSize.x;
 
     // Compute the pixel coords
-    return uint2(wgX * 8 + groupThreadID.x, wgY * 4 + groupThreadID.y);
+    return uint2(wgX * TILE_WIDTH + groupThreadID.x, wgY * TILE_HEIGHT + groupThreadID.y);
 }
 
 #endif // COMMON_HLSL
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef FEATURE_CACHE_HLSL
+#define FEATURE_CACHE_HLSL
+
+// Includes
+#include "shader_lib/visibility_utilities.hlsl"
+
+// Modes of the feature cache, mirrored by render_pipeline/feature_cache.h
+#define FEATURE_CACHE_DISABLED 0
+// The keys are recorded but nothing is reused (first frame, invalidated history)
+#define FEATURE_CACHE_RECORD 1
+#define FEATURE_CACHE_REUSE 2
+
+// Pixels that need to be inferred
+#define FEATURE_CACHE_NO_REUSE 0xFFFFFFFF
+
+// Rotating subset of tiles that is re-inferred every frame, scrambled so that it doesn't form visible patterns
+bool is_refresh_tile(uint tileIdx, uint frameIndex, uint refreshPeriod)
+{
+    uint hash = (tileIdx * 0x9E3779B1u) >> 16;
+    return (hash + frameIndex) % refreshPeriod == 0;
+}
+
+// Primitive, material, UV and normalized LOD of the features inferred for a pixel
+uint4 pack_feature_cache_key(uint primitiveID, uint matID, float2 uv, float lod)
+{
+    return uint4(pack_visibility_buffer(primitiveID), asuint(uv.x), asuint(uv.y), (matID << 16) | f32tof16(lod));
+}
+
+bool unpack_feature_cache_key(uint4 key, out uint matID, out float2 uv, out float lod)
+{
+    matID = key.w >> 16;
+    uv = asfloat(key.yz);
+    lod = f16tof32(key.w & 0xFFFF);
+    return is_valid_visibility_value(key.x);
+}
+
+#if defined(GLOBAL_CB_BINDING_SLOT)
+// Pixel that covered a world space position in the previous frame
+bool reproject_pixel(float3 positionWS, out uint2 prevPixelCoords)
+{
+    prevPixelCoords = uint2(0, 0);
+    float4 prevPositionCS = evaluate_homogenous_position(positionWS - _PrevCameraPosition, _PrevViewProjectionMatrix);
+    if (prevPositionCS.w <= 0.0)
+        return false;
+
+    // Inverse of evaluate_ndc_coordinates
+    float2 ndc = prevPositionCS.xy / prevPositionCS.w;
+    float2 prevCoords = float2(ndc.x * 0.5 + 0.5, 0.5 - ndc.y * 0.5) * float2(_ScreenSize) + 0.5;
+    if (any(prevCoords < 0.0) || any(prevCoords >= float2(_ScreenSize)))
+        return false;
+    prevPixelCoords = uint2(prevCoords);
+    return true;
+}
+
+// The history can be reused if it was inferred on the same material, close enough in UV space and at the same LOD
+bool validate_reuse(uint matID, float2 uv, float2 uvDX, float2 uvDY, float lod, uint4 prevKey)
+{
+    uint prevMatID;
+    float2 prevUV;
+    float prevLOD;
+    if (!unpack_feature_cache_key(prevKey, prevMatID, prevUV, prevLOD) || prevMatID != matID)
+        return false;
+    float footprint = max(max(length(uvDX), length(uvDY)), 1e-8);
+    return length(prevUV - uv) <= _CacheMaxUVDelta * footprint && abs(prevLOD - lod) <= _CacheMaxLODDelta;
+}
+#endif
+
+#endif // FEATURE_CACHE_HLSL
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef GBUFFER_CODEC_HLSL
+#define GBUFFER_CODEC_HLSL
+
+// Includes
+#include "shader_lib/common.hlsl"
+
+// Material channels produced by the inference, the GBuffer stores them in a uint4 per pixel:
+// x: diffuse color (RGB9E5)
+// y: tangent space normal (octahedral, 2 x 16 bits)
+// z: ambient occlusion, roughness, metalness, thickness (4 x 8 bits)
+// w: mask (2 x 8 bits), displacement (16 bits)
+// The padding channels of the network are dropped.
+#define GBUFFER_NUM_CHANNELS 16
+
+// Shared exponent diffuse color, matches DXGI_FORMAT_R9G9B9E5_SHAREDEXP
+#define RGB9E5_MANTISSA_BITS 9
+#define RGB9E5_EXPONENT_BIAS 15
+#define RGB9E5_MAX_VALUE 65408.0
+
+uint pack_unorm(float value, uint numBits)
+{
+    return uint(saturate(value) * float((1u << numBits) - 1) + 0.5);
+}
+
+float unpack_unorm(uint value, uint numBits)
+{
+    return float(value) / float((1u << numBits) - 1);
+}
+
+uint pack_rgb9e5(float3 color)
+{
+    color = clamp(color, 0.0, RGB9E5_MAX_VALUE);
+    float maxChannel = max(max(color.x, color.y), color.z);
+
+    // Exponent of the largest channel, read from the float to avoid the imprecision of log2
+    int maxExponent = int((asuint(maxChannel) >> 23) & 0xFF) - 127;
+    int sharedExponent = max(-RGB9E5_EXPONENT_BIAS - 1, maxExponent) + 1 + RGB9E5_EXPONENT_BIAS;
+
+    // The rounding can overflow the mantissa of the largest channel
+    float scale = exp2(float(sharedExponent - RGB9E5_EXPONENT_BIAS - RGB9E5_MANTISSA_BITS));
+    if (uint(floor(maxChannel / scale + 0.5)) == (1u << RGB9E5_MANTISSA_BITS))
+    {
+        sharedExponent++;
+        scale *= 2.0;
+    }
+
+    uint3 mantissa = uint3(floor(color / scale + 0.5));
+    return mantissa.x | (mantissa.y << 9) | (mantissa.z << 18) | (uint(sharedExponent) << 27);
+}
+
+float3 unpack_rgb9e5(uint value)
+{
+    float scale = exp2(float(int(value >> 27) - RGB9E5_EXPONENT_BIAS - RGB9E5_MANTISSA_BITS));
+    return float3(value & 0x1FF, (value >> 9) & 0x1FF, (value >> 18) & 0x1FF) * scale;
+}
+
+// Octahedral mapping of a unit vector to [0, 1]^2
+float2 octahedral_encode(float3 n)
+{
+    n /= max(abs(n.x) + abs(n.y) + abs(n.z), FLT_MIN);
+    float2 e = n.xy;
+    if (n.z < 0.0)
+    {
+        e.x = (1.0 - abs(n.y)) * (n.x >= 0.0 ? 1.0 : -1.0);
+        e.y = (1.0 - abs(n.x)) * (n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return e * 0.5 + 0.5;
+}
+
+float3 octahedral_decode(float2 e)
+{
+    e = e * 2.0 - 1.0;
+    float3 n = float3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+uint4 encode_gbuffer(float channels[GBUFFER_NUM_CHANNELS])
+{
+    // The network outputs the normal remapped to [0, 1]
+    float3 normalTS = float3(channels[NORMAL_OFFSET], channels[NORMAL_OFFSET + 1], channels[NORMAL_OFFSET + 2]) * 2.0 - 1.0;
+    float2 octNormal = octahedral_encode(normalTS);
+
+    uint4 data;
+    data.x = pack_rgb9e5(float3(channels[DIFFUSE_OFFSET], channels[DIFFUSE_OFFSET + 1], channels[DIFFUSE_OFFSET + 2]));
+    data.y = pack_unorm(octNormal.x, 16) | (pack_unorm(octNormal.y, 16) << 16);
+    data.z = pack_unorm(channels[AO_OFFSET], 8) | (pack_unorm(channels[ROUGHNESS_OFFSET], 8) << 8)
+        | (pack_unorm(channels[METALNESS_OFFSET], 8) << 16) | (pack_unorm(channels[THICKNESS_OFFSET], 8) << 24);
+    data.w = pack_unorm(channels[MASK_OFFSET], 8) | (pack_unorm(channels[MASK_OFFSET + 1], 8) << 8) | (pack_unorm(channels[DISPLACEMENT_OFFSET], 16) << 16);
+    return data;
+}
+
+void decode_gbuffer(uint4 data, out float channels[GBUFFER_NUM_CHANNELS])
+{
+    for (uint channelIdx = 0; channelIdx < GBUFFER_NUM_CHANNELS; ++channelIdx)
+        channels[channelIdx] = 0.0;
+
+    float3 diffuse = unpack_rgb9e5(data.x);
+    channels[DIFFUSE_OFFSET] = diffuse.x;
+    channels[DIFFUSE_OFFSET + 1] = diffuse.y;
+    channels[DIFFUSE_OFFSET + 2] = diffuse.z;
+
+    float3 normalTS = octahedral_decode(float2(unpack_unorm(data.y & 0xFFFF, 16), unpack_unorm(data.y >> 16, 16))) * 0.5 + 0.5;
+    channels[NORMAL_OFFSET] = normalTS.x;
+    channels[NORMAL_OFFSET + 1] = normalTS.y;
+    channels[NORMAL_OFFSET + 2] = normalTS.z;
+
+    channels[AO_OFFSET] = unpack_unorm(data.z & 0xFF, 8);
+    channels[ROUGHNESS_OFFSET] = unpack_unorm((data.z >> 8) & 0xFF, 8);
+    channels[METALNESS_OFFSET] = unpack_unorm((data.z >> 16) & 0xFF, 8);
+    channels[THICKNESS_OFFSET] = unpack_unorm(data.z >> 24, 8);
+    channels[MASK_OFFSET] = unpack_unorm(data.w & 0xFF, 8);
+    channels[MASK_OFFSET + 1] = unpack_unorm((data.w >> 8) & 0xFF, 8);
+    channels[DISPLACEMENT_OFFSET] = unpack_unorm(data.w >> 16, 16);
+}
+
+#endif // GBUFFER_CODEC_HLSL
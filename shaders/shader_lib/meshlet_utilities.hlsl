@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef MESHLET_UTILITIES_HLSL
+#define MESHLET_UTILITIES_HLSL
+
+// Same limits and constants as scene/meshlet.h
+#define MESHLET_MAX_VERTICES 64
+#define MESHLET_MAX_TRIANGLES 124
+#define MESHLET_MIN_CONE_SPREAD 0.1
+#define MESHLET_CONE_SLACK 0.01
+
+// Vertex offset, vertex count, triangle offset and triangle count of every meshlet
+#if defined(MESHLET_BUFFER_BINDING_SLOT)
+StructuredBuffer<uint4> _MeshletBuffer: register(MESHLET_BUFFER_BINDING_SLOT);
+#endif
+
+// Global vertex indices and primitive IDs of the meshlets
+#if defined(MESHLET_VERTEX_BUFFER_BINDING_SLOT)
+StructuredBuffer<uint> _MeshletVertexBuffer: register(MESHLET_VERTEX_BUFFER_BINDING_SLOT);
+#endif
+
+#if defined(MESHLET_TRIANGLE_BUFFER_BINDING_SLOT)
+StructuredBuffer<uint> _MeshletTriangleBuffer: register(MESHLET_TRIANGLE_BUFFER_BINDING_SLOT);
+#endif
+
+// Normal of the side the visibility pass keeps, same as front_normal in meshlet.cpp
+float3 front_normal(float3 p0, float3 p1, float3 p2)
+{
+    return cross(p2 - p0, p1 - p0);
+}
+#endif // MESHLET_UTILITIES_HLSL
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef VARIABLE_RATE_HLSL
+#define VARIABLE_RATE_HLSL
+
+// Inference rates of a tile, mirrored by render_pipeline/variable_rate.h
+#define INFERENCE_RATE_FULL 0
+// Even columns are inferred (half of the pixels)
+#define INFERENCE_RATE_HALF 1
+// Even columns of the even rows are inferred (a quarter of the pixels)
+#define INFERENCE_RATE_QUARTER 2
+
+// Falloff of the upsample weights with the UV discontinuity (in pixel footprints)
+#define VRS_EDGE_SHARPNESS 4.0
+
+#if defined(GLOBAL_CB_BINDING_SLOT)
+// Only fully covered tiles of a single material whose LOD doesn't vary too much are inferred at a reduced rate
+uint select_inference_rate(uint numCoveredPixels, float minLOD, float maxLOD)
+{
+    if (numCoveredPixels != TILE_PIXELS || (maxLOD - minLOD) > _VRSMaxLODSpread)
+        return INFERENCE_RATE_FULL;
+    if (minLOD >= _VRSQuarterRateLOD)
+        return INFERENCE_RATE_QUARTER;
+    if (minLOD >= _VRSHalfRateLOD)
+        return INFERENCE_RATE_HALF;
+    return INFERENCE_RATE_FULL;
+}
+#endif
+
+uint inferred_pixels_per_tile(uint rate)
+{
+    return rate == INFERENCE_RATE_HALF ? TILE_PIXELS / 2 : TILE_PIXELS / 4;
+}
+
+// Local coordinates of the i-th inferred pixel of a reduced rate tile
+uint2 inferred_pixel_coords(uint inferredIdx, uint rate)
+{
+    uint inferredPerRow = TILE_WIDTH / 2;
+    return uint2((inferredIdx % inferredPerRow) * 2, rate == INFERENCE_RATE_HALF ? inferredIdx / inferredPerRow : (inferredIdx / inferredPerRow) * 2);
+}
+
+bool is_inferred_pixel(uint2 localCoords, uint rate)
+{
+    return (localCoords.x & 0x1) == 0 && (rate == INFERENCE_RATE_HALF || (localCoords.y & 0x1) == 0);
+}
+
+// Inferred pixels (inside the tile) a skipped pixel is reconstructed from, and their bilinear weights
+void upsample_taps(uint2 localCoords, uint rate, out uint2 tapCoords[4], out float tapWeights[4])
+{
+    uint2 base = uint2(localCoords.x & ~0x1, rate == INFERENCE_RATE_HALF ? localCoords.y : localCoords.y & ~0x1);
+    float fx = (localCoords.x & 0x1) != 0 ? 0.5 : 0.0;
+    float fy = rate == INFERENCE_RATE_QUARTER && (localCoords.y & 0x1) != 0 ? 0.5 : 0.0;
+    bool hasRight = base.x + 2 < TILE_WIDTH;
+    bool hasBottom = base.y + 2 < TILE_HEIGHT;
+
+    tapCoords[0] = base;
+    tapCoords[1] = base + uint2(2, 0);
+    tapCoords[2] = base + uint2(0, 2);
+    tapCoords[3] = base + uint2(2, 2);
+    tapWeights[0] = (1.0 - fx) * (1.0 - fy);
+    tapWeights[1] = hasRight ? fx * (1.0 - fy) : 0.0;
+    tapWeights[2] = hasBottom ? (1.0 - fx) * fy : 0.0;
+    tapWeights[3] = hasRight && hasBottom ? fx * fy : 0.0;
+}
+
+// Drops the taps that are not on the continuation of the surface (UV seams, overlapping triangles of the same material)
+float edge_weight(float2 uv, float2 uvDX, float2 uvDY, float2 tapUV, float2 offset)
+{
+    float2 predictedUV = uv + uvDX * offset.x + uvDY * offset.y;
+    float footprint = max(max(length(uvDX), length(uvDY)), 1e-8);
+    float error = length(tapUV - predictedUV) / footprint;
+    return 1.0 / (1.0 + error * error * VRS_EDGE_SHARPNESS);
+}
+
+#endif // VARIABLE_RATE_HLSL
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef VERTEX_QUANTIZATION_HLSL
+#define VERTEX_QUANTIZATION_HLSL
+
+// Includes
+#include "shader_lib/mesh_utilities.hlsl"
+
+// Largest quantized value
+#define QUANTIZATION_RANGE 65535.0
+
+// Matches SharedVertexData, attributes that don't change with the animation
+struct SharedVertexData
+{
+    float2 texCoord;
+    uint matID;
+};
+
+// Matches QuantizedVertexData, 16 bit components packed in pairs:
+// x: position.x | position.y
+// y: position.z | normal.u
+// z: normal.v | tangent.u
+// w: tangent.v | padding
+float3 decode_quantized_position(uint4 data, float3 boundsMin, float3 positionScale)
+{
+    float3 q = float3(data.x & 0xFFFF, data.x >> 16, data.y & 0xFFFF);
+    return q * positionScale + boundsMin;
+}
+
+// Same operations as decode_octahedral in mesh.cpp
+float3 decode_quantized_direction(uint u, uint v)
+{
+    float2 e = float2(u, v) * (2.0 / QUANTIZATION_RANGE) - 1.0;
+    float3 n = float3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return n / sqrt(dot(n, n));
+}
+
+float3 decode_quantized_normal(uint4 data)
+{
+    return decode_quantized_direction(data.y >> 16, data.z & 0xFFFF);
+}
+
+float3 decode_quantized_tangent(uint4 data)
+{
+    return decode_quantized_direction(data.z >> 16, data.w & 0xFFFF);
+}
+
+VertexData decode_quantized_vertex(uint4 data, SharedVertexData shared, float3 boundsMin, float3 positionScale)
+{
+    float3 position = decode_quantized_position(data, boundsMin, positionScale);
+    float3 normal = decode_quantized_normal(data);
+    float3 tangent = decode_quantized_tangent(data);
+
+    VertexData vData;
+    vData.data0 = float4(position, normal.x);
+    vData.data1 = float4(normal.yz, tangent.xy);
+    vData.data2 = float4(tangent.z, shared.texCoord, asfloat(shared.matID));
+    return vData;
+}
+#endif // VERTEX_QUANTIZATION_HLSL